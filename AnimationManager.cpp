@@ -0,0 +1,390 @@
+﻿// AnimationManager.cpp
+// スケルタルアニメーション
+// |  クリップのキーはトラック（ノード）ごとに 位置 / 回転 / 拡大 の3本。時間は秒で昇順
+// |  クリップは登録時に圧縮して名前で共有する（キー削減 → 量子化。再生は圧縮済みのまま読む）
+// |  サンプリングはトラックごとのカーソル（前回のキー）から前へ進めるだけ。時間が戻ったときだけ二分探索
+// |  姿勢 → ノードのワールド行列（親が先に並んでいるので1回の走査）→ ボーン行列（Offset * Global * GlobalInverse）
+// |  CPU スキニングは頂点ごとに重み付きの行列を 4 行まとめて作って変換（DirectXMath の SIMD）
+// |  GPU スキニングはボーン行列をそのまま VS へ（Model::Draw 側）
+// __________________________________________
+
+#include "Manager.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+
+using namespace DirectX;
+
+#define ANIM_TIME_MAX   65535.0f
+#define ANIM_VALUE_MAX  65535.0f
+#define ANIM_ROT_MAX    32767.0f            // smallest-three は 15 bit（上位 1 bit は最大成分の番号）
+#define ANIM_ROT_RANGE  0.70710678f         // 残り 3 成分は ±1/√2 に収まる
+
+static bool g_AnimGPU = false;
+
+// クリップの共有キャッシュ（deque: 追加してもアドレスが変わらない。Model がポインタを持つ）
+static std::deque<AnimPackedClip> g_AnimClips;
+static KeyMap g_AnimClipMap;
+static float g_AnimTolPos = 0.001f;
+static float g_AnimTolRot = 0.001f;         // ラジアン
+static float g_AnimTolScale = 0.001f;
+
+//-----------------------------------------
+// 姿勢
+//-----------------------------------------
+void Anim_BindPose(const ModelSkeleton* skel, AnimPose* pose)
+{
+    if (!skel || !pose) return;
+    pose->Pos = skel->BindPos;
+    pose->Rot = skel->BindRot;
+    pose->Scale = skel->BindScale;
+}
+
+void Anim_MapTracks(const ModelSkeleton* skel, const AnimPackedClip* clip, std::vector<int>* trackNode)
+{
+    if (!trackNode) return;
+    trackNode->clear();
+    if (!skel || !clip) return;
+    trackNode->resize(clip->Tracks.size(), -1);
+    for (size_t t = 0; t < clip->Tracks.size(); ++t) {
+        auto it = std::find(skel->NodeName.begin(), skel->NodeName.end(), clip->Tracks[t].NodeName);
+        if (it != skel->NodeName.end()) (*trackNode)[t] = (int)(it - skel->NodeName.begin());
+    }
+}
+
+//-----------------------------------------
+// 圧縮
+//-----------------------------------------
+static float Anim_Clamp01(float f) { return f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f); }
+
+static float Anim_VecError(const XMFLOAT3& a, const XMFLOAT3& b)
+{
+    return XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&a), XMLoadFloat3(&b))));
+}
+static float Anim_RotError(const XMFLOAT4& a, const XMFLOAT4& b)
+{
+    float d = fabsf(XMVectorGetX(XMVector4Dot(XMLoadFloat4(&a), XMLoadFloat4(&b))));
+    return 2.0f * acosf(d > 1.0f ? 1.0f : d);   // 2つの回転の角度差
+}
+static XMFLOAT3 Anim_VecLerp(const XMFLOAT3& a, const XMFLOAT3& b, float t)
+{
+    XMFLOAT3 r;
+    XMStoreFloat3(&r, XMVectorLerp(XMLoadFloat3(&a), XMLoadFloat3(&b), t));
+    return r;
+}
+static XMFLOAT4 Anim_RotLerp(const XMFLOAT4& a, const XMFLOAT4& b, float t)
+{
+    XMFLOAT4 r;
+    XMStoreFloat4(&r, XMQuaternionSlerp(XMLoadFloat4(&a), XMLoadFloat4(&b), t));
+    return r;
+}
+
+// 残すキーの番号
+// |  前に残したキー a から b までを直線（回転は slerp）で結び、間のキーが全て tol 以内なら b を伸ばす
+// |  全部が同じ値なら 1 キーだけ
+template<class V, class Lerp, class Err>
+static std::vector<int> Anim_ReduceKeys(const std::vector<float>& time, const std::vector<V>& value, float tol, Lerp lerp, Err err)
+{
+    std::vector<int> keep;
+    int n = (int)std::min(time.size(), value.size());
+    if (n == 0) return keep;
+    keep.push_back(0);
+    int a = 0;
+    for (int b = 2; b < n; ++b) {
+        float span = time[b] - time[a];
+        bool ok = true;
+        for (int k = a + 1; k < b && ok; ++k) {
+            float f = span > 0.0f ? (time[k] - time[a]) / span : 0.0f;
+            ok = err(lerp(value[a], value[b], f), value[k]) <= tol;
+        }
+        if (!ok) { a = b - 1; keep.push_back(a); }
+    }
+    if (n > 1) keep.push_back(n - 1);
+    if (keep.size() == 2 && err(value[0], value[n - 1]) <= tol) keep.resize(1);
+    return keep;
+}
+
+static void Anim_PackTimes(const std::vector<float>& time, const std::vector<int>& keep, float duration, AnimPackedChannel& out)
+{
+    out.Time.resize(keep.size());
+    for (size_t i = 0; i < keep.size(); ++i)
+        out.Time[i] = (unsigned short)(Anim_Clamp01(duration > 0.0f ? time[keep[i]] / duration : 0.0f) * ANIM_TIME_MAX + 0.5f);
+}
+
+// 位置 / 拡大（残したキーの範囲で 16 bit）
+static void Anim_PackVec(const std::vector<XMFLOAT3>& value, const std::vector<int>& keep, AnimPackedChannel& out)
+{
+    out.Min = XMFLOAT3(0, 0, 0);
+    out.Step = XMFLOAT3(0, 0, 0);
+    if (keep.empty()) return;
+    XMVECTOR mn = XMVectorReplicate(FLT_MAX), mx = XMVectorReplicate(-FLT_MAX);
+    for (int k : keep) {
+        XMVECTOR v = XMLoadFloat3(&value[k]);
+        mn = XMVectorMin(mn, v);
+        mx = XMVectorMax(mx, v);
+    }
+    XMVECTOR step = XMVectorScale(XMVectorSubtract(mx, mn), 1.0f / ANIM_VALUE_MAX);
+    XMStoreFloat3(&out.Min, mn);
+    XMStoreFloat3(&out.Step, step);
+
+    // 幅 0 の成分は 0 で割らない
+    XMVECTOR inv = XMVectorSelect(XMVectorReciprocal(step), XMVectorZero(), XMVectorEqual(step, XMVectorZero()));
+    out.Value.resize(keep.size() * 3);
+    for (size_t i = 0; i < keep.size(); ++i) {
+        XMFLOAT3 q;
+        XMStoreFloat3(&q, XMVectorRound(XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&value[keep[i]]), mn), inv)));
+        out.Value[i * 3 + 0] = (unsigned short)std::min(q.x, ANIM_VALUE_MAX);
+        out.Value[i * 3 + 1] = (unsigned short)std::min(q.y, ANIM_VALUE_MAX);
+        out.Value[i * 3 + 2] = (unsigned short)std::min(q.z, ANIM_VALUE_MAX);
+    }
+}
+
+// 回転（smallest-three: 一番大きい成分を落として残り 3 つを 15 bit、番号 2 bit は 1 つ目と 2 つ目の上位 bit）
+static void Anim_PackRot(const std::vector<XMFLOAT4>& value, const std::vector<int>& keep, AnimPackedChannel& out)
+{
+    out.Min = XMFLOAT3(0, 0, 0);
+    out.Step = XMFLOAT3(0, 0, 0);
+    out.Value.resize(keep.size() * 3);
+    for (size_t i = 0; i < keep.size(); ++i) {
+        XMFLOAT4 q;
+        XMStoreFloat4(&q, XMQuaternionNormalize(XMLoadFloat4(&value[keep[i]])));
+        float c[4] = { q.x, q.y, q.z, q.w };
+        int largest = 0;
+        for (int j = 1; j < 4; ++j) if (fabsf(c[j]) > fabsf(c[largest])) largest = j;
+        float sign = c[largest] < 0.0f ? -1.0f : 1.0f;      // 落とす成分は常に正（q と -q は同じ回転）
+
+        unsigned short s[3];
+        for (int j = 0, n = 0; j < 4; ++j) {
+            if (j == largest) continue;
+            float f = Anim_Clamp01((c[j] * sign + ANIM_ROT_RANGE) / (2.0f * ANIM_ROT_RANGE));
+            s[n++] = (unsigned short)(f * ANIM_ROT_MAX + 0.5f);
+        }
+        out.Value[i * 3 + 0] = (unsigned short)(s[0] | ((largest & 1) << 15));
+        out.Value[i * 3 + 1] = (unsigned short)(s[1] | ((largest >> 1) << 15));
+        out.Value[i * 3 + 2] = s[2];
+    }
+}
+
+const AnimPackedClip* AddAnimClip(const char* name, AnimClip&& clip)
+{
+    if (!name || !*name) return nullptr;
+    int index = KeyMap_GetIndex(&g_AnimClipMap, name);
+    if (index >= 0) return &g_AnimClips[index];
+
+    AnimPackedClip packed = {};
+    packed.Duration = clip.Duration;
+    packed.Tracks.resize(clip.Tracks.size());
+    for (size_t t = 0; t < clip.Tracks.size(); ++t) {
+        const AnimTrack& src = clip.Tracks[t];
+        AnimPackedTrack& dst = packed.Tracks[t];
+        dst.NodeName = src.NodeName;
+
+        std::vector<int> pos = Anim_ReduceKeys(src.PosTime, src.Pos, g_AnimTolPos, Anim_VecLerp, Anim_VecError);
+        std::vector<int> rot = Anim_ReduceKeys(src.RotTime, src.Rot, g_AnimTolRot, Anim_RotLerp, Anim_RotError);
+        std::vector<int> scale = Anim_ReduceKeys(src.ScaleTime, src.Scale, g_AnimTolScale, Anim_VecLerp, Anim_VecError);
+        Anim_PackTimes(src.PosTime, pos, clip.Duration, dst.Pos);
+        Anim_PackTimes(src.RotTime, rot, clip.Duration, dst.Rot);
+        Anim_PackTimes(src.ScaleTime, scale, clip.Duration, dst.Scale);
+        Anim_PackVec(src.Pos, pos, dst.Pos);
+        Anim_PackRot(src.Rot, rot, dst.Rot);
+        Anim_PackVec(src.Scale, scale, dst.Scale);
+
+        packed.RawKeys += src.Pos.size() + src.Rot.size() + src.Scale.size();
+        packed.PackedKeys += pos.size() + rot.size() + scale.size();
+        packed.RawBytes += (src.PosTime.size() + src.RotTime.size() + src.ScaleTime.size()) * sizeof(float)
+            + src.Pos.size() * sizeof(XMFLOAT3) + src.Rot.size() * sizeof(XMFLOAT4) + src.Scale.size() * sizeof(XMFLOAT3);
+        for (const AnimPackedChannel* c : { &dst.Pos, &dst.Rot, &dst.Scale })
+            packed.PackedBytes += (c->Time.size() + c->Value.size()) * sizeof(unsigned short) + sizeof(c->Min) + sizeof(c->Step);
+    }
+
+    char msg[256];
+    snprintf(msg, sizeof(msg), "AnimClip %s: %.1f KB -> %.1f KB (keys %zu -> %zu)", name,
+        packed.RawBytes / 1024.0, packed.PackedBytes / 1024.0, packed.RawKeys, packed.PackedKeys);
+    AddMessage(msg);
+
+    clip = AnimClip{};      // 元のキーは持たない
+    KeyMap_Add(&g_AnimClipMap, name);
+    g_AnimClips.push_back(std::move(packed));
+    return &g_AnimClips.back();
+}
+
+const AnimPackedClip* GetAnimClip(const char* name)
+{
+    if (!name) return nullptr;
+    int index = KeyMap_GetIndex(&g_AnimClipMap, name);
+    return index < 0 ? nullptr : &g_AnimClips[index];
+}
+
+void SetAnimClipTolerance(float pos, float rot, float scale)
+{
+    g_AnimTolPos = pos < 0.0f ? 0.0f : pos;
+    g_AnimTolRot = rot < 0.0f ? 0.0f : rot;
+    g_AnimTolScale = scale < 0.0f ? 0.0f : scale;
+}
+
+void GetAnimClipMemory(int* count, size_t* rawBytes, size_t* packedBytes)
+{
+    size_t raw = 0, packed = 0;
+    for (const AnimPackedClip& c : g_AnimClips) { raw += c.RawBytes; packed += c.PackedBytes; }
+    if (count) *count = (int)g_AnimClips.size();
+    if (rawBytes) *rawBytes = raw;
+    if (packedBytes) *packedBytes = packed;
+}
+
+void ReleaseAnimClips()
+{
+    g_AnimClips.clear();
+    KeyMap_Free(&g_AnimClipMap);
+}
+
+//-----------------------------------------
+// サンプリング（圧縮済みのまま読む）
+//-----------------------------------------
+// tick 以下で一番後ろのキー（cursor から前へ進める。時間が戻ったときだけ二分探索）
+static int Anim_Seek(const std::vector<unsigned short>& times, float tick, int& cursor)
+{
+    int n = (int)times.size();
+    if (cursor < 0 || cursor >= n || times[cursor] > tick) {
+        cursor = (int)(std::upper_bound(times.begin(), times.end(), tick,
+            [](float t, unsigned short k) { return t < (float)k; }) - times.begin()) - 1;
+        if (cursor < 0) cursor = 0;
+    }
+    while (cursor + 1 < n && times[cursor + 1] <= tick) cursor++;
+    return cursor;
+}
+
+// キー k と k + 1 の間での割合（最後のキー以降は 0）
+static float Anim_Factor(const std::vector<unsigned short>& times, int k, float tick)
+{
+    if (k + 1 >= (int)times.size()) return 0.0f;
+    float span = (float)times[k + 1] - (float)times[k];
+    if (span <= 0.0f) return 0.0f;
+    return Anim_Clamp01((tick - (float)times[k]) / span);
+}
+
+static XMVECTOR Anim_DecodeVec(const AnimPackedChannel& c, int k)
+{
+    const unsigned short* q = &c.Value[k * 3];
+    return XMVectorMultiplyAdd(XMVectorSet(q[0], q[1], q[2], 0.0f), XMLoadFloat3(&c.Step), XMLoadFloat3(&c.Min));
+}
+
+static XMVECTOR Anim_DecodeRot(const AnimPackedChannel& c, int k)
+{
+    const unsigned short* q = &c.Value[k * 3];
+    int largest = (q[0] >> 15) | ((q[1] >> 15) << 1);
+    const float scale = 2.0f * ANIM_ROT_RANGE / ANIM_ROT_MAX;
+    float s[3] = {
+        (q[0] & 0x7fff) * scale - ANIM_ROT_RANGE,
+        (q[1] & 0x7fff) * scale - ANIM_ROT_RANGE,
+        (q[2] & 0x7fff) * scale - ANIM_ROT_RANGE,
+    };
+    float w = 1.0f - s[0] * s[0] - s[1] * s[1] - s[2] * s[2];
+    float r[4];
+    for (int j = 0, n = 0; j < 4; ++j) r[j] = (j == largest) ? sqrtf(w > 0.0f ? w : 0.0f) : s[n++];
+    return XMVectorSet(r[0], r[1], r[2], r[3]);
+}
+
+void Anim_Sample(const AnimPackedClip* clip, const std::vector<int>& trackNode, float time, int* cursor, AnimPose* pose)
+{
+    if (!clip || !cursor || !pose) return;
+    float tick = clip->Duration > 0.0f ? Anim_Clamp01(time / clip->Duration) * ANIM_TIME_MAX : 0.0f;
+    int nodeCount = (int)pose->Pos.size();
+    int trackCount = std::min((int)clip->Tracks.size(), (int)trackNode.size());
+    for (int t = 0; t < trackCount; ++t) {
+        int node = trackNode[t];
+        if (node < 0 || node >= nodeCount) continue;
+        const AnimPackedTrack& tr = clip->Tracks[t];
+        int* c = cursor + t * 3;
+
+        if (!tr.Pos.Time.empty()) {
+            int k = Anim_Seek(tr.Pos.Time, tick, c[0]);
+            int k1 = std::min(k + 1, (int)tr.Pos.Time.size() - 1);
+            XMStoreFloat3(&pose->Pos[node], XMVectorLerp(Anim_DecodeVec(tr.Pos, k), Anim_DecodeVec(tr.Pos, k1), Anim_Factor(tr.Pos.Time, k, tick)));
+        }
+        if (!tr.Rot.Time.empty()) {
+            int k = Anim_Seek(tr.Rot.Time, tick, c[1]);
+            int k1 = std::min(k + 1, (int)tr.Rot.Time.size() - 1);
+            XMStoreFloat4(&pose->Rot[node], XMQuaternionSlerp(Anim_DecodeRot(tr.Rot, k), Anim_DecodeRot(tr.Rot, k1), Anim_Factor(tr.Rot.Time, k, tick)));
+        }
+        if (!tr.Scale.Time.empty()) {
+            int k = Anim_Seek(tr.Scale.Time, tick, c[2]);
+            int k1 = std::min(k + 1, (int)tr.Scale.Time.size() - 1);
+            XMStoreFloat3(&pose->Scale[node], XMVectorLerp(Anim_DecodeVec(tr.Scale, k), Anim_DecodeVec(tr.Scale, k1), Anim_Factor(tr.Scale.Time, k, tick)));
+        }
+    }
+}
+
+void Anim_Blend(AnimPose* dst, const AnimPose& src, float t)
+{
+    if (!dst) return;
+    size_t n = std::min(dst->Pos.size(), src.Pos.size());
+    for (size_t i = 0; i < n; ++i) {
+        XMStoreFloat3(&dst->Pos[i], XMVectorLerp(XMLoadFloat3(&dst->Pos[i]), XMLoadFloat3(&src.Pos[i]), t));
+        XMStoreFloat4(&dst->Rot[i], XMQuaternionSlerp(XMLoadFloat4(&dst->Rot[i]), XMLoadFloat4(&src.Rot[i]), t));
+        XMStoreFloat3(&dst->Scale[i], XMVectorLerp(XMLoadFloat3(&dst->Scale[i]), XMLoadFloat3(&src.Scale[i]), t));
+    }
+}
+
+//-----------------------------------------
+// 行列
+//-----------------------------------------
+void Anim_Palette(const ModelSkeleton* skel, const AnimPose& pose, XMMATRIX* global, XMMATRIX* palette)
+{
+    if (!skel || !global || !palette) return;
+    int nodeCount = (int)std::min(skel->Parent.size(), pose.Pos.size());
+    for (int i = 0; i < nodeCount; ++i) {
+        XMMATRIX local = XMMatrixScalingFromVector(XMLoadFloat3(&pose.Scale[i]))
+            * XMMatrixRotationQuaternion(XMLoadFloat4(&pose.Rot[i]))
+            * XMMatrixTranslationFromVector(XMLoadFloat3(&pose.Pos[i]));
+        int parent = skel->Parent[i];
+        global[i] = parent >= 0 ? XMMatrixMultiply(local, global[parent]) : local;
+    }
+    XMMATRIX inv = XMLoadFloat4x4(&skel->GlobalInverse);
+    for (size_t b = 0; b < skel->BoneNode.size(); ++b) {
+        int node = skel->BoneNode[b];
+        XMMATRIX g = (node >= 0 && node < nodeCount) ? global[node] : XMMatrixIdentity();
+        palette[b] = XMMatrixMultiply(XMMatrixMultiply(XMLoadFloat4x4(&skel->BoneOffset[b]), g), inv);
+    }
+}
+
+//-----------------------------------------
+// CPU スキニング
+//-----------------------------------------
+void Anim_SkinCPU(const ModelVertex* src, const ModelSkinVertex* skin, int count, const XMMATRIX* palette, ModelVertex* dst)
+{
+    if (!src || !skin || !palette || !dst) return;
+    for (int i = 0; i < count; ++i) {
+        const ModelSkinVertex& s = skin[i];
+        dst[i].uv = src[i].uv;
+
+        // 重みを掛けた行列の和（4 行を 4 要素ずつ）
+        XMVECTOR r0 = XMVectorZero(), r1 = r0, r2 = r0, r3 = r0;
+        float sum = 0.0f;
+        for (int k = 0; k < 4; ++k) {
+            if (s.weight[k] <= 0.0f) continue;
+            const XMMATRIX& m = palette[s.bone[k]];
+            XMVECTOR w = XMVectorReplicate(s.weight[k]);
+            r0 = XMVectorMultiplyAdd(m.r[0], w, r0);
+            r1 = XMVectorMultiplyAdd(m.r[1], w, r1);
+            r2 = XMVectorMultiplyAdd(m.r[2], w, r2);
+            r3 = XMVectorMultiplyAdd(m.r[3], w, r3);
+            sum += s.weight[k];
+        }
+        if (sum <= 0.0f) {      // どのボーンにも付いていない頂点はそのまま
+            dst[i].pos = src[i].pos;
+            dst[i].normal = src[i].normal;
+            continue;
+        }
+        XMMATRIX m(r0, r1, r2, r3);
+        XMStoreFloat3(&dst[i].pos, XMVector3Transform(XMLoadFloat3(&src[i].pos), m));
+        XMStoreFloat3(&dst[i].normal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&src[i].normal), m)));
+    }
+}
+
+//-----------------------------------------
+// 設定
+//-----------------------------------------
+void SetModelSkinningGPU(bool enable) { g_AnimGPU = enable; }
+bool IsModelSkinningGPU() { return g_AnimGPU; }
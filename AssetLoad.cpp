@@ -1,5 +1,7 @@
 #include "AssetLoad.h"
 #include "Main.h" // Ȃ̊֐iIN_LoadTexture, IN_LoadFBXj錾Ăꏊ
+#include "JobSystem.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -305,6 +307,100 @@ bool AL_LoadFromPackageByName(const char* name) {
     return WriteTempAndCallLoader(e);
 }
 
+// --- 񓯊[h ---
+struct AsyncTextureLoad {
+    std::string name;
+    std::vector<uint8_t> data;     // pkg ǂ񂾌f[^iWuŏLj
+    std::vector<unsigned char> pixels;
+    unsigned width = 0;
+    unsigned height = 0;
+    bool decoded = false;
+};
+
+static JobCounter g_asyncLoadCounter;
+static std::vector<std::string> g_asyncLoadPending; // CXbĥݐG
+
+static void AsyncTextureUpload(void* p)
+{
+    AsyncTextureLoad* task = static_cast<AsyncTextureLoad*>(p);
+    if (!task->decoded || !IN_UploadTexture(task->name.c_str(), task->pixels.data(), task->width, task->height))
+        AddMessage(ConcatCStr("AL_LoadFromPackageByNameAsync failed: ", task->name.c_str()));
+
+    auto it = std::find(g_asyncLoadPending.begin(), g_asyncLoadPending.end(), task->name);
+    if (it != g_asyncLoadPending.end()) g_asyncLoadPending.erase(it);
+    delete task;
+}
+
+static void AsyncTextureDecode(void* p)
+{
+    AsyncTextureLoad* task = static_cast<AsyncTextureLoad*>(p);
+    task->decoded = IN_DecodeTexture_Memory(task->data.data(), task->data.size(), task->pixels, task->width, task->height);
+    task->data.clear();
+    task->data.shrink_to_fit();
+    // D3D ւ̓o^̓CXbhŁiJE^ɐςނ̂ Wait  0 ɂȂȂj
+    Job_RunMainThread(AsyncTextureUpload, task, &g_asyncLoadCounter);
+}
+
+bool AL_LoadFromPackageByNameAsync(const char* name) {
+    if (!name) return false;
+    if (AL_IsLoadPending(name)) return true;
+
+    std::string ext = fs::path(name).extension().string();
+    if (ext.size() && ext[0] == '.') ext.erase(0, 1);
+    ext = ToLowerExt(ext);
+    if (!(ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp"))
+        return AL_LoadFromPackageByName(name);
+
+    Package* pkg = nullptr;
+    int idx = -1;
+    if (!FindPackageEntryByName(name, pkg, idx)) return false;
+    if (!pkg) return false;
+    if (idx < 0 || idx >= (int)pkg->entries.size()) return false;
+
+    // pkg ̓ǂݏo̓CXbhŁiXg[LĂ邽߁j
+    PackageEntry& e = pkg->entries[idx];
+    AsyncTextureLoad* task = new AsyncTextureLoad();
+    task->name = name;
+    if (!e.data.empty()) {
+        task->data = e.data;
+    }
+    else {
+        if (!pkg->pkgStream.is_open()) {
+            pkg->pkgStream.open(pkg->pkgPath, std::ios::binary);
+            if (!pkg->pkgStream.is_open()) { delete task; return false; }
+        }
+        pkg->pkgStream.seekg(e.offset);
+        task->data.resize((size_t)e.size);
+        pkg->pkgStream.read((char*)task->data.data(), (std::streamsize)e.size);
+    }
+
+    g_asyncLoadPending.push_back(task->name);
+    Job_Run(AsyncTextureDecode, task, &g_asyncLoadCounter);
+    return true;
+}
+
+void AL_WaitAsyncLoads() {
+    Job_Wait(&g_asyncLoadCounter);
+}
+
+bool AL_IsLoadPending(const char* name) {
+    if (!name) return false;
+    for (const std::string& s : g_asyncLoadPending)
+        if (s == name) return true;
+    return false;
+}
+
+void AL_UnloadFromPackage(const char* name) {
+    if (!name) return;
+    Package* pkg = nullptr;
+    int idx = -1;
+    if (!FindPackageEntryByName(name, pkg, idx) || !pkg) return;
+    if (idx < 0 || idx >= (int)pkg->entries.size()) return;
+    // ob`iKipkg oj̃f[^͗B̎̂Ȃ̂Ŏc
+    if (pkg->pkgPath.empty()) return;
+    std::vector<uint8_t>().swap(pkg->entries[idx].data);
+}
+
 bool AL_LoadFromPackageByIndex(const char* ext, int index) {
     if (!ext) return false;
     Package* pkg = FindPackageByExt(ToLowerExt(ext));
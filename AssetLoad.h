@@ -2,7 +2,7 @@
 #include "Manager.h"
 #include <string>
 #include <vector>
-#include <DirectXMath.h>
+#include "MathAPI.h"
 //  / I
 void AL_Init();
 void AL_Shutdown();
@@ -27,6 +27,16 @@ bool AL_LoadPackageIndex(const char* ext, const char* pkgFilePath);
 bool AL_LoadFromPackageByName(const char* name); // L[}bvɓo^ς݂̖Og
 bool AL_LoadFromPackageByIndex(const char* ext, int index);
 
+// 񓯊ŁF摜̃fR[h[J[ōsAGPU ւ̓o^̓CXbhōs
+// 摜ȊO̊gq͂̏œ[h
+//  AL_WaitAsyncLoads() ő҂At[ Job_PumpMainThread() ŏf
+bool AL_LoadFromPackageByNameAsync(const char* name);
+void AL_WaitAsyncLoads();
+bool AL_IsLoadPending(const char* name);
+
+// pkg ǂ񂾃oCĩLbV̂Ăi pkg ǂݒj
+void AL_UnloadFromPackage(const char* name);
+
 // pbP[Wł index 擾iKeyMap oRj
 // return: index (>=0) or -1
 int AL_GetIndexFromPackage(const char* ext, const char* name);
@@ -20,78 +20,161 @@
 #include "AssetLoad.h"
 #include "Manager.h"
 
+#if !defined(LIA_NO_ASSIMP)
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#endif
 
 #include <vector>
+#include <deque>
+#if defined(_WIN32)
 #include <wincodec.h> // WIC
+#endif
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cfloat>
+#include <unordered_map>
 
 #define SafeRelease(p) if(p){ (p)->Release(); (p)=nullptr; }
 
 //グローバル_____________________
-static std::vector<ID3D11ShaderResourceView*> g_textureSRV;        //テクスチャ保存用SRV
-static std::vector<std::vector<ModelVertex>> g_modelVertex;        //Obj保存用SRV
-static ID3D11SamplerState* g_samplerState;                         //デフォルトサンプラーステート
+static std::vector<RenderShaderResourceView*> g_textureSRV;        //テクスチャ保存用SRV
+static std::vector<int> g_textureRef;                               //シーンからの参照数（0 になったら解放）
+//モデル（deque: 後から読み込んでもアドレスが変わらない。Model は Get* のポインタを持ち続ける）
+static std::deque<std::vector<ModelVertex>> g_modelVertex;         //Obj保存用SRV
+static std::deque<std::vector<ModelSkinVertex>> g_modelSkin;       //ボーンの重み（g_modelVertex と同じ並び、ボーンが無ければ空）
+static std::deque<ModelSkeleton> g_modelSkeleton;                  //骨格（ボーンが無ければ空）
+static RenderSamplerState* g_samplerState;                         //デフォルトサンプラーステート
 //キーマップ
 static KeyMap TextureMap;
 static KeyMap ModelMap;
+static int g_textureLastIndex = -1;    // 直前に返したテクスチャ（同じ名前が続く場合は検索しない）
 
-ID3D11ShaderResourceView* GetTextureSRV(const char* filename)
+RenderShaderResourceView* GetTextureSRV(const char* filename)
 {
     if (!filename) return nullptr;
+    int index = g_textureLastIndex;
+    if (index >= 0 && index < (int)g_textureSRV.size() && g_textureSRV[index]) {
+        const char* key = KeyMap_GetKey(&TextureMap, index);
+        if (key && strcmp(key, filename) == 0) return g_textureSRV[index];
+    }
     // すでに登録済みならそのSRVを返す
-    int index = KeyMap_GetIndex(&TextureMap, filename);
-    if (index >= 0 && index < (int)g_textureSRV.size()) {
+    index = KeyMap_GetIndex(&TextureMap, filename);
+    if (index >= 0 && index < (int)g_textureSRV.size() && g_textureSRV[index]) {
+        g_textureLastIndex = index;
         return g_textureSRV[index];
     }
 
+    // 非同期読み込み中なら完了を待つ
+    if (AL_IsLoadPending(filename)) {
+        AL_WaitAsyncLoads();
+        index = KeyMap_GetIndex(&TextureMap, filename);
+        if (index >= 0 && index < (int)g_textureSRV.size() && g_textureSRV[index]) return g_textureSRV[index];
+    }
+
     // pkgから読み込み
     if (!AL_LoadFromPackageByName(filename)) {
-        MessageBoxA(nullptr, ("Texture not found: " + std::string(filename)).c_str(), "AssetManager", MB_OK);
+        System_MessageBox(("Texture not found: " + std::string(filename)).c_str(), "AssetManager");
         return nullptr;
     }
 
     // KeyMapが更新されているはずなので再取得
     index = KeyMap_GetIndex(&TextureMap, filename);
-    if (index < 0 || index >= (int)g_textureSRV.size()) {
-        MessageBoxA(nullptr, "GetOrLoadTextureSRV: invalid index after load", "Error", MB_OK);
+    if (index < 0 || index >= (int)g_textureSRV.size() || !g_textureSRV[index]) {
+        System_MessageBox("GetOrLoadTextureSRV: invalid index after load", "Error");
         return nullptr;
     }
 
     return g_textureSRV[index];
 }
+// ================================================================
+// Texture 参照カウント（シーンのストリーミング用）
+// |  AddRef は登録だけで読み込まない（読み込みは GetTextureSRV / 非同期ロード）
+// |  参照が 0 になったら SRV と pkg のキャッシュを解放。インデックスは残す
+// ================================================================
+int Texture_AddRef(const char* name)
+{
+    if (!name) return 0;
+    int index = KeyMap_GetIndex(&TextureMap, name);
+    if (index < 0) index = KeyMap_Add(&TextureMap, name);
+    if (index < 0) return 0;
+    if ((int)g_textureSRV.size() <= index) g_textureSRV.resize(index + 1, nullptr);
+    if ((int)g_textureRef.size() <= index) g_textureRef.resize(index + 1, 0);
+    return ++g_textureRef[index];
+}
+
+int Texture_Release(const char* name)
+{
+    if (!name) return 0;
+    int index = KeyMap_GetIndex(&TextureMap, name);
+    if (index < 0 || index >= (int)g_textureRef.size() || g_textureRef[index] <= 0) return 0;
+    if (--g_textureRef[index] > 0) return g_textureRef[index];
+
+    if (AL_IsLoadPending(name)) AL_WaitAsyncLoads();
+    if (index < (int)g_textureSRV.size()) SafeRelease(g_textureSRV[index]);
+    AL_UnloadFromPackage(name);
+    return 0;
+}
+
+bool Texture_IsResident(const char* name)
+{
+    if (!name) return false;
+    int index = KeyMap_GetIndex(&TextureMap, name);
+    return index >= 0 && index < (int)g_textureSRV.size() && g_textureSRV[index];
+}
+
 // ================================================================
 // FBX / OBJ 取得
+// |  未読み込みなら pkg から読む（テクスチャと同じ）
 // ================================================================
-const std::vector<ModelVertex>* GetModelVertices(const char* name)
+static int Model_Find(const char* name)
 {
+    if (!name || !*name) return -1;
     int index = KeyMap_GetIndex(&ModelMap, name);
-    if (index < 0 || index >= (int)g_modelVertex.size()) return nullptr;
-    return &g_modelVertex[index];
+    if (index < 0 && AL_LoadFromPackageByName(name)) index = KeyMap_GetIndex(&ModelMap, name);
+    if (index < 0 || index >= (int)g_modelVertex.size()) return -1;
+    return index;
+}
+
+const std::vector<ModelVertex>* GetModelVertices(const char* name)
+{
+    int index = Model_Find(name);
+    return index < 0 ? nullptr : &g_modelVertex[index];
+}
+
+const std::vector<ModelSkinVertex>* GetModelSkin(const char* name)
+{
+    int index = Model_Find(name);
+    return (index < 0 || g_modelSkin[index].empty()) ? nullptr : &g_modelSkin[index];
+}
+
+const ModelSkeleton* GetModelSkeleton(const char* name)
+{
+    int index = Model_Find(name);
+    return (index < 0 || g_modelSkeleton[index].BoneNode.empty()) ? nullptr : &g_modelSkeleton[index];
+}
+
+const AnimPackedClip* GetModelClip(const char* name, int clip)
+{
+    // クリップは AnimationManager の共有キャッシュ（モデルの読み込みで登録される）
+    if (Model_Find(name) < 0 || clip < 0) return nullptr;
+    if (clip == 0) return GetAnimClip(name);
+    return GetAnimClip(FrameFormat("%s#%d", name, clip));
 }
 
 
 // ================================================================
-// Texture メモリロード
+// Texture デコード（WIC / 任意のスレッドから呼べる）
+// |  WIC の無い環境（ヘッドレスのベンチ）は PNG のヘッダーから大きさだけ読み、白で埋める
 // ================================================================
-bool IN_LoadTexture_Memory(const char* name, const unsigned char* data, size_t size)
+bool IN_DecodeTexture_Memory(const unsigned char* data, size_t size,
+    std::vector<unsigned char>& pixels, unsigned& width, unsigned& height)
 {
     if (!data || size == 0) return false;
 
-    if (!GetDevice())
-    {
-        MessageBoxA(nullptr, "Device is NULL in IN_LoadTexture_Memory", "Error", MB_OK);
-        return false;
-    }
-
-    int TextureIndex = KeyMap_Add(&TextureMap, name);
-    if ((int)g_textureSRV.size() <= TextureIndex)
-        g_textureSRV.resize(TextureIndex + 1, nullptr);
-
+#if defined(_WIN32)
     IWICImagingFactory* pWIC = nullptr;
     IWICStream* pStream = nullptr;
     IWICBitmapDecoder* pDecoder = nullptr;
@@ -101,88 +184,442 @@ bool IN_LoadTexture_Memory(const char* name, const unsigned char* data, size_t s
 
     HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pWIC));
     if (FAILED(hr)) {
-        HRESULT hrInit = CoInitialize(nullptr);
+        // ワーカースレッドは COM 未初期化なので MTA で初期化
+        HRESULT hrInit = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
         if (SUCCEEDED(hrInit)) calledCoInit = true;
         hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pWIC));
-        if (FAILED(hr)) {
-            if (calledCoInit) CoUninitialize();
-            return false;
-        }
     }
 
-    hr = pWIC->CreateStream(&pStream);
-    if (FAILED(hr)) return false;
-    hr = pStream->InitializeFromMemory((WICInProcPointer)data, (DWORD)size);
-    if (FAILED(hr)) return false;
+    if (SUCCEEDED(hr)) hr = pWIC->CreateStream(&pStream);
+    if (SUCCEEDED(hr)) hr = pStream->InitializeFromMemory((WICInProcPointer)data, (DWORD)size);
+    if (SUCCEEDED(hr)) hr = pWIC->CreateDecoderFromStream(pStream, nullptr, WICDecodeMetadataCacheOnLoad, &pDecoder);
+    if (SUCCEEDED(hr)) hr = pDecoder->GetFrame(0, &pFrame);
+    if (SUCCEEDED(hr)) hr = pWIC->CreateFormatConverter(&pConverter);
+    if (SUCCEEDED(hr)) hr = pConverter->Initialize(pFrame, GUID_WICPixelFormat32bppRGBA,
+        WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
 
-    hr = pWIC->CreateDecoderFromStream(pStream, nullptr, WICDecodeMetadataCacheOnLoad, &pDecoder);
-    if (FAILED(hr)) return false;
-    hr = pDecoder->GetFrame(0, &pFrame);
-    if (FAILED(hr)) return false;
+    if (SUCCEEDED(hr)) {
+        unsigned w = 0, h = 0;
+        pConverter->GetSize(&w, &h);
+        pixels.resize((size_t)w * h * 4);
+        hr = pConverter->CopyPixels(nullptr, w * 4, (unsigned)pixels.size(), pixels.data());
+        width = w;
+        height = h;
+    }
 
-    hr = pWIC->CreateFormatConverter(&pConverter);
-    if (FAILED(hr)) return false;
-    hr = pConverter->Initialize(pFrame, GUID_WICPixelFormat32bppRGBA,
-        WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
-    if (FAILED(hr)) return false;
+    SafeRelease(pConverter);
+    SafeRelease(pFrame);
+    SafeRelease(pDecoder);
+    SafeRelease(pStream);
+    SafeRelease(pWIC);
+    if (calledCoInit) CoUninitialize();
+
+    return SUCCEEDED(hr);
+#else
+    // シグネチャ 8 バイト + IHDR（長さ 4 / 種類 4 / 幅 4 / 高さ 4、ビッグエンディアン）
+    static const unsigned char sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (size < 24 || memcmp(data, sig, 8) != 0 || memcmp(data + 12, "IHDR", 4) != 0) return false;
+    auto be32 = [](const unsigned char* p) { return ((unsigned)p[0] << 24) | ((unsigned)p[1] << 16) | ((unsigned)p[2] << 8) | p[3]; };
+    unsigned w = be32(data + 16), h = be32(data + 20);
+    if (w == 0 || h == 0) return false;
+    pixels.assign((size_t)w * h * 4, 0xFF);
+    width = w;
+    height = h;
+    return true;
+#endif
+}
+
+// ================================================================
+// Texture 登録（デコード済みピクセル → SRV / メインスレッド）
+// ================================================================
+bool IN_UploadTexture(const char* name, const unsigned char* pixels, unsigned width, unsigned height)
+{
+    if (!name || !pixels || width == 0 || height == 0) return false;
 
-    UINT width, height;
-    pConverter->GetSize(&width, &height);
-    std::vector<BYTE> pixels(width * height * 4);
-    pConverter->CopyPixels(nullptr, width * 4, (UINT)pixels.size(), pixels.data());
+    if (!GetDevice())
+    {
+        System_MessageBox("Device is NULL in IN_UploadTexture", "Error");
+        return false;
+    }
 
-    D3D11_TEXTURE2D_DESC desc = {};
+    // 解放済みの再読み込みは同じインデックスへ
+    int TextureIndex = KeyMap_GetIndex(&TextureMap, name);
+    if (TextureIndex < 0) TextureIndex = KeyMap_Add(&TextureMap, name);
+    if ((int)g_textureSRV.size() <= TextureIndex)
+        g_textureSRV.resize(TextureIndex + 1, nullptr);
+
+    RenderTexture2DDesc desc = {};
     desc.Width = width;
     desc.Height = height;
     desc.MipLevels = 1;
-    desc.ArraySize = 1;
-    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    desc.SampleDesc.Count = 1;
-    desc.Usage = D3D11_USAGE_DEFAULT;
-    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = pixels.data();
+    desc.Format = RenderFormat_R8G8B8A8_UNorm;
+    desc.Usage = RenderUsage_Default;
+    desc.BindFlags = RenderBind_ShaderResource;
+
+    RenderSubresourceData initData = {};
+    initData.pSysMem = pixels;
     initData.SysMemPitch = width * 4;
 
-    ID3D11Texture2D* texture = nullptr;
-    hr = GetDevice()->CreateTexture2D(&desc, &initData, &texture);
-    if (FAILED(hr)) return false;
+    RenderTexture2D* texture = nullptr;
+    if (!GetDevice()->CreateTexture2D(&desc, &initData, &texture)) return false;
 
-    ID3D11ShaderResourceView* srv = nullptr;
-    hr = GetDevice()->CreateShaderResourceView(texture, nullptr, &srv);
-    if (FAILED(hr)) { texture->Release(); return false; }
+    RenderShaderResourceView* srv = nullptr;
+    if (!GetDevice()->CreateShaderResourceView(texture, &srv)) { texture->Release(); return false; }
 
+    SafeRelease(g_textureSRV[TextureIndex]);
     g_textureSRV[TextureIndex] = srv;
 
     SafeRelease(texture);
-    SafeRelease(pConverter);
-    SafeRelease(pFrame);
-    SafeRelease(pDecoder);
-    SafeRelease(pStream);
-    SafeRelease(pWIC);
-    if (calledCoInit) CoUninitialize();
-
     return true;
 }
 
 // ================================================================
-// Obj / FBX メモリロード（Assimp利用）
+// Texture メモリロード（同期: デコード + 登録）
 // ================================================================
-static bool LoadModel_Assimp_FromMemory(const char* name, const unsigned char* data, size_t size, bool isFBX)
+bool IN_LoadTexture_Memory(const char* name, const unsigned char* data, size_t size)
 {
     if (!data || size == 0) return false;
 
-    // 既にロード済みか？
-    int mapSize = KeyMap_GetSize(&ModelMap);
-    for (int i = 0; i < mapSize; ++i) {
-        const char* key = KeyMap_GetKey(&ModelMap, i);
-        if (strcmp(key, name) == 0) return true;
+    if (!GetDevice())
+    {
+        System_MessageBox("Device is NULL in IN_LoadTexture_Memory", "Error");
+        return false;
+    }
+
+    std::vector<unsigned char> pixels;
+    unsigned width = 0, height = 0;
+    if (!IN_DecodeTexture_Memory(data, size, pixels, width, height)) return false;
+    return IN_UploadTexture(name, pixels.data(), width, height);
+}
+
+// ================================================================
+// モデルの BVH（レイ判定用）
+// |  頂点は3つずつ三角形（Triangulate 済み）。葉は三角形 MESH_BVH_LEAF 個以下
+// |  ノードは深さ優先で並べる（左の子は次のノード、右の子は Right）
+// ================================================================
+#define MESH_BVH_LEAF 4
+
+struct MeshBVHNode {
+    XMFLOAT3 Min, Max;
+    int Start, Count;       // 葉のみ: Tris の範囲
+    int Right;              // 内部ノードのみ
+};
+struct MeshBVH {
+    std::vector<MeshBVHNode> Nodes;
+    std::vector<int> Tris;  // 三角形番号（葉の順）
+};
+static std::vector<MeshBVH> g_modelBVH;     // ModelMap と同じ並び（読み込み時に作成）
+
+static int MeshBVH_BuildNode(MeshBVH& bvh, const std::vector<XMFLOAT3>& centroid, const std::vector<ModelVertex>& v, int begin, int end)
+{
+    int node = (int)bvh.Nodes.size();
+    bvh.Nodes.push_back({});
+    XMVECTOR mn = XMVectorReplicate(FLT_MAX), mx = XMVectorReplicate(-FLT_MAX);
+    XMVECTOR cmn = mn, cmx = mx;
+    for (int i = begin; i < end; ++i) {
+        int t = bvh.Tris[i];
+        for (int k = 0; k < 3; ++k) {
+            XMVECTOR p = XMLoadFloat3(&v[t * 3 + k].pos);
+            mn = XMVectorMin(mn, p);
+            mx = XMVectorMax(mx, p);
+        }
+        XMVECTOR c = XMLoadFloat3(&centroid[t]);
+        cmn = XMVectorMin(cmn, c);
+        cmx = XMVectorMax(cmx, c);
+    }
+    XMStoreFloat3(&bvh.Nodes[node].Min, mn);
+    XMStoreFloat3(&bvh.Nodes[node].Max, mx);
+
+    if (end - begin <= MESH_BVH_LEAF) {
+        bvh.Nodes[node].Start = begin;
+        bvh.Nodes[node].Count = end - begin;
+        return node;
+    }
+
+    // 重心の広がりが一番大きい軸の中央値で分ける
+    XMFLOAT3 ext;
+    XMStoreFloat3(&ext, XMVectorSubtract(cmx, cmn));
+    int axis = (ext.x >= ext.y && ext.x >= ext.z) ? 0 : (ext.y >= ext.z ? 1 : 2);
+    int mid = (begin + end) / 2;
+    std::nth_element(bvh.Tris.begin() + begin, bvh.Tris.begin() + mid, bvh.Tris.begin() + end, [&](int a, int b)
+    {
+        return (&centroid[a].x)[axis] < (&centroid[b].x)[axis];
+    });
+
+    bvh.Nodes[node].Count = 0;
+    MeshBVH_BuildNode(bvh, centroid, v, begin, mid);
+    int right = MeshBVH_BuildNode(bvh, centroid, v, mid, end);
+    bvh.Nodes[node].Right = right;
+    return node;
+}
+
+static void MeshBVH_Build(MeshBVH& bvh, const std::vector<ModelVertex>& v)
+{
+    bvh.Nodes.clear();
+    bvh.Tris.clear();
+    int triCount = (int)(v.size() / 3);
+    if (triCount == 0) return;
+
+    std::vector<XMFLOAT3> centroid(triCount);
+    bvh.Tris.resize(triCount);
+    for (int t = 0; t < triCount; ++t) {
+        XMVECTOR c = XMVectorAdd(XMVectorAdd(XMLoadFloat3(&v[t * 3].pos), XMLoadFloat3(&v[t * 3 + 1].pos)), XMLoadFloat3(&v[t * 3 + 2].pos));
+        XMStoreFloat3(&centroid[t], XMVectorScale(c, 1.0f / 3.0f));
+        bvh.Tris[t] = t;
+    }
+    bvh.Nodes.reserve((size_t)triCount * 2 / MESH_BVH_LEAF + 1);
+    MeshBVH_BuildNode(bvh, centroid, v, 0, triCount);
+}
+
+// 箱に入る距離（外れなら false）
+static bool MeshBVH_RayBox(const MeshBVHNode& n, const float o[3], const float inv[3], float maxDist, float* tmin)
+{
+    float t0 = 0.0f, t1 = maxDist;
+    const float* mn = &n.Min.x;
+    const float* mx = &n.Max.x;
+    for (int k = 0; k < 3; ++k) {
+        float a = (mn[k] - o[k]) * inv[k];
+        float b = (mx[k] - o[k]) * inv[k];
+        if (a > b) std::swap(a, b);
+        t0 = a > t0 ? a : t0;
+        t1 = b < t1 ? b : t1;
+        if (t0 > t1) return false;
+    }
+    *tmin = t0;
+    return true;
+}
+
+// 三角形（両面、Moller-Trumbore）
+static bool MeshBVH_RayTri(FXMVECTOR o, FXMVECTOR d, const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2, float* t)
+{
+    XMVECTOR a = XMLoadFloat3(&p0);
+    XMVECTOR e1 = XMVectorSubtract(XMLoadFloat3(&p1), a);
+    XMVECTOR e2 = XMVectorSubtract(XMLoadFloat3(&p2), a);
+    XMVECTOR pv = XMVector3Cross(d, e2);
+    float det = XMVectorGetX(XMVector3Dot(e1, pv));
+    if (fabsf(det) < 1e-12f) return false;
+    float inv = 1.0f / det;
+    XMVECTOR tv = XMVectorSubtract(o, a);
+    float u = XMVectorGetX(XMVector3Dot(tv, pv)) * inv;
+    if (u < 0.0f || u > 1.0f) return false;
+    XMVECTOR qv = XMVector3Cross(tv, e1);
+    float w = XMVectorGetX(XMVector3Dot(d, qv)) * inv;
+    if (w < 0.0f || u + w > 1.0f) return false;
+    *t = XMVectorGetX(XMVector3Dot(e2, qv)) * inv;
+    return *t >= 0.0f;
+}
+
+bool RaycastModelMesh(const char* modelName, const Vec4& origin, const Vec4& dir, float maxDist, float* distance, Vec4* normal)
+{
+    int index = KeyMap_GetIndex(&ModelMap, modelName);
+    if (index < 0 || index >= (int)g_modelBVH.size() || g_modelBVH[index].Nodes.empty()) return false;
+    const MeshBVH& bvh = g_modelBVH[index];
+    const std::vector<ModelVertex>& v = g_modelVertex[index];
+
+    const float o[3] = { origin.X, origin.Y, origin.Z };
+    const float d[3] = { dir.X, dir.Y, dir.Z };
+    float inv[3];
+    for (int k = 0; k < 3; ++k) inv[k] = d[k] != 0.0f ? 1.0f / d[k] : FLT_MAX;
+    XMVECTOR ov = XMVectorSet(o[0], o[1], o[2], 0.0f);
+    XMVECTOR dv = XMVectorSet(d[0], d[1], d[2], 0.0f);
+
+    float best = maxDist;
+    int bestTri = -1;
+    int stack[64];
+    int sp = 0;
+    stack[sp++] = 0;
+    while (sp > 0) {
+        const MeshBVHNode& n = bvh.Nodes[stack[--sp]];
+        float tBox;
+        if (!MeshBVH_RayBox(n, o, inv, best, &tBox)) continue;
+        if (n.Count > 0) {
+            for (int i = n.Start; i < n.Start + n.Count; ++i) {
+                int tri = bvh.Tris[i];
+                float t;
+                if (MeshBVH_RayTri(ov, dv, v[tri * 3].pos, v[tri * 3 + 1].pos, v[tri * 3 + 2].pos, &t) && t < best) {
+                    best = t;
+                    bestTri = tri;
+                }
+            }
+            continue;
+        }
+        // 近い方の子を後に積んで先に調べる
+        int left = (int)(&n - bvh.Nodes.data()) + 1;
+        int right = n.Right;
+        float tl, tr;
+        bool hl = MeshBVH_RayBox(bvh.Nodes[left], o, inv, best, &tl);
+        bool hr = MeshBVH_RayBox(bvh.Nodes[right], o, inv, best, &tr);
+        if (sp + 2 > 64) continue;
+        if (hl && hr) {
+            if (tl < tr) { stack[sp++] = right; stack[sp++] = left; }
+            else         { stack[sp++] = left;  stack[sp++] = right; }
+        }
+        else if (hl) stack[sp++] = left;
+        else if (hr) stack[sp++] = right;
+    }
+    if (bestTri < 0) return false;
+
+    if (distance) *distance = best;
+    if (normal) {
+        XMVECTOR a = XMLoadFloat3(&v[bestTri * 3].pos);
+        XMVECTOR nv = XMVector3Normalize(XMVector3Cross(
+            XMVectorSubtract(XMLoadFloat3(&v[bestTri * 3 + 1].pos), a),
+            XMVectorSubtract(XMLoadFloat3(&v[bestTri * 3 + 2].pos), a)));
+        if (XMVectorGetX(XMVector3Dot(nv, dv)) > 0.0f) nv = XMVectorNegate(nv);    // レイ側を向ける
+        *normal = { XMVectorGetX(nv), XMVectorGetY(nv), XMVectorGetZ(nv), 0.0f };
+    }
+    return true;
+}
+
+bool GetModelMeshBounds(const char* modelName, Vec4* min, Vec4* max)
+{
+    int index = KeyMap_GetIndex(&ModelMap, modelName);
+    if (index < 0 || index >= (int)g_modelBVH.size() || g_modelBVH[index].Nodes.empty()) return false;
+    const MeshBVHNode& root = g_modelBVH[index].Nodes[0];
+    if (min) *min = { root.Min.x, root.Min.y, root.Min.z, 0.0f };
+    if (max) *max = { root.Max.x, root.Max.y, root.Max.z, 0.0f };
+    return true;
+}
+
+// ================================================================
+// 変換済みモデルの登録
+// |  Assimp の読み込みもここを通る（手で作った骨格 / クリップもそのまま登録できる）
+// |  skin / skel はボーンが無ければ空でよい。同名が登録済みなら何もしない
+// ================================================================
+bool IN_RegisterModel(const char* name, std::vector<ModelVertex>&& verts, std::vector<ModelSkinVertex>&& skin,
+    ModelSkeleton&& skel, std::vector<AnimClip>&& clips)
+{
+    if (!name || !*name) return false;
+    if (KeyMap_GetIndex(&ModelMap, name) >= 0) return true;
+    if (!skin.empty() && skin.size() != verts.size()) {
+        AddMessage(ConcatCStr("IN_RegisterModel: skin size mismatch ", name));
+        return false;
     }
 
     int ModelIndex = KeyMap_Add(&ModelMap, name);
-    if ((int)g_modelVertex.size() <= ModelIndex)
+    if ((int)g_modelVertex.size() <= ModelIndex) {
         g_modelVertex.resize(ModelIndex + 1);
+        g_modelSkin.resize(ModelIndex + 1);
+        g_modelSkeleton.resize(ModelIndex + 1);
+        g_modelBVH.resize(ModelIndex + 1);
+    }
+    g_modelVertex[ModelIndex] = std::move(verts);
+    g_modelSkin[ModelIndex] = std::move(skin);
+    g_modelSkeleton[ModelIndex] = std::move(skel);
+    for (size_t i = 0; i < clips.size(); ++i) {
+        std::string key = i == 0 ? std::string(name) : std::string(name) + "#" + std::to_string(i);
+        AddAnimClip(key.c_str(), std::move(clips[i]));
+    }
+    MeshBVH_Build(g_modelBVH[ModelIndex], g_modelVertex[ModelIndex]);
+    return true;
+}
+
+// ================================================================
+// Obj / FBX メモリロード（Assimp利用）
+// |  骨格とアニメーションもここで実行時の形に変換する（再生中は Assimp を使わない）
+// |  メッシュの無い FBX はアニメーションだけのファイルとして読む（AddMotion 用）
+// |  LIA_NO_ASSIMP（assimp の無いビルド）では読み込みに失敗する
+// ================================================================
+#if !defined(LIA_NO_ASSIMP)
+// Assimp は列ベクトル用なので転置して行ベクトル用に
+static XMFLOAT4X4 Model_ToMatrix(const aiMatrix4x4& m)
+{
+    return XMFLOAT4X4(
+        m.a1, m.b1, m.c1, m.d1,
+        m.a2, m.b2, m.c2, m.d2,
+        m.a3, m.b3, m.c3, m.d3,
+        m.a4, m.b4, m.c4, m.d4);
+}
+
+// ノード階層を親が先の順に並べる
+static void Model_AddNode(ModelSkeleton& skel, const aiNode* node, int parent)
+{
+    int index = (int)skel.NodeName.size();
+    aiVector3D s, p;
+    aiQuaternion r;
+    node->mTransformation.Decompose(s, r, p);
+    skel.NodeName.push_back(node->mName.C_Str());
+    skel.Parent.push_back(parent);
+    skel.BindPos.push_back({ p.x, p.y, p.z });
+    skel.BindRot.push_back({ r.x, r.y, r.z, r.w });
+    skel.BindScale.push_back({ s.x, s.y, s.z });
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) Model_AddNode(skel, node->mChildren[i], index);
+}
+
+// 頂点の影響を重い順に 4 本まで残す
+static void Model_AddWeight(ModelSkinVertex& v, unsigned short bone, float weight)
+{
+    int slot = 3;
+    for (int k = 0; k < 4; ++k) if (v.weight[k] < v.weight[slot]) slot = k;
+    if (weight <= v.weight[slot]) return;
+    v.bone[slot] = bone;
+    v.weight[slot] = weight;
+}
+
+// メッシュ1つ分のボーン（頂点番号ごと）。ボーンは骨格の BoneNode へ名前で登録
+static void Model_ReadBones(ModelSkeleton& skel, const std::unordered_map<std::string, int>& nodeOf,
+    const aiMesh* mesh, std::vector<ModelSkinVertex>& out)
+{
+    out.assign(mesh->mNumVertices, ModelSkinVertex{});
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiBone* bone = mesh->mBones[b];
+        auto it = nodeOf.find(bone->mName.C_Str());
+        if (it == nodeOf.end()) continue;
+
+        int boneIndex = (int)(std::find(skel.BoneNode.begin(), skel.BoneNode.end(), it->second) - skel.BoneNode.begin());
+        if (boneIndex == (int)skel.BoneNode.size()) {
+            skel.BoneNode.push_back(it->second);
+            skel.BoneOffset.push_back(Model_ToMatrix(bone->mOffsetMatrix));
+        }
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& vw = bone->mWeights[w];
+            if (vw.mVertexId < mesh->mNumVertices) Model_AddWeight(out[vw.mVertexId], (unsigned short)boneIndex, vw.mWeight);
+        }
+    }
+    for (ModelSkinVertex& v : out) {
+        float sum = v.weight[0] + v.weight[1] + v.weight[2] + v.weight[3];
+        if (sum > 0.0f) for (int k = 0; k < 4; ++k) v.weight[k] /= sum;
+    }
+}
+
+static void Model_ReadClips(const aiScene* scene, std::vector<AnimClip>& out)
+{
+    for (unsigned int a = 0; a < scene->mNumAnimations; ++a) {
+        const aiAnimation* anim = scene->mAnimations[a];
+        double tps = anim->mTicksPerSecond > 0.0 ? anim->mTicksPerSecond : 25.0;
+        AnimClip clip;
+        clip.Duration = (float)(anim->mDuration / tps);
+        clip.Tracks.resize(anim->mNumChannels);
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            const aiNodeAnim* ch = anim->mChannels[c];
+            AnimTrack& t = clip.Tracks[c];
+            t.NodeName = ch->mNodeName.C_Str();
+            for (unsigned int k = 0; k < ch->mNumPositionKeys; ++k) {
+                const aiVectorKey& key = ch->mPositionKeys[k];
+                t.PosTime.push_back((float)(key.mTime / tps));
+                t.Pos.push_back({ key.mValue.x, key.mValue.y, key.mValue.z });
+            }
+            for (unsigned int k = 0; k < ch->mNumRotationKeys; ++k) {
+                const aiQuatKey& key = ch->mRotationKeys[k];
+                t.RotTime.push_back((float)(key.mTime / tps));
+                t.Rot.push_back({ key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w });
+            }
+            for (unsigned int k = 0; k < ch->mNumScalingKeys; ++k) {
+                const aiVectorKey& key = ch->mScalingKeys[k];
+                t.ScaleTime.push_back((float)(key.mTime / tps));
+                t.Scale.push_back({ key.mValue.x, key.mValue.y, key.mValue.z });
+            }
+        }
+        out.push_back(std::move(clip));
+    }
+}
+
+static bool LoadModel_Assimp_FromMemory(const char* name, const unsigned char* data, size_t size, bool isFBX)
+{
+    if (!data || size == 0) return false;
+
+    // 既にロード済みか？
+    if (KeyMap_GetIndex(&ModelMap, name) >= 0) return true;
 
     Assimp::Importer importer;
 
@@ -193,17 +630,33 @@ static bool LoadModel_Assimp_FromMemory(const char* name, const unsigned char* d
         aiProcess_GenNormals |
         aiProcess_CalcTangentSpace |
         aiProcess_JoinIdenticalVertices |
+        aiProcess_LimitBoneWeights |
         aiProcess_ConvertToLeftHanded,
         isFBX ? "fbx" : "obj"
     );
 
-    if (!scene || !scene->HasMeshes()) {
+    if (!scene || (!scene->HasMeshes() && !scene->HasAnimations())) {
         std::string err = importer.GetErrorString();
-        MessageBoxA(nullptr, ("Assimp: " + err).c_str(), "LoadModel_Memory Error", MB_OK);
+        System_MessageBox(("Assimp: " + err).c_str(), "LoadModel_Memory Error");
         return false;
     }
 
+    // 骨格（どれかのメッシュにボーンがあるときだけ）
+    ModelSkeleton skel;
+    std::unordered_map<std::string, int> nodeOf;
+    bool hasBones = false;
+    for (unsigned int mi = 0; mi < scene->mNumMeshes; ++mi)
+        if (scene->mMeshes[mi] && scene->mMeshes[mi]->HasBones()) hasBones = true;
+    if (hasBones && scene->mRootNode) {
+        Model_AddNode(skel, scene->mRootNode, -1);
+        for (int i = 0; i < (int)skel.NodeName.size(); ++i) nodeOf.emplace(skel.NodeName[i], i);
+        aiMatrix4x4 inv = scene->mRootNode->mTransformation;
+        skel.GlobalInverse = Model_ToMatrix(inv.Inverse());
+    }
+
     std::vector<ModelVertex> outVerts;
+    std::vector<ModelSkinVertex> outSkin;
+    std::vector<ModelSkinVertex> meshSkin;
 
     for (unsigned int mi = 0; mi < scene->mNumMeshes; ++mi)
     {
@@ -212,6 +665,7 @@ static bool LoadModel_Assimp_FromMemory(const char* name, const unsigned char* d
 
         bool hasNormals = mesh->HasNormals();
         bool hasTexCoords = mesh->HasTextureCoords(0);
+        if (hasBones) Model_ReadBones(skel, nodeOf, mesh, meshSkin);
 
         for (unsigned int f = 0; f < mesh->mNumFaces; ++f)
         {
@@ -229,12 +683,14 @@ static bool LoadModel_Assimp_FromMemory(const char* name, const unsigned char* d
                 else
                     v.uv = DirectX::XMFLOAT2(0, 0);
                 outVerts.push_back(v);
+                if (hasBones) outSkin.push_back(meshSkin[vi]);
             }
         }
     }
 
-    g_modelVertex[ModelIndex] = std::move(outVerts);
-    return true;
+    std::vector<AnimClip> clips;
+    Model_ReadClips(scene, clips);
+    return IN_RegisterModel(name, std::move(outVerts), std::move(outSkin), std::move(skel), std::move(clips));
 }
 
 // ================================================================
@@ -249,13 +705,36 @@ bool IN_LoadModelObj_Memory(const char* name, const unsigned char* data, size_t
 {
     return LoadModel_Assimp_FromMemory(name, data, size, false);
 }
+#else
+bool IN_LoadFBX_Memory(const char* name, const unsigned char*, size_t)
+{
+    AddMessage(ConcatCStr("LIA_NO_ASSIMP: FBX は読み込めません: ", name));
+    return false;
+}
+
+bool IN_LoadModelObj_Memory(const char* name, const unsigned char*, size_t)
+{
+    AddMessage(ConcatCStr("LIA_NO_ASSIMP: OBJ は読み込めません: ", name));
+    return false;
+}
+#endif
 
 // ================================================================
 // WAV メモリロード
 // ================================================================
+// WAVEFORMATEX と同じ並び（xaudio2 へそのまま渡せる）
+struct WavFormat {
+    uint16_t wFormatTag;
+    uint16_t nChannels;
+    uint32_t nSamplesPerSec;
+    uint32_t nAvgBytesPerSec;
+    uint16_t nBlockAlign;
+    uint16_t wBitsPerSample;
+    uint16_t cbSize;
+};
 struct WavData {
-    std::vector<BYTE> buffer;
-    WAVEFORMATEX format = {};
+    std::vector<unsigned char> buffer;
+    WavFormat format = {};
 };
 
 static std::vector<WavData> g_wavData;
@@ -276,13 +755,13 @@ bool IN_LoadWav_Memory(const char* name, const unsigned char* data, size_t size)
     if ((int)g_wavData.size() <= WavIndex)
         g_wavData.resize(WavIndex + 1);
 
-    const BYTE* ptr = data;
+    const unsigned char* ptr = data;
     // RIFFチャンク確認
     if (size < 44 || strncmp((const char*)ptr, "RIFF", 4) != 0 || strncmp((const char*)(ptr + 8), "WAVE", 4) != 0)
         return false;
 
-    const BYTE* fmtChunk = nullptr;
-    const BYTE* dataChunk = nullptr;
+    const unsigned char* fmtChunk = nullptr;
+    const unsigned char* dataChunk = nullptr;
     size_t dataSize = 0;
 
     size_t pos = 12;
@@ -296,7 +775,7 @@ bool IN_LoadWav_Memory(const char* name, const unsigned char* data, size_t size)
 
     if (!fmtChunk || !dataChunk) return false;
 
-    WAVEFORMATEX fmt = {};
+    WavFormat fmt = {};
     fmt.wFormatTag = *(uint16_t*)(fmtChunk + 0);
     fmt.nChannels = *(uint16_t*)(fmtChunk + 2);
     fmt.nSamplesPerSec = *(uint32_t*)(fmtChunk + 4);
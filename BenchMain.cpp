@@ -0,0 +1,20 @@
+﻿// BenchMain.cpp
+// lia_bench の入口（CMakeLists.txt でのみビルド。Visual Studio のプロジェクトは Main.cpp の WinMain から --bench で入る）
+// |  引数は WinMain のコマンドラインと同じ形に繋いで Bench_Main へ渡す
+// |  例) lia_bench --bench bench/basic.txt 60 --out saved/bench/report.txt
+// __________________________________________
+
+#include "BenchRunner.h"
+
+#include <string>
+
+int main(int argc, char** argv)
+{
+    std::string cmdLine;
+    for (int i = 1; i < argc; ++i) {
+        if (!cmdLine.empty()) cmdLine += ' ';
+        cmdLine += argv[i];
+    }
+    if (cmdLine.find("--bench") == std::string::npos) cmdLine = "--bench " + cmdLine;
+    return Bench_Main(cmdLine.c_str());
+}
@@ -0,0 +1,1308 @@
+﻿// BenchRunner.cpp
+// ヘッドレスのベンチマーク実行（BenchRunner.h）
+// |  シーン構築 → 固定フレーム数を回し、区間ごとの時間を集計する
+// |  フレームの中身は UpdateDo / DrawDo と同じ順序を区間ごとに分けて呼ぶ
+// __________________________________________
+
+#include "BenchRunner.h"
+#include "Manager.h"
+#include "JobSystem.h"
+#include "AssetLoad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define BENCH_MAX_ZONES    32
+#define BENCH_MAX_COMMANDS 64
+#define BENCH_HEAP_WARMUP  10   // ヒープ確保の集計から外す最初のフレーム数（容量の伸び切り待ち）
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct BenchZoneStat {
+    const char* Name;
+    long long Total;
+    long long Max;
+    long long Frame;    // 現フレームの合計（Max 判定用）
+    unsigned Calls;
+    unsigned Units;     // 処理した個数（Bench_ZoneUnits、0 なら1個あたりは出さない）
+};
+
+struct BenchCommand {
+    const char* Name;
+    BenchSetupFn Setup;
+    BenchFrameFn Frame;
+    bool Used;          // スクリプトで使われたか（Frame を呼ぶか）
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static BenchZoneStat g_BenchZones[BENCH_MAX_ZONES];
+static int g_BenchZoneCount = 0;
+static BenchCommand g_BenchCommands[BENCH_MAX_COMMANDS];
+static int g_BenchCommandCount = 0;
+static unsigned g_BenchSeed = 12345;
+static int g_BenchFrames = 600;
+static long long g_BenchFreq = 0;
+
+// 組み込みコマンドで追加したオブジェクト名（animate 用）
+static std::vector<std::string> g_BenchSpriteWorld;
+static std::vector<std::string> g_BenchSpriteScreen;
+static std::vector<std::string> g_BenchCylinder;
+static std::vector<std::string> g_BenchGridBox;
+static std::vector<std::string> g_BenchInactive;   // 非アクティブシーンのオブジェクト（animate 対象外）
+static int g_BenchObjectCount = 0;
+
+//-----------------------------------------
+// 乱数 / 時間
+//-----------------------------------------
+unsigned Bench_Random()
+{
+    g_BenchSeed = g_BenchSeed * 1664525u + 1013904223u;
+    return g_BenchSeed >> 8;
+}
+
+float Bench_RandomRange(float min, float max)
+{
+    return min + (max - min) * (float)(Bench_Random() & 0xFFFF) / 65535.0f;
+}
+
+long long Bench_Now()
+{
+    return System_GetTicks();
+}
+
+static double Bench_ToMs(long long ticks)
+{
+    return (double)ticks * 1000.0 / (double)g_BenchFreq;
+}
+
+//-----------------------------------------
+// 区間
+//-----------------------------------------
+int Bench_ZoneBegin(const char* name)
+{
+    for (int i = 0; i < g_BenchZoneCount; ++i)
+        if (strcmp(g_BenchZones[i].Name, name) == 0) return i;
+    if (g_BenchZoneCount >= BENCH_MAX_ZONES) return -1;
+    g_BenchZones[g_BenchZoneCount] = { name, 0, 0, 0, 0, 0 };
+    return g_BenchZoneCount++;
+}
+
+void Bench_ZoneEnd(int zone, long long begin)
+{
+    if (zone < 0) return;
+    long long d = Bench_Now() - begin;
+    g_BenchZones[zone].Total += d;
+    g_BenchZones[zone].Frame += d;
+    g_BenchZones[zone].Calls++;
+}
+
+void Bench_ZoneUnits(const char* name, unsigned units)
+{
+    int zone = Bench_ZoneBegin(name);
+    if (zone >= 0) g_BenchZones[zone].Units += units;
+}
+
+static void Bench_ZoneFrameEnd()
+{
+    for (int i = 0; i < g_BenchZoneCount; ++i) {
+        BenchZoneStat& z = g_BenchZones[i];
+        if (z.Frame > z.Max) z.Max = z.Frame;
+        z.Frame = 0;
+    }
+}
+
+//-----------------------------------------
+// コマンド登録
+//-----------------------------------------
+void Bench_Register(const char* command, BenchSetupFn setup, BenchFrameFn frame)
+{
+    if (!command) return;
+    for (int i = 0; i < g_BenchCommandCount; ++i) {
+        if (strcmp(g_BenchCommands[i].Name, command) == 0) {
+            g_BenchCommands[i].Setup = setup;
+            g_BenchCommands[i].Frame = frame;
+            return;
+        }
+    }
+    if (g_BenchCommandCount >= BENCH_MAX_COMMANDS) {
+        AddMessage(ConcatCStr("Bench_Register: too many commands ", command));
+        return;
+    }
+    g_BenchCommands[g_BenchCommandCount++] = { command, setup, frame, false };
+}
+
+static BenchCommand* Bench_FindCommand(const char* name)
+{
+    for (int i = 0; i < g_BenchCommandCount; ++i)
+        if (strcmp(g_BenchCommands[i].Name, name) == 0) return &g_BenchCommands[i];
+    return nullptr;
+}
+
+//-----------------------------------------
+// 組み込みコマンド
+//-----------------------------------------
+static const char* Bench_Name(std::vector<std::string>& list, const char* prefix)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%s%d", prefix, (int)list.size());
+    list.push_back(name);
+    g_BenchObjectCount++;
+    return list.back().c_str();
+}
+
+// テクスチャのパス（パッケージへ登録してから返す。登録済みなら何もしない）
+static const char* Bench_Texture(const char* arg)
+{
+    const char* path = (arg && *arg) ? arg : "asset/test.png";
+    AL_RegisterAssetToBatch(path);
+    return path;
+}
+
+static void Bench_SetupSpriteWorld(int count, const char* arg)
+{
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchSpriteWorld, "BenchSW_");
+        AddSpriteWorld(name, Bench_Texture(arg));
+        SetSpriteWorldPos(name, Bench_RandomRange(-20, 20), Bench_RandomRange(-5, 5), Bench_RandomRange(-20, 20));
+        SetSpriteWorldSize(name, 1, 1, 1);
+        SetSpriteWorldColor(name, 1, 1, 1, 1);
+    }
+}
+
+static void Bench_SetupSpriteScreen(int count, const char* arg)
+{
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchSpriteScreen, "BenchSS_");
+        AddSpriteScreen(name, Bench_Texture(arg));
+        SetSpriteScreenPos(name, Bench_RandomRange(0, 800), Bench_RandomRange(0, 600));
+        SetSpriteScreenSize(name, 32, 32);
+        SetSpriteScreenColor(name, 1, 1, 1, 1);
+    }
+}
+
+static void Bench_SetupCylinder(int count, const char* arg)
+{
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchCylinder, "BenchCY_");
+        AddSpriteCylinder(name, Bench_Texture(arg));
+        SetSpriteCylinderPos(name, Bench_RandomRange(-20, 20), 0, Bench_RandomRange(-20, 20));
+        SetSpriteCylinderSize(name, 1, 2, 1);
+    }
+}
+
+static void Bench_SetupGridBox(int count, const char*)
+{
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchGridBox, "BenchGB_");
+        AddGridBox(name);
+        SetGridBoxPos(name, Bench_RandomRange(-20, 20), Bench_RandomRange(-5, 5), Bench_RandomRange(-20, 20));
+    }
+}
+
+static void Bench_SetupGridPolygon(int count, const char* arg)
+{
+    static int serial = 0;
+    int sides = (arg && *arg) ? atoi(arg) : 6;
+    for (int i = 0; i < count; ++i) {
+        char name[64];
+        snprintf(name, sizeof(name), "BenchGP_%d", serial++);
+        AddGridPolygon(name);
+        SetGridPolygonPos(name, Bench_RandomRange(-20, 20), 0, Bench_RandomRange(-20, 20));
+        SetGridPolygonSides(name, sides);
+        g_BenchObjectCount++;
+    }
+}
+
+// 非アクティブなシーンを count 個追加（各 arg 個の SpriteWorld、既定 1000）
+// |  計測対象は最初の "Bench" シーンのまま。以降の行は最後のシーンに入るためスクリプトの最後に書く
+static void Bench_SetupInactiveScenes(int count, const char* arg)
+{
+    int perScene = (arg && *arg) ? atoi(arg) : 1000;
+    SceneEndPoint();
+    for (int s = 0; s < count; ++s) {
+        char scene[64];
+        snprintf(scene, sizeof(scene), "BenchInactive_%d", s);
+        AddScene(scene);
+        for (int i = 0; i < perScene; ++i) {
+            const char* name = Bench_Name(g_BenchInactive, "BenchIN_");
+            AddSpriteWorld(name, Bench_Texture(nullptr));
+            SetSpriteWorldPos(name, Bench_RandomRange(-20, 20), Bench_RandomRange(-5, 5), Bench_RandomRange(-20, 20));
+        }
+        if (s + 1 < count) SceneEndPoint();
+    }
+}
+
+// "Bench" シーンを count 回複製（CopyScene の速度確認）
+// |  作成中のシーンはここで閉じられるため、スクリプトの最後に書く
+static void Bench_SetupCopyScene(int count, const char*)
+{
+    BenchZone z("CopyScene");
+    for (int i = 0; i < count; ++i) {
+        char scene[64];
+        snprintf(scene, sizeof(scene), "BenchCopy_%d", i);
+        CopyScene("Bench", scene);
+    }
+}
+
+// Update の呼び出しコスト比較（count 個、SpriteWorld / SpriteCylinder 半々）
+// |  VirtualUpdate: 1個ずつ new した Component* を仮想呼び出し（以前の Object の方式）
+// |  PoolUpdate   : 型別の連続領域を ComponentUpdateAll でまとめて処理（現在の方式）
+// |  Init は呼ばない（GPU リソースを作らずに数だけ揃える）
+static std::vector<Component*> g_BenchVirtual;
+static ComponentArray<SpriteWorld> g_BenchPoolWorld;
+static ComponentArray<SpriteCylinder> g_BenchPoolCylinder;
+
+static void Bench_SetupComponentUpdate(int count, const char*)
+{
+    for (int i = 0; i < count; ++i) {
+        if (i & 1) {
+            g_BenchVirtual.push_back(new SpriteCylinder(nullptr));
+            g_BenchPoolCylinder.Emplace(nullptr);
+        }
+        else {
+            g_BenchVirtual.push_back(new SpriteWorld(nullptr));
+            g_BenchPoolWorld.Emplace(nullptr);
+        }
+    }
+}
+
+static void Bench_FrameComponentUpdate(int)
+{
+    {
+        BenchZone z("VirtualUpdate");
+        for (Component* c : g_BenchVirtual) c->Update();
+    }
+    {
+        BenchZone z("PoolUpdate");
+        g_BenchPoolWorld.ForEachSpan(0, g_BenchPoolWorld.Size(), [](ComponentSpan<SpriteWorld> s) { ComponentUpdateAll(s); });
+        g_BenchPoolCylinder.ForEachSpan(0, g_BenchPoolCylinder.Size(), [](ComponentSpan<SpriteCylinder> s) { ComponentUpdateAll(s); });
+    }
+}
+
+// 生成と削除を繰り返す定常状態（count 個を維持し、毎フレーム arg % を入れ替える、既定 10）
+// |  削除したスロットが再利用されるので Pool は最初の count 行から増えないはず
+static std::vector<int> g_BenchSpawnRing;
+static int g_BenchSpawnSerial = 0;
+static int g_BenchSpawnRate = 10;
+static size_t g_BenchSpawnPeak = 0;
+static size_t g_BenchSpawnHead = 0;
+
+static void Bench_SpawnOne(int serial)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "BenchSD_%d", serial);
+    AddSpriteWorld(name, Bench_Texture(nullptr));
+    SetSpriteWorldPos(name, Bench_RandomRange(-20, 20), Bench_RandomRange(-5, 5), Bench_RandomRange(-20, 20));
+}
+
+static void Bench_SetupSpawnDespawn(int count, const char* arg)
+{
+    g_BenchSpawnRate = (arg && *arg) ? atoi(arg) : 10;
+    for (int i = 0; i < count; ++i) {
+        g_BenchSpawnRing.push_back(g_BenchSpawnSerial);
+        Bench_SpawnOne(g_BenchSpawnSerial++);
+        g_BenchObjectCount++;
+    }
+    g_BenchSpawnPeak = GetObjectDataPool()->SpriteWorldPos.size;
+}
+
+// リール（円柱3本）を count 個追加。名前経由で1本ずつ組む場合と Prefab から一括で作る場合を比較
+// |  どちらも直後に CreateObject まで行う。レポートの per-unit 行で1リールあたりの時間を見る
+static int g_BenchReelSerial = 0;
+
+static void Bench_AddReelCylinder(const char* name, float x, float z)
+{
+    AddSpriteCylinder(name, Bench_Texture(nullptr));
+    SetSpriteCylinderTextureSide(name, Bench_Texture(nullptr));
+    SetSpriteCylinderTextureTop(name, Bench_Texture(nullptr));
+    SetSpriteCylinderTextureBottom(name, Bench_Texture(nullptr));
+    SetSpriteCylinderSize(name, 1, 2, 1);
+    SetSpriteCylinderSegment(name, 32);
+    SetSpriteCylinderPos(name, x, 0, z);
+    SetSpriteCylinderAngle(name, 0, 1.57f, 0);
+}
+
+static void Bench_SetupPrefab(int count, const char*)
+{
+    char name[64];
+    {
+        BenchZone z("ReelByName");
+        for (int i = 0; i < count; ++i) {
+            float x = Bench_RandomRange(-20, 20), zz = Bench_RandomRange(-20, 20);
+            for (int r = 0; r < 3; ++r) {
+                snprintf(name, sizeof(name), "BenchReel_%d/%d", g_BenchReelSerial, r);
+                Bench_AddReelCylinder(name, x + 1.2f * r, zz);
+            }
+            g_BenchReelSerial++;
+        }
+    }
+    { BenchZone z("ReelByNameCreate"); CreateObject(); }
+
+    // ひな形を1つ組んで Prefab に控え、元は削除（空きスロットは Prefab 側で再利用される）
+    if (GetPrefabObjectCount("BenchReel") == 0) {
+        CreatePrefab("BenchReel");
+        for (int r = 0; r < 3; ++r) {
+            snprintf(name, sizeof(name), "BenchReelTemplate/%d", r);
+            Bench_AddReelCylinder(name, 1.2f * r, 0);
+            AddPrefabObject("BenchReel", IndexType::SpriteCylinder, name);
+            RemoveSpriteCylinder(name);
+        }
+    }
+    std::vector<PrefabTransform> xf(count);
+    for (PrefabTransform& t : xf) {
+        t.Pos = { Bench_RandomRange(-20, 20), 0, Bench_RandomRange(-20, 20), 0 };
+        t.Angle = { 0, Bench_RandomRange(-3.14f, 3.14f), 0, 0 };
+    }
+    {
+        BenchZone z("ReelPrefab");
+        snprintf(name, sizeof(name), "BenchPrefab_%d_", g_BenchReelSerial++);
+        InstantiatePrefab("BenchReel", count, xf.data(), name);
+    }
+    { BenchZone z("ReelPrefabCreate"); CreateObject(); }
+
+    Bench_ZoneUnits("ReelByName", count);
+    Bench_ZoneUnits("ReelByNameCreate", count);
+    Bench_ZoneUnits("ReelPrefab", count);
+    Bench_ZoneUnits("ReelPrefabCreate", count);
+    g_BenchObjectCount += count * 3 * 2;
+}
+
+// 親子付けの更新（枠 GridBox + 円柱3本 の組を count 個、毎フレーム arg % の枠だけ回す、既定 10）
+// |  子は動かさないので、計算し直すのは回した枠とその子だけ（UpdateTransforms 行を見る）
+static std::vector<int> g_BenchHierarchyRoot;
+static int g_BenchHierarchyRate = 10;
+
+static void Bench_SetupHierarchy(int count, const char* arg)
+{
+    g_BenchHierarchyRate = (arg && *arg) ? atoi(arg) : 10;
+    char name[64], child[64];
+    for (int i = 0; i < count; ++i) {
+        int serial = (int)g_BenchHierarchyRoot.size();
+        snprintf(name, sizeof(name), "BenchHF_%d", serial);
+        AddGridBox(name);
+        SetGridBoxPos(name, Bench_RandomRange(-20, 20), 0, Bench_RandomRange(-20, 20));
+        SetGridBoxSize(name, 4, 2.5f, 1.5f);
+        for (int r = 0; r < 3; ++r) {
+            snprintf(child, sizeof(child), "BenchHC_%d_%d", serial, r);
+            AddSpriteCylinder(child, Bench_Texture(nullptr));
+            SetSpriteCylinderSize(child, 1, 2, 1);
+            SetSpriteCylinderPos(child, 1.2f * (r - 1), 0, 0);
+            SetSpriteCylinderAngle(child, 0, 1.57f, 0);
+            SetParent(IndexType::SpriteCylinder, child, IndexType::GridBox, name);
+        }
+        g_BenchHierarchyRoot.push_back(GetObjectIndexByName(IndexType::GridBox, name));
+        g_BenchObjectCount += 4;
+    }
+}
+
+static void Bench_FrameHierarchy(int frame)
+{
+    if (g_BenchHierarchyRoot.empty()) return;
+    ObjectDataPool* p = GetObjectDataPool();
+    size_t n = g_BenchHierarchyRoot.size() * g_BenchHierarchyRate / 100;
+    size_t start = (size_t)frame * n;
+    for (size_t k = 0; k < n; ++k) {
+        int idx = g_BenchHierarchyRoot[(start + k) % g_BenchHierarchyRoot.size()];
+        Vec4 a = Vec4_Get(&p->GridBoxAngle, idx);
+        a.Y += 0.05f;
+        Vec4_Set(&p->GridBoxAngle, idx, a);
+        Transform_MarkDirty(IndexType::GridBox, idx);
+    }
+    BenchZone z("UpdateTransforms");
+    UpdateTransforms();
+}
+
+// 視錐台カリング（カメラの周囲 ±arg の立方体に GridBox を count 個、既定 100。arg が off ならカリングなし）
+// |  カメラは毎フレーム少しずつ向きを変える。レポートの Cull 行と culling/frame 行を見る
+static int g_BenchCullCount = 0;
+
+static void Bench_SetupCull(int count, const char* arg)
+{
+    bool off = arg && strcmp(arg, "off") == 0;
+    float range = (arg && *arg && !off) ? (float)atof(arg) : 100.0f;
+    SetCullingEnabled(!off);
+    if (GetPrefabObjectCount("BenchCull") == 0) {
+        CreatePrefab("BenchCull");
+        AddGridBox("BenchCullTemplate");
+        AddPrefabObject("BenchCull", IndexType::GridBox, "BenchCullTemplate");
+        RemoveGridBox("BenchCullTemplate");
+    }
+    std::vector<PrefabTransform> xf(count);
+    for (PrefabTransform& t : xf) {
+        t.Pos = { Bench_RandomRange(-range, range), 10.0f + Bench_RandomRange(-range, range), -30.0f + Bench_RandomRange(-range, range), 0 };
+        t.Angle = { 0, Bench_RandomRange(-3.14f, 3.14f), 0, 0 };
+    }
+    InstantiatePrefab("BenchCull", count, xf.data(), "BenchCull_");
+    g_BenchCullCount += count;
+    g_BenchObjectCount += count;
+}
+
+static void Bench_FrameCull(int frame)
+{
+    float t = frame * 0.02f;
+    SetCameraLook("BenchCamera", 30.0f * sinf(t), 10.0f, -30.0f + 30.0f * cosf(t));
+
+    // DrawScene と同じ処理を単独で計測（カメラは前フレームの値）
+    int camIndex = GetObjectIndexByName(IndexType::Camera, "BenchCamera");
+    Camera* cam = GetObjectClass()->GetComponent<Camera>(camIndex < 0 ? 0 : camIndex);
+    if (!cam) return;
+    BenchZone z("Cull");
+    UpdateBounds();
+    SetCullingFrustum(cam->GetViewProjection());
+    CullRange(IndexType::GridBox, 0, (int)GetObjectDataPool()->GridBoxPos.size);
+    Bench_ZoneUnits("Cull", g_BenchCullCount);
+}
+
+// 空間インデックス（±100 に GridBox を count 個、毎フレーム arg % を動かす、既定 10）
+// |  SpatialUpdate: ツリーの更新 / QueryTree: ツリーでの問い合わせ / QueryBrute: 全件を境界で判定
+// |  問い合わせは毎フレーム 球・AABB・レイ 各 64 回 + 視錐台 1 回
+static std::vector<int> g_BenchSpatial;
+static int g_BenchSpatialRate = 10;
+
+static void Bench_SetupSpatial(int count, const char* arg)
+{
+    g_BenchSpatialRate = (arg && *arg) ? atoi(arg) : 10;
+    if (GetPrefabObjectCount("BenchSpatial") == 0) {
+        CreatePrefab("BenchSpatial");
+        AddGridBox("BenchSpatialTemplate");
+        AddPrefabObject("BenchSpatial", IndexType::GridBox, "BenchSpatialTemplate");
+        RemoveGridBox("BenchSpatialTemplate");
+    }
+    std::vector<PrefabTransform> xf(count);
+    for (PrefabTransform& t : xf) {
+        t.Pos = { Bench_RandomRange(-100, 100), Bench_RandomRange(-100, 100), Bench_RandomRange(-100, 100), 0 };
+        t.Angle = { 0, Bench_RandomRange(-3.14f, 3.14f), 0, 0 };
+    }
+    InstantiatePrefab("BenchSpatial", count, xf.data(), "BenchSpatial_");
+    g_BenchObjectCount += count;
+
+    // 空きスロットが再利用されるので動かす対象は生きている行から拾い直す
+    const BoolVector& alive = GetObjectDataPool()->GridBoxAlive;
+    g_BenchSpatial.clear();
+    for (int i = 0; i < (int)alive.size; ++i)
+        if (alive.data[i]) g_BenchSpatial.push_back(i);
+}
+
+// 全件走査（比較用）
+static int Bench_BruteQuery(int shape, const Vec4& a, const Vec4& b)
+{
+    static const IndexType types[] = { IndexType::SpriteWorld, IndexType::SpriteBox, IndexType::SpriteCylinder, IndexType::GridBox, IndexType::GridPolygon };
+    ObjectDataPool* p = GetObjectDataPool();
+    const BoolVector* alive[] = { &p->SpriteWorldAlive, &p->SpriteBoxAlive, &p->SpriteCylinderAlive, &p->GridBoxAlive, &p->GridPolygonAlive };
+    int hits = 0;
+    for (int s = 0; s < 5; ++s) {
+        for (int i = 0; i < (int)alive[s]->size; ++i) {
+            Vec4 c, e;
+            if (!alive[s]->data[i] || !GetObjectBounds(types[s], i, &c, &e)) continue;
+            if (shape == 0) {   // 球
+                float dx = fmaxf(fabsf(c.X - a.X) - e.X, 0), dy = fmaxf(fabsf(c.Y - a.Y) - e.Y, 0), dz = fmaxf(fabsf(c.Z - a.Z) - e.Z, 0);
+                hits += (dx * dx + dy * dy + dz * dz <= a.W * a.W) ? 1 : 0;
+            }
+            else if (shape == 1) {  // AABB
+                hits += (fabsf(c.X - (a.X + b.X) * 0.5f) <= e.X + (b.X - a.X) * 0.5f &&
+                    fabsf(c.Y - (a.Y + b.Y) * 0.5f) <= e.Y + (b.Y - a.Y) * 0.5f &&
+                    fabsf(c.Z - (a.Z + b.Z) * 0.5f) <= e.Z + (b.Z - a.Z) * 0.5f) ? 1 : 0;
+            }
+            else {  // レイ（a: 始点 / b: 向き）
+                float t0 = 0, t1 = 1000.0f;
+                const float o[3] = { a.X, a.Y, a.Z }, d[3] = { b.X, b.Y, b.Z };
+                const float mn[3] = { c.X - e.X, c.Y - e.Y, c.Z - e.Z }, mx[3] = { c.X + e.X, c.Y + e.Y, c.Z + e.Z };
+                for (int k = 0; k < 3 && t0 <= t1; ++k) {
+                    float inv = d[k] != 0 ? 1.0f / d[k] : 1e30f;
+                    float n0 = (mn[k] - o[k]) * inv, n1 = (mx[k] - o[k]) * inv;
+                    if (n0 > n1) std::swap(n0, n1);
+                    t0 = fmaxf(t0, n0); t1 = fminf(t1, n1);
+                }
+                hits += (t0 <= t1) ? 1 : 0;
+            }
+        }
+    }
+    return hits;
+}
+
+static void Bench_FrameSpatial(int frame)
+{
+    if (g_BenchSpatial.empty()) return;
+    ObjectDataPool* p = GetObjectDataPool();
+    size_t n = g_BenchSpatial.size() * g_BenchSpatialRate / 100;
+    size_t start = (size_t)frame * n;
+    for (size_t k = 0; k < n; ++k) {
+        int idx = g_BenchSpatial[(start + k) % g_BenchSpatial.size()];
+        Vec4 pos = Vec4_Get(&p->GridBoxPos, idx);
+        pos.X += Bench_RandomRange(-1, 1);
+        pos.Z += Bench_RandomRange(-1, 1);
+        Vec4_Set(&p->GridBoxPos, idx, pos);
+        Transform_MarkDirty(IndexType::GridBox, idx);
+    }
+    UpdateTransforms();
+    UpdateBounds();
+    {
+        BenchZone z("SpatialUpdate");
+        UpdateSpatialIndex();
+    }
+    Bench_ZoneUnits("SpatialUpdate", (unsigned)n);
+
+    // 問い合わせの形はツリーと全件で同じものを使う
+    Vec4 shapeA[64 * 3], shapeB[64 * 3];
+    for (int q = 0; q < 64; ++q) {
+        Vec4 c = { Bench_RandomRange(-100, 100), Bench_RandomRange(-100, 100), Bench_RandomRange(-100, 100), 5.0f };
+        shapeA[q] = c;
+        shapeA[64 + q] = { c.X - 5, c.Y - 5, c.Z - 5, 0 };
+        shapeB[64 + q] = { c.X + 5, c.Y + 5, c.Z + 5, 0 };
+        XMVECTOR d = XMVector3Normalize(XMVectorSet(Bench_RandomRange(-1, 1), Bench_RandomRange(-1, 1), Bench_RandomRange(-1, 1), 0));
+        shapeA[128 + q] = c;
+        shapeB[128 + q] = { XMVectorGetX(d), XMVectorGetY(d), XMVectorGetZ(d), 0 };
+    }
+    int treeHits = 0, bruteHits = 0;
+    {
+        BenchZone z("QueryTree");
+        static std::vector<SpatialHit> hits;
+        for (int q = 0; q < 64; ++q) {
+            hits.clear(); treeHits += QuerySpatialSphere(shapeA[q], &hits);
+            hits.clear(); treeHits += QuerySpatialAABB(shapeA[64 + q], shapeB[64 + q], &hits);
+            hits.clear(); treeHits += QuerySpatialRay(shapeA[128 + q], shapeB[128 + q], 1000.0f, &hits);
+        }
+        int camIndex = GetObjectIndexByName(IndexType::Camera, "BenchCamera");
+        if (Camera* cam = GetObjectClass()->GetComponent<Camera>(camIndex < 0 ? 0 : camIndex)) {
+            hits.clear(); treeHits += QuerySpatialFrustum(cam->GetViewProjection(), &hits);
+        }
+    }
+    {
+        BenchZone z("QueryBrute");
+        for (int q = 0; q < 64; ++q) {
+            bruteHits += Bench_BruteQuery(0, shapeA[q], shapeA[q]);
+            bruteHits += Bench_BruteQuery(1, shapeA[64 + q], shapeB[64 + q]);
+            bruteHits += Bench_BruteQuery(2, shapeA[128 + q], shapeB[128 + q]);
+        }
+    }
+    // ツリーは葉の箱が大きめなので多めに返る（0 件の差が出たらツリーの不整合）
+    if (treeHits < bruteHits) AddMessage("spatial: tree returned fewer hits than brute force");
+}
+
+// 当たり判定（箱・球・カプセルを 1/3 ずつ count 個、全部を毎フレーム少しずつ動かす）
+// |  Collision: 広域 + 詳細の判定（UpdateScene 行にも同じ処理が入る）
+// |  密度は 1 辺 cbrt(count) * 3 の立方体に一定（規模を変えても1個あたりの接触数はほぼ同じ）
+static std::vector<int> g_BenchCollider;
+static float g_BenchColliderHalf = 0.0f;
+
+static void Bench_SetupCollision(int count, const char*)
+{
+    g_BenchColliderHalf = cbrtf((float)count) * 1.5f;
+    float h = g_BenchColliderHalf;
+    for (int i = 0; i < count; ++i) {
+        char name[64];
+        snprintf(name, sizeof(name), "BenchCollider_%d", i);
+        switch (i % 3) {
+        case 0:
+            AddBoxCollider(name);
+            SetColliderSize(name, Bench_RandomRange(0.5f, 1.5f), Bench_RandomRange(0.5f, 1.5f), Bench_RandomRange(0.5f, 1.5f));
+            break;
+        case 1:
+            AddSphereCollider(name);
+            SetColliderSize(name, Bench_RandomRange(0.3f, 0.7f), 0, 0);
+            break;
+        default:
+            AddCapsuleCollider(name);
+            SetColliderSize(name, Bench_RandomRange(0.3f, 0.5f), Bench_RandomRange(0.5f, 1.5f), 0);
+            break;
+        }
+        SetColliderPos(name, Bench_RandomRange(-h, h), Bench_RandomRange(-h, h), Bench_RandomRange(-h, h));
+        SetColliderAngle(name, Bench_RandomRange(-3.14f, 3.14f), Bench_RandomRange(-3.14f, 3.14f), 0);
+        g_BenchCollider.push_back(GetObjectIndexByName(IndexType::BoxCollider, name));
+    }
+    g_BenchObjectCount += count;
+}
+
+static void Bench_FrameCollision(int)
+{
+    if (g_BenchCollider.empty()) return;
+    ObjectDataPool* p = GetObjectDataPool();
+    float h = g_BenchColliderHalf;
+    for (int idx : g_BenchCollider) {
+        Vec4 pos = Vec4_Get(&p->BoxColliderPos, idx);
+        pos.X = std::clamp(pos.X + Bench_RandomRange(-0.1f, 0.1f), -h, h);
+        pos.Y = std::clamp(pos.Y + Bench_RandomRange(-0.1f, 0.1f), -h, h);
+        pos.Z = std::clamp(pos.Z + Bench_RandomRange(-0.1f, 0.1f), -h, h);
+        Vec4_Set(&p->BoxColliderPos, idx, pos);
+    }
+    {
+        BenchZone z("Collision");
+        UpdateCollision(0, (int)p->BoxColliderPos.size);
+    }
+    Bench_ZoneUnits("Collision", (unsigned)g_BenchCollider.size());
+}
+
+// レイ判定（SpriteWorld / SpriteBox / SpriteCylinder / GridBox を 1/4 ずつ count 個、毎フレーム 1000 本）
+// |  Raycast 行（1本あたり）と raycast 行（1秒あたりの本数・当たった割合）を見る
+// |  ツリーは DrawScene で作られるので 1 フレーム目は当たらない
+#define BENCH_RAYS_PER_FRAME 1000
+static long long g_BenchRayCount = 0;
+static long long g_BenchRayHits = 0;
+static long long g_BenchRayTicks = 0;
+
+static void Bench_SetupRaycast(int count, const char* arg)
+{
+    for (int i = 0; i < count; ++i) {
+        char name[64];
+        snprintf(name, sizeof(name), "BenchRay_%d", i);
+        float x = Bench_RandomRange(-40, 40), y = Bench_RandomRange(-10, 10), z = Bench_RandomRange(-40, 40);
+        float a = Bench_RandomRange(-3.14f, 3.14f);
+        switch (i % 4) {
+        case 0:
+            AddSpriteWorld(name, Bench_Texture(arg));
+            SetSpriteWorldPos(name, x, y, z);
+            SetSpriteWorldAngle(name, 0, a, 0);
+            break;
+        case 1:
+            AddSpriteBox(name, Bench_Texture(arg));
+            SetSpriteBoxPos(name, x, y, z);
+            SetSpriteBoxSize(name, 1, 1, 1);
+            SetSpriteBoxAngle(name, 0, a, 0);
+            break;
+        case 2:
+            AddSpriteCylinder(name, Bench_Texture(arg));
+            SetSpriteCylinderPos(name, x, y, z);
+            SetSpriteCylinderSize(name, 0.5f, 2, 0.5f);
+            break;
+        default:
+            AddGridBox(name);
+            SetGridBoxPos(name, x, y, z);
+            SetGridBoxSize(name, 1, 1, 1);
+            break;
+        }
+    }
+    g_BenchObjectCount += count;
+}
+
+static void Bench_FrameRaycast(int)
+{
+    Vec4 origin[BENCH_RAYS_PER_FRAME], dir[BENCH_RAYS_PER_FRAME];
+    for (int i = 0; i < BENCH_RAYS_PER_FRAME; ++i)
+        if (!ScreenPointToRay("BenchCamera", Bench_RandomRange(0, 800), Bench_RandomRange(0, 600), &origin[i], &dir[i])) return;
+
+    int hits = 0;
+    long long begin = Bench_Now();
+    {
+        BenchZone z("Raycast");
+        for (int i = 0; i < BENCH_RAYS_PER_FRAME; ++i) {
+            RaycastHit hit;
+            hits += RaycastScene(origin[i], dir[i], RaycastMask_All, &hit) ? 1 : 0;
+        }
+    }
+    g_BenchRayTicks += Bench_Now() - begin;
+    g_BenchRayCount += BENCH_RAYS_PER_FRAME;
+    g_BenchRayHits += hits;
+    Bench_ZoneUnits("Raycast", BENCH_RAYS_PER_FRAME);
+}
+
+// UI の当たり判定と描画前の判定（SpriteScreen を count 個、50 個に1個は不透明な大きめのパネル）
+// |  毎フレーム 1% を動かし、1000 点で一番手前の UI を引く。ScreenPick 行（1点あたり）と ui culling 行を見る
+#define BENCH_PICKS_PER_FRAME 1000
+static std::vector<std::string> g_BenchUi;
+
+static void Bench_SetupUi(int count, const char* arg)
+{
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchUi, "BenchUI_");
+        AddSpriteScreen(name, Bench_Texture(arg));
+        SetSpriteScreenPos(name, Bench_RandomRange(-32, 800), Bench_RandomRange(-32, 600));
+        if (i % 50 == 49) {
+            SetSpriteScreenSize(name, 160, 120);
+            SetSpriteScreenOpaque(name, true);
+        }
+        else {
+            float s = Bench_RandomRange(16, 64);
+            SetSpriteScreenSize(name, s, s);
+        }
+    }
+}
+
+static void Bench_FrameUi(int)
+{
+    if (g_BenchUi.empty()) return;
+    int move = (int)g_BenchUi.size() / 100 + 1;
+    for (int i = 0; i < move; ++i) {
+        int k = (int)Bench_RandomRange(0, (float)g_BenchUi.size() - 1);
+        SetSpriteScreenPos(g_BenchUi[k].c_str(), Bench_RandomRange(-32, 800), Bench_RandomRange(-32, 600));
+    }
+    float x[BENCH_PICKS_PER_FRAME], y[BENCH_PICKS_PER_FRAME];
+    for (int i = 0; i < BENCH_PICKS_PER_FRAME; ++i) {
+        x[i] = Bench_RandomRange(0, 800);
+        y[i] = Bench_RandomRange(0, 600);
+    }
+    {
+        BenchZone z("ScreenPick");
+        for (int i = 0; i < BENCH_PICKS_PER_FRAME; ++i) PickSpriteScreen(x[i], y[i]);
+    }
+    Bench_ZoneUnits("ScreenPick", BENCH_PICKS_PER_FRAME);
+}
+
+// スケルタルアニメーション（count 体。骨 16 本の円柱キャラクターと 2 つのクリップを手で作って登録）
+// |  毎フレーム 1/60 の体を 10 フレームかけてもう一方のクリップへ切り替える
+// |  DrawScene 行（姿勢 + スキニング、1体あたり）と ObjectDraw 行（頂点の転送）を見る。arg が gpu なら VS でスキニング
+// |  クリップは FBX の書き出しと同じく 30fps の毎フレームに位置 / 回転 / 拡大を持たせる（anim clips 行で圧縮の前後を見る）
+#define BENCH_ANIM_BONES 16
+#define BENCH_ANIM_SIDES 12
+#define BENCH_ANIM_RINGS 4      // 骨 1 本あたりの輪の数
+static std::vector<std::string> g_BenchAnim;
+static std::vector<int> g_BenchAnimClip;
+
+static AnimClip Bench_AnimClip(float speed, float amount, float boneLen)
+{
+    AnimClip clip;
+    clip.Duration = 2.0f;
+    for (int b = 0; b < BENCH_ANIM_BONES; ++b) {
+        AnimTrack tr;
+        char name[32];
+        snprintf(name, sizeof(name), "Bone%d", b);
+        tr.NodeName = name;
+        for (int k = 0; k <= 60; ++k) {
+            float t = k / 30.0f;
+            XMFLOAT4 q;
+            XMStoreFloat4(&q, XMQuaternionRotationRollPitchYaw(0, 0, amount * sinf(speed * t * 3.14159f + b * 0.3f)));
+            tr.PosTime.push_back(t);
+            tr.Pos.push_back(XMFLOAT3(0, b > 0 ? boneLen : 0.0f, 0));
+            tr.RotTime.push_back(t);
+            tr.Rot.push_back(q);
+            tr.ScaleTime.push_back(t);
+            tr.Scale.push_back(XMFLOAT3(1, 1, 1));
+        }
+        clip.Tracks.push_back(std::move(tr));
+    }
+    return clip;
+}
+
+static void Bench_AnimRegister()
+{
+    const float boneLen = 0.25f;
+    ModelSkeleton skel;
+    skel.NodeName.push_back("Root");
+    skel.Parent.push_back(-1);
+    for (int b = 0; b < BENCH_ANIM_BONES; ++b) {
+        char name[32];
+        snprintf(name, sizeof(name), "Bone%d", b);
+        skel.NodeName.push_back(name);
+        skel.Parent.push_back(b);
+    }
+    for (size_t n = 0; n < skel.NodeName.size(); ++n) {
+        skel.BindPos.push_back(XMFLOAT3(0, n >= 2 ? boneLen : 0.0f, 0));
+        skel.BindRot.push_back(XMFLOAT4(0, 0, 0, 1));
+        skel.BindScale.push_back(XMFLOAT3(1, 1, 1));
+    }
+    for (int b = 0; b < BENCH_ANIM_BONES; ++b) {
+        XMFLOAT4X4 offset;
+        XMStoreFloat4x4(&offset, XMMatrixTranslation(0, -boneLen * b, 0));
+        skel.BoneNode.push_back(b + 1);
+        skel.BoneOffset.push_back(offset);
+    }
+    XMStoreFloat4x4(&skel.GlobalInverse, XMMatrixIdentity());
+
+    // 円柱（面ごとに展開）。輪の高さで隣の骨と重みを分ける
+    std::vector<ModelVertex> verts;
+    std::vector<ModelSkinVertex> skin;
+    const int rings = BENCH_ANIM_BONES * BENCH_ANIM_RINGS;
+    for (int r = 0; r < rings; ++r) {
+        for (int s = 0; s < BENCH_ANIM_SIDES; ++s) {
+            int quad[6][2] = { {r,s}, {r + 1,s}, {r,s + 1}, {r,s + 1}, {r + 1,s}, {r + 1,s + 1} };
+            for (auto& q : quad) {
+                float a = 6.28318f * q[1] / BENCH_ANIM_SIDES;
+                float y = boneLen * q[0] / BENCH_ANIM_RINGS;
+                ModelVertex v = { XMFLOAT3(0.3f * cosf(a), y, 0.3f * sinf(a)), XMFLOAT2((float)q[1] / BENCH_ANIM_SIDES, y), XMFLOAT3(cosf(a), 0, sinf(a)) };
+                float f = y / boneLen;
+                int b = (int)f;
+                if (b >= BENCH_ANIM_BONES - 1) { b = BENCH_ANIM_BONES - 1; f = (float)b; }
+                ModelSkinVertex w = {};
+                w.bone[0] = (unsigned short)b;
+                w.bone[1] = (unsigned short)(b + 1 < BENCH_ANIM_BONES ? b + 1 : b);
+                w.weight[1] = f - b;
+                w.weight[0] = 1.0f - w.weight[1];
+                verts.push_back(v);
+                skin.push_back(w);
+            }
+        }
+    }
+    std::vector<AnimClip> clips;
+    clips.push_back(Bench_AnimClip(1.0f, 0.15f, boneLen));
+    IN_RegisterModel("bench/anim_chara", std::move(verts), std::move(skin), std::move(skel), std::move(clips));
+
+    // 2 つ目のクリップはアニメーションだけのファイルとして
+    clips.clear();
+    clips.push_back(Bench_AnimClip(3.0f, 0.3f, boneLen));
+    IN_RegisterModel("bench/anim_fast", {}, {}, ModelSkeleton{}, std::move(clips));
+}
+
+static void Bench_SetupAnim(int count, const char* arg)
+{
+    Bench_AnimRegister();
+    SetModelSkinningGPU(arg && strcmp(arg, "gpu") == 0);
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchAnim, "BenchAnim_");
+        AddModel(name, "bench/anim_chara");
+        SetModelPos(name, (float)(i % 25) * 1.5f - 18.0f, 0, (float)(i / 25) * 1.5f - 15.0f);
+        SetModelMotion(name, "bench/anim_chara", 0);
+        g_BenchAnimClip.push_back(0);
+    }
+}
+
+static void Bench_FrameAnim(int frame)
+{
+    static const char* clips[2] = { "bench/anim_chara", "bench/anim_fast" };
+    for (size_t i = frame % 60; i < g_BenchAnim.size(); i += 60) {
+        g_BenchAnimClip[i] ^= 1;
+        SetModelMotion(g_BenchAnim[i].c_str(), clips[g_BenchAnimClip[i]], 10);
+    }
+    Bench_ZoneUnits("DrawScene", (unsigned)g_BenchAnim.size());
+    Bench_ZoneUnits("ObjectDraw", (unsigned)g_BenchAnim.size());
+}
+
+// Tween（count 個。SpriteWorld 1 つに Pos / Angle / Color / Size の 4 個）
+// |  Pos / Color は往復、Angle は1周の繰り返し、Size は 2 つの連結（終わりのイベントで同じ組を作り直す）
+// |  Tween 行（1個あたり）を見る。作り直しは空きスロットの再利用なので確保は増えない
+static std::vector<std::string> g_BenchTween;
+
+// index: g_BenchTween の番号（終わりのイベントへそのまま渡す）
+static void Bench_TweenSize(size_t index)
+{
+    const char* name = g_BenchTween[index].c_str();
+    float d = Bench_RandomRange(0.3f, 1.0f);
+    int grow = AddTween(IndexType::SpriteWorld, name, TweenProp_Size, { 1.5f, 1.5f, 1.5f, 0 }, d, TweenEase_OutBack);
+    int shrink = AddTween(IndexType::SpriteWorld, name, TweenProp_Size, { 1, 1, 1, 0 }, d, TweenEase_InQuad);
+    SetTweenAfter(shrink, grow);
+    SetTweenEvent(shrink, [](int, int event, void* user) {
+        if (event == TweenEvent_Complete) Bench_TweenSize((size_t)user);
+    }, (void*)index);
+}
+
+static void Bench_SetupTween(int count, const char* arg)
+{
+    ReserveTweens(GetTweenCount() + count + 4);
+    for (int i = 0; i < count; i += 4) {
+        size_t index = g_BenchTween.size();
+        const char* name = Bench_Name(g_BenchTween, "BenchTW_");
+        AddSpriteWorld(name, Bench_Texture(arg));
+        SetSpriteWorldPos(name, Bench_RandomRange(-20, 20), Bench_RandomRange(-5, 5), Bench_RandomRange(-20, 20));
+        SetSpriteWorldSize(name, 1, 1, 1);
+        SetSpriteWorldColor(name, 1, 1, 1, 1);
+
+        int t = AddTweenBy(IndexType::SpriteWorld, name, TweenProp_Pos, { 0, 2, 0, 0 }, Bench_RandomRange(0.5f, 2.0f), TweenEase_InOutSine);
+        SetTweenLoop(t, -1, true);
+        t = AddTweenBy(IndexType::SpriteWorld, name, TweenProp_Angle, { 0, 6.28318f, 0, 0 }, Bench_RandomRange(1.0f, 4.0f));
+        SetTweenLoop(t, -1);
+        t = AddTween(IndexType::SpriteWorld, name, TweenProp_Color, { Bench_RandomRange(0, 1), Bench_RandomRange(0, 1), Bench_RandomRange(0, 1), 1 }, 1.0f, TweenEase_OutQuad);
+        SetTweenDelay(t, Bench_RandomRange(0, 1));
+        SetTweenLoop(t, -1, true);
+        Bench_TweenSize(index);
+    }
+}
+
+static void Bench_FrameTween(int)
+{
+    Bench_ZoneUnits("Tween", (unsigned)GetTweenCount());
+}
+
+// リール（count 本。SpriteCylinder のリールモード、全て同じテクスチャ / 分割数 = 1 バンク）
+// |  止まっているリールは回し直し、回っているリールは 1/120 の確率で乱数の図柄に止める
+// |  ObjectDraw 行（1本あたり）と Reel 行を見る。reels 行の結果（止まった図柄の合計）は同じ seed なら毎回同じ
+#define BENCH_REEL_SYMBOLS 21
+static std::vector<std::string> g_BenchReel;
+static std::vector<unsigned char> g_BenchReelSpun;     // 一度回したか
+static long long g_BenchReelStops = 0;
+static long long g_BenchReelSum = 0;
+
+static void Bench_SetupReel(int count, const char* arg)
+{
+    SetReelSeed(g_BenchSeed);
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchReel, "BenchRL_");
+        AddSpriteCylinder(name, Bench_Texture(arg));
+        SetSpriteCylinderPos(name, (float)(i % 40) * 1.1f - 22.0f, (float)(i / 40 % 20) * 2.1f - 20.0f, (float)(i / 800) * 2.0f);
+        SetSpriteCylinderSize(name, 0.5f, 1, 0.5f);
+        SetSpriteCylinderAngle(name, 0, 0, 1.56f);
+        SetSpriteCylinderReel(name, BENCH_REEL_SYMBOLS);
+        g_BenchReelSpun.push_back(0);
+    }
+}
+
+static void Bench_FrameReel(int)
+{
+    for (size_t i = 0; i < g_BenchReel.size(); ++i) {
+        const char* name = g_BenchReel[i].c_str();
+        if (!IsReelSpinning(name)) {
+            if (g_BenchReelSpun[i]) g_BenchReelSum += GetReelSymbol(name);
+            SpinReel(name, Bench_RandomRange(15, 25));
+            g_BenchReelSpun[i] = 1;
+        }
+        else if (Bench_Random() % 120 == 0) {
+            StopReel(name, -1, Bench_RandomRange(0, 0.2f));
+            g_BenchReelStops++;
+        }
+    }
+    Bench_ZoneUnits("Reel", (unsigned)g_BenchReel.size());
+    Bench_ZoneUnits("ObjectDraw", (unsigned)g_BenchReel.size());
+}
+
+// パーティクル（count 個の発生源、それぞれ最大 10000 粒子。寿命 1〜2 秒で出し続けて上限付近で釣り合う）
+// |  Effect 行（粒子 1 個あたりの積分 / 削除 / 発生）と ObjectDraw 行（インスタンスの書き出し）を見る
+#define BENCH_EFFECT_PARTICLES 10000
+static std::vector<std::string> g_BenchEffect;
+static long long g_BenchEffectSum = 0;
+static int g_BenchEffectFrames = 0;
+
+static void Bench_SetupEffect(int count, const char* arg)
+{
+    SetEffectSeed(g_BenchSeed);
+    EffectDesc d = EffectDesc_Default();
+    d.MaxParticles = BENCH_EFFECT_PARTICLES;
+    d.Rate = BENCH_EFFECT_PARTICLES / 1.5f;
+    d.LifeMin = 1.0f;
+    d.LifeMax = 2.0f;
+    d.Velocity = { 0, 3, 0, 0 };
+    d.VelocityRandom = { 1.5f, 1, 1.5f, 0 };
+    d.Gravity = { 0, -2, 0, 0 };
+    d.Drag = 0.1f;
+    d.SpawnRadius = 0.2f;
+    d.SizeStart = 0.2f;
+    d.SizeEnd = 0.05f;
+    d.ColorStart = { 1, 0.8f, 0.3f, 1 };
+    d.ColorEnd = { 1, 0.2f, 0.1f, 0 };
+    for (int i = 0; i < count; ++i) {
+        const char* name = Bench_Name(g_BenchEffect, "BenchEF_");
+        AddEffect(name, Bench_Texture(arg));
+        SetEffectPos(name, (float)(i % 10) * 4.0f - 18.0f, 0, (float)(i / 10 % 10) * 4.0f - 18.0f);
+        SetEffectDesc(name, d);
+    }
+}
+
+static void Bench_FrameEffect(int)
+{
+    int total = GetEffectTotalParticles();
+    g_BenchEffectSum += total;
+    g_BenchEffectFrames++;
+    Bench_ZoneUnits("Effect", (unsigned)total);
+    Bench_ZoneUnits("ObjectDraw", (unsigned)total);
+}
+
+static void Bench_FrameSpawnDespawn(int)
+{
+    if (g_BenchSpawnRing.empty()) return;
+    BenchZone z("SpawnDespawn");
+    size_t n = g_BenchSpawnRing.size() * g_BenchSpawnRate / 100;
+    for (size_t i = 0; i < n; ++i) {
+        int& slot = g_BenchSpawnRing[g_BenchSpawnHead];
+        char name[64];
+        snprintf(name, sizeof(name), "BenchSD_%d", slot);
+        RemoveSpriteWorld(name);
+        slot = g_BenchSpawnSerial++;
+        Bench_SpawnOne(slot);
+        g_BenchSpawnHead = (g_BenchSpawnHead + 1) % g_BenchSpawnRing.size();
+    }
+    if (GetObjectDataPool()->SpriteWorldPos.size > g_BenchSpawnPeak) {
+        g_BenchSpawnPeak = GetObjectDataPool()->SpriteWorldPos.size;
+        AddMessage("spawn_despawn: SpriteWorld pool grew");
+    }
+}
+
+// 毎フレーム全オブジェクトの座標を名前経由で書き換える（シーン同期の負荷確認）
+static void Bench_FrameAnimate(int frame)
+{
+    float t = frame * (1.0f / 60.0f);
+    for (size_t i = 0; i < g_BenchSpriteWorld.size(); ++i)
+        SetSpriteWorldAngle(g_BenchSpriteWorld[i].c_str(), 0, t + (float)i, 0);
+    for (size_t i = 0; i < g_BenchSpriteScreen.size(); ++i)
+        SetSpriteScreenAngle(g_BenchSpriteScreen[i].c_str(), t + (float)i);
+    for (size_t i = 0; i < g_BenchCylinder.size(); ++i)
+        SetSpriteCylinderAngle(g_BenchCylinder[i].c_str(), t * 4.0f, 0, 1.56f);
+    for (size_t i = 0; i < g_BenchGridBox.size(); ++i)
+        SetGridBoxPos(g_BenchGridBox[i].c_str(), (float)(i % 40) - 20.0f, sinf(t + (float)i), (float)(i / 40) - 20.0f);
+}
+
+static void Bench_RegisterBuiltins()
+{
+    Bench_Register("sprite_world", Bench_SetupSpriteWorld, nullptr);
+    Bench_Register("sprite_screen", Bench_SetupSpriteScreen, nullptr);
+    Bench_Register("cylinder", Bench_SetupCylinder, nullptr);
+    Bench_Register("grid_box", Bench_SetupGridBox, nullptr);
+    Bench_Register("grid_polygon", Bench_SetupGridPolygon, nullptr);
+    Bench_Register("animate", nullptr, Bench_FrameAnimate);
+    Bench_Register("inactive_scenes", Bench_SetupInactiveScenes, nullptr);
+    Bench_Register("component_update", Bench_SetupComponentUpdate, Bench_FrameComponentUpdate);
+    Bench_Register("spawn_despawn", Bench_SetupSpawnDespawn, Bench_FrameSpawnDespawn);
+    Bench_Register("copy_scene", Bench_SetupCopyScene, nullptr);
+    Bench_Register("prefab", Bench_SetupPrefab, nullptr);
+    Bench_Register("hierarchy", Bench_SetupHierarchy, Bench_FrameHierarchy);
+    Bench_Register("cull", Bench_SetupCull, Bench_FrameCull);
+    Bench_Register("spatial", Bench_SetupSpatial, Bench_FrameSpatial);
+    Bench_Register("collision", Bench_SetupCollision, Bench_FrameCollision);
+    Bench_Register("raycast", Bench_SetupRaycast, Bench_FrameRaycast);
+    Bench_Register("ui", Bench_SetupUi, Bench_FrameUi);
+    Bench_Register("anim", Bench_SetupAnim, Bench_FrameAnim);
+    Bench_Register("tween", Bench_SetupTween, Bench_FrameTween);
+    Bench_Register("reel", Bench_SetupReel, Bench_FrameReel);
+    Bench_Register("effect", Bench_SetupEffect, Bench_FrameEffect);
+    Job_RegisterBench();
+}
+
+//-----------------------------------------
+// 引数（起動引数 / スクリプトの1行を空白で区切る。"" で囲めば空白を含められる）
+//-----------------------------------------
+static std::vector<std::string> Bench_SplitArgs(const char* cmdLine)
+{
+    std::vector<std::string> args;
+    std::string cur;
+    bool quoted = false, has = false;
+    for (const char* p = cmdLine; p && *p; ++p) {
+        if (*p == '"') { quoted = !quoted; has = true; continue; }
+        if (!quoted && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+            if (has) { args.push_back(cur); cur.clear(); has = false; }
+            continue;
+        }
+        cur += *p;
+        has = true;
+    }
+    if (has) args.push_back(cur);
+    return args;
+}
+
+//-----------------------------------------
+// スクリプト
+//-----------------------------------------
+static bool Bench_RunScript(const char* path)
+{
+    FILE* fp = System_FileOpen(path, "r");
+    if (!fp) {
+        AddMessage(ConcatCStr("Bench: script not found ", path));
+        return false;
+    }
+
+    char line[512];
+    int lineNo = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), fp)) {
+        lineNo++;
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        std::vector<std::string> tokens = Bench_SplitArgs(line);
+        if (tokens.empty()) continue;
+        const char* cmd = tokens[0].c_str();
+        int count = tokens.size() >= 2 ? atoi(tokens[1].c_str()) : 1;
+        const char* arg = tokens.size() >= 3 ? tokens[2].c_str() : "";
+
+        // 実行設定
+        if (strcmp(cmd, "frames") == 0) { g_BenchFrames = count; continue; }
+        if (strcmp(cmd, "seed") == 0) { g_BenchSeed = (unsigned)count; continue; }
+        if (strcmp(cmd, "workers") == 0) {
+            // ジョブシステムをワーカー数を指定して作り直す（0: メインスレッドのみ）
+            Job_Shutdown();
+            Job_Init(count);
+            continue;
+        }
+
+        BenchCommand* c = Bench_FindCommand(cmd);
+        if (!c) {
+            char msg[128];
+            snprintf(msg, sizeof(msg), "Bench: unknown command '%s' (line %d)", cmd, lineNo);
+            AddMessage(msg);
+            ok = false;
+            continue;
+        }
+        c->Used = true;
+        if (c->Setup) c->Setup(count, arg);
+    }
+    fclose(fp);
+    return ok;
+}
+
+//-----------------------------------------
+// レポート
+//-----------------------------------------
+static long long g_BenchCullVisible = 0;
+static long long g_BenchCullCulled = 0;
+static long long g_BenchScreenVisible = 0;
+static long long g_BenchScreenCulled = 0;
+static unsigned long long g_BenchHeapAllocs = 0;    // ウォームアップ後の合計
+static unsigned long long g_BenchHeapMax = 0;       // ウォームアップ後の1フレームの最大
+static int g_BenchHeapFrames = 0;                   // ウォームアップ後に確保のあったフレーム数
+
+static void Bench_Report(FILE* fp, const char* script, int frames, const RenderStatsCounters& render)
+{
+    RenderNullStats ns = {};
+    RenderNull_GetStats(&ns);
+
+    fprintf(fp, "lia_bench script=%s frames=%d objects=%d backend=%s\n", script, frames, g_BenchObjectCount,
+        RenderBackend_GetType() == RenderBackend_Null ? "Null" : "D3D11");
+    fprintf(fp, "%-16s %12s %10s %10s %10s\n", "zone", "total(ms)", "avg(ms)", "max(ms)", "calls");
+    for (int i = 0; i < g_BenchZoneCount; ++i) {
+        const BenchZoneStat& z = g_BenchZones[i];
+        fprintf(fp, "%-16s %12.3f %10.4f %10.4f %10u\n", z.Name,
+            Bench_ToMs(z.Total), Bench_ToMs(z.Total) / (frames ? frames : 1), Bench_ToMs(z.Max), z.Calls);
+    }
+    for (int i = 0; i < g_BenchZoneCount; ++i) {
+        const BenchZoneStat& z = g_BenchZones[i];
+        if (z.Units == 0) continue;
+        fprintf(fp, "per-unit: %-16s %10.3f us (%u units)\n", z.Name,
+            Bench_ToMs(z.Total) * 1000.0 / z.Units, z.Units);
+    }
+    double f = frames ? (double)frames : 1.0;
+    fprintf(fp, "render/frame: draw %.1f / state %.1f / tex %.1f / upload %.1f / buffer %.1f / resource %.1f\n",
+        render.DrawCalls / f, render.StateChanges / f, render.TextureBinds / f,
+        render.Uploads / f, render.BufferCreates / f, render.ResourceCreates / f);
+    fprintf(fp, "culling/frame: visible %.1f / culled %.1f\n", g_BenchCullVisible / f, g_BenchCullCulled / f);
+    if (g_BenchScreenVisible + g_BenchScreenCulled > 0)
+        fprintf(fp, "ui culling/frame: visible %.1f / culled %.1f\n", g_BenchScreenVisible / f, g_BenchScreenCulled / f);
+    if (g_BenchRayCount > 0 && g_BenchRayTicks > 0)
+        fprintf(fp, "raycast: %.0f queries/s / hit %.1f%%\n",
+            g_BenchRayCount * 1000.0 / Bench_ToMs(g_BenchRayTicks), g_BenchRayHits * 100.0 / g_BenchRayCount);
+    int clipCount;
+    size_t clipRaw, clipPacked;
+    GetAnimClipMemory(&clipCount, &clipRaw, &clipPacked);
+    if (clipCount > 0)
+        fprintf(fp, "anim clips: %d / raw %.1f KB -> packed %.1f KB\n", clipCount, clipRaw / 1024.0, clipPacked / 1024.0);
+    if (g_BenchReelStops > 0)
+        fprintf(fp, "reels: stops %lld / symbol sum %lld\n", g_BenchReelStops, g_BenchReelSum);
+    if (g_BenchEffectFrames > 0)
+        fprintf(fp, "effects: %d emitters / particles %.0f per frame / last %d\n",
+            (int)g_BenchEffect.size(), (double)g_BenchEffectSum / g_BenchEffectFrames, GetEffectTotalParticles());
+#if defined(LIA_PROFILE)
+    if (frames > BENCH_HEAP_WARMUP)
+        fprintf(fp, "heap/frame: allocs %.2f / steady max %llu / frames with allocs %d\n",
+            (double)g_BenchHeapAllocs / (frames - BENCH_HEAP_WARMUP), g_BenchHeapMax, g_BenchHeapFrames);
+#else
+    fprintf(fp, "heap/frame: not counted (build with LIA_PROFILE)\n");
+#endif
+    size_t arenaPeak, arenaCapacity;
+    int arenaOverflows;
+    GetFrameArenaStats(&arenaPeak, &arenaCapacity, &arenaOverflows);
+    fprintf(fp, "frame arena: peak %.1f KB / capacity %.1f KB / overflows %d\n",
+        arenaPeak / 1024.0, arenaCapacity / 1024.0, arenaOverflows);
+    fprintf(fp, "null backend: commands %u / errors %u / live %u / peak %u / uploaded %.2f MB\n",
+        ns.Commands, ns.ValidationErrors, ns.LiveResources, ns.PeakResources, ns.BytesUploaded / (1024.0 * 1024.0));
+}
+
+//-----------------------------------------
+// 実行
+//-----------------------------------------
+int Bench_Main(const char* cmdLine)
+{
+    // 呼び出し元のコンソールへ出力（GUIアプリのため）
+    System_AttachConsole();
+
+    std::vector<std::string> args = Bench_SplitArgs(cmdLine);
+    std::string script, out = "saved/bench/report.txt";
+    int frames = -1;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--bench" && i + 1 < args.size()) {
+            script = args[++i];
+            if (i + 1 < args.size() && args[i + 1][0] != '-') frames = atoi(args[++i].c_str());
+        }
+        else if (args[i] == "--out" && i + 1 < args.size()) out = args[++i];
+    }
+    if (script.empty()) {
+        printf("usage: --bench <script> [frames] [--out <report>]\n");
+        return 1;
+    }
+
+    g_BenchFreq = System_GetTickFrequency();
+
+    RenderBackend_InitNull();
+    InitDo();
+    Bench_RegisterBuiltins();
+
+    // シーン構築
+    AddCamera("BenchCamera");
+    SetCameraPos("BenchCamera", 0.0f, 10.0f, -30.0f);
+    SetCameraLook("BenchCamera", 0.0f, 0.0f, 0.0f);
+
+    AddScene("Bench");
+    bool ok;
+    {
+        BenchZone z("Build");
+        ok = Bench_RunScript(script.c_str());
+    }
+    SceneEndPoint();
+    SetSceneCamera("Bench", "BenchCamera");
+    ChangeScene("Bench");
+    if (frames < 0) frames = g_BenchFrames;
+
+    // 計測ループ（UpdateDo / DrawDo を区間ごとに分解）
+    RenderStatsCounters render = {};
+    for (int frame = 0; frame < frames; ++frame) {
+        unsigned long long heapBefore = GetHeapAllocCount();
+        LIA_PROFILE_FRAME_BEGIN();
+        {
+            BenchZone total("Frame");
+            {
+                BenchZone z("Script");
+                for (int i = 0; i < g_BenchCommandCount; ++i)
+                    if (g_BenchCommands[i].Used && g_BenchCommands[i].Frame) g_BenchCommands[i].Frame(frame);
+            }
+            { BenchZone z("ShaderManager"); ShaderManager_Update(); }
+            { BenchZone z("CreateObject");  CreateObject(); }
+            { BenchZone z("UpdateScene");   UpdateScene(); }
+            { BenchZone z("Tween");         UpdateTweens(1.0f / 60.0f); }
+            { BenchZone z("Reel");          UpdateReels(1.0f / 60.0f); }
+            { BenchZone z("Effect");        UpdateEffects(1.0f / 60.0f); }
+            { BenchZone z("ObjectUpdate");  GetObjectClass()->Update(); }
+            { BenchZone z("DrawScene");     DrawScene(); }
+            { BenchZone z("ObjectDraw");    GetObjectClass()->Draw(); }
+        }
+        RenderStats_EndFrame();
+        FrameArena_Reset();
+        LIA_PROFILE_FRAME_END();
+
+        // 定常状態のフレームはヒープ確保 0 のはず（ウォームアップ後のみ集計）
+        if (frame >= BENCH_HEAP_WARMUP) {
+            unsigned long long heap = GetHeapAllocCount() - heapBefore;
+            g_BenchHeapAllocs += heap;
+            if (heap > g_BenchHeapMax) g_BenchHeapMax = heap;
+            if (heap > 0) g_BenchHeapFrames++;
+        }
+        Bench_ZoneFrameEnd();
+
+        const RenderStatsCounters& t = GetRenderStats()->Total;
+        render.DrawCalls += t.DrawCalls;
+        render.StateChanges += t.StateChanges;
+        render.TextureBinds += t.TextureBinds;
+        render.Uploads += t.Uploads;
+        render.BufferCreates += t.BufferCreates;
+        render.ResourceCreates += t.ResourceCreates;
+        int visible, culled;
+        GetCullingStats(&visible, &culled);
+        g_BenchCullVisible += visible;
+        g_BenchCullCulled += culled;
+        GetScreenCullStats(&visible, &culled);
+        g_BenchScreenVisible += visible;
+        g_BenchScreenCulled += culled;
+    }
+
+    // レポート
+    Bench_Report(stdout, script.c_str(), frames, render);
+    std::filesystem::path p(out);
+    if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
+    FILE* fp = System_FileOpen(out.c_str(), "w");
+    if (fp) {
+        Bench_Report(fp, script.c_str(), frames, render);
+        fclose(fp);
+    }
+#if defined(LIA_PROFILE)
+    Profile_DumpChromeTrace("saved/bench/trace.json");
+#endif
+
+    RenderNullStats ns = {};
+    RenderNull_GetStats(&ns);
+
+    ReleaseDo();
+    RenderBackend_Shutdown();
+
+    if (!ok) return 1;
+    return ns.ValidationErrors ? 2 : 0;
+}
@@ -0,0 +1,39 @@
+﻿// BenchRunner.h
+// ヘッドレスのベンチマーク実行（lia_bench）
+// |  起動引数: --bench <script> [frames] [--out <report>]
+// |  Null バックエンドで動かすため GPU もウィンドウも不要
+// |  実行ファイル: lia_bench（CMakeLists.txt。BenchMain.cpp + エンジン + Null バックエンド。d3d11.h 無しでどの OS でもビルドできる）
+// |               本体の exe（Windows）も --bench で同じモードになる
+// |  スクリプトは1行1コマンド「<command> [count] [arg]」、# 以降はコメント
+// |  例) sprite_world 1000 asset/test.png / cylinder 64 / grid_box 256 / animate
+// |  実行設定: frames <n> / seed <n> / workers <n>（ジョブシステムのワーカー数。0 はメインスレッドのみ）
+// |  サブシステムごとのCPU時間と描画統計をレポートへ書き出す
+// __________________________________________
+
+#pragma once
+
+// スクリプトのコマンド（シーン構築時に1回）/ 毎フレームのフック
+typedef void (*BenchSetupFn)(int count, const char* arg);
+typedef void (*BenchFrameFn)(int frame);
+
+//|| API ||___________________________
+int  Bench_Main(const char* cmdLine);                                       //--bench 指定時に WinMain / lia_bench の main から呼ぶ（終了コードを返す）
+void Bench_Register(const char* command, BenchSetupFn setup, BenchFrameFn frame);  //スクリプトのコマンドを追加
+unsigned Bench_Random();                                                    //シード固定の乱数（結果を再現させる）
+float Bench_RandomRange(float min, float max);
+
+// 任意区間の計測（レポートに name の行が追加される）
+int  Bench_ZoneBegin(const char* name);
+void Bench_ZoneEnd(int zone, long long begin);
+long long Bench_Now();
+void Bench_ZoneUnits(const char* name, unsigned units);                     //name の処理個数を加算（レポートに1個あたりの時間を出す）
+
+struct BenchZone
+{
+    int Zone;
+    long long Begin;
+    explicit BenchZone(const char* name) : Zone(Bench_ZoneBegin(name)), Begin(Bench_Now()) {}
+    ~BenchZone() { Bench_ZoneEnd(Zone, Begin); }
+    BenchZone(const BenchZone&) = delete;
+    BenchZone& operator=(const BenchZone&) = delete;
+};
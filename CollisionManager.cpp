@@ -0,0 +1,503 @@
+﻿// CollisionManager.cpp
+// 当たり判定（箱 / 球 / カプセル）
+// |  Pool の BoxCollider 列（Pos / Size / Angle / Shape）から毎フレーム判定用の形を作る
+// |  広域: ワールド AABB の最小 X で並べた Sweep and Prune。並び順は前フレームのものを挿入ソートで直す
+// |        （動きが小さければほぼ O(n)）。走査は 4 個ずつ SIMD で比べ、一定数ずつに分けて Job_ParallelFor
+// |  詳細: 球とカプセルは「線分 + 半径」として同じ処理、箱 × 箱は分離軸（15 軸）、
+// |        箱 × 線分は線分上で箱に一番近い点を探してから箱 × 球
+// |  接触は1本の配列に入れ直す（並列に判定した結果を順番どおりに詰めるので毎回同じ順）
+// __________________________________________
+
+#include "Manager.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace DirectX;
+
+#define COLLISION_SWEEP_CHUNK 256       // 広域の走査を分ける単位
+#define COLLISION_SORT_LIMIT 16         // 挿入ソートの移動が件数のこの倍を超えたら並べ直す
+#define COLLISION_LINE_STEPS 16         // 箱 × 線分で近い点を探す回数
+#define COLLISION_PAD 4
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct ColliderProxy {
+    XMFLOAT3 Min, Max;      // ワールド AABB
+    XMFLOAT3 Center;
+    XMFLOAT3 Axis[3];       // 回転後のローカル X / Y / Z 軸
+    XMFLOAT3 Half;          // 箱の半径（各軸）
+    XMFLOAT3 P0, P1;        // 球 / カプセルの線分（球は P0 == P1）
+    float Radius;
+    int Shape;
+    int Index;              // Pool のインデックス
+};
+
+// 最小 X の順に並べた AABB（SoA、4個ずつ読めるよう末尾に余白）
+struct SweepColumns {
+    std::vector<float> MinX, MaxX, MinY, MaxY, MinZ, MaxZ;
+    std::vector<int> Proxy;
+};
+
+struct CollisionPair {
+    int A, B;               // プロキシ（A < B。プロキシは Pool の順なので Pool のインデックスも A < B）
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static std::vector<int> g_ColliderRows;                 // 今フレームの対象行（Pool のインデックス）
+static std::vector<int> g_ColliderPrevRows;             // 並び順を作ったときの対象行
+static std::vector<ColliderProxy> g_Proxies;
+static std::vector<int> g_SweepOrder;                   // プロキシを最小 X の順に（フレームをまたいで使う）
+static SweepColumns g_Sweep;
+static std::vector<std::vector<CollisionPair>> g_ChunkPairs;
+static std::vector<CollisionPair> g_Pairs;
+static std::vector<CollisionContact> g_PairContacts;    // 組ごとの結果（詳細判定の作業用）
+static std::vector<unsigned char> g_PairHit;
+static std::vector<CollisionContact> g_Contacts;
+
+//-----------------------------------------
+// 形
+//-----------------------------------------
+static void Proxy_Build(ColliderProxy& px, int index)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    const Vec4& pos = p->BoxColliderPos.data[index];
+    const Vec4& size = p->BoxColliderSize.data[index];
+    const Vec4& angle = p->BoxColliderAngle.data[index];
+
+    XMMATRIX rot = XMMatrixRotationRollPitchYaw(angle.X, angle.Y, angle.Z);
+    XMStoreFloat3(&px.Axis[0], rot.r[0]);
+    XMStoreFloat3(&px.Axis[1], rot.r[1]);
+    XMStoreFloat3(&px.Axis[2], rot.r[2]);
+    px.Center = { pos.X, pos.Y, pos.Z };
+    px.Shape = p->BoxColliderShape.data[index];
+    px.Index = index;
+
+    XMVECTOR c = XMLoadFloat3(&px.Center);
+    XMVECTOR ext;
+    if (px.Shape == ColliderShape_Box) {
+        px.Half = { fabsf(size.X) * 0.5f, fabsf(size.Y) * 0.5f, fabsf(size.Z) * 0.5f };
+        px.Radius = 0.0f;
+        px.P0 = px.P1 = px.Center;
+        // ワールド AABB の半径 = |回転| * 半径
+        ext = XMVectorAdd(XMVectorAdd(
+            XMVectorScale(XMVectorAbs(rot.r[0]), px.Half.x),
+            XMVectorScale(XMVectorAbs(rot.r[1]), px.Half.y)),
+            XMVectorScale(XMVectorAbs(rot.r[2]), px.Half.z));
+    }
+    else {
+        px.Radius = fabsf(size.X);
+        px.Half = { 0.0f, 0.0f, 0.0f };
+        float h = (px.Shape == ColliderShape_Capsule) ? fabsf(size.Y) * 0.5f : 0.0f;
+        XMVECTOR up = XMVectorScale(rot.r[1], h);
+        XMStoreFloat3(&px.P0, XMVectorSubtract(c, up));
+        XMStoreFloat3(&px.P1, XMVectorAdd(c, up));
+        ext = XMVectorAdd(XMVectorAbs(up), XMVectorReplicate(px.Radius));
+    }
+    XMStoreFloat3(&px.Min, XMVectorSubtract(c, ext));
+    XMStoreFloat3(&px.Max, XMVectorAdd(c, ext));
+}
+
+//-----------------------------------------
+// 最近点
+//-----------------------------------------
+// 箱の中（表面含む）で p に一番近い点
+static XMVECTOR ClosestOnBox(const ColliderProxy& box, FXMVECTOR p)
+{
+    XMVECTOR c = XMLoadFloat3(&box.Center);
+    XMVECTOR d = XMVectorSubtract(p, c);
+    const float* half = &box.Half.x;
+    XMVECTOR q = c;
+    for (int k = 0; k < 3; ++k) {
+        XMVECTOR axis = XMLoadFloat3(&box.Axis[k]);
+        float t = XMVectorGetX(XMVector3Dot(d, axis));
+        t = t < -half[k] ? -half[k] : (t > half[k] ? half[k] : t);
+        q = XMVectorAdd(q, XMVectorScale(axis, t));
+    }
+    return q;
+}
+
+// 線分 a-b 上で p に一番近い点
+static XMVECTOR ClosestOnSegment(FXMVECTOR p, FXMVECTOR a, FXMVECTOR b)
+{
+    XMVECTOR ab = XMVectorSubtract(b, a);
+    float len2 = XMVectorGetX(XMVector3LengthSq(ab));
+    if (len2 < 1e-12f) return a;
+    float t = XMVectorGetX(XMVector3Dot(XMVectorSubtract(p, a), ab)) / len2;
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    return XMVectorAdd(a, XMVectorScale(ab, t));
+}
+
+// 線分 p1-q1 と p2-q2 の最近点の組（端点でつぶれている線分も可）
+static void ClosestSegmentSegment(FXMVECTOR p1, FXMVECTOR q1, FXMVECTOR p2, GXMVECTOR q2, XMVECTOR* c1, XMVECTOR* c2)
+{
+    XMVECTOR d1 = XMVectorSubtract(q1, p1);
+    XMVECTOR d2 = XMVectorSubtract(q2, p2);
+    XMVECTOR r = XMVectorSubtract(p1, p2);
+    float a = XMVectorGetX(XMVector3LengthSq(d1));
+    float e = XMVectorGetX(XMVector3LengthSq(d2));
+    float f = XMVectorGetX(XMVector3Dot(d2, r));
+    float s = 0.0f, t = 0.0f;
+
+    if (a < 1e-12f && e < 1e-12f) { *c1 = p1; *c2 = p2; return; }
+    if (a < 1e-12f) {
+        t = f / e;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    }
+    else {
+        float c = XMVectorGetX(XMVector3Dot(d1, r));
+        if (e < 1e-12f) {
+            s = -c / a;
+            s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+        }
+        else {
+            float b = XMVectorGetX(XMVector3Dot(d1, d2));
+            float denom = a * e - b * b;
+            s = denom > 1e-12f ? (b * f - c * e) / denom : 0.0f;   // 平行なら端から
+            s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = -c / a;
+                s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+            }
+            else if (t > 1.0f) {
+                t = 1.0f;
+                s = (b - c) / a;
+                s = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+            }
+        }
+    }
+    *c1 = XMVectorAdd(p1, XMVectorScale(d1, s));
+    *c2 = XMVectorAdd(p2, XMVectorScale(d2, t));
+}
+
+//-----------------------------------------
+// 詳細判定（Normal は A から B 向き、W にめり込み量）
+//-----------------------------------------
+static void Contact_Set(CollisionContact* out, FXMVECTOR normal, float depth, FXMVECTOR point)
+{
+    XMFLOAT3 n, pt;
+    XMStoreFloat3(&n, normal);
+    XMStoreFloat3(&pt, point);
+    out->Normal = { n.x, n.y, n.z, depth };
+    out->Point = { pt.x, pt.y, pt.z, 0.0f };
+}
+
+// 球 × 球（線分同士の最近点に置いた球で使う）
+static bool Collide_SphereSphere(FXMVECTOR ca, float ra, FXMVECTOR cb, float rb, CollisionContact* out)
+{
+    XMVECTOR d = XMVectorSubtract(cb, ca);
+    float dist2 = XMVectorGetX(XMVector3LengthSq(d));
+    float r = ra + rb;
+    if (dist2 > r * r) return false;
+    float dist = sqrtf(dist2);
+    XMVECTOR n = dist > 1e-6f ? XMVectorScale(d, 1.0f / dist) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    float depth = r - dist;
+    Contact_Set(out, n, depth, XMVectorAdd(ca, XMVectorScale(n, ra - depth * 0.5f)));
+    return true;
+}
+
+// 線分 + 半径 同士（球 / カプセル）
+static bool Collide_RoundRound(const ColliderProxy& a, const ColliderProxy& b, CollisionContact* out)
+{
+    XMVECTOR ca, cb;
+    ClosestSegmentSegment(XMLoadFloat3(&a.P0), XMLoadFloat3(&a.P1), XMLoadFloat3(&b.P0), XMLoadFloat3(&b.P1), &ca, &cb);
+    return Collide_SphereSphere(ca, a.Radius, cb, b.Radius, out);
+}
+
+// 箱 × 球（中心が箱の中なら一番浅い面から押し出す）
+static bool Collide_BoxSphere(const ColliderProxy& box, FXMVECTOR c, float r, CollisionContact* out)
+{
+    XMVECTOR q = ClosestOnBox(box, c);
+    XMVECTOR d = XMVectorSubtract(c, q);
+    float dist2 = XMVectorGetX(XMVector3LengthSq(d));
+    if (dist2 > r * r) return false;
+    if (dist2 > 1e-12f) {
+        float dist = sqrtf(dist2);
+        Contact_Set(out, XMVectorScale(d, 1.0f / dist), r - dist, q);
+        return true;
+    }
+
+    XMVECTOR local = XMVectorSubtract(c, XMLoadFloat3(&box.Center));
+    const float* half = &box.Half.x;
+    int best = 0;
+    float bestGap = FLT_MAX, bestSign = 1.0f;
+    for (int k = 0; k < 3; ++k) {
+        float t = XMVectorGetX(XMVector3Dot(local, XMLoadFloat3(&box.Axis[k])));
+        float gap = half[k] - fabsf(t);
+        if (gap < bestGap) { bestGap = gap; best = k; bestSign = t < 0.0f ? -1.0f : 1.0f; }
+    }
+    Contact_Set(out, XMVectorScale(XMLoadFloat3(&box.Axis[best]), bestSign), r + bestGap, c);
+    return true;
+}
+
+// 箱 × 線分 + 半径：線分上の点と箱の距離は下に凸なので 3 分探索で一番近い点を探す
+static bool Collide_BoxRound(const ColliderProxy& box, const ColliderProxy& round, CollisionContact* out)
+{
+    XMVECTOR p0 = XMLoadFloat3(&round.P0);
+    XMVECTOR p1 = XMLoadFloat3(&round.P1);
+    if (round.Shape == ColliderShape_Sphere) return Collide_BoxSphere(box, p0, round.Radius, out);
+
+    float lo = 0.0f, hi = 1.0f;
+    for (int step = 0; step < COLLISION_LINE_STEPS; ++step) {
+        float m1 = lo + (hi - lo) * (1.0f / 3.0f);
+        float m2 = hi - (hi - lo) * (1.0f / 3.0f);
+        XMVECTOR a = XMVectorLerp(p0, p1, m1);
+        XMVECTOR b = XMVectorLerp(p0, p1, m2);
+        float da = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(a, ClosestOnBox(box, a))));
+        float db = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(b, ClosestOnBox(box, b))));
+        if (da <= db) hi = m2; else lo = m1;
+    }
+    XMVECTOR c = XMVectorLerp(p0, p1, (lo + hi) * 0.5f);
+    // 線分が箱を貫いているときは箱の中心に一番近い点から押し出す
+    if (XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(c, ClosestOnBox(box, c)))) < 1e-12f)
+        c = ClosestOnSegment(XMLoadFloat3(&box.Center), p0, p1);
+    return Collide_BoxSphere(box, c, round.Radius, out);
+}
+
+// 箱 × 箱：分離軸（面 3 + 3、辺の組 9）。一番浅い軸で押し出す
+static bool Collide_BoxBox(const ColliderProxy& a, const ColliderProxy& b, CollisionContact* out)
+{
+    XMVECTOR axA[3], axB[3];
+    for (int k = 0; k < 3; ++k) { axA[k] = XMLoadFloat3(&a.Axis[k]); axB[k] = XMLoadFloat3(&b.Axis[k]); }
+    const float* ha = &a.Half.x;
+    const float* hb = &b.Half.x;
+    XMVECTOR d = XMVectorSubtract(XMLoadFloat3(&b.Center), XMLoadFloat3(&a.Center));
+
+    float R[3][3], AbsR[3][3], t[3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            R[i][j] = XMVectorGetX(XMVector3Dot(axA[i], axB[j]));
+            AbsR[i][j] = fabsf(R[i][j]) + 1e-6f;    // 平行な辺で外積が 0 になるのを避ける
+        }
+        t[i] = XMVectorGetX(XMVector3Dot(d, axA[i]));
+    }
+
+    float best = FLT_MAX;
+    XMVECTOR bestAxis = axA[0];
+    auto test = [&](FXMVECTOR axis, float ra, float rb, float dist, float len, bool edge) -> bool
+    {
+        float overlap = ra + rb - fabsf(dist);
+        if (overlap < 0.0f) return false;
+        if (len < 1e-6f) return true;               // 平行な辺の組は面の軸で足りる
+        overlap /= len;
+        if (edge) overlap *= 1.05f;                 // 同じくらいなら面の軸を選ぶ
+        if (overlap < best) {
+            best = overlap;
+            XMVECTOR n = XMVectorScale(axis, 1.0f / len);
+            bestAxis = dist < 0.0f ? XMVectorNegate(n) : n;
+        }
+        return true;
+    };
+
+    // A の面
+    for (int i = 0; i < 3; ++i)
+        if (!test(axA[i], ha[i], hb[0] * AbsR[i][0] + hb[1] * AbsR[i][1] + hb[2] * AbsR[i][2], t[i], 1.0f, false)) return false;
+    // B の面
+    for (int j = 0; j < 3; ++j) {
+        float dist = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+        if (!test(axB[j], ha[0] * AbsR[0][j] + ha[1] * AbsR[1][j] + ha[2] * AbsR[2][j], hb[j], dist, 1.0f, false)) return false;
+    }
+    // 辺 × 辺（A の i 軸 × B の j 軸）
+    for (int i = 0; i < 3; ++i) {
+        int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; ++j) {
+            int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            float ra = ha[i1] * AbsR[i2][j] + ha[i2] * AbsR[i1][j];
+            float rb = hb[j1] * AbsR[i][j2] + hb[j2] * AbsR[i][j1];
+            float dist = t[i2] * R[i1][j] - t[i1] * R[i2][j];
+            XMVECTOR axis = XMVector3Cross(axA[i], axB[j]);
+            float len = XMVectorGetX(XMVector3Length(axis));
+            if (!test(axis, ra, rb, dist, len, true)) return false;
+        }
+    }
+
+    // 接触点は互いの中心に一番近い点の中間
+    XMVECTOR pa = ClosestOnBox(a, XMLoadFloat3(&b.Center));
+    XMVECTOR pb = ClosestOnBox(b, XMLoadFloat3(&a.Center));
+    Contact_Set(out, bestAxis, best, XMVectorScale(XMVectorAdd(pa, pb), 0.5f));
+    return true;
+}
+
+static bool Collide(const ColliderProxy& a, const ColliderProxy& b, CollisionContact* out)
+{
+    bool boxA = a.Shape == ColliderShape_Box;
+    bool boxB = b.Shape == ColliderShape_Box;
+    bool hit;
+    if (boxA && boxB)   hit = Collide_BoxBox(a, b, out);
+    else if (boxA)      hit = Collide_BoxRound(a, b, out);
+    else if (boxB) {
+        hit = Collide_BoxRound(b, a, out);          // B → A 向きで出るので反転
+        out->Normal = { -out->Normal.X, -out->Normal.Y, -out->Normal.Z, out->Normal.W };
+    }
+    else                hit = Collide_RoundRound(a, b, out);
+    if (!hit) return false;
+    out->A = a.Index;
+    out->B = b.Index;
+    return true;
+}
+
+//-----------------------------------------
+// 広域（Sweep and Prune）
+//-----------------------------------------
+// 最小 X の順に並べ直す。対象が変わっていなければ前フレームの順から挿入ソート
+static void Sweep_Sort()
+{
+    int n = (int)g_Proxies.size();
+    bool rebuild = g_ColliderRows != g_ColliderPrevRows;
+    if (rebuild) {
+        g_ColliderPrevRows = g_ColliderRows;
+        g_SweepOrder.resize(n);
+        for (int i = 0; i < n; ++i) g_SweepOrder[i] = i;
+    }
+    else {
+        long long moves = 0, limit = (long long)n * COLLISION_SORT_LIMIT;
+        for (int i = 1; i < n && !rebuild; ++i) {
+            int key = g_SweepOrder[i];
+            float x = g_Proxies[key].Min.x;
+            int j = i - 1;
+            while (j >= 0 && g_Proxies[g_SweepOrder[j]].Min.x > x) {
+                g_SweepOrder[j + 1] = g_SweepOrder[j];
+                --j;
+                if (++moves > limit) { rebuild = true; break; }   // 大きく動いた（途中までの順はそのまま使える）
+            }
+            g_SweepOrder[j + 1] = key;
+        }
+    }
+    if (rebuild)
+        std::sort(g_SweepOrder.begin(), g_SweepOrder.end(), [](int a, int b)
+        {
+            return g_Proxies[a].Min.x < g_Proxies[b].Min.x;
+        });
+
+    // 余白は最小 X を最大にして必ず外れるようにする
+    SweepColumns& s = g_Sweep;
+    size_t padded = (size_t)n + COLLISION_PAD;
+    s.MinX.assign(padded, FLT_MAX); s.MaxX.resize(padded);
+    s.MinY.resize(padded); s.MaxY.resize(padded);
+    s.MinZ.resize(padded); s.MaxZ.resize(padded);
+    s.Proxy.resize(padded);
+    for (int k = 0; k < n; ++k) {
+        const ColliderProxy& px = g_Proxies[g_SweepOrder[k]];
+        s.MinX[k] = px.Min.x; s.MaxX[k] = px.Max.x;
+        s.MinY[k] = px.Min.y; s.MaxY[k] = px.Max.y;
+        s.MinZ[k] = px.Min.z; s.MaxZ[k] = px.Max.z;
+        s.Proxy[k] = g_SweepOrder[k];
+    }
+}
+
+// 並べた順に、自分より後ろで X が重なっている間だけ Y / Z を比べる（4個ずつ）
+static void Sweep_FindPairs()
+{
+    const SweepColumns& s = g_Sweep;
+    int n = (int)g_Proxies.size();
+    int chunks = (n + COLLISION_SWEEP_CHUNK - 1) / COLLISION_SWEEP_CHUNK;
+    if ((int)g_ChunkPairs.size() < chunks) g_ChunkPairs.resize(chunks);
+
+    Job_ParallelFor(0, chunks, 1, [&](int cb, int ce)
+    {
+        for (int chunk = cb; chunk < ce; ++chunk) {
+            std::vector<CollisionPair>& pairs = g_ChunkPairs[chunk];
+            pairs.clear();
+            int end = (chunk + 1) * COLLISION_SWEEP_CHUNK;
+            if (end > n) end = n;
+            for (int k = chunk * COLLISION_SWEEP_CHUNK; k < end; ++k) {
+                XMVECTOR maxX = XMVectorReplicate(s.MaxX[k]);
+                XMVECTOR minY = XMVectorReplicate(s.MinY[k]), maxY = XMVectorReplicate(s.MaxY[k]);
+                XMVECTOR minZ = XMVectorReplicate(s.MinZ[k]), maxZ = XMVectorReplicate(s.MaxZ[k]);
+                int a = s.Proxy[k];
+                for (int j = k + 1; s.MinX[j] <= s.MaxX[k]; j += 4) {
+                    XMVECTOR hit = XMVectorLessOrEqual(XMLoadFloat4((const XMFLOAT4*)&s.MinX[j]), maxX);
+                    hit = XMVectorAndInt(hit, XMVectorGreaterOrEqual(XMLoadFloat4((const XMFLOAT4*)&s.MaxY[j]), minY));
+                    hit = XMVectorAndInt(hit, XMVectorLessOrEqual(XMLoadFloat4((const XMFLOAT4*)&s.MinY[j]), maxY));
+                    hit = XMVectorAndInt(hit, XMVectorGreaterOrEqual(XMLoadFloat4((const XMFLOAT4*)&s.MaxZ[j]), minZ));
+                    hit = XMVectorAndInt(hit, XMVectorLessOrEqual(XMLoadFloat4((const XMFLOAT4*)&s.MinZ[j]), maxZ));
+                    XMUINT4 mask;
+                    XMStoreUInt4(&mask, hit);
+                    if ((mask.x | mask.y | mask.z | mask.w) == 0) continue;
+                    const uint32_t lanes[4] = { mask.x, mask.y, mask.z, mask.w };
+                    for (int l = 0; l < 4; ++l) {
+                        if (!lanes[l]) continue;
+                        int b = s.Proxy[j + l];
+                        if (a < b) pairs.push_back({ a, b });
+                        else       pairs.push_back({ b, a });
+                    }
+                }
+            }
+        }
+    });
+
+    g_Pairs.clear();
+    for (int chunk = 0; chunk < chunks; ++chunk)
+        g_Pairs.insert(g_Pairs.end(), g_ChunkPairs[chunk].begin(), g_ChunkPairs[chunk].end());
+}
+
+//-----------------------------------------
+// 更新（UpdateScene から毎フレーム）
+//-----------------------------------------
+void UpdateCollision(int begin, int end)
+{
+    LIA_PROFILE_SCOPE("UpdateCollision");
+    ObjectDataPool* p = GetObjectDataPool();
+    g_Contacts.clear();
+
+    if (begin < 0) begin = 0;
+    if (end > (int)p->BoxColliderPos.size) end = (int)p->BoxColliderPos.size;
+    g_ColliderRows.clear();
+    for (int i = begin; i < end; ++i)
+        if (VecBool_Get(&p->BoxColliderAlive, i)) g_ColliderRows.push_back(i);
+
+    int n = (int)g_ColliderRows.size();
+    g_Proxies.resize(n);
+    Job_ParallelFor(0, n, 0, [&](int b, int e)
+    {
+        for (int i = b; i < e; ++i) Proxy_Build(g_Proxies[i], g_ColliderRows[i]);
+    });
+
+    Sweep_Sort();
+    Sweep_FindPairs();
+
+    int pairCount = (int)g_Pairs.size();
+    g_PairContacts.resize(pairCount);
+    g_PairHit.resize(pairCount);
+    Job_ParallelFor(0, pairCount, 0, [&](int b, int e)
+    {
+        for (int i = b; i < e; ++i)
+            g_PairHit[i] = Collide(g_Proxies[g_Pairs[i].A], g_Proxies[g_Pairs[i].B], &g_PairContacts[i]) ? 1 : 0;
+    });
+
+    for (int i = 0; i < pairCount; ++i)
+        if (g_PairHit[i]) g_Contacts.push_back(g_PairContacts[i]);
+}
+
+const CollisionContact* GetCollisionContacts(int* count)
+{
+    if (count) *count = (int)g_Contacts.size();
+    return g_Contacts.empty() ? nullptr : g_Contacts.data();
+}
+
+int GetCollisionPairCount()
+{
+    return (int)g_Pairs.size();
+}
+
+void ReleaseCollision()
+{
+    std::vector<int>().swap(g_ColliderRows);
+    std::vector<int>().swap(g_ColliderPrevRows);
+    std::vector<ColliderProxy>().swap(g_Proxies);
+    std::vector<int>().swap(g_SweepOrder);
+    g_Sweep = SweepColumns();
+    std::vector<std::vector<CollisionPair>>().swap(g_ChunkPairs);
+    std::vector<CollisionPair>().swap(g_Pairs);
+    std::vector<CollisionContact>().swap(g_PairContacts);
+    std::vector<unsigned char>().swap(g_PairHit);
+    std::vector<CollisionContact>().swap(g_Contacts);
+}
@@ -5,6 +5,9 @@ class Component
 protected:
     class Object* object = nullptr;
 public:
+    bool Enabled = true;    //false: 폜ς݁iXbgėp҂jBUpdate / Draw Ȃ
+    bool Culled = false;    //true: ̊OiDrawScene t[ݒjBDraw Ȃ
+
     //ftHgRXgN^
     Component() = delete;
     //VRXgGameObjɓo^
@@ -18,4 +21,14 @@ public:
     virtual void Update() {}
     virtual void Draw() {}
     virtual void Release() {}
-};
\ No newline at end of file
+};
+
+// ^̃R|[lg̘AԁiUpdateAll / DrawAll ɓnj
+template<class T>
+struct ComponentSpan
+{
+    T* Data;
+    int Count;
+    T* begin() const { return Data; }
+    T* end() const { return Data + Count; }
+};
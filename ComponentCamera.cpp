@@ -1,41 +1,56 @@
 #include "ComponentCamera.h"
 #include "Main.h"
+#include "SystemAPI.h"
+#include <cstring>
+
+void Camera::UpdateViewProjection()
+{
+    viewProj = XMMatrixMultiply(view, proj);
+    version++;
+}
 
 void Camera::SetCameraView(DirectX::XMFLOAT4 CamPos, DirectX::XMFLOAT4 LookAt)
 {
-    view = XMMatrixLookAtLH(
+    XMMATRIX next = XMMatrixLookAtLH(
         XMVectorSet(CamPos.x, -CamPos.y, CamPos.z, 1.0f), // Jʒu
         XMVectorSet(LookAt.x, -LookAt.y, LookAt.z, 1.0f),   // _
         XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f));  // 
+    // lȂ牽Ȃit[lĂs̍ČvZNȂj
+    if (memcmp(&next, &view, sizeof(XMMATRIX)) == 0) return;
+    view = next;
+    UpdateViewProjection();
 }
 
 void Camera::SetCameraProjection(float FovY, float ScreenW, float ScreenH)
 {
     if (ScreenH <= 0.0f)
     {
-        MessageBoxA(nullptr, "ScreenH <= 0.0f", "Camera Error", MB_OK);
+        System_MessageBox("ScreenH <= 0.0f", "Camera Error");
         ScreenH = 1.0f;
     }
 
     if (ScreenW <= 0.0f)
     {
-        MessageBoxA(nullptr, "ScreenW <= 0.0f", "Camera Error", MB_OK);
+        System_MessageBox("ScreenW <= 0.0f", "Camera Error");
         ScreenW = 1.0f;
     }
 
     if (FovY <= 0.0f || FovY >= 179.0f)
     {
-        MessageBoxA(nullptr, "FovY slłB", "Camera Error", MB_OK);
+        System_MessageBox("FovY slłB", "Camera Error");
         FovY = 70.0f;
     }
 
     float aspect = ScreenW / ScreenH;
 
-    proj
+    XMMATRIX next
         = 
         XMMatrixPerspectiveFovLH(
         XMConvertToRadians(FovY),
         aspect,
         0.1f,
         100.0f);
+    if (memcmp(&next, &proj, sizeof(XMMATRIX)) == 0) return;
+    proj = next;
+    UpdateViewProjection();
 }
\ No newline at end of file
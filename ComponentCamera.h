@@ -1,8 +1,8 @@
-#pragma once
+﻿#pragma once
 
 #include "Component.h"
 
-#include <DirectXMath.h>
+#include "MathAPI.h"
 
 using namespace DirectX;
 
@@ -11,6 +11,9 @@ class Camera : public Component
 protected:
     XMMATRIX view;
     XMMATRIX proj;
+    XMMATRIX viewProj;          // view * proj（変わったときだけ計算）
+    unsigned version = 0;       // view / proj が変わるたびに +1
+    void UpdateViewProjection();
 public:
     using Component::Component;
 
@@ -25,15 +28,28 @@ public:
     {
         return proj;
     }
+    const XMMATRIX& GetViewProjection() const
+    {
+        return viewProj;
+    }
+    // 前回の値と比べて view / proj が変わったかを判定する用
+    unsigned GetVersion() const
+    {
+        return version;
+    }
 
     void Init()override
     {
         view = XMMatrixIdentity();
         proj = XMMatrixIdentity();
+        viewProj = XMMatrixIdentity();
+        version++;
     }
     void Release()override
     {
         view = XMMatrixIdentity();
         proj = XMMatrixIdentity();
+        viewProj = XMMatrixIdentity();
+        version++;
     }
 };
\ No newline at end of file
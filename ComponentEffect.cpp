@@ -0,0 +1,178 @@
+﻿// ComponentEffect.cpp
+// パーティクルの描画
+// |  インスタンス = 位置と大きさ / 色（EffectInstance）。Map(DISCARD) した先へ EffectManager が並列に直接書く
+// |  頂点は全発生源で共有の単位四角形（6頂点）。VS でカメラの右 / 上へ広げる
+// __________________________________________
+
+#include "Manager.h"     // 先に読む（Object.h が各コンポーネントのヘッダーを含むため）
+#include "ComponentEffect.h"
+#include "JobSystem.h"
+#include <iterator>
+
+using namespace DirectX;
+
+#define EFFECT_WRITE_GRAIN 8192     // インスタンス書き出しの1ジョブあたりの粒子数
+
+//-----------------------------------------
+// 全インスタンス共有のパイプライン状態（最初の Draw で1回だけ作成）
+//-----------------------------------------
+struct EffectShared {
+    RenderPtr<RenderInputLayout> Layout;
+    RenderPtr<RenderBuffer> Quad;          // 単位四角形（-0.5 .. 0.5）
+    RenderPtr<RenderBuffer> EffectBuf;
+    RenderPtr<RenderSamplerState> Sampler;
+    RenderPtr<RenderBlendState> Blend;
+    RenderPtr<RenderDepthStencilState> Depth;
+};
+static EffectShared g_EffectShared;
+
+bool Effect::CreateShared()
+{
+    RenderBlob* vsBlob = GetCurrentEffectVSBlob();
+    if (!vsBlob || !GetVertexShaderEffect() || !GetPixelShaderEffect()) return false;
+
+    // slot 0: 四角形の角 / slot 1: インスタンス
+    RenderInputElementDesc layoutDesc[] = {
+        {"POSITION", 0, RenderFormat_R32G32_Float,       0, 0,  RenderInput_PerVertex,   0},
+        {"TEXCOORD", 1, RenderFormat_R32G32B32A32_Float, 1, 0,  RenderInput_PerInstance, 1},
+        {"COLOR",    0, RenderFormat_R32G32B32A32_Float, 1, 16, RenderInput_PerInstance, 1},
+    };
+    GetDevice()->CreateInputLayout(layoutDesc, (unsigned)std::size(layoutDesc), vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &g_EffectShared.Layout);
+
+    const XMFLOAT2 quad[6] = {
+        { -0.5f,  0.5f }, {  0.5f,  0.5f }, { -0.5f, -0.5f },
+        { -0.5f, -0.5f }, {  0.5f,  0.5f }, {  0.5f, -0.5f },
+    };
+    RenderBufferDesc vbd{};
+    vbd.Usage = RenderUsage_Immutable;
+    vbd.BindFlags = RenderBind_VertexBuffer;
+    vbd.ByteWidth = sizeof(quad);
+    RenderSubresourceData init{};
+    init.pSysMem = quad;
+    GetDevice()->CreateBuffer(&vbd, &init, &g_EffectShared.Quad);
+
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Default;
+    bd.BindFlags = RenderBind_ConstantBuffer;
+    bd.ByteWidth = sizeof(EffectBuffer);
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_EffectShared.EffectBuf);
+
+    RenderSamplerDesc samp{};
+    samp.Filter = RenderFilter_Linear;
+    samp.AddressU = samp.AddressV = samp.AddressW = RenderAddress_Clamp;
+    samp.MinLOD = 0;
+    samp.MaxLOD = RENDER_LOD_MAX;
+    GetDevice()->CreateSamplerState(&samp, &g_EffectShared.Sampler);
+
+    RenderBlendDesc blendDesc{};
+    blendDesc.RenderTarget[0].BlendEnable = true;
+    blendDesc.RenderTarget[0].SrcBlend = RenderBlend_SrcAlpha;
+    blendDesc.RenderTarget[0].DestBlend = RenderBlend_InvSrcAlpha;
+    blendDesc.RenderTarget[0].BlendOp = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].SrcBlendAlpha = RenderBlend_One;
+    blendDesc.RenderTarget[0].DestBlendAlpha = RenderBlend_Zero;
+    blendDesc.RenderTarget[0].BlendOpAlpha = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].RenderTargetWriteMask = RENDER_COLOR_WRITE_ALL;
+    GetDevice()->CreateBlendState(&blendDesc, &g_EffectShared.Blend);
+
+    // 深度は比較のみ（粒子どうしは並べ替えずに重ねる）
+    RenderDepthStencilDesc dsDesc{};
+    dsDesc.DepthEnable = true;
+    dsDesc.DepthWriteMask = RenderDepthWrite_Zero;
+    dsDesc.DepthFunc = RenderCompare_Less;
+    GetDevice()->CreateDepthStencilState(&dsDesc, &g_EffectShared.Depth);
+
+    if (!g_EffectShared.Layout || !g_EffectShared.Quad || !g_EffectShared.EffectBuf) {
+        AddMessage("Effect: shared resources failed");
+        return false;
+    }
+    return true;
+}
+
+void Effect::ReleaseShared()
+{
+    g_EffectShared = EffectShared{};
+}
+
+void Effect::SetEffect(int index, const char* texturePath)
+{
+    m_index = index;
+    m_srv = (texturePath && *texturePath) ? GetTextureSRV(texturePath) : nullptr;
+    if (!m_srv) AddMessage(ConcatCStr("Effect: texture not found: ", texturePath ? texturePath : ""));
+}
+
+void Effect::SetView(const XMMATRIX& view) { ViewSet = view; }
+void Effect::SetProj(const XMMATRIX& proj) { ProjSet = proj; }
+
+void Effect::Draw()
+{
+    LIA_PROFILE_SCOPE("Effect::Draw");
+    int count = GetEffectCount(m_index);
+    if (count <= 0 || !m_srv) return;
+    if (!g_EffectShared.Layout && !CreateShared()) return;
+
+    // 容量は SetEffectDesc のときだけ変わる（その時だけ作り直す）
+    int capacity = GetEffectCapacity(m_index);
+    if (!m_instances || m_capacity < capacity)
+    {
+        m_instances.Reset();
+        m_capacity = 0;
+        RenderBufferDesc bd{};
+        bd.Usage = RenderUsage_Dynamic;
+        bd.BindFlags = RenderBind_VertexBuffer;
+        bd.CPUAccessFlags = RenderCpuAccess_Write;
+        bd.ByteWidth = (unsigned)(sizeof(EffectInstance) * capacity);
+        if (!GetDevice()->CreateBuffer(&bd, nullptr, &m_instances)) { AddMessage("Effect: CreateBuffer instances failed"); return; }
+        m_capacity = capacity;
+    }
+
+    RenderContext* ctx = GetContext();
+    RenderMappedSubresource mapped{};
+    if (!ctx->Map(m_instances.Get(), RenderMap_WriteDiscard, &mapped) || !mapped.pData) return;
+    EffectInstance* inst = static_cast<EffectInstance*>(mapped.pData);
+    const int index = m_index;
+    Job_ParallelFor(0, count, EFFECT_WRITE_GRAIN, [index, inst](int begin, int end)
+    {
+        Effect_WriteInstances(index, inst, begin, end);
+    });
+    ctx->Unmap(m_instances.Get());
+
+    // ビュー行列の転置の 0 / 1 行目 = カメラの右 / 上（ワールド）
+    XMMATRIX viewT = XMMatrixTranspose(ViewSet);
+    EffectBuffer eb;
+    eb.viewProj = XMMatrixTranspose(XMMatrixMultiply(ViewSet, ProjSet));
+    XMStoreFloat4(&eb.right, viewT.r[0]);
+    XMStoreFloat4(&eb.up, viewT.r[1]);
+    ctx->UpdateSubresource(g_EffectShared.EffectBuf.Get(), &eb);
+
+    ctx->VSSetShader(GetVertexShaderEffect());
+    ctx->PSSetShader(GetPixelShaderEffect());
+    ctx->IASetInputLayout(g_EffectShared.Layout.Get());
+    ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
+    ctx->VSSetConstantBuffers(0, 1, g_EffectShared.EffectBuf.GetAddressOf());
+    ctx->PSSetSamplers(0, 1, g_EffectShared.Sampler.GetAddressOf());
+    ctx->PSSetShaderResources(0, 1, &m_srv);
+    float blendFactor[4] = { 0,0,0,0 };
+    ctx->OMSetBlendState(g_EffectShared.Blend.Get(), blendFactor, 0xffffffff);
+    ctx->OMSetDepthStencilState(g_EffectShared.Depth.Get(), 0);
+
+    RenderBuffer* vbs[2] = { g_EffectShared.Quad.Get(), m_instances.Get() };
+    unsigned strides[2] = { sizeof(XMFLOAT2), sizeof(EffectInstance) };
+    unsigned offsets[2] = { 0, 0 };
+    ctx->IASetVertexBuffers(0, 2, vbs, strides, offsets);
+    ctx->DrawInstanced(6, (unsigned)count, 0, 0);
+
+    // slot 1 と SRV を外す（後続の描画は slot 0 のみ）
+    RenderBuffer* nullVB = nullptr;
+    unsigned zero = 0;
+    ctx->IASetVertexBuffers(1, 1, &nullVB, &zero, &zero);
+    RenderShaderResourceView* nullSRV[1] = { nullptr };
+    ctx->PSSetShaderResources(0, 1, nullSRV);
+}
+
+void Effect::Release()
+{
+    m_instances.Reset();
+    m_capacity = 0;
+    m_srv = nullptr;
+}
@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include "Component.h"
+#include "Manager.h"
+#include "Main.h" // GetDevice(), GetContext(), GetTextureSRV(), AddMessage()
+#include "MathAPI.h"
+
+using namespace DirectX;
+
+// パーティクルの発生源1つ分の描画（粒子は EffectManager が持つ）
+// |  粒子をインスタンスバッファへ直接書いて1回の DrawInstanced（カメラ向きの四角形、半透明、深度は書かない）
+class Effect : public Component
+{
+public:
+    using Component::Component;
+
+    void Draw() override;
+    void Release() override;
+    static void ReleaseShared();    // 共有のパイプライン状態を破棄（終了時）
+
+    void SetEffect(int index, const char* texturePath);    // Pool の行とテクスチャ（CreateObject が設定）
+    void SetView(const XMMATRIX& view);
+    void SetProj(const XMMATRIX& proj);
+
+private:
+    struct EffectBuffer {
+        XMMATRIX viewProj;  // 転置済み
+        XMFLOAT4 right;     // カメラの右（ワールド）
+        XMFLOAT4 up;        // カメラの上（ワールド）
+    };
+    static bool CreateShared();
+
+    int m_index = -1;
+    RenderShaderResourceView* m_srv = nullptr;
+
+    // camera matrices (set each frame by SceneManager)
+    XMMATRIX ViewSet = XMMatrixIdentity();
+    XMMATRIX ProjSet = XMMatrixIdentity();
+
+    RenderPtr<RenderBuffer> m_instances;   // DYNAMIC、m_capacity 個
+    int m_capacity = 0;
+};
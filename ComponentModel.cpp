@@ -0,0 +1,364 @@
+﻿#include "Manager.h"
+#include "ComponentModel.h"
+#include "GameLoop.h"
+#include "Main.h"
+#include <cmath>
+#include <cstring>
+
+//-----------------------------------------
+// 全インスタンス共有のパイプライン状態
+// |  最初の Init で1回だけ作る（SpriteWorld と同じ）
+// |  メッシュの頂点バッファはモデル名ごとに1つ（同じキャラクターを何体出しても増えない）
+//-----------------------------------------
+struct ModelMeshBuffers {
+    RenderPtr<RenderBuffer> Vertex;
+    RenderPtr<RenderBuffer> Skin;
+};
+struct ModelShared {
+    RenderPtr<RenderInputLayout> Layout;
+    RenderPtr<RenderInputLayout> SkinLayout;
+    RenderPtr<RenderBuffer> MatrixBuf;
+    RenderPtr<RenderBuffer> ColorBuf;
+    RenderPtr<RenderBuffer> BoneBuf;
+    RenderPtr<RenderDepthStencilState> Depth;
+    std::unordered_map<std::string, ModelMeshBuffers> Mesh;
+};
+static ModelShared g_ModelShared;
+
+bool Model::CreateShared(RenderBlob* vsBlob, RenderBlob* skinBlob)
+{
+    // --- 入力レイアウト ---
+    RenderInputElementDesc layout[] = {
+        {"POSITION",0,RenderFormat_R32G32B32_Float,0,0, RenderInput_PerVertex,0},
+        {"TEXCOORD",0,RenderFormat_R32G32_Float,0,12, RenderInput_PerVertex,0},
+        {"NORMAL",0,RenderFormat_R32G32B32_Float,0,20, RenderInput_PerVertex,0},
+        {"BLENDINDICES",0,RenderFormat_R16G16B16A16_UInt,1,0, RenderInput_PerVertex,0},
+        {"BLENDWEIGHT",0,RenderFormat_R32G32B32A32_Float,1,8, RenderInput_PerVertex,0},
+    };
+    bool ok = GetDevice()->CreateInputLayout(layout, 3, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &g_ModelShared.Layout);
+    if (ok)
+        ok = GetDevice()->CreateInputLayout(layout, 5, skinBlob->GetBufferPointer(), skinBlob->GetBufferSize(), &g_ModelShared.SkinLayout);
+    if (!ok) {
+        System_MessageBox("Model: CreateInputLayout failed", "Error");
+        return false;
+    }
+
+    // --- 定数バッファ作成 ---
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Default;
+    bd.BindFlags = RenderBind_ConstantBuffer;
+
+    bd.ByteWidth = sizeof(MatrixBuffer);
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_ModelShared.MatrixBuf);
+
+    bd.ByteWidth = sizeof(XMFLOAT4);
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_ModelShared.ColorBuf);
+
+    bd.ByteWidth = sizeof(XMMATRIX) * ANIM_GPU_BONE_MAX;
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_ModelShared.BoneBuf);
+
+    RenderDepthStencilDesc dsDesc = {};
+    dsDesc.DepthEnable = true;
+    dsDesc.DepthWriteMask = RenderDepthWrite_All;
+    dsDesc.DepthFunc = RenderCompare_Less;
+    GetDevice()->CreateDepthStencilState(&dsDesc, &g_ModelShared.Depth);
+    return true;
+}
+
+void Model::ReleaseShared()
+{
+    g_ModelShared = ModelShared{};
+}
+
+Model::~Model() {}
+
+void Model::Init()
+{
+    // === エンジンのシェーダー管理から取得 ===
+    RenderBlob* vsBlob = GetCurrentModelVSBlob();
+    RenderBlob* skinBlob = GetCurrentSkinVSBlob();
+    if (!vsBlob || !skinBlob)
+    {
+        System_MessageBox("Model: VS Blob is NULL", "ERROR");
+        return;
+    }
+    if (!g_ModelShared.Layout) CreateShared(vsBlob, skinBlob);
+}
+
+void Model::SetModelPath(const char* filename)
+{
+    if (!filename || !*filename) return;
+    modelPath = filename;
+    const char* ext = strrchr(filename, '.');
+    modelType = (ext && System_StrICmp(ext, ".obj") == 0) ? ModelType::OBJ : ModelType::FBX;
+
+    bindVertices = GetModelVertices(filename);
+    if (!bindVertices || bindVertices->empty())
+    {
+        AddMessage(ConcatCStr("Model::SetModelPath: not found ", filename));
+        bindVertices = nullptr;
+        return;
+    }
+    vertexCount = (unsigned)bindVertices->size();
+    skin = GetModelSkin(filename);
+    skeleton = skin ? GetModelSkeleton(filename) : nullptr;
+
+    if (skeleton)
+    {
+        Anim_BindPose(skeleton, &pose);
+        blendPose = pose;
+        global.resize(skeleton->NodeName.size());
+        palette.resize(skeleton->BoneNode.size());
+        skinDirty = true;
+    }
+
+    // 共有の頂点バッファ（無ければ作る）
+    ModelMeshBuffers& mesh = g_ModelShared.Mesh[modelPath];
+    if (!mesh.Vertex)
+    {
+        RenderBufferDesc bd{};
+        bd.Usage = RenderUsage_Immutable;
+        bd.BindFlags = RenderBind_VertexBuffer;
+        bd.ByteWidth = (unsigned)(sizeof(ModelVertex) * bindVertices->size());
+        RenderSubresourceData init{};
+        init.pSysMem = bindVertices->data();
+        GetDevice()->CreateBuffer(&bd, &init, &mesh.Vertex);
+
+        if (skin)
+        {
+            bd.ByteWidth = (unsigned)(sizeof(ModelSkinVertex) * skin->size());
+            init.pSysMem = skin->data();
+            GetDevice()->CreateBuffer(&bd, &init, &mesh.Skin);
+        }
+    }
+    vertexBuffer = mesh.Vertex;
+    skinBuffer = mesh.Skin;
+}
+
+void Model::SetSize(float SizeX, float SizeY, float SizeZ) { MatSize = XMMatrixScaling(SizeX, SizeY, SizeZ); }
+void Model::SetWorld(const XMMATRIX& w) { MatWorld = w; }
+void Model::SetView(const XMMATRIX& view) { ViewSet = view; }
+void Model::SetProj(const XMMATRIX& proj) { ProjSet = proj; }
+
+//-----------------------------------------
+// モーション
+//-----------------------------------------
+int Model::FindMotion(const char* filename) const
+{
+    if (!filename) return -1;
+    for (size_t i = 0; i < motions.size(); ++i)
+        if (motions[i].Name == filename) return (int)i;
+    return -1;
+}
+
+void Model::StartLayer(Layer& layer, int motion)
+{
+    layer.Motion = motion;
+    layer.Time = 0.0f;
+    layer.Cursor.assign(motions[motion].Clip->Tracks.size() * 3, 0);
+}
+
+bool Model::UseGPU() const
+{
+    return skeleton && skinBuffer && IsModelSkinningGPU() && skeleton->BoneNode.size() <= ANIM_GPU_BONE_MAX;
+}
+
+void Model::AddMotion(const char* filename)
+{
+    if (!skeleton || FindMotion(filename) >= 0) return;
+
+    // ファイル内の最初のクリップ（モデル自身のファイルでもよい）
+    const AnimPackedClip* clip = GetModelClip(filename, 0);
+    if (!clip)
+    {
+        AddMessage(ConcatCStr("Model::AddMotion: no animation ", filename));
+        return;
+    }
+    Motion m;
+    m.Name = filename;
+    m.Clip = clip;
+    Anim_MapTracks(skeleton, clip, &m.TrackNode);
+    motions.push_back(std::move(m));
+}
+
+void Model::SetMotion(const char* filename)
+{
+    int motion = FindMotion(filename);
+    if (motion < 0) { AddMotion(filename); motion = FindMotion(filename); }
+    if (motion < 0) return;
+
+    StartLayer(layers[0], motion);
+    layers[1] = Layer{};
+    blendLength = 0;
+    skinDirty = true;
+}
+
+void Model::SetMotionBlend(const char* filename, int changeFrame)
+{
+    if (changeFrame <= 0) { SetMotion(filename); return; }
+    int motion = FindMotion(filename);
+    if (motion < 0) { AddMotion(filename); motion = FindMotion(filename); }
+    if (motion < 0) return;
+
+    // 切り替え中ならその先を再生中として扱う（3つ以上は混ぜない）
+    if (blendLength > 0) { layers[0] = std::move(layers[1]); layers[1] = Layer{}; }
+    if (layers[0].Motion == motion) { blendLength = 0; return; }
+
+    StartLayer(layers[1], motion);
+    blendFrame = 0;
+    blendLength = changeFrame;
+    skinDirty = true;
+}
+
+bool Model::IsMotion(const char* filename) const
+{
+    int motion = blendLength > 0 ? layers[1].Motion : layers[0].Motion;
+    return motion >= 0 && filename && motions[motion].Name == filename;
+}
+
+//-----------------------------------------
+// 更新（時間を進めるだけ。姿勢は Skin）
+//-----------------------------------------
+void Model::UpdateAll(ComponentSpan<Model> span)
+{
+    float dt = (float)GameLoop_GetStep();
+    for (Model& m : span)
+    {
+        if (!m.Enabled || !m.skeleton) continue;
+        int layerCount = m.blendLength > 0 ? 2 : 1;
+        for (int l = 0; l < layerCount; ++l)
+        {
+            Layer& layer = m.layers[l];
+            if (layer.Motion < 0) continue;
+            float duration = m.motions[layer.Motion].Clip->Duration;
+            layer.Time += dt;
+            if (duration > 0.0f && layer.Time >= duration) layer.Time = fmodf(layer.Time, duration);    // ループ（カーソルは Anim_Sample が戻す）
+            m.skinDirty = true;
+        }
+        if (m.blendLength > 0 && ++m.blendFrame >= m.blendLength)
+        {
+            m.layers[0] = std::move(m.layers[1]);
+            m.layers[1] = Layer{};
+            m.blendLength = 0;
+        }
+    }
+}
+
+void Model::Update()
+{
+    UpdateAll(ComponentSpan<Model>{ this, 1 });
+}
+
+void Model::Skin()
+{
+    if (!skeleton || !skinDirty) return;
+
+    Anim_BindPose(skeleton, &pose);
+    if (layers[0].Motion >= 0)
+    {
+        const Motion& m = motions[layers[0].Motion];
+        Anim_Sample(m.Clip, m.TrackNode, layers[0].Time, layers[0].Cursor.data(), &pose);
+    }
+    if (blendLength > 0 && layers[1].Motion >= 0)
+    {
+        const Motion& m = motions[layers[1].Motion];
+        Anim_BindPose(skeleton, &blendPose);
+        Anim_Sample(m.Clip, m.TrackNode, layers[1].Time, layers[1].Cursor.data(), &blendPose);
+        Anim_Blend(&pose, blendPose, (float)blendFrame / (float)blendLength);
+    }
+    Anim_Palette(skeleton, pose, global.data(), palette.data());
+
+    if (!UseGPU())
+    {
+        vertices.resize(vertexCount);
+        Anim_SkinCPU(bindVertices->data(), skin->data(), (int)vertexCount, palette.data(), vertices.data());
+    }
+    skinDirty = false;
+}
+
+//-----------------------------------------
+// 描画
+//-----------------------------------------
+void Model::Draw()
+{
+    LIA_PROFILE_SCOPE("Model::Draw");
+    if (!bindVertices || !vertexBuffer || !g_ModelShared.Layout) return;
+
+    // DrawScene で並列に済ませていなければここで
+    Skin();
+    bool gpu = UseGPU();
+
+    RenderBuffer* vb = vertexBuffer.Get();
+    if (skeleton && !gpu)
+    {
+        if (!dynamicBuffer)
+        {
+            RenderBufferDesc bd{};
+            bd.Usage = RenderUsage_Dynamic;
+            bd.BindFlags = RenderBind_VertexBuffer;
+            bd.CPUAccessFlags = RenderCpuAccess_Write;
+            bd.ByteWidth = (unsigned)(sizeof(ModelVertex) * vertexCount);
+            GetDevice()->CreateBuffer(&bd, nullptr, &dynamicBuffer);
+        }
+        RenderMappedSubresource mapped{};
+        if (GetContext()->Map(dynamicBuffer.Get(), RenderMap_WriteDiscard, &mapped) && mapped.pData)
+        {
+            memcpy(mapped.pData, vertices.data(), sizeof(ModelVertex) * vertexCount);
+            GetContext()->Unmap(dynamicBuffer.Get());
+        }
+        vb = dynamicBuffer.Get();
+    }
+
+    world = MatSize * MatWorld;
+    MatrixBuffer mb;
+    mb.mvp = XMMatrixTranspose(world * ViewSet * ProjSet);
+    mb.world = XMMatrixTranspose(world);
+    GetContext()->UpdateSubresource(g_ModelShared.MatrixBuf.Get(), &mb);
+    GetContext()->UpdateSubresource(g_ModelShared.ColorBuf.Get(), &color);
+
+    // バインド
+    if (gpu)
+    {
+        XMMATRIX bones[ANIM_GPU_BONE_MAX];
+        for (size_t b = 0; b < palette.size(); ++b) bones[b] = XMMatrixTranspose(palette[b]);
+        GetContext()->UpdateSubresource(g_ModelShared.BoneBuf.Get(), bones);
+
+        RenderBuffer* vbs[2] = { vb, skinBuffer.Get() };
+        unsigned strides[2] = { sizeof(ModelVertex), sizeof(ModelSkinVertex) };
+        unsigned offsets[2] = { 0, 0 };
+        GetContext()->IASetVertexBuffers(0, 2, vbs, strides, offsets);
+        GetContext()->IASetInputLayout(g_ModelShared.SkinLayout.Get());
+        GetContext()->VSSetShader(GetVertexShaderSkin());
+        GetContext()->VSSetConstantBuffers(2, 1, g_ModelShared.BoneBuf.GetAddressOf());
+    }
+    else
+    {
+        unsigned stride = sizeof(ModelVertex), offset = 0;
+        GetContext()->IASetVertexBuffers(0, 1, &vb, &stride, &offset);
+        GetContext()->IASetInputLayout(g_ModelShared.Layout.Get());
+        GetContext()->VSSetShader(GetVertexShaderModel());
+    }
+    GetContext()->IASetPrimitiveTopology(RenderTopology_TriangleList);
+    GetContext()->VSSetConstantBuffers(0, 1, g_ModelShared.MatrixBuf.GetAddressOf());
+
+    GetContext()->PSSetShader(GetPixelShaderModel());
+    GetContext()->PSSetConstantBuffers(1, 1, g_ModelShared.ColorBuf.GetAddressOf());
+    float blendFactor[4] = { 0,0,0,0 };
+    GetContext()->OMSetBlendState(nullptr, blendFactor, 0xffffffff);
+    GetContext()->OMSetDepthStencilState(g_ModelShared.Depth.Get(), 0);
+
+    GetContext()->Draw(vertexCount, 0);
+}
+
+void Model::Release()
+{
+    vertexBuffer.Reset();
+    skinBuffer.Reset();
+    dynamicBuffer.Reset();
+    bindVertices = nullptr;
+    skin = nullptr;
+    skeleton = nullptr;
+    motions.clear();
+    layers[0] = layers[1] = Layer{};
+    blendLength = 0;
+}
@@ -7,21 +7,22 @@
 #include <vector>
 #include <unordered_map>
 
-#include <d3d11.h>
-#include <DirectXMath.h>
-#include <d3dcompiler.h>
-#include <wrl.h>
-
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-
-#pragma comment (lib, "d3dcompiler.lib")
+#include "MathAPI.h"
 
 using namespace DirectX;
-using Microsoft::WRL::ComPtr;
 
 struct ModelVertex;
+struct ModelSkinVertex;
+struct ModelSkeleton;
+struct AnimPackedClip;
+
+// Aj[V̎pim[hƂ̃[JlBAnimationManager gj
+struct AnimPose
+{
+    std::vector<XMFLOAT3> Pos;
+    std::vector<XMFLOAT4> Rot;
+    std::vector<XMFLOAT3> Scale;
+};
 
 enum class ModelType
 {
@@ -42,10 +43,14 @@ public:
     void Update()override;
     void Draw() override;
     void Release() override;
+    static void UpdateAll(ComponentSpan<Model> span);   // Đ / ؂ւ̐isip̌vZ Skinj
+    static void ReleaseShared();             // L̃pCvCԂƃbVjiIj
+
+    void Skin();                             // p  {[s  CPU XLjOi[J[XbhĂł悢j
+    bool IsMotion(const char* filename) const;  // Đi؂ւ܂ށj̃[V
 
-    void SetPos(float PosX, float PosY, float PosZ);
     void SetSize(float SizeX, float SizeY, float SizeZ);
-    void SetAngle(float AngleX, float AngleY, float AngleZ);
+    void SetWorld(const XMMATRIX& world);   // ]Eړ̃[hsiTransformManager ̌ʁBSize ͊܂܂Ȃj
 
     void SetView(const XMMATRIX& view);
     void SetProj(const XMMATRIX& proj);
@@ -56,22 +61,54 @@ public:
     void SetMotionBlend(const char* filename, int changeFrame);//[Vω
 
 private:
+    struct MatrixBuffer {
+        XMMATRIX mvp;
+        XMMATRIX world;
+    };
+    struct Motion {
+        std::string Name;
+        const AnimPackedClip* Clip = nullptr;
+        std::vector<int> TrackNode;          // gbN  m[h
+    };
+    struct Layer {
+        int Motion = -1;                     // motions ̓Yi-1: pj
+        float Time = 0.0f;                   // b
+        std::vector<int> Cursor;             // gbNƂ̑ÕL[iʒu / ] / gj
+    };
+    static bool CreateShared(RenderBlob* vsBlob, RenderBlob* skinBlob);
+    int FindMotion(const char* filename) const;
+    void StartLayer(Layer& layer, int motion);
+    bool UseGPU() const;
+
     std::string modelPath;
     ModelType modelType = ModelType::OBJ;
 
-    // assimpǂݍ݌
-    std::vector<ModelVertex> vertices;
-    std::vector<unsigned int> indices;
+    // assimpǂݍ݌ʁiAssetManager B_͖ʂƂɓWJς݁j
+    const std::vector<ModelVertex>* bindVertices = nullptr;
+    const std::vector<ModelSkinVertex>* skin = nullptr;
+    const ModelSkeleton* skeleton = nullptr;
+    unsigned vertexCount = 0;
+
+    // Aj[V
+    std::vector<Motion> motions;
+    Layer layers[2];                         // 0: Đ / 1: ؂ւ
+    int blendFrame = 0;                      // ؂ւ̌o߃t[
+    int blendLength = 0;                     // 0: ؂ւł͂Ȃ
+    AnimPose pose, blendPose;
+    std::vector<XMMATRIX> global;            // m[h̃[hs
+    std::vector<XMMATRIX> palette;           // {[s
+    std::vector<ModelVertex> vertices;       // CPU XLjǑ
+    bool skinDirty = true;
 
     // DirectX11 buffer
-    ComPtr<ID3D11Buffer> vertexBuffer;
-    ComPtr<ID3D11Buffer> indexBuffer;
-    UINT indexCount = 0;
+    RenderPtr<RenderBuffer> vertexBuffer;       // p̒_ifŋLj
+    RenderPtr<RenderBuffer> skinBuffer;         // {[ԍƏd݁ifŋLj
+    RenderPtr<RenderBuffer> dynamicBuffer;      // CPU XLjǑʁiʁADYNAMICj
+    XMFLOAT4 color{ 1,1,1,1 };
 
     // transform matrices
-    XMMATRIX MatPos = XMMatrixIdentity();
     XMMATRIX MatSize = XMMatrixIdentity();
-    XMMATRIX MatAngle = XMMatrixIdentity();
+    XMMATRIX MatWorld = XMMatrixIdentity();
     XMMATRIX world = XMMatrixIdentity();
     XMMATRIX ViewSet = XMMatrixIdentity();
     XMMATRIX ProjSet = XMMatrixIdentity();
@@ -1,4 +1,5 @@
-﻿#include "ComponentSound.h"
+﻿#include "Manager.h"     // 先に読む（Object.h が各コンポーネントのヘッダーを含むため）
+#include "ComponentSound.h"
 #include <algorithm>
 #include <cmath>
 
@@ -46,6 +47,7 @@ void Sound::Init()
     pan = 0.0f;
 
 
+#if defined(_WIN32)
     // =========================
     // WAV 読み込みテスト
     // =========================
@@ -95,6 +97,7 @@ void Sound::Init()
 
 
     m_wavData.reset(data);
+#endif
 }
 
 void Sound::Update()
@@ -127,11 +130,6 @@ void Sound::Update()
     // パンや距離減衰を実サウンドへ適用する処理をここに追加
 }
 
-void Sound::Draw()
-{
-    
-}
-
 void Sound::Release()
 {
 }
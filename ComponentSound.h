@@ -1,10 +1,12 @@
 #pragma once
 #include "Manager.h"
 #include "Component.h"
+#if defined(_WIN32)
 #include <xaudio2.h>
 #include <x3daudio.h>
+#endif
 #include <memory>
-#include <DirectXMath.h>
+#include "MathAPI.h"
 
 using namespace DirectX;
 
@@ -15,7 +17,6 @@ public:
 
     void Init() override;
     void Update() override;
-    void Draw() override;
     void Release() override;
 
     void SetMono(bool mono);
@@ -34,9 +35,11 @@ private:
     XMFLOAT3 camAng{ 0,0,0 };
     float pan = 0.0f;
 
-    // XAudio2
+#if defined(_WIN32)
+    // XAudio2iWindows ȊO͖炳Ȃj
     IXAudio2MasteringVoice* m_masterVoice = nullptr;
     IXAudio2SourceVoice* m_sourceVoice = nullptr;
+#endif
 
     // WAV f[^ێ
     std::unique_ptr<unsigned char[]> m_wavData;
@@ -1,80 +1,105 @@
-// SpriteBox.cpp
+﻿// SpriteBox.cpp
+#include "Manager.h"     // 先に読む（Object.h が各コンポーネントのヘッダーを含むため）
 #include "ComponentSpriteBox.h"
 #include "Main.h" // GetDevice(), GetContext(), GetTextureSRV(), AddMessage()
-#include <d3dcompiler.h>
 #include <cmath>
 #include <vector>
-#include <unordered_map>
 
-using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
-// store per-instance depth since header m_size is XMFLOAT2
-static std::unordered_map<const SpriteBox*, float> s_instanceDepth;
-
 SpriteBox::~SpriteBox()
 {
     Release();
-    s_instanceDepth.erase(this);
 }
 
-void SpriteBox::Init()
+//-----------------------------------------
+// 全インスタンス共有のパイプライン状態
+// |  シェーダーのコンパイルを含めて最初の Init で1回だけ行う（以前はインスタンスごとにコンパイルしていた）
+//-----------------------------------------
+struct SpriteBoxShared {
+    RenderPtr<RenderVertexShader> VS;
+    RenderPtr<RenderPixelShader> PS;
+    RenderPtr<RenderInputLayout> Layout;
+    RenderPtr<RenderBuffer> MatrixBuf;
+    RenderPtr<RenderBuffer> ColorBuf;
+    RenderPtr<RenderSamplerState> Sampler;
+    RenderPtr<RenderBlendState> Blend;
+    RenderPtr<RenderDepthStencilState> Depth;
+};
+static SpriteBoxShared g_SpriteBoxShared;
+
+bool SpriteBox::CreateShared()
 {
-    // compile shaders
-    ComPtr<ID3DBlob> vsBlob, psBlob;
-    HRESULT hr = D3DCompileFromFile(L"Shader/2D_VS.hlsl", nullptr, nullptr, "VSMain", "vs_5_0", 0, 0, &vsBlob, nullptr);
-    if (FAILED(hr)) { AddMessage("SpriteBox: VS compile failed"); return; }
-    hr = D3DCompileFromFile(L"Shader/2D_PS.hlsl", nullptr, nullptr, "PSMain", "ps_5_0", 0, 0, &psBlob, nullptr);
-    if (FAILED(hr)) { AddMessage("SpriteBox: PS compile failed"); return; }
+    // shaders: エンジンのシェーダー管理から（SpriteCylinder と同じ 2D VS / 3D PS。Shader/*.hlsl は退避済みで読めない）
+    RenderBlob* vsBlob = GetCurrent2DVSBlob();
+    if (!vsBlob || !GetVertexShader2D() || !GetPixelShader3D()) { AddMessage("SpriteBox: default shaders not ready"); return false; }
+    RenderDevice* dev = GetDevice();
 
-    ID3D11Device* dev = GetDevice();
-
-    dev->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, &m_vs);
-    dev->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &m_ps);
+    g_SpriteBoxShared.VS = GetVertexShader2D();
+    g_SpriteBoxShared.PS = GetPixelShader3D();
 
     // input layout: position(3), uv(2)
-    D3D11_INPUT_ELEMENT_DESC layout[] = {
-        { "POSITION",0,DXGI_FORMAT_R32G32B32_FLOAT,0,0, D3D11_INPUT_PER_VERTEX_DATA,0 },
-        { "TEXCOORD",0,DXGI_FORMAT_R32G32_FLOAT,0,12, D3D11_INPUT_PER_VERTEX_DATA,0 },
+    RenderInputElementDesc layout[] = {
+        { "POSITION",0,RenderFormat_R32G32B32_Float,0,0, RenderInput_PerVertex,0 },
+        { "TEXCOORD",0,RenderFormat_R32G32_Float,0,12, RenderInput_PerVertex,0 },
     };
-    dev->CreateInputLayout(layout, 2, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &m_layout);
+    dev->CreateInputLayout(layout, 2, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &g_SpriteBoxShared.Layout);
 
     // constant buffers
-    D3D11_BUFFER_DESC bd{};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Default;
+    bd.BindFlags = RenderBind_ConstantBuffer;
     bd.ByteWidth = sizeof(MatrixBuffer);
-    dev->CreateBuffer(&bd, nullptr, &m_matrixBuf);
+    dev->CreateBuffer(&bd, nullptr, &g_SpriteBoxShared.MatrixBuf);
 
     bd.ByteWidth = sizeof(ColorBuffer);
-    dev->CreateBuffer(&bd, nullptr, &m_colorBuf);
+    dev->CreateBuffer(&bd, nullptr, &g_SpriteBoxShared.ColorBuf);
 
     // sampler (wrap)
-    D3D11_SAMPLER_DESC samp{};
-    samp.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-    samp.AddressU = samp.AddressV = samp.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+    RenderSamplerDesc samp{};
+    samp.Filter = RenderFilter_Linear;
+    samp.AddressU = samp.AddressV = samp.AddressW = RenderAddress_Wrap;
     samp.MinLOD = 0;
-    samp.MaxLOD = D3D11_FLOAT32_MAX;
-    dev->CreateSamplerState(&samp, &m_samplerState);
+    samp.MaxLOD = RENDER_LOD_MAX;
+    dev->CreateSamplerState(&samp, &g_SpriteBoxShared.Sampler);
 
     // blend (standard alpha)
-    D3D11_BLEND_DESC blendDesc{};
-    blendDesc.RenderTarget[0].BlendEnable = TRUE;
-    blendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-    blendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-    blendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-    blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-    blendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-    dev->CreateBlendState(&blendDesc, &m_blendState);
+    RenderBlendDesc blendDesc{};
+    blendDesc.RenderTarget[0].BlendEnable = true;
+    blendDesc.RenderTarget[0].SrcBlend = RenderBlend_SrcAlpha;
+    blendDesc.RenderTarget[0].DestBlend = RenderBlend_InvSrcAlpha;
+    blendDesc.RenderTarget[0].BlendOp = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].SrcBlendAlpha = RenderBlend_One;
+    blendDesc.RenderTarget[0].DestBlendAlpha = RenderBlend_Zero;
+    blendDesc.RenderTarget[0].BlendOpAlpha = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].RenderTargetWriteMask = RENDER_COLOR_WRITE_ALL;
+    dev->CreateBlendState(&blendDesc, &g_SpriteBoxShared.Blend);
 
     // depth stencil: enable depth test & write
-    D3D11_DEPTH_STENCIL_DESC dsDesc{};
-    dsDesc.DepthEnable = TRUE;
-    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
-    dsDesc.DepthFunc = D3D11_COMPARISON_LESS;
-    dev->CreateDepthStencilState(&dsDesc, &m_depthState);
+    RenderDepthStencilDesc dsDesc{};
+    dsDesc.DepthEnable = true;
+    dsDesc.DepthWriteMask = RenderDepthWrite_All;
+    dsDesc.DepthFunc = RenderCompare_Less;
+    dev->CreateDepthStencilState(&dsDesc, &g_SpriteBoxShared.Depth);
+    return true;
+}
+
+void SpriteBox::ReleaseShared()
+{
+    g_SpriteBoxShared = SpriteBoxShared{};
+}
+
+void SpriteBox::Init()
+{
+    if (!g_SpriteBoxShared.VS && !CreateShared()) return;
+    m_vs = g_SpriteBoxShared.VS;
+    m_ps = g_SpriteBoxShared.PS;
+    m_layout = g_SpriteBoxShared.Layout;
+    m_matrixBuf = g_SpriteBoxShared.MatrixBuf;
+    m_colorBuf = g_SpriteBoxShared.ColorBuf;
+    m_samplerState = g_SpriteBoxShared.Sampler;
+    m_blendState = g_SpriteBoxShared.Blend;
+    m_depthState = g_SpriteBoxShared.Depth;
 
     // build initial mesh (uses current m_size and stored depth)
     BuildMesh();
@@ -87,51 +112,63 @@ void SpriteBox::SetTextureRear(const char* assetPath) { m_srvRear = GetTextureSR
 void SpriteBox::SetTextureLeft(const char* assetPath) { m_srvLeft = GetTextureSRV(assetPath); if (!m_srvLeft) AddMessage(ConcatCStr("TextureNotFound(Left):", assetPath)); }
 void SpriteBox::SetTextureRight(const char* assetPath) { m_srvRight = GetTextureSRV(assetPath); if (!m_srvRight) AddMessage(ConcatCStr("TextureNotFound(Right):", assetPath)); }
 
-void SpriteBox::SetPos(float x, float y, float z) { m_pos = { x,y,z }; }
-void SpriteBox::SetAngle(float x, float y, float z) { m_angle = { x,y,z }; }
+void SpriteBox::SetPos(float x, float y, float z) { m_pos = { x,y,z }; m_worldDirty = m_mvpDirty = true; }
+void SpriteBox::SetAngle(float x, float y, float z) { m_angle = { x,y,z }; m_worldDirty = m_mvpDirty = true; }
+void SpriteBox::SetWorld(const XMMATRIX& world) { m_world = world; m_worldDirty = false; m_mvpDirty = true; }
+void SpriteBox::SetMVP(const XMMATRIX& mvp) { m_mvp = mvp; m_mvpDirty = false; }
 void SpriteBox::SetColor(float r, float g, float b, float a) { m_color = { r,g,b,a }; }
 
 void SpriteBox::SetSize(float x, float y, float z)
 {
-    // header has m_size as XMFLOAT2; use x->m_size.x, y->m_size.y, store depth separately
+    // m_size is XMFLOAT2; depth is kept in m_depth
+    // 同じ値なら作り直さない（DrawScene が毎フレーム呼ぶ）
+    if (m_vbTop && m_size.x == x && m_size.y == y && m_depth == z) return;
     m_size.x = x;
     m_size.y = y;
-    s_instanceDepth[this] = z;
+    m_depth = z;
     BuildMesh();
 }
 
-void SpriteBox::SetView(const XMMATRIX& view) { ViewSet = view; }
-void SpriteBox::SetProj(const XMMATRIX& proj) { ProjSet = proj; }
+void SpriteBox::SetView(const XMMATRIX& view) { ViewSet = view; m_mvpDirty = true; }
+void SpriteBox::SetProj(const XMMATRIX& proj) { ProjSet = proj; m_mvpDirty = true; }
+
+void SpriteBox::UpdateMatrix()
+{
+    if (m_worldDirty) {
+        m_world =
+            XMMatrixRotationRollPitchYaw(m_angle.x, m_angle.y, m_angle.z) *
+            XMMatrixTranslation(m_pos.x, m_pos.y, m_pos.z);
+        m_worldDirty = false;
+    }
+    m_mvp = XMMatrixTranspose(m_world * ViewSet * ProjSet);
+    m_mvpDirty = false;
+}
 
 void SpriteBox::BuildMesh()
 {
     // Build six faces as separate vertex buffers (each face: 2 triangles -> 6 verts)
     float halfW = m_size.x * 0.5f;
     float halfH = m_size.y * 0.5f;
-    float halfD = 0.5f;
-    auto it = s_instanceDepth.find(this);
-    if (it != s_instanceDepth.end()) halfD = it->second * 0.5f;
-    else halfD = 0.5f; // default depth 1.0 if not set
+    float halfD = m_depth * 0.5f;
 
     // Vertex layout: position, uv
     struct V { XMFLOAT3 p; XMFLOAT2 uv; };
 
     // Helper to create a face VB given 4 corner positions (clockwise when looking at outside)
-    auto createFaceVB = [&](const XMFLOAT3& p00, const XMFLOAT3& p10, const XMFLOAT3& p11, const XMFLOAT3& p01) -> ComPtr<ID3D11Buffer> {
+    auto createFaceVB = [&](const XMFLOAT3& p00, const XMFLOAT3& p10, const XMFLOAT3& p11, const XMFLOAT3& p01) -> RenderPtr<RenderBuffer> {
         // UVs: p00 -> (0,0), p10 -> (1,0), p11 -> (1,1), p01 -> (0,1)
         V verts[6] = {
             { p00, {0.0f, 0.0f} }, { p10, {1.0f, 0.0f} }, { p11, {1.0f, 1.0f} },
             { p00, {0.0f, 0.0f} }, { p11, {1.0f, 1.0f} }, { p01, {0.0f, 1.0f} }
         };
-        D3D11_BUFFER_DESC bd{};
-        bd.Usage = D3D11_USAGE_IMMUTABLE;
-        bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        RenderBufferDesc bd{};
+        bd.Usage = RenderUsage_Immutable;
+        bd.BindFlags = RenderBind_VertexBuffer;
         bd.ByteWidth = sizeof(verts);
-        D3D11_SUBRESOURCE_DATA init{};
+        RenderSubresourceData init{};
         init.pSysMem = verts;
-        ComPtr<ID3D11Buffer> vb;
-        HRESULT hr = GetDevice()->CreateBuffer(&bd, &init, &vb);
-        if (FAILED(hr)) { AddMessage("SpriteBox: CreateBuffer face failed"); return nullptr; }
+        RenderPtr<RenderBuffer> vb;
+        if (!GetDevice()->CreateBuffer(&bd, &init, &vb)) { AddMessage("SpriteBox: CreateBuffer face failed"); return nullptr; }
         return vb;
         };
 
@@ -168,17 +205,16 @@ void SpriteBox::BuildMesh()
 
 void SpriteBox::Draw()
 {
+    LIA_PROFILE_SCOPE("SpriteBox::Draw");
 
-    ID3D11DeviceContext* ctx = GetContext();
+    RenderContext* ctx = GetContext();
     if (!ctx) return;
     BuildMesh();
-    // Prepare matrix
-    XMMATRIX world =
-        XMMatrixRotationRollPitchYaw(m_angle.x, m_angle.y, m_angle.z) *
-        XMMatrixTranslation(m_pos.x, m_pos.y, m_pos.z);
+    // Prepare matrix（DrawScene で並列計算済み）
+    if (m_mvpDirty) UpdateMatrix();
 
     MatrixBuffer mb;
-    mb.mvp = XMMatrixTranspose(world * ViewSet * ProjSet);
+    mb.mvp = m_mvp;
     mb.diffuseColor = m_color;
     mb.useTexture = 1;
     mb.pad = XMFLOAT3(0, 0, 0);
@@ -186,8 +222,8 @@ void SpriteBox::Draw()
     ColorBuffer cb{ m_color };
 
     // common binds
-    ctx->VSSetShader(m_vs.Get(), nullptr, 0);
-    ctx->PSSetShader(m_ps.Get(), nullptr, 0);
+    ctx->VSSetShader(m_vs.Get());
+    ctx->PSSetShader(m_ps.Get());
     ctx->IASetInputLayout(m_layout.Get());
     ctx->VSSetConstantBuffers(0, 1, m_matrixBuf.GetAddressOf());
     ctx->PSSetConstantBuffers(1, 1, m_colorBuf.GetAddressOf());
@@ -197,27 +233,27 @@ void SpriteBox::Draw()
     ctx->OMSetDepthStencilState(m_depthState.Get(), 0);
 
     // Update constant buffers
-    ctx->UpdateSubresource(m_matrixBuf.Get(), 0, nullptr, &mb, 0, 0);
-    ctx->UpdateSubresource(m_colorBuf.Get(), 0, nullptr, &cb, 0, 0);
+    ctx->UpdateSubresource(m_matrixBuf.Get(), &mb);
+    ctx->UpdateSubresource(m_colorBuf.Get(), &cb);
 
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
+    unsigned stride = sizeof(Vertex);
+    unsigned offset = 0;
 
     // Draw order: Top -> Bottom -> Front -> Rear -> Left -> Right
     // For each face: bind texture, set VB, draw 6 verts (triangle list)
 
-    auto drawFace = [&](ComPtr<ID3D11Buffer>& vb, ID3D11ShaderResourceView* srv) {
+    auto drawFace = [&](RenderPtr<RenderBuffer>& vb, RenderShaderResourceView* srv) {
         if (!vb || !srv) return;
         // bind srv
         ctx->PSSetShaderResources(0, 1, &srv);
         // bind vb
-        UINT faceStride = sizeof(Vertex);
-        UINT faceOffset = 0;
+        unsigned faceStride = sizeof(Vertex);
+        unsigned faceOffset = 0;
         ctx->IASetVertexBuffers(0, 1, vb.GetAddressOf(), &faceStride, &faceOffset);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(6, 0);
         // clear srv
-        ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+        RenderShaderResourceView* nullSRV[1] = { nullptr };
         ctx->PSSetShaderResources(0, 1, nullSRV);
         };
 
@@ -232,9 +268,9 @@ void SpriteBox::Draw()
     if (m_vbTop && m_srvTop) {
         ctx->IASetVertexBuffers(0, 1, m_vbTop.GetAddressOf(), &stride, &offset);
         ctx->PSSetShaderResources(0, 1, &m_srvTop);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(6, 0);
-        ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+        RenderShaderResourceView* nullSRV[1] = { nullptr };
         ctx->PSSetShaderResources(0, 1, nullSRV);
     }
 
@@ -242,9 +278,9 @@ void SpriteBox::Draw()
     if (m_vbBottom && m_srvBottom) {
         ctx->IASetVertexBuffers(0, 1, m_vbBottom.GetAddressOf(), &stride, &offset);
         ctx->PSSetShaderResources(0, 1, &m_srvBottom);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(6, 0);
-        ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+        RenderShaderResourceView* nullSRV[1] = { nullptr };
         ctx->PSSetShaderResources(0, 1, nullSRV);
     }
 
@@ -252,9 +288,9 @@ void SpriteBox::Draw()
     if (m_vbFront && m_srvFront) {
         ctx->IASetVertexBuffers(0, 1, m_vbFront.GetAddressOf(), &stride, &offset);
         ctx->PSSetShaderResources(0, 1, &m_srvFront);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(6, 0);
-        ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+        RenderShaderResourceView* nullSRV[1] = { nullptr };
         ctx->PSSetShaderResources(0, 1, nullSRV);
     }
 
@@ -262,9 +298,9 @@ void SpriteBox::Draw()
     if (m_vbRear && m_srvRear) {
         ctx->IASetVertexBuffers(0, 1, m_vbRear.GetAddressOf(), &stride, &offset);
         ctx->PSSetShaderResources(0, 1, &m_srvRear);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(6, 0);
-        ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+        RenderShaderResourceView* nullSRV[1] = { nullptr };
         ctx->PSSetShaderResources(0, 1, nullSRV);
     }
 
@@ -272,9 +308,9 @@ void SpriteBox::Draw()
     if (m_vbLeft && m_srvLeft) {
         ctx->IASetVertexBuffers(0, 1, m_vbLeft.GetAddressOf(), &stride, &offset);
         ctx->PSSetShaderResources(0, 1, &m_srvLeft);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(6, 0);
-        ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+        RenderShaderResourceView* nullSRV[1] = { nullptr };
         ctx->PSSetShaderResources(0, 1, nullSRV);
     }
 
@@ -282,9 +318,9 @@ void SpriteBox::Draw()
     if (m_vbRight && m_srvRight) {
         ctx->IASetVertexBuffers(0, 1, m_vbRight.GetAddressOf(), &stride, &offset);
         ctx->PSSetShaderResources(0, 1, &m_srvRight);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(6, 0);
-        ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+        RenderShaderResourceView* nullSRV[1] = { nullptr };
         ctx->PSSetShaderResources(0, 1, nullSRV);
     }
 
@@ -299,6 +335,7 @@ void SpriteBox::Release()
     m_vbRear.Reset();
     m_vbLeft.Reset();
     m_vbRight.Reset();
+    m_mvpDirty = true;
 
     m_matrixBuf.Reset();
     m_colorBuf.Reset();
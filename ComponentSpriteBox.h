@@ -1,13 +1,10 @@
-#pragma once
+﻿#pragma once
 
 #include "Manager.h"
 #include "Main.h"
 
-#include <d3dcompiler.h>
-#include <wrl/client.h>
 #include <vector>
 
-using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
 class SpriteBox : public Component
@@ -20,6 +17,7 @@ public:
 	void Init()override;
 	void Draw()override;
 	void Release()override;
+	static void ReleaseShared();	// 共有のパイプライン状態を破棄（終了時）
 
 	void SetTextureTop(const char* assetPath);
 	void SetTextureBottom(const char* assetPath);
@@ -32,9 +30,13 @@ public:
 	void SetSize(float x, float y, float z);
 	void SetAngle(float x, float y, float z);
 	void SetColor(float r, float g, float b, float a);
+	void SetWorld(const XMMATRIX& world);	// 回転・移動済みのワールド行列（SetPos / SetAngle より優先）
 
 	void SetView(const XMMATRIX& view);
 	void SetProj(const XMMATRIX& proj);
+	void UpdateMatrix();	// m_mvp を再計算（ワーカースレッドから呼んでよい）
+	void SetMVP(const XMMATRIX& mvp);	// 転置済み world * view * proj を直接設定（DrawScene の一括計算）
+	bool IsMatrixDirty() const { return m_mvpDirty; }
 
 private:
 	struct Vertex{
@@ -50,42 +52,48 @@ private:
 	struct ColorBuffer {
 		XMFLOAT4 color;
 	};
+	static bool CreateShared();
 
 	XMMATRIX ViewSet;
 	XMMATRIX ProjSet;
+	XMMATRIX m_mvp = XMMatrixIdentity();	// 転置済み world * view * proj
+	bool m_mvpDirty = true;
+	XMMATRIX m_world = XMMatrixIdentity();
+	bool m_worldDirty = true;
 
 	XMFLOAT3 m_pos{ 0,0,0 };
 	XMFLOAT3 m_angle{ 0,0,0 };
 	XMFLOAT2 m_size{ 1,1 };
+	float m_depth = 1.0f;	// 奥行き（SetSize の z）
 	XMFLOAT4 m_color{ 1,1,1,1 };
 
-	ID3D11ShaderResourceView* m_srvTop = nullptr;
-	ID3D11ShaderResourceView* m_srvBottom = nullptr;
-	ID3D11ShaderResourceView* m_srvFront = nullptr;
-	ID3D11ShaderResourceView* m_srvRear = nullptr;
-	ID3D11ShaderResourceView* m_srvLeft = nullptr;
-	ID3D11ShaderResourceView* m_srvRight = nullptr;
-
-	ComPtr<ID3D11Buffer> m_vbTop;
-	ComPtr<ID3D11Buffer> m_vbBottom;
-	ComPtr<ID3D11Buffer> m_vbFront;
-	ComPtr<ID3D11Buffer> m_vbRear;
-	ComPtr<ID3D11Buffer> m_vbLeft;
-	ComPtr<ID3D11Buffer> m_vbRight;
-
-	ComPtr<ID3D11Buffer> m_matrixBuf;
-	ComPtr<ID3D11Buffer> m_colorBuf;
-	ComPtr<ID3D11InputLayout> m_layout;
-	ComPtr<ID3D11VertexShader> m_vs;
-	ComPtr<ID3D11PixelShader> m_ps;
-
-	ComPtr<ID3D11SamplerState> m_samplerState = nullptr;
-	ComPtr<ID3D11BlendState> m_blendState = nullptr;
-
-	ComPtr<ID3D11DepthStencilState> m_depthState = nullptr;
-
-	UINT m_topVertexCount;
-	UINT m_bottomVertexCount;
+	RenderShaderResourceView* m_srvTop = nullptr;
+	RenderShaderResourceView* m_srvBottom = nullptr;
+	RenderShaderResourceView* m_srvFront = nullptr;
+	RenderShaderResourceView* m_srvRear = nullptr;
+	RenderShaderResourceView* m_srvLeft = nullptr;
+	RenderShaderResourceView* m_srvRight = nullptr;
+
+	RenderPtr<RenderBuffer> m_vbTop;
+	RenderPtr<RenderBuffer> m_vbBottom;
+	RenderPtr<RenderBuffer> m_vbFront;
+	RenderPtr<RenderBuffer> m_vbRear;
+	RenderPtr<RenderBuffer> m_vbLeft;
+	RenderPtr<RenderBuffer> m_vbRight;
+
+	RenderPtr<RenderBuffer> m_matrixBuf;
+	RenderPtr<RenderBuffer> m_colorBuf;
+	RenderPtr<RenderInputLayout> m_layout;
+	RenderPtr<RenderVertexShader> m_vs;
+	RenderPtr<RenderPixelShader> m_ps;
+
+	RenderPtr<RenderSamplerState> m_samplerState = nullptr;
+	RenderPtr<RenderBlendState> m_blendState = nullptr;
+
+	RenderPtr<RenderDepthStencilState> m_depthState = nullptr;
+
+	unsigned m_topVertexCount;
+	unsigned m_bottomVertexCount;
 
 	void BuildMesh();
 };
\ No newline at end of file
@@ -1,14 +1,172 @@
-﻿#include "ComponentSpriteCylinder.h"
+﻿#include "Manager.h"     // 先に読む（Object.h が各コンポーネントのヘッダーを含むため）
+#include "ComponentSpriteCylinder.h"
 #include "Main.h" // GetDevice(), GetContext(), GetTextureSRV(), AddMessage()
-#include <d3dcompiler.h>
-#include <vector>
+#include <algorithm>
 #include <cmath>
+#include <tuple>
+#include <iterator>
+#include <vector>
 
-using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
 static constexpr float TWO_PI = 2.0f * 3.14159265358979323846f;
 
+#define SPRITE_CYLINDER_BANK_MAX 1024   // 1回のインスタンス描画の最大数（ComponentArray のブロックと同じ）
+
+//-----------------------------------------
+// 全インスタンス共有のパイプライン状態（最初の Init で1回だけ作成）
+//-----------------------------------------
+struct SpriteCylinderShared {
+    RenderPtr<RenderInputLayout> Layout;
+    RenderPtr<RenderBuffer> MatrixBuf;
+    RenderPtr<RenderBuffer> ColorBuf;
+    RenderPtr<RenderSamplerState> Sampler;
+    RenderPtr<RenderBlendState> Blend;
+    RenderPtr<RenderDepthStencilState> Depth;
+
+    // リールバンク
+    struct UnitMesh {
+        int Seg;
+        RenderPtr<RenderBuffer> Side, Top, Bottom;
+        unsigned SideCount, TopCount, BottomCount;
+    };
+    RenderPtr<RenderInputLayout> ReelLayout;
+    RenderPtr<RenderBuffer> ReelInstances;         // DYNAMIC、SPRITE_CYLINDER_BANK_MAX 個
+    RenderPtr<RenderBuffer> ReelScroll[2];         // b0: x = 0（上下面）/ 1（側面は UV をずらす）
+    std::vector<UnitMesh> ReelMeshes;
+    std::vector<SpriteCylinder*> ReelQueue;     // 作業用
+};
+static SpriteCylinderShared g_SpriteCylinderShared;
+
+// 頂点から IMMUTABLE の頂点バッファを作る（空なら作らない。C は std::vector / FrameVector）
+template<class C>
+static void SpriteCylinder_CreateVB(const C& verts, RenderPtr<RenderBuffer>& vb, unsigned& count, const char* error)
+{
+    vb.Reset();
+    count = 0;
+    if (verts.empty()) return;
+    RenderBufferDesc vbd{};
+    vbd.Usage = RenderUsage_Immutable;
+    vbd.BindFlags = RenderBind_VertexBuffer;
+    vbd.ByteWidth = (unsigned)(verts.size() * sizeof(typename C::value_type));
+    RenderSubresourceData init{};
+    init.pSysMem = verts.data();
+    if (!GetDevice()->CreateBuffer(&vbd, &init, &vb)) { AddMessage(error); return; }
+    count = (unsigned)verts.size();
+}
+
+bool SpriteCylinder::CreateShared(RenderBlob* vsBlob)
+{
+    // Input layout: POSITION(3), TEXCOORD(2)
+    RenderInputElementDesc layoutDesc[] = {
+        {"POSITION", 0, RenderFormat_R32G32B32_Float, 0, 0, RenderInput_PerVertex, 0},
+        {"TEXCOORD", 0, RenderFormat_R32G32_Float,    0, 12, RenderInput_PerVertex, 0},
+    };
+    GetDevice()->CreateInputLayout(layoutDesc, (unsigned)std::size(layoutDesc), vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &g_SpriteCylinderShared.Layout);
+
+    // Constant buffers
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Default;
+    bd.BindFlags = RenderBind_ConstantBuffer;
+    bd.ByteWidth = sizeof(MatrixBuffer);
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_SpriteCylinderShared.MatrixBuf);
+
+    bd.ByteWidth = sizeof(ColorBuffer);
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_SpriteCylinderShared.ColorBuf);
+
+    // Sampler
+    RenderSamplerDesc samp{};
+    samp.Filter = RenderFilter_Linear;
+    samp.AddressU = samp.AddressV = samp.AddressW = RenderAddress_Wrap;
+    samp.MinLOD = 0;
+    samp.MaxLOD = RENDER_LOD_MAX;
+    GetDevice()->CreateSamplerState(&samp, &g_SpriteCylinderShared.Sampler);
+
+    // Blend state (enable alpha)
+    RenderBlendDesc blendDesc{};
+    blendDesc.RenderTarget[0].BlendEnable = true;
+    blendDesc.RenderTarget[0].SrcBlend = RenderBlend_SrcAlpha;
+    blendDesc.RenderTarget[0].DestBlend = RenderBlend_InvSrcAlpha;
+    blendDesc.RenderTarget[0].BlendOp = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].SrcBlendAlpha = RenderBlend_One;
+    blendDesc.RenderTarget[0].DestBlendAlpha = RenderBlend_Zero;
+    blendDesc.RenderTarget[0].BlendOpAlpha = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].RenderTargetWriteMask = RENDER_COLOR_WRITE_ALL;
+    GetDevice()->CreateBlendState(&blendDesc, &g_SpriteCylinderShared.Blend);
+
+    // DepthStencil: default + a no-depth-write state (we still create a normal depth state)
+    RenderDepthStencilDesc dsDesc{};
+    dsDesc.DepthEnable = true;
+    dsDesc.DepthWriteMask = RenderDepthWrite_All;
+    dsDesc.DepthFunc = RenderCompare_Less;
+    GetDevice()->CreateDepthStencilState(&dsDesc, &g_SpriteCylinderShared.Depth);
+    return g_SpriteCylinderShared.Layout.Get() != nullptr;
+}
+
+bool SpriteCylinder::CreateReelShared()
+{
+    RenderBlob* vsBlob = GetCurrentReelVSBlob();
+    if (!vsBlob || !GetVertexShaderReel() || !GetPixelShaderReel()) return false;
+
+    // slot 0: 単位円柱の頂点 / slot 1: インスタンス
+    RenderInputElementDesc layoutDesc[] = {
+        {"POSITION", 0, RenderFormat_R32G32B32_Float,    0, 0,  RenderInput_PerVertex,   0},
+        {"TEXCOORD", 0, RenderFormat_R32G32_Float,       0, 12, RenderInput_PerVertex,   0},
+        {"TEXCOORD", 1, RenderFormat_R32G32B32A32_Float, 1, 0,  RenderInput_PerInstance, 1},
+        {"TEXCOORD", 2, RenderFormat_R32G32B32A32_Float, 1, 16, RenderInput_PerInstance, 1},
+        {"TEXCOORD", 3, RenderFormat_R32G32B32A32_Float, 1, 32, RenderInput_PerInstance, 1},
+        {"TEXCOORD", 4, RenderFormat_R32G32B32A32_Float, 1, 48, RenderInput_PerInstance, 1},
+        {"COLOR",    0, RenderFormat_R32G32B32A32_Float, 1, 64, RenderInput_PerInstance, 1},
+        {"TEXCOORD", 5, RenderFormat_R32G32B32A32_Float, 1, 80, RenderInput_PerInstance, 1},
+    };
+    GetDevice()->CreateInputLayout(layoutDesc, (unsigned)std::size(layoutDesc), vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &g_SpriteCylinderShared.ReelLayout);
+
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Dynamic;
+    bd.BindFlags = RenderBind_VertexBuffer;
+    bd.CPUAccessFlags = RenderCpuAccess_Write;
+    bd.ByteWidth = sizeof(ReelInstance) * SPRITE_CYLINDER_BANK_MAX;
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_SpriteCylinderShared.ReelInstances);
+
+    for (int i = 0; i < 2; ++i) {
+        XMFLOAT4 scroll((float)i, 0, 0, 0);
+        RenderBufferDesc cbd{};
+        cbd.Usage = RenderUsage_Immutable;
+        cbd.BindFlags = RenderBind_ConstantBuffer;
+        cbd.ByteWidth = sizeof(XMFLOAT4);
+        RenderSubresourceData init{};
+        init.pSysMem = &scroll;
+        GetDevice()->CreateBuffer(&cbd, &init, &g_SpriteCylinderShared.ReelScroll[i]);
+    }
+    if (!g_SpriteCylinderShared.ReelLayout || !g_SpriteCylinderShared.ReelInstances) {
+        AddMessage("SpriteCylinder: reel bank resources failed");
+        return false;
+    }
+    return true;
+}
+
+int SpriteCylinder::ReelMesh(int seg)
+{
+    std::vector<SpriteCylinderShared::UnitMesh>& meshes = g_SpriteCylinderShared.ReelMeshes;
+    for (size_t i = 0; i < meshes.size(); ++i) if (meshes[i].Seg == seg) return (int)i;
+
+    SpriteCylinderShared::UnitMesh m{};
+    m.Seg = seg;
+    FrameVector<Vertex> side, top, bottom;
+    BuildVertices(1.0f, 1.0f, seg, side, top, bottom);
+    SpriteCylinder_CreateVB(side, m.Side, m.SideCount, "SpriteCylinder: CreateBuffer reel side failed");
+    SpriteCylinder_CreateVB(top, m.Top, m.TopCount, "SpriteCylinder: CreateBuffer reel top failed");
+    SpriteCylinder_CreateVB(bottom, m.Bottom, m.BottomCount, "SpriteCylinder: CreateBuffer reel bottom failed");
+    if (!m.Side) return -1;
+    meshes.push_back(m);
+    return (int)meshes.size() - 1;
+}
+
+void SpriteCylinder::ReleaseShared()
+{
+    g_SpriteCylinderShared = SpriteCylinderShared{};
+}
+
 void SpriteCylinder::Init()
 {
     // === エンジンのシェーダー管理から取得 ===
@@ -16,63 +174,27 @@ void SpriteCylinder::Init()
     m_ps = GetPixelShader3D();
     if (!m_vs || !m_ps)
     {
-        MessageBoxA(0, "SpriteScreen: Default shaders not ready", "ERROR", MB_OK);
+        System_MessageBox("SpriteScreen: Default shaders not ready", "ERROR");
         return;
     }
 
     // === 入力レイアウトを作成 ===
     // ♠ 必要なのは「VS のバイトコード」だが、ShaderManager では g_Default2DVSBlob を保持している
 
-    ID3DBlob* vsBlob = GetCurrent2DVSBlob();
+    RenderBlob* vsBlob = GetCurrent2DVSBlob();
     if (!vsBlob)
     {
-        MessageBoxA(nullptr, "SpriteScreen: VS Blob is NULL", "ERROR", MB_OK);
+        System_MessageBox("SpriteScreen: VS Blob is NULL", "ERROR");
         return;
     }
 
-    // Input layout: POSITION(3), TEXCOORD(2)
-    D3D11_INPUT_ELEMENT_DESC layoutDesc[] = {
-        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
-    };
-    GetDevice()->CreateInputLayout(layoutDesc, _countof(layoutDesc), vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &m_layout);
-
-    // Constant buffers
-    D3D11_BUFFER_DESC bd{};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    bd.ByteWidth = sizeof(MatrixBuffer);
-    GetDevice()->CreateBuffer(&bd, nullptr, &m_matrixBuf);
-
-    bd.ByteWidth = sizeof(ColorBuffer);
-    GetDevice()->CreateBuffer(&bd, nullptr, &m_colorBuf);
-
-    // Sampler
-    D3D11_SAMPLER_DESC samp{};
-    samp.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-    samp.AddressU = samp.AddressV = samp.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-    samp.MinLOD = 0;
-    samp.MaxLOD = D3D11_FLOAT32_MAX;
-    GetDevice()->CreateSamplerState(&samp, &m_sampler);
-
-    // Blend state (enable alpha)
-    D3D11_BLEND_DESC blendDesc{};
-    blendDesc.RenderTarget[0].BlendEnable = TRUE;
-    blendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-    blendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-    blendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-    blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-    blendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-    GetDevice()->CreateBlendState(&blendDesc, &m_blend);
-
-    // DepthStencil: default + a no-depth-write state (we still create a normal depth state)
-    D3D11_DEPTH_STENCIL_DESC dsDesc{};
-    dsDesc.DepthEnable = TRUE;
-    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
-    dsDesc.DepthFunc = D3D11_COMPARISON_LESS;
-    GetDevice()->CreateDepthStencilState(&dsDesc, &m_depth);
+    if (!g_SpriteCylinderShared.Layout && !CreateShared(vsBlob)) return;
+    m_layout = g_SpriteCylinderShared.Layout;
+    m_matrixBuf = g_SpriteCylinderShared.MatrixBuf;
+    m_colorBuf = g_SpriteCylinderShared.ColorBuf;
+    m_sampler = g_SpriteCylinderShared.Sampler;
+    m_blend = g_SpriteCylinderShared.Blend;
+    m_depth = g_SpriteCylinderShared.Depth;
 
     // Build geometry
     BuildMesh();
@@ -81,16 +203,32 @@ void SpriteCylinder::Init()
 void SpriteCylinder::SetPos(float x, float y, float z)
 {
     m_pos = { x, y, z };
+    m_worldDirty = m_mvpDirty = true;
 }
 void SpriteCylinder::SetSize(float x, float y, float z)
 {
     // API-compatible: x = radius, y = height (z ignored)
+    // 同じ値なら作り直さない（DrawScene が毎フレーム呼ぶ）
+    // リールモードは共有の単位円柱にインスタンスの行列で掛けるので作り直さない
+    if ((m_vbSide || IsReel()) && m_size.x == x && m_size.y == y && m_size.z == z) return;
     m_size = { x, y, z };
-    BuildMesh();
+    if (!IsReel()) BuildMesh();
 }
 void SpriteCylinder::SetAngle(float rx, float ry, float rz)
 {
     m_angle = { rx, ry, rz };
+    m_worldDirty = m_mvpDirty = true;
+}
+void SpriteCylinder::SetWorld(const XMMATRIX& world)
+{
+    m_world = world;
+    m_worldDirty = false;
+    m_mvpDirty = true;
+}
+void SpriteCylinder::SetMVP(const XMMATRIX& mvp)
+{
+    m_mvp = mvp;
+    m_mvpDirty = false;
 }
 void SpriteCylinder::SetColor(float r, float g, float b, float a)
 {
@@ -116,29 +254,47 @@ void SpriteCylinder::SetBottomTexture(const char* path)
 void SpriteCylinder::SetSegment(int seg)
 {
     if (seg < 3) seg = 3;
+    if ((m_vbSide || IsReel()) && m_seg == seg) return;
     m_seg = seg;
-    BuildMesh();
+    if (!IsReel()) BuildMesh();
 }
 
-void SpriteCylinder::SetView(const XMMATRIX& view) { ViewSet = view; }
-void SpriteCylinder::SetProj(const XMMATRIX& proj) { ProjSet = proj; }
+void SpriteCylinder::SetReel(int symbols, float scroll)
+{
+    bool wasReel = IsReel();
+    m_reelSymbols = symbols > 0 ? symbols : 0;
+    m_reelScroll = scroll;
+    if (wasReel && !IsReel()) BuildMesh();  // リール中の Size / 分割数を自前のメッシュへ
+}
+
+void SpriteCylinder::SetView(const XMMATRIX& view) { ViewSet = view; m_mvpDirty = true; }
+void SpriteCylinder::SetProj(const XMMATRIX& proj) { ProjSet = proj; m_mvpDirty = true; }
+
+void SpriteCylinder::UpdateMatrix()
+{
+    if (m_worldDirty) {
+        m_world = XMMatrixRotationRollPitchYaw(m_angle.x, m_angle.y, m_angle.z)
+            * XMMatrixTranslation(m_pos.x, m_pos.y, m_pos.z);
+        m_worldDirty = false;
+    }
+    m_mvp = XMMatrixTranspose(m_world * ViewSet * ProjSet);
+    m_mvpDirty = false;
+}
 
 void SpriteCylinder::Draw()
 {
+    LIA_PROFILE_SCOPE("SpriteCylinder::Draw");
     if (!m_vs || !m_ps) return;
 
     SetSegment(m_seg);
 
-    ID3D11DeviceContext* ctx = GetContext();
+    RenderContext* ctx = GetContext();
 
-    // Calculate world-view-proj
-    XMMATRIX S = XMMatrixScaling(1.0f, 1.0f, 1.0f);
-    XMMATRIX R = XMMatrixRotationRollPitchYaw(m_angle.x, m_angle.y, m_angle.z);
-    XMMATRIX T = XMMatrixTranslation(m_pos.x, m_pos.y, m_pos.z);
-    XMMATRIX world = S * R * T;
+    // world-view-proj（DrawScene で並列計算済み）
+    if (m_mvpDirty) UpdateMatrix();
 
     MatrixBuffer mb;
-    mb.mvp = XMMatrixTranspose(world * ViewSet * ProjSet);
+    mb.mvp = m_mvp;
     mb.diffuseColor = m_color;
     mb.useTexture = 1;
     mb.pad = XMFLOAT3(0, 0, 0);
@@ -146,8 +302,8 @@ void SpriteCylinder::Draw()
     ColorBuffer cb{ m_color };
 
     // Common binds
-    ctx->VSSetShader(GetVertexShader2D(), nullptr, 0);
-    ctx->PSSetShader(GetPixelShader3D(), nullptr, 0);
+    ctx->VSSetShader(GetVertexShader2D());
+    ctx->PSSetShader(GetPixelShader3D());
     ctx->IASetInputLayout(m_layout.Get());
     ctx->VSSetConstantBuffers(0, 1, m_matrixBuf.GetAddressOf());
     ctx->PSSetConstantBuffers(1, 1, m_colorBuf.GetAddressOf());
@@ -157,47 +313,130 @@ void SpriteCylinder::Draw()
     ctx->OMSetBlendState(m_blend.Get(), blendFactor, 0xffffffff);
     ctx->OMSetDepthStencilState(m_depth.Get(), 0);
 
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
+    unsigned stride = sizeof(Vertex);
+    unsigned offset = 0;
 
     // Draw Top first (triangle list)
     if (m_vbTop && m_srvTop && m_topVertexCount > 0)
     {
-        ctx->UpdateSubresource(m_matrixBuf.Get(), 0, nullptr, &mb, 0, 0);
-        ctx->UpdateSubresource(m_colorBuf.Get(), 0, nullptr, &cb, 0, 0);
+        ctx->UpdateSubresource(m_matrixBuf.Get(), &mb);
+        ctx->UpdateSubresource(m_colorBuf.Get(), &cb);
 
         ctx->PSSetShaderResources(0, 1, &m_srvTop);
         ctx->IASetVertexBuffers(0, 1, m_vbTop.GetAddressOf(), &stride, &offset);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(m_topVertexCount, 0);
     }
 
     // Draw Bottom next
     if (m_vbBottom && m_srvBottom && m_bottomVertexCount > 0)
     {
-        ctx->UpdateSubresource(m_matrixBuf.Get(), 0, nullptr, &mb, 0, 0);
-        ctx->UpdateSubresource(m_colorBuf.Get(), 0, nullptr, &cb, 0, 0);
+        ctx->UpdateSubresource(m_matrixBuf.Get(), &mb);
+        ctx->UpdateSubresource(m_colorBuf.Get(), &cb);
 
         ctx->PSSetShaderResources(0, 1, &m_srvBottom);
         ctx->IASetVertexBuffers(0, 1, m_vbBottom.GetAddressOf(), &stride, &offset);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(m_bottomVertexCount, 0);
     }
 
     // Draw Side last
     if (m_vbSide && m_srvSide && m_sideVertexCount > 0)
     {
-        ctx->UpdateSubresource(m_matrixBuf.Get(), 0, nullptr, &mb, 0, 0);
-        ctx->UpdateSubresource(m_colorBuf.Get(), 0, nullptr, &cb, 0, 0);
+        ctx->UpdateSubresource(m_matrixBuf.Get(), &mb);
+        ctx->UpdateSubresource(m_colorBuf.Get(), &cb);
 
         ctx->PSSetShaderResources(0, 1, &m_srvSide);
         ctx->IASetVertexBuffers(0, 1, m_vbSide.GetAddressOf(), &stride, &offset);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
         ctx->Draw(m_sideVertexCount, 0);
     }
 
     // Clear SRV slot 0
-    ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+    RenderShaderResourceView* nullSRV[1] = { nullptr };
+    ctx->PSSetShaderResources(0, 1, nullSRV);
+}
+
+// 通常の行は1つずつ、リールモードの行は テクスチャ3枚 + 分割数 が同じものをまとめて DrawInstanced（面ごとに1回）
+void SpriteCylinder::DrawAll(ComponentSpan<SpriteCylinder> span)
+{
+    std::vector<SpriteCylinder*>& queue = g_SpriteCylinderShared.ReelQueue;
+    queue.clear();
+    for (SpriteCylinder& c : span)
+    {
+        if (!c.Enabled || c.Culled) continue;
+        if (c.IsReel()) queue.push_back(&c);
+        else c.SpriteCylinder::Draw();
+    }
+    if (queue.empty()) return;
+    if (!g_SpriteCylinderShared.ReelLayout && !CreateReelShared()) return;
+
+    LIA_PROFILE_SCOPE("SpriteCylinder::DrawBank");
+    auto key = [](const SpriteCylinder* c) {
+        return std::make_tuple((uintptr_t)c->m_srvSide, (uintptr_t)c->m_srvTop, (uintptr_t)c->m_srvBottom, c->m_seg);
+    };
+    std::sort(queue.begin(), queue.end(), [&](const SpriteCylinder* a, const SpriteCylinder* b) { return key(a) < key(b); });
+
+    RenderContext* ctx = GetContext();
+    ctx->VSSetShader(GetVertexShaderReel());
+    ctx->PSSetShader(GetPixelShaderReel());
+    ctx->IASetInputLayout(g_SpriteCylinderShared.ReelLayout.Get());
+    ctx->IASetPrimitiveTopology(RenderTopology_TriangleList);
+    ctx->PSSetSamplers(0, 1, g_SpriteCylinderShared.Sampler.GetAddressOf());
+    float blendFactor[4] = { 0,0,0,0 };
+    ctx->OMSetBlendState(g_SpriteCylinderShared.Blend.Get(), blendFactor, 0xffffffff);
+    ctx->OMSetDepthStencilState(g_SpriteCylinderShared.Depth.Get(), 0);
+
+    for (size_t g = 0; g < queue.size();)
+    {
+        size_t e = g + 1;
+        while (e < queue.size() && e - g < SPRITE_CYLINDER_BANK_MAX && key(queue[e]) == key(queue[g])) ++e;
+        const SpriteCylinder* head = queue[g];
+        int mesh = ReelMesh(head->m_seg);
+        if (mesh < 0) { g = e; continue; }
+        const SpriteCylinderShared::UnitMesh& m = g_SpriteCylinderShared.ReelMeshes[mesh];
+
+        // インスタンス（world * view * proj は DrawScene で計算済み。Size は単位円柱へ掛ける）
+        RenderMappedSubresource mapped{};
+        if (!ctx->Map(g_SpriteCylinderShared.ReelInstances.Get(), RenderMap_WriteDiscard, &mapped) || !mapped.pData) return;
+        ReelInstance* inst = static_cast<ReelInstance*>(mapped.pData);
+        for (size_t i = g; i < e; ++i, ++inst)
+        {
+            SpriteCylinder* c = queue[i];
+            if (c->m_mvpDirty) c->UpdateMatrix();
+            const float r = c->m_size.x <= 0.0f ? 1.0f : c->m_size.x;
+            XMFLOAT4X4 mvp;
+            XMStoreFloat4x4(&mvp, XMMatrixMultiply(c->m_mvp, XMMatrixScaling(r, c->m_size.y, r)));
+            for (int row = 0; row < 4; ++row) inst->row[row] = XMFLOAT4(mvp.m[row]);
+            inst->color = c->m_color;
+            inst->uv = XMFLOAT4(c->m_reelScroll, 0, 0, 0);
+        }
+        ctx->Unmap(g_SpriteCylinderShared.ReelInstances.Get());
+
+        unsigned count = (unsigned)(e - g);
+        unsigned strides[2] = { sizeof(Vertex), sizeof(ReelInstance) };
+        unsigned offsets[2] = { 0, 0 };
+        auto drawPart = [&](RenderBuffer* vb, unsigned vertexCount, RenderShaderResourceView* srv, int scroll)
+        {
+            if (!vb || !srv || vertexCount == 0) return;
+            RenderBuffer* vbs[2] = { vb, g_SpriteCylinderShared.ReelInstances.Get() };
+            ctx->VSSetConstantBuffers(0, 1, g_SpriteCylinderShared.ReelScroll[scroll].GetAddressOf());
+            ctx->IASetVertexBuffers(0, 2, vbs, strides, offsets);
+            ctx->PSSetShaderResources(0, 1, &srv);
+            ctx->DrawInstanced(vertexCount, count, 0, 0);
+        };
+        // 上面 → 下面 → 側面（Draw と同じ順。UV をずらすのは側面だけ）
+        drawPart(m.Top.Get(), m.TopCount, head->m_srvTop, 0);
+        drawPart(m.Bottom.Get(), m.BottomCount, head->m_srvBottom, 0);
+        drawPart(m.Side.Get(), m.SideCount, head->m_srvSide, 1);
+        g = e;
+    }
+
+    // slot 1 と SRV を外す（後続の描画は slot 0 のみ）
+    RenderBuffer* nullVB = nullptr;
+    unsigned zero = 0;
+    ctx->IASetVertexBuffers(1, 1, &nullVB, &zero, &zero);
+    RenderShaderResourceView* nullSRV[1] = { nullptr };
     ctx->PSSetShaderResources(0, 1, nullSRV);
 }
 
@@ -216,23 +455,20 @@ void SpriteCylinder::Release()
     m_depth.Reset();
     m_srvSide = m_srvTop = m_srvBottom = nullptr;
     m_sideVertexCount = m_topVertexCount = m_bottomVertexCount = 0;
+    m_mvpDirty = true;
 }
 
-void SpriteCylinder::BuildMesh()
+// 半径 r・高さ h・分割数 seg の頂点（側面 / 上面 / 下面、三角形リスト）
+void SpriteCylinder::BuildVertices(float r, float h, int seg, FrameVector<Vertex>& sideVerts, FrameVector<Vertex>& topVerts, FrameVector<Vertex>& bottomVerts)
 {
-    // radius and height
-    const float r = m_size.x <= 0.0f ? 1.0f : m_size.x;
-    const float h = m_size.y;
     const float halfH = h * 0.5f;
 
-    if (m_seg < 3) m_seg = 3;
-
-    // Precompute perimeter points (m_seg+1 so last == first)
-    std::vector<XMFLOAT3> perim;
-    perim.reserve(m_seg + 1);
-    for (int i = 0; i <= m_seg; ++i)
+    // Precompute perimeter points (seg+1 so last == first)
+    FrameVector<XMFLOAT3> perim;
+    perim.reserve(seg + 1);
+    for (int i = 0; i <= seg; ++i)
     {
-        float t = (float)i / (float)m_seg;
+        float t = (float)i / (float)seg;
         float theta = t * TWO_PI;
         float x = cosf(theta) * r;
         float z = sinf(theta) * r;
@@ -242,15 +478,15 @@ void SpriteCylinder::BuildMesh()
     // --- Side (triangle list) ---
     // For each segment i: two triangles (a,b,c) and (a,c,d)
     // where a = top_i, b = bottom_i, c = bottom_i+1, d = top_i+1
-    std::vector<Vertex> sideVerts;
-    sideVerts.reserve(m_seg * 6);
-    for (int i = 0; i < m_seg; ++i)
+    sideVerts.clear();
+    sideVerts.reserve(seg * 6);
+    for (int i = 0; i < seg; ++i)
     {
         XMFLOAT3 p0 = perim[i];
         XMFLOAT3 p1 = perim[i + 1];
 
-        float u0 = (float)i / (float)m_seg;
-        float u1 = (float)(i + 1) / (float)m_seg;
+        float u0 = (float)i / (float)seg;
+        float u1 = (float)(i + 1) / (float)seg;
 
         // original positions
         Vertex top0 = { { p0.x, +halfH, p0.z }, { u0, 0.0f } };
@@ -269,30 +505,11 @@ void SpriteCylinder::BuildMesh()
         sideVerts.push_back(top0);
     }
 
-    if (!sideVerts.empty())
-    {
-        D3D11_BUFFER_DESC vbd{};
-        vbd.Usage = D3D11_USAGE_IMMUTABLE;
-        vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbd.ByteWidth = (UINT)(sideVerts.size() * sizeof(Vertex));
-        D3D11_SUBRESOURCE_DATA init{};
-        init.pSysMem = sideVerts.data();
-        m_vbSide.Reset();
-        HRESULT hr = GetDevice()->CreateBuffer(&vbd, &init, &m_vbSide);
-        if (FAILED(hr)) AddMessage("SpriteCylinder: CreateBuffer side failed");
-        m_sideVertexCount = (UINT)sideVerts.size();
-    }
-    else
-    {
-        m_vbSide.Reset();
-        m_sideVertexCount = 0;
-    }
-
     // --- Top (center + triangles) ---
-    std::vector<Vertex> topVerts;
-    topVerts.reserve(m_seg * 3);
+    topVerts.clear();
+    topVerts.reserve(seg * 3);
     Vertex centerTop{ {0.0f, +halfH, 0.0f}, {0.5f, 0.5f} };
-    for (int i = 0; i < m_seg; ++i)
+    for (int i = 0; i < seg; ++i)
     {
         XMFLOAT3 p0 = perim[i];
         XMFLOAT3 p1 = perim[i + 1];
@@ -303,30 +520,12 @@ void SpriteCylinder::BuildMesh()
         topVerts.push_back({ { p1.x, +halfH, p1.z }, uv1 });
         topVerts.push_back({ { p0.x, +halfH, p0.z }, uv0 });
     }
-    if (!topVerts.empty())
-    {
-        D3D11_BUFFER_DESC vbd{};
-        vbd.Usage = D3D11_USAGE_IMMUTABLE;
-        vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbd.ByteWidth = (UINT)(topVerts.size() * sizeof(Vertex));
-        D3D11_SUBRESOURCE_DATA init{};
-        init.pSysMem = topVerts.data();
-        m_vbTop.Reset();
-        HRESULT hr = GetDevice()->CreateBuffer(&vbd, &init, &m_vbTop);
-        if (FAILED(hr)) AddMessage("SpriteCylinder: CreateBuffer top failed");
-        m_topVertexCount = (UINT)topVerts.size();
-    }
-    else
-    {
-        m_vbTop.Reset();
-        m_topVertexCount = 0;
-    }
 
     // --- Bottom (center + triangles, reversed winding) ---
-    std::vector<Vertex> bottomVerts;
-    bottomVerts.reserve(m_seg * 3);
+    bottomVerts.clear();
+    bottomVerts.reserve(seg * 3);
     Vertex centerBottom{ {0.0f, -halfH, 0.0f}, {0.5f, 0.5f} };
-    for (int i = 0; i < m_seg; ++i)
+    for (int i = 0; i < seg; ++i)
     {
         XMFLOAT3 p0 = perim[i];
         XMFLOAT3 p1 = perim[i + 1];
@@ -338,22 +537,19 @@ void SpriteCylinder::BuildMesh()
         bottomVerts.push_back({ { p0.x, -halfH, p0.z }, uv0 });
         bottomVerts.push_back({ { p1.x, -halfH, p1.z }, uv1 });
     }
-    if (!bottomVerts.empty())
-    {
-        D3D11_BUFFER_DESC vbd{};
-        vbd.Usage = D3D11_USAGE_IMMUTABLE;
-        vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        vbd.ByteWidth = (UINT)(bottomVerts.size() * sizeof(Vertex));
-        D3D11_SUBRESOURCE_DATA init{};
-        init.pSysMem = bottomVerts.data();
-        m_vbBottom.Reset();
-        HRESULT hr = GetDevice()->CreateBuffer(&vbd, &init, &m_vbBottom);
-        if (FAILED(hr)) AddMessage("SpriteCylinder: CreateBuffer bottom failed");
-        m_bottomVertexCount = (UINT)bottomVerts.size();
-    }
-    else
-    {
-        m_vbBottom.Reset();
-        m_bottomVertexCount = 0;
-    }
+}
+
+void SpriteCylinder::BuildMesh()
+{
+    // radius and height
+    const float r = m_size.x <= 0.0f ? 1.0f : m_size.x;
+    const float h = m_size.y;
+
+    if (m_seg < 3) m_seg = 3;
+
+    FrameVector<Vertex> sideVerts, topVerts, bottomVerts;
+    BuildVertices(r, h, m_seg, sideVerts, topVerts, bottomVerts);
+    SpriteCylinder_CreateVB(sideVerts, m_vbSide, m_sideVertexCount, "SpriteCylinder: CreateBuffer side failed");
+    SpriteCylinder_CreateVB(topVerts, m_vbTop, m_topVertexCount, "SpriteCylinder: CreateBuffer top failed");
+    SpriteCylinder_CreateVB(bottomVerts, m_vbBottom, m_bottomVertexCount, "SpriteCylinder: CreateBuffer bottom failed");
 }
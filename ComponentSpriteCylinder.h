@@ -1,32 +1,38 @@
-#pragma once
+﻿#pragma once
 
 #include "Component.h"
 #include "Manager.h"
 #include "Main.h" // GetDevice(), GetContext(), GetTextureSRV(), AddMessage()
-#include <DirectXMath.h>
-#include <wrl/client.h>
+#include "MathAPI.h"
+#include <vector>
 
-using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
+template<class T> struct FrameAllocator;     // Manager.h（Manager.h から読まれたときはまだ定義されていない）
+
 class SpriteCylinder : public Component
 {
 public:
     using Component::Component;
 
     void Init() override;
-    void Update() override {}
     void Draw() override;
     void Release() override;
+    static void ReleaseShared();    // 共有のパイプライン状態を破棄（終了時）
+    static void DrawAll(ComponentSpan<SpriteCylinder> span);   // リールモードの行はテクスチャ / 分割数が同じものを1回のインスタンス描画（リールバンク）
 
     // setters (API compatible with SpriteWorld-like usage)
     void SetPos(float x, float y, float z);
     void SetSize(float x, float y, float z);
     void SetAngle(float rx, float ry, float rz); // rad
     void SetColor(float r, float g, float b, float a);
+    void SetWorld(const XMMATRIX& world); // 回転・移動済みのワールド行列（SetPos / SetAngle より優先）
 
     void SetView(const XMMATRIX& view);
     void SetProj(const XMMATRIX& proj);
+    void UpdateMatrix(); // m_mvp を再計算（ワーカースレッドから呼んでよい）
+    void SetMVP(const XMMATRIX& mvp); // 転置済み world * view * proj を直接設定（DrawScene の一括計算）
+    bool IsMatrixDirty() const { return m_mvpDirty; }
 
     void SetSideTexture(const char* path);
     void SetTopTexture(const char* path);
@@ -34,6 +40,11 @@ public:
 
     void SetSegment(int seg);
 
+    // リールモード（ReelManager の状態を DrawScene が毎フレーム渡す）
+    // |  symbols > 0: 側面の UV を scroll（0..1）だけずらして描く。メッシュは分割数ごとの単位円柱を共有し、Size はインスタンスの行列で掛ける
+    void SetReel(int symbols, float scroll);
+    bool IsReel() const { return m_reelSymbols > 0; }
+
 private:
     struct Vertex {
         XMFLOAT3 pos;
@@ -49,6 +60,17 @@ private:
     struct ColorBuffer {
         XMFLOAT4 color;
     };
+    // リールバンクのインスタンス（行列は転置済み world * view * proj に Size を掛けたもの）
+    struct ReelInstance {
+        XMFLOAT4 row[4];
+        XMFLOAT4 color;
+        XMFLOAT4 uv;        // x: UV のずらし量
+    };
+    static bool CreateShared(RenderBlob* vsBlob);
+    static bool CreateReelShared();
+    static int ReelMesh(int seg);   // 分割数 seg の単位円柱（無ければ作る）。戻り値は共有メッシュの番号（失敗は -1）
+    static void BuildVertices(float r, float h, int seg, std::vector<Vertex, FrameAllocator<Vertex>>& side,
+        std::vector<Vertex, FrameAllocator<Vertex>>& top, std::vector<Vertex, FrameAllocator<Vertex>>& bottom);    // 作業用はフレームアリーナ（FrameVector）
 
     // transform / visual
     XMFLOAT3 m_pos{ 0,0,0 };
@@ -59,32 +81,39 @@ private:
     // camera matrices (set each frame by SceneManager)
     XMMATRIX ViewSet{};
     XMMATRIX ProjSet{};
+    XMMATRIX m_mvp = XMMatrixIdentity(); // 転置済み world * view * proj
+    bool m_mvpDirty = true;
+    XMMATRIX m_world = XMMatrixIdentity();
+    bool m_worldDirty = true;
 
     // textures (raw pointers to SRV managed elsewhere)
-    ID3D11ShaderResourceView* m_srvSide = nullptr;
-    ID3D11ShaderResourceView* m_srvTop = nullptr;
-    ID3D11ShaderResourceView* m_srvBottom = nullptr;
+    RenderShaderResourceView* m_srvSide = nullptr;
+    RenderShaderResourceView* m_srvTop = nullptr;
+    RenderShaderResourceView* m_srvBottom = nullptr;
 
     // buffers & pipeline
-    ComPtr<ID3D11Buffer> m_vbSide;
-    ComPtr<ID3D11Buffer> m_vbTop;
-    ComPtr<ID3D11Buffer> m_vbBottom;
-
-    ComPtr<ID3D11InputLayout> m_layout;
-    ComPtr<ID3D11VertexShader> m_vs;
-    ComPtr<ID3D11PixelShader> m_ps;
-    ComPtr<ID3D11Buffer> m_matrixBuf;
-    ComPtr<ID3D11Buffer> m_colorBuf;
-    ComPtr<ID3D11SamplerState> m_sampler;
-    ComPtr<ID3D11BlendState> m_blend;
-    ComPtr<ID3D11DepthStencilState> m_depth;
+    RenderPtr<RenderBuffer> m_vbSide;
+    RenderPtr<RenderBuffer> m_vbTop;
+    RenderPtr<RenderBuffer> m_vbBottom;
+
+    RenderPtr<RenderInputLayout> m_layout;
+    RenderPtr<RenderVertexShader> m_vs;
+    RenderPtr<RenderPixelShader> m_ps;
+    RenderPtr<RenderBuffer> m_matrixBuf;
+    RenderPtr<RenderBuffer> m_colorBuf;
+    RenderPtr<RenderSamplerState> m_sampler;
+    RenderPtr<RenderBlendState> m_blend;
+    RenderPtr<RenderDepthStencilState> m_depth;
 
     // counts
-    UINT m_sideVertexCount = 0;
-    UINT m_topVertexCount = 0;
-    UINT m_bottomVertexCount = 0;
+    unsigned m_sideVertexCount = 0;
+    unsigned m_topVertexCount = 0;
+    unsigned m_bottomVertexCount = 0;
 
     int m_seg = 32;
 
+    int m_reelSymbols = 0;
+    float m_reelScroll = 0.0f;
+
     void BuildMesh();
 };
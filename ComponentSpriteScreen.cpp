@@ -1,9 +1,8 @@
-﻿#include "ComponentSpriteScreen.h"
+﻿#include "Manager.h"     // 先に読む（Object.h が各コンポーネントのヘッダーを含むため）
+#include "ComponentSpriteScreen.h"
 #include "Main.h"
-#include <d3dcompiler.h>
-#include <wrl/client.h>
+#include <cstring>
 
-using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
 // -----------------------------------------------------------
@@ -17,23 +16,23 @@ void SpriteScreen::Init()
 
     if (!m_vs || !m_ps)
     {
-        MessageBoxA(0, "SpriteScreen: Default shaders not ready", "ERROR", MB_OK);
+        System_MessageBox("SpriteScreen: Default shaders not ready", "ERROR");
         return;
     }
 
     // === 入力レイアウトを作成 ===
     // ♠ 必要なのは「VS のバイトコード」だが、ShaderManager では g_Default2DVSBlob を保持している
     
-    ID3DBlob* vsBlob = GetCurrent2DVSBlob();
+    RenderBlob* vsBlob = GetCurrent2DVSBlob();
     if (!vsBlob)
     {
-        MessageBoxA(nullptr, "SpriteScreen: VS Blob is NULL", "ERROR", MB_OK);
+        System_MessageBox("SpriteScreen: VS Blob is NULL", "ERROR");
         return;
     }
 
-    D3D11_INPUT_ELEMENT_DESC layout[] = {
-        {"POSITION",0,DXGI_FORMAT_R32G32B32_FLOAT,0,0,  D3D11_INPUT_PER_VERTEX_DATA,0},
-        {"TEXCOORD",0,DXGI_FORMAT_R32G32_FLOAT,   0,12, D3D11_INPUT_PER_VERTEX_DATA,0},
+    RenderInputElementDesc layout[] = {
+        {"POSITION",0,RenderFormat_R32G32B32_Float,0,0,  RenderInput_PerVertex,0},
+        {"TEXCOORD",0,RenderFormat_R32G32_Float,   0,12, RenderInput_PerVertex,0},
     };
 
     GetDevice()->CreateInputLayout(
@@ -45,16 +44,24 @@ void SpriteScreen::Init()
     );
 
     // --- 定数バッファ ---
-    D3D11_BUFFER_DESC bd{};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Default;
+    bd.BindFlags = RenderBind_ConstantBuffer;
     bd.ByteWidth = sizeof(MatrixBuffer);
     GetDevice()->CreateBuffer(&bd, nullptr, &m_matrixBuf);
 
+    // --- 頂点バッファ（1枚ぶん。Draw で毎回 Map して書き換える）---
+    RenderBufferDesc vbd{};
+    vbd.Usage = RenderUsage_Dynamic;
+    vbd.BindFlags = RenderBind_VertexBuffer;
+    vbd.CPUAccessFlags = RenderCpuAccess_Write;
+    vbd.ByteWidth = sizeof(VertexScreen) * 6;
+    GetDevice()->CreateBuffer(&vbd, nullptr, &m_vb);
+
     // --- サンプラー ---
-    D3D11_SAMPLER_DESC samp{};
-    samp.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-    samp.AddressU = samp.AddressV = samp.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+    RenderSamplerDesc samp{};
+    samp.Filter = RenderFilter_Linear;
+    samp.AddressU = samp.AddressV = samp.AddressW = RenderAddress_Clamp;
     GetDevice()->CreateSamplerState(&samp, &m_sampler);
 }
 
@@ -67,7 +74,7 @@ void SpriteScreen::SetTexture(const char* path)
     m_srv = GetTextureSRV(path);
     if (!m_srv)
     {
-        MessageBoxA(nullptr, path, "SpriteScreen: Texture not found", MB_OK);
+        System_MessageBox(path, "SpriteScreen: Texture not found");
     }
 }
 
@@ -92,8 +99,9 @@ void SpriteScreen::SetColor(float r, float g, float b, float a)
 // -----------------------------------------------------------
 void SpriteScreen::Draw()
 {
+    LIA_PROFILE_SCOPE("SpriteScreen::Draw");
 
-    if (!m_visible || !m_srv) return;
+    if (!m_visible || !m_srv || !m_vb) return;
 
     // --- 頂点データ作成 ---
     float x = m_pos.x;
@@ -110,18 +118,11 @@ void SpriteScreen::Draw()
         {{x,     y + h, 0}, {0,1}},
     };
 
-    // --- 頂点バッファ作成 ---
-    D3D11_BUFFER_DESC vbd{};
-    vbd.Usage = D3D11_USAGE_DYNAMIC;
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    vbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    vbd.ByteWidth = sizeof(verts);
-
-    D3D11_SUBRESOURCE_DATA initData{};
-    initData.pSysMem = verts;
-
-    if (m_vb) m_vb.Reset();
-    GetDevice()->CreateBuffer(&vbd, &initData, &m_vb);
+    // --- 頂点バッファ更新（作り直さない）---
+    RenderMappedSubresource mapped{};
+    if (!GetContext()->Map(m_vb.Get(), RenderMap_WriteDiscard, &mapped) || !mapped.pData) return;
+    memcpy(mapped.pData, verts, sizeof(verts));
+    GetContext()->Unmap(m_vb.Get());
 
     // --- 射影行列（スクリーン座標）---
     float width = (float)800;
@@ -131,24 +132,24 @@ void SpriteScreen::Draw()
     MatrixBuffer mb;
     mb.mvp = XMMatrixTranspose(ortho);
     mb.color = m_color;
-    GetContext()->UpdateSubresource(m_matrixBuf.Get(), 0, nullptr, &mb, 0, 0);
+    GetContext()->UpdateSubresource(m_matrixBuf.Get(), &mb);
 
     // --- 深度ステンシル無効化 ---
-    ID3D11DepthStencilState* prevDepth = nullptr;
-    UINT stencilRef = 0;
+    RenderDepthStencilState* prevDepth = nullptr;
+    unsigned stencilRef = 0;
     GetContext()->OMGetDepthStencilState(&prevDepth, &stencilRef);
     GetContext()->OMSetDepthStencilState(nullptr, 0);
 
     // --- バインド設定 ---
-    UINT stride = sizeof(VertexScreen), offset = 0;
+    unsigned stride = sizeof(VertexScreen), offset = 0;
     GetContext()->IASetVertexBuffers(0, 1, m_vb.GetAddressOf(), &stride, &offset);
-    GetContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    GetContext()->IASetPrimitiveTopology(RenderTopology_TriangleList);
     GetContext()->IASetInputLayout(m_layout.Get());
 
-    GetContext()->VSSetShader(GetVertexShader2D(), nullptr, 0);
+    GetContext()->VSSetShader(GetVertexShader2D());
     GetContext()->VSSetConstantBuffers(0, 1, m_matrixBuf.GetAddressOf());
 
-    GetContext()->PSSetShader(GetPixelShader2D(), nullptr, 0);
+    GetContext()->PSSetShader(GetPixelShader2D());
     GetContext()->PSSetShaderResources(0, 1, &m_srv);
     GetContext()->PSSetSamplers(0, 1, m_sampler.GetAddressOf()); // ← UI専用サンプラー設定
 
@@ -159,7 +160,7 @@ void SpriteScreen::Draw()
     GetContext()->OMSetDepthStencilState(prevDepth, stencilRef);
     if (prevDepth) prevDepth->Release();
 
-    /*ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
+    /*RenderShaderResourceView* nullSRV[1] = { nullptr };
     GetContext()->PSSetShaderResources(0, 1, nullSRV);*/
 }
 
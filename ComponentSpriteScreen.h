@@ -1,10 +1,7 @@
 #pragma once
 #include "Manager.h"
-#include <d3d11.h>
-#include <wrl/client.h>
-#include <DirectXMath.h>
+#include "MathAPI.h"
 
-using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
 class SpriteScreen : public Component
@@ -39,12 +36,12 @@ private:
     XMFLOAT4 m_color{ 1, 1, 1, 1 };
     bool m_visible = true;
 
-    ID3D11ShaderResourceView* m_srv = nullptr;
+    RenderShaderResourceView* m_srv = nullptr;
 
-    ComPtr<ID3D11Buffer> m_vb;
-    ComPtr<ID3D11Buffer> m_matrixBuf;
-    ComPtr<ID3D11InputLayout> m_layout;
-    ComPtr<ID3D11VertexShader> m_vs;
-    ComPtr<ID3D11PixelShader> m_ps;
-    ComPtr<ID3D11SamplerState> m_sampler; //  SpriteScreenp
+    RenderPtr<RenderBuffer> m_vb;
+    RenderPtr<RenderBuffer> m_matrixBuf;
+    RenderPtr<RenderInputLayout> m_layout;
+    RenderPtr<RenderVertexShader> m_vs;
+    RenderPtr<RenderPixelShader> m_ps;
+    RenderPtr<RenderSamplerState> m_sampler; //  SpriteScreenp
 };
@@ -2,6 +2,81 @@
 #include "ComponentSpriteWorld.h"
 #include "Main.h"
 
+//-----------------------------------------
+// 全インスタンス共有のパイプライン状態
+// |  最初の Init で1回だけ作り、各インスタンスは参照を持つだけ（Prefab などで大量に作っても増えない）
+//-----------------------------------------
+struct SpriteWorldShared {
+    RenderPtr<RenderInputLayout> Layout;
+    RenderPtr<RenderBuffer> MatrixBuf;
+    RenderPtr<RenderBuffer> ColorBuf;
+    RenderPtr<RenderSamplerState> Sampler;
+    RenderPtr<RenderBlendState> Blend;
+    RenderPtr<RenderDepthStencilState> Depth;
+    RenderPtr<RenderDepthStencilState> NoDepth;
+};
+static SpriteWorldShared g_SpriteWorldShared;
+
+bool SpriteWorld::CreateShared(RenderBlob* vsBlob)
+{
+    // --- 入力レイアウト ---
+    RenderInputElementDesc layout[] = {
+        {"POSITION",0,RenderFormat_R32G32B32_Float,0,0, RenderInput_PerVertex,0},
+        {"TEXCOORD",0,RenderFormat_R32G32_Float,0,12, RenderInput_PerVertex,0},
+    };
+    if (!GetDevice()->CreateInputLayout(layout, 2, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &g_SpriteWorldShared.Layout)) {
+        System_MessageBox("CreateInputLayout failed", "Error");
+        return false;
+    }
+
+    // --- 定数バッファ作成 ---
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Default;
+    bd.BindFlags = RenderBind_ConstantBuffer;
+
+    bd.ByteWidth = sizeof(MatrixBuffer);
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_SpriteWorldShared.MatrixBuf);
+
+    bd.ByteWidth = sizeof(ColorBuffer);
+    GetDevice()->CreateBuffer(&bd, nullptr, &g_SpriteWorldShared.ColorBuf);
+
+    // Sampler
+    RenderSamplerDesc sampDesc = {};
+    sampDesc.Filter = RenderFilter_Linear;
+    sampDesc.AddressU = sampDesc.AddressV = sampDesc.AddressW = RenderAddress_Wrap;
+    GetDevice()->CreateSamplerState(&sampDesc, &g_SpriteWorldShared.Sampler);
+
+    // Blend
+    RenderBlendDesc blendDesc = {};
+    blendDesc.RenderTarget[0].BlendEnable = true;
+    blendDesc.RenderTarget[0].SrcBlend = RenderBlend_SrcAlpha;
+    blendDesc.RenderTarget[0].DestBlend = RenderBlend_InvSrcAlpha;
+    blendDesc.RenderTarget[0].BlendOp = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].SrcBlendAlpha = RenderBlend_One;
+    blendDesc.RenderTarget[0].DestBlendAlpha = RenderBlend_Zero;
+    blendDesc.RenderTarget[0].BlendOpAlpha = RenderBlendOp_Add;
+    blendDesc.RenderTarget[0].RenderTargetWriteMask = RENDER_COLOR_WRITE_ALL;
+    GetDevice()->CreateBlendState(&blendDesc, &g_SpriteWorldShared.Blend);
+
+    // Depth stencil: 書き込み無効 or 常に成功の設定(テスト用)
+    RenderDepthStencilDesc dsDesc = {};
+    dsDesc.DepthEnable = true;
+    dsDesc.DepthWriteMask = RenderDepthWrite_All;
+    dsDesc.DepthFunc = RenderCompare_Less;
+    GetDevice()->CreateDepthStencilState(&dsDesc, &g_SpriteWorldShared.Depth);
+
+    dsDesc.DepthEnable = true; // テストの間は無効にする
+    dsDesc.DepthWriteMask = RenderDepthWrite_Zero;
+    dsDesc.DepthFunc = RenderCompare_Always;
+    GetDevice()->CreateDepthStencilState(&dsDesc, &g_SpriteWorldShared.NoDepth);
+    return true;
+}
+
+void SpriteWorld::ReleaseShared()
+{
+    g_SpriteWorldShared = SpriteWorldShared{};
+}
+
 void SpriteWorld::Init()
 {
     // === エンジンのシェーダー管理から取得 ===
@@ -9,79 +84,44 @@ void SpriteWorld::Init()
     m_ps = GetPixelShader3D();
     if (!m_vs || !m_ps)
     {
-        MessageBoxA(0, "SpriteScreen: Default shaders not ready", "ERROR", MB_OK);
+        System_MessageBox("SpriteScreen: Default shaders not ready", "ERROR");
         return;
     }
 
     // === 入力レイアウトを作成 ===
     // ♠ 必要なのは「VS のバイトコード」だが、ShaderManager では g_Default2DVSBlob を保持している
 
-    ID3DBlob* vsBlob = GetCurrent2DVSBlob();
+    RenderBlob* vsBlob = GetCurrent2DVSBlob();
     if (!vsBlob)
     {
-        MessageBoxA(nullptr, "SpriteScreen: VS Blob is NULL", "ERROR", MB_OK);
-        return;
-    }
-
-    // --- 入力レイアウト ---
-    D3D11_INPUT_ELEMENT_DESC layout[] = {
-        {"POSITION",0,DXGI_FORMAT_R32G32B32_FLOAT,0,0, D3D11_INPUT_PER_VERTEX_DATA,0},
-        {"TEXCOORD",0,DXGI_FORMAT_R32G32_FLOAT,0,12, D3D11_INPUT_PER_VERTEX_DATA,0},
-    };
-    HRESULT hr = GetDevice()->CreateInputLayout(layout, 2, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &m_layout);
-    if (FAILED(hr)) {
-        char buf[128]; sprintf_s(buf, "CreateInputLayout failed 0x%08X", (unsigned)hr);
-        MessageBoxA(nullptr, buf, "Error", MB_OK);
+        System_MessageBox("SpriteScreen: VS Blob is NULL", "ERROR");
         return;
     }
 
-    // --- 定数バッファ作成 ---
-    D3D11_BUFFER_DESC bd{};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-
-    bd.ByteWidth = sizeof(MatrixBuffer);
-    GetDevice()->CreateBuffer(&bd, nullptr, &m_matrixBuf);
-
-    bd.ByteWidth = sizeof(ColorBuffer);
-    GetDevice()->CreateBuffer(&bd, nullptr, &m_colorBuf);
-
-    // Sampler
-    D3D11_SAMPLER_DESC sampDesc = {};
-    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-    sampDesc.AddressU = sampDesc.AddressV = sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-    GetDevice()->CreateSamplerState(&sampDesc, &m_samplerState); // m_samplerState はメンバに追加しておく
-
-    // Blend
-    D3D11_BLEND_DESC blendDesc = {};
-    blendDesc.RenderTarget[0].BlendEnable = TRUE;
-    blendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-    blendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-    blendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-    blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-    blendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-    blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-    GetDevice()->CreateBlendState(&blendDesc, &m_blendState);
-
-    // Depth stencil: 書き込み無効 or 常に成功の設定(テスト用)
-    D3D11_DEPTH_STENCIL_DESC dsDesc = {};
-    dsDesc.DepthEnable = TRUE;
-    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
-    dsDesc.DepthFunc = D3D11_COMPARISON_LESS;
-    GetDevice()->CreateDepthStencilState(&dsDesc, &m_depthState);
-
-    dsDesc.DepthEnable = TRUE; // テストの間は無効にする
-    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
-    dsDesc.DepthFunc = D3D11_COMPARISON_ALWAYS;
-    GetDevice()->CreateDepthStencilState(&dsDesc, &m_noDepthState);
+    if (!g_SpriteWorldShared.Layout && !CreateShared(vsBlob)) return;
+    m_layout = g_SpriteWorldShared.Layout;
+    m_matrixBuf = g_SpriteWorldShared.MatrixBuf;
+    m_colorBuf = g_SpriteWorldShared.ColorBuf;
+    m_samplerState = g_SpriteWorldShared.Sampler.Get();
+    m_blendState = g_SpriteWorldShared.Blend.Get();
+    m_depthState = g_SpriteWorldShared.Depth.Get();
+    m_noDepthState = g_SpriteWorldShared.NoDepth.Get();
+
+    // --- 頂点バッファ（1枚ぶん。中身は Draw で大きさが変わったときに Map して書く）---
+    RenderBufferDesc bd{};
+    bd.Usage = RenderUsage_Dynamic;
+    bd.BindFlags = RenderBind_VertexBuffer;
+    bd.CPUAccessFlags = RenderCpuAccess_Write;
+    bd.ByteWidth = sizeof(Vertex) * 4;
+    GetDevice()->CreateBuffer(&bd, nullptr, &m_vb);
+    m_meshDirty = true;
 }
 
 void SpriteWorld::SetTexture(const char* assetPath)
 {
     // AssetManager経由で取得
     if (!assetPath || strlen(assetPath) == 0) {
-        MessageBoxA(nullptr, assetPath, "SpriteWorld::SetTexture: Error Invalid", MB_OK);
+        System_MessageBox(assetPath, "SpriteWorld::SetTexture: Error Invalid");
         return;
     }
 
@@ -89,75 +129,69 @@ void SpriteWorld::SetTexture(const char* assetPath)
 
     if (!m_srv)
     {
-        MessageBoxA(nullptr, assetPath, "SpriteWorld: Texture not found", MB_OK);
+        System_MessageBox(assetPath, "SpriteWorld: Texture not found");
     }
 }
 
-void SpriteWorld::SetPos(float x, float y, float z) { m_pos = { x,y,z }; }
-void SpriteWorld::SetSize(float w, float h) { m_size = { w,h }; }
-void SpriteWorld::SetAngle(float rx, float ry, float rz) { m_angle = { rx,ry,rz }; }
+void SpriteWorld::SetPos(float x, float y, float z) { m_pos = { x,y,z }; m_worldDirty = m_mvpDirty = true; }
+void SpriteWorld::SetSize(float w, float h) { if (m_size.x != w || m_size.y != h) { m_size = { w,h }; m_meshDirty = true; } }
+void SpriteWorld::SetAngle(float rx, float ry, float rz) { m_angle = { rx,ry,rz }; m_worldDirty = m_mvpDirty = true; }
+void SpriteWorld::SetWorld(const XMMATRIX& world) { m_world = world; m_worldDirty = false; m_mvpDirty = true; }
+void SpriteWorld::SetMVP(const XMMATRIX& mvp) { m_mvp = mvp; m_mvpDirty = false; }
 void SpriteWorld::SetColor(const XMFLOAT4& color) { m_color = color; }
 void SpriteWorld::SetBillboard(bool enable) { m_isBillboard = enable; }
 
 void SpriteWorld::Draw()
 {
+    LIA_PROFILE_SCOPE("SpriteWorld::Draw");
     if (!m_srv) 
     {
-        MessageBoxA(nullptr, "SpriteWorld : Error No SRV", "Draw", MB_OK);
+        System_MessageBox("SpriteWorld : Error No SRV", "Draw");
         return;
     }
 
-    char buf[256];
-    sprintf_s(buf, "Draw: srv=%p pos=(%f,%f,%f) size=(%f,%f) angle=(%f,%f,%f)",
-        m_srv, m_pos.x, m_pos.y, m_pos.z, m_size.x, m_size.y, m_angle.x, m_angle.y, m_angle.z);
-
-    // 頂点設定
-    float hw = m_size.x * 0.5f, hh = m_size.y * 0.5f;
-    Vertex verts[4] = {
-        {{-hw, hh, 0}, {0,0}},
-        {{ hw, hh, 0}, {1,0}},
-        {{-hw,-hh, 0}, {0,1}},
-        {{ hw,-hh, 0}, {1,1}},
-    };
-
-    // 頂点バッファ生成
-    if (m_vb) m_vb.Reset();
-    D3D11_BUFFER_DESC bd{};
-    bd.Usage = D3D11_USAGE_DYNAMIC;
-    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    bd.ByteWidth = sizeof(verts);
-    D3D11_SUBRESOURCE_DATA init{};
-    init.pSysMem = verts;
-    GetDevice()->CreateBuffer(&bd, &init, &m_vb);
-
-    // Billboard処理（カメラ向き）
-    XMMATRIX world = XMMatrixRotationRollPitchYaw(m_angle.x, m_angle.y, m_angle.z)
-        * XMMatrixTranslation(m_pos.x, m_pos.y, m_pos.z);
+    // 頂点設定（サイズが変わったときだけ書き換える。作り直さない）
+    if (!m_vb) return;
+    if (m_meshDirty)
+    {
+        float hw = m_size.x * 0.5f, hh = m_size.y * 0.5f;
+        Vertex verts[4] = {
+            {{-hw, hh, 0}, {0,0}},
+            {{ hw, hh, 0}, {1,0}},
+            {{-hw,-hh, 0}, {0,1}},
+            {{ hw,-hh, 0}, {1,1}},
+        };
+
+        RenderMappedSubresource mapped{};
+        if (!GetContext()->Map(m_vb.Get(), RenderMap_WriteDiscard, &mapped) || !mapped.pData) return;
+        memcpy(mapped.pData, verts, sizeof(verts));
+        GetContext()->Unmap(m_vb.Get());
+        m_meshDirty = false;
+    }
 
-    XMMATRIX view = ViewSet;
-    XMMATRIX proj = ProjSet;
+    // 行列は DrawScene で並列計算済み（未計算ならここで）
+    if (m_mvpDirty) UpdateMatrix();
 
     MatrixBuffer mb;
-    mb.mvp = XMMatrixTranspose(world * view * proj);
+    mb.mvp = m_mvp;
     mb.diffuseColor = XMFLOAT4(1, 1, 1, 1); // 必要なら変更
     mb.useTexture = (m_srv != nullptr) ? 1 : 0;
     mb.pad = XMFLOAT3(0, 0, 0);
-    GetContext()->UpdateSubresource(m_matrixBuf.Get(), 0, nullptr, &mb, 0, 0);
+    GetContext()->UpdateSubresource(m_matrixBuf.Get(), &mb);
 
     ColorBuffer cb{ m_color };
-    GetContext()->UpdateSubresource(m_colorBuf.Get(), 0, nullptr, &cb, 0, 0);
+    GetContext()->UpdateSubresource(m_colorBuf.Get(), &cb);
 
     // バインド
-    UINT stride = sizeof(Vertex), offset = 0;
+    unsigned stride = sizeof(Vertex), offset = 0;
     GetContext()->IASetVertexBuffers(0, 1, m_vb.GetAddressOf(), &stride, &offset);
-    GetContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    GetContext()->IASetPrimitiveTopology(RenderTopology_TriangleStrip);
     GetContext()->IASetInputLayout(m_layout.Get());
 
-    GetContext()->VSSetShader(GetVertexShader2D(), nullptr, 0);
+    GetContext()->VSSetShader(GetVertexShader2D());
     GetContext()->VSSetConstantBuffers(0, 1, m_matrixBuf.GetAddressOf());
 
-    GetContext()->PSSetShader(GetPixelShader3D(), nullptr, 0);
+    GetContext()->PSSetShader(GetPixelShader3D());
     GetContext()->PSSetConstantBuffers(1, 1, m_colorBuf.GetAddressOf());
 
     GetContext()->PSSetShaderResources(0, 1, &m_srv);
@@ -180,7 +214,11 @@ void SpriteWorld::Release()
     m_layout.Reset();
     m_vs.Reset();
     m_ps.Reset();
+    m_samplerState = nullptr;
+    m_blendState = nullptr;
+    m_depthState = m_noDepthState = nullptr;
     m_srv = nullptr;
+    m_mvpDirty = true;
 }
 
 void SpriteWorld::SetView(const XMMATRIX& view)
@@ -189,6 +227,7 @@ void SpriteWorld::SetView(const XMMATRIX& view)
     // 必要に応じて保存しておく
 
     ViewSet = view;
+    m_mvpDirty = true;
 }
 void SpriteWorld::SetProj(const XMMATRIX& proj)
 {
@@ -196,4 +235,16 @@ void SpriteWorld::SetProj(const XMMATRIX& proj)
     // 必要に応じて保存しておく
 
     ProjSet = proj;
+    m_mvpDirty = true;
+}
+
+void SpriteWorld::UpdateMatrix()
+{
+    if (m_worldDirty) {
+        m_world = XMMatrixRotationRollPitchYaw(m_angle.x, m_angle.y, m_angle.z)
+            * XMMatrixTranslation(m_pos.x, m_pos.y, m_pos.z);
+        m_worldDirty = false;
+    }
+    m_mvp = XMMatrixTranspose(m_world * ViewSet * ProjSet);
+    m_mvpDirty = false;
 }
\ No newline at end of file
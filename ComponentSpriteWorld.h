@@ -2,10 +2,7 @@
 
 #pragma once
 #include "Manager.h"
-#include <d3dcompiler.h>
-#include <wrl/client.h>
 #include <vector>
-using Microsoft::WRL::ComPtr;
 
 using namespace DirectX;
 
@@ -18,6 +15,7 @@ public:
     void Init() override;
     void Draw() override;
     void Release() override;
+    static void ReleaseShared();             // L̃pCvCԂjiIj
 
     void SetTexture(const char* assetPath);  // AssetManager擾
     void SetPos(float x, float y, float z);
@@ -27,6 +25,10 @@ public:
     void SetProj(const XMMATRIX& proj);
     void SetColor(const XMFLOAT4& color);
     void SetBillboard(bool enable);
+    void SetWorld(const XMMATRIX& world);    // ]Eړς݂̃[hsiTransformManager ̒lBSetPos / SetAngle Dj
+    void UpdateMatrix();                     // m_mvp ČvZi[J[XbhĂł悢j
+    void SetMVP(const XMMATRIX& mvp);        // ]uς world * view * proj 𒼐ڐݒiDrawScene ̈ꊇvZj
+    bool IsMatrixDirty() const { return m_mvpDirty; }
 private:
     struct Vertex {
         XMFLOAT3 pos;
@@ -41,9 +43,15 @@ private:
     struct ColorBuffer {
         XMFLOAT4 color;
     };
+    static bool CreateShared(RenderBlob* vsBlob);
 
     XMMATRIX ViewSet;
     XMMATRIX ProjSet;
+    XMMATRIX m_mvp = XMMatrixIdentity();     // ]uς world * view * proj
+    bool m_mvpDirty = true;
+    XMMATRIX m_world = XMMatrixIdentity();
+    bool m_worldDirty = true;                // SetPos / SetAngle  m_pos / m_angle 蒼
+    bool m_meshDirty = true;                 // SetSize ͒_obt@iMapj
 
     bool m_isBillboard = false;
     XMFLOAT3 m_pos{ 0,0,0 };
@@ -51,18 +59,18 @@ private:
     XMFLOAT2 m_size{ 1,1 };
     XMFLOAT4 m_color{ 1,1,1,1 };
 
-    ID3D11ShaderResourceView* m_srv = nullptr;
+    RenderShaderResourceView* m_srv = nullptr;
 
-    ComPtr<ID3D11Buffer> m_vb;
-    ComPtr<ID3D11Buffer> m_matrixBuf;
-    ComPtr<ID3D11Buffer> m_colorBuf;
-    ComPtr<ID3D11InputLayout> m_layout;
-    ComPtr<ID3D11VertexShader> m_vs;
-    ComPtr<ID3D11PixelShader> m_ps;
+    RenderPtr<RenderBuffer> m_vb;
+    RenderPtr<RenderBuffer> m_matrixBuf;
+    RenderPtr<RenderBuffer> m_colorBuf;
+    RenderPtr<RenderInputLayout> m_layout;
+    RenderPtr<RenderVertexShader> m_vs;
+    RenderPtr<RenderPixelShader> m_ps;
 
-    ID3D11SamplerState* m_samplerState = nullptr;
-    ID3D11BlendState* m_blendState = nullptr;
+    RenderSamplerState* m_samplerState = nullptr;
+    RenderBlendState* m_blendState = nullptr;
 
-    ID3D11DepthStencilState* m_depthState = nullptr;
-    ID3D11DepthStencilState* m_noDepthState = nullptr;
+    RenderDepthStencilState* m_depthState = nullptr;
+    RenderDepthStencilState* m_noDepthState = nullptr;
 };
\ No newline at end of file
@@ -9,6 +9,13 @@
 #include "Manager.h"
 #include "AssetLoad.h"
 
+// [iSPACE 3{Ƃ񂵎n߁AA / S / D łꂼ~߂j
+#define REEL_SYMBOLS 20
+static const char* g_Reel[3] = { "Cylinder01", "Cylinder02", "Cylinder03" };
+static const int g_ReelKey[3] = { 'A', 'S', 'D' };
+// DiscUR_Reel1.png ̕сi0:XCJ 1:`F[ 2:x 3:7 4:vC 5:7 6:BARj
+static const int g_ReelStrip[REEL_SYMBOLS] = { 0, 1, 2, 0, 3, 4, 0, 2, 4, 2, 5, 0, 2, 4, 1, 4, 2, 6, 0, 4 };
+
 void CoreStartUp()
 {
     AL_Init(); // AssetLoad 
@@ -28,11 +35,7 @@ void CoreStartUp()
     AL_LoadPackageIndex("fbx", "saved/pkg/Assetfbx.pkg");
     AL_LoadPackageIndex("obj", "saved/pkg/Assetobj.pkg");
 
-    // .pkgCfbNXœǂݍ݁iDirectX\[Xj
-    AL_LoadFromPackageByName("asset/test.png");
-    AL_LoadFromPackageByName("asset/est.png");
-    AL_LoadFromPackageByName("asset/DiscUR_Reel1.png");
-    AL_LoadFromPackageByName("asset/hamu.png");
+    // eNX`̓V[PʂœǂݍށiChangeScene / PreloadScene ɁÃV[Ŏgj
     //AL_LoadFromPackageByName("asset/model/player.fbx");
 
     // --- J ---
@@ -88,26 +91,26 @@ void CoreStartUp()
     SetSpriteCylinderTextureSide("Cylinder01", "asset/DiscUR_Reel1.png"); 
     SetSpriteCylinderTextureTop("Cylinder01", "asset/hamu.png");   
     SetSpriteCylinderTextureBottom("Cylinder01", "asset/hamu.png");
-    SetSpriteCylinderSize("Cylinder01", 1, 2, 1);
+    SetSpriteCylinderSize("Cylinder01", 2, 1, 2);
     SetSpriteCylinderSegment("Cylinder01", 32);
     SetSpriteCylinderPos("Cylinder01", 0, 0, 0);
-    SetSpriteCylinderAngle("Cylinder01", 0, 1.57f, 0);
+    SetSpriteCylinderAngle("Cylinder01", 0, 0, 1.56f);
 
     AddSpriteCylinder("Cylinder02", "asset/DiscUR_Reel1.png");
     SetSpriteCylinderTextureSide("Cylinder02", "asset/DiscUR_Reel1.png");
     SetSpriteCylinderTextureTop("Cylinder02", "asset/hamu.png");
     SetSpriteCylinderTextureBottom("Cylinder02", "asset/hamu.png");
-    SetSpriteCylinderSize("Cylinder02", 1, 2, 1);
+    SetSpriteCylinderSize("Cylinder02", 2, 1, 2);
     SetSpriteCylinderPos("Cylinder02", 1.2f, 0, 0);
-    SetSpriteCylinderAngle("Cylinder02", 0, 1.57f, 0);
+    SetSpriteCylinderAngle("Cylinder02", 0, 0, 1.56f);
 
     AddSpriteCylinder("Cylinder03", "asset/DiscUR_Reel1.png");
     SetSpriteCylinderTextureSide("Cylinder03", "asset/DiscUR_Reel1.png");
     SetSpriteCylinderTextureTop("Cylinder03", "asset/hamu.png");
     SetSpriteCylinderTextureBottom("Cylinder03", "asset/hamu.png");
-    SetSpriteCylinderSize("Cylinder03", 1, 2, 1);
+    SetSpriteCylinderSize("Cylinder03", 2, 1, 2);
     SetSpriteCylinderPos("Cylinder03", 2.4f, 0, 0);
-    SetSpriteCylinderAngle("Cylinder03", 0, 1.57f, 0);
+    SetSpriteCylinderAngle("Cylinder03", 0, 0, 1.56f);
 
 	SceneEndPoint();
 
@@ -123,7 +126,7 @@ void CoreStartUp()
     SetSceneCamera("Scene3", "SubCamera");
     SetSceneCamera("Scene1", "MainCamera");
     SetSceneCamera("Scene2", "SideCamera");
-    // ŏ̃V[ݒ
+    // ŏ̃V[ݒiScene3 ̃eNX`ǂݍ܂j
     ChangeScene("Scene3");
 
     AddGridBox("BoxC");
@@ -132,6 +135,13 @@ void CoreStartUp()
     AddGridBox("BoxD");
     SetGridBoxPos("BoxD", 2, 0, 0);
 
+    // [i~͉񂳂ʂ UV 炷j
+    SetReelSeed(12345);
+    for (int i = 0; i < 3; ++i) {
+        SetSpriteCylinderReel(g_Reel[i], REEL_SYMBOLS);
+        SetReelStrip(g_Reel[i], g_ReelStrip, REEL_SYMBOLS);
+    }
+
 }
 void CoreSceneUpdate()
 {
@@ -141,61 +151,18 @@ void CoreSceneUpdate()
 
     SetCameraPos("SubCamera", 3, 5, -5);
 
-    static float Reel = 0.0f;
-    static float Reel1 = 0.0f;
-    static float Reel2 = 0.0f;
-    static float angle = 0;
-    static float angle1 = 0;
-    static float angle2 = 0;
-    static bool moveF = false;
-    static bool moveF1 = false;
-    static bool moveF2 = false;
-    
-    if (GetKeyState('A') < 0)
-        moveF = false;
-
-    if (GetKeyState('S') < 0)
-        moveF1 = false;
-
-    if (GetKeyState('D') < 0)
-        moveF2 = false;
+    for (int i = 0; i < 3; ++i) {
+        if (System_IsKeyDown(g_ReelKey[i]))
+            StopReel(g_Reel[i]);    // } SetReelSeed ̗
+    }
 
-    if (GetKeyState(VK_SPACE) < 0)
+    if (System_IsKeyDown(SYSTEM_KEY_SPACE))
     {
-        moveF = true;
-        moveF1 = true;
-        moveF2 = true;
+        // 1  1.05bi1t[ 0.1 WAj
+        for (int i = 0; i < 3; ++i) {
+            if (!IsReelSpinning(g_Reel[i])) SpinReel(g_Reel[i], REEL_SYMBOLS * 6.0f / 6.2831853f);
+        }
     }
-
-
-    if (moveF)
-        Reel = 0.1f;
-    else
-        Reel = 0.0f;
-
-    if (moveF1)
-        Reel1 = 0.1f;
-    else
-        Reel1 = 0.0f;
-
-    if (moveF2)
-        Reel2 = 0.1f;
-    else
-        Reel2 = 0.0f;
-
-
-    angle += Reel;
-    angle1 += Reel1;
-    angle2 += Reel2;
-
-    SetSpriteCylinderAngle("Cylinder01", angle, 0, 1.56);
-    SetSpriteCylinderSize("Cylinder01", 2, 1, 2);
-
-    SetSpriteCylinderAngle("Cylinder02", angle1, 0, 1.56);
-    SetSpriteCylinderSize("Cylinder02", 2, 1, 2);
-
-    SetSpriteCylinderAngle("Cylinder03", angle2, 0, 1.56);
-    SetSpriteCylinderSize("Cylinder03", 2, 1, 2);
 }
 void CoreSceneDraw()
 {
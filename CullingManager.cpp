@@ -0,0 +1,332 @@
+﻿// CullingManager.cpp
+// 境界ボリュームと視錐台カリング
+// |  Pool の 3D オブジェクト（SpriteWorld / SpriteBox / SpriteCylinder / GridBox / GridPolygon / Model）に1つずつ
+// |  中心 + ワールド AABB の半径（各軸）+ 境界球の半径 を持つ（SoA、4個ずつ読めるよう末尾に余白）
+// |  境界はワールド行列か Size が変わった行だけ作り直す（UpdateBounds、DrawScene から毎フレーム）
+// |  判定は 4 オブジェクトずつ 6 平面と比べる（DirectXMath の SIMD、範囲は Job_ParallelFor で分割）
+// |  SetCullingUseTree(true) なら SpatialManager のツリーで見えるものだけ拾う
+// __________________________________________
+
+#include "Manager.h"
+#include "JobSystem.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace DirectX;
+
+#define CULL_TYPE_COUNT 6
+#define CULL_PAD 4
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct CullColumns {
+    std::vector<float> X, Y, Z;             // 中心（ワールド）
+    std::vector<float> EX, EY, EZ;          // ワールド AABB の半径
+    std::vector<float> R;                   // 境界球の半径
+    std::vector<Vec4> Size;                 // 境界を作ったときの Size（変わったら作り直す）
+    std::vector<unsigned char> Updated;     // 直前の UpdateBounds で作り直した
+    std::vector<unsigned char> Visible;     // bit0: 今回見えている / bit1: 前回見えていた
+    int Count = 0;
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static const IndexType CullTypes[CULL_TYPE_COUNT] = {
+    IndexType::SpriteWorld, IndexType::SpriteBox, IndexType::SpriteCylinder,
+    IndexType::GridBox, IndexType::GridPolygon, IndexType::Model,
+};
+static CullColumns g_Cull[CULL_TYPE_COUNT];
+static XMFLOAT4 g_FrustumPlanes[6];         // ax + by + cz + d >= 0 が内側（正規化済み）
+static bool g_CullingEnabled = true;
+static bool g_CullingUseTree = false;       // true: SpatialManager のツリーで判定
+static std::atomic<int> g_CullVisible{ 0 };
+static std::atomic<int> g_CullCulled{ 0 };
+
+//-----------------------------------------
+// 列
+//-----------------------------------------
+static int Cull_Slot(IndexType type)
+{
+    for (int s = 0; s < CULL_TYPE_COUNT; ++s)
+        if (CullTypes[s] == type) return s;
+    return -1;
+}
+
+static void Cull_Columns(int slot, Vec4Vector** size, BoolVector** alive)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    switch (CullTypes[slot])
+    {
+    case IndexType::SpriteWorld:    *size = &p->SpriteWorldSize;    *alive = &p->SpriteWorldAlive;    break;
+    case IndexType::SpriteBox:      *size = &p->SpriteBoxSize;      *alive = &p->SpriteBoxAlive;      break;
+    case IndexType::SpriteCylinder: *size = &p->SpriteCylinderSize; *alive = &p->SpriteCylinderAlive; break;
+    case IndexType::GridBox:        *size = &p->GridBoxSize;        *alive = &p->GridBoxAlive;        break;
+    case IndexType::GridPolygon:    *size = &p->GridPolygonSize;    *alive = &p->GridPolygonAlive;    break;
+    case IndexType::Model:          *size = &p->ModelSize;          *alive = &p->ModelAlive;          break;
+    default:                        *size = nullptr;                *alive = nullptr;                 break;
+    }
+}
+
+// Size → ローカルの中心と半径（各軸）。Model 以外のメッシュは原点中心
+// |  Model はメッシュの AABB * Size。メッシュが無ければ Size の箱で代わりにして false（次のフレームで作り直す）
+static bool Cull_LocalBox(IndexType type, int index, const Vec4& s, XMVECTOR* center, XMVECTOR* extent)
+{
+    *center = XMVectorZero();
+    switch (type)
+    {
+    case IndexType::SpriteWorld:
+        *extent = XMVectorSet(fabsf(s.X) * 0.5f, fabsf(s.Y) * 0.5f, 0.0f, 0.0f);
+        return true;
+    case IndexType::SpriteCylinder: {
+        float r = s.X <= 0.0f ? 1.0f : s.X;     // BuildMesh と同じ（X = 半径, Y = 高さ）
+        *extent = XMVectorSet(r, fabsf(s.Y) * 0.5f, r, 0.0f);
+        return true;
+    }
+    case IndexType::Model: {
+        Vec4 mn, mx;
+        if (GetModelMeshBounds(VecC_Get(&GetObjectDataPool()->ModelPath, index), &mn, &mx)) {
+            XMVECTOR scale = XMVectorSet(s.X, s.Y, s.Z, 0.0f);
+            *center = XMVectorMultiply(XMVectorSet((mn.X + mx.X) * 0.5f, (mn.Y + mx.Y) * 0.5f, (mn.Z + mx.Z) * 0.5f, 0.0f), scale);
+            *extent = XMVectorAbs(XMVectorMultiply(XMVectorSet((mx.X - mn.X) * 0.5f, (mx.Y - mn.Y) * 0.5f, (mx.Z - mn.Z) * 0.5f, 0.0f), scale));
+            return true;
+        }
+        *extent = XMVectorSet(fabsf(s.X) * 0.5f, fabsf(s.Y) * 0.5f, fabsf(s.Z) * 0.5f, 0.0f);
+        return false;
+    }
+    default:
+        *extent = XMVectorSet(fabsf(s.X) * 0.5f, fabsf(s.Y) * 0.5f, fabsf(s.Z) * 0.5f, 0.0f);
+        return true;
+    }
+}
+
+// Pool の行数まで列を伸ばす（新しい行は要計算）
+static void Cull_Grow(int slot, int count)
+{
+    CullColumns& c = g_Cull[slot];
+    if (c.Count >= count) return;
+    size_t padded = (size_t)count + CULL_PAD;
+    c.X.resize(padded); c.Y.resize(padded); c.Z.resize(padded);
+    c.EX.resize(padded); c.EY.resize(padded); c.EZ.resize(padded);
+    c.R.resize(padded);
+    c.Size.resize(count, Vec4{ NAN, NAN, NAN, NAN });   // 必ず作り直される値
+    c.Updated.resize(count, 0);
+    c.Visible.resize(count, 0);
+    c.Count = count;
+}
+
+//-----------------------------------------
+// 境界の更新（UpdateTransforms の後に1回）
+//-----------------------------------------
+void UpdateBounds()
+{
+    LIA_PROFILE_SCOPE("UpdateBounds");
+    for (int s = 0; s < CULL_TYPE_COUNT; ++s) {
+        Vec4Vector* size;
+        BoolVector* alive;
+        Cull_Columns(s, &size, &alive);
+        Cull_Grow(s, (int)size->size);
+
+        CullColumns& c = g_Cull[s];
+        IndexType type = CullTypes[s];
+        Job_ParallelFor(0, c.Count, 0, [&](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i) {
+                const Vec4& sz = size->data[i];
+                bool changed = IsTransformUpdated(type, i) || memcmp(&sz, &c.Size[i], sizeof(Vec4)) != 0;
+                c.Updated[i] = changed ? 1 : 0;
+                if (!changed) continue;
+
+                // ワールド AABB の半径 = |回転| * ローカルの半径（行ベクトルなので行ごとに足す）
+                const XMMATRIX& w = GetWorldMatrix(type, i);
+                XMVECTOR lc, e;
+                bool exact = Cull_LocalBox(type, i, sz, &lc, &e);
+                XMVECTOR ext = XMVectorMultiply(XMVectorAbs(w.r[0]), XMVectorSplatX(e));
+                ext = XMVectorMultiplyAdd(XMVectorAbs(w.r[1]), XMVectorSplatY(e), ext);
+                ext = XMVectorMultiplyAdd(XMVectorAbs(w.r[2]), XMVectorSplatZ(e), ext);
+                XMVECTOR center = XMVector3TransformCoord(lc, w);
+
+                c.X[i] = XMVectorGetX(center);
+                c.Y[i] = XMVectorGetY(center);
+                c.Z[i] = XMVectorGetZ(center);
+                c.EX[i] = XMVectorGetX(ext);
+                c.EY[i] = XMVectorGetY(ext);
+                c.EZ[i] = XMVectorGetZ(ext);
+                c.R[i] = XMVectorGetX(XMVector3Length(e));
+                c.Size[i] = exact ? sz : Vec4{ NAN, NAN, NAN, NAN };
+            }
+        });
+    }
+}
+
+//-----------------------------------------
+// 視錐台
+//-----------------------------------------
+void GetFrustumPlanes(const XMMATRIX& viewProj, XMFLOAT4 planes[6])
+{
+    // 列ベクトル c0..c3（転置の行）から6平面を取り出す（D3D: 0 <= z <= w）
+    XMMATRIX t = XMMatrixTranspose(viewProj);
+    XMVECTOR p[6] = {
+        XMVectorAdd(t.r[3], t.r[0]),        // 左
+        XMVectorSubtract(t.r[3], t.r[0]),   // 右
+        XMVectorAdd(t.r[3], t.r[1]),        // 下
+        XMVectorSubtract(t.r[3], t.r[1]),   // 上
+        t.r[2],                             // 近
+        XMVectorSubtract(t.r[3], t.r[2]),   // 遠
+    };
+    for (int k = 0; k < 6; ++k) XMStoreFloat4(&planes[k], XMPlaneNormalize(p[k]));
+}
+
+void SetCullingFrustum(const XMMATRIX& viewProj)
+{
+    GetFrustumPlanes(viewProj, g_FrustumPlanes);
+    g_CullVisible = 0;
+    g_CullCulled = 0;
+    if (!g_CullingUseTree) return;
+
+    // ツリーで見えるものだけ拾って bit0 を立てる（CullRange は範囲内を数えるだけ）
+    for (CullColumns& c : g_Cull)
+        for (int i = 0; i < c.Count; ++i) c.Visible[i] = (unsigned char)((c.Visible[i] & 1) << 1);
+    static std::vector<SpatialHit> hits;
+    hits.clear();
+    QuerySpatialFrustum(viewProj, &hits);
+    for (const SpatialHit& h : hits) {
+        int slot = Cull_Slot(h.Type);
+        if (slot >= 0 && h.Index < g_Cull[slot].Count) g_Cull[slot].Visible[h.Index] |= 1;
+    }
+}
+
+// [begin, end) を判定して Visible を書く（戻り値は見えている数）
+int CullRange(IndexType type, int begin, int end)
+{
+    LIA_PROFILE_SCOPE("CullRange");
+    int slot = Cull_Slot(type);
+    if (slot < 0) return 0;
+    Vec4Vector* size;
+    BoolVector* alive;
+    Cull_Columns(slot, &size, &alive);
+    CullColumns& c = g_Cull[slot];
+    if (begin < 0) begin = 0;
+    if (end > c.Count) end = c.Count;                   // UpdateBounds 前に増えた行は次のフレームから
+    if (end > (int)alive->size) end = (int)alive->size;
+    if (begin >= end) return 0;
+
+    XMVECTOR pa[6], pb[6], pc[6], pd[6], aa[6], ab[6], ac[6];
+    for (int k = 0; k < 6; ++k) {
+        const XMFLOAT4& p = g_FrustumPlanes[k];
+        pa[k] = XMVectorReplicate(p.x); aa[k] = XMVectorReplicate(fabsf(p.x));
+        pb[k] = XMVectorReplicate(p.y); ab[k] = XMVectorReplicate(fabsf(p.y));
+        pc[k] = XMVectorReplicate(p.z); ac[k] = XMVectorReplicate(fabsf(p.z));
+        pd[k] = XMVectorReplicate(p.w);
+    }
+    const bool* aliveData = alive->data;
+    const bool enabled = g_CullingEnabled;
+
+    std::atomic<int> visibleTotal{ 0 };
+    std::atomic<int> aliveTotal{ 0 };
+    if (g_CullingUseTree) {
+        // 判定は SetCullingFrustum で済んでいる
+        int visible = 0, count = 0;
+        for (int i = begin; i < end; ++i) {
+            bool live = aliveData[i];
+            bool in = live && (!enabled || (c.Visible[i] & 1));
+            c.Visible[i] = (unsigned char)((c.Visible[i] & 2) | (in ? 1 : 0));
+            visible += in ? 1 : 0;
+            count += live ? 1 : 0;
+        }
+        visibleTotal = visible;
+        aliveTotal = count;
+    }
+    else Job_ParallelFor(begin, end, 1024, [&](int b, int e)
+    {
+        int visible = 0, count = 0;
+        for (int i = b; i < e; i += 4) {
+            // 4個まとめて: 中心の距離 + AABB の射影半径 < 0 の平面が1つでもあれば外
+            XMVECTOR x = XMLoadFloat4((const XMFLOAT4*)&c.X[i]);
+            XMVECTOR y = XMLoadFloat4((const XMFLOAT4*)&c.Y[i]);
+            XMVECTOR z = XMLoadFloat4((const XMFLOAT4*)&c.Z[i]);
+            XMVECTOR ex = XMLoadFloat4((const XMFLOAT4*)&c.EX[i]);
+            XMVECTOR ey = XMLoadFloat4((const XMFLOAT4*)&c.EY[i]);
+            XMVECTOR ez = XMLoadFloat4((const XMFLOAT4*)&c.EZ[i]);
+            XMVECTOR outside = XMVectorFalseInt();
+            for (int k = 0; k < 6; ++k) {
+                XMVECTOR dist = XMVectorMultiplyAdd(pa[k], x, XMVectorMultiplyAdd(pb[k], y, XMVectorMultiplyAdd(pc[k], z, pd[k])));
+                XMVECTOR rad = XMVectorMultiplyAdd(aa[k], ex, XMVectorMultiplyAdd(ab[k], ey, XMVectorMultiply(ac[k], ez)));
+                outside = XMVectorOrInt(outside, XMVectorLess(XMVectorAdd(dist, rad), XMVectorZero()));
+            }
+            XMUINT4 mask;
+            XMStoreUInt4(&mask, outside);
+            const uint32_t lanes[4] = { mask.x, mask.y, mask.z, mask.w };
+            int n = (e - i < 4) ? e - i : 4;
+            for (int l = 0; l < n; ++l) {
+                unsigned char prev = (c.Visible[i + l] & 1) << 1;
+                bool live = aliveData[i + l];
+                bool in = live && (!enabled || lanes[l] == 0);
+                c.Visible[i + l] = prev | (in ? 1 : 0);
+                visible += in ? 1 : 0;
+                count += live ? 1 : 0;
+            }
+        }
+        visibleTotal += visible;
+        aliveTotal += count;
+    });
+
+    int v = visibleTotal.load();
+    g_CullVisible += v;
+    g_CullCulled += aliveTotal.load() - v;
+    return v;
+}
+
+//-----------------------------------------
+// 取得
+//-----------------------------------------
+bool IsObjectVisible(IndexType type, int index)
+{
+    int slot = Cull_Slot(type);
+    if (slot < 0 || index < 0 || index >= g_Cull[slot].Count) return false;
+    return (g_Cull[slot].Visible[index] & 1) != 0;
+}
+
+bool IsObjectNewlyVisible(IndexType type, int index)
+{
+    int slot = Cull_Slot(type);
+    if (slot < 0 || index < 0 || index >= g_Cull[slot].Count) return false;
+    return g_Cull[slot].Visible[index] == 1;
+}
+
+bool IsBoundsUpdated(IndexType type, int index)
+{
+    int slot = Cull_Slot(type);
+    if (slot < 0 || index < 0 || index >= g_Cull[slot].Count) return false;
+    return g_Cull[slot].Updated[index] != 0;
+}
+
+bool GetObjectBounds(IndexType type, int index, Vec4* sphere, Vec4* extent)
+{
+    int slot = Cull_Slot(type);
+    if (slot < 0 || index < 0 || index >= g_Cull[slot].Count) return false;
+    const CullColumns& c = g_Cull[slot];
+    if (sphere) *sphere = { c.X[index], c.Y[index], c.Z[index], c.R[index] };
+    if (extent) *extent = { c.EX[index], c.EY[index], c.EZ[index], 0.0f };
+    return true;
+}
+
+void GetCullingStats(int* visible, int* culled)
+{
+    if (visible) *visible = g_CullVisible.load();
+    if (culled) *culled = g_CullCulled.load();
+}
+
+void SetCullingEnabled(bool enable) { g_CullingEnabled = enable; }
+void SetCullingUseTree(bool enable) { g_CullingUseTree = enable; }
+bool IsCullingEnabled() { return g_CullingEnabled; }
+
+void ReleaseCulling()
+{
+    for (CullColumns& c : g_Cull) c = CullColumns{};
+    g_CullVisible = 0;
+    g_CullCulled = 0;
+}
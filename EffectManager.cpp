@@ -0,0 +1,381 @@
+﻿// EffectManager.cpp
+// パーティクル（Effect の発生源ごと）
+// |  粒子は SoA（位置 xyz / 速度 xyz / 経過 / 寿命 の列）。積分は4個ずつ DirectXMath の SIMD、全発生源を EFFECT_CHUNK ずつに分けて並列
+// |  寿命が尽きた粒子は末尾と入れ替えて消す（並びは保たない）。列は MaxParticles を4の倍数に切り上げて確保（SetEffectDesc 以外で確保しない）
+// |  色 / 大きさは 経過 / 寿命 で開始 → 終了の直線補間。Effect コンポーネントが Map した先へ直接書く（Effect_WriteInstances）
+// |  乱数は発生源ごと（並列でも同じ種と同じ入力なら同じ結果。更新は固定ステップ）
+// |  D3D は使わない（ヘッドレスでも UpdateEffects だけで動く）
+// |  更新するのは現在のシーンの範囲の発生源のみ（他のシーンの粒子はそのまま止まる。削除した行は Effect_OnRemove で空にする）
+// __________________________________________
+
+#include "Manager.h"
+#include "JobSystem.h"
+#include "MathAPI.h"
+#include <vector>
+#include <utility>
+
+using namespace DirectX;
+
+#define EFFECT_CHUNK 4096           // 積分の1ジョブあたりの粒子数（4の倍数）
+#define EFFECT_LIFE_MIN 0.001f      // 寿命の下限（0 除算を避ける）
+
+struct EffectEmitter
+{
+    EffectDesc Desc;
+    bool Playing;
+    float Carry;        // 発生数の端数
+    int Burst;          // 次の更新で追加で出す数
+    unsigned Rand;
+    int Count;
+    int Capacity;       // 4の倍数
+    std::vector<float> PX, PY, PZ, VX, VY, VZ, Age, Life;
+};
+
+struct EffectChunk { int Emitter; int Begin; int End; };
+
+static std::vector<EffectEmitter> g_Effects;       // Pool の行ごと
+static std::vector<EffectChunk> g_EffectChunks;    // 作業用（容量は使い回す）
+static unsigned g_EffectSeed = 12345;
+static int g_EffectTotal = 0;
+
+static unsigned Effect_Rand(EffectEmitter& e)
+{
+    // xorshift32（ReelManager と同じ）
+    unsigned x = e.Rand;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return e.Rand = x;
+}
+// [-1, 1)
+static float Effect_RandSigned(EffectEmitter& e)
+{
+    return (float)(Effect_Rand(e) >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+static void Effect_Alloc(EffectEmitter& e)
+{
+    int cap = (e.Desc.MaxParticles + 3) & ~3;
+    e.Capacity = cap;
+    e.Count = 0;
+    e.PX.assign(cap, 0.0f); e.PY.assign(cap, 0.0f); e.PZ.assign(cap, 0.0f);
+    e.VX.assign(cap, 0.0f); e.VY.assign(cap, 0.0f); e.VZ.assign(cap, 0.0f);
+    e.Age.assign(cap, 0.0f); e.Life.assign(cap, 1.0f);
+}
+
+// 名前 → 行（無ければ -1）
+static int Effect_Index(const char* name, const char* api)
+{
+    int index = name ? KeyMap_GetIndex(&GetObjectDataPool()->EffectMap, name) : -1;
+    if (index < 0 || index >= (int)g_Effects.size()) {
+        AddMessage(ConcatCStr(api, name ? name : ""));
+        return -1;
+    }
+    return index;
+}
+
+//-----------------------------------------
+// 設定
+//-----------------------------------------
+EffectDesc EffectDesc_Default()
+{
+    EffectDesc d;
+    d.MaxParticles = 1000;
+    d.Rate = 200.0f;
+    d.LifeMin = 1.0f;
+    d.LifeMax = 2.0f;
+    d.Velocity = { 0, 2, 0, 0 };
+    d.VelocityRandom = { 1, 0.5f, 1, 0 };
+    d.Gravity = { 0, -1, 0, 0 };
+    d.Drag = 0.0f;
+    d.SpawnRadius = 0.0f;
+    d.SizeStart = 0.3f;
+    d.SizeEnd = 0.0f;
+    d.ColorStart = { 1, 1, 1, 1 };
+    d.ColorEnd = { 1, 1, 1, 0 };
+    return d;
+}
+
+void Effect_OnAdd(int index)
+{
+    if (index < 0) return;
+    if (index >= (int)g_Effects.size()) g_Effects.resize(index + 1);
+    EffectEmitter& e = g_Effects[index];
+    e.Desc = EffectDesc_Default();
+    e.Playing = true;
+    e.Carry = 0.0f;
+    e.Burst = 0;
+    e.Rand = (g_EffectSeed ^ ((unsigned)index * 2654435761u)) | 1u;   // 0 だと xorshift が止まる
+    Effect_Alloc(e);
+}
+
+// 削除時：止めて粒子を消す（再利用時に Effect_OnAdd で初期化し直す）
+void Effect_OnRemove(IndexType type, int index)
+{
+    if (type != IndexType::Effect || index < 0 || index >= (int)g_Effects.size()) return;
+    EffectEmitter& e = g_Effects[index];
+    e.Playing = false;
+    e.Carry = 0.0f;
+    e.Burst = 0;
+    e.Count = 0;
+}
+
+// 行の移動時：粒子ごと to へ入れ替える（from は続く Effect_OnRemove で空になる）
+void Effect_OnMove(IndexType type, int from, int to)
+{
+    if (type != IndexType::Effect || from < 0 || from >= (int)g_Effects.size() || to < 0) return;
+    if (to >= (int)g_Effects.size()) g_Effects.resize(to + 1);
+    std::swap(g_Effects[from], g_Effects[to]);
+}
+
+// 行の複製時：設定と再生中かどうかだけ写す（粒子は空から、乱数は to の行で初期化）
+void Effect_OnCopy(int from, int to)
+{
+    if (from < 0 || to < 0) return;
+    Effect_OnAdd(to);
+    if (from >= (int)g_Effects.size()) return;
+    EffectEmitter& e = g_Effects[to];
+    const EffectEmitter& src = g_Effects[from];
+    bool realloc = src.Desc.MaxParticles != e.Desc.MaxParticles;
+    e.Desc = src.Desc;
+    e.Playing = src.Playing;
+    if (realloc) Effect_Alloc(e);
+}
+
+void SetEffectDesc(const char* name, const EffectDesc& desc)
+{
+    int index = Effect_Index(name, "SetEffectDesc: not found ");
+    if (index < 0) return;
+    EffectEmitter& e = g_Effects[index];
+    int oldMax = e.Desc.MaxParticles;
+    e.Desc = desc;
+    if (e.Desc.MaxParticles < 0) e.Desc.MaxParticles = 0;
+    if (e.Desc.LifeMin < EFFECT_LIFE_MIN) e.Desc.LifeMin = EFFECT_LIFE_MIN;
+    if (e.Desc.LifeMax < e.Desc.LifeMin) e.Desc.LifeMax = e.Desc.LifeMin;
+    if (e.Desc.MaxParticles != oldMax) Effect_Alloc(e);
+}
+
+void SetEffectSeed(unsigned seed)
+{
+    g_EffectSeed = seed ? seed : 12345;
+}
+
+void PlayEffect(const char* name)
+{
+    int index = Effect_Index(name, "PlayEffect: not found ");
+    if (index >= 0) g_Effects[index].Playing = true;
+}
+
+void StopEffect(const char* name)
+{
+    int index = Effect_Index(name, "StopEffect: not found ");
+    if (index < 0) return;
+    g_Effects[index].Playing = false;
+    g_Effects[index].Carry = 0.0f;
+}
+
+void BurstEffect(const char* name, int count)
+{
+    int index = Effect_Index(name, "BurstEffect: not found ");
+    if (index >= 0 && count > 0) g_Effects[index].Burst += count;
+}
+
+int GetEffectParticleCount(const char* name)
+{
+    int index = name ? KeyMap_GetIndex(&GetObjectDataPool()->EffectMap, name) : -1;
+    return GetEffectCount(index);
+}
+
+int GetEffectTotalParticles()
+{
+    return g_EffectTotal;
+}
+
+int GetEffectCount(int index)
+{
+    if (index < 0 || index >= (int)g_Effects.size()) return 0;
+    return g_Effects[index].Count;
+}
+
+int GetEffectCapacity(int index)
+{
+    if (index < 0 || index >= (int)g_Effects.size()) return 0;
+    return g_Effects[index].Capacity;
+}
+
+//-----------------------------------------
+// 更新
+//-----------------------------------------
+// 粒子 [begin, end) を積分（begin は4の倍数、end は Count を4の倍数に切り上げた値まで。余りの列は使われないので書いてよい）
+static void Effect_Integrate(EffectEmitter& e, int begin, int end, float dt)
+{
+    const EffectDesc& d = e.Desc;
+    float damp = 1.0f - d.Drag * dt;
+    if (damp < 0.0f) damp = 0.0f;
+    const XMVECTOR vdt = XMVectorReplicate(dt);
+    const XMVECTOR vdamp = XMVectorReplicate(damp);
+    const XMVECTOR gx = XMVectorReplicate(d.Gravity.X * dt);
+    const XMVECTOR gy = XMVectorReplicate(d.Gravity.Y * dt);
+    const XMVECTOR gz = XMVectorReplicate(d.Gravity.Z * dt);
+    float* px = e.PX.data(); float* py = e.PY.data(); float* pz = e.PZ.data();
+    float* vx = e.VX.data(); float* vy = e.VY.data(); float* vz = e.VZ.data();
+    float* age = e.Age.data();
+
+    for (int i = begin; i < end; i += 4)
+    {
+        // v = v * damp + g * dt / p += v * dt / age += dt
+        XMVECTOR x = XMVectorMultiplyAdd(XMLoadFloat4((const XMFLOAT4*)(vx + i)), vdamp, gx);
+        XMVECTOR y = XMVectorMultiplyAdd(XMLoadFloat4((const XMFLOAT4*)(vy + i)), vdamp, gy);
+        XMVECTOR z = XMVectorMultiplyAdd(XMLoadFloat4((const XMFLOAT4*)(vz + i)), vdamp, gz);
+        XMStoreFloat4((XMFLOAT4*)(vx + i), x);
+        XMStoreFloat4((XMFLOAT4*)(vy + i), y);
+        XMStoreFloat4((XMFLOAT4*)(vz + i), z);
+        XMStoreFloat4((XMFLOAT4*)(px + i), XMVectorMultiplyAdd(x, vdt, XMLoadFloat4((const XMFLOAT4*)(px + i))));
+        XMStoreFloat4((XMFLOAT4*)(py + i), XMVectorMultiplyAdd(y, vdt, XMLoadFloat4((const XMFLOAT4*)(py + i))));
+        XMStoreFloat4((XMFLOAT4*)(pz + i), XMVectorMultiplyAdd(z, vdt, XMLoadFloat4((const XMFLOAT4*)(pz + i))));
+        XMStoreFloat4((XMFLOAT4*)(age + i), XMVectorAdd(XMLoadFloat4((const XMFLOAT4*)(age + i)), vdt));
+    }
+}
+
+// 寿命切れを消して、今回の分を出す（発生源ごと。別の発生源とは列を共有しない）
+static void Effect_Step(EffectEmitter& e, const Vec4& origin, float dt)
+{
+    int n = e.Count;
+    for (int i = 0; i < n;)
+    {
+        if (e.Age[i] < e.Life[i]) { ++i; continue; }
+        --n;
+        e.PX[i] = e.PX[n]; e.PY[i] = e.PY[n]; e.PZ[i] = e.PZ[n];
+        e.VX[i] = e.VX[n]; e.VY[i] = e.VY[n]; e.VZ[i] = e.VZ[n];
+        e.Age[i] = e.Age[n]; e.Life[i] = e.Life[n];
+    }
+
+    const EffectDesc& d = e.Desc;
+    int spawn = e.Burst;
+    e.Burst = 0;
+    if (e.Playing) {
+        e.Carry += d.Rate * dt;
+        int k = (int)e.Carry;
+        e.Carry -= (float)k;
+        spawn += k;
+    }
+    if (spawn > e.Capacity - n) spawn = e.Capacity - n;
+    for (int k = 0; k < spawn; ++k, ++n)
+    {
+        e.PX[n] = origin.X + Effect_RandSigned(e) * d.SpawnRadius;
+        e.PY[n] = origin.Y + Effect_RandSigned(e) * d.SpawnRadius;
+        e.PZ[n] = origin.Z + Effect_RandSigned(e) * d.SpawnRadius;
+        e.VX[n] = d.Velocity.X + Effect_RandSigned(e) * d.VelocityRandom.X;
+        e.VY[n] = d.Velocity.Y + Effect_RandSigned(e) * d.VelocityRandom.Y;
+        e.VZ[n] = d.Velocity.Z + Effect_RandSigned(e) * d.VelocityRandom.Z;
+        e.Age[n] = 0.0f;
+        e.Life[n] = d.LifeMin + (d.LifeMax - d.LifeMin) * (Effect_RandSigned(e) * 0.5f + 0.5f);
+    }
+    e.Count = n;
+}
+
+void UpdateEffects(float dt)
+{
+    LIA_PROFILE_SCOPE("UpdateEffects");
+    ObjectDataPool* pool = GetObjectDataPool();
+    int count = (int)g_Effects.size();
+    if (count > (int)pool->EffectPos.size) count = (int)pool->EffectPos.size;
+
+    // 現在のシーンの範囲（シーンが無ければ全体）
+    int first = 0, last = count;
+    if (GetSceneRange(GetCurrentSceneName(), IndexType::Effect, &first, &last)) {
+        if (first < 0) first = 0;
+        if (last > count) last = count;
+    }
+    if (first >= last) { g_EffectTotal = 0; return; }
+
+    // 積分（発生源をまたいで EFFECT_CHUNK ずつに分けて並列）
+    g_EffectChunks.clear();
+    for (int i = first; i < last; ++i)
+    {
+        int n = (g_Effects[i].Count + 3) & ~3;
+        for (int b = 0; b < n; b += EFFECT_CHUNK)
+            g_EffectChunks.push_back({ i, b, b + EFFECT_CHUNK < n ? b + EFFECT_CHUNK : n });
+    }
+    {
+        LIA_PROFILE_SCOPE("UpdateEffects::Integrate");
+        Job_ParallelFor(0, (int)g_EffectChunks.size(), 1, [dt](int begin, int end)
+        {
+            for (int c = begin; c < end; ++c)
+            {
+                const EffectChunk& k = g_EffectChunks[c];
+                Effect_Integrate(g_Effects[k.Emitter], k.Begin, k.End, dt);
+            }
+        });
+    }
+
+    // 削除 / 発生（発生源ごとに並列）
+    {
+        LIA_PROFILE_SCOPE("UpdateEffects::Emit");
+        Job_ParallelFor(first, last, 0, [pool, dt](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+                Effect_Step(g_Effects[i], Vec4_Get(&pool->EffectPos, i), dt);
+        });
+    }
+
+    int total = 0;
+    for (int i = first; i < last; ++i) total += g_Effects[i].Count;
+    g_EffectTotal = total;
+}
+
+//-----------------------------------------
+// インスタンスの書き出し（Map した先へ直接）
+//-----------------------------------------
+void Effect_WriteInstances(int index, EffectInstance* dst, int begin, int end)
+{
+    if (index < 0 || index >= (int)g_Effects.size()) return;
+    const EffectEmitter& e = g_Effects[index];
+    const EffectDesc& d = e.Desc;
+    if (end > e.Count) end = e.Count;
+
+    const float* px = e.PX.data(); const float* py = e.PY.data(); const float* pz = e.PZ.data();
+    const float* age = e.Age.data(); const float* life = e.Life.data();
+    const float sizeD = d.SizeEnd - d.SizeStart;
+    const Vec4 colD = { d.ColorEnd.X - d.ColorStart.X, d.ColorEnd.Y - d.ColorStart.Y,
+                        d.ColorEnd.Z - d.ColorStart.Z, d.ColorEnd.W - d.ColorStart.W };
+
+    // 4個ずつ: t = 経過 / 寿命 → 大きさ / 色を補間し、列（SoA）を転置して粒子ごと（AoS）に書く
+    const XMVECTOR s0 = XMVectorReplicate(d.SizeStart), sd = XMVectorReplicate(sizeD);
+    const XMVECTOR r0 = XMVectorReplicate(d.ColorStart.X), rd = XMVectorReplicate(colD.X);
+    const XMVECTOR g0 = XMVectorReplicate(d.ColorStart.Y), gd = XMVectorReplicate(colD.Y);
+    const XMVECTOR b0 = XMVectorReplicate(d.ColorStart.Z), bd = XMVectorReplicate(colD.Z);
+    const XMVECTOR a0 = XMVectorReplicate(d.ColorStart.W), ad = XMVectorReplicate(colD.W);
+    int i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        XMVECTOR t = XMVectorSaturate(XMVectorDivide(XMLoadFloat4((const XMFLOAT4*)(age + i)), XMLoadFloat4((const XMFLOAT4*)(life + i))));
+        XMMATRIX ps(XMLoadFloat4((const XMFLOAT4*)(px + i)), XMLoadFloat4((const XMFLOAT4*)(py + i)),
+                    XMLoadFloat4((const XMFLOAT4*)(pz + i)), XMVectorMultiplyAdd(t, sd, s0));
+        XMMATRIX col(XMVectorMultiplyAdd(t, rd, r0), XMVectorMultiplyAdd(t, gd, g0),
+                     XMVectorMultiplyAdd(t, bd, b0), XMVectorMultiplyAdd(t, ad, a0));
+        ps = XMMatrixTranspose(ps);
+        col = XMMatrixTranspose(col);
+        for (int k = 0; k < 4; ++k)
+        {
+            XMStoreFloat4((XMFLOAT4*)&dst[i + k].PosSize, ps.r[k]);
+            XMStoreFloat4((XMFLOAT4*)&dst[i + k].Color, col.r[k]);
+        }
+    }
+    for (; i < end; ++i)
+    {
+        float t = age[i] / life[i];
+        if (t > 1.0f) t = 1.0f;
+        dst[i].PosSize = { px[i], py[i], pz[i], d.SizeStart + sizeD * t };
+        dst[i].Color = { d.ColorStart.X + colD.X * t, d.ColorStart.Y + colD.Y * t,
+                         d.ColorStart.Z + colD.Z * t, d.ColorStart.W + colD.W * t };
+    }
+}
+
+void ReleaseEffects()
+{
+    g_Effects.clear();      g_Effects.shrink_to_fit();
+    g_EffectChunks.clear(); g_EffectChunks.shrink_to_fit();
+    g_EffectSeed = 12345;
+    g_EffectTotal = 0;
+}
@@ -0,0 +1,157 @@
+﻿// GameLoop.cpp
+// 固定タイムステップのループ駆動（GameLoop.h）
+// __________________________________________
+
+#include "GameLoop.h"
+
+#include "SystemAPI.h"
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static GameLoopClockFn g_LoopClock = nullptr;
+static void* g_LoopClockUser = nullptr;
+static long long g_LoopClockFreq = 0;
+
+static double g_LoopStep = 1.0 / 60.0;
+static int g_LoopMaxSteps = 5;
+static bool g_LoopUncapped = false;
+
+static bool g_LoopStarted = false;
+static long long g_LoopPrevTick = 0;
+static double g_LoopAccumulator = 0.0;
+
+// 計測
+static double g_LoopFrameSeconds = 0.0;
+static double g_LoopFrameSum = 0.0;
+static double g_LoopFrameMax = 0.0;
+static unsigned long long g_LoopStatFrames = 0;
+static unsigned long long g_LoopSteps = 0;
+static unsigned long long g_LoopFrames = 0;
+static unsigned long long g_LoopDropped = 0;
+
+// 既定の時計（System_GetTicks）
+static long long GameLoop_DefaultClock(void*)
+{
+    return System_GetTicks();
+}
+
+static long long GameLoop_Now()
+{
+    return g_LoopClock(g_LoopClockUser);
+}
+
+//-----------------------------------------
+// 設定
+//-----------------------------------------
+void GameLoop_Init(double stepSeconds, int maxStepsPerFrame)
+{
+    if (!g_LoopClock) GameLoop_SetClock(nullptr, 0, nullptr);
+    GameLoop_SetStep(stepSeconds);
+    GameLoop_SetMaxSteps(maxStepsPerFrame);
+
+    g_LoopStarted = false;
+    g_LoopSteps = 0;
+    g_LoopFrames = 0;
+    g_LoopDropped = 0;
+    GameLoop_ResetFrameStats();
+}
+
+void GameLoop_SetClock(GameLoopClockFn now, long long ticksPerSecond, void* user)
+{
+    if (now && ticksPerSecond > 0) {
+        g_LoopClock = now;
+        g_LoopClockFreq = ticksPerSecond;
+        g_LoopClockUser = user;
+    }
+    else {
+        g_LoopClock = GameLoop_DefaultClock;
+        g_LoopClockFreq = System_GetTickFrequency();
+        g_LoopClockUser = nullptr;
+    }
+    // 時計が変わったので基準を取り直す
+    g_LoopStarted = false;
+}
+
+void GameLoop_SetStep(double stepSeconds)
+{
+    if (stepSeconds > 0.0) g_LoopStep = stepSeconds;
+}
+
+void GameLoop_SetMaxSteps(int maxStepsPerFrame)
+{
+    g_LoopMaxSteps = maxStepsPerFrame > 0 ? maxStepsPerFrame : 1;
+}
+
+void GameLoop_SetUncapped(bool uncapped)
+{
+    g_LoopUncapped = uncapped;
+    GameLoop_ResetFrameStats();
+}
+
+//-----------------------------------------
+// 実行
+//-----------------------------------------
+int GameLoop_Tick(GameLoopUpdateFn update, GameLoopRenderFn render, void* user)
+{
+    if (!g_LoopClock) GameLoop_SetClock(nullptr, 0, nullptr);
+
+    long long now = GameLoop_Now();
+    if (!g_LoopStarted) {
+        // 初回は必ず1ステップ回す（オブジェクト生成を描画より先に済ませる）
+        g_LoopStarted = true;
+        g_LoopPrevTick = now;
+        g_LoopAccumulator = g_LoopStep;
+        g_LoopFrameSeconds = 0.0;
+    }
+    else {
+        g_LoopFrameSeconds = (double)(now - g_LoopPrevTick) / (double)g_LoopClockFreq;
+        g_LoopPrevTick = now;
+        if (g_LoopFrameSeconds < 0.0) g_LoopFrameSeconds = 0.0;
+        g_LoopAccumulator += g_LoopFrameSeconds;
+
+        g_LoopFrameSum += g_LoopFrameSeconds;
+        if (g_LoopFrameSeconds > g_LoopFrameMax) g_LoopFrameMax = g_LoopFrameSeconds;
+        g_LoopStatFrames++;
+    }
+
+    // 追いつける上限を超えた分は捨てる（処理落ち時の連鎖を防ぐ）
+    double limit = g_LoopStep * g_LoopMaxSteps;
+    if (g_LoopAccumulator > limit) {
+        g_LoopDropped += (unsigned long long)((g_LoopAccumulator - limit) / g_LoopStep);
+        g_LoopAccumulator = limit;
+    }
+
+    int steps = 0;
+    while (g_LoopAccumulator >= g_LoopStep) {
+        if (update) update(g_LoopStep, user);
+        g_LoopAccumulator -= g_LoopStep;
+        steps++;
+    }
+    g_LoopSteps += steps;
+
+    if (render) render(g_LoopAccumulator / g_LoopStep, user);
+    g_LoopFrames++;
+
+    return steps;
+}
+
+//-----------------------------------------
+// 取得
+//-----------------------------------------
+bool GameLoop_IsUncapped() { return g_LoopUncapped; }
+int GameLoop_GetPresentInterval() { return g_LoopUncapped ? 0 : 1; }
+double GameLoop_GetStep() { return g_LoopStep; }
+double GameLoop_GetFrameSeconds() { return g_LoopFrameSeconds; }
+double GameLoop_GetAverageFrameSeconds() { return g_LoopStatFrames ? g_LoopFrameSum / (double)g_LoopStatFrames : 0.0; }
+double GameLoop_GetMaxFrameSeconds() { return g_LoopFrameMax; }
+unsigned long long GameLoop_GetStepCount() { return g_LoopSteps; }
+unsigned long long GameLoop_GetFrameCount() { return g_LoopFrames; }
+unsigned long long GameLoop_GetDroppedSteps() { return g_LoopDropped; }
+
+void GameLoop_ResetFrameStats()
+{
+    g_LoopFrameSum = 0.0;
+    g_LoopFrameMax = 0.0;
+    g_LoopStatFrames = 0;
+}
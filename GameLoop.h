@@ -0,0 +1,37 @@
+﻿// GameLoop.h
+// 固定タイムステップのループ駆動
+// |  更新は一定間隔(Step)で必要回数だけ実行し、描画はフレームごとに1回
+// |  余り時間は alpha（0〜1）として render へ渡す（補間したい描画側が使う。エンジンの描画は補間しない）
+// |  時計は差し替え可能（ヘッドレス実行やテストで任意の時間を流せる）
+// |  Uncapped 時は垂直同期を切り、フレーム時間を高精度に計測する
+// __________________________________________
+
+#pragma once
+
+// 時計（任意単位のティックを返す）
+typedef long long (*GameLoopClockFn)(void* user);
+
+// 1ステップ分の更新 / 1フレーム分の描画
+typedef void (*GameLoopUpdateFn)(double dt, void* user);
+typedef void (*GameLoopRenderFn)(double alpha, void* user);
+
+//|| API ||___________________________
+void GameLoop_Init(double stepSeconds = 1.0 / 60.0, int maxStepsPerFrame = 5);
+void GameLoop_SetClock(GameLoopClockFn now, long long ticksPerSecond, void* user); //nullptr で既定の時計（System_GetTicks）に戻す
+void GameLoop_SetStep(double stepSeconds);
+void GameLoop_SetMaxSteps(int maxStepsPerFrame);                //1フレームで追いつく最大ステップ数（超過分は捨てる）
+void GameLoop_SetUncapped(bool uncapped);                       //true: Present(0,0) で上限なし計測
+
+// 1フレーム進める（update を0回以上、render を1回）。実行したステップ数を返す
+int GameLoop_Tick(GameLoopUpdateFn update, GameLoopRenderFn render, void* user);
+
+bool GameLoop_IsUncapped();
+int GameLoop_GetPresentInterval();                              //Present の SyncInterval（Uncapped なら 0）
+double GameLoop_GetStep();
+double GameLoop_GetFrameSeconds();                              //直近フレームの実時間
+double GameLoop_GetAverageFrameSeconds();                       //GameLoop_ResetFrameStats 以降の平均
+double GameLoop_GetMaxFrameSeconds();
+unsigned long long GameLoop_GetStepCount();                     //累計ステップ数
+unsigned long long GameLoop_GetFrameCount();                    //累計フレーム数
+unsigned long long GameLoop_GetDroppedSteps();                  //上限で捨てたステップ数
+void GameLoop_ResetFrameStats();
@@ -1,15 +1,12 @@
 ﻿#include "Grid.h"
 #include "Manager.h"
 #include "Main.h"
-#include <d3dcompiler.h>
-#include <wrl.h>
 #include <vector>
 
 #define M_PI 3.14159265358979323846
 
-using Microsoft::WRL::ComPtr;
 
-D3D11_BUFFER_DESC bd = {};
+RenderBufferDesc bd = {};
 
 void Grid::Init()
 {
@@ -21,61 +18,93 @@ void Grid::Init()
         { XMFLOAT3(10.0f, 0.0f, 0.0f) },
     };
 
-    // 頂点バッファ
-    bd.Usage = D3D11_USAGE_DEFAULT;
+    // 頂点バッファ（SetPos で Map して書き換える）
+    bd.Usage = RenderUsage_Dynamic;
     bd.ByteWidth = sizeof(line);
-    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bd.BindFlags = RenderBind_VertexBuffer;
+    bd.CPUAccessFlags = RenderCpuAccess_Write;
 
-    D3D11_SUBRESOURCE_DATA initData = {};
+    RenderSubresourceData initData = {};
     initData.pSysMem = line;
 
     GetDevice()->CreateBuffer(&bd, &initData, &m_vertexBuffer);
 
+    // 単位立方体（8頂点 / 12本の線分）。大きさと姿勢は定数バッファの行列で掛ける
+    Vertex box[8] = {
+        { XMFLOAT3(-0.5f, -0.5f, -0.5f) },
+        { XMFLOAT3( 0.5f, -0.5f, -0.5f) },
+        { XMFLOAT3( 0.5f,  0.5f, -0.5f) },
+        { XMFLOAT3(-0.5f,  0.5f, -0.5f) },
+        { XMFLOAT3(-0.5f, -0.5f,  0.5f) },
+        { XMFLOAT3( 0.5f, -0.5f,  0.5f) },
+        { XMFLOAT3( 0.5f,  0.5f,  0.5f) },
+        { XMFLOAT3(-0.5f,  0.5f,  0.5f) },
+    };
+    unsigned boxIndices[24] = {
+        0,1, 1,2, 2,3, 3,0,
+        4,5, 5,6, 6,7, 7,4,
+        0,4, 1,5, 2,6, 3,7
+    };
+    bd = {};
+    bd.Usage = RenderUsage_Immutable;
+    bd.ByteWidth = sizeof(box);
+    bd.BindFlags = RenderBind_VertexBuffer;
+    initData.pSysMem = box;
+    GetDevice()->CreateBuffer(&bd, &initData, &m_boxVB);
+
+    bd.ByteWidth = sizeof(boxIndices);
+    bd.BindFlags = RenderBind_IndexBuffer;
+    initData.pSysMem = boxIndices;
+    GetDevice()->CreateBuffer(&bd, &initData, &m_boxIB);
+
     // 定数バッファ
     bd = {};
-    bd.Usage = D3D11_USAGE_DEFAULT;
+    bd.Usage = RenderUsage_Default;
     bd.ByteWidth = sizeof(ConstantBuffer);
-    bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    bd.BindFlags = RenderBind_ConstantBuffer;
 
     GetDevice()->CreateBuffer(&bd, nullptr, &m_constantBuffer);
 
     // シェーダーコンパイル
 
-    //D3DCompileFromFile(L"Shader/grid_vs.hlsl", nullptr, nullptr, "VSMain", "vs_5_0", 0, 0, &vsBlob, &errorBlob);
-    //D3DCompileFromFile(L"Shader/grid_ps.hlsl", nullptr, nullptr, "PSMain", "ps_5_0", 0, 0, &psBlob, &errorBlob);
+    //GetDevice()->CompileShaderFromFile("Shader/grid_vs.hlsl", "VSMain", "vs_5_0", &vsBlob, &errorBlob);
+    //GetDevice()->CompileShaderFromFile("Shader/grid_ps.hlsl", "PSMain", "ps_5_0", &psBlob, &errorBlob);
     //
-    //GetDevice()->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, &m_vertexShader);
-    //GetDevice()->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &m_pixelShader);
+    //GetDevice()->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &m_vertexShader);
+    //GetDevice()->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), &m_pixelShader);
 
     m_vertexShader = GetVertexShader3DGrid();
     m_pixelShader = GetPixelShader3DGrid();
 
-    ID3DBlob* vsBlob = GetCurrent3DGridVSBlob();
+    RenderBlob* vsBlob = GetCurrent3DGridVSBlob();
     if (!vsBlob)
     {
-        MessageBoxA(nullptr, "SpriteScreen: VS Blob is NULL", "ERROR", MB_OK);
+        System_MessageBox("SpriteScreen: VS Blob is NULL", "ERROR");
         return;
     }
     // 入力レイアウト
-    D3D11_INPUT_ELEMENT_DESC layout[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    RenderInputElementDesc layout[] = {
+        { "POSITION", 0, RenderFormat_R32G32B32_Float, 0, 0, RenderInput_PerVertex, 0 },
     };
 
     GetDevice()->CreateInputLayout(layout, 1, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &m_inputLayout);
-
-    if (vsBlob) vsBlob->Release();
-    if (psBlob) psBlob->Release();
-    if (errorBlob) errorBlob->Release();
 }
 
 void Grid::SetView(const XMMATRIX& View)
 {
     ViewSet = View;
+    ViewProjT = XMMatrixTranspose(ViewSet * ProjSet);
 }
 
 void Grid::SetProj(const XMMATRIX& Proj)
 {
     ProjSet = Proj;
+    ViewProjT = XMMatrixTranspose(ViewSet * ProjSet);
+}
+
+void Grid::SetViewProjection(const XMMATRIX& viewProj)
+{
+    ViewProjT = XMMatrixTranspose(viewProj);
 }
 
 void Grid::SetColor(const XMFLOAT4& color)
@@ -85,23 +114,24 @@ void Grid::SetColor(const XMFLOAT4& color)
 
 void Grid::Draw()
 {
+    LIA_PROFILE_SCOPE("Grid::Draw");
     ConstantBuffer cb;
     // 定数バッファ更新
-    cb.viewProj = XMMatrixTranspose(ViewSet * ProjSet);
+    cb.viewProj = ViewProjT;
     cb.lineColor = ColorSet;
 
-    GetContext()->UpdateSubresource(m_constantBuffer, 0, nullptr, &cb, 0, 0);
+    GetContext()->UpdateSubresource(m_constantBuffer.Get(), &cb);
     
     // バインド
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
-    GetContext()->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
-    GetContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
-    GetContext()->IASetInputLayout(m_inputLayout);
-    GetContext()->VSSetShader(m_vertexShader, nullptr, 0);
-    GetContext()->VSSetConstantBuffers(0, 1, &m_constantBuffer);
-    GetContext()->PSSetShader(m_pixelShader, nullptr, 0);
-    GetContext()->PSSetConstantBuffers(0, 1, &m_constantBuffer);
+    unsigned stride = sizeof(Vertex);
+    unsigned offset = 0;
+    GetContext()->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
+    GetContext()->IASetPrimitiveTopology(RenderTopology_LineList);
+    GetContext()->IASetInputLayout(m_inputLayout.Get());
+    GetContext()->VSSetShader(m_vertexShader);
+    GetContext()->VSSetConstantBuffers(0, 1, m_constantBuffer.GetAddressOf());
+    GetContext()->PSSetShader(m_pixelShader);
+    GetContext()->PSSetConstantBuffers(0, 1, m_constantBuffer.GetAddressOf());
 
     // 描画
     GetContext()->Draw(2, 0);
@@ -115,167 +145,114 @@ void Grid::SetPos(XMFLOAT3 Start, XMFLOAT3 End)
         { End },
     };
 
-    // 頂点バッファ
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(line);
-    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    // 頂点バッファ更新（作り直さない）
+    RenderMappedSubresource mapped{};
+    if (!GetContext()->Map(m_vertexBuffer.Get(), RenderMap_WriteDiscard, &mapped) || !mapped.pData) return;
+    memcpy(mapped.pData, line, sizeof(line));
+    GetContext()->Unmap(m_vertexBuffer.Get());
+}
 
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = line;
+// 線分の描画（共通）。world は単位形状からワールドへの行列
+void Grid::DrawLines(RenderBuffer* vb, RenderBuffer* ib, unsigned indexCount, const XMMATRIX& world)
+{
+    ConstantBuffer cb;
+    cb.viewProj = ViewProjT * XMMatrixTranspose(world);    // 転置済み world * view * proj
+    cb.lineColor = ColorSet;
+    GetContext()->UpdateSubresource(m_constantBuffer.Get(), &cb);
 
-    GetDevice()->CreateBuffer(&bd, &initData, &m_vertexBuffer);
+    unsigned stride = sizeof(Vertex);
+    unsigned offset = 0;
+    GetContext()->IASetVertexBuffers(0, 1, &vb, &stride, &offset);
+    GetContext()->IASetIndexBuffer(ib, RenderFormat_R32_UInt, 0);
+    GetContext()->IASetPrimitiveTopology(RenderTopology_LineList);
+
+    GetContext()->IASetInputLayout(m_inputLayout.Get());
+    GetContext()->VSSetShader(m_vertexShader);
+    GetContext()->VSSetConstantBuffers(0, 1, m_constantBuffer.GetAddressOf());
+    GetContext()->PSSetShader(m_pixelShader);
+    GetContext()->PSSetConstantBuffers(0, 1, m_constantBuffer.GetAddressOf());
+
+    GetContext()->DrawIndexed(indexCount, 0, 0);
 }
 
-void Grid::DrawBox(const XMFLOAT3& pos, const XMFLOAT3& size, const XMFLOAT3& Angle)
+// 辺の数 sides の単位多角柱（無ければ作る）
+const Grid::PolygonMesh* Grid::GetPolygonMesh(int sides)
 {
-    // --- 1. 8頂点を作成 ---
-    XMFLOAT3 v[8] = {
-        {-0.5f, -0.5f, -0.5f},
-        { 0.5f, -0.5f, -0.5f},
-        { 0.5f,  0.5f, -0.5f},
-        {-0.5f,  0.5f, -0.5f},
-        {-0.5f, -0.5f,  0.5f},
-        { 0.5f, -0.5f,  0.5f},
-        { 0.5f,  0.5f,  0.5f},
-        {-0.5f,  0.5f,  0.5f},
-    };
+    for (const PolygonMesh& m : m_polygonMeshes) if (m.Sides == sides) return &m;
 
-    // --- 2. ワールド行列を作成 ---
-    XMMATRIX S = XMMatrixScaling(size.x, size.y, size.z);
-    XMMATRIX R = XMMatrixRotationRollPitchYaw(Angle.x, Angle.y, Angle.z);
-    XMMATRIX T = XMMatrixTranslation(pos.x, pos.y, pos.z);
-    XMMATRIX world = S * R * T;
+    // 頂点: 上面（z = +0.5）sides 個 → 下面（z = -0.5）sides 個（作るときだけなので一時配列はフレームアリーナ）
+    const int vertCount = sides * 2;
+    Vertex* verts = FrameAllocArray<Vertex>(vertCount);
+    for (int i = 0; i < sides; ++i)
+    {
+        float theta = (2.0f * static_cast<float>(M_PI) * i) / sides;
+        float x = cosf(theta) * 0.5f;
+        float y = sinf(theta) * 0.5f;
+        verts[i].position = XMFLOAT3(x, y, +0.5f);
+        verts[i + sides].position = XMFLOAT3(x, y, -0.5f);
+    }
 
-    // --- 3. 頂点を変換 ---
-    Vertex verts[8];
-    for (int i = 0; i < 8; i++)
+    // インデックス: 上面の辺 → 下面の辺 → 側面の辺（上面だけなら先頭 sides * 2 個）
+    const int indexCount = sides * 6;
+    unsigned* indices = FrameAllocArray<unsigned>(indexCount);
+    for (int i = 0; i < sides; ++i) {
+        unsigned next = (i + 1) % sides;
+        indices[i * 2] = i;
+        indices[i * 2 + 1] = next;
+        indices[sides * 2 + i * 2] = i + sides;
+        indices[sides * 2 + i * 2 + 1] = next + sides;
+        indices[sides * 4 + i * 2] = i;
+        indices[sides * 4 + i * 2 + 1] = i + sides;
+    }
+
+    PolygonMesh m;
+    m.Sides = sides;
+    RenderBufferDesc vbd{};
+    vbd.Usage = RenderUsage_Immutable;
+    vbd.ByteWidth = sizeof(Vertex) * vertCount;
+    vbd.BindFlags = RenderBind_VertexBuffer;
+    RenderSubresourceData vinit{ verts };
+    RenderBufferDesc ibd{};
+    ibd.Usage = RenderUsage_Immutable;
+    ibd.ByteWidth = sizeof(unsigned) * indexCount;
+    ibd.BindFlags = RenderBind_IndexBuffer;
+    RenderSubresourceData iinit{ indices };
+    if (!DeviceGetter->CreateBuffer(&vbd, &vinit, &m.VB) || !DeviceGetter->CreateBuffer(&ibd, &iinit, &m.IB))
     {
-        XMVECTOR p = XMLoadFloat3(&v[i]);
-        p = XMVector3TransformCoord(p, world);
-        XMStoreFloat3(&verts[i].position, p);
+        AddMessage("Grid: CreateBuffer polygon failed");
+        return nullptr;
     }
+    m_polygonMeshes.push_back(m);
+    return &m_polygonMeshes.back();
+}
 
-    // --- 4. 12本の線分インデックス ---
-    UINT indices[] = {
-        0,1, 1,2, 2,3, 3,0,
-        4,5, 5,6, 6,7, 7,4,
-        0,4, 1,5, 2,6, 3,7
-    };
+void Grid::DrawBox(const XMFLOAT3& pos, const XMFLOAT3& size, const XMFLOAT3& Angle)
+{
+    DrawBox(XMMatrixRotationRollPitchYaw(Angle.x, Angle.y, Angle.z) * XMMatrixTranslation(pos.x, pos.y, pos.z), size);
+}
 
-    // --- 5. 一時頂点/インデックスバッファ作成 ---
-    D3D11_BUFFER_DESC vbd{};
-    vbd.Usage = D3D11_USAGE_IMMUTABLE;
-    vbd.ByteWidth = sizeof(verts);
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA vinit{ verts };
-    ComPtr<ID3D11Buffer> vb;
-    DeviceGetter->CreateBuffer(&vbd, &vinit, &vb);
-
-    D3D11_BUFFER_DESC ibd{};
-    ibd.Usage = D3D11_USAGE_IMMUTABLE;
-    ibd.ByteWidth = sizeof(indices);
-    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA iinit{ indices };
-    ComPtr<ID3D11Buffer> ib;
-    DeviceGetter->CreateBuffer(&ibd, &iinit, &ib);
-
-    // --- 6. 定数バッファ更新 ---
-    ConstantBuffer cb;
-    cb.viewProj = XMMatrixTranspose(ViewSet * ProjSet);
-    cb.lineColor = ColorSet;
-    GetContext()->UpdateSubresource(m_constantBuffer, 0, nullptr, &cb, 0, 0);
-
-    // --- 7. 描画セットアップ ---
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
-    GetContext()->IASetVertexBuffers(0, 1, vb.GetAddressOf(), &stride, &offset);
-    GetContext()->IASetIndexBuffer(ib.Get(), DXGI_FORMAT_R32_UINT, 0);
-    GetContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
-
-    GetContext()->IASetInputLayout(m_inputLayout);
-    GetContext()->VSSetShader(m_vertexShader, nullptr, 0);
-    GetContext()->VSSetConstantBuffers(0, 1, &m_constantBuffer);
-    GetContext()->PSSetShader(m_pixelShader, nullptr, 0);
-    GetContext()->PSSetConstantBuffers(0, 1, &m_constantBuffer);
-
-    // --- 8. Draw ---
-    GetContext()->DrawIndexed(24, 0, 0);
+// rotTrans: 回転・移動（親子付け済み）。size はその前に掛ける
+void Grid::DrawBox(const XMMATRIX& rotTrans, const XMFLOAT3& size)
+{
+    LIA_PROFILE_SCOPE("Grid::DrawBox");
+    // 単位立方体を大きさ → 回転・移動の順に変換（頂点は Init で作ったものをそのまま使う）
+    DrawLines(m_boxVB.Get(), m_boxIB.Get(), 24, XMMatrixScaling(size.x, size.y, size.z) * rotTrans);
 }
 
 //グリッド表示用===============================
 void Grid::DrawPolygonGrid(const XMFLOAT3& pos, float radius, int sides, const XMFLOAT3& Angle)
 {
+    LIA_PROFILE_SCOPE("Grid::DrawPolygonGrid");
     if (sides < 3) sides = 3;
+    const PolygonMesh* mesh = GetPolygonMesh(sides);
+    if (!mesh) return;
 
-    // --- 1. 正多角形の頂点を作成（XY平面に配置） ---
-    std::vector<XMFLOAT3> poly(sides);
-    for (int i = 0; i < sides; ++i) {
-        float theta = (2.0f * static_cast<float>(M_PI) * i) / sides;
-        float x = cosf(theta) * radius;
-        float y = sinf(theta) * radius;
-        poly[i] = XMFLOAT3{x, y, 0.0f};
-    }
-
-    // --- 2. ワールド行列を作成 ---
+    // 単位多角柱の上面（z = +0.5、半径 0.5）を XY 平面の半径 radius へ → 回転・移動
     XMMATRIX R = XMMatrixRotationRollPitchYaw(Angle.x, Angle.y, Angle.z);
     XMMATRIX T = XMMatrixTranslation(pos.x, pos.y, pos.z);
-    XMMATRIX world = R * T; // スケールは既に radius で反映済み
-
-    // --- 3. 頂点を変換して Vertex 配列を作成 ---
-    std::vector<Vertex> verts(sides);
-    for (int i = 0; i < sides; ++i) {
-        XMVECTOR p = XMLoadFloat3(&poly[i]);
-        p = XMVector3TransformCoord(p, world);
-        XMStoreFloat3(&verts[i].position, p);
-        // 必要なら法線やUVもセット（今回は線描画のみなので position のみでOK）
-    }
+    XMMATRIX world = XMMatrixTranslation(0.0f, 0.0f, -0.5f) * XMMatrixScaling(radius * 2.0f, radius * 2.0f, 1.0f) * R * T;
 
-    // --- 4. 線分インデックス（辺をつなぐ） ---
-    std::vector<UINT> indices;
-    indices.reserve(sides * 2);
-    for (int i = 0; i < sides; ++i) {
-        indices.push_back(i);
-        indices.push_back((i + 1) % sides);
-    }
-
-    // --- 5. 一時頂点/インデックスバッファ作成 ---
-    D3D11_BUFFER_DESC vbd{};
-    vbd.Usage = D3D11_USAGE_IMMUTABLE;
-    vbd.ByteWidth = static_cast<UINT>(sizeof(Vertex) * verts.size());
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA vinit{ verts.data() };
-    ComPtr<ID3D11Buffer> vb;
-    DeviceGetter->CreateBuffer(&vbd, &vinit, &vb);
-
-    D3D11_BUFFER_DESC ibd{};
-    ibd.Usage = D3D11_USAGE_IMMUTABLE;
-    ibd.ByteWidth = static_cast<UINT>(sizeof(UINT) * indices.size());
-    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA iinit{ indices.data() };
-    ComPtr<ID3D11Buffer> ib;
-    DeviceGetter->CreateBuffer(&ibd, &iinit, &ib);
-
-    // --- 6. 定数バッファ更新（共通） ---
-    ConstantBuffer cb;
-    cb.viewProj = XMMatrixTranspose(ViewSet * ProjSet);
-    cb.lineColor = ColorSet;
-    GetContext()->UpdateSubresource(m_constantBuffer, 0, nullptr, &cb, 0, 0);
-
-    // --- 7. 描画セットアップ ---
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
-    GetContext()->IASetVertexBuffers(0, 1, vb.GetAddressOf(), &stride, &offset);
-    GetContext()->IASetIndexBuffer(ib.Get(), DXGI_FORMAT_R32_UINT, 0);
-    GetContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
-
-    GetContext()->IASetInputLayout(m_inputLayout);
-    GetContext()->VSSetShader(m_vertexShader, nullptr, 0);
-    GetContext()->VSSetConstantBuffers(0, 1, &m_constantBuffer);
-    GetContext()->PSSetShader(m_pixelShader, nullptr, 0);
-    GetContext()->PSSetConstantBuffers(0, 1, &m_constantBuffer);
-
-    // --- 8. Draw ---
-    GetContext()->DrawIndexed(static_cast<UINT>(indices.size()), 0, 0);
+    DrawLines(mesh->VB.Get(), mesh->IB.Get(), static_cast<unsigned>(sides * 2), world);
 }
 
 // グリッドとして複数配置する
@@ -299,90 +276,16 @@ void Grid::DrawGridPolygonGrid(int cols, int rows, float spacing, int sides, flo
 //多角柱の描画
 void Grid::DrawGridPolygon(int sides, const XMFLOAT3& pos, const XMFLOAT3& size, const XMFLOAT3& Angle)
 {
-    if (sides < 3) sides = 3;
-
-    const int vertCount = sides * 2;
-
-    float halfW = size.x * 0.5f;
-    float halfD = size.y * 0.5f;
-    float halfH = size.z * 0.5f;
-
-    std::vector<XMFLOAT3> localVerts(vertCount);
-
-    // --- 1. 正多角形の上面・下面をサイズ反映して生成 ---
-    for (int i = 0; i < sides; ++i)
-    {
-        float theta = (2.0f * static_cast<float>(M_PI) * i) / sides;
-        float x = cosf(theta) * halfW;
-        float y = sinf(theta) * halfD;
-
-        // 上面
-        localVerts[i] = XMFLOAT3{ x, y, +halfH };
-        // 下面
-        localVerts[i + sides] = XMFLOAT3{ x, y, -halfH };
-    }
-
-    // --- 2. ワールド変換 ---
-    XMMATRIX S = XMMatrixScaling(1, 1, 1); // ここでは使用しない（すでに size 反映）
-    XMMATRIX R = XMMatrixRotationRollPitchYaw(Angle.x, Angle.y, Angle.z);
-    XMMATRIX T = XMMatrixTranslation(pos.x, pos.y, pos.z);
-    XMMATRIX world = S * R * T;
-
-    std::vector<Vertex> verts(vertCount);
-    for (int i = 0; i < vertCount; ++i)
-    {
-        XMVECTOR p = XMLoadFloat3(&localVerts[i]);
-        p = XMVector3TransformCoord(p, world);
-        XMStoreFloat3(&verts[i].position, p);
-    }
+    DrawGridPolygon(sides, XMMatrixRotationRollPitchYaw(Angle.x, Angle.y, Angle.z) * XMMatrixTranslation(pos.x, pos.y, pos.z), size);
+}
 
-    // --- 3. インデックス作成（上面・下面・側面）---
-    std::vector<UINT> indices;
-    indices.reserve(sides * 6);
-
-    for (int i = 0; i < sides; i++) {
-        indices.push_back(i);
-        indices.push_back((i + 1) % sides);
-        indices.push_back(i + sides);
-        indices.push_back(((i + 1) % sides) + sides);
-        indices.push_back(i);
-        indices.push_back(i + sides);
-    }
+void Grid::DrawGridPolygon(int sides, const XMMATRIX& world, const XMFLOAT3& size)
+{
+    LIA_PROFILE_SCOPE("Grid::DrawGridPolygon");
+    if (sides < 3) sides = 3;
+    const PolygonMesh* mesh = GetPolygonMesh(sides);
+    if (!mesh) return;
 
-    // --- 4. バッファ生成---
-    D3D11_BUFFER_DESC vbd{};
-    vbd.Usage = D3D11_USAGE_IMMUTABLE;
-    vbd.ByteWidth = sizeof(Vertex) * verts.size();
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA vinit{ verts.data() };
-    ComPtr<ID3D11Buffer> vb;
-    DeviceGetter->CreateBuffer(&vbd, &vinit, &vb);
-
-    D3D11_BUFFER_DESC ibd{};
-    ibd.Usage = D3D11_USAGE_IMMUTABLE;
-    ibd.ByteWidth = sizeof(UINT) * indices.size();
-    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA iinit{ indices.data() };
-    ComPtr<ID3D11Buffer> ib;
-    DeviceGetter->CreateBuffer(&ibd, &iinit, &ib);
-
-    // --- 5. 共通描画処理 ---
-    ConstantBuffer cb;
-    cb.viewProj = XMMatrixTranspose(ViewSet * ProjSet);
-    cb.lineColor = ColorSet;
-    GetContext()->UpdateSubresource(m_constantBuffer, 0, nullptr, &cb, 0, 0);
-
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
-    GetContext()->IASetVertexBuffers(0, 1, vb.GetAddressOf(), &stride, &offset);
-    GetContext()->IASetIndexBuffer(ib.Get(), DXGI_FORMAT_R32_UINT, 0);
-    GetContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
-
-    GetContext()->IASetInputLayout(m_inputLayout);
-    GetContext()->VSSetShader(m_vertexShader, nullptr, 0);
-    GetContext()->VSSetConstantBuffers(0, 1, &m_constantBuffer);
-    GetContext()->PSSetShader(m_pixelShader, nullptr, 0);
-    GetContext()->PSSetConstantBuffers(0, 1, &m_constantBuffer);
-
-    GetContext()->DrawIndexed((UINT)indices.size(), 0, 0);
-}
\ No newline at end of file
+    // 単位多角柱（半径 0.5 / 高さ 1）を size.x（幅）/ size.y（奥行き）/ size.z（高さ）で伸ばしてから world
+    DrawLines(mesh->VB.Get(), mesh->IB.Get(), static_cast<unsigned>(sides * 6), XMMatrixScaling(size.x, size.y, size.z) * world);
+}
@@ -1,9 +1,10 @@
-#pragma once
+﻿#pragma once
 
 #include "Component.h"
+#include "RenderDevice.h"
 
-#include <d3d11.h>
-#include <DirectXMath.h>
+#include "MathAPI.h"
+#include <vector>
 using namespace DirectX;
 
 class Grid
@@ -19,16 +20,19 @@ public:
 
     void SetView(const XMMATRIX& View);
     void SetProj(const XMMATRIX& Proj);
+    void SetViewProjection(const XMMATRIX& viewProj);             // view * proj（カメラで計算済みの値）
     void SetColor(const XMFLOAT4& color);
     void SetPos(XMFLOAT3 Start, XMFLOAT3 End);
 
     void DrawBox(const XMFLOAT3& pos, const XMFLOAT3& size, const XMFLOAT3& Angle);
+    void DrawBox(const XMMATRIX& world, const XMFLOAT3& size);     // world: 回転・移動のみ（TransformManager の値）
     void DrawGridPolygonGrid(
         int cols, int rows,
         float spacing, int sides,
         float radius,
         const XMFLOAT3& origin, const XMFLOAT3& Angle);
     void DrawGridPolygon(int sides, const XMFLOAT3& pos, const XMFLOAT3& size, const XMFLOAT3& Angle);
+    void DrawGridPolygon(int sides, const XMMATRIX& world, const XMFLOAT3& size);
 private:
 
     struct Vertex {
@@ -36,25 +40,34 @@ private:
     };
 
     struct ConstantBuffer {
-        XMMATRIX viewProj;
+        XMMATRIX viewProj;                                        // 転置済み。箱 / 多角形は単位形状の world を掛けたもの
         XMFLOAT4 lineColor = { 0.0f,0.0f,0.0f,0.0f };
     };
 
+    // 辺の数ごとの単位多角柱（半径 0.5 / 高さ 1）。インデックスは上面の辺 → 下面の辺 → 側面の辺の順
+    struct PolygonMesh {
+        int Sides = 0;
+        RenderPtr<RenderBuffer> VB;
+        RenderPtr<RenderBuffer> IB;
+    };
+
     XMMATRIX ViewSet;
     XMMATRIX ProjSet;
+    XMMATRIX ViewProjT = XMMatrixIdentity();                      // 転置済み view * proj（Draw ごとに掛けない）
     XMFLOAT4 ColorSet;
 
-    ID3D11Buffer* m_vertexBuffer = nullptr;
-    ID3D11Buffer* m_constantBuffer = nullptr;
-    ID3D11VertexShader* m_vertexShader = nullptr;
-    ID3D11PixelShader* m_pixelShader = nullptr;
-    ID3D11InputLayout* m_inputLayout = nullptr;
-
-    ID3DBlob* vsBlob = nullptr;
-    ID3DBlob* psBlob = nullptr;
-    ID3DBlob* errorBlob = nullptr;
+    RenderPtr<RenderBuffer> m_vertexBuffer;                       // 1本線（Dynamic。SetPos で Map して書き換える）
+    RenderPtr<RenderBuffer> m_constantBuffer;
+    RenderPtr<RenderBuffer> m_boxVB;                              // 単位立方体（Init で1回だけ作る）
+    RenderPtr<RenderBuffer> m_boxIB;
+    std::vector<PolygonMesh> m_polygonMeshes;
+    RenderVertexShader* m_vertexShader = nullptr;     // ShaderManager が持つ
+    RenderPixelShader* m_pixelShader = nullptr;
+    RenderPtr<RenderInputLayout> m_inputLayout;
 
-    ID3D11Device* DeviceGetter;
+    RenderDevice* DeviceGetter;
 
     void DrawPolygonGrid(const XMFLOAT3& pos, float radius, int sides, const XMFLOAT3& Angle);
+    const PolygonMesh* GetPolygonMesh(int sides);                 // 無ければ作る（失敗は nullptr）
+    void DrawLines(RenderBuffer* vb, RenderBuffer* ib, unsigned indexCount, const XMMATRIX& world);
 };
\ No newline at end of file
@@ -0,0 +1,502 @@
+﻿// JobManager.cpp
+// ワークスティーリング型ジョブシステムの実装（JobSystem.h）
+// |  スレッド 0 がメインスレッド、1〜 がワーカー
+// |  キューは固定長の Chase-Lev 両端キュー（持ち主は末尾で push/pop、他スレッドは先頭から steal）
+// |  ジョブ本体はスレッドごとのリングプールから切り出す（new しない）
+// |  次の枠のジョブがまだキューにある / 実行中ならその場で実行する（持ち主が pop を続けると古いジョブが先頭に残るため）
+// |  キューが溢れた場合・未初期化の場合はその場で実行する
+// __________________________________________
+
+#include "JobSystem.h"
+#include "BenchRunner.h"
+#include "Manager.h"
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define JOB_MAX_THREADS 64
+#define JOB_QUEUE_SIZE  4096    // 2の累乗
+#define JOB_POOL_SIZE   8192    // 2の累乗（使用中の枠は Live で判定）
+#define JOB_SPIN_COUNT  64      // 眠る前に探しに行く回数
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct Job {
+    JobFn Fn;
+    void* Data;
+    JobCounter* Counter;
+    std::atomic<bool>* Live;    // プールの使用中フラグ（メインスレッド用ジョブは nullptr）
+    // ParallelFor 用（Data は自分自身を指す）
+    JobRangeFn RangeFn;
+    void* RangeData;
+    int Begin, End, Grain;
+};
+
+// Chase-Lev 両端キュー（固定長）
+struct JobQueue {
+    std::atomic<long long> Top{ 0 };
+    std::atomic<long long> Bottom{ 0 };
+    std::atomic<Job*> Items[JOB_QUEUE_SIZE];
+
+    bool Push(Job* job)
+    {
+        long long b = Bottom.load(std::memory_order_relaxed);
+        long long t = Top.load(std::memory_order_acquire);
+        if (b - t >= JOB_QUEUE_SIZE) return false;
+        Items[b & (JOB_QUEUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+        Bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 持ち主のみ
+    Job* Pop()
+    {
+        long long b = Bottom.load(std::memory_order_relaxed) - 1;
+        Bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = Top.load(std::memory_order_relaxed);
+        if (t > b) {
+            Bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Job* job = Items[b & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // 最後の1個は steal と取り合う
+            if (!Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            Bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    // 他スレッドから
+    Job* Steal()
+    {
+        long long t = Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long b = Bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Job* job = Items[t & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (!Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return job;
+    }
+};
+
+struct JobThread {
+    JobQueue Queue;
+    Job Pool[JOB_POOL_SIZE];
+    std::atomic<bool> Live[JOB_POOL_SIZE] = {};     // 積んでから実行し終えるまで true
+    unsigned PoolIndex = 0;
+    unsigned Random = 0;
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static JobThread* g_JobThreads = nullptr;
+static int g_JobThreadCount = 0;                 // メイン + ワーカー
+static std::vector<std::thread> g_JobWorkers;
+static std::atomic<bool> g_JobRunning{ false };
+static thread_local int t_JobIndex = -1;
+
+// 眠っているワーカーの起床
+static std::mutex g_JobSleepMutex;
+static std::condition_variable g_JobWake;
+static std::atomic<int> g_JobSleeping{ 0 };
+static std::atomic<int> g_JobPending{ 0 };       // キューに積まれている数（目安）
+
+// メインスレッド専用ジョブ
+static std::mutex g_JobMainMutex;
+static std::vector<Job> g_JobMainQueue;
+static std::vector<std::vector<Job>> g_JobMainSpare;   // 実行し終えた手元（容量を残したまま次の入れ替えに使う。メインスレッドのみ）
+
+//-----------------------------------------
+// 内部
+//-----------------------------------------
+// 次の枠がまだ使用中なら nullptr（呼び出し側がその場で実行する）
+static Job* Job_Alloc(JobThread& th)
+{
+    unsigned i = th.PoolIndex & (JOB_POOL_SIZE - 1);
+    if (th.Live[i].load(std::memory_order_acquire)) return nullptr;
+    th.PoolIndex++;
+    th.Live[i].store(true, std::memory_order_relaxed);
+    Job* job = &th.Pool[i];
+    job->Live = &th.Live[i];
+    return job;
+}
+
+static void Job_Execute(Job* job)
+{
+    // 枠は実行し終えてから返す（ParallelFor のジョブは実行中も自分の枠を読む）
+    JobFn fn = job->Fn;
+    void* data = job->Data;
+    JobCounter* counter = job->Counter;
+    std::atomic<bool>* live = job->Live;
+    fn(data);
+    if (live) live->store(false, std::memory_order_release);
+    if (counter) counter->Value.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+static void Job_Wake()
+{
+    if (g_JobSleeping.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(g_JobSleepMutex);
+        g_JobWake.notify_one();
+    }
+}
+
+static void Job_Push(JobThread& th, Job* job)
+{
+    if (!th.Queue.Push(job)) {
+        // 溢れたらその場で実行
+        Job_Execute(job);
+        return;
+    }
+    g_JobPending.fetch_add(1, std::memory_order_seq_cst);
+    Job_Wake();
+}
+
+// 自分のキュー → 他スレッドから steal
+static Job* Job_Find(int self)
+{
+    JobThread& th = g_JobThreads[self];
+    Job* job = th.Queue.Pop();
+    if (!job) {
+        // xorshift で開始位置をばらす
+        unsigned r = th.Random;
+        r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+        th.Random = r;
+        int start = (int)(r % (unsigned)g_JobThreadCount);
+        for (int i = 0; i < g_JobThreadCount && !job; ++i) {
+            int victim = (start + i) % g_JobThreadCount;
+            if (victim == self) continue;
+            job = g_JobThreads[victim].Queue.Steal();
+        }
+    }
+    if (job) g_JobPending.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+static bool Job_RunOneMain()
+{
+    // 実行中に Job_Wait から再入しても良いよう手元へ移してから実行
+    // 手元は前に使い終えた配列と入れ替える（キューにも容量付きの配列が戻るので毎フレーム確保しない）
+    std::vector<Job> jobs;
+    if (!g_JobMainSpare.empty()) {
+        jobs.swap(g_JobMainSpare.back());
+        g_JobMainSpare.pop_back();
+    }
+    bool found;
+    {
+        std::lock_guard<std::mutex> lock(g_JobMainMutex);
+        found = !g_JobMainQueue.empty();
+        if (found) jobs.swap(g_JobMainQueue);
+    }
+    if (found)
+        for (Job& j : jobs) Job_Execute(&j);
+    jobs.clear();
+    g_JobMainSpare.push_back(std::move(jobs));
+    return found;
+}
+
+static void Job_WorkerMain(int index)
+{
+    t_JobIndex = index;
+    g_JobThreads[index].Random = 0x9E3779B9u * (unsigned)(index + 1);
+
+    char name[32];
+    snprintf(name, sizeof(name), "Worker %d", index);
+    LIA_PROFILE_THREAD(name);
+
+    int spin = 0;
+    while (g_JobRunning.load(std::memory_order_acquire)) {
+        Job* job = Job_Find(index);
+        if (job) {
+            Job_Execute(job);
+            spin = 0;
+            continue;
+        }
+        if (++spin < JOB_SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(g_JobSleepMutex);
+        g_JobSleeping.fetch_add(1, std::memory_order_seq_cst);
+        g_JobWake.wait(lock, [] {
+            return !g_JobRunning.load(std::memory_order_acquire) ||
+                g_JobPending.load(std::memory_order_seq_cst) > 0;
+        });
+        g_JobSleeping.fetch_sub(1, std::memory_order_seq_cst);
+        spin = 0;
+    }
+}
+
+//-----------------------------------------
+// 初期化 / 終了
+//-----------------------------------------
+void Job_Init(int workerCount)
+{
+    if (g_JobThreads) return;
+
+    if (workerCount < 0) {
+        int hw = (int)std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 0;
+    }
+    if (workerCount > JOB_MAX_THREADS - 1) workerCount = JOB_MAX_THREADS - 1;
+
+    g_JobThreadCount = workerCount + 1;
+    g_JobThreads = new JobThread[g_JobThreadCount];
+    g_JobThreads[0].Random = 0x12345678u;
+    t_JobIndex = 0;
+
+    g_JobRunning.store(true, std::memory_order_release);
+    g_JobWorkers.reserve(workerCount);
+    for (int i = 1; i <= workerCount; ++i)
+        g_JobWorkers.emplace_back(Job_WorkerMain, i);
+}
+
+void Job_Shutdown()
+{
+    if (!g_JobThreads) return;
+
+    // 残っているジョブを片付けてから止める
+    Job* job;
+    while ((job = Job_Find(0)) != nullptr) Job_Execute(job);
+    Job_PumpMainThread();
+
+    {
+        std::lock_guard<std::mutex> lock(g_JobSleepMutex);
+        g_JobRunning.store(false, std::memory_order_release);
+    }
+    g_JobWake.notify_all();
+    for (auto& t : g_JobWorkers) t.join();
+    g_JobWorkers.clear();
+
+    g_JobMainSpare.clear();
+    delete[] g_JobThreads;
+    g_JobThreads = nullptr;
+    g_JobThreadCount = 0;
+    g_JobPending.store(0);
+    t_JobIndex = -1;
+}
+
+int Job_GetWorkerCount() { return g_JobThreadCount > 0 ? g_JobThreadCount - 1 : 0; }
+int Job_GetThreadIndex() { return t_JobIndex; }
+bool Job_IsMainThread() { return t_JobIndex == 0; }
+
+//-----------------------------------------
+// 投入 / 待機
+//-----------------------------------------
+void Job_Run(JobFn fn, void* data, JobCounter* counter)
+{
+    if (!fn) return;
+    if (counter) counter->Value.fetch_add(1, std::memory_order_relaxed);
+
+    // ジョブシステム外のスレッド / 未初期化はその場で実行
+    if (!g_JobThreads || t_JobIndex < 0) {
+        fn(data);
+        if (counter) counter->Value.fetch_sub(1, std::memory_order_acq_rel);
+        return;
+    }
+
+    JobThread& th = g_JobThreads[t_JobIndex];
+    Job* job = Job_Alloc(th);
+    if (!job) {
+        fn(data);
+        if (counter) counter->Value.fetch_sub(1, std::memory_order_acq_rel);
+        return;
+    }
+    job->Fn = fn;
+    job->Data = data;
+    job->Counter = counter;
+    Job_Push(th, job);
+}
+
+void Job_RunMainThread(JobFn fn, void* data, JobCounter* counter)
+{
+    if (!fn) return;
+    if (counter) counter->Value.fetch_add(1, std::memory_order_relaxed);
+
+    if (!g_JobThreads) {
+        fn(data);
+        if (counter) counter->Value.fetch_sub(1, std::memory_order_acq_rel);
+        return;
+    }
+
+    Job job = {};
+    job.Fn = fn;
+    job.Data = data;
+    job.Counter = counter;
+    std::lock_guard<std::mutex> lock(g_JobMainMutex);
+    g_JobMainQueue.push_back(job);
+}
+
+void Job_PumpMainThread()
+{
+    if (t_JobIndex != 0) return;
+    while (Job_RunOneMain()) {}
+}
+
+void Job_Wait(JobCounter* counter)
+{
+    if (!counter) return;
+    int self = t_JobIndex;
+    while (counter->Value.load(std::memory_order_acquire) > 0) {
+        if (self < 0 || !g_JobThreads) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (self == 0 && Job_RunOneMain()) continue;
+        Job* job = Job_Find(self);
+        if (job) Job_Execute(job);
+        else std::this_thread::yield();
+    }
+}
+
+//-----------------------------------------
+// ParallelFor（後半をジョブとして積み、自分は前半を続ける）
+//-----------------------------------------
+static void Job_SplitRange(JobRangeFn fn, void* user, int begin, int end, int grain, JobCounter* counter);
+
+static void Job_RangeEntry(void* data)
+{
+    const Job* src = static_cast<const Job*>(data);
+    Job_SplitRange(src->RangeFn, src->RangeData, src->Begin, src->End, src->Grain, src->Counter);
+}
+
+static void Job_SplitRange(JobRangeFn fn, void* user, int begin, int end, int grain, JobCounter* counter)
+{
+    JobThread& th = g_JobThreads[t_JobIndex];
+    while (end - begin > grain) {
+        // 枠が空いていなければ残りは自分で実行
+        Job* job = Job_Alloc(th);
+        if (!job) break;
+        int mid = begin + (end - begin) / 2;
+        counter->Value.fetch_add(1, std::memory_order_relaxed);
+        job->Fn = Job_RangeEntry;
+        job->Data = job;
+        job->Counter = counter;
+        job->RangeFn = fn;
+        job->RangeData = user;
+        job->Begin = mid;
+        job->End = end;
+        job->Grain = grain;
+        Job_Push(th, job);
+        end = mid;
+    }
+    fn(begin, end, user);
+}
+
+void Job_ParallelFor(int begin, int end, int grain, JobRangeFn fn, void* data)
+{
+    if (!fn || end <= begin) return;
+    int count = end - begin;
+    if (grain <= 0) {
+        // スレッドあたり4分割を目安
+        int parts = (g_JobThreadCount > 0 ? g_JobThreadCount : 1) * 4;
+        grain = (count + parts - 1) / parts;
+        if (grain < 1) grain = 1;
+    }
+    if (!g_JobThreads || t_JobIndex < 0 || count <= grain) {
+        fn(begin, end, data);
+        return;
+    }
+
+    JobCounter counter;
+    Job_SplitRange(fn, data, begin, end, grain, &counter);
+    Job_Wait(&counter);
+}
+
+//-----------------------------------------
+// ベンチマーク（BenchRunner のスクリプトから使う）
+// |  job_fib <n>          : fib(n) をジョブで再帰分割（n<=JOB_FIB_CUTOFF は直列）
+// |  job_parallel_for <n> : n 要素の配列を ParallelFor で更新
+// |  それぞれ直列版も同じフレームで測り、結果が一致しなければ AddMessage
+//-----------------------------------------
+#define JOB_FIB_CUTOFF 16
+
+static int g_BenchFibN = 0;
+static std::vector<float> g_BenchForData;
+
+struct FibTask {
+    int N;
+    long long Result;
+};
+
+static long long Job_FibSerial(int n)
+{
+    return n < 2 ? n : Job_FibSerial(n - 1) + Job_FibSerial(n - 2);
+}
+
+static void Job_FibEntry(void* data)
+{
+    FibTask* task = static_cast<FibTask*>(data);
+    if (task->N <= JOB_FIB_CUTOFF) {
+        task->Result = Job_FibSerial(task->N);
+        return;
+    }
+    FibTask a = { task->N - 1, 0 };
+    FibTask b = { task->N - 2, 0 };
+    JobCounter counter;
+    Job_Run(Job_FibEntry, &a, &counter);
+    Job_FibEntry(&b);
+    Job_Wait(&counter);
+    task->Result = a.Result + b.Result;
+}
+
+static void Job_BenchFibSetup(int count, const char*)
+{
+    g_BenchFibN = count;
+}
+
+static void Job_BenchFibFrame(int)
+{
+    FibTask task = { g_BenchFibN, 0 };
+    {
+        BenchZone z("JobFib");
+        Job_FibEntry(&task);
+    }
+    long long serial;
+    {
+        BenchZone z("JobFibSerial");
+        serial = Job_FibSerial(g_BenchFibN);
+    }
+    if (serial != task.Result) AddMessage("job_fib: result mismatch");
+}
+
+static void Job_BenchForKernel(int begin, int end, void*)
+{
+    float* d = g_BenchForData.data();
+    for (int i = begin; i < end; ++i)
+        d[i] = sqrtf(d[i] * d[i] + 1.0f) * 0.5f + sinf((float)i) * 0.25f;
+}
+
+static void Job_BenchForSetup(int count, const char*)
+{
+    g_BenchForData.assign(count > 0 ? count : 0, 1.0f);
+}
+
+static void Job_BenchForFrame(int)
+{
+    int n = (int)g_BenchForData.size();
+    {
+        BenchZone z("JobParallelFor");
+        Job_ParallelFor(0, n, 0, Job_BenchForKernel, nullptr);
+    }
+    {
+        BenchZone z("JobSerialFor");
+        Job_BenchForKernel(0, n, nullptr);
+    }
+}
+
+void Job_RegisterBench()
+{
+    Bench_Register("job_fib", Job_BenchFibSetup, Job_BenchFibFrame);
+    Bench_Register("job_parallel_for", Job_BenchForSetup, Job_BenchForFrame);
+}
@@ -0,0 +1,46 @@
+﻿// JobSystem.h
+// ワークスティーリング型のジョブシステム
+// |  スレッドごとに Chase-Lev 両端キューを持ち、空いたワーカーは他から盗む
+// |  完了待ちは JobCounter（0 になるまで待つ）。待っている間も他のジョブを実行する
+// |  Job_RunMainThread のジョブはメインスレッドでのみ実行（D3D への登録など）
+// |  ジョブ本体は関数ポインタ + void*（実行中のメモリ確保なし）
+// __________________________________________
+
+#pragma once
+
+#include <atomic>
+
+// 完了待ち用カウンタ（投入時 +1、完了時 -1）
+struct JobCounter
+{
+    std::atomic<int> Value{ 0 };
+};
+
+typedef void (*JobFn)(void* data);
+typedef void (*JobRangeFn)(int begin, int end, void* data);
+
+//|| API ||___________________________
+void Job_Init(int workerCount = -1);                                        //-1: 論理コア数 - 1
+void Job_Shutdown();
+int  Job_GetWorkerCount();                                                  //メインスレッドを除くワーカー数
+int  Job_GetThreadIndex();                                                  //0: メイン / 1〜: ワーカー / -1: 対象外のスレッド
+bool Job_IsMainThread();
+
+void Job_Run(JobFn fn, void* data, JobCounter* counter);                    //任意のスレッドで実行
+void Job_RunMainThread(JobFn fn, void* data, JobCounter* counter);          //メインスレッドで実行
+void Job_Wait(JobCounter* counter);                                         //counter が 0 になるまで他のジョブを手伝いながら待つ
+void Job_PumpMainThread();                                                  //溜まっているメインスレッド用ジョブを実行
+
+// [begin, end) を grain 以下に分割して並列実行（戻った時点で全て完了）
+void Job_ParallelFor(int begin, int end, int grain, JobRangeFn fn, void* data);
+
+// ラムダ用（キャプチャ付きでも可。呼び出し中のみ有効）
+template<class F>
+void Job_ParallelFor(int begin, int end, int grain, const F& f)
+{
+    Job_ParallelFor(begin, end, grain,
+        [](int b, int e, void* d) { (*static_cast<const F*>(d))(b, e); },
+        (void*)&f);
+}
+
+void Job_RegisterBench();                                                   //BenchRunner に job_fib / job_parallel_for を登録
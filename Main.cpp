@@ -15,9 +15,13 @@
 #include <sstream>
 
 #include "Main.h"
+#include "RenderBackendD3D11.h"
 
 #include "Manager.h"
 #include "CoreScene.h"
+#include "GameLoop.h"
+#include "BenchRunner.h"
+#include "JobSystem.h"
 
  //
 //ライブラリ_______________
@@ -38,15 +42,10 @@ ID3D11DepthStencilView* g_pDepthStencilView = nullptr;
 int ScreenWidth = 800;
 int ScreenHeight = 600;
 
-ID3D11Device* GetDevice() { return g_pd3dDevice; }
-ID3D11DeviceContext* GetContext() { return g_pImmediateContext; }
-IDXGISwapChain* GetSwapChain() { return g_pSwapChain; }
-ID3D11RenderTargetView* GetRenderTargetView() { return g_pRenderTargetView; }
-ID3D11Texture2D* GetDepthStencil() { return g_pTexture2D; }
-ID3D11DepthStencilView* GetDepthStencilView() { return g_pDepthStencilView; }
-
-int GetScreenWidth() { return ScreenWidth; }
-int GetScreenHeight() { return ScreenHeight; }
+// スワップチェーンと描画先はウィンドウを持つこのファイルだけで使う（エンジン側は Main.h の GetDevice / GetContext）
+static IDXGISwapChain* GetSwapChain() { return g_pSwapChain; }
+static ID3D11RenderTargetView* GetRenderTargetView() { return g_pRenderTargetView; }
+static ID3D11DepthStencilView* GetDepthStencilView() { return g_pDepthStencilView; }
 
 // ウィンドウプロシージャ
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
@@ -78,6 +77,10 @@ HRESULT InitD3D(HWND hWnd) {
     );
     if (FAILED(hr)) return hr;
 
+    // 描画バックエンドに実体を設定
+    RenderBackend_InitD3D11(g_pd3dDevice, g_pImmediateContext);
+    SetScreenSize(ScreenWidth, ScreenHeight);
+
     // ================================
     // バックバッファ取得
     // ================================
@@ -140,13 +143,34 @@ void ReleaseD3D()
 {
     if (g_pRenderTargetView) g_pRenderTargetView->Release();
     if (g_pSwapChain) g_pSwapChain->Release();
+    RenderBackend_Shutdown();
     if (g_pImmediateContext) g_pImmediateContext->Release();
     if (g_pd3dDevice) g_pd3dDevice->Release();
 }
 
+// 固定ステップ1回分の更新
+static void MainStep(double, void*)
+{
+    CoreSceneUpdate();
+    UpdateDo();
+}
+
+// 1フレーム分の描画
+static void MainRender(double, void*)
+{
+    const float clearColor[4] = { 0.1f, 0.2f, 0.3f, 1.0f };
+    g_pImmediateContext->ClearRenderTargetView(GetRenderTargetView(), clearColor);
+    g_pImmediateContext->ClearDepthStencilView(GetDepthStencilView(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+
+    CoreSceneDraw();
+    DrawDo();
+}
+
 //Main
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow) 
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR lpCmdLine, int nCmdShow) 
 {
+    // ベンチマーク（ウィンドウ / GPU 無しで実行して終了）
+    if (lpCmdLine && strstr(lpCmdLine, "--bench")) return Bench_Main(lpCmdLine);
 
     MSG msg{};
 
@@ -186,9 +210,15 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow)
 
     InitDo();
     CoreStartUp();
+
+    // 更新は 60Hz 固定（--uncapped で垂直同期なしの計測モード）
+    GameLoop_Init(1.0 / 60.0, 5);
+    if (lpCmdLine && strstr(lpCmdLine, "--uncapped")) GameLoop_SetUncapped(true);
     // 主ループ
     bool running = true;
     while (running) {
+        LIA_PROFILE_FRAME_BEGIN();
+
         // メッセージ処理（ノンブロッキング）
         while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
             if (msg.message == WM_QUIT) {
@@ -199,20 +229,27 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow)
         }
         if (!running) break;
 
-        // --- レンダリング（ここに描画処理を入れる） ---
-        const float clearColor[4] = { 0.1f, 0.2f, 0.3f, 1.0f };
-        GetContext()->ClearRenderTargetView(GetRenderTargetView(), clearColor);
-        GetContext()->ClearDepthStencilView(GetDepthStencilView(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-        
-        CoreSceneUpdate();
-        CoreSceneDraw();
-        
-        UpdateDo();
-        DrawDo();
+        // --- 更新（固定ステップ）＆ レンダリング ---
+        GameLoop_Tick(MainStep, MainRender, nullptr);
+        LIA_PROFILE_CPU_END();  // ここまでを CPU 時間とする（Present の待ちを含めない）
         // swap
-        GetSwapChain()->Present(1, 0);
+        {
+            LIA_PROFILE_SCOPE("Present");
+            GetSwapChain()->Present(GameLoop_GetPresentInterval(), 0);
+        }
+        RenderStats_EndFrame();
+        FrameArena_Reset();     // このフレームの一時領域を捨てる
         // -----------------------------------------------
 
+        LIA_PROFILE_FRAME_END();
+#if defined(LIA_PROFILE)
+        // F12 で直近フレームのタイムラインを書き出し
+        static bool dumpKeyPrev = false;
+        bool dumpKey = (GetAsyncKeyState(VK_F12) & 0x8000) != 0;
+        if (dumpKey && !dumpKeyPrev) Profile_DumpChromeTrace("saved/profile/trace.json");
+        dumpKeyPrev = dumpKey;
+#endif
+
         // FPS カウント
         ++frameCount;
         UINT64 now = GetTickCount64();
@@ -223,8 +260,12 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow)
 
             // タイトル更新
             wchar_t title[256];
-            swprintf_s(title, L"Tick64 FPS Sample - FPS: %.2f (%u frames / %.2f s)", fps, frameCount, seconds);
+            swprintf_s(title, L"Tick64 FPS Sample - FPS: %.2f (%u frames / %.2f s) CPU: %.2f ms Frame: avg %.3f / max %.3f ms%s",
+                fps, frameCount, seconds, Profile_GetLastFrameMs(),
+                GameLoop_GetAverageFrameSeconds() * 1000.0, GameLoop_GetMaxFrameSeconds() * 1000.0,
+                GameLoop_IsUncapped() ? L" [Uncapped]" : L"");
             SetWindowTextW(g_hwnd, title);
+            GameLoop_ResetFrameStats();
 
             // リセット
             lastTitleUpdateTick = now;
@@ -236,6 +277,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow)
     }
 
     // 終了処理
+    Job_Shutdown();
     ReleaseD3D();
     UnregisterClass(wc.lpszClassName, hInstance);
 }
@@ -1,12 +1,11 @@
-#pragma once
+﻿#pragma once
 
-#include <d3d11.h>
+#include "RenderDevice.h"
 
-ID3D11Device* GetDevice();
-ID3D11DeviceContext* GetContext();
-IDXGISwapChain* GetSwapChain();
-ID3D11RenderTargetView* GetRenderTargetView();
-ID3D11Texture2D* GetDepthStencil();
-ID3D11DepthStencilView* GetDepthStencilView();
+// 現在の描画バックエンドと描画先の大きさ（RenderManager.cpp）
+// |  スワップチェーン / 描画先のビューはウィンドウを持つ Main.cpp の中だけで使う
+RenderDevice* GetDevice();
+RenderContext* GetContext();
 int GetScreenWidth();
-int GetScreenHeight();
\ No newline at end of file
+int GetScreenHeight();
+void SetScreenSize(int width, int height);
\ No newline at end of file
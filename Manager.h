@@ -9,11 +9,28 @@
 // |  InputManager.cpp
 // |  EffectManager.cpp
 // |  ShaderManager.cpp
+// |  ProfileManager.cpp
+// |  RenderManager.cpp
+// |  JobManager.cpp
+// |  PrefabManager.cpp
+// |  TransformManager.cpp
+// |  CullingManager.cpp
+// |  SpatialManager.cpp
+// |  CollisionManager.cpp
+// |  RaycastManager.cpp
+// |  ScreenGridManager.cpp
+// |  AnimationManager.cpp
+// |  TweenManager.cpp
+// |  ReelManager.cpp
 // __________________________________________
 
 #pragma once
 
 // Include________________________
+#include "Profiler.h"
+#include "SystemAPI.h"
+#include "MathAPI.h"
+#include "RenderDevice.h"
 #include "Grid.h"
 #include "Object.h"
 #include "Component.h"
@@ -21,13 +38,6 @@
 #include <string>
 #include <vector>
 
-#include <d3d11.h>
-#include <DirectXMath.h>
-#include <d3dcompiler.h>
-#include <DirectXMathMatrix.inl>
-#include <wrl.h>
-
-#pragma comment (lib, "d3dcompiler.lib")
 
 // Define_________________________
 
@@ -44,6 +54,7 @@ typedef struct { int*   data; size_t size; size_t capacity; } IntVector;
 typedef struct { float* data; size_t size; size_t capacity; } FloatVector;
 typedef struct { bool*  data; size_t size; size_t capacity; } BoolVector;
 typedef struct { char** keys; size_t size; size_t capacity; } KeyMap;
+typedef struct { DirectX::XMMATRIX* data; size_t size; size_t capacity; } MatrixVector;   //16 oCgE
 // ObjectIndex\
 typedef struct {
 	int CameraIndex;        //Camera_________
@@ -75,7 +86,9 @@ enum class IndexType {
 	GridPolygon,
 	GridSphere,
 	GridCapsule,
-	Effect
+	Effect,
+	SpriteBox,
+	SpriteCylinder
 };
 enum LightType
 {
@@ -83,6 +96,12 @@ enum LightType
     SpotLight,
     DirectionalLight,
 };
+enum ColliderShape
+{
+    ColliderShape_Box,          //Size: eӂ̒
+    ColliderShape_Sphere,       //Size.X: a
+    ColliderShape_Capsule,      //Size.X: a / Size.Y: [̋̒SԂ̒i[J Y j
+};
 enum SoundEffect
 {
     Delay,
@@ -106,6 +125,58 @@ struct ModelVertex
     XMFLOAT2 uv;
     XMFLOAT3 normal;
 };
+//XLjOp_iModelVertex ƓсB{[̖f͎Ȃj
+struct ModelSkinVertex
+{
+    unsigned short bone[4];     //{[ԍiModelSkeleton::BoneNode ̓Yj
+    float weight[4];            //v 1iǂ̃{[ɂtĂȂ_͑S 0j
+};
+//iiFBX ̃m[hKwBe͕KqOɕԁj
+struct ModelSkeleton
+{
+    std::vector<std::string> NodeName;
+    std::vector<int> Parent;                //-1: [g
+    std::vector<XMFLOAT3> BindPos;          //piȇ΁j
+    std::vector<XMFLOAT4> BindRot;          //NH[^jI
+    std::vector<XMFLOAT3> BindScale;
+    std::vector<int> BoneNode;              //{[ԍ  m[h
+    std::vector<XMFLOAT4X4> BoneOffset;     //bV  {[
+    XMFLOAT4X4 GlobalInverse;               //[g̋ts
+};
+//Aj[ṼL[im[h1BԂ͕bŏj
+struct AnimTrack
+{
+    std::string NodeName;
+    std::vector<float> PosTime, RotTime, ScaleTime;
+    std::vector<XMFLOAT3> Pos;
+    std::vector<XMFLOAT4> Rot;
+    std::vector<XMFLOAT3> Scale;
+};
+struct AnimClip
+{
+    float Duration;                         //b
+    std::vector<AnimTrack> Tracks;
+};
+//kς݂̃L[iAddAnimClip BĐ͂炾gj
+struct AnimPackedChannel
+{
+    std::vector<unsigned short> Time;       //Duration  65535 
+    std::vector<unsigned short> Value;      //1L[ 3 iʒu / g: Min + q * StepA]: smallest-threej
+    XMFLOAT3 Min;
+    XMFLOAT3 Step;
+};
+struct AnimPackedTrack
+{
+    std::string NodeName;
+    AnimPackedChannel Pos, Rot, Scale;
+};
+struct AnimPackedClip
+{
+    float Duration;                         //b
+    std::vector<AnimPackedTrack> Tracks;
+    size_t RawKeys, PackedKeys;             //L[팸̑O
+    size_t RawBytes, PackedBytes;           //L[̃f[^ʁiOȂǂ͊܂܂Ȃj
+};
 
 //-----------------------------------------
 // Vec4Ǘpf[^v[\
@@ -127,6 +198,7 @@ struct ObjectDataPool {
     Vec4Vector SpriteScreenSize;
     Vec4Vector SpriteScreenColor;
     IntVector  SpriteScreenAngle;
+    BoolVector SpriteScreenOpaque;  // si UI Bj
     //SpriteBox
     Vec4Vector SpriteBoxPos;
     Vec4Vector SpriteBoxSize;
@@ -142,10 +214,13 @@ struct ObjectDataPool {
     Vec4Vector ModelPos;
     Vec4Vector ModelSize;
     Vec4Vector ModelAngle;
+    // EffectiBq EffectManager j
+    Vec4Vector EffectPos;
     // BoxCollider
     Vec4Vector BoxColliderPos;
     Vec4Vector BoxColliderSize;
     Vec4Vector BoxColliderAngle;
+    IntVector  BoxColliderShape;    // ColliderShape
     // Grid(Box / Polygon)
     Vec4Vector GridBoxPos;
     Vec4Vector GridBoxSize;
@@ -155,6 +230,24 @@ struct ObjectDataPool {
     Vec4Vector GridPolygonSize;
     Vec4Vector GridPolygonAngle;
     Vec4Vector GridPolygonColor;
+    // [hsi]Eړ̂݁BTransformManager ύX̂sj
+    MatrixVector SpriteWorldMatrix;
+    MatrixVector SpriteBoxMatrix;
+    MatrixVector SpriteCylinderMatrix;
+    MatrixVector GridBoxMatrix;
+    MatrixVector GridPolygonMatrix;
+    MatrixVector ModelMatrix;
+    // tOifalse: Remove ς݁AXbg͍ėp҂j
+    BoolVector CameraAlive;
+    BoolVector SpriteWorldAlive;
+    BoolVector SpriteScreenAlive;
+    BoolVector SpriteBoxAlive;
+    BoolVector SpriteCylinderAlive;
+    BoolVector GridBoxAlive;
+    BoolVector GridPolygonAlive;
+    BoolVector BoxColliderAlive;
+    BoolVector ModelAlive;
+    BoolVector EffectAlive;
     // Int / Bool / Char Vec
     IntVector GridPolygonSides;
     CharVector TexturePath;
@@ -165,6 +258,10 @@ struct ObjectDataPool {
     // KeyMaps
     KeyMap CameraMap;
     KeyMap ModelMap;
+    KeyMap ModelMotionMap;          // SetModelMotion ̃[Viݒ͋j
+    IntVector ModelMotionBlend;     // ؂ւɂt[
+    KeyMap EffectMap;
+    KeyMap EffectTexturePathMap;
     KeyMap TextureMap;
     KeyMap SpriteWorldMap;
     KeyMap SpriteScreenMap;
@@ -199,6 +296,7 @@ void InitDo();
 void UpdateDo();
 void DrawDo();
 void ReleaseDo();
+void CreateObject();                                                                //v[ɒǉꂽIuWFNg̃R|[lgiUpdateDoj
 //|| Camera ||_______________________
 void AddCamera(const char* name);                                                   //J̒ǉ
 void SetCameraPos(const char* name, float x, float y, float z);                     //J̍Wݒ
@@ -206,6 +304,7 @@ void SetCameraLook(const char* name, float x, float y, float z);
 void UseCameraSet(const char* name);                                                //gpJ̐ݒ
 int GetUseCamera();                                                                 //gpJ̃CfbNX擾
 void SetUseCamera(int index);                                                       //gpJCfbNXŎw
+void RemoveCamera(const char* name);                                                //J̍폜
 //void SettingCameraOnce();
 //|| SpriteWorld ||__________________
 void AddSpriteWorld(const char* name, const char* pathName);                        //|ǉeNX`w
@@ -213,12 +312,15 @@ void SetSpriteWorldPos(const char* name, float x, float y, float z);
 void SetSpriteWorldSize(const char* name, float x, float y, float z);               //|TCYݒ
 void SetSpriteWorldAngle(const char* name, float x, float y, float z);              //|pxݒ
 void SetSpriteWorldColor(const char* name, float r, float g, float b, float a);     //|ZFݒ
+void RemoveSpriteWorld(const char* name);                                           //|폜
 //|| SpriteScreen ||_________________                                               //
 void AddSpriteScreen(const char* name, const char* pathName);                       //UI̒ǉeNX`w
 void SetSpriteScreenPos(const char* name, float x, float y);                        //UIWݒ
 void SetSpriteScreenSize(const char* name, float x, float y);                       //UITCYݒ
 void SetSpriteScreenAngle(const char* name, float angle);                           //UIpxݒ
 void SetSpriteScreenColor(const char* name, float r, float g, float b, float a);    //UIFݒ
+void SetSpriteScreenOpaque(const char* name, bool opaque);                          //UIsݒ聦UI`悵Ȃ
+void RemoveSpriteScreen(const char* name);                                          //UI폜
 //|| SpriteBox ||____________________                                               //
 void AddSpriteBox(const char* name, const char* pathName);                          //`̒ǉeNX`w聦S
 void SetSpriteBoxPos(const char* name, float x, float y, float z);                  //`̍Wݒ
@@ -232,6 +334,7 @@ void SetSpriteBoxTextureRear(const char* name, const char* pathName);
 void SetSpriteBoxTextureLeft(const char* name, const char* pathName);               //`̃eNX`ݒ荶
 void SetSpriteBoxTextureRight(const char* name, const char* pathName);              //`̃eNX`ݒE
 void SetSpriteBoxTexture(const char* name, const char* pathName);                   //`̃eNX`ݒS
+void RemoveSpriteBox(const char* name);                                             //`̍폜
 //|| SpriteCylinder ||_______________                                               //
 void AddSpriteCylinder(const char* name, const char* pathName);                     //~̒ǉeNX`w
 void SetSpriteCylinderPos(const char* name, float x, float y, float z);             //~̍Wݒ
@@ -242,6 +345,7 @@ void SetSpriteCylinderSegment(const char* name, int sengment);
 void SetSpriteCylinderTextureTop(const char* name, const char* pathName);           //~̃eNX`ݒ
 void SetSpriteCylinderTextureBottom(const char* name, const char* pathName);        //~̃eNX`ݒ
 void SetSpriteCylinderTextureSide(const char* name, const char* pathName);          //~̃eNX`ݒ
+void RemoveSpriteCylinder(const char* name);                                        //~̍폜
 //|| Grid   ||_______________________                                               //
 // Grid Line                                                                        //
 void AddGridLine(const char* name);                                                 //Obh̒ǉ
@@ -252,6 +356,7 @@ void AddGridBox(const char* name);
 void SetGridBoxPos(const char* name, float x, float y, float z);                    //`Obh̍Wݒ
 void SetGridBoxSize(const char* name, float x, float y, float z);                   //`Obh̃TCYݒ
 void SetGridBoxColor(const char* name, float R, float G, float B, float A);         //`Obh̐Fݒ
+void RemoveGridBox(const char* name);                                               //`Obh̍폜
 // Grid Polygon                                                                     //
 void AddGridPolygon(const char* name);                                              //pObh̒ǉ
 void SetGridPolygonPos(const char* name, float x, float y, float z);                //pObh̍Wݒ
@@ -259,6 +364,7 @@ void SetGridPolygonSize(const char* name, float x, float y, float z);
 void SetGridPolygonAngle(const char* name, float x, float y, float z);              //pObh̊pxݒ
 void SetGridPolygonColor(const char* name, float R, float G, float B, float A);     //pObh̐Fݒ
 void SetGridPolygonSides(const char* name, int sides);                              //pObh̊pݒ
+void RemoveGridPolygon(const char* name);                                           //pObh̍폜
 //|| Sound ||_______________________ 
 //World
 void AddSpeaker(const char* name, const char* pathName);                            //Xs[J[̒ǉw
@@ -287,9 +393,36 @@ void SetModelPos(const char* name, float x, float y, float z);
 void SetModelSize(const char* name, float x, float y, float z);                     //f̃TCYݒ
 void SetModelAngle(const char* name, float x, float y, float z);                    //f̊pxݒ
 void SetModelMotion(const char* name, const char* pathName, int Attack);            //f̃[Vݒڍsxݒ
+void RemoveModel(const char* name);                                                 //f̍폜
+//|| Effect ||________________________
+void AddEffect(const char* name, const char* texturePath);                          //p[eBN̔̒ǉiV[PʁBݒ EffectManagerj
+void RemoveEffect(const char* name);                                                //̍폜iqj
+void SetEffectPos(const char* name, float x, float y, float z);                     //̍Wݒio̗q͓Ȃj
+//|| Collider ||______________________                                               //
+void AddBoxCollider(const char* name);                                              //̓蔻̒ǉ
+void AddSphereCollider(const char* name);                                           //̓蔻̒ǉ
+void AddCapsuleCollider(const char* name);                                          //JvZ̓蔻̒ǉ
+void SetColliderPos(const char* name, float x, float y, float z);                   //蔻̍Wݒ
+void SetColliderSize(const char* name, float x, float y, float z);                  //蔻̃TCYݒ聦`Ƃ̈Ӗ ColliderShape
+void SetColliderAngle(const char* name, float x, float y, float z);                 //蔻̊pxݒ
+void RemoveCollider(const char* name);                                              //蔻̍폜
 
 ///////////////////////////////////
 
+// CfbNXw̍폜iDeleteScene pjBrelease: R|[lg GPU \[X
+void RemoveObjectAt(IndexType type, int index, bool release);
+bool IsObjectAlive(IndexType type, int index);
+int  GetObjectIndexByName(IndexType type, const char* name);        //OCfbNXi -1j
+// V[̓ǂݍ / pBRelease  Restore  Init ƃeNX`̍Đݒs
+void ReleaseObjectResources(IndexType type, int index);
+void RestoreObjectResources(IndexType type, int index);
+// [begin, end) 𖖔֕iCopyScene pAO prefix + ̖OjB߂l: ̐擪
+int CopyObjectRange(IndexType type, int begin, int end, const char* prefix);
+// count smہi󂫃XbgDAc͖ֈꊇǉjBoutIndex ɍsԍA߂l: mې
+int AcquireObjectRows(IndexType type, int count, int* outIndex);
+// [begin, end) ̐Ăs𖖔ֈڂi̍s͍폜ς݂ɂȂjB߂l: ړ̐擪
+int MoveObjectRange(IndexType type, int begin, int end);
+
 void OutObjectIndex(ObjectIndex* out);
 ObjectIndex* GetObjectIndex();
 
@@ -313,14 +446,275 @@ void UpdateScene();
 void DrawScene();
 const char* GetCurrentSceneName();
 void NotifyAddObject(IndexType type);
+bool GetActiveSceneRange(IndexType type, int* begin, int* end);    //ǉ̃V[͈̔́i falsej
+bool MoveActiveSceneRangeToTail(IndexType type);                    //p͈͂܂疖ֈڂiObjectManager pj
+bool GetSceneRange(const char* name, IndexType type, int* begin, int* end);    //V[ name ł͈̔́i falsej
+// Xg[~O
+// |  V[͖ǂݍ݂ōAChangeScenei܂ PreloadScenejŕKvȃAZbgǂݍ
+// |  }jtFXg̓IuWFNgǉ̃eNX`玩ōiAddSceneAsset Œǉj
+void PreloadScene(const char* name);                                //AZbg̔񓯊ǂݍ݂Jn
+void UnloadScene(const char* name);                                 //AZbgƃR|[lg GPU \[Xif[^͎cj
+bool IsSceneLoaded(const char* name);
+void ChangeSceneWhenLoaded(const char* name);                       //ǂݍ݊ɐ؂ւi܂ō̃V[`j
+void AddSceneAsset(const char* scene, const char* path);            //}jtFXg֒ǉ
+void NotifySceneAsset(const char* path);                            //ǉV[̃}jtFXg֒ǉiObjectManager pj
+bool IsSceneSlotLoaded(IndexType type, int index);                  //Xbg܂ރV[ǂݍݍς݂
+
+  ///////////////////
+ // PrefabManager //
+///////////////////
+// CX^XƂ̂炵iPos ͉ZAAngle  Prefab ̔zuƉ]Ċepx։Zj
+typedef struct { Vec4 Pos; Vec4 Angle; } PrefabTransform;
+
+void CreatePrefab(const char* prefabName);                                          // Prefab 쐬
+void AddPrefabObject(const char* prefabName, IndexType type, const char* objectName);   //IuWFNg̍̒lT
+void CreatePrefabFromScene(const char* prefabName, const char* sceneName);          //V[̑SIuWFNg쐬
+int  GetPrefabObjectCount(const char* prefabName);
+int  InstantiatePrefab(const char* prefabName, int count,
+    const PrefabTransform* transforms, const char* namePrefix);                     //count ܂Ƃ߂ĒǉiO: prefix + ԍ + "/" + ̖Oj
+void DeletePrefab(const char* prefabName);
+void ReleasePrefabs();                                                              //S Prefab jiReleaseDo j
+
+  //////////////////////
+ // TransformManager //
+//////////////////////
+// Ώ: SpriteWorld / SpriteBox / SpriteCylinder / GridBox / GridPolygon / Model
+// eIuWFNg Pos / Angle ͐ȇΒliSize ͎q֓`Ȃj
+void SetParent(IndexType type, const char* name, IndexType parentType, const char* parentName);   //parentName  NULL ȂeO
+void SetParentAt(IndexType type, int index, IndexType parentType, int parentIndex);              //parentIndex < 0 ŐeO
+int  GetParentAt(IndexType type, int index, IndexType* parentType);                             //ẽCfbNXi -1j
+void UpdateTransforms();                                                    //ύX̂؂̃[hsvZiDrawScene 疈t[j
+const DirectX::XMMATRIX& GetWorldMatrix(IndexType type, int index);        //]Eړ̃[hsiSize ͊܂܂Ȃj
+bool IsTransformUpdated(IndexType type, int index);                         //O UpdateTransforms ŌvZ
+void Transform_MarkDirty(IndexType type, int index);                        //Pool  Pos / Angle 𒼐ڏƂɌĂ
+void Transform_OnRemove(IndexType type, int index);                         //폜iObjectManager pj
+void Transform_OnMove(IndexType type, int from, int to);                    //s̈ړiObjectManager pj
+void ReleaseTransforms();
+
+  ////////////////////
+ // CullingManager //
+////////////////////
+// Ώ: TransformManager Ɠ 3D IuWFNgBE̓[hs Size iModel ̓bV AABB * Sizej
+void UpdateBounds();                                                        //ύX̂s̋E蒼iUpdateTransforms ̌ɖt[j
+void SetCullingFrustum(const DirectX::XMMATRIX& viewProj);                  //ɎgiĂ鐔 / O̐ 0 ɖ߂j
+int  CullRange(IndexType type, int begin, int end);                         //[begin, end) 𔻒i߂l͌Ă鐔j
+bool IsObjectVisible(IndexType type, int index);                            //O CullRange Ŏ̓
+bool IsObjectNewlyVisible(IndexType type, int index);                       //O͊Oō͓
+bool IsBoundsUpdated(IndexType type, int index);                            //O UpdateBounds ō蒼
+bool GetObjectBounds(IndexType type, int index, Vec4* sphere, Vec4* extent);   //sphere: S + a / extent: [h AABB ̔a
+void GetCullingStats(int* visible, int* culled);                            //t[̌Ă鐔 / O̐
+void SetCullingEnabled(bool enable);                                        //false: Ă̂͑SČĂ鈵
+bool IsCullingEnabled();
+void SetCullingUseTree(bool enable);                                        //true: S SIMD ł͂Ȃ SpatialManager ̃c[Ŕ
+void GetFrustumPlanes(const DirectX::XMMATRIX& viewProj, DirectX::XMFLOAT4 planes[6]); //K6ʁij
+void ReleaseCulling();
+
+  ////////////////////
+ // SpatialManager //
+////////////////////
+// I AABB c[iΏۂ CullingManager ƓBt͋E菭傫j
+// ₢킹̌ʂ out ̖ɒǉA߂l͒ǉ
+typedef struct { IndexType Type; int Index; float Distance; } SpatialHit;  //Distance: C͔ɓ鋗 / ͔܂ł̋
+void UpdateSpatialIndex();                                                  //E͂ݏos꒼iUpdateBounds ̌ɖt[j
+int  QuerySpatialAABB(const Vec4& min, const Vec4& max, std::vector<SpatialHit>* out);
+int  QuerySpatialSphere(const Vec4& sphere, std::vector<SpatialHit>* out);  //sphere: S + a(W)
+int  QuerySpatialFrustum(const DirectX::XMMATRIX& viewProj, std::vector<SpatialHit>* out);
+int  QuerySpatialRay(const Vec4& origin, const Vec4& dir, float maxDist, std::vector<SpatialHit>* out);  //߂
+int  GetSpatialObjectCount();
+int  GetSpatialTreeHeight();
+void ReleaseSpatialIndex();
+
+  //////////////////////
+ // CollisionManager //
+//////////////////////
+// Ώ: CollideriPool  BoxCollider jBL X  Sweep and PruneAڍׂ͌`̑gƂ̔
+// ڐG͖t[蒼1{̔ziA < BAg1񂾂j
+typedef struct { int A; int B; Vec4 Normal; Vec4 Point; } CollisionContact;   //Normal: A  B AW ͂߂荞ݗ / Point: ڐG_
+void UpdateCollision(int begin, int end);                                   //[begin, end) ̐ڐG蒼iUpdateScene 疈t[j
+const CollisionContact* GetCollisionContacts(int* count);                   //O UpdateCollision ̐ڐG
+int  GetCollisionPairCount();                                               //O̍L攻Ŏcg̐
+void ReleaseCollision();
+
+  ////////////////////
+ // RaycastManager //
+////////////////////
+// ݂̃V[ւ̃Ci SpatialManager ̃c[Azu͒O DrawScene ̎_j
+enum RaycastMask
+{
+    RaycastMask_SpriteWorld     = 1 << 0,   //
+    RaycastMask_SpriteBox       = 1 << 1,   //
+    RaycastMask_SpriteCylinder  = 1 << 2,   //Wt̉~
+    RaycastMask_GridBox         = 1 << 3,   //
+    RaycastMask_Model           = 1 << 4,   //Op`iǂݍݎ BVHj
+    RaycastMask_All             = 0x1F,
+};
+typedef struct { IndexType Type; int Index; float Distance; Vec4 Point; Vec4 Normal; } RaycastHit;   //Normal: ʂ̊O
+bool RaycastScene(const Vec4& origin, const Vec4& dir, unsigned mask, RaycastHit* hit, float maxDist = 1000.0f);  //ԋ߂idir ͐KȂĂ悢j
+bool ScreenPointToRay(const char* camera, float x, float y, Vec4* origin, Vec4* dir);  //x, y: ʂ̃sNZi㌴_j/ camera: nullptr Ŏgp̃J
+
+  ///////////////////////
+ // ScreenGridManager //
+///////////////////////
+// SpriteScreen  2D ԃnbVi800x600 ڂɕAڂƂɏdȂsj
+// ₢킹݂͌̃V[̐Ăŝ݁Aʂ͕`揇iقǎOj out ̖ɒǉ
+void ScreenGrid_MarkDirty(IndexType type, int index);                       //Pool  Pos / Size 𒼐ڏƂ / 폜ɌĂ
+void UpdateScreenGrid();                                                    //ύX̂sڂ꒼i₢킹̑OɎŌĂԁj
+int  QueryScreenPoint(float x, float y, std::vector<int>* out);             //_܂ލs
+int  QueryScreenRect(float x0, float y0, float x1, float y1, std::vector<int>* out);  //`ƏdȂs
+int  PickSpriteScreen(float x, float y);                                    //_܂ވԎO̍si -1j
+int  CullScreenRange(int begin, int end);                                   //[begin, end) ̉ʊO / O̕s UI ɉBꂽs𔻒i߂l͕`悷鐔j
+bool IsScreenVisible(int index);                                            //O CullScreenRange ŕ`悷s
+void GetScreenCullStats(int* visible, int* culled);                         //O CullScreenRange ̕`悷鐔 / Ȃ
+void ReleaseScreenGrid();
+
+  //////////////////////
+ // AnimationManager //
+//////////////////////
+// i / Nbv AssetManager fǂݍݎɍBĐԁiԁEJ[\Eԁj Model 
+// p̓m[hƂ̃[J ʒu / ] / giAnimPosej
+#define ANIM_GPU_BONE_MAX 128
+void Anim_BindPose(const ModelSkeleton* skel, AnimPose* pose);              //pŖ߂
+void Anim_MapTracks(const ModelSkeleton* skel, const AnimPackedClip* clip, std::vector<int>* trackNode);  //gbN  m[hiOőΉA -1j
+void Anim_Sample(const AnimPackedClip* clip, const std::vector<int>& trackNode, float time, int* cursor, AnimPose* pose);  //cursor: gbN * 3iÕL[i߂j
+void Anim_Blend(AnimPose* dst, const AnimPose& src, float t);               //dst  src  t 񂹂
+void Anim_Palette(const ModelSkeleton* skel, const AnimPose& pose, XMMATRIX* global, XMMATRIX* palette);  //global: m[h / palette: {[
+void Anim_SkinCPU(const ModelVertex* src, const ModelSkinVertex* skin, int count, const XMMATRIX* palette, ModelVertex* dst);
+void SetModelSkinningGPU(bool enable);                                      //true: {[ ANIM_GPU_BONE_MAX ȉ̃f VS ŃXLjO
+bool IsModelSkinningGPU();
+//|| Nbv̋LLbV ||________
+// L[덷ŊԈA] smallest-threei48 bitjAʒu / g̓gbNƂ͈̔͂ 16 bit ɗʎq
+// ÕNbv1îōĐĂȂj
+const AnimPackedClip* AddAnimClip(const char* name, AnimClip&& clip);     //kēo^io^ς݂ȂԂj
+const AnimPackedClip* GetAnimClip(const char* name);                      // nullptr
+void SetAnimClipTolerance(float pos, float rot, float scale);              //L[팸̋e덷irot ̓WAjBȍ~̓o^Ɍ
+void GetAnimClipMemory(int* count, size_t* rawBytes, size_t* packedBytes); //o^ς݃Nbv̍v
+void ReleaseAnimClips();
+
+  //////////////////
+ // TweenManager //
+//////////////////
+// Pool ̗iPos / Angle / Size / ColorjԂŕԂBUpdateTweensiUpdateDo 疈t[jł܂Ƃ߂ĕ]ď
+// ߂l̓nhis -1jBI / ~߂ Tween ̃nh͖ɂȂ
+enum TweenProp
+{
+    TweenProp_Pos,
+    TweenProp_Angle,
+    TweenProp_Size,     //SpriteScreen ͕E
+    TweenProp_Color,    //Camera / Model / BoxCollider ͖
+};
+enum TweenEase
+{
+    TweenEase_Linear,
+    TweenEase_InQuad,
+    TweenEase_OutQuad,
+    TweenEase_InOutQuad,
+    TweenEase_InCubic,
+    TweenEase_OutCubic,
+    TweenEase_InOutCubic,
+    TweenEase_InOutSine,
+    TweenEase_OutBack,      //s߂Ė߂
+    TweenEase_OutBounce,
+};
+enum TweenEvent
+{
+    TweenEvent_Loop,        //1iŌ̎ Complete ̂݁j
+    TweenEvent_Complete,
+};
+typedef void (*TweenEventFn)(int tween, int event, void* user);
+int  AddTween(IndexType type, const char* name, int prop, Vec4 to, float duration, int ease = TweenEase_Linear);     //n܂_̒l  to
+int  AddTweenBy(IndexType type, const char* name, int prop, Vec4 delta, float duration, int ease = TweenEase_Linear); //n܂_̒l  + delta
+int  AddTweenAt(IndexType type, int index, int prop, Vec4 from, Vec4 to, float duration, int ease = TweenEase_Linear);
+void SetTweenDelay(int tween, float seconds);                              //n܂܂ł̕b
+void SetTweenLoop(int tween, int count, bool pingPong = false);            //count: ǉŌJԂ񐔁i-1 Ŗj/ pingPong: ͋t
+void SetTweenAfter(int tween, int prev);                                   //prev IĂn߂iAj
+void SetTweenEvent(int tween, TweenEventFn fn, void* user);
+void StopTween(int tween);                                                 //̎_̒l̂܂܎~߂
+void StopTweens(IndexType type, const char* name);                         //Ώۂ Tween SĎ~߂
+bool IsTweenActive(int tween);
+int  GetTweenCount();                                                      //isi҂܂ށj̐
+void ReserveTweens(int count);                                             //XbgɊm
+void UpdateTweens(float dt);
+void Tween_OnRemove(IndexType type, int index);                            //폜iObjectManager pj
+void Tween_OnMove(IndexType type, int from, int to);                       //s̈ړiObjectManager pj
+void ReleaseTweens();
+
+  /////////////////
+ // ReelManager //
+/////////////////
+// SpriteCylinder ̃[[hB]͑ʂ UV 炵ĕ\i~ Angle / bV͕ςȂj
+// ʂ̃eNX`}œт}̕сBʒu 0 ̐}iUV ̂炵 0  u = 0 ̈ʒuj
+// eNX` / ̃[1̃CX^X`i[oNj
+void SetSpriteCylinderReel(const char* name, int symbols);                 //symbols > 0 Ń[A0 Œʏ̉~ɖ߂
+void SetReelStrip(const char* name, const int* symbols, int count);        //ʒuƂ̐}ԍicount = }Bݒ ʒu = }ԍj
+void SetReelSeed(unsigned seed);                                           //StopReel ̗̎ivCpj
+void SpinReel(const char* name, float speed);                              //speed: 1b̐}i> 0B0 j
+void StopReel(const char* name, int symbol = -1, float delay = 0.0f);      //symbol ɗ悤Ď~߂i-1 ŗj/ delay: n߂܂ł̕b
+bool IsReelSpinning(const char* name);                                     //] / 
+int  GetReelSymbol(const char* name);                                      //̐}ԍ
+int  GetReelSymbols(int index);                                            //}i[łȂ 0BDrawScene pj
+float GetReelScroll(int index);                                            //UV ̂炵 0..1iDrawScene pj
+void UpdateReels(float dt);                                                //UpdateDo 疈t[iŒXebvj
+void Reel_OnRemove(IndexType type, int index);                             //폜iObjectManager pj
+void Reel_OnMove(IndexType type, int from, int to);                        //s̈ړiObjectManager pj
+void ReleaseReels();
+
+  ///////////////////
+ // EffectManager //
+///////////////////
+// p[eBNBq͔Ƃ SoA ŎAUpdateEffects ŕɐϕiD3D gȂ̂ŃwbhXłj
+// `͔Ƃ1̃CX^X`iEffect R|[lg Effect_WriteInstances Œڏj
+typedef struct
+{
+    int   MaxParticles;     //ɑ݂ł鐔i͂̐ŊmہB͏oȂj
+    float Rate;             //1bɏo
+    float LifeMin, LifeMax; //ibj
+    Vec4  Velocity;         //
+    Vec4  VelocityRandom;   //̂΂iƂ }j
+    Vec4  Gravity;          //x
+    float Drag;             //1b̌̊
+    float SpawnRadius;      //ʒû΂iƂ }j
+    float SizeStart, SizeEnd;
+    Vec4  ColorStart, ColorEnd;
+} EffectDesc;
+typedef struct { Vec4 PosSize; Vec4 Color; } EffectInstance;               //CX^X1ixyz: ʒu / w: 傫AFj
+EffectDesc EffectDesc_Default();
+void SetEffectDesc(const char* name, const EffectDesc& desc);              //MaxParticles ςƗq͏
+void SetEffectSeed(unsigned seed);                                         //ȍ~ɒǉ锭̗̎ivCpj
+void PlayEffect(const char* name);                                         //Rate ŏoiAddEffect ̒ォj
+void StopEffect(const char* name);                                         //ô~߂ioq͎܂Ŏcj
+void BurstEffect(const char* name, int count);                             //̍XV count ܂Ƃ߂ďo
+int  GetEffectParticleCount(const char* name);
+int  GetEffectTotalParticles();                                            //݂̃V[̗̔qiO UpdateEffectsj
+int  GetEffectCount(int index);                                            //s index ̗qi`pj
+int  GetEffectCapacity(int index);                                         //s index ̗̗eʁi4 ̔{j
+void Effect_WriteInstances(int index, EffectInstance* dst, int begin, int end);    //q [begin, end)  dst[begin..end) ցi[J[XbhĂł悢j
+void Effect_OnAdd(int index);                                              //AddEffect iObjectManager pj
+void Effect_OnRemove(IndexType type, int index);                           //폜iObjectManager pj
+void Effect_OnMove(IndexType type, int from, int to);                      //s̈ړiObjectManager pj
+void Effect_OnCopy(int from, int to);                                      //s̕Bݒ̂ݎʂiObjectManager pj
+void UpdateEffects(float dt);                                              //UpdateDo 疈t[iŒXebvÃ݂V[̔̂݁j
+void ReleaseEffects();
 
   //////////////////
  // AssetManager //
 //////////////////
-const std::vector<ModelVertex>* GetModelVertex(const char* modelName);
-ID3D11ShaderResourceView* GetTextureSRV(const char* textureName);
+const std::vector<ModelVertex>* GetModelVertices(const char* modelName);          //ǂݍ݂Ȃ pkg ǂށiȉj
+const std::vector<ModelSkinVertex>* GetModelSkin(const char* modelName);           //{[ nullptr
+const ModelSkeleton* GetModelSkeleton(const char* modelName);                      //{[ nullptr
+const AnimPackedClip* GetModelClip(const char* modelName, int clip = 0);           //t@C̃Aj[ViLbV 0 Ԃ modelNameAȍ~ "modelName#ԍ"j
+bool IN_RegisterModel(const char* name, std::vector<ModelVertex>&& verts, std::vector<ModelSkinVertex>&& skin,
+    ModelSkeleton&& skel, std::vector<AnimClip>&& clips);                          //ϊς݂̃fo^iskin / skel ̓{[΋Aclips ͈kăLbVցj
+bool RaycastModelMesh(const char* modelName, const Vec4& origin, const Vec4& dir, float maxDist, float* distance, Vec4* normal);  //fԂ̃CiBVHj
+bool GetModelMeshBounds(const char* modelName, Vec4* min, Vec4* max);              //fԂ AABB
+RenderShaderResourceView* GetTextureSRV(const char* textureName);
+int  Texture_AddRef(const char* name);                                              //V[̎QƂǉiǂݍ݂͂Ȃj
+int  Texture_Release(const char* name);                                             //QƂOB0 ɂȂ SRV 
+bool Texture_IsResident(const char* name);                                          //GPU ɍڂĂ邩
 
 bool IN_LoadTexture_Memory(const char* name, const unsigned char* data, size_t size);
+bool IN_DecodeTexture_Memory(const unsigned char* data, size_t size,
+    std::vector<unsigned char>& pixels, unsigned& width, unsigned& height);        //Cӂ̃Xbhŉ
+bool IN_UploadTexture(const char* name, const unsigned char* pixels, unsigned width, unsigned height); //CXbĥ
 bool IN_LoadFBX_Memory(const char* name, const unsigned char* data, size_t size);
 bool IN_LoadModelObj_Memory(const char* name, const unsigned char* data, size_t size);
 bool IN_LoadWav_Memory(const char* name, const unsigned char* data, size_t size);
@@ -345,16 +739,27 @@ void ShaderManager_Update();
 int GetVertexShaderIndex(const char* shaderName);
 int GetPixelShaderIndex(const char* shaderName);
 
-ID3D11VertexShader* GetVertexShader2D();
-ID3D11PixelShader*  GetPixelShader2D();
-ID3D11VertexShader* GetVertexShader3D();
-ID3D11PixelShader*  GetPixelShader3D();
-ID3D11VertexShader* GetVertexShader3DGrid();
-ID3D11PixelShader*  GetPixelShader3DGrid();
+RenderVertexShader* GetVertexShader2D();
+RenderPixelShader*  GetPixelShader2D();
+RenderVertexShader* GetVertexShader3D();
+RenderPixelShader*  GetPixelShader3D();
+RenderVertexShader* GetVertexShader3DGrid();
+RenderPixelShader*  GetPixelShader3DGrid();
+RenderVertexShader* GetVertexShaderModel();
+RenderVertexShader* GetVertexShaderSkin();     //VS ŃXLjOi{[ b2j
+RenderPixelShader*  GetPixelShaderModel();
+RenderVertexShader* GetVertexShaderReel();     //[oNiCX^X`j
+RenderPixelShader*  GetPixelShaderReel();
+RenderVertexShader* GetVertexShaderEffect();   //p[eBNiCX^X`AJ̎lp`j
+RenderPixelShader*  GetPixelShaderEffect();
 
-ID3DBlob* GetCurrent2DVSBlob();
-ID3DBlob* GetCurrent3DVSBlob();
-ID3DBlob* GetCurrent3DGridVSBlob();
+RenderBlob* GetCurrent2DVSBlob();
+RenderBlob* GetCurrent3DVSBlob();
+RenderBlob* GetCurrent3DGridVSBlob();
+RenderBlob* GetCurrentModelVSBlob();
+RenderBlob* GetCurrentSkinVSBlob();
+RenderBlob* GetCurrentReelVSBlob();
+RenderBlob* GetCurrentEffectVSBlob();
 
   //////////////////
  // UtilManager  //
@@ -362,13 +767,48 @@ ID3DBlob* GetCurrent3DGridVSBlob();
 //|| [eBeB ||________________
 void AddMessage(const char* sent);
 std::wstring ConvertToWString(const char* str);
-const char* ConcatCStr(const char* str1, const char* str2);
-void ConcatCStrFree(const char* str);
+const char* ConcatCStr(const char* str1, const char* str2);                        //ʂ̓t[A[iĩt[̊ԂLj
+void ConcatCStrFree(const char* str);                                               //݊piȂj
+//|| t[A[i ||_______________
+// 1t[gꎞ̈BFrameArena_Resetit[̏Ijł܂Ƃ߂Ď̂Ă̂ŉ͕sv
+void* FrameAlloc(size_t size, size_t align = 16);                                   //ǂ̃Xbhłialign  2 ̗ݏj
+char* FrameFormat(const char* format, ...);                                         //printf `̈ꎞ
+template<class T> T* FrameAllocArray(size_t count)
+{
+    T* p = static_cast<T*>(FrameAlloc(sizeof(T) * count, alignof(T)));
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void FrameArena_Reset();                                                            //t[̏IiCXbhAWuĂȂƂj
+void GetFrameArenaStats(size_t* peak, size_t* capacity, int* overflows);            //peak: 1t[̍őgp / overflows: {̂ɓȂ񐔁i݌vj
+void ReleaseFrameArena();
+// std::vector piFrameVector<T>Bdeallocate ͉Ȃ̂ reserve Ăgj
+template<class T>
+struct FrameAllocator
+{
+    typedef T value_type;
+    FrameAllocator() = default;
+    template<class U> FrameAllocator(const FrameAllocator<U>&) {}
+    T* allocate(size_t n) { return FrameAllocArray<T>(n); }
+    void deallocate(T*, size_t) {}
+    template<class U> bool operator==(const FrameAllocator<U>&) const { return true; }
+    template<class U> bool operator!=(const FrameAllocator<U>&) const { return false; }
+};
+template<class T> using FrameVector = std::vector<T, FrameAllocator<T>>;
+//|| q[vmۂ̌v ||_______________
+#if defined(LIA_PROFILE)
+void HeapCount_Add();
+#else
+inline void HeapCount_Add() {}
+#endif
+unsigned long long GetHeapAllocCount();                                             //operator new  Util  C z̊mۂ̗݌viLIA_PROFILE `͏ 0j
 //|| Vec4 n ||_______________________
 void Vec4_Init(Vec4Vector* vec);
 void Vec4_PushBack(Vec4Vector* vec, Vec4 value);
 void Vec4_Set(Vec4Vector* vec, size_t index, Vec4 value);
 Vec4 Vec4_Get(Vec4Vector* vec, size_t index);
+void Vec4_AppendRange(Vec4Vector* vec, size_t begin, size_t end);   //[begin, end) 𖖔֕
+void Vec4_AppendFill(Vec4Vector* vec, size_t count, Vec4 value);    //value  count ֒ǉ
 void Vec4_Free(Vec4Vector* vec);
 //|| Char2 n ||______________________
 void Char2_Init(Char2Vector* vec);
@@ -388,18 +828,30 @@ void VecInt_Init(IntVector* vec);
 void VecInt_PushBack(IntVector* vec, int value);
 void VecInt_Set(IntVector* vec, size_t index, int value);
 int VecInt_Get(IntVector* vec, size_t index);
+void VecInt_AppendRange(IntVector* vec, size_t begin, size_t end);
+void VecInt_AppendFill(IntVector* vec, size_t count, int value);
 void VecInt_Free(IntVector* vec);
 //|| Bool n ||_______________________
 void VecBool_Init(BoolVector* vec);
 void VecBool_PushBack(BoolVector* vec, bool value);
 void VecBool_Set(BoolVector* vec, size_t index, bool value);
 bool VecBool_Get(BoolVector* vec, size_t index);
+void VecBool_AppendRange(BoolVector* vec, size_t begin, size_t end);
+void VecBool_AppendFill(BoolVector* vec, size_t count, bool value);
 void VecBool_Free(BoolVector* vec);
 //|| KeyMap n ||______________________
 void KeyMap_Init(KeyMap* map);
 int KeyMap_Add(KeyMap* map, const char* key);
+int KeyMap_Push(KeyMap* map, const char* key);                  //d𒲂ׂɖ֒ǉiIuWFNgƂ̃eNX`pXȂǁAL[ԗj
 int KeyMap_GetIndex(KeyMap* map, const char* key);
 const char* KeyMap_GetKey(KeyMap* map, int index);
 int KeyMap_GetSize(KeyMap* map);
 void KeyMap_SetKey(KeyMap* map, size_t index, const char* key);
-void KeyMap_Free(KeyMap* map);
\ No newline at end of file
+void KeyMap_AppendRange(KeyMap* map, size_t begin, size_t end, const char* prefix);   //[begin, end) ̃L[ prefix tŖ֕
+void KeyMap_AppendEmpty(KeyMap* map, size_t count);                  //NULL ̃L[ count ֒ǉ
+void KeyMap_Remove(KeyMap* map, size_t index);                  //L[iCfbNX͈ێAGetKey  NULL Ԃj
+void KeyMap_Free(KeyMap* map);
+//|| Matrix n ||______________________
+void VecMat_Init(MatrixVector* vec);
+void VecMat_Resize(MatrixVector* vec, size_t size);                 //͒Pʍs
+void VecMat_Free(MatrixVector* vec);
\ No newline at end of file
@@ -0,0 +1,412 @@
+﻿// MathAPI.h
+// 数学ライブラリの窓口
+// |  Windows : DirectXMath をそのまま使う
+// |  それ以外 : エンジンが使う DirectXMath の一部を同じ名前・同じ規約（行ベクトル / 左手系）でスカラー実装
+// |  使う関数を増やすときは両方で同じ結果になるようにここへ足す
+// __________________________________________
+
+#pragma once
+
+#if defined(_WIN32)
+
+#include <DirectXMath.h>
+
+#else
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace DirectX
+{
+    constexpr float XM_PI = 3.141592654f;
+
+    //-----------------------------------------
+    // 型
+    //-----------------------------------------
+    struct alignas(16) XMVECTOR
+    {
+        union {
+            float f[4];
+            uint32_t u[4];
+        };
+    };
+
+    typedef const XMVECTOR& FXMVECTOR;
+    typedef const XMVECTOR& GXMVECTOR;
+    typedef const XMVECTOR& HXMVECTOR;
+    typedef const XMVECTOR& CXMVECTOR;
+
+    struct XMMATRIX;
+    XMMATRIX XMMatrixMultiply(const XMMATRIX& m1, const XMMATRIX& m2);
+
+    struct alignas(16) XMMATRIX
+    {
+        XMVECTOR r[4];
+
+        XMMATRIX() = default;
+        XMMATRIX(FXMVECTOR r0, FXMVECTOR r1, FXMVECTOR r2, FXMVECTOR r3) : r{ r0, r1, r2, r3 } {}
+        XMMATRIX operator*(const XMMATRIX& m) const { return XMMatrixMultiply(*this, m); }
+        XMMATRIX& operator*=(const XMMATRIX& m) { *this = XMMatrixMultiply(*this, m); return *this; }
+    };
+
+    typedef const XMMATRIX& FXMMATRIX;
+    typedef const XMMATRIX& CXMMATRIX;
+
+    struct XMFLOAT2
+    {
+        float x, y;
+        XMFLOAT2() = default;
+        constexpr XMFLOAT2(float _x, float _y) : x(_x), y(_y) {}
+    };
+
+    struct XMFLOAT3
+    {
+        float x, y, z;
+        XMFLOAT3() = default;
+        constexpr XMFLOAT3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+    };
+
+    struct XMFLOAT4
+    {
+        float x, y, z, w;
+        XMFLOAT4() = default;
+        constexpr XMFLOAT4(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+        explicit XMFLOAT4(const float* p) : x(p[0]), y(p[1]), z(p[2]), w(p[3]) {}
+    };
+
+    struct XMUINT4
+    {
+        uint32_t x, y, z, w;
+        XMUINT4() = default;
+        constexpr XMUINT4(uint32_t _x, uint32_t _y, uint32_t _z, uint32_t _w) : x(_x), y(_y), z(_z), w(_w) {}
+    };
+
+    struct XMFLOAT4X4
+    {
+        union {
+            struct {
+                float _11, _12, _13, _14;
+                float _21, _22, _23, _24;
+                float _31, _32, _33, _34;
+                float _41, _42, _43, _44;
+            };
+            float m[4][4];
+        };
+
+        XMFLOAT4X4() = default;
+        constexpr XMFLOAT4X4(float m00, float m01, float m02, float m03,
+                             float m10, float m11, float m12, float m13,
+                             float m20, float m21, float m22, float m23,
+                             float m30, float m31, float m32, float m33)
+            : _11(m00), _12(m01), _13(m02), _14(m03),
+              _21(m10), _22(m11), _23(m12), _24(m13),
+              _31(m20), _32(m21), _33(m22), _34(m23),
+              _41(m30), _42(m31), _43(m32), _44(m33) {}
+    };
+
+    inline constexpr float XMConvertToRadians(float degrees) { return degrees * (XM_PI / 180.0f); }
+
+    //-----------------------------------------
+    // 読み書き
+    //-----------------------------------------
+    inline XMVECTOR XMVectorSet(float x, float y, float z, float w)
+    {
+        XMVECTOR v;
+        v.f[0] = x; v.f[1] = y; v.f[2] = z; v.f[3] = w;
+        return v;
+    }
+    inline XMVECTOR XMVectorReplicate(float s) { return XMVectorSet(s, s, s, s); }
+    inline XMVECTOR XMVectorZero() { return XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f); }
+    inline XMVECTOR XMVectorFalseInt() { return XMVectorZero(); }
+
+    inline float XMVectorGetX(FXMVECTOR v) { return v.f[0]; }
+    inline float XMVectorGetY(FXMVECTOR v) { return v.f[1]; }
+    inline float XMVectorGetZ(FXMVECTOR v) { return v.f[2]; }
+
+    inline XMVECTOR XMLoadFloat3(const XMFLOAT3* p) { return XMVectorSet(p->x, p->y, p->z, 0.0f); }
+    inline XMVECTOR XMLoadFloat4(const XMFLOAT4* p) { return XMVectorSet(p->x, p->y, p->z, p->w); }
+    inline void XMStoreFloat3(XMFLOAT3* p, FXMVECTOR v) { p->x = v.f[0]; p->y = v.f[1]; p->z = v.f[2]; }
+    inline void XMStoreFloat4(XMFLOAT4* p, FXMVECTOR v) { p->x = v.f[0]; p->y = v.f[1]; p->z = v.f[2]; p->w = v.f[3]; }
+    inline void XMStoreUInt4(XMUINT4* p, FXMVECTOR v) { p->x = v.u[0]; p->y = v.u[1]; p->z = v.u[2]; p->w = v.u[3]; }
+
+    inline XMMATRIX XMLoadFloat4x4(const XMFLOAT4X4* p)
+    {
+        return XMMATRIX(XMVectorSet(p->_11, p->_12, p->_13, p->_14),
+                        XMVectorSet(p->_21, p->_22, p->_23, p->_24),
+                        XMVectorSet(p->_31, p->_32, p->_33, p->_34),
+                        XMVectorSet(p->_41, p->_42, p->_43, p->_44));
+    }
+    inline void XMStoreFloat4x4(XMFLOAT4X4* p, FXMMATRIX m)
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) p->m[i][j] = m.r[i].f[j];
+    }
+
+    //-----------------------------------------
+    // 成分ごとの演算
+    //-----------------------------------------
+#define LIA_XM_PER_LANE(expr) XMVECTOR r; for (int i = 0; i < 4; ++i) { expr; } return r
+
+    inline XMVECTOR XMVectorAdd(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.f[i] = a.f[i] + b.f[i]); }
+    inline XMVECTOR XMVectorSubtract(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.f[i] = a.f[i] - b.f[i]); }
+    inline XMVECTOR XMVectorMultiply(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.f[i] = a.f[i] * b.f[i]); }
+    inline XMVECTOR XMVectorDivide(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.f[i] = a.f[i] / b.f[i]); }
+    inline XMVECTOR XMVectorMultiplyAdd(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c) { LIA_XM_PER_LANE(r.f[i] = a.f[i] * b.f[i] + c.f[i]); }
+    inline XMVECTOR XMVectorScale(FXMVECTOR v, float s) { LIA_XM_PER_LANE(r.f[i] = v.f[i] * s); }
+    inline XMVECTOR XMVectorNegate(FXMVECTOR v) { LIA_XM_PER_LANE(r.f[i] = -v.f[i]); }
+    inline XMVECTOR XMVectorAbs(FXMVECTOR v) { LIA_XM_PER_LANE(r.f[i] = fabsf(v.f[i])); }
+    inline XMVECTOR XMVectorReciprocal(FXMVECTOR v) { LIA_XM_PER_LANE(r.f[i] = 1.0f / v.f[i]); }
+    inline XMVECTOR XMVectorRound(FXMVECTOR v) { LIA_XM_PER_LANE(r.f[i] = nearbyintf(v.f[i])); }     //偶数丸め
+    inline XMVECTOR XMVectorSaturate(FXMVECTOR v) { LIA_XM_PER_LANE(r.f[i] = v.f[i] < 0.0f ? 0.0f : (v.f[i] > 1.0f ? 1.0f : v.f[i])); }
+    inline XMVECTOR XMVectorMin(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.f[i] = a.f[i] < b.f[i] ? a.f[i] : b.f[i]); }
+    inline XMVECTOR XMVectorMax(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.f[i] = a.f[i] > b.f[i] ? a.f[i] : b.f[i]); }
+    inline XMVECTOR XMVectorLerp(FXMVECTOR a, FXMVECTOR b, float t) { LIA_XM_PER_LANE(r.f[i] = a.f[i] + (b.f[i] - a.f[i]) * t); }
+
+    // 比較（真のレーンは全ビット 1）
+    inline XMVECTOR XMVectorEqual(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.u[i] = a.f[i] == b.f[i] ? 0xFFFFFFFFu : 0u); }
+    inline XMVECTOR XMVectorLess(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.u[i] = a.f[i] < b.f[i] ? 0xFFFFFFFFu : 0u); }
+    inline XMVECTOR XMVectorLessOrEqual(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.u[i] = a.f[i] <= b.f[i] ? 0xFFFFFFFFu : 0u); }
+    inline XMVECTOR XMVectorGreaterOrEqual(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.u[i] = a.f[i] >= b.f[i] ? 0xFFFFFFFFu : 0u); }
+    inline XMVECTOR XMVectorAndInt(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.u[i] = a.u[i] & b.u[i]); }
+    inline XMVECTOR XMVectorOrInt(FXMVECTOR a, FXMVECTOR b) { LIA_XM_PER_LANE(r.u[i] = a.u[i] | b.u[i]); }
+    inline XMVECTOR XMVectorSelect(FXMVECTOR a, FXMVECTOR b, FXMVECTOR control) { LIA_XM_PER_LANE(r.u[i] = (a.u[i] & ~control.u[i]) | (b.u[i] & control.u[i])); }
+
+#undef LIA_XM_PER_LANE
+
+    inline XMVECTOR XMVectorSplatX(FXMVECTOR v) { return XMVectorReplicate(v.f[0]); }
+    inline XMVECTOR XMVectorSplatY(FXMVECTOR v) { return XMVectorReplicate(v.f[1]); }
+    inline XMVECTOR XMVectorSplatZ(FXMVECTOR v) { return XMVectorReplicate(v.f[2]); }
+
+    inline XMVECTOR operator+(FXMVECTOR a, FXMVECTOR b) { return XMVectorAdd(a, b); }
+    inline XMVECTOR operator-(FXMVECTOR a, FXMVECTOR b) { return XMVectorSubtract(a, b); }
+    inline XMVECTOR operator*(FXMVECTOR a, FXMVECTOR b) { return XMVectorMultiply(a, b); }
+    inline XMVECTOR operator/(FXMVECTOR a, FXMVECTOR b) { return XMVectorDivide(a, b); }
+    inline XMVECTOR operator*(FXMVECTOR v, float s) { return XMVectorScale(v, s); }
+    inline XMVECTOR operator*(float s, FXMVECTOR v) { return XMVectorScale(v, s); }
+    inline XMVECTOR operator-(FXMVECTOR v) { return XMVectorNegate(v); }
+
+    //-----------------------------------------
+    // 3D / 4D ベクトル
+    //-----------------------------------------
+    inline XMVECTOR XMVector3Dot(FXMVECTOR a, FXMVECTOR b)
+    {
+        return XMVectorReplicate(a.f[0] * b.f[0] + a.f[1] * b.f[1] + a.f[2] * b.f[2]);
+    }
+    inline XMVECTOR XMVector4Dot(FXMVECTOR a, FXMVECTOR b)
+    {
+        return XMVectorReplicate(a.f[0] * b.f[0] + a.f[1] * b.f[1] + a.f[2] * b.f[2] + a.f[3] * b.f[3]);
+    }
+    inline XMVECTOR XMVector3LengthSq(FXMVECTOR v) { return XMVector3Dot(v, v); }
+    inline XMVECTOR XMVector3Length(FXMVECTOR v) { return XMVectorReplicate(sqrtf(XMVector3Dot(v, v).f[0])); }
+
+    // 長さ 0 は 0 ベクトルを返す
+    inline XMVECTOR XMVector3Normalize(FXMVECTOR v)
+    {
+        float len = sqrtf(XMVector3Dot(v, v).f[0]);
+        return XMVectorScale(v, len > 0.0f ? 1.0f / len : 0.0f);
+    }
+    inline XMVECTOR XMVector4Normalize(FXMVECTOR v)
+    {
+        float len = sqrtf(XMVector4Dot(v, v).f[0]);
+        return XMVectorScale(v, len > 0.0f ? 1.0f / len : 0.0f);
+    }
+
+    inline XMVECTOR XMVector3Cross(FXMVECTOR a, FXMVECTOR b)
+    {
+        return XMVectorSet(a.f[1] * b.f[2] - a.f[2] * b.f[1],
+                           a.f[2] * b.f[0] - a.f[0] * b.f[2],
+                           a.f[0] * b.f[1] - a.f[1] * b.f[0], 0.0f);
+    }
+
+    // v.xyz を w=1 として変換（結果の w はそのまま）
+    inline XMVECTOR XMVector3Transform(FXMVECTOR v, FXMMATRIX m)
+    {
+        XMVECTOR r = XMVectorMultiplyAdd(XMVectorSplatZ(v), m.r[2], m.r[3]);
+        r = XMVectorMultiplyAdd(XMVectorSplatY(v), m.r[1], r);
+        return XMVectorMultiplyAdd(XMVectorSplatX(v), m.r[0], r);
+    }
+    inline XMVECTOR XMVector3TransformCoord(FXMVECTOR v, FXMMATRIX m)
+    {
+        XMVECTOR r = XMVector3Transform(v, m);
+        return XMVectorScale(r, 1.0f / r.f[3]);
+    }
+    inline XMVECTOR XMVector3TransformNormal(FXMVECTOR v, FXMMATRIX m)
+    {
+        XMVECTOR r = XMVectorMultiply(XMVectorSplatZ(v), m.r[2]);
+        r = XMVectorMultiplyAdd(XMVectorSplatY(v), m.r[1], r);
+        return XMVectorMultiplyAdd(XMVectorSplatX(v), m.r[0], r);
+    }
+
+    inline XMVECTOR XMPlaneNormalize(FXMVECTOR p)
+    {
+        float len = sqrtf(XMVector3Dot(p, p).f[0]);
+        return XMVectorScale(p, len > 0.0f ? 1.0f / len : 0.0f);
+    }
+
+    //-----------------------------------------
+    // 四元数
+    //-----------------------------------------
+    inline XMVECTOR XMQuaternionNormalize(FXMVECTOR q) { return XMVector4Normalize(q); }
+
+    inline XMVECTOR XMQuaternionRotationRollPitchYaw(float pitch, float yaw, float roll)
+    {
+        float sp = sinf(pitch * 0.5f), cp = cosf(pitch * 0.5f);
+        float sy = sinf(yaw * 0.5f), cy = cosf(yaw * 0.5f);
+        float sr = sinf(roll * 0.5f), cr = cosf(roll * 0.5f);
+        return XMVectorSet(cr * sp * cy + sr * cp * sy,
+                           cr * cp * sy - sr * sp * cy,
+                           sr * cp * cy - cr * sp * sy,
+                           cr * cp * cy + sr * sp * sy);
+    }
+
+    // 最短経路（内積が負なら片方を反転）。ほぼ同じ向きは線形補間
+    inline XMVECTOR XMQuaternionSlerp(FXMVECTOR q0, FXMVECTOR q1, float t)
+    {
+        float cosOmega = XMVector4Dot(q0, q1).f[0];
+        float sign = 1.0f;
+        if (cosOmega < 0.0f) { cosOmega = -cosOmega; sign = -1.0f; }
+
+        float s0, s1;
+        if (cosOmega < 1.0f - 0.00001f) {
+            float omega = atan2f(sqrtf(1.0f - cosOmega * cosOmega), cosOmega);
+            float invSin = 1.0f / sinf(omega);
+            s0 = sinf((1.0f - t) * omega) * invSin;
+            s1 = sinf(t * omega) * invSin;
+        }
+        else {
+            s0 = 1.0f - t;
+            s1 = t;
+        }
+        return XMVectorAdd(XMVectorScale(q0, s0), XMVectorScale(q1, s1 * sign));
+    }
+
+    //-----------------------------------------
+    // 行列（行ベクトル：v * M）
+    //-----------------------------------------
+    inline XMMATRIX XMMatrixIdentity()
+    {
+        return XMMATRIX(XMVectorSet(1, 0, 0, 0), XMVectorSet(0, 1, 0, 0), XMVectorSet(0, 0, 1, 0), XMVectorSet(0, 0, 0, 1));
+    }
+
+    inline XMMATRIX XMMatrixMultiply(const XMMATRIX& m1, const XMMATRIX& m2)
+    {
+        XMMATRIX r;
+        for (int i = 0; i < 4; ++i) {
+            XMVECTOR v = XMVectorScale(m2.r[0], m1.r[i].f[0]);
+            v = XMVectorMultiplyAdd(XMVectorReplicate(m1.r[i].f[1]), m2.r[1], v);
+            v = XMVectorMultiplyAdd(XMVectorReplicate(m1.r[i].f[2]), m2.r[2], v);
+            r.r[i] = XMVectorMultiplyAdd(XMVectorReplicate(m1.r[i].f[3]), m2.r[3], v);
+        }
+        return r;
+    }
+
+    inline XMMATRIX XMMatrixTranspose(FXMMATRIX m)
+    {
+        XMMATRIX r;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) r.r[i].f[j] = m.r[j].f[i];
+        return r;
+    }
+
+    inline XMMATRIX XMMatrixTranslation(float x, float y, float z)
+    {
+        XMMATRIX r = XMMatrixIdentity();
+        r.r[3] = XMVectorSet(x, y, z, 1.0f);
+        return r;
+    }
+    inline XMMATRIX XMMatrixTranslationFromVector(FXMVECTOR v) { return XMMatrixTranslation(v.f[0], v.f[1], v.f[2]); }
+
+    inline XMMATRIX XMMatrixScaling(float x, float y, float z)
+    {
+        return XMMATRIX(XMVectorSet(x, 0, 0, 0), XMVectorSet(0, y, 0, 0), XMVectorSet(0, 0, z, 0), XMVectorSet(0, 0, 0, 1));
+    }
+    inline XMMATRIX XMMatrixScalingFromVector(FXMVECTOR v) { return XMMatrixScaling(v.f[0], v.f[1], v.f[2]); }
+
+    // Z（roll）→ X（pitch）→ Y（yaw）の順に回す
+    inline XMMATRIX XMMatrixRotationRollPitchYaw(float pitch, float yaw, float roll)
+    {
+        float sp = sinf(pitch), cp = cosf(pitch);
+        float sy = sinf(yaw), cy = cosf(yaw);
+        float sr = sinf(roll), cr = cosf(roll);
+        return XMMATRIX(XMVectorSet(cr * cy + sr * sp * sy, sr * cp, sr * sp * cy - cr * sy, 0.0f),
+                        XMVectorSet(cr * sp * sy - sr * cy, cr * cp, sr * sy + cr * sp * cy, 0.0f),
+                        XMVectorSet(cp * sy, -sp, cp * cy, 0.0f),
+                        XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    inline XMMATRIX XMMatrixRotationQuaternion(FXMVECTOR q)
+    {
+        float x = q.f[0], y = q.f[1], z = q.f[2], w = q.f[3];
+        return XMMATRIX(XMVectorSet(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w), 2.0f * (x * z - y * w), 0.0f),
+                        XMVectorSet(2.0f * (x * y - z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + x * w), 0.0f),
+                        XMVectorSet(2.0f * (x * z + y * w), 2.0f * (y * z - x * w), 1.0f - 2.0f * (x * x + y * y), 0.0f),
+                        XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    // 逆行列（余因子展開。det が 0 の結果は未定義。pDeterminant は省略可）
+    inline XMMATRIX XMMatrixInverse(XMVECTOR* pDeterminant, FXMMATRIX m)
+    {
+        float a[16], inv[16];
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) a[i * 4 + j] = m.r[i].f[j];
+
+        inv[0]  =  a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+        inv[4]  = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+        inv[8]  =  a[4] * a[9]  * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+        inv[12] = -a[4] * a[9]  * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+        inv[1]  = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+        inv[5]  =  a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+        inv[9]  = -a[0] * a[9]  * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+        inv[13] =  a[0] * a[9]  * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+        inv[2]  =  a[1] * a[6]  * a[15] - a[1] * a[7]  * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7]  - a[13] * a[3] * a[6];
+        inv[6]  = -a[0] * a[6]  * a[15] + a[0] * a[7]  * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7]  + a[12] * a[3] * a[6];
+        inv[10] =  a[0] * a[5]  * a[15] - a[0] * a[7]  * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7]  - a[12] * a[3] * a[5];
+        inv[14] = -a[0] * a[5]  * a[14] + a[0] * a[6]  * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6]  + a[12] * a[2] * a[5];
+        inv[3]  = -a[1] * a[6]  * a[11] + a[1] * a[7]  * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9]  * a[2] * a[7]  + a[9]  * a[3] * a[6];
+        inv[7]  =  a[0] * a[6]  * a[11] - a[0] * a[7]  * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8]  * a[2] * a[7]  - a[8]  * a[3] * a[6];
+        inv[11] = -a[0] * a[5]  * a[11] + a[0] * a[7]  * a[9]  + a[4] * a[1] * a[11] - a[4] * a[3] * a[9]  - a[8]  * a[1] * a[7]  + a[8]  * a[3] * a[5];
+        inv[15] =  a[0] * a[5]  * a[10] - a[0] * a[6]  * a[9]  - a[4] * a[1] * a[10] + a[4] * a[2] * a[9]  + a[8]  * a[1] * a[6]  - a[8]  * a[2] * a[5];
+
+        float det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+        if (pDeterminant) *pDeterminant = XMVectorReplicate(det);
+
+        float invDet = 1.0f / det;
+        XMMATRIX r;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j) r.r[i].f[j] = inv[i * 4 + j] * invDet;
+        return r;
+    }
+
+    inline XMMATRIX XMMatrixPerspectiveFovLH(float fovAngleY, float aspectRatio, float nearZ, float farZ)
+    {
+        float h = cosf(fovAngleY * 0.5f) / sinf(fovAngleY * 0.5f);
+        float w = h / aspectRatio;
+        float range = farZ / (farZ - nearZ);
+        return XMMATRIX(XMVectorSet(w, 0, 0, 0), XMVectorSet(0, h, 0, 0),
+                        XMVectorSet(0, 0, range, 1.0f), XMVectorSet(0, 0, -range * nearZ, 0));
+    }
+
+    inline XMMATRIX XMMatrixOrthographicOffCenterLH(float left, float right, float bottom, float top, float nearZ, float farZ)
+    {
+        float rw = 1.0f / (right - left);
+        float rh = 1.0f / (top - bottom);
+        float range = 1.0f / (farZ - nearZ);
+        return XMMATRIX(XMVectorSet(rw + rw, 0, 0, 0), XMVectorSet(0, rh + rh, 0, 0), XMVectorSet(0, 0, range, 0),
+                        XMVectorSet(-(left + right) * rw, -(top + bottom) * rh, -range * nearZ, 1.0f));
+    }
+
+    inline XMMATRIX XMMatrixLookAtLH(FXMVECTOR eye, FXMVECTOR focus, FXMVECTOR up)
+    {
+        XMVECTOR r2 = XMVector3Normalize(XMVectorSubtract(focus, eye));
+        XMVECTOR r0 = XMVector3Normalize(XMVector3Cross(up, r2));
+        XMVECTOR r1 = XMVector3Cross(r2, r0);
+        XMVECTOR negEye = XMVectorNegate(eye);
+        return XMMATRIX(XMVectorSet(r0.f[0], r1.f[0], r2.f[0], 0.0f),
+                        XMVectorSet(r0.f[1], r1.f[1], r2.f[1], 0.0f),
+                        XMVectorSet(r0.f[2], r1.f[2], r2.f[2], 0.0f),
+                        XMVectorSet(XMVector3Dot(r0, negEye).f[0], XMVector3Dot(r1, negEye).f[0], XMVector3Dot(r2, negEye).f[0], 1.0f));
+    }
+}
+
+#endif
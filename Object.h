@@ -9,118 +9,292 @@
 #include "ComponentSpriteCylinder.h"
 #include "ComponentSound.h"
 #include "ComponentModel.h"
+#include "ComponentEffect.h"
+#include "RenderDevice.h"
+#include <new>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
+//-----------------------------------------
+// R|[lg^̈ꗗ
+// |  я = Xbgԍ = RenderScopeiCamera=0 c Effect=8j
+// |  V^͂1ǉ邾ł悢
+//-----------------------------------------
+template<class... Ts> struct ComponentTypeList {};
+
+using ComponentTypes = ComponentTypeList<
+    Camera,
+    Grid,               // \iGrid  Component ł͂Ȃ GetGridClass() ŊǗj
+    Model,
+    SpriteWorld,
+    SpriteScreen,
+    SpriteBox,
+    SpriteCylinder,
+    Sound,
+    Effect>;
+
+// ^  XbgԍiRpCj
+template<class T, class List> struct ComponentTypeIndex;
+template<class T, class... Ts> struct ComponentTypeIndex<T, ComponentTypeList<T, Ts...>>
+{
+    static constexpr int value = 0;
+};
+template<class T, class U, class... Ts> struct ComponentTypeIndex<T, ComponentTypeList<U, Ts...>>
+{
+    static constexpr int value = 1 + ComponentTypeIndex<T, ComponentTypeList<Ts...>>::value;
+};
+
+template<class List> struct ComponentTypeCount;
+template<class... Ts> struct ComponentTypeCount<ComponentTypeList<Ts...>>
+{
+    static constexpr int value = (int)sizeof...(Ts);
+};
+
+#define COMPONENT_SLOT_COUNT ComponentTypeCount<ComponentTypes>::value
+
+// ̂Ă^
+template<class T> struct ComponentEnabled : std::is_base_of<Component, T> {};
+
+//-----------------------------------------
+// ܂Ƃ߂čXV / `
+// |  ^ static void UpdateAll(ComponentSpan<T>) / DrawAll `Ƃg
+// |   T::Update / T::Draw ^m肳ďɌĂԁiEnabled == false ͔΂BDraw  Culled ΂j
+// |  Update / Draw  override ĂȂ^̓[vƏȂ
+//-----------------------------------------
+template<class T> struct ComponentHasUpdate
+    : std::bool_constant<!std::is_same_v<decltype(&T::Update), void (Component::*)()>> {};
+template<class T> struct ComponentHasDraw
+    : std::bool_constant<!std::is_same_v<decltype(&T::Draw), void (Component::*)()>> {};
+
+template<class T, class = void> struct ComponentHasUpdateAll : std::false_type {};
+template<class T> struct ComponentHasUpdateAll<T, std::void_t<decltype(T::UpdateAll(std::declval<ComponentSpan<T>>()))>> : std::true_type {};
+template<class T, class = void> struct ComponentHasDrawAll : std::false_type {};
+template<class T> struct ComponentHasDrawAll<T, std::void_t<decltype(T::DrawAll(std::declval<ComponentSpan<T>>()))>> : std::true_type {};
+
+template<class T> constexpr bool ComponentNeedsUpdate = ComponentHasUpdateAll<T>::value || ComponentHasUpdate<T>::value;
+template<class T> constexpr bool ComponentNeedsDraw = ComponentHasDrawAll<T>::value || ComponentHasDraw<T>::value;
+
+template<class T>
+void ComponentUpdateAll(ComponentSpan<T> span)
+{
+    if constexpr (ComponentHasUpdateAll<T>::value) T::UpdateAll(span);
+    else if constexpr (ComponentHasUpdate<T>::value) for (T& c : span) { if (c.Enabled) c.T::Update(); }
+}
+
+template<class T>
+void ComponentDrawAll(ComponentSpan<T> span)
+{
+    if constexpr (ComponentHasDrawAll<T>::value) T::DrawAll(span);
+    else if constexpr (ComponentHasDraw<T>::value) for (T& c : span) { if (c.Enabled && !c.Culled) c.T::Draw(); }
+}
+
+//-----------------------------------------
+// ^Ƃ̘Ä
+// |  BlockSize ̃ubNɎ̂𒼐ڕׂiubN͘Aj
+// |  ǉĂAhX͕ςȂiGetComponent ̃|C^ێĂ悢j
+//-----------------------------------------
+template<class T>
+class ComponentArray
+{
+public:
+    static const int BlockShift = 10;
+    static const int BlockSize = 1 << BlockShift;
+
+    ComponentArray() = default;
+    ComponentArray(const ComponentArray&) = delete;
+    ComponentArray& operator=(const ComponentArray&) = delete;
+    ~ComponentArray() { Clear(); }
+
+    int Size() const { return m_size; }
+
+    T& operator[](int i) { return m_blocks[i >> BlockShift][i & (BlockSize - 1)]; }
+    T* At(int i) { return (i < 0 || i >= m_size) ? nullptr : &(*this)[i]; }
+
+    template<class... A>
+    T* Emplace(A&&... args)
+    {
+        if ((m_size >> BlockShift) >= (int)m_blocks.size())
+            m_blocks.push_back(static_cast<T*>(::operator new(sizeof(T) * BlockSize, std::align_val_t(alignof(T)))));
+        T* p = new (&m_blocks[m_size >> BlockShift][m_size & (BlockSize - 1)]) T(std::forward<A>(args)...);
+        m_size++;
+        return p;
+    }
+
+    // [begin, end) ubNPʂ̘AԂɕ f(ComponentSpan<T>) Ă
+    template<class F>
+    void ForEachSpan(int begin, int end, F&& f)
+    {
+        if (end > m_size) end = m_size;
+        while (begin < end)
+        {
+            int offset = begin & (BlockSize - 1);
+            int count = BlockSize - offset;
+            if (count > end - begin) count = end - begin;
+            f(ComponentSpan<T>{ &m_blocks[begin >> BlockShift][offset], count });
+            begin += count;
+        }
+    }
+
+    void Clear()
+    {
+        for (int i = m_size - 1; i >= 0; --i) (*this)[i].~T();
+        for (T* b : m_blocks) ::operator delete(b, std::align_val_t(alignof(T)));
+        m_blocks.clear();
+        m_size = 0;
+    }
+
+private:
+    std::vector<T*> m_blocks;
+    int m_size = 0;
+};
+
+// Ȍ^̃Xbgiɋj
+template<class T>
+class ComponentArrayNone
+{
+public:
+    int Size() const { return 0; }
+    T* At(int) { return nullptr; }
+    void Clear() {}
+};
+
+template<class T>
+using ComponentStorageOf = std::conditional_t<ComponentEnabled<T>::value, ComponentArray<T>, ComponentArrayNone<T>>;
+
+template<class List> struct ComponentStorageTuple;
+template<class... Ts> struct ComponentStorageTuple<ComponentTypeList<Ts...>>
+{
+    using type = std::tuple<ComponentStorageOf<Ts>...>;
+};
+
+// V[Ƃ̗Ĺ͈iXbgƂ [Begin, End)ABegin < 0 ̓XbgŚj
+struct ObjectSceneList
+{
+    int Begin[COMPONENT_SLOT_COUNT];
+    int End[COMPONENT_SLOT_COUNT];
+};
+
 class Object
 {
+public:
+    template<class T>
+    static constexpr int TypeIndex = ComponentTypeIndex<T, ComponentTypes>::value;
+
 private:
+    typename ComponentStorageTuple<ComponentTypes>::type m_storage;
+
+    template<class T>
+    ComponentStorageOf<T>& Storage() { return std::get<TypeIndex<T>>(m_storage); }
+
+    // Xbg type ̍t[̑Ώ۔͈
+    void GetActiveRange(int type, int size, int& begin, int& end) const
+    {
+        begin = 0;
+        end = size;
+        if (m_activeScene < 0 || m_activeScene >= (int)m_sceneLists.size()) return;
+        const ObjectSceneList& list = m_sceneLists[m_activeScene];
+        if (list.Begin[type] < 0) return;
+        begin = list.Begin[type] < size ? list.Begin[type] : size;
+        end = list.End[type] < size ? list.End[type] : size;
+    }
+
+    // ^Ƃ̏izĂяoł͂Ȃ^m肳Ă܂Ƃ߂ČĂԁj
+    template<class T>
+    void UpdateType(ComponentArray<T>& a)
+    {
+        if constexpr (ComponentNeedsUpdate<T>)
+        {
+            int begin, end;
+            GetActiveRange(TypeIndex<T>, a.Size(), begin, end);
+            a.ForEachSpan(begin, end, [](ComponentSpan<T> s) { ComponentUpdateAll(s); });
+        }
+    }
+    template<class T>
+    void DrawType(ComponentArray<T>& a)
+    {
+        if constexpr (ComponentNeedsDraw<T>)
+        {
+            int begin, end;
+            GetActiveRange(TypeIndex<T>, a.Size(), begin, end);
+            RenderStats_SetScope(TypeIndex<T>);
+            a.ForEachSpan(begin, end, [](ComponentSpan<T> s) { ComponentDrawAll(s); });
+        }
+    }
+    template<class T>
+    void ReleaseType(ComponentArray<T>& a)
+    {
+        for (int i = 0; i < a.Size(); ++i) a[i].T::Release();
+    }
+    template<class T> void UpdateType(ComponentArrayNone<T>&) {}
+    template<class T> void DrawType(ComponentArrayNone<T>&) {}
+    template<class T> void ReleaseType(ComponentArrayNone<T>&) {}
 
 public:
-    std::vector<std::vector <class Component*>> m_lpComp;
+    std::vector<ObjectSceneList> m_sceneLists;  // SceneManager o^
+    int m_activeScene = -1;                      // -1: SR|[lgΏ
 
     int UseScene = -1;
     bool Active = true;
 
+    virtual ~Object() {}
+
     virtual void Init() {
 
     }
     virtual void Update() {
-        for (auto& i : m_lpComp)
-        {
-            for (auto& ii : i)
-            {
-                ii->Update();
-            }
-        }
-
+        // ݂̃V[͈̔͂̂
+        std::apply([this](auto&... a) { (UpdateType(a), ...); }, m_storage);
     }
     virtual void Draw() {
-        for (auto& i : m_lpComp)
-        {
-            for (auto& ii : i)
-            {
-                ii->Draw();
-            }
-        }
+        // `擝v̓Xbgԍ(=RenderScope)ƂɏWv
+        std::apply([this](auto&... a) { (DrawType(a), ...); }, m_storage);
+        RenderStats_SetScope(RenderScope_Engine);
     }
     virtual void Release() {
-        for (auto& i : m_lpComp)
+        std::apply([this](auto&... a) { (ReleaseType(a), ...); }, m_storage);
+    }
+
+    // V[ scene ł̃Xbg type ͈̔͂o^ibegin < 0 ŃXbgŚj
+    void SetSceneRange(int scene, int type, int begin, int end)
+    {
+        if (scene < 0 || type < 0 || type >= COMPONENT_SLOT_COUNT) return;
+        if ((int)m_sceneLists.size() <= scene)
         {
-            for (auto& ii : i)
-            {
-                ii->Release();
-            }
+            ObjectSceneList all;
+            for (int t = 0; t < COMPONENT_SLOT_COUNT; ++t) { all.Begin[t] = -1; all.End[t] = -1; }
+            m_sceneLists.resize(scene + 1, all);
         }
+        m_sceneLists[scene].Begin[type] = begin;
+        m_sceneLists[scene].End[type] = end;
+    }
+    template<typename T>
+    void SetSceneRange(int scene, int begin, int end)
+    {
+        SetSceneRange(scene, TypeIndex<T>, begin, end);
     }
+    // LȃV[̐؂ւiXg̍ւ̂݁j
+    void SetActiveScene(int scene) { m_activeScene = scene; }
+    int GetActiveScene() const { return m_activeScene; }
 
     template<typename T = Component>
     T* AddComponent()
     {
-        //static_assert(std::is_base_of<Component, T>::value, "T must be a Component");
-
         static_assert(std::is_base_of<Component, T>::value, "T must inherit Component");
+        static_assert(ComponentEnabled<T>::value, "T is not registered in ComponentTypes");
 
-        if (m_lpComp.size() < 8) m_lpComp.resize(8);
-
-        int type = -1;
-
-        if constexpr (std::is_same_v<T, class Camera>) type = 0;
-        else if constexpr (std::is_same_v<T, class Grid>) type = 1;
-        else if constexpr (std::is_same_v<T, class Model>) type = 2;
-        else if constexpr (std::is_same_v<T, class SpriteWorld>) type = 3;
-        else if constexpr (std::is_same_v<T, class SpriteScreen>) type = 4;
-        else if constexpr (std::is_same_v<T, class SpriteBox>) type = 5;
-        else if constexpr (std::is_same_v<T, class SpriteCylinder>) type = 6;
-        else if constexpr (std::is_same_v<T, class Sound>) type = 7;
-        else type = -1;
-
-
-        if (type == -1) return nullptr; // m̌^
-
-        T* component = new T(this);  // this Template*
-        m_lpComp[type].push_back(component);
+        T* component = Storage<T>().Emplace(this);
         component->Init();
         return component;
     }
     template <typename T = Component>
     T* GetComponent(int index)
     {
-        int type = -1;
-
-        if constexpr (std::is_same_v<T, class Camera>) type = 0;
-        else if constexpr (std::is_same_v<T, class Grid>) type = 1;
-        else if constexpr (std::is_same_v<T, class Model>) type = 2;
-        else if constexpr (std::is_same_v<T, class SpriteWorld>) type = 3;
-        else if constexpr (std::is_same_v<T, class SpriteScreen>) type = 4;
-        else if constexpr (std::is_same_v<T, class SpriteBox>) type = 5;
-        else if constexpr (std::is_same_v<T, class SpriteCylinder>) type = 6;
-        else type = -1;
-
-
-        if (type == -1) return nullptr; // m̌^
-
-
-        if (index < 0 || index >= m_lpComp[type].size())
-            return nullptr;
-        return dynamic_cast<T*>(m_lpComp[type][index]);
+        return Storage<T>().At(index);
     }
     template <typename T = Component>
     int GetSize()
     {
-        int type = -1;
-
-        if constexpr (std::is_same_v<T, class Camera>) type = 0;
-        else if constexpr (std::is_same_v<T, class Grid>) type = 1;
-        else if constexpr (std::is_same_v<T, class Model>) type = 2;
-        else if constexpr (std::is_same_v<T, class SpriteWorld>) type = 3;
-        else if constexpr (std::is_same_v<T, class SpriteScreen>) type = 4;
-        else if constexpr (std::is_same_v<T, class SpriteBox>) type = 5;
-        else if constexpr (std::is_same_v<T, class SpriteCylinder>) type = 6;
-        else type = -1;
-
-
-        if (type == -1) return -1; // m̌^
-
-        return static_cast<int>(m_lpComp[type].size());
+        return Storage<T>().Size();
     }
-};
\ No newline at end of file
+};
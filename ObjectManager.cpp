@@ -13,7 +13,11 @@
 #include "ComponentSpriteBox.h"
 #include "ComponentSpriteCylinder.h"
 #include "ComponentSound.h"
+#include "JobSystem.h"
+#include "GameLoop.h"
+#include <climits>
 #include <string>
+#include <vector>
 
 // ======================================================
 // ObjectManager.cpp（統合・高速化版）
@@ -38,10 +42,472 @@ static int SpriteScreenIndex = 0, SpriteScreenOldIndex = 0;
 static int SpriteBoxIndex = 0, SpriteBoxOldIndex = 0;
 static int SpriteCylinderIndex = 0, SpriteCylinderOldIndex = 0;
 static int ModelIndex = 0, ModelOldIndex = 0;
+static int EffectIndex = 0, EffectOldIndex = 0;
 static int BoxColliderIndex = 0, BoxColliderOldIndex = 0;
 static int GridBoxIndex = 0, GridBoxOldIndex = 0;
 static int GridPolygonIndex = 0, GridPolygonOldIndex = 0;
 
+//-----------------------------------------
+// 削除済みスロットの再利用
+// |  削除してもインデックスは詰めない（シーン範囲・名前・コンポーネントの対応を保つため）
+// |  追加時は追加先シーンの範囲にある空きを優先して使い、無ければ末尾へ追加
+//-----------------------------------------
+struct ObjectSlots {
+    std::vector<int> Free;                  // 空きスロット
+    std::vector<int> Revive;                // 再利用したスロット（CreateObject でコンポーネントを再設定）
+    std::vector<unsigned char> Released;    // GPU リソース解放済み（再利用時に Init し直す）
+};
+static ObjectSlots CameraSlots, SpriteWorldSlots, SpriteScreenSlots, SpriteBoxSlots,
+                   SpriteCylinderSlots, GridBoxSlots, GridPolygonSlots, BoxColliderSlots, ModelSlots, EffectSlots;
+
+struct ObjectTypeInfo {
+    ObjectSlots* Slots;
+    KeyMap* Map;
+    BoolVector* Alive;
+};
+
+static bool ObjectType_Get(IndexType type, ObjectTypeInfo* out)
+{
+    switch (type)
+    {
+    case IndexType::Camera:         *out = { &CameraSlots, &g_ObjectPool.CameraMap, &g_ObjectPool.CameraAlive }; return true;
+    case IndexType::SpriteWorld:    *out = { &SpriteWorldSlots, &g_ObjectPool.SpriteWorldMap, &g_ObjectPool.SpriteWorldAlive }; return true;
+    case IndexType::SpriteScreen:   *out = { &SpriteScreenSlots, &g_ObjectPool.SpriteScreenMap, &g_ObjectPool.SpriteScreenAlive }; return true;
+    case IndexType::SpriteBox:      *out = { &SpriteBoxSlots, &g_ObjectPool.SpriteBoxMap, &g_ObjectPool.SpriteBoxAlive }; return true;
+    case IndexType::SpriteCylinder: *out = { &SpriteCylinderSlots, &g_ObjectPool.SpriteCylinderMap, &g_ObjectPool.SpriteCylinderAlive }; return true;
+    case IndexType::GridBox:        *out = { &GridBoxSlots, &g_ObjectPool.GridBoxMap, &g_ObjectPool.GridBoxAlive }; return true;
+    case IndexType::GridPolygon:    *out = { &GridPolygonSlots, &g_ObjectPool.GridPolygonMap, &g_ObjectPool.GridPolygonAlive }; return true;
+    case IndexType::BoxCollider:    *out = { &BoxColliderSlots, &g_ObjectPool.BoxColliderMap, &g_ObjectPool.BoxColliderAlive }; return true;
+    case IndexType::Model:          *out = { &ModelSlots, &g_ObjectPool.ModelMap, &g_ObjectPool.ModelAlive }; return true;
+    case IndexType::Effect:         *out = { &EffectSlots, &g_ObjectPool.EffectMap, &g_ObjectPool.EffectAlive }; return true;
+    default: return false;
+    }
+}
+
+// [begin, end) にある空きスロットを外して返す（無ければ -1）
+static int ObjectSlots_Take(ObjectSlots& s, int begin, int end)
+{
+    for (size_t i = s.Free.size(); i-- > 0;) {
+        int idx = s.Free[i];
+        if (idx < begin || idx >= end) continue;
+        s.Free[i] = s.Free.back();
+        s.Free.pop_back();
+        return idx;
+    }
+    return -1;
+}
+
+// 再利用できる空きスロットを返す（無ければ -1）。Camera はシーンに属さないのでどれでもよい
+// |  削除済みシーンから引き継いだ範囲が埋まっていたら、範囲を末尾へ移してから探し直す
+static int ObjectSlots_Acquire(ObjectSlots& s, IndexType type)
+{
+    int begin = 0, end = INT_MAX;
+    if (type != IndexType::Camera && !GetActiveSceneRange(type, &begin, &end)) return -1;
+    int idx = ObjectSlots_Take(s, begin, end);
+    if (idx < 0 && end != INT_MAX && MoveActiveSceneRangeToTail(type) && GetActiveSceneRange(type, &begin, &end))
+        idx = ObjectSlots_Take(s, begin, end);
+    if (idx < 0) return -1;
+    s.Revive.push_back(idx);
+    Transform_MarkDirty(type, idx);
+    ScreenGrid_MarkDirty(type, idx);
+    return idx;
+}
+
+// [begin, end) の空きスロット数
+static int ObjectSlots_CountFree(const ObjectSlots& s, int begin, int end)
+{
+    int n = 0;
+    for (int idx : s.Free) n += (idx >= begin && idx < end) ? 1 : 0;
+    return n;
+}
+
+// 再利用時に Init し直す必要があるか（フラグは下ろす）
+static bool ObjectSlots_TakeReleased(ObjectSlots& s, int idx)
+{
+    if (idx < 0 || idx >= (int)s.Released.size() || !s.Released[idx]) return false;
+    s.Released[idx] = 0;
+    return true;
+}
+
+static Component* GetComponentAt(IndexType type, int index)
+{
+    if (!object) return nullptr;
+    switch (type)
+    {
+    case IndexType::Camera:         return object->GetComponent<Camera>(index);
+    case IndexType::Model:          return object->GetComponent<Model>(index);
+    case IndexType::SpriteWorld:    return object->GetComponent<SpriteWorld>(index);
+    case IndexType::SpriteScreen:   return object->GetComponent<SpriteScreen>(index);
+    case IndexType::SpriteBox:      return object->GetComponent<SpriteBox>(index);
+    case IndexType::SpriteCylinder: return object->GetComponent<SpriteCylinder>(index);
+    case IndexType::Effect:         return object->GetComponent<Effect>(index);
+    default: return nullptr;
+    }
+}
+
+void RemoveObjectAt(IndexType type, int index, bool release)
+{
+    ObjectTypeInfo t;
+    if (!ObjectType_Get(type, &t)) return;
+    if (index < 0 || index >= (int)t.Alive->size || !VecBool_Get(t.Alive, index)) return;
+
+    VecBool_Set(t.Alive, index, false);
+    KeyMap_Remove(t.Map, index);
+    t.Slots->Free.push_back(index);
+    Transform_OnRemove(type, index);
+    Tween_OnRemove(type, index);
+    Reel_OnRemove(type, index);
+    Effect_OnRemove(type, index);
+    ScreenGrid_MarkDirty(type, index);
+
+    // コンポーネントは残して無効化（未生成なら CreateObject で無効のまま作られる）
+    Component* c = GetComponentAt(type, index);
+    if (c) {
+        c->Enabled = false;
+        if (release) {
+            c->Release();
+            if ((int)t.Slots->Released.size() <= index) t.Slots->Released.resize(index + 1, 0);
+            t.Slots->Released[index] = 1;
+        }
+    }
+    if (type == IndexType::Camera && UseCamera == index) UseCamera = -1;
+}
+
+bool IsObjectAlive(IndexType type, int index)
+{
+    ObjectTypeInfo t;
+    if (!ObjectType_Get(type, &t)) return true;
+    if (index < 0 || index >= (int)t.Alive->size) return false;
+    return VecBool_Get(t.Alive, index);
+}
+
+int GetObjectIndexByName(IndexType type, const char* name)
+{
+    ObjectTypeInfo t;
+    if (!name || !ObjectType_Get(type, &t)) return -1;
+    return KeyMap_GetIndex(t.Map, name);
+}
+
+static void RemoveObjectByName(IndexType type, const char* name, const char* api)
+{
+    ObjectTypeInfo t;
+    if (!name || !ObjectType_Get(type, &t)) return;
+    int idx = KeyMap_GetIndex(t.Map, name);
+    if (idx < 0) { AddMessage(ConcatCStr(api, name)); return; }
+    RemoveObjectAt(type, idx, false);
+}
+
+//-----------------------------------------
+// 範囲の複製（CopyScene 用）
+// |  [begin, end) の全カラムを末尾へまとめて複製（カラムごとに確保1回 + memcpy）
+// |  名前は prefix + 元の名前。削除済みスロットは削除済みのまま複製し空きに加える
+// |  コンポーネントは次の CreateObject でまとめて生成される
+// |  戻り値: 複製先の先頭インデックス（複製先の末尾は GetObjectIndex() の値）
+//-----------------------------------------
+static void ClampCopyRange(int& begin, int& end, int count)
+{
+    if (begin < 0) begin = 0;
+    if (end > count) end = count;
+    if (end < begin) end = begin;
+}
+
+int CopyObjectRange(IndexType type, int begin, int end, const char* prefix)
+{
+    ObjectDataPool* p = &g_ObjectPool;
+    ObjectTypeInfo t;
+    int dst = -1;
+
+    switch (type)
+    {
+    case IndexType::SpriteWorld:
+        ClampCopyRange(begin, end, SpriteWorldIndex);
+        dst = SpriteWorldIndex;
+        Vec4_AppendRange(&p->SpriteWorldPos, begin, end);
+        Vec4_AppendRange(&p->SpriteWorldSize, begin, end);
+        Vec4_AppendRange(&p->SpriteWorldAngle, begin, end);
+        Vec4_AppendRange(&p->SpriteWorldColor, begin, end);
+        KeyMap_AppendRange(&p->SpriteWorldMap, begin, end, prefix);
+        KeyMap_AppendRange(&p->SpriteWorldTexturePathMap, begin, end, nullptr);
+        VecBool_AppendRange(&p->SpriteWorldAlive, begin, end);
+        SpriteWorldIndex += end - begin;
+        ObjectIdx.SpriteWorldIndex = SpriteWorldIndex;
+        break;
+    case IndexType::SpriteScreen:
+        ClampCopyRange(begin, end, SpriteScreenIndex);
+        dst = SpriteScreenIndex;
+        Vec4_AppendRange(&p->SpriteScreenPos, begin, end);
+        Vec4_AppendRange(&p->SpriteScreenSize, begin, end);
+        Vec4_AppendRange(&p->SpriteScreenColor, begin, end);
+        VecInt_AppendRange(&p->SpriteScreenAngle, begin, end);
+        VecBool_AppendRange(&p->SpriteScreenOpaque, begin, end);
+        KeyMap_AppendRange(&p->SpriteScreenMap, begin, end, prefix);
+        KeyMap_AppendRange(&p->SpriteScreenTexturePathMap, begin, end, nullptr);
+        VecBool_AppendRange(&p->SpriteScreenAlive, begin, end);
+        SpriteScreenIndex += end - begin;
+        ObjectIdx.SpriteScreenIndex = SpriteScreenIndex;
+        break;
+    case IndexType::SpriteBox:
+        ClampCopyRange(begin, end, SpriteBoxIndex);
+        dst = SpriteBoxIndex;
+        Vec4_AppendRange(&p->SpriteBoxPos, begin, end);
+        Vec4_AppendRange(&p->SpriteBoxSize, begin, end);
+        Vec4_AppendRange(&p->SpriteBoxAngle, begin, end);
+        Vec4_AppendRange(&p->SpriteBoxColor, begin, end);
+        KeyMap_AppendRange(&p->SpriteBoxMap, begin, end, prefix);
+        KeyMap_AppendRange(&p->SpriteBoxTopTexturePathMap, begin, end, nullptr);
+        KeyMap_AppendRange(&p->SpriteBoxBottomTexturePathMap, begin, end, nullptr);
+        KeyMap_AppendRange(&p->SpriteBoxFrontTexturePathMap, begin, end, nullptr);
+        KeyMap_AppendRange(&p->SpriteBoxRearTexturePathMap, begin, end, nullptr);
+        KeyMap_AppendRange(&p->SpriteBoxLeftTexturePathMap, begin, end, nullptr);
+        KeyMap_AppendRange(&p->SpriteBoxRightTexturePathMap, begin, end, nullptr);
+        VecBool_AppendRange(&p->SpriteBoxAlive, begin, end);
+        SpriteBoxIndex += end - begin;
+        ObjectIdx.SpriteBoxIndex = SpriteBoxIndex;
+        break;
+    case IndexType::SpriteCylinder:
+        ClampCopyRange(begin, end, SpriteCylinderIndex);
+        dst = SpriteCylinderIndex;
+        Vec4_AppendRange(&p->SpriteCylinderPos, begin, end);
+        Vec4_AppendRange(&p->SpriteCylinderSize, begin, end);
+        Vec4_AppendRange(&p->SpriteCylinderAngle, begin, end);
+        Vec4_AppendRange(&p->SpriteCylinderColor, begin, end);
+        VecInt_AppendRange(&p->SpriteCylinderSegment, begin, end);
+        KeyMap_AppendRange(&p->SpriteCylinderMap, begin, end, prefix);
+        KeyMap_AppendRange(&p->SpriteCylinderTopTexturePathMap, begin, end, nullptr);
+        KeyMap_AppendRange(&p->SpriteCylinderBottomTexturePathMap, begin, end, nullptr);
+        KeyMap_AppendRange(&p->SpriteCylinderSideTexturePathMap, begin, end, nullptr);
+        VecBool_AppendRange(&p->SpriteCylinderAlive, begin, end);
+        SpriteCylinderIndex += end - begin;
+        ObjectIdx.SpriteCylinderIndex = SpriteCylinderIndex;
+        break;
+    case IndexType::GridBox:
+        ClampCopyRange(begin, end, GridBoxIndex);
+        dst = GridBoxIndex;
+        Vec4_AppendRange(&p->GridBoxPos, begin, end);
+        Vec4_AppendRange(&p->GridBoxSize, begin, end);
+        Vec4_AppendRange(&p->GridBoxAngle, begin, end);
+        Vec4_AppendRange(&p->GridBoxColor, begin, end);
+        KeyMap_AppendRange(&p->GridBoxMap, begin, end, prefix);
+        VecBool_AppendRange(&p->GridBoxAlive, begin, end);
+        GridBoxIndex += end - begin;
+        ObjectIdx.GridBoxIndex = GridBoxIndex;
+        break;
+    case IndexType::GridPolygon:
+        ClampCopyRange(begin, end, GridPolygonIndex);
+        dst = GridPolygonIndex;
+        Vec4_AppendRange(&p->GridPolygonPos, begin, end);
+        Vec4_AppendRange(&p->GridPolygonSize, begin, end);
+        Vec4_AppendRange(&p->GridPolygonAngle, begin, end);
+        Vec4_AppendRange(&p->GridPolygonColor, begin, end);
+        VecInt_AppendRange(&p->GridPolygonSides, begin, end);
+        KeyMap_AppendRange(&p->GridPolygonMap, begin, end, prefix);
+        VecBool_AppendRange(&p->GridPolygonAlive, begin, end);
+        GridPolygonIndex += end - begin;
+        ObjectIdx.GridPolygonIndex = GridPolygonIndex;
+        break;
+    case IndexType::BoxCollider:
+        ClampCopyRange(begin, end, BoxColliderIndex);
+        dst = BoxColliderIndex;
+        Vec4_AppendRange(&p->BoxColliderPos, begin, end);
+        Vec4_AppendRange(&p->BoxColliderSize, begin, end);
+        Vec4_AppendRange(&p->BoxColliderAngle, begin, end);
+        VecInt_AppendRange(&p->BoxColliderShape, begin, end);
+        KeyMap_AppendRange(&p->BoxColliderMap, begin, end, prefix);
+        VecBool_AppendRange(&p->BoxColliderAlive, begin, end);
+        BoxColliderIndex += end - begin;
+        ObjectIdx.BoxColliderIndex = BoxColliderIndex;
+        break;
+    case IndexType::Model:
+        ClampCopyRange(begin, end, ModelIndex);
+        dst = ModelIndex;
+        Vec4_AppendRange(&p->ModelPos, begin, end);
+        Vec4_AppendRange(&p->ModelSize, begin, end);
+        Vec4_AppendRange(&p->ModelAngle, begin, end);
+        for (int i = begin; i < end; ++i) VecC_PushBack(&p->ModelPath, VecC_Get(&p->ModelPath, i));
+        KeyMap_AppendRange(&p->ModelMap, begin, end, prefix);
+        KeyMap_AppendRange(&p->ModelMotionMap, begin, end, nullptr);
+        VecInt_AppendRange(&p->ModelMotionBlend, begin, end);
+        VecBool_AppendRange(&p->ModelAlive, begin, end);
+        ModelIndex += end - begin;
+        ObjectIdx.ModelIndex = ModelIndex;
+        break;
+    case IndexType::Effect:
+        ClampCopyRange(begin, end, EffectIndex);
+        dst = EffectIndex;
+        Vec4_AppendRange(&p->EffectPos, begin, end);
+        KeyMap_AppendRange(&p->EffectMap, begin, end, prefix);
+        KeyMap_AppendRange(&p->EffectTexturePathMap, begin, end, nullptr);
+        VecBool_AppendRange(&p->EffectAlive, begin, end);
+        for (int i = begin; i < end; ++i) Effect_OnCopy(i, dst + (i - begin));
+        EffectIndex += end - begin;
+        ObjectIdx.EffectIndex = EffectIndex;
+        break;
+    default:
+        return -1;
+    }
+
+    // 削除済みのまま複製したスロットは空きへ
+    if (ObjectType_Get(type, &t))
+        for (int i = 0; i < end - begin; ++i)
+            if (!VecBool_Get(t.Alive, dst + i)) t.Slots->Free.push_back(dst + i);
+    return dst;
+}
+
+//-----------------------------------------
+// 行の一括確保（Prefab 用）
+// |  追加先シーンの空きスロットを優先し、足りない分は末尾へまとめて追加（カラムごとに確保1回）
+// |  確保した行は生存扱い。値と名前は呼び出し側が書く（末尾の行は既定値・名前なし）
+// |  outIndex に確保した行を count 個書く。戻り値: 確保できた数
+//-----------------------------------------
+int AcquireObjectRows(IndexType type, int count, int* outIndex)
+{
+    ObjectDataPool* p = &g_ObjectPool;
+    ObjectTypeInfo t;
+    if (count <= 0 || !outIndex || type == IndexType::Camera || !ObjectType_Get(type, &t)) return 0;
+
+    // 引き継いだ範囲に収まらないなら先に末尾へ移す（途中で移すと確保済みの行番号が古くなる）
+    int begin, end;
+    if (GetActiveSceneRange(type, &begin, &end) && end != INT_MAX && ObjectSlots_CountFree(*t.Slots, begin, end) < count)
+        MoveActiveSceneRangeToTail(type);
+
+    int n = 0;
+    while (n < count) {
+        int reuse = ObjectSlots_Acquire(*t.Slots, type);
+        if (reuse < 0) break;
+        VecBool_Set(t.Alive, reuse, true);
+        outIndex[n++] = reuse;
+    }
+    size_t add = (size_t)(count - n);
+    if (add == 0) return n;
+
+    int first = -1;
+    switch (type)
+    {
+    case IndexType::SpriteWorld:
+        first = SpriteWorldIndex;
+        Vec4_AppendFill(&p->SpriteWorldPos, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteWorldSize, add, { 1,1,1,1 });
+        Vec4_AppendFill(&p->SpriteWorldAngle, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteWorldColor, add, { 1,1,1,1 });
+        KeyMap_AppendEmpty(&p->SpriteWorldMap, add);
+        KeyMap_AppendEmpty(&p->SpriteWorldTexturePathMap, add);
+        VecBool_AppendFill(&p->SpriteWorldAlive, add, true);
+        SpriteWorldIndex += (int)add;
+        ObjectIdx.SpriteWorldIndex = SpriteWorldIndex;
+        break;
+    case IndexType::SpriteScreen:
+        first = SpriteScreenIndex;
+        Vec4_AppendFill(&p->SpriteScreenPos, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteScreenSize, add, { 100,100,100,100 });
+        Vec4_AppendFill(&p->SpriteScreenColor, add, { 1,1,1,1 });
+        VecInt_AppendFill(&p->SpriteScreenAngle, add, 0);
+        VecBool_AppendFill(&p->SpriteScreenOpaque, add, false);
+        KeyMap_AppendEmpty(&p->SpriteScreenMap, add);
+        KeyMap_AppendEmpty(&p->SpriteScreenTexturePathMap, add);
+        VecBool_AppendFill(&p->SpriteScreenAlive, add, true);
+        SpriteScreenIndex += (int)add;
+        ObjectIdx.SpriteScreenIndex = SpriteScreenIndex;
+        break;
+    case IndexType::SpriteBox:
+        first = SpriteBoxIndex;
+        Vec4_AppendFill(&p->SpriteBoxPos, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteBoxSize, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteBoxAngle, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteBoxColor, add, { 0,0,0,0 });
+        KeyMap_AppendEmpty(&p->SpriteBoxMap, add);
+        KeyMap_AppendEmpty(&p->SpriteBoxTopTexturePathMap, add);
+        KeyMap_AppendEmpty(&p->SpriteBoxBottomTexturePathMap, add);
+        KeyMap_AppendEmpty(&p->SpriteBoxFrontTexturePathMap, add);
+        KeyMap_AppendEmpty(&p->SpriteBoxRearTexturePathMap, add);
+        KeyMap_AppendEmpty(&p->SpriteBoxLeftTexturePathMap, add);
+        KeyMap_AppendEmpty(&p->SpriteBoxRightTexturePathMap, add);
+        VecBool_AppendFill(&p->SpriteBoxAlive, add, true);
+        SpriteBoxIndex += (int)add;
+        ObjectIdx.SpriteBoxIndex = SpriteBoxIndex;
+        break;
+    case IndexType::SpriteCylinder:
+        first = SpriteCylinderIndex;
+        Vec4_AppendFill(&p->SpriteCylinderPos, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteCylinderSize, add, { 1,1,1,1 });
+        Vec4_AppendFill(&p->SpriteCylinderAngle, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->SpriteCylinderColor, add, { 1,1,1,1 });
+        VecInt_AppendFill(&p->SpriteCylinderSegment, add, 32);
+        KeyMap_AppendEmpty(&p->SpriteCylinderMap, add);
+        KeyMap_AppendEmpty(&p->SpriteCylinderTopTexturePathMap, add);
+        KeyMap_AppendEmpty(&p->SpriteCylinderBottomTexturePathMap, add);
+        KeyMap_AppendEmpty(&p->SpriteCylinderSideTexturePathMap, add);
+        VecBool_AppendFill(&p->SpriteCylinderAlive, add, true);
+        SpriteCylinderIndex += (int)add;
+        ObjectIdx.SpriteCylinderIndex = SpriteCylinderIndex;
+        break;
+    case IndexType::GridBox:
+        first = GridBoxIndex;
+        Vec4_AppendFill(&p->GridBoxPos, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->GridBoxSize, add, { 1,1,1,1 });
+        Vec4_AppendFill(&p->GridBoxAngle, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->GridBoxColor, add, { 1,1,1,1 });
+        KeyMap_AppendEmpty(&p->GridBoxMap, add);
+        VecBool_AppendFill(&p->GridBoxAlive, add, true);
+        GridBoxIndex += (int)add;
+        ObjectIdx.GridBoxIndex = GridBoxIndex;
+        NotifyAddObject(IndexType::GridBox);
+        break;
+    case IndexType::GridPolygon:
+        first = GridPolygonIndex;
+        Vec4_AppendFill(&p->GridPolygonPos, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->GridPolygonSize, add, { 1,1,1,1 });
+        Vec4_AppendFill(&p->GridPolygonAngle, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->GridPolygonColor, add, { 0,0,0,1 });
+        VecInt_AppendFill(&p->GridPolygonSides, add, 4);
+        KeyMap_AppendEmpty(&p->GridPolygonMap, add);
+        VecBool_AppendFill(&p->GridPolygonAlive, add, true);
+        GridPolygonIndex += (int)add;
+        ObjectIdx.GridPolygonIndex = GridPolygonIndex;
+        NotifyAddObject(IndexType::GridPolygon);
+        break;
+    case IndexType::BoxCollider:
+        first = BoxColliderIndex;
+        Vec4_AppendFill(&p->BoxColliderPos, add, { 0,0,0,0 });
+        Vec4_AppendFill(&p->BoxColliderSize, add, { 1,1,1,0 });
+        Vec4_AppendFill(&p->BoxColliderAngle, add, { 0,0,0,0 });
+        VecInt_AppendFill(&p->BoxColliderShape, add, ColliderShape_Box);
+        KeyMap_AppendEmpty(&p->BoxColliderMap, add);
+        VecBool_AppendFill(&p->BoxColliderAlive, add, true);
+        BoxColliderIndex += (int)add;
+        ObjectIdx.BoxColliderIndex = BoxColliderIndex;
+        NotifyAddObject(IndexType::BoxCollider);
+        break;
+    default:
+        return n;
+    }
+    for (size_t i = 0; i < add; ++i) outIndex[n++] = first + (int)i;
+    return n;
+}
+
+//-----------------------------------------
+// 範囲の移動（SceneManager 用）
+// |  [begin, end) を末尾へ複製し、生きている行の親子関係・Tween・リールを移してから元の行を削除する
+// |  削除済みの行は削除済みのまま複製され空きに加わる。戻り値: 移動先の先頭（失敗は -1）
+//-----------------------------------------
+int MoveObjectRange(IndexType type, int begin, int end)
+{
+    ObjectTypeInfo t;
+    if (!ObjectType_Get(type, &t)) return -1;
+    ClampCopyRange(begin, end, (int)t.Alive->size);
+    int dst = CopyObjectRange(type, begin, end, nullptr);
+    if (dst < 0) return -1;
+    for (int i = begin; i < end; ++i) {
+        if (!VecBool_Get(t.Alive, i)) continue;
+        int to = dst + (i - begin);
+        Transform_OnMove(type, i, to);
+        Tween_OnMove(type, i, to);
+        Reel_OnMove(type, i, to);
+        Effect_OnMove(type, i, to);
+        RemoveObjectAt(type, i, false);
+    }
+    return dst;
+}
+
 //-----------------------------------------
 // Getter群
 //-----------------------------------------
@@ -64,6 +530,7 @@ Vec4 GetVec4FromPool(IndexType type, int index)
     case IndexType::GridBox: return Vec4_Get(&p->GridBoxPos, index);
     case IndexType::GridPolygon: return Vec4_Get(&p->GridPolygonPos, index);
     case IndexType::Model: return Vec4_Get(&p->ModelPos, index);
+    case IndexType::Effect: return Vec4_Get(&p->EffectPos, index);
     default: return { 0,0,0,0 };
     }
 }
@@ -77,6 +544,7 @@ void SetVec4ToPool(IndexType type, int index, Vec4 v)
     case IndexType::GridBox: Vec4_Set(&p->GridBoxPos, index, v); break;
     case IndexType::GridPolygon: Vec4_Set(&p->GridPolygonPos, index, v); break;
     case IndexType::Model: Vec4_Set(&p->ModelPos, index, v); break;
+    case IndexType::Effect: Vec4_Set(&p->EffectPos, index, v); break;
     default: break;
     }
 }
@@ -85,14 +553,27 @@ void SetVec4ToPool(IndexType type, int index, Vec4 v)
 // Camera管理
 //-----------------------------------------
 void AddCamera(const char* name) {
+    int reuse = ObjectSlots_Acquire(CameraSlots, IndexType::Camera);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.CameraPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.CameraLook, reuse, { 0,0,1,0 });
+        KeyMap_SetKey(&g_ObjectPool.CameraMap, reuse, name);
+        VecBool_Set(&g_ObjectPool.CameraAlive, reuse, true);
+        if (UseCamera < 0) UseCamera = reuse;
+        return;
+    }
     Vec4_PushBack(&g_ObjectPool.CameraPos, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.CameraLook, { 0,0,1,0 });
     KeyMap_Add(&g_ObjectPool.CameraMap, name);
+    VecBool_PushBack(&g_ObjectPool.CameraAlive, true);
     CameraIndex++;
     ObjectIdx.CameraIndex = CameraIndex;
     // 初回カメラはルート使用カメラにしておく（安全）
     if (UseCamera < 0) UseCamera = 0;
 }
+void RemoveCamera(const char* name) {
+    RemoveObjectByName(IndexType::Camera, name, "RemoveCamera: camera not found: ");
+}
 void SetCameraPos(const char* name, float x, float y, float z) {
     int idx = KeyMap_GetIndex(&g_ObjectPool.CameraMap, name);
     if (idx < 0) { AddMessage(ConcatCStr("SetCameraPos: camera not found: ", name)); return; }
@@ -111,7 +592,7 @@ void UseCameraSet(const char* name) {
 void SetUseCamera(int index) {
     if (index < 0) { UseCamera = index; return; }
     if (index >= CameraIndex) {
-        AddMessage(ConcatCStr("SetUseCamera: invalid index ", std::to_string(index).c_str()));
+        AddMessage(FrameFormat("SetUseCamera: invalid index %d", index));
         return;
     }
     UseCamera = index;
@@ -122,20 +603,38 @@ void SetUseCamera(int index) {
 //-----------------------------------------
 void AddSpriteWorld(const char* name, const char* pathName)
 {
+    NotifySceneAsset(pathName);     // シーンのマニフェストへ
+    int reuse = ObjectSlots_Acquire(SpriteWorldSlots, IndexType::SpriteWorld);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.SpriteWorldPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteWorldSize, reuse, { 1,1,1,1 });
+        Vec4_Set(&g_ObjectPool.SpriteWorldAngle, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteWorldColor, reuse, { 1,1,1,1 });
+        KeyMap_SetKey(&g_ObjectPool.SpriteWorldMap, reuse, name);
+        KeyMap_SetKey(&g_ObjectPool.SpriteWorldTexturePathMap, reuse, pathName);
+        VecBool_Set(&g_ObjectPool.SpriteWorldAlive, reuse, true);
+        return;
+    }
     Vec4_PushBack(&g_ObjectPool.SpriteWorldPos, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteWorldSize, { 1,1,1,1 });
     Vec4_PushBack(&g_ObjectPool.SpriteWorldAngle, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteWorldColor, { 1,1,1,1 });
     KeyMap_Add(&g_ObjectPool.SpriteWorldMap, name);
-    KeyMap_Add(&g_ObjectPool.SpriteWorldTexturePathMap, pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteWorldTexturePathMap, pathName);
+    VecBool_PushBack(&g_ObjectPool.SpriteWorldAlive, true);
     SpriteWorldIndex++;
     ObjectIdx.SpriteWorldIndex = SpriteWorldIndex;
 }
+void RemoveSpriteWorld(const char* name)
+{
+    RemoveObjectByName(IndexType::SpriteWorld, name, "RemoveSpriteWorld : sprite not found");
+}
 void SetSpriteWorldPos(const char* name, float x, float y, float z)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteWorldMap, name);
     if (idx < 0) { AddMessage(ConcatCStr("SetSpriteWorldPos : sprite not found", name)); return; }
     Vec4_Set(&g_ObjectPool.SpriteWorldPos, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::SpriteWorld, idx);
 }
 void SetSpriteWorldSize(const char* name, float x, float y, float z)
 {
@@ -148,6 +647,7 @@ void SetSpriteWorldAngle(const char* name, float x, float y, float z)
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteWorldMap, name);
     if (idx < 0) { AddMessage(ConcatCStr("SetSpriteWorldAngle : sprite not found", name)); return; }
     Vec4_Set(&g_ObjectPool.SpriteWorldAngle, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::SpriteWorld, idx);
 }
 void SetSpriteWorldColor(const char* name, float r, float g, float b, float a)
 {
@@ -161,20 +661,40 @@ void SetSpriteWorldColor(const char* name, float r, float g, float b, float a)
 //-----------------------------------------
 void AddSpriteScreen(const char* name, const char* pathName)
 {
+    NotifySceneAsset(pathName);
+    int reuse = ObjectSlots_Acquire(SpriteScreenSlots, IndexType::SpriteScreen);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.SpriteScreenPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteScreenSize, reuse, { 100, 100, 100, 100 });
+        Vec4_Set(&g_ObjectPool.SpriteScreenColor, reuse, { 1,1,1,1 });
+        VecInt_Set(&g_ObjectPool.SpriteScreenAngle, reuse, 0);
+        VecBool_Set(&g_ObjectPool.SpriteScreenOpaque, reuse, false);
+        KeyMap_SetKey(&g_ObjectPool.SpriteScreenMap, reuse, name);
+        KeyMap_SetKey(&g_ObjectPool.SpriteScreenTexturePathMap, reuse, pathName);
+        VecBool_Set(&g_ObjectPool.SpriteScreenAlive, reuse, true);
+        return;
+    }
     Vec4_PushBack(&g_ObjectPool.SpriteScreenPos, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteScreenSize, { 100, 100, 100, 100 });
     Vec4_PushBack(&g_ObjectPool.SpriteScreenColor, { 1,1,1,1 });
     VecInt_PushBack(&g_ObjectPool.SpriteScreenAngle, 0);
+    VecBool_PushBack(&g_ObjectPool.SpriteScreenOpaque, false);
     KeyMap_Add(&g_ObjectPool.SpriteScreenMap, name);
-    KeyMap_Add(&g_ObjectPool.SpriteScreenTexturePathMap, pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteScreenTexturePathMap, pathName);
+    VecBool_PushBack(&g_ObjectPool.SpriteScreenAlive, true);
     SpriteScreenIndex++;
     ObjectIdx.SpriteScreenIndex = SpriteScreenIndex;
 }
+void RemoveSpriteScreen(const char* name)
+{
+    RemoveObjectByName(IndexType::SpriteScreen, name, "RemoveSpriteScreen : sprite not found");
+}
 void SetSpriteScreenPos(const char* name, float x, float y)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteScreenMap, name);
     if (idx < 0) { AddMessage(ConcatCStr("SetSpriteScreenPos : sprite not found", name)); return; }
     Vec4_Set(&g_ObjectPool.SpriteScreenPos, idx, { x, y, 0, 0 });
+    ScreenGrid_MarkDirty(IndexType::SpriteScreen, idx);
 }
 
 void SetSpriteScreenSize(const char* name, float x, float y)
@@ -182,6 +702,7 @@ void SetSpriteScreenSize(const char* name, float x, float y)
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteScreenMap, name);
     if (idx < 0) { AddMessage(ConcatCStr("SetSpriteScreenSize : sprite not found", name)); return; }
     Vec4_Set(&g_ObjectPool.SpriteScreenSize, idx, { x, y, 1, 1 });
+    ScreenGrid_MarkDirty(IndexType::SpriteScreen, idx);
 }
 void SetSpriteScreenAngle(const char* name, float angle)
 {
@@ -195,30 +716,59 @@ void SetSpriteScreenColor(const char* name, float r, float g, float b, float a)
     if (idx < 0) { AddMessage(ConcatCStr("SetSpriteScreenColor : sprite not found", name)); return; }
     Vec4_Set(&g_ObjectPool.SpriteScreenColor, idx, { r, g, b, a });
 }
+void SetSpriteScreenOpaque(const char* name, bool opaque)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteScreenMap, name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetSpriteScreenOpaque : sprite not found", name)); return; }
+    VecBool_Set(&g_ObjectPool.SpriteScreenOpaque, idx, opaque);
+}
 //-----------------------------------------
 // SpriteBox
 //-----------------------------------------
 void AddSpriteBox(const char* name, const char* pathName)
 {
+    NotifySceneAsset(pathName);
+    int reuse = ObjectSlots_Acquire(SpriteBoxSlots, IndexType::SpriteBox);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.SpriteBoxPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteBoxSize, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteBoxAngle, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteBoxColor, reuse, { 0,0,0,0 });
+        KeyMap_SetKey(&g_ObjectPool.SpriteBoxMap, reuse, name);
+        KeyMap_SetKey(&g_ObjectPool.SpriteBoxTopTexturePathMap,    reuse, pathName);
+        KeyMap_SetKey(&g_ObjectPool.SpriteBoxBottomTexturePathMap, reuse, pathName);
+        KeyMap_SetKey(&g_ObjectPool.SpriteBoxFrontTexturePathMap,  reuse, pathName);
+        KeyMap_SetKey(&g_ObjectPool.SpriteBoxRearTexturePathMap,   reuse, pathName);
+        KeyMap_SetKey(&g_ObjectPool.SpriteBoxLeftTexturePathMap,   reuse, pathName);
+        KeyMap_SetKey(&g_ObjectPool.SpriteBoxRightTexturePathMap,  reuse, pathName);
+        VecBool_Set(&g_ObjectPool.SpriteBoxAlive, reuse, true);
+        return;
+    }
     Vec4_PushBack(&g_ObjectPool.SpriteBoxPos, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteBoxSize, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteBoxAngle, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteBoxColor, { 0,0,0,0 });
     KeyMap_Add(&g_ObjectPool.SpriteBoxMap, name);
-    KeyMap_Add(&g_ObjectPool.SpriteBoxTopTexturePathMap,    pathName);
-    KeyMap_Add(&g_ObjectPool.SpriteBoxBottomTexturePathMap, pathName);
-    KeyMap_Add(&g_ObjectPool.SpriteBoxFrontTexturePathMap,  pathName);
-    KeyMap_Add(&g_ObjectPool.SpriteBoxRearTexturePathMap,   pathName);
-    KeyMap_Add(&g_ObjectPool.SpriteBoxLeftTexturePathMap,   pathName);
-    KeyMap_Add(&g_ObjectPool.SpriteBoxRightTexturePathMap,  pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteBoxTopTexturePathMap,    pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteBoxBottomTexturePathMap, pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteBoxFrontTexturePathMap,  pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteBoxRearTexturePathMap,   pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteBoxLeftTexturePathMap,   pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteBoxRightTexturePathMap,  pathName);
+    VecBool_PushBack(&g_ObjectPool.SpriteBoxAlive, true);
     SpriteBoxIndex++;
     ObjectIdx.SpriteBoxIndex = SpriteBoxIndex;
 }
+void RemoveSpriteBox(const char* name)
+{
+    RemoveObjectByName(IndexType::SpriteBox, name, "RemoveSpriteBox : box not found");
+}
 void SetSpriteBoxPos(const char* name, float x, float y, float z)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if(idx < 0){ return; }
     Vec4_Set(&g_ObjectPool.SpriteBoxPos, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::SpriteBox, idx);
 }
 void SetSpriteBoxSize(const char* name, float x, float y, float z)
 {
@@ -231,6 +781,7 @@ void SetSpriteBoxAngle(const char* name, float x, float y, float z)
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if (idx < 0) { return; }
     Vec4_Set(&g_ObjectPool.SpriteBoxAngle, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::SpriteBox, idx);
 }
 void SetSpriteBoxColor(const char* name, float r, float g, float b, float a)
 {
@@ -243,36 +794,42 @@ void SetSpriteBoxTextureTop(const char* name, const char* pathName)
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if (idx < 0) { return; }
     KeyMap_SetKey(&g_ObjectPool.SpriteBoxTopTexturePathMap, idx, pathName);
+    NotifySceneAsset(pathName);
 }
 void SetSpriteBoxTextureBottom(const char* name, const char* pathName)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if (idx < 0) { return; }
     KeyMap_SetKey(&g_ObjectPool.SpriteBoxBottomTexturePathMap, idx, pathName);
+    NotifySceneAsset(pathName);
 }
 void SetSpriteBoxTextureFront(const char* name, const char* pathName)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if (idx < 0) { return; }
     KeyMap_SetKey(&g_ObjectPool.SpriteBoxFrontTexturePathMap, idx, pathName);
+    NotifySceneAsset(pathName);
 }
 void SetSpriteBoxTextureRear(const char* name, const char* pathName)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if (idx < 0) { return; }
     KeyMap_SetKey(&g_ObjectPool.SpriteBoxRearTexturePathMap, idx, pathName);
+    NotifySceneAsset(pathName);
 }
 void SetSpriteBoxTextureLeft(const char* name, const char* pathName)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if (idx < 0) { return; }
     KeyMap_SetKey(&g_ObjectPool.SpriteBoxLeftTexturePathMap, idx, pathName);
+    NotifySceneAsset(pathName);
 }
 void SetSpriteBoxTextureRight(const char* name, const char* pathName)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteBoxMap, name);
     if (idx < 0) { return; }
     KeyMap_SetKey(&g_ObjectPool.SpriteBoxRightTexturePathMap, idx, pathName);
+    NotifySceneAsset(pathName);
 }
 void SetSpriteBoxTexture(const char* name, const char* pathName)
 {
@@ -289,23 +846,44 @@ void SetSpriteBoxTexture(const char* name, const char* pathName)
 //-----------------------------------------
 void AddSpriteCylinder(const char* name, const char* pathName)
 {
+    NotifySceneAsset(pathName);
+    int reuse = ObjectSlots_Acquire(SpriteCylinderSlots, IndexType::SpriteCylinder);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.SpriteCylinderPos,   reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteCylinderSize,  reuse, { 1,1,1,1 });
+        Vec4_Set(&g_ObjectPool.SpriteCylinderAngle, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.SpriteCylinderColor, reuse, { 1,1,1,1 });
+        VecInt_Set(&g_ObjectPool.SpriteCylinderSegment, reuse, 32);
+        KeyMap_SetKey(&g_ObjectPool.SpriteCylinderMap, reuse, name);
+        KeyMap_SetKey(&g_ObjectPool.SpriteCylinderTopTexturePathMap, reuse, pathName);
+        KeyMap_SetKey(&g_ObjectPool.SpriteCylinderBottomTexturePathMap, reuse, pathName);
+        KeyMap_SetKey(&g_ObjectPool.SpriteCylinderSideTexturePathMap, reuse, pathName);
+        VecBool_Set(&g_ObjectPool.SpriteCylinderAlive, reuse, true);
+        return;
+    }
     Vec4_PushBack(&g_ObjectPool.SpriteCylinderPos,   { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteCylinderSize,  { 1,1,1,1 });
     Vec4_PushBack(&g_ObjectPool.SpriteCylinderAngle, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.SpriteCylinderColor, { 1,1,1,1 });
     VecInt_PushBack(&g_ObjectPool.SpriteCylinderSegment, 32);
     KeyMap_Add(&g_ObjectPool.SpriteCylinderMap, name);
-    KeyMap_Add(&g_ObjectPool.SpriteCylinderTopTexturePathMap, pathName);
-    KeyMap_Add(&g_ObjectPool.SpriteCylinderBottomTexturePathMap, pathName);
-    KeyMap_Add(&g_ObjectPool.SpriteCylinderSideTexturePathMap, pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteCylinderTopTexturePathMap, pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteCylinderBottomTexturePathMap, pathName);
+    KeyMap_Push(&g_ObjectPool.SpriteCylinderSideTexturePathMap, pathName);
+    VecBool_PushBack(&g_ObjectPool.SpriteCylinderAlive, true);
     SpriteCylinderIndex++;
     ObjectIdx.SpriteCylinderIndex = SpriteCylinderIndex;
 }
+void RemoveSpriteCylinder(const char* name)
+{
+    RemoveObjectByName(IndexType::SpriteCylinder, name, "RemoveSpriteCylinder : sprite not found");
+}
 void SetSpriteCylinderPos(const char* name, float x, float y, float z)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteCylinderMap, name);
     if (idx < 0) { AddMessage(ConcatCStr("SetSpriteCylinderPos : sprite not found", name)); return; }
     Vec4_Set(&g_ObjectPool.SpriteCylinderPos, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::SpriteCylinder, idx);
 }
 void SetSpriteCylinderSize(const char* name, float x, float y, float z)
 {
@@ -318,6 +896,7 @@ void SetSpriteCylinderAngle(const char* name, float x, float y, float z)
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteCylinderMap, name);
     if (idx < 0) { AddMessage(ConcatCStr("SetSpriteCylinderAngle : sprite not found", name)); return; }
     Vec4_Set(&g_ObjectPool.SpriteCylinderAngle, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::SpriteCylinder, idx);
 }
 void SetSpriteCylinderColor(const char* name, float r, float g, float b, float a)
 {
@@ -336,18 +915,24 @@ void SetSpriteCylinderTextureSide(const char* name, const char* pathName){
     if (idx < 0) { AddMessage("SetSpriteCylinderSideTexture : sprite not found"); return; }
 
     KeyMap_SetKey(&g_ObjectPool.SpriteCylinderSideTexturePathMap, idx, pathName);
+
+    NotifySceneAsset(pathName);
 }
 void SetSpriteCylinderTextureTop(const char* name, const char* pathName){
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteCylinderMap, name);
     if (idx < 0) { AddMessage("SetSpriteCylinderTopTexture : sprite not found"); return; }
 
     KeyMap_SetKey(&g_ObjectPool.SpriteCylinderTopTexturePathMap, idx, pathName);
+
+    NotifySceneAsset(pathName);
 }
 void SetSpriteCylinderTextureBottom(const char* name, const char* pathName){
     int idx = KeyMap_GetIndex(&g_ObjectPool.SpriteCylinderMap, name);
     if (idx < 0) { AddMessage("SetSpriteCylinderBottomTexture : sprite not found"); return; }
 
     KeyMap_SetKey(&g_ObjectPool.SpriteCylinderBottomTexturePathMap, idx, pathName);
+
+    NotifySceneAsset(pathName);
 }
 
 //-----------------------------------------
@@ -355,21 +940,37 @@ void SetSpriteCylinderTextureBottom(const char* name, const char* pathName){
 //-----------------------------------------
 void AddGridBox(const char* Name)
 {
+    int reuse = ObjectSlots_Acquire(GridBoxSlots, IndexType::GridBox);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.GridBoxPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.GridBoxSize, reuse, { 1,1,1,1 });
+        Vec4_Set(&g_ObjectPool.GridBoxAngle, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.GridBoxColor, reuse, { 1,1,1,1 });
+        KeyMap_SetKey(&g_ObjectPool.GridBoxMap, reuse, Name);
+        VecBool_Set(&g_ObjectPool.GridBoxAlive, reuse, true);
+        return;
+    }
     Vec4_PushBack(&g_ObjectPool.GridBoxPos, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.GridBoxSize, { 1,1,1,1 });
     Vec4_PushBack(&g_ObjectPool.GridBoxAngle, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.GridBoxColor, { 1,1,1,1 });
     KeyMap_Add(&g_ObjectPool.GridBoxMap, Name);
+    VecBool_PushBack(&g_ObjectPool.GridBoxAlive, true);
     GridBoxIndex++;
     ObjectIdx.GridBoxIndex = GridBoxIndex;
 
     NotifyAddObject(IndexType::GridBox);
 }
+void RemoveGridBox(const char* Name)
+{
+    RemoveObjectByName(IndexType::GridBox, Name, "RemoveGridBox: not found ");
+}
 void SetGridBoxPos(const char* Name, float x, float y, float z)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.GridBoxMap, Name);
     if (idx < 0) { AddMessage(ConcatCStr("SetGridBoxPos: not found ", Name)); return; }
     Vec4_Set(&g_ObjectPool.GridBoxPos, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::GridBox, idx);
 }
 void SetGridBoxSize(const char* Name, float x, float y, float z)
 {
@@ -382,6 +983,7 @@ void SetGridBoxAngle(const char* Name, float x, float y, float z)
     int idx = KeyMap_GetIndex(&g_ObjectPool.GridBoxMap, Name);
     if (idx < 0) { AddMessage(ConcatCStr("SetGridBoxAngle: not found ", Name)); return; }
     Vec4_Set(&g_ObjectPool.GridBoxAngle, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::GridBox, idx);
 }
 void SetGridBoxColor(const char* Name, float R, float G, float B, float A)
 {
@@ -392,20 +994,37 @@ void SetGridBoxColor(const char* Name, float R, float G, float B, float A)
 
 void AddGridPolygon(const char* Name)
 {
+    int reuse = ObjectSlots_Acquire(GridPolygonSlots, IndexType::GridPolygon);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.GridPolygonPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.GridPolygonSize, reuse, { 1,1,1,1 });
+        Vec4_Set(&g_ObjectPool.GridPolygonAngle, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.GridPolygonColor, reuse, { 0,0,0,1 });
+        VecInt_Set(&g_ObjectPool.GridPolygonSides, reuse, 4);
+        KeyMap_SetKey(&g_ObjectPool.GridPolygonMap, reuse, Name);
+        VecBool_Set(&g_ObjectPool.GridPolygonAlive, reuse, true);
+        return;
+    }
     Vec4_PushBack(&g_ObjectPool.GridPolygonPos, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.GridPolygonSize, { 1,1,1,1 });
     Vec4_PushBack(&g_ObjectPool.GridPolygonAngle, { 0,0,0,0 });
     Vec4_PushBack(&g_ObjectPool.GridPolygonColor, { 0,0,0,1 });
     VecInt_PushBack(&g_ObjectPool.GridPolygonSides, 4);
     KeyMap_Add(&g_ObjectPool.GridPolygonMap, Name);
+    VecBool_PushBack(&g_ObjectPool.GridPolygonAlive, true);
     GridPolygonIndex++;
     ObjectIdx.GridPolygonIndex = GridPolygonIndex;
 }
+void RemoveGridPolygon(const char* Name)
+{
+    RemoveObjectByName(IndexType::GridPolygon, Name, "RemoveGridPolygon: not found ");
+}
 void SetGridPolygonPos(const char* Name, float x, float y, float z)
 {
     int idx = KeyMap_GetIndex(&g_ObjectPool.GridPolygonMap, Name);
     if (idx < 0) { AddMessage(ConcatCStr("SetGridPolygonPos: not found ", Name)); return; }
     Vec4_Set(&g_ObjectPool.GridPolygonPos, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::GridPolygon, idx);
 }
 void SetGridPolygonColor(const char* Name, float R, float G, float B, float A)
 {
@@ -420,17 +1039,269 @@ void SetGridPolygonSides(const char* Name, int sides)
     VecInt_Set(&g_ObjectPool.GridPolygonSides, idx, sides);
 }
 
+//-----------------------------------------
+// Collider
+// |  箱・球・カプセルは同じ列に入れて形は BoxColliderShape で区別する
+//-----------------------------------------
+static void AddCollider(const char* Name, ColliderShape shape, Vec4 size)
+{
+    int reuse = ObjectSlots_Acquire(BoxColliderSlots, IndexType::BoxCollider);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.BoxColliderPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.BoxColliderSize, reuse, size);
+        Vec4_Set(&g_ObjectPool.BoxColliderAngle, reuse, { 0,0,0,0 });
+        VecInt_Set(&g_ObjectPool.BoxColliderShape, reuse, shape);
+        KeyMap_SetKey(&g_ObjectPool.BoxColliderMap, reuse, Name);
+        VecBool_Set(&g_ObjectPool.BoxColliderAlive, reuse, true);
+        return;
+    }
+    Vec4_PushBack(&g_ObjectPool.BoxColliderPos, { 0,0,0,0 });
+    Vec4_PushBack(&g_ObjectPool.BoxColliderSize, size);
+    Vec4_PushBack(&g_ObjectPool.BoxColliderAngle, { 0,0,0,0 });
+    VecInt_PushBack(&g_ObjectPool.BoxColliderShape, shape);
+    KeyMap_Add(&g_ObjectPool.BoxColliderMap, Name);
+    VecBool_PushBack(&g_ObjectPool.BoxColliderAlive, true);
+    BoxColliderIndex++;
+    ObjectIdx.BoxColliderIndex = BoxColliderIndex;
+    NotifyAddObject(IndexType::BoxCollider);
+}
+void AddBoxCollider(const char* Name)
+{
+    AddCollider(Name, ColliderShape_Box, { 1,1,1,0 });
+}
+void AddSphereCollider(const char* Name)
+{
+    AddCollider(Name, ColliderShape_Sphere, { 0.5f,0,0,0 });
+}
+void AddCapsuleCollider(const char* Name)
+{
+    AddCollider(Name, ColliderShape_Capsule, { 0.5f,1,0,0 });
+}
+void RemoveCollider(const char* Name)
+{
+    RemoveObjectByName(IndexType::BoxCollider, Name, "RemoveCollider: not found ");
+}
+void SetColliderPos(const char* Name, float x, float y, float z)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.BoxColliderMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetColliderPos: not found ", Name)); return; }
+    Vec4_Set(&g_ObjectPool.BoxColliderPos, idx, { x,y,z,0 });
+}
+void SetColliderSize(const char* Name, float x, float y, float z)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.BoxColliderMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetColliderSize: not found ", Name)); return; }
+    Vec4_Set(&g_ObjectPool.BoxColliderSize, idx, { x,y,z,0 });
+}
+void SetColliderAngle(const char* Name, float x, float y, float z)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.BoxColliderMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetColliderAngle: not found ", Name)); return; }
+    Vec4_Set(&g_ObjectPool.BoxColliderAngle, idx, { x,y,z,0 });
+}
+
+//-----------------------------------------
+// Model
+// |  Pool の行のみ（ModelPath はアセット名。メッシュは AssetManager から名前で引く）
+// |  メッシュは共有なのでシーンのストリーミングの対象外（削除した行は Sprite と同じく再利用する）
+//-----------------------------------------
+void AddModel(const char* Name, const char* pathName)
+{
+    int reuse = ObjectSlots_Acquire(ModelSlots, IndexType::Model);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.ModelPos, reuse, { 0,0,0,0 });
+        Vec4_Set(&g_ObjectPool.ModelSize, reuse, { 1,1,1,0 });
+        Vec4_Set(&g_ObjectPool.ModelAngle, reuse, { 0,0,0,0 });
+        VecC_Set(&g_ObjectPool.ModelPath, reuse, pathName ? pathName : "");
+        KeyMap_SetKey(&g_ObjectPool.ModelMap, reuse, Name);
+        KeyMap_SetKey(&g_ObjectPool.ModelMotionMap, reuse, "");
+        VecInt_Set(&g_ObjectPool.ModelMotionBlend, reuse, 0);
+        VecBool_Set(&g_ObjectPool.ModelAlive, reuse, true);
+        return;
+    }
+    Vec4_PushBack(&g_ObjectPool.ModelPos, { 0,0,0,0 });
+    Vec4_PushBack(&g_ObjectPool.ModelSize, { 1,1,1,0 });
+    Vec4_PushBack(&g_ObjectPool.ModelAngle, { 0,0,0,0 });
+    VecC_PushBack(&g_ObjectPool.ModelPath, pathName ? pathName : "");
+    KeyMap_Add(&g_ObjectPool.ModelMap, Name);
+    KeyMap_AppendEmpty(&g_ObjectPool.ModelMotionMap, 1);
+    VecInt_PushBack(&g_ObjectPool.ModelMotionBlend, 0);
+    VecBool_PushBack(&g_ObjectPool.ModelAlive, true);
+    ModelIndex++;
+    ObjectIdx.ModelIndex = ModelIndex;
+}
+void RemoveModel(const char* name)
+{
+    RemoveObjectByName(IndexType::Model, name, "RemoveModel : model not found");
+}
+void SetModelPos(const char* Name, float x, float y, float z)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.ModelMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetModelPos: not found ", Name)); return; }
+    Vec4_Set(&g_ObjectPool.ModelPos, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::Model, idx);
+}
+void SetModelSize(const char* Name, float x, float y, float z)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.ModelMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetModelSize: not found ", Name)); return; }
+    Vec4_Set(&g_ObjectPool.ModelSize, idx, { x,y,z,0 });
+}
+void SetModelAngle(const char* Name, float x, float y, float z)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.ModelMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetModelAngle: not found ", Name)); return; }
+    Vec4_Set(&g_ObjectPool.ModelAngle, idx, { x,y,z,0 });
+    Transform_MarkDirty(IndexType::Model, idx);
+}
+// モーションの切り替え（Attack: 切り替えにかけるフレーム数。0 で即座に）
+// |  反映は DrawScene（pathName のクリップはそこで読み込む）
+void SetModelMotion(const char* Name, const char* pathName, int Attack)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.ModelMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetModelMotion: not found ", Name)); return; }
+    if (pathName && *pathName && !GetModelClip(pathName)) { AddMessage(ConcatCStr("SetModelMotion: no animation ", pathName)); return; }
+    KeyMap_SetKey(&g_ObjectPool.ModelMotionMap, idx, pathName ? pathName : "");
+    VecInt_Set(&g_ObjectPool.ModelMotionBlend, idx, Attack < 0 ? 0 : Attack);
+}
+
+//-----------------------------------------
+// Effect
+// |  Pool は発生源の位置とテクスチャのみ（粒子と設定は EffectManager）
+// |  シーン単位の範囲を持ち、削除した行は Sprite と同じく再利用する（テクスチャはストリーミングの対象外）
+//-----------------------------------------
+void AddEffect(const char* Name, const char* texturePath)
+{
+    int reuse = ObjectSlots_Acquire(EffectSlots, IndexType::Effect);
+    if (reuse >= 0) {
+        Vec4_Set(&g_ObjectPool.EffectPos, reuse, { 0,0,0,0 });
+        KeyMap_SetKey(&g_ObjectPool.EffectMap, reuse, Name);
+        KeyMap_SetKey(&g_ObjectPool.EffectTexturePathMap, reuse, texturePath ? texturePath : "");
+        VecBool_Set(&g_ObjectPool.EffectAlive, reuse, true);
+        Effect_OnAdd(reuse);
+        return;
+    }
+    Vec4_PushBack(&g_ObjectPool.EffectPos, { 0,0,0,0 });
+    KeyMap_Add(&g_ObjectPool.EffectMap, Name);
+    KeyMap_Push(&g_ObjectPool.EffectTexturePathMap, texturePath ? texturePath : "");
+    VecBool_PushBack(&g_ObjectPool.EffectAlive, true);
+    Effect_OnAdd(EffectIndex);
+    EffectIndex++;
+    ObjectIdx.EffectIndex = EffectIndex;
+}
+void RemoveEffect(const char* name)
+{
+    RemoveObjectByName(IndexType::Effect, name, "RemoveEffect : effect not found");
+}
+void SetEffectPos(const char* Name, float x, float y, float z)
+{
+    int idx = KeyMap_GetIndex(&g_ObjectPool.EffectMap, Name);
+    if (idx < 0) { AddMessage(ConcatCStr("SetEffectPos: not found ", Name)); return; }
+    Vec4_Set(&g_ObjectPool.EffectPos, idx, { x,y,z,0 });
+}
+
+
+// プールの名前・テクスチャからコンポーネントを組み直して有効に戻す（Release 済みなら Init から）
+static void RestoreComponent(IndexType type, int idx)
+{
+    ObjectTypeInfo t;
+    if (!ObjectType_Get(type, &t)) return;
+    Component* c = GetComponentAt(type, idx);
+    if (!c || !IsObjectAlive(type, idx)) return;
+    if (ObjectSlots_TakeReleased(*t.Slots, idx)) c->Init();
+
+    ObjectDataPool* p = &g_ObjectPool;
+    switch (type)
+    {
+    case IndexType::SpriteWorld:
+        static_cast<SpriteWorld*>(c)->SetTexture(KeyMap_GetKey(&p->SpriteWorldTexturePathMap, idx));
+        break;
+    case IndexType::SpriteScreen:
+        static_cast<SpriteScreen*>(c)->SetTexture(KeyMap_GetKey(&p->SpriteScreenTexturePathMap, idx));
+        break;
+    case IndexType::SpriteBox:
+    {
+        SpriteBox* box = static_cast<SpriteBox*>(c);
+        box->SetTextureTop(KeyMap_GetKey(&p->SpriteBoxTopTexturePathMap, idx));
+        box->SetTextureBottom(KeyMap_GetKey(&p->SpriteBoxBottomTexturePathMap, idx));
+        box->SetTextureFront(KeyMap_GetKey(&p->SpriteBoxFrontTexturePathMap, idx));
+        box->SetTextureRear(KeyMap_GetKey(&p->SpriteBoxRearTexturePathMap, idx));
+        box->SetTextureLeft(KeyMap_GetKey(&p->SpriteBoxLeftTexturePathMap, idx));
+        box->SetTextureRight(KeyMap_GetKey(&p->SpriteBoxRightTexturePathMap, idx));
+        break;
+    }
+    case IndexType::SpriteCylinder:
+    {
+        SpriteCylinder* cylinder = static_cast<SpriteCylinder*>(c);
+        cylinder->SetTopTexture(KeyMap_GetKey(&p->SpriteCylinderTopTexturePathMap, idx));
+        cylinder->SetBottomTexture(KeyMap_GetKey(&p->SpriteCylinderBottomTexturePathMap, idx));
+        cylinder->SetSideTexture(KeyMap_GetKey(&p->SpriteCylinderSideTexturePathMap, idx));
+        break;
+    }
+    case IndexType::Model:
+    {
+        Model* model = static_cast<Model*>(c);
+        model->Release();       // 前のモデルのモーションを捨てる（メッシュは共有）
+        model->SetModelPath(VecC_Get(&p->ModelPath, idx));
+        break;
+    }
+    case IndexType::Effect:
+        static_cast<Effect*>(c)->SetEffect(idx, KeyMap_GetKey(&p->EffectTexturePathMap, idx));
+        break;
+    default:
+        break;
+    }
+    c->Enabled = true;
+}
+
+// 再利用したスロットを組み直す（新しい名前・テクスチャで）
+static void ReviveComponents()
+{
+    const IndexType types[] = { IndexType::Camera, IndexType::SpriteWorld, IndexType::SpriteScreen,
+                                IndexType::SpriteBox, IndexType::SpriteCylinder, IndexType::GridBox, IndexType::GridPolygon,
+                                IndexType::BoxCollider, IndexType::Model, IndexType::Effect };
+    for (IndexType type : types)
+    {
+        ObjectTypeInfo t;
+        if (!ObjectType_Get(type, &t)) continue;
+        bool streamed = type != IndexType::Model && type != IndexType::Effect;   // Model / Effect は読み込みを待たない
+        for (int idx : t.Slots->Revive)
+            if (!streamed || IsSceneSlotLoaded(type, idx)) RestoreComponent(type, idx);
+        t.Slots->Revive.clear();
+    }
+}
+
+// シーンの解放：GPU リソースを捨てて無効化（プールのデータと名前は残す）
+void ReleaseObjectResources(IndexType type, int index)
+{
+    ObjectTypeInfo t;
+    if (!ObjectType_Get(type, &t)) return;
+    Component* c = GetComponentAt(type, index);
+    if (!c || !IsObjectAlive(type, index)) return;
+    if (index < (int)t.Slots->Released.size() && t.Slots->Released[index]) return;
+
+    c->Enabled = false;
+    c->Release();
+    if ((int)t.Slots->Released.size() <= index) t.Slots->Released.resize(index + 1, 0);
+    t.Slots->Released[index] = 1;
+}
+
+void RestoreObjectResources(IndexType type, int index)
+{
+    RestoreComponent(type, index);
+}
 
 // オブジェクトの作成・管理
 void CreateObject()
 {
 	//※ コンポーネント(ObjectClass内)のみ追加する
     if (!object) return;
+    LIA_PROFILE_SCOPE("CreateObject");
 
 	// Camera
     while (CameraOldIdx < CameraIndex) 
     {
-        object->AddComponent<Camera>();
+        object->AddComponent<Camera>()->Enabled = IsObjectAlive(IndexType::Camera, CameraOldIdx);
         CameraOldIdx++;
     }
     //SpriteWorld
@@ -438,14 +1309,21 @@ void CreateObject()
     {
         const char* texPath = KeyMap_GetKey(&g_ObjectPool.SpriteWorldTexturePathMap, SpriteWorldOldIndex);
 
-        object->AddComponent<SpriteWorld>()->SetTexture(texPath);
+        // 未読み込みのシーンはテクスチャを後回し（読み込み時に RestoreObjectResources）
+        bool loaded = IsSceneSlotLoaded(IndexType::SpriteWorld, SpriteWorldOldIndex);
+        SpriteWorld* sprite = object->AddComponent<SpriteWorld>();
+        if (loaded) sprite->SetTexture(texPath);
+        sprite->Enabled = loaded && IsObjectAlive(IndexType::SpriteWorld, SpriteWorldOldIndex);
         SpriteWorldOldIndex++;
     }
     while (SpriteScreenOldIndex < SpriteScreenIndex)
     {
         const char* texPath = KeyMap_GetKey(&g_ObjectPool.SpriteScreenTexturePathMap, SpriteScreenOldIndex);
 
-        object->AddComponent<SpriteScreen>()->SetTexture(texPath);
+        bool loaded = IsSceneSlotLoaded(IndexType::SpriteScreen, SpriteScreenOldIndex);
+        SpriteScreen* sprite = object->AddComponent<SpriteScreen>();
+        if (loaded) sprite->SetTexture(texPath);
+        sprite->Enabled = loaded && IsObjectAlive(IndexType::SpriteScreen, SpriteScreenOldIndex);
         SpriteScreenOldIndex++;
     }
     while (SpriteBoxOldIndex < SpriteBoxIndex)
@@ -457,12 +1335,17 @@ void CreateObject()
         const char* leftTexPath   = KeyMap_GetKey(&g_ObjectPool.SpriteBoxLeftTexturePathMap, SpriteBoxOldIndex);
         const char* rightTexPath  = KeyMap_GetKey(&g_ObjectPool.SpriteBoxRightTexturePathMap, SpriteBoxOldIndex);
 
-        object->AddComponent<SpriteBox>()->SetTextureTop(topTexPath);
-        object->GetComponent<SpriteBox>(SpriteBoxOldIndex)->SetTextureBottom(bottomTexPath);
-        object->GetComponent<SpriteBox>(SpriteBoxOldIndex)->SetTextureFront(frontTexPath);
-        object->GetComponent<SpriteBox>(SpriteBoxOldIndex)->SetTextureRear(rearTexPath);
-        object->GetComponent<SpriteBox>(SpriteBoxOldIndex)->SetTextureLeft(leftTexPath);
-        object->GetComponent<SpriteBox>(SpriteBoxOldIndex)->SetTextureRight(rightTexPath);
+        bool loaded = IsSceneSlotLoaded(IndexType::SpriteBox, SpriteBoxOldIndex);
+        SpriteBox* box = object->AddComponent<SpriteBox>();
+        if (loaded) {
+            box->SetTextureTop(topTexPath);
+            box->SetTextureBottom(bottomTexPath);
+            box->SetTextureFront(frontTexPath);
+            box->SetTextureRear(rearTexPath);
+            box->SetTextureLeft(leftTexPath);
+            box->SetTextureRight(rightTexPath);
+        }
+        box->Enabled = loaded && IsObjectAlive(IndexType::SpriteBox, SpriteBoxOldIndex);
 
         SpriteBoxOldIndex++;
     }
@@ -472,24 +1355,58 @@ void CreateObject()
         const char* bottomTexPath = KeyMap_GetKey(&g_ObjectPool.SpriteCylinderBottomTexturePathMap, SpriteCylinderOldIndex);
         const char* sideTexPath = KeyMap_GetKey(&g_ObjectPool.SpriteCylinderSideTexturePathMap, SpriteCylinderOldIndex);
 
-        object->AddComponent<SpriteCylinder>()->SetTopTexture(topTexPath);
-        object->GetComponent<SpriteCylinder>(SpriteCylinderOldIndex)->SetBottomTexture(bottomTexPath);
-        object->GetComponent<SpriteCylinder>(SpriteCylinderOldIndex)->SetSideTexture(sideTexPath);
+        bool loaded = IsSceneSlotLoaded(IndexType::SpriteCylinder, SpriteCylinderOldIndex);
+        SpriteCylinder* cylinder = object->AddComponent<SpriteCylinder>();
+        if (loaded) {
+            cylinder->SetTopTexture(topTexPath);
+            cylinder->SetBottomTexture(bottomTexPath);
+            cylinder->SetSideTexture(sideTexPath);
+        }
+        cylinder->Enabled = loaded && IsObjectAlive(IndexType::SpriteCylinder, SpriteCylinderOldIndex);
 
         SpriteCylinderOldIndex++;
     }
+    //Model（メッシュは AssetManager で共有）
+    while (ModelOldIndex < ModelIndex)
+    {
+        Model* model = object->AddComponent<Model>();
+        model->SetModelPath(VecC_Get(&g_ObjectPool.ModelPath, ModelOldIndex));
+        model->Enabled = IsObjectAlive(IndexType::Model, ModelOldIndex);
+        ModelOldIndex++;
+    }
+    //Effect（行の番号で粒子を引く）
+    while (EffectOldIndex < EffectIndex)
+    {
+        Effect* effect = object->AddComponent<Effect>();
+        effect->SetEffect(EffectOldIndex, KeyMap_GetKey(&g_ObjectPool.EffectTexturePathMap, EffectOldIndex));
+        effect->Enabled = IsObjectAlive(IndexType::Effect, EffectOldIndex);
+        EffectOldIndex++;
+    }
+
+    // 再利用したスロット（新しい名前・テクスチャで組み直す）
+    ReviveComponents();
 }
 
 
 //-----------------------------------------
 // ライフサイクル
 //-----------------------------------------
+static void ObjectSlots_Clear()
+{
+    ObjectSlots* all[] = { &CameraSlots, &SpriteWorldSlots, &SpriteScreenSlots, &SpriteBoxSlots,
+                           &SpriteCylinderSlots, &GridBoxSlots, &GridPolygonSlots, &BoxColliderSlots, &ModelSlots, &EffectSlots };
+    for (ObjectSlots* s : all) { s->Free.clear(); s->Revive.clear(); s->Released.clear(); }
+}
+
 void InitDo()
 {
+    // ジョブシステム（2回目以降は何もしない）
+    Job_Init();
+
     // インデックス初期化・ObjectIdx リセット
     UseCamera = -1;
-    CameraIndex = UIIndex = SpriteWorldIndex = ModelIndex = BoxColliderIndex = GridBoxIndex = GridPolygonIndex = 0;
-    CameraOldIdx = UIOldIndex = SpriteWorldOldIndex = ModelOldIndex = BoxColliderOldIndex = GridBoxOldIndex = GridPolygonOldIndex = 0;
+    CameraIndex = UIIndex = SpriteWorldIndex = ModelIndex = BoxColliderIndex = GridBoxIndex = GridPolygonIndex = EffectIndex = 0;
+    CameraOldIdx = UIOldIndex = SpriteWorldOldIndex = ModelOldIndex = BoxColliderOldIndex = GridBoxOldIndex = GridPolygonOldIndex = EffectOldIndex = 0;
 
     ObjectIdx.CameraIndex = 0;
     ObjectIdx.SpriteWorldIndex = 0;
@@ -526,11 +1443,14 @@ void InitDo()
     Vec4_Init(&p->ModelPos);
     Vec4_Init(&p->ModelSize);
     Vec4_Init(&p->ModelAngle);
+    // Effect
+    Vec4_Init(&p->EffectPos);
 
     // BoxCollider
     Vec4_Init(&p->BoxColliderPos);
     Vec4_Init(&p->BoxColliderSize);
     Vec4_Init(&p->BoxColliderAngle);
+    VecInt_Init(&p->BoxColliderShape);
 
     // Grid Box / Polygon
     Vec4_Init(&p->GridBoxPos);
@@ -542,6 +1462,12 @@ void InitDo()
     Vec4_Init(&p->GridPolygonSize);
     Vec4_Init(&p->GridPolygonAngle);
     Vec4_Init(&p->GridPolygonColor);
+    VecMat_Init(&p->SpriteWorldMatrix);
+    VecMat_Init(&p->SpriteBoxMatrix);
+    VecMat_Init(&p->SpriteCylinderMatrix);
+    VecMat_Init(&p->GridBoxMatrix);
+    VecMat_Init(&p->GridPolygonMatrix);
+    VecMat_Init(&p->ModelMatrix);
 
     // Int/Char/Bool vectors
     VecInt_Init(&p->GridPolygonSides);
@@ -554,6 +1480,10 @@ void InitDo()
     // KeyMaps
     KeyMap_Init(&p->CameraMap);
     KeyMap_Init(&p->ModelMap);
+    KeyMap_Init(&p->ModelMotionMap);
+    KeyMap_Init(&p->EffectMap);
+    KeyMap_Init(&p->EffectTexturePathMap);
+    VecInt_Init(&p->ModelMotionBlend);
     KeyMap_Init(&p->TextureMap);
     KeyMap_Init(&p->SpriteWorldMap);
     KeyMap_Init(&p->UIMap);
@@ -563,6 +1493,20 @@ void InitDo()
     KeyMap_Init(&p->SpriteWorldTexturePathMap);
     KeyMap_Init(&p->SpriteScreenTexturePathMap);
 
+    // 生存フラグ
+    VecBool_Init(&p->CameraAlive);
+    VecBool_Init(&p->SpriteWorldAlive);
+    VecBool_Init(&p->SpriteScreenAlive);
+    VecBool_Init(&p->SpriteScreenOpaque);
+    VecBool_Init(&p->SpriteBoxAlive);
+    VecBool_Init(&p->SpriteCylinderAlive);
+    VecBool_Init(&p->GridBoxAlive);
+    VecBool_Init(&p->GridPolygonAlive);
+    VecBool_Init(&p->BoxColliderAlive);
+    VecBool_Init(&p->ModelAlive);
+    VecBool_Init(&p->EffectAlive);
+    ObjectSlots_Clear();
+
     ShaderManager_Init();
 
     // クラス取得
@@ -576,15 +1520,21 @@ void InitDo()
 
 void UpdateDo()
 {
+    LIA_PROFILE_SCOPE("UpdateDo");
+    Job_PumpMainThread();   // 非同期ロードの GPU 登録など
     ShaderManager_Update();
 
     CreateObject();
     UpdateScene();
+    UpdateTweens((float)GameLoop_GetStep());
+    UpdateReels((float)GameLoop_GetStep());
+    UpdateEffects((float)GameLoop_GetStep());
     object->Update();
 }
 
 void DrawDo()
 {
+    LIA_PROFILE_SCOPE("DrawDo");
     DrawScene();
     object->Draw();
 }
@@ -608,10 +1558,12 @@ void ReleaseDo()
     Vec4_Free(&p->ModelPos);
     Vec4_Free(&p->ModelSize);
     Vec4_Free(&p->ModelAngle);
+    Vec4_Free(&p->EffectPos);
 
     Vec4_Free(&p->BoxColliderPos);
     Vec4_Free(&p->BoxColliderSize);
     Vec4_Free(&p->BoxColliderAngle);
+    VecInt_Free(&p->BoxColliderShape);
 
     Vec4_Free(&p->GridBoxPos);
     Vec4_Free(&p->GridBoxSize);
@@ -622,6 +1574,12 @@ void ReleaseDo()
     Vec4_Free(&p->GridPolygonSize);
     Vec4_Free(&p->GridPolygonAngle);
     Vec4_Free(&p->GridPolygonColor);
+    VecMat_Free(&p->SpriteWorldMatrix);
+    VecMat_Free(&p->SpriteBoxMatrix);
+    VecMat_Free(&p->SpriteCylinderMatrix);
+    VecMat_Free(&p->GridBoxMatrix);
+    VecMat_Free(&p->GridPolygonMatrix);
+    VecMat_Free(&p->ModelMatrix);
 
     VecInt_Free(&p->GridPolygonSides);
     VecC_Free(&p->TexturePath);
@@ -632,6 +1590,10 @@ void ReleaseDo()
 
     KeyMap_Free(&p->CameraMap);
     KeyMap_Free(&p->ModelMap);
+    KeyMap_Free(&p->ModelMotionMap);
+    KeyMap_Free(&p->EffectMap);
+    KeyMap_Free(&p->EffectTexturePathMap);
+    VecInt_Free(&p->ModelMotionBlend);
     KeyMap_Free(&p->TextureMap);
     KeyMap_Free(&p->SpriteWorldMap);
     KeyMap_Free(&p->UIMap);
@@ -639,9 +1601,40 @@ void ReleaseDo()
     KeyMap_Free(&p->GridBoxMap);
     KeyMap_Free(&p->GridPolygonMap);
 
+    VecBool_Free(&p->CameraAlive);
+    VecBool_Free(&p->SpriteWorldAlive);
+    VecBool_Free(&p->SpriteScreenAlive);
+    VecBool_Free(&p->SpriteScreenOpaque);
+    VecBool_Free(&p->SpriteBoxAlive);
+    VecBool_Free(&p->SpriteCylinderAlive);
+    VecBool_Free(&p->GridBoxAlive);
+    VecBool_Free(&p->GridPolygonAlive);
+    VecBool_Free(&p->BoxColliderAlive);
+    VecBool_Free(&p->ModelAlive);
+    VecBool_Free(&p->EffectAlive);
+    ObjectSlots_Clear();
+    ReleasePrefabs();
+    ReleaseTransforms();
+    ReleaseCulling();
+    ReleaseSpatialIndex();
+    ReleaseCollision();
+    ReleaseScreenGrid();
+    ReleaseAnimClips();
+    ReleaseTweens();
+    ReleaseReels();
+    ReleaseEffects();
+
     // オブジェクト解放
     if (object) { delete object; object = nullptr; }
+    SpriteWorld::ReleaseShared();
+    SpriteBox::ReleaseShared();
+    SpriteCylinder::ReleaseShared();
+    Model::ReleaseShared();
+    Effect::ReleaseShared();
     if (grid) { delete grid; grid = nullptr; }
+
+    Job_Shutdown();
+    ReleaseFrameArena();
 }
 
 void OutObjectIndex(ObjectIndex* out)
@@ -0,0 +1,382 @@
+﻿// PrefabManager.cpp
+// Prefab（オブジェクトのひな形）の作成と一括生成
+// |  既存オブジェクトの Pool の値を丸ごと控えておき、InstantiatePrefab でまとめて追加する
+// |  追加は型ごとに AcquireObjectRows で一括（名前検索なし）。コンポーネントは次の CreateObject で生成
+// |  名前は "<prefix><番号>/<元の名前>"、座標は PrefabTransform で回転・移動し、角度は回転を合成して戻す
+// __________________________________________
+
+#include "Manager.h"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+#define PREFAB_TEXTURE_MAX 6
+
+struct PrefabObject {
+    IndexType Type;
+    std::string Name;
+    Vec4 Pos, Size, Angle, Color;
+    int Value;                                  // SpriteScreen: 角度 / SpriteCylinder: 分割数 / GridPolygon: 辺の数
+    bool Opaque;                                // SpriteScreen のみ
+    std::string Texture[PREFAB_TEXTURE_MAX];    // SpriteWorld/Screen: [0] / Cylinder: 上,下,側面 / Box: 上,下,前,後,左,右
+};
+
+struct Prefab {
+    std::vector<PrefabObject> Objects;
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static KeyMap PrefabMap;
+static std::vector<Prefab> g_Prefabs;
+
+static const IndexType PrefabTypes[] = {
+    IndexType::SpriteWorld, IndexType::SpriteScreen, IndexType::SpriteBox,
+    IndexType::SpriteCylinder, IndexType::GridBox, IndexType::GridPolygon,
+};
+
+//-----------------------------------------
+// Pool との読み書き
+//-----------------------------------------
+static void Prefab_SetTexture(std::string& dst, KeyMap* map, int index)
+{
+    const char* key = KeyMap_GetKey(map, index);
+    dst = key ? key : "";
+}
+
+static bool Prefab_Capture(IndexType type, int index, PrefabObject* o)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    o->Type = type;
+    o->Value = 0;
+    o->Opaque = false;
+    switch (type)
+    {
+    case IndexType::SpriteWorld:
+        o->Pos = Vec4_Get(&p->SpriteWorldPos, index);
+        o->Size = Vec4_Get(&p->SpriteWorldSize, index);
+        o->Angle = Vec4_Get(&p->SpriteWorldAngle, index);
+        o->Color = Vec4_Get(&p->SpriteWorldColor, index);
+        Prefab_SetTexture(o->Texture[0], &p->SpriteWorldTexturePathMap, index);
+        break;
+    case IndexType::SpriteScreen:
+        o->Pos = Vec4_Get(&p->SpriteScreenPos, index);
+        o->Size = Vec4_Get(&p->SpriteScreenSize, index);
+        o->Angle = { 0,0,0,0 };
+        o->Color = Vec4_Get(&p->SpriteScreenColor, index);
+        o->Value = VecInt_Get(&p->SpriteScreenAngle, index);
+        o->Opaque = VecBool_Get(&p->SpriteScreenOpaque, index);
+        Prefab_SetTexture(o->Texture[0], &p->SpriteScreenTexturePathMap, index);
+        break;
+    case IndexType::SpriteBox:
+        o->Pos = Vec4_Get(&p->SpriteBoxPos, index);
+        o->Size = Vec4_Get(&p->SpriteBoxSize, index);
+        o->Angle = Vec4_Get(&p->SpriteBoxAngle, index);
+        o->Color = Vec4_Get(&p->SpriteBoxColor, index);
+        Prefab_SetTexture(o->Texture[0], &p->SpriteBoxTopTexturePathMap, index);
+        Prefab_SetTexture(o->Texture[1], &p->SpriteBoxBottomTexturePathMap, index);
+        Prefab_SetTexture(o->Texture[2], &p->SpriteBoxFrontTexturePathMap, index);
+        Prefab_SetTexture(o->Texture[3], &p->SpriteBoxRearTexturePathMap, index);
+        Prefab_SetTexture(o->Texture[4], &p->SpriteBoxLeftTexturePathMap, index);
+        Prefab_SetTexture(o->Texture[5], &p->SpriteBoxRightTexturePathMap, index);
+        break;
+    case IndexType::SpriteCylinder:
+        o->Pos = Vec4_Get(&p->SpriteCylinderPos, index);
+        o->Size = Vec4_Get(&p->SpriteCylinderSize, index);
+        o->Angle = Vec4_Get(&p->SpriteCylinderAngle, index);
+        o->Color = Vec4_Get(&p->SpriteCylinderColor, index);
+        o->Value = VecInt_Get(&p->SpriteCylinderSegment, index);
+        Prefab_SetTexture(o->Texture[0], &p->SpriteCylinderTopTexturePathMap, index);
+        Prefab_SetTexture(o->Texture[1], &p->SpriteCylinderBottomTexturePathMap, index);
+        Prefab_SetTexture(o->Texture[2], &p->SpriteCylinderSideTexturePathMap, index);
+        break;
+    case IndexType::GridBox:
+        o->Pos = Vec4_Get(&p->GridBoxPos, index);
+        o->Size = Vec4_Get(&p->GridBoxSize, index);
+        o->Angle = Vec4_Get(&p->GridBoxAngle, index);
+        o->Color = Vec4_Get(&p->GridBoxColor, index);
+        break;
+    case IndexType::GridPolygon:
+        o->Pos = Vec4_Get(&p->GridPolygonPos, index);
+        o->Size = Vec4_Get(&p->GridPolygonSize, index);
+        o->Angle = Vec4_Get(&p->GridPolygonAngle, index);
+        o->Color = Vec4_Get(&p->GridPolygonColor, index);
+        o->Value = VecInt_Get(&p->GridPolygonSides, index);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+static void Prefab_SetKey(KeyMap* map, int index, const std::string& key)
+{
+    if (key.empty()) KeyMap_Remove(map, index);
+    else KeyMap_SetKey(map, index, key.c_str());
+}
+
+// index の行へ書き込む（Pool は AcquireObjectRows で確保済み）
+static void Prefab_Write(const PrefabObject& o, int index, const char* name, Vec4 pos, Vec4 angle)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    switch (o.Type)
+    {
+    case IndexType::SpriteWorld:
+        p->SpriteWorldPos.data[index] = pos;
+        p->SpriteWorldSize.data[index] = o.Size;
+        p->SpriteWorldAngle.data[index] = angle;
+        p->SpriteWorldColor.data[index] = o.Color;
+        KeyMap_SetKey(&p->SpriteWorldMap, index, name);
+        Prefab_SetKey(&p->SpriteWorldTexturePathMap, index, o.Texture[0]);
+        break;
+    case IndexType::SpriteScreen:
+        p->SpriteScreenPos.data[index] = pos;
+        p->SpriteScreenSize.data[index] = o.Size;
+        p->SpriteScreenColor.data[index] = o.Color;
+        p->SpriteScreenAngle.data[index] = o.Value;
+        p->SpriteScreenOpaque.data[index] = o.Opaque;
+        KeyMap_SetKey(&p->SpriteScreenMap, index, name);
+        Prefab_SetKey(&p->SpriteScreenTexturePathMap, index, o.Texture[0]);
+        break;
+    case IndexType::SpriteBox:
+        p->SpriteBoxPos.data[index] = pos;
+        p->SpriteBoxSize.data[index] = o.Size;
+        p->SpriteBoxAngle.data[index] = angle;
+        p->SpriteBoxColor.data[index] = o.Color;
+        KeyMap_SetKey(&p->SpriteBoxMap, index, name);
+        Prefab_SetKey(&p->SpriteBoxTopTexturePathMap, index, o.Texture[0]);
+        Prefab_SetKey(&p->SpriteBoxBottomTexturePathMap, index, o.Texture[1]);
+        Prefab_SetKey(&p->SpriteBoxFrontTexturePathMap, index, o.Texture[2]);
+        Prefab_SetKey(&p->SpriteBoxRearTexturePathMap, index, o.Texture[3]);
+        Prefab_SetKey(&p->SpriteBoxLeftTexturePathMap, index, o.Texture[4]);
+        Prefab_SetKey(&p->SpriteBoxRightTexturePathMap, index, o.Texture[5]);
+        break;
+    case IndexType::SpriteCylinder:
+        p->SpriteCylinderPos.data[index] = pos;
+        p->SpriteCylinderSize.data[index] = o.Size;
+        p->SpriteCylinderAngle.data[index] = angle;
+        p->SpriteCylinderColor.data[index] = o.Color;
+        p->SpriteCylinderSegment.data[index] = o.Value;
+        KeyMap_SetKey(&p->SpriteCylinderMap, index, name);
+        Prefab_SetKey(&p->SpriteCylinderTopTexturePathMap, index, o.Texture[0]);
+        Prefab_SetKey(&p->SpriteCylinderBottomTexturePathMap, index, o.Texture[1]);
+        Prefab_SetKey(&p->SpriteCylinderSideTexturePathMap, index, o.Texture[2]);
+        break;
+    case IndexType::GridBox:
+        p->GridBoxPos.data[index] = pos;
+        p->GridBoxSize.data[index] = o.Size;
+        p->GridBoxAngle.data[index] = angle;
+        p->GridBoxColor.data[index] = o.Color;
+        KeyMap_SetKey(&p->GridBoxMap, index, name);
+        break;
+    case IndexType::GridPolygon:
+        p->GridPolygonPos.data[index] = pos;
+        p->GridPolygonSize.data[index] = o.Size;
+        p->GridPolygonAngle.data[index] = angle;
+        p->GridPolygonColor.data[index] = o.Color;
+        p->GridPolygonSides.data[index] = o.Value;
+        KeyMap_SetKey(&p->GridPolygonMap, index, name);
+        break;
+    default:
+        break;
+    }
+}
+
+// 回転行列 → Angle（XMMatrixRotationRollPitchYaw の逆。X: pitch / Y: yaw / Z: roll）
+static Vec4 Prefab_MatrixToAngle(FXMMATRIX m, float w)
+{
+    XMFLOAT4X4 f;
+    XMStoreFloat4x4(&f, m);
+    float sp = -f._32;
+    if (sp > 1.0f) sp = 1.0f;
+    if (sp < -1.0f) sp = -1.0f;
+    float pitch = asinf(sp);
+    if (fabsf(sp) < 0.9999f) return { pitch, atan2f(f._31, f._33), atan2f(f._12, f._22), w };
+    return { pitch, atan2f(-f._13, f._11), 0.0f, w };  // 真上 / 真下向きは roll を yaw に寄せる
+}
+
+static Prefab* Prefab_Find(const char* name)
+{
+    int idx = name ? KeyMap_GetIndex(&PrefabMap, name) : -1;
+    return idx < 0 ? nullptr : &g_Prefabs[idx];
+}
+
+//-----------------------------------------
+// 作成
+//-----------------------------------------
+void CreatePrefab(const char* prefabName)
+{
+    if (!prefabName) return;
+    if (KeyMap_GetIndex(&PrefabMap, prefabName) >= 0) {
+        AddMessage(ConcatCStr("CreatePrefab: already exists ", prefabName));
+        return;
+    }
+    KeyMap_Add(&PrefabMap, prefabName);
+    g_Prefabs.emplace_back();
+}
+
+void AddPrefabObject(const char* prefabName, IndexType type, const char* objectName)
+{
+    Prefab* prefab = Prefab_Find(prefabName);
+    if (!prefab) { AddMessage(ConcatCStr("AddPrefabObject: prefab not found ", prefabName)); return; }
+
+    KeyMap* map = nullptr;
+    ObjectDataPool* p = GetObjectDataPool();
+    switch (type)
+    {
+    case IndexType::SpriteWorld:    map = &p->SpriteWorldMap;    break;
+    case IndexType::SpriteScreen:   map = &p->SpriteScreenMap;   break;
+    case IndexType::SpriteBox:      map = &p->SpriteBoxMap;      break;
+    case IndexType::SpriteCylinder: map = &p->SpriteCylinderMap; break;
+    case IndexType::GridBox:        map = &p->GridBoxMap;        break;
+    case IndexType::GridPolygon:    map = &p->GridPolygonMap;    break;
+    default:
+        AddMessage("AddPrefabObject: unsupported type");
+        return;
+    }
+    int idx = KeyMap_GetIndex(map, objectName);
+    if (idx < 0) { AddMessage(ConcatCStr("AddPrefabObject: object not found ", objectName)); return; }
+
+    PrefabObject o;
+    Prefab_Capture(type, idx, &o);
+    o.Name = objectName;
+    prefab->Objects.push_back(o);
+}
+
+// シーンの生存しているオブジェクトをまとめて控える（Camera は対象外）
+void CreatePrefabFromScene(const char* prefabName, const char* sceneName)
+{
+    CreatePrefab(prefabName);
+    Prefab* prefab = Prefab_Find(prefabName);
+    if (!prefab) return;
+
+    for (IndexType type : PrefabTypes) {
+        int begin = 0, end = 0;
+        if (!GetSceneRange(sceneName, type, &begin, &end)) {
+            AddMessage(ConcatCStr("CreatePrefabFromScene: scene not found ", sceneName));
+            return;
+        }
+        for (int i = begin; i < end; ++i) {
+            if (!IsObjectAlive(type, i)) continue;
+            PrefabObject o;
+            if (!Prefab_Capture(type, i, &o)) break;
+            const char* name = nullptr;
+            ObjectDataPool* p = GetObjectDataPool();
+            switch (type)
+            {
+            case IndexType::SpriteWorld:    name = KeyMap_GetKey(&p->SpriteWorldMap, i);    break;
+            case IndexType::SpriteScreen:   name = KeyMap_GetKey(&p->SpriteScreenMap, i);   break;
+            case IndexType::SpriteBox:      name = KeyMap_GetKey(&p->SpriteBoxMap, i);      break;
+            case IndexType::SpriteCylinder: name = KeyMap_GetKey(&p->SpriteCylinderMap, i); break;
+            case IndexType::GridBox:        name = KeyMap_GetKey(&p->GridBoxMap, i);        break;
+            case IndexType::GridPolygon:    name = KeyMap_GetKey(&p->GridPolygonMap, i);    break;
+            default: break;
+            }
+            o.Name = name ? name : "";
+            prefab->Objects.push_back(o);
+        }
+    }
+}
+
+int GetPrefabObjectCount(const char* prefabName)
+{
+    Prefab* prefab = Prefab_Find(prefabName);
+    return prefab ? (int)prefab->Objects.size() : 0;
+}
+
+//-----------------------------------------
+// 一括生成
+// |  型ごとに「数 × インスタンス数」の行を1回で確保し、値を直接書き込む
+// |  全ての型の行が揃ってから書き込む（どれかが確保できなければ確保済みの行を全て戻して 0）
+// |  transforms が NULL なら Prefab の値のまま（全インスタンス同じ位置）
+// |  戻り値: 生成したインスタンス数
+//-----------------------------------------
+int InstantiatePrefab(const char* prefabName, int count, const PrefabTransform* transforms, const char* namePrefix)
+{
+    Prefab* prefab = Prefab_Find(prefabName);
+    if (!prefab) { AddMessage(ConcatCStr("InstantiatePrefab: prefab not found ", prefabName)); return 0; }
+    if (count <= 0 || prefab->Objects.empty()) return 0;
+    if (!namePrefix) namePrefix = prefabName;
+
+    // インスタンスごとの回転（型の間で共有）
+    std::vector<XMMATRIX> rot;
+    if (transforms) {
+        rot.resize(count);
+        for (int i = 0; i < count; ++i)
+            rot[i] = XMMatrixRotationRollPitchYaw(transforms[i].Angle.X, transforms[i].Angle.Y, transforms[i].Angle.Z);
+    }
+
+    // 型ごとの対象と行（先に全ての型の行を確保する）
+    const int typeCount = (int)(sizeof(PrefabTypes) / sizeof(PrefabTypes[0]));
+    std::vector<const PrefabObject*> objs[typeCount];
+    std::vector<int> rows[typeCount];
+    for (int t = 0; t < typeCount; ++t) {
+        for (const PrefabObject& o : prefab->Objects)
+            if (o.Type == PrefabTypes[t]) objs[t].push_back(&o);
+        if (objs[t].empty()) continue;
+
+        int n = (int)objs[t].size() * count;
+        rows[t].resize(n);
+        int got = AcquireObjectRows(PrefabTypes[t], n, rows[t].data());
+        rows[t].resize(got > 0 ? got : 0);
+        if (got < n) {
+            AddMessage(ConcatCStr("InstantiatePrefab: failed to allocate rows ", prefabName));
+            for (int u = 0; u <= t; ++u)
+                for (int r : rows[u]) RemoveObjectAt(PrefabTypes[u], r, false);
+            return 0;
+        }
+    }
+
+    char name[256];
+    for (int t = 0; t < typeCount; ++t) {
+        int k = (int)objs[t].size();
+        if (k == 0) continue;
+
+        // テクスチャは追加先シーンのマニフェストへ（インスタンス数に関係なく1回）
+        for (const PrefabObject* o : objs[t])
+            for (const std::string& tex : o->Texture)
+                if (!tex.empty()) NotifySceneAsset(tex.c_str());
+
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < k; ++j) {
+                const PrefabObject& o = *objs[t][j];
+                Vec4 pos = o.Pos, angle = o.Angle;
+                if (transforms) {
+                    const PrefabTransform& tr = transforms[i];
+                    XMVECTOR v = XMVector3Transform(XMVectorSet(o.Pos.X, o.Pos.Y, o.Pos.Z, 0.0f), rot[i]);
+                    pos = { XMVectorGetX(v) + tr.Pos.X, XMVectorGetY(v) + tr.Pos.Y, XMVectorGetZ(v) + tr.Pos.Z, o.Pos.W };
+                    // 自身の回転 → インスタンスの回転の順に合成（座標と同じ向き）
+                    angle = Prefab_MatrixToAngle(XMMatrixRotationRollPitchYaw(o.Angle.X, o.Angle.Y, o.Angle.Z) * rot[i], o.Angle.W);
+                }
+                snprintf(name, sizeof(name), "%s%d/%s", namePrefix, i, o.Name.c_str());
+                Prefab_Write(o, rows[t][(size_t)i * k + j], name, pos, angle);
+            }
+        }
+    }
+    return count;
+}
+
+//-----------------------------------------
+// 解放
+//-----------------------------------------
+void DeletePrefab(const char* prefabName)
+{
+    int idx = prefabName ? KeyMap_GetIndex(&PrefabMap, prefabName) : -1;
+    if (idx < 0) { AddMessage(ConcatCStr("DeletePrefab: not found ", prefabName)); return; }
+    KeyMap_Remove(&PrefabMap, idx);
+    g_Prefabs[idx].Objects.clear();
+    g_Prefabs[idx].Objects.shrink_to_fit();
+}
+
+void ReleasePrefabs()
+{
+    KeyMap_Free(&PrefabMap);
+    g_Prefabs.clear();
+}
@@ -0,0 +1,233 @@
+﻿// ProfileManager.cpp
+// フレームプロファイラの実装
+// |  スレッドごとに固定長リングバッファを持ち、書き込みはオーナースレッドのみ（ロック無し）
+// |  フレーム境界はメインスレッドが記録し、書き出し時に保持範囲を決める
+// |  リングが一周して一部のゾーンが上書きされたフレームは書き出さない（欠けたフレームを出さない）
+// |  書き出しはフレーム境界（Profile_EndFrame後）で呼ぶことを想定
+// __________________________________________
+
+#include "Profiler.h"
+#include "Manager.h"
+
+#if defined(LIA_PROFILE)
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+
+#define PROFILE_MAX_THREADS 64
+#define PROFILE_MAX_EVENTS  16384   // スレッドごとの保持件数（2の累乗）
+#define PROFILE_MAX_FRAMES  128     // 保持フレーム数
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct ProfileEvent {
+    const char* Name;
+    long long Begin;
+    long long End;
+};
+
+struct ProfileThreadBuffer {
+    ProfileEvent Events[PROFILE_MAX_EVENTS];
+    std::atomic<unsigned> Write{ 0 };   // 書き込み位置（オーナースレッドのみ更新）
+    unsigned ThreadId = 0;
+    char Name[32] = {};
+};
+
+struct ProfileFrame {
+    long long Begin;
+    long long CpuEnd;   // Profile_EndCpu（Present の待ちを除く）
+    long long End;
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static std::atomic<ProfileThreadBuffer*> g_ProfileThreads[PROFILE_MAX_THREADS];
+static std::atomic<int> g_ProfileThreadCount{ 0 };
+static thread_local ProfileThreadBuffer* t_ProfileBuffer = nullptr;
+static thread_local bool t_ProfileRejected = false;
+
+// フレーム情報（メインスレッドのみ）
+static ProfileFrame g_ProfileFrames[PROFILE_MAX_FRAMES];
+static unsigned g_ProfileFrameCount = 0;
+static long long g_ProfileFrameBegin = 0;
+static long long g_ProfileCpuEnd = 0;       // 0: このフレームは Profile_EndCpu 無し
+static long long g_ProfileFreq = 0;
+
+static long long Profile_Freq()
+{
+    if (g_ProfileFreq == 0) {
+        g_ProfileFreq = System_GetTickFrequency();
+    }
+    return g_ProfileFreq;
+}
+
+// 呼び出しスレッドのバッファを取得（初回のみ登録）
+static ProfileThreadBuffer* Profile_GetThreadBuffer()
+{
+    if (t_ProfileBuffer) return t_ProfileBuffer;
+    if (t_ProfileRejected) return nullptr;
+
+    int slot = g_ProfileThreadCount.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= PROFILE_MAX_THREADS) {
+        t_ProfileRejected = true;
+        return nullptr;
+    }
+    ProfileThreadBuffer* buf = new ProfileThreadBuffer();
+    buf->ThreadId = System_GetThreadId();
+    snprintf(buf->Name, sizeof(buf->Name), "Thread %u", buf->ThreadId);
+    g_ProfileThreads[slot].store(buf, std::memory_order_release);
+    t_ProfileBuffer = buf;
+    return buf;
+}
+
+//-----------------------------------------
+// 記録
+//-----------------------------------------
+void Profile_RecordZone(const char* name, long long begin, long long end)
+{
+    ProfileThreadBuffer* buf = t_ProfileBuffer ? t_ProfileBuffer : Profile_GetThreadBuffer();
+    if (!buf) return;
+
+    unsigned w = buf->Write.load(std::memory_order_relaxed);
+    ProfileEvent& e = buf->Events[w & (PROFILE_MAX_EVENTS - 1)];
+    e.Name = name;
+    e.Begin = begin;
+    e.End = end;
+    buf->Write.store(w + 1, std::memory_order_release);
+}
+
+void Profile_SetThreadName(const char* name)
+{
+    ProfileThreadBuffer* buf = Profile_GetThreadBuffer();
+    if (!buf || !name) return;
+    snprintf(buf->Name, sizeof(buf->Name), "%s", name);   //長い名前は切り詰め
+}
+
+//-----------------------------------------
+// フレーム境界
+//-----------------------------------------
+void Profile_BeginFrame()
+{
+    if (g_ProfileFrameCount == 0) Profile_SetThreadName("Main");
+    g_ProfileFrameBegin = Profile_Now();
+    g_ProfileCpuEnd = 0;
+}
+
+void Profile_EndCpu()
+{
+    g_ProfileCpuEnd = Profile_Now();
+}
+
+void Profile_EndFrame()
+{
+    ProfileFrame& f = g_ProfileFrames[g_ProfileFrameCount % PROFILE_MAX_FRAMES];
+    f.Begin = g_ProfileFrameBegin;
+    f.End = Profile_Now();
+    f.CpuEnd = g_ProfileCpuEnd ? g_ProfileCpuEnd : f.End;
+    g_ProfileFrameCount++;
+}
+
+double Profile_GetLastFrameMs()
+{
+    if (g_ProfileFrameCount == 0) return 0.0;
+    const ProfileFrame& f = g_ProfileFrames[(g_ProfileFrameCount - 1) % PROFILE_MAX_FRAMES];
+    return (double)(f.CpuEnd - f.Begin) * 1000.0 / (double)Profile_Freq();
+}
+
+//-----------------------------------------
+// Chrome Trace 書き出し
+//-----------------------------------------
+static void Profile_WriteEscaped(FILE* fp, const char* s)
+{
+    for (; s && *s; ++s) {
+        if (*s == '"' || *s == '\\') fputc('\\', fp);
+        fputc(*s, fp);
+    }
+}
+
+bool Profile_DumpChromeTrace(const char* path)
+{
+    if (!path || g_ProfileFrameCount == 0) return false;
+
+    std::filesystem::path p(path);
+    if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
+
+    FILE* fp = System_FileOpen(path, "wb");
+    if (!fp) {
+        AddMessage(ConcatCStr("Profile_DumpChromeTrace: open failed ", path));
+        return false;
+    }
+
+    int threads = g_ProfileThreadCount.load(std::memory_order_acquire);
+    if (threads > PROFILE_MAX_THREADS) threads = PROFILE_MAX_THREADS;
+
+    // 一周したリングの最古のゾーンの終了時刻（これより前に終わったゾーンは上書き済みの可能性がある）
+    long long evicted = 0;
+    for (int t = 0; t < threads; ++t) {
+        ProfileThreadBuffer* buf = g_ProfileThreads[t].load(std::memory_order_acquire);
+        if (!buf) continue;
+        unsigned w = buf->Write.load(std::memory_order_acquire);
+        if (w <= PROFILE_MAX_EVENTS) continue;
+        long long end = buf->Events[(w - PROFILE_MAX_EVENTS) & (PROFILE_MAX_EVENTS - 1)].End;
+        if (end > evicted) evicted = end;
+    }
+
+    // 保持しているフレームのうち、ゾーンが欠けていない最古のフレームの開始時刻を基準にする（最低1フレームは出す）
+    unsigned frames = g_ProfileFrameCount < PROFILE_MAX_FRAMES ? g_ProfileFrameCount : PROFILE_MAX_FRAMES;
+    unsigned first = g_ProfileFrameCount - frames;
+    while (first + 1 < g_ProfileFrameCount && g_ProfileFrames[first % PROFILE_MAX_FRAMES].Begin < evicted) ++first;
+    long long origin = g_ProfileFrames[first % PROFILE_MAX_FRAMES].Begin;
+    double toUs = 1000000.0 / (double)Profile_Freq();
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fp);
+    fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}", fp);
+
+    // フレーム境界
+    for (unsigned i = first; i < g_ProfileFrameCount; ++i) {
+        const ProfileFrame& f = g_ProfileFrames[i % PROFILE_MAX_FRAMES];
+        fprintf(fp, ",\n{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+            i, (f.Begin - origin) * toUs, (f.End - f.Begin) * toUs);
+    }
+
+    // スレッドごとのゾーン
+    for (int t = 0; t < threads; ++t) {
+        ProfileThreadBuffer* buf = g_ProfileThreads[t].load(std::memory_order_acquire);
+        if (!buf) continue;
+
+        fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", buf->ThreadId);
+        Profile_WriteEscaped(fp, buf->Name);
+        fputs("\"}}", fp);
+
+        unsigned w = buf->Write.load(std::memory_order_acquire);
+        unsigned start = w > PROFILE_MAX_EVENTS ? w - PROFILE_MAX_EVENTS : 0;
+        for (unsigned i = start; i < w; ++i) {
+            const ProfileEvent& e = buf->Events[i & (PROFILE_MAX_EVENTS - 1)];
+            if (e.Begin < origin) continue;
+            fputs(",\n{\"name\":\"", fp);
+            Profile_WriteEscaped(fp, e.Name);
+            fprintf(fp, "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                buf->ThreadId, (e.Begin - origin) * toUs, (e.End - e.Begin) * toUs);
+        }
+    }
+
+    fputs("\n]}\n", fp);
+    fclose(fp);
+
+    AddMessage(ConcatCStr("Profile_DumpChromeTrace: ", path));
+    return true;
+}
+
+#else
+
+// LIA_PROFILE 無効時は何もしない
+void Profile_BeginFrame() {}
+void Profile_EndCpu() {}
+void Profile_EndFrame() {}
+void Profile_SetThreadName(const char*) {}
+bool Profile_DumpChromeTrace(const char*) { return false; }
+double Profile_GetLastFrameMs() { return 0.0; }
+
+#endif
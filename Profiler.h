@@ -0,0 +1,59 @@
+﻿// Profiler.h
+// フレームプロファイラ（CPUゾーン計測）
+// |  LIA_PROFILE_SCOPE("Name") でスコープ単位の計測を行う
+// |  スレッドごとのリングバッファへロックフリーで書き込む
+// |  Chrome Trace(JSON) 形式で書き出し可能 (chrome://tracing / Perfetto)
+// |  LIA_PROFILE 未定義時はマクロが空になり、計測コードは一切生成されない
+// __________________________________________
+
+#pragma once
+
+#if defined(LIA_PROFILE)
+
+#include "SystemAPI.h"
+
+// 計測用の時刻取得（System_GetTicks のティック）
+inline long long Profile_Now()
+{
+    return System_GetTicks();
+}
+
+// ゾーン1件を呼び出しスレッドのバッファへ記録
+void Profile_RecordZone(const char* name, long long begin, long long end);
+
+// スコープ計測用（コンストラクタで開始、デストラクタで記録）
+struct ProfileScope
+{
+    const char* Name;
+    long long Begin;
+    explicit ProfileScope(const char* name) : Name(name), Begin(Profile_Now()) {}
+    ~ProfileScope() { Profile_RecordZone(Name, Begin, Profile_Now()); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define LIA_PROFILE_CONCAT_IN(a, b) a##b
+#define LIA_PROFILE_CONCAT(a, b) LIA_PROFILE_CONCAT_IN(a, b)
+#define LIA_PROFILE_SCOPE(name) ProfileScope LIA_PROFILE_CONCAT(liaProfileScope_, __LINE__)(name)
+#define LIA_PROFILE_FRAME_BEGIN() Profile_BeginFrame()
+#define LIA_PROFILE_FRAME_END() Profile_EndFrame()
+#define LIA_PROFILE_CPU_END() Profile_EndCpu()
+#define LIA_PROFILE_THREAD(name) Profile_SetThreadName(name)
+
+#else
+
+#define LIA_PROFILE_SCOPE(name) ((void)0)
+#define LIA_PROFILE_FRAME_BEGIN() ((void)0)
+#define LIA_PROFILE_FRAME_END() ((void)0)
+#define LIA_PROFILE_CPU_END() ((void)0)
+#define LIA_PROFILE_THREAD(name) ((void)0)
+
+#endif
+
+//|| API ||___________________________
+void Profile_BeginFrame();                          //フレーム開始（メインループ先頭）
+void Profile_EndCpu();                              //CPU の処理の終わり（Present の直前。呼ばなければフレーム終了まで）
+void Profile_EndFrame();                            //フレーム終了（Present後）
+void Profile_SetThreadName(const char* name);       //呼び出しスレッドの表示名設定
+bool Profile_DumpChromeTrace(const char* path);     //保持中のフレームをChrome Trace形式で書き出し
+double Profile_GetLastFrameMs();                    //直前フレームのCPU時間(ms。Present / 垂直同期の待ちは含まない)
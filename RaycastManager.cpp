@@ -0,0 +1,264 @@
+﻿// RaycastManager.cpp
+// レイ判定とマウスでの選択
+// |  候補は SpatialManager のツリーから箱に入る距離の近い順に受け取り、形ごとに正確に判定する
+// |  一番近い当たりが次の候補の箱より手前なら打ち切る
+// |  形: SpriteWorld は板（ローカル XY 面）、SpriteBox / GridBox は箱、SpriteCylinder は蓋付きの円柱、
+// |      Model は読み込み時に作った BVH で三角形まで
+// |  配置は直前の DrawScene（UpdateTransforms / UpdateSpatialIndex）の時点
+// __________________________________________
+
+#include "Main.h"
+#include "Manager.h"
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+using namespace DirectX;
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static std::vector<SpatialHit> g_RayCandidates;     // ツリーからの候補（毎回使い回す）
+
+//-----------------------------------------
+// 形ごとの判定（ローカル空間。o / d はワールド行列の逆で戻したもの、t はワールドと同じ）
+//-----------------------------------------
+// 板（XY 面、中心原点）
+static bool Ray_Quad(const XMFLOAT3& o, const XMFLOAT3& d, float hx, float hy, float maxDist, float* t, XMFLOAT3* n)
+{
+    if (fabsf(d.z) < 1e-8f) return false;
+    float tt = -o.z / d.z;
+    if (tt < 0.0f || tt > maxDist) return false;
+    float x = o.x + d.x * tt, y = o.y + d.y * tt;
+    if (fabsf(x) > hx || fabsf(y) > hy) return false;
+    *t = tt;
+    *n = { 0.0f, 0.0f, d.z > 0.0f ? -1.0f : 1.0f };
+    return true;
+}
+
+// 箱（中心原点、半径 h）。入る面の法線を返す（中から撃ったときは距離 0）
+static bool Ray_Box(const XMFLOAT3& o, const XMFLOAT3& d, const XMFLOAT3& h, float maxDist, float* t, XMFLOAT3* n)
+{
+    const float* po = &o.x;
+    const float* pd = &d.x;
+    const float* ph = &h.x;
+    float t0 = 0.0f, t1 = maxDist;
+    int axis = -1;
+    float sign = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+        if (fabsf(pd[k]) < 1e-12f) {
+            if (po[k] < -ph[k] || po[k] > ph[k]) return false;
+            continue;
+        }
+        float inv = 1.0f / pd[k];
+        float a = (-ph[k] - po[k]) * inv;
+        float b = (ph[k] - po[k]) * inv;
+        float s = -1.0f;
+        if (a > b) { float tmp = a; a = b; b = tmp; s = 1.0f; }
+        if (a > t0) { t0 = a; axis = k; sign = s; }
+        if (b < t1) t1 = b;
+        if (t0 > t1) return false;
+    }
+    *t = t0;
+    float* pn = &n->x;
+    pn[0] = pn[1] = pn[2] = 0.0f;
+    if (axis >= 0) pn[axis] = sign;
+    else { pn[0] = -d.x; pn[1] = -d.y; pn[2] = -d.z; }
+    return true;
+}
+
+// 円柱（軸はローカル Y、半径 r、高さ 2 * hy）
+static bool Ray_Cylinder(const XMFLOAT3& o, const XMFLOAT3& d, float r, float hy, float maxDist, float* t, XMFLOAT3* n)
+{
+    float best = maxDist;
+    bool hit = false;
+
+    // 中から撃ったとき
+    if (o.x * o.x + o.z * o.z <= r * r && fabsf(o.y) <= hy) {
+        *t = 0.0f;
+        *n = { -d.x, -d.y, -d.z };
+        return true;
+    }
+    // 側面
+    float a = d.x * d.x + d.z * d.z;
+    if (a > 1e-12f) {
+        float b = o.x * d.x + o.z * d.z;
+        float c = o.x * o.x + o.z * o.z - r * r;
+        float disc = b * b - a * c;
+        if (disc >= 0.0f) {
+            float tt = (-b - sqrtf(disc)) / a;
+            float y = o.y + d.y * tt;
+            if (tt >= 0.0f && tt <= best && fabsf(y) <= hy) {
+                best = tt;
+                *n = { (o.x + d.x * tt) / r, 0.0f, (o.z + d.z * tt) / r };
+                hit = true;
+            }
+        }
+    }
+    // 蓋
+    if (fabsf(d.y) > 1e-12f) {
+        float cap = d.y > 0.0f ? -hy : hy;      // 手前側の蓋
+        float tt = (cap - o.y) / d.y;
+        float x = o.x + d.x * tt, z = o.z + d.z * tt;
+        if (tt >= 0.0f && tt <= best && x * x + z * z <= r * r) {
+            best = tt;
+            *n = { 0.0f, d.y > 0.0f ? -1.0f : 1.0f, 0.0f };
+            hit = true;
+        }
+    }
+    if (hit) *t = best;
+    return hit;
+}
+
+// ワールド行列の逆でレイをローカルへ
+static void Ray_ToLocal(const XMMATRIX& world, FXMVECTOR o, FXMVECTOR d, XMFLOAT3* lo, XMFLOAT3* ld)
+{
+    XMMATRIX inv = XMMatrixInverse(nullptr, world);
+    XMStoreFloat3(lo, XMVector3TransformCoord(o, inv));
+    XMStoreFloat3(ld, XMVector3TransformNormal(d, inv));
+}
+
+static bool Ray_Object(IndexType type, int index, FXMVECTOR o, FXMVECTOR d, float maxDist, float* t, XMVECTOR* normal)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    const XMMATRIX& world = GetWorldMatrix(type, index);
+    XMFLOAT3 lo, ld, ln;
+    Ray_ToLocal(world, o, d, &lo, &ld);
+
+    bool hit = false;
+    switch (type)
+    {
+    case IndexType::SpriteWorld: {
+        Vec4 s = Vec4_Get(&p->SpriteWorldSize, index);
+        hit = Ray_Quad(lo, ld, fabsf(s.X) * 0.5f, fabsf(s.Y) * 0.5f, maxDist, t, &ln);
+        break;
+    }
+    case IndexType::SpriteBox: {
+        Vec4 s = Vec4_Get(&p->SpriteBoxSize, index);
+        hit = Ray_Box(lo, ld, { fabsf(s.X) * 0.5f, fabsf(s.Y) * 0.5f, fabsf(s.Z) * 0.5f }, maxDist, t, &ln);
+        break;
+    }
+    case IndexType::GridBox: {
+        Vec4 s = Vec4_Get(&p->GridBoxSize, index);
+        hit = Ray_Box(lo, ld, { fabsf(s.X) * 0.5f, fabsf(s.Y) * 0.5f, fabsf(s.Z) * 0.5f }, maxDist, t, &ln);
+        break;
+    }
+    case IndexType::SpriteCylinder: {
+        Vec4 s = Vec4_Get(&p->SpriteCylinderSize, index);
+        float r = s.X <= 0.0f ? 1.0f : s.X;     // BuildMesh と同じ（X = 半径, Y = 高さ）
+        hit = Ray_Cylinder(lo, ld, r, fabsf(s.Y) * 0.5f, maxDist, t, &ln);
+        break;
+    }
+    default:
+        return false;
+    }
+    if (hit) *normal = XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&ln), world));
+    return hit;
+}
+
+// Model: Size を含むワールド行列で戻してメッシュの BVH へ（t はそのままワールドの距離）
+static bool Ray_Model(int index, FXMVECTOR o, FXMVECTOR d, float maxDist, float* t, XMVECTOR* normal)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    const char* mesh = VecC_Get(&p->ModelPath, index);
+    if (!mesh || !*mesh) return false;
+    Vec4 size = Vec4_Get(&p->ModelSize, index);
+    XMMATRIX world = XMMatrixMultiply(XMMatrixScaling(size.X, size.Y, size.Z), GetWorldMatrix(IndexType::Model, index));
+
+    XMFLOAT3 lo, ld, ln;
+    Ray_ToLocal(world, o, d, &lo, &ld);
+
+    // メッシュ全体の箱で先に外す
+    Vec4 mn, mx;
+    if (!GetModelMeshBounds(mesh, &mn, &mx)) return false;
+    XMFLOAT3 bo = { lo.x - (mn.X + mx.X) * 0.5f, lo.y - (mn.Y + mx.Y) * 0.5f, lo.z - (mn.Z + mx.Z) * 0.5f };
+    float tBox;
+    if (!Ray_Box(bo, ld, { (mx.X - mn.X) * 0.5f, (mx.Y - mn.Y) * 0.5f, (mx.Z - mn.Z) * 0.5f }, maxDist, &tBox, &ln)) return false;
+
+    Vec4 localNormal;
+    if (!RaycastModelMesh(mesh, { lo.x, lo.y, lo.z, 0 }, { ld.x, ld.y, ld.z, 0 }, maxDist, t, &localNormal)) return false;
+    // 法線は逆転置で戻す（拡大縮小が軸ごとに違っても面に垂直のまま）
+    XMMATRIX normalMat = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+    *normal = XMVector3Normalize(XMVector3TransformNormal(XMVectorSet(localNormal.X, localNormal.Y, localNormal.Z, 0), normalMat));
+    return true;
+}
+
+//-----------------------------------------
+// API
+//-----------------------------------------
+bool RaycastScene(const Vec4& origin, const Vec4& dir, unsigned mask, RaycastHit* hit, float maxDist)
+{
+    LIA_PROFILE_SCOPE("RaycastScene");
+    XMVECTOR o = XMVectorSet(origin.X, origin.Y, origin.Z, 0.0f);
+    XMVECTOR d = XMVectorSet(dir.X, dir.Y, dir.Z, 0.0f);
+    float len = XMVectorGetX(XMVector3Length(d));
+    if (len < 1e-12f) return false;
+    d = XMVectorScale(d, 1.0f / len);
+    Vec4 nd = { XMVectorGetX(d), XMVectorGetY(d), XMVectorGetZ(d), 0.0f };
+
+    // 現在のシーンの範囲（シーンが無ければ全体）
+    static const IndexType types[5] = { IndexType::SpriteWorld, IndexType::SpriteBox, IndexType::SpriteCylinder, IndexType::GridBox, IndexType::Model };
+    static const unsigned bits[5] = { RaycastMask_SpriteWorld, RaycastMask_SpriteBox, RaycastMask_SpriteCylinder, RaycastMask_GridBox, RaycastMask_Model };
+    int rangeBegin[5], rangeEnd[5];
+    const char* scene = GetCurrentSceneName();
+    for (int s = 0; s < 5; ++s)
+        if (!GetSceneRange(scene, types[s], &rangeBegin[s], &rangeEnd[s])) { rangeBegin[s] = 0; rangeEnd[s] = INT_MAX; }
+
+    float best = maxDist;
+    IndexType bestType = IndexType::SpriteWorld;
+    int bestIndex = -1;
+    XMVECTOR bestNormal = XMVectorZero();
+
+    g_RayCandidates.clear();
+    QuerySpatialRay({ origin.X, origin.Y, origin.Z, 0.0f }, nd, maxDist, &g_RayCandidates);
+    for (const SpatialHit& c : g_RayCandidates) {
+        if (c.Distance > best) break;           // 近い順なのでここから先は当たっても遠い
+        int s = 0;
+        while (s < 5 && types[s] != c.Type) ++s;
+        if (s == 5 || !(mask & bits[s])) continue;
+        if (c.Index < rangeBegin[s] || c.Index >= rangeEnd[s]) continue;
+
+        float t;
+        XMVECTOR n;
+        bool hitObject = (c.Type == IndexType::Model) ? Ray_Model(c.Index, o, d, best, &t, &n)
+                                                      : Ray_Object(c.Type, c.Index, o, d, best, &t, &n);
+        if (hitObject && t <= best) {
+            best = t;
+            bestType = c.Type;
+            bestIndex = c.Index;
+            bestNormal = n;
+        }
+    }
+
+    if (bestIndex < 0) return false;
+    if (hit) {
+        XMVECTOR pt = XMVectorAdd(o, XMVectorScale(d, best));
+        hit->Type = bestType;
+        hit->Index = bestIndex;
+        hit->Distance = best;
+        hit->Point = { XMVectorGetX(pt), XMVectorGetY(pt), XMVectorGetZ(pt), 0.0f };
+        hit->Normal = { XMVectorGetX(bestNormal), XMVectorGetY(bestNormal), XMVectorGetZ(bestNormal), 0.0f };
+    }
+    return true;
+}
+
+bool ScreenPointToRay(const char* camera, float x, float y, Vec4* origin, Vec4* dir)
+{
+    int index = camera ? GetObjectIndexByName(IndexType::Camera, camera) : GetUseCamera();
+    Camera* cam = (GetObjectClass() && index >= 0) ? GetObjectClass()->GetComponent<Camera>(index) : nullptr;
+    if (!cam) { AddMessage(ConcatCStr("ScreenPointToRay: camera not found ", camera ? camera : "(use camera)")); return false; }
+
+    // 画面座標 → NDC → 近い面 / 遠い面（viewProj の逆）
+    float w = (float)GetScreenWidth(), h = (float)GetScreenHeight();
+    float nx = x / w * 2.0f - 1.0f;
+    float ny = 1.0f - y / h * 2.0f;
+    XMMATRIX inv = XMMatrixInverse(nullptr, cam->GetViewProjection());
+    XMVECTOR nearP = XMVector3TransformCoord(XMVectorSet(nx, ny, 0.0f, 1.0f), inv);
+    XMVECTOR farP = XMVector3TransformCoord(XMVectorSet(nx, ny, 1.0f, 1.0f), inv);
+    XMVECTOR d = XMVector3Normalize(XMVectorSubtract(farP, nearP));
+
+    if (origin) *origin = { XMVectorGetX(nearP), XMVectorGetY(nearP), XMVectorGetZ(nearP), 0.0f };
+    if (dir) *dir = { XMVectorGetX(d), XMVectorGetY(d), XMVectorGetZ(d), 0.0f };
+    return true;
+}
@@ -0,0 +1,287 @@
+﻿// ReelManager.cpp
+// リール（SpriteCylinder のリールモード）
+// |  回転は円柱を回さず、側面の UV をずらして表す（メッシュと Angle はそのまま。Draw 側で定数 / インスタンスデータに入れるだけ）
+// |  位置は図柄単位（0..図柄数）。側面のテクスチャを図柄数で等分した帯を図柄の並び（ストリップ）とする
+// |  回転: 加速 → 一定速度。停止: 指定の図柄が窓（UV の基準位置）に来るよう、今の速度から減速（OutQuad、速度は連続）
+// |  止める図柄 / 遅延の乱数は SetReelSeed の種から（同じ種と同じ入力なら同じ結果。更新は固定ステップ）
+// __________________________________________
+
+#include "Manager.h"
+#include <cmath>
+#include <vector>
+
+#define REEL_ACCEL_TIME 0.2f        // 0 → 指定速度までの秒数
+#define REEL_STOP_TIME  0.4f        // 減速にかける最短の秒数
+#define REEL_MIN_SPEED  1.0f        // 減速を始めるときの最低速度（図柄 / 秒）
+
+enum ReelState
+{
+    ReelState_Idle,
+    ReelState_Spin,
+    ReelState_Stop,
+};
+
+// SpriteCylinder の行ごと
+static std::vector<int> g_ReelSymbols;          // 0: リールではない
+static std::vector<unsigned char> g_ReelState;
+static std::vector<float> g_ReelPos;            // 図柄単位 [0, 図柄数)
+static std::vector<float> g_ReelVelocity;       // 図柄 / 秒
+static std::vector<float> g_ReelSpeed;          // 回転の目標速度
+static std::vector<float> g_ReelStopDelay;      // 停止を始めるまでの残り秒数
+static std::vector<int> g_ReelTarget;           // 止めるストリップ上の位置（-1: 未指定）
+static std::vector<float> g_ReelStopFrom, g_ReelStopDist, g_ReelStopTime, g_ReelStopLength;
+static std::vector<std::vector<int>> g_ReelStrip;   // 位置 → 図柄番号（空なら位置 = 図柄番号）
+
+static std::vector<int> g_ReelActive;           // 回転中の行
+static std::vector<unsigned char> g_ReelListed; // g_ReelActive に入っているか
+static unsigned g_ReelRand = 12345;
+
+static unsigned Reel_Rand()
+{
+    // xorshift32（標準の乱数と違って実装に依らず同じ列）
+    unsigned x = g_ReelRand;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return g_ReelRand = x;
+}
+
+static void Reel_Grow(int index)
+{
+    if (index < (int)g_ReelSymbols.size()) return;
+    int n = index + 1;
+    g_ReelSymbols.resize(n, 0);      g_ReelState.resize(n, ReelState_Idle);
+    g_ReelPos.resize(n, 0.0f);       g_ReelVelocity.resize(n, 0.0f);   g_ReelSpeed.resize(n, 0.0f);
+    g_ReelStopDelay.resize(n, 0.0f); g_ReelTarget.resize(n, -1);
+    g_ReelStopFrom.resize(n, 0.0f);  g_ReelStopDist.resize(n, 0.0f);
+    g_ReelStopTime.resize(n, 0.0f);  g_ReelStopLength.resize(n, 0.0f);
+    g_ReelStrip.resize(n);           g_ReelListed.resize(n, 0);
+}
+
+// 名前 → リールの行（リールでなければ -1）
+static int Reel_Index(const char* name, const char* api)
+{
+    int index = GetObjectIndexByName(IndexType::SpriteCylinder, name);
+    if (index < 0 || index >= (int)g_ReelSymbols.size() || g_ReelSymbols[index] <= 0) {
+        AddMessage(ConcatCStr(api, name ? name : ""));
+        return -1;
+    }
+    return index;
+}
+
+static void Reel_Activate(int index)
+{
+    if (g_ReelListed[index]) return;
+    g_ReelListed[index] = 1;
+    g_ReelActive.push_back(index);
+}
+
+//-----------------------------------------
+// 設定
+//-----------------------------------------
+void SetSpriteCylinderReel(const char* name, int symbols)
+{
+    int index = GetObjectIndexByName(IndexType::SpriteCylinder, name);
+    if (index < 0) { AddMessage(ConcatCStr("SetSpriteCylinderReel: not found ", name ? name : "")); return; }
+    Reel_Grow(index);
+    g_ReelSymbols[index] = symbols > 0 ? symbols : 0;
+    g_ReelState[index] = ReelState_Idle;
+    g_ReelPos[index] = 0.0f;
+    g_ReelVelocity[index] = 0.0f;
+    g_ReelTarget[index] = -1;
+    g_ReelStrip[index].clear();
+}
+
+void SetReelStrip(const char* name, const int* symbols, int count)
+{
+    int index = Reel_Index(name, "SetReelStrip: not a reel ");
+    if (index < 0) return;
+    if (count != g_ReelSymbols[index]) {
+        AddMessage(ConcatCStr("SetReelStrip: count != symbols ", name));
+        return;
+    }
+    g_ReelStrip[index].assign(symbols, symbols + count);
+}
+
+void SetReelSeed(unsigned seed)
+{
+    g_ReelRand = seed ? seed : 12345;   // 0 だと xorshift が止まる
+}
+
+void SpinReel(const char* name, float speed)
+{
+    int index = Reel_Index(name, "SpinReel: not a reel ");
+    if (index < 0) return;
+    if (!(speed > 0.0f)) { AddMessage(ConcatCStr("SpinReel: speed must be > 0 ", name)); return; }   // 加速の上限と停止の計算は正の向きが前提
+    g_ReelSpeed[index] = speed;
+    g_ReelTarget[index] = -1;
+    g_ReelStopDelay[index] = 0.0f;
+    g_ReelState[index] = ReelState_Spin;
+    Reel_Activate(index);
+}
+
+void StopReel(const char* name, int symbol, float delay)
+{
+    int index = Reel_Index(name, "StopReel: not a reel ");
+    if (index < 0 || g_ReelState[index] != ReelState_Spin) return;
+    int n = g_ReelSymbols[index];
+    const std::vector<int>& strip = g_ReelStrip[index];
+
+    // 図柄番号 → ストリップ上の位置（複数あれば乱数で1つ。-1 は位置を乱数で）
+    int target = -1;
+    if (symbol < 0) target = (int)(Reel_Rand() % (unsigned)n);
+    else if (strip.empty()) target = symbol < n ? symbol : -1;
+    else {
+        int hits = 0;
+        for (int s : strip) if (s == symbol) hits++;
+        if (hits > 0) {
+            int pick = (int)(Reel_Rand() % (unsigned)hits);
+            for (int p = 0; p < n; ++p) if (strip[p] == symbol && pick-- == 0) { target = p; break; }
+        }
+    }
+    if (target < 0) { AddMessage(ConcatCStr("StopReel: symbol not on strip ", name)); return; }
+
+    g_ReelTarget[index] = target;
+    g_ReelStopDelay[index] = delay > 0.0f ? delay : 0.0f;
+}
+
+bool IsReelSpinning(const char* name)
+{
+    int index = GetObjectIndexByName(IndexType::SpriteCylinder, name);
+    if (index < 0 || index >= (int)g_ReelSymbols.size()) return false;
+    return g_ReelState[index] != ReelState_Idle;
+}
+
+int GetReelSymbol(const char* name)
+{
+    int index = GetObjectIndexByName(IndexType::SpriteCylinder, name);
+    if (index < 0 || index >= (int)g_ReelSymbols.size() || g_ReelSymbols[index] <= 0) return -1;
+    int n = g_ReelSymbols[index];
+    int p = (int)floorf(g_ReelPos[index] + 0.5f);
+    p = ((p % n) + n) % n;
+    return g_ReelStrip[index].empty() ? p : g_ReelStrip[index][p];
+}
+
+int GetReelSymbols(int index)
+{
+    if (index < 0 || index >= (int)g_ReelSymbols.size()) return 0;
+    return g_ReelSymbols[index];
+}
+
+float GetReelScroll(int index)
+{
+    if (index < 0 || index >= (int)g_ReelSymbols.size() || g_ReelSymbols[index] <= 0) return 0.0f;
+    return g_ReelPos[index] / (float)g_ReelSymbols[index];
+}
+
+// 行の移動時：状態を to へ写す（from は続く Reel_OnRemove で通常の円柱に戻る）
+void Reel_OnMove(IndexType type, int from, int to)
+{
+    if (type != IndexType::SpriteCylinder || from < 0 || from >= (int)g_ReelSymbols.size() || g_ReelSymbols[from] <= 0) return;
+    Reel_Grow(to);
+    g_ReelSymbols[to] = g_ReelSymbols[from];
+    g_ReelState[to] = g_ReelState[from];
+    g_ReelPos[to] = g_ReelPos[from];
+    g_ReelVelocity[to] = g_ReelVelocity[from];
+    g_ReelSpeed[to] = g_ReelSpeed[from];
+    g_ReelStopDelay[to] = g_ReelStopDelay[from];
+    g_ReelTarget[to] = g_ReelTarget[from];
+    g_ReelStopFrom[to] = g_ReelStopFrom[from];
+    g_ReelStopDist[to] = g_ReelStopDist[from];
+    g_ReelStopTime[to] = g_ReelStopTime[from];
+    g_ReelStopLength[to] = g_ReelStopLength[from];
+    g_ReelStrip[to].swap(g_ReelStrip[from]);
+    if (g_ReelState[to] != ReelState_Idle) Reel_Activate(to);
+}
+
+void Reel_OnRemove(IndexType type, int index)
+{
+    if (type != IndexType::SpriteCylinder || index < 0 || index >= (int)g_ReelSymbols.size()) return;
+    g_ReelSymbols[index] = 0;
+    g_ReelState[index] = ReelState_Idle;    // 回転中の一覧からは次の UpdateReels で外れる
+    g_ReelStrip[index].clear();
+}
+
+//-----------------------------------------
+// 更新（固定ステップで呼ぶ）
+//-----------------------------------------
+// [0, n) に折り返す（fmodf は負の値をそのまま返す）
+static float Reel_Wrap(float pos, float n)
+{
+    pos = fmodf(pos, n);
+    return pos < 0.0f ? pos + n : pos;
+}
+
+// 今の位置と速度から target で止まる減速を始める
+static void Reel_BeginStop(int i)
+{
+    int n = g_ReelSymbols[i];
+    float v = g_ReelVelocity[i] > REEL_MIN_SPEED ? g_ReelVelocity[i] : REEL_MIN_SPEED;
+    float from = g_ReelPos[i];
+    // OutQuad の初速は 2 * 距離 / 時間。最短の時間で進む距離より先にある target の位置を選び、時間を合わせる
+    float minDist = v * REEL_STOP_TIME * 0.5f;
+    float dist = (float)g_ReelTarget[i] - from;
+    dist += ceilf((minDist - dist) / (float)n) * (float)n;
+    g_ReelStopFrom[i] = from;
+    g_ReelStopDist[i] = dist;
+    g_ReelStopLength[i] = 2.0f * dist / v;
+    g_ReelStopTime[i] = 0.0f;
+    g_ReelState[i] = ReelState_Stop;
+}
+
+void UpdateReels(float dt)
+{
+    LIA_PROFILE_SCOPE("UpdateReels");
+    for (size_t k = g_ReelActive.size(); k-- > 0;) {
+        int i = g_ReelActive[k];
+        float n = (float)g_ReelSymbols[i];
+        if (g_ReelState[i] == ReelState_Spin) {
+            float speed = g_ReelSpeed[i];
+            float v = g_ReelVelocity[i] + speed * (dt / REEL_ACCEL_TIME);
+            g_ReelVelocity[i] = v < speed ? v : speed;
+            g_ReelPos[i] = Reel_Wrap(g_ReelPos[i] + g_ReelVelocity[i] * dt, n);
+            if (g_ReelTarget[i] >= 0) {
+                g_ReelStopDelay[i] -= dt;
+                if (g_ReelStopDelay[i] <= 0.0f) Reel_BeginStop(i);
+            }
+        }
+        else if (g_ReelState[i] == ReelState_Stop) {
+            float t = (g_ReelStopTime[i] += dt) / g_ReelStopLength[i];
+            if (t >= 1.0f) {
+                g_ReelPos[i] = (float)g_ReelTarget[i];
+                g_ReelVelocity[i] = 0.0f;
+                g_ReelTarget[i] = -1;
+                g_ReelState[i] = ReelState_Idle;
+            }
+            else {
+                float e = t * (2.0f - t);
+                g_ReelPos[i] = Reel_Wrap(g_ReelStopFrom[i] + g_ReelStopDist[i] * e, n);
+                g_ReelVelocity[i] = g_ReelStopDist[i] * 2.0f * (1.0f - t) / g_ReelStopLength[i];
+            }
+        }
+        if (g_ReelState[i] == ReelState_Idle) {
+            g_ReelListed[i] = 0;
+            g_ReelActive[k] = g_ReelActive.back();
+            g_ReelActive.pop_back();
+        }
+    }
+}
+
+void ReleaseReels()
+{
+    g_ReelSymbols.clear();    g_ReelSymbols.shrink_to_fit();
+    g_ReelState.clear();      g_ReelState.shrink_to_fit();
+    g_ReelPos.clear();        g_ReelPos.shrink_to_fit();
+    g_ReelVelocity.clear();   g_ReelVelocity.shrink_to_fit();
+    g_ReelSpeed.clear();      g_ReelSpeed.shrink_to_fit();
+    g_ReelStopDelay.clear();  g_ReelStopDelay.shrink_to_fit();
+    g_ReelTarget.clear();     g_ReelTarget.shrink_to_fit();
+    g_ReelStopFrom.clear();   g_ReelStopFrom.shrink_to_fit();
+    g_ReelStopDist.clear();   g_ReelStopDist.shrink_to_fit();
+    g_ReelStopTime.clear();   g_ReelStopTime.shrink_to_fit();
+    g_ReelStopLength.clear(); g_ReelStopLength.shrink_to_fit();
+    g_ReelStrip.clear();      g_ReelStrip.shrink_to_fit();
+    g_ReelActive.clear();     g_ReelActive.shrink_to_fit();
+    g_ReelListed.clear();     g_ReelListed.shrink_to_fit();
+    g_ReelRand = 12345;
+}
@@ -0,0 +1,363 @@
+﻿// RenderBackendD3D11.cpp
+// D3D11 バックエンド（RenderDevice / RenderContext の呼び出しを D3D11 へ変換して転送）
+// |  リソースは D3D11 のオブジェクトを持つ RenderResource 派生で包む
+// |  記述子の列挙は D3D11 と同じ値なのでそのまま渡す（下の static_assert）
+// |  シェーダーのコンパイルは D3DCompile
+// __________________________________________
+
+#include "RenderBackendD3D11.h"
+
+#include <d3dcompiler.h>
+#include <wrl/client.h>
+
+#pragma comment (lib, "d3dcompiler.lib")
+
+using Microsoft::WRL::ComPtr;
+
+static_assert(RenderFormat_R32G32B32A32_Float == DXGI_FORMAT_R32G32B32A32_FLOAT && RenderFormat_R32G32B32_Float == DXGI_FORMAT_R32G32B32_FLOAT &&
+    RenderFormat_R16G16B16A16_UInt == DXGI_FORMAT_R16G16B16A16_UINT && RenderFormat_R32G32_Float == DXGI_FORMAT_R32G32_FLOAT &&
+    RenderFormat_R8G8B8A8_UNorm == DXGI_FORMAT_R8G8B8A8_UNORM && RenderFormat_R32_UInt == DXGI_FORMAT_R32_UINT &&
+    RenderFormat_R16_UInt == DXGI_FORMAT_R16_UINT, "RenderFormat");
+static_assert(RenderUsage_Default == D3D11_USAGE_DEFAULT && RenderUsage_Immutable == D3D11_USAGE_IMMUTABLE &&
+    RenderUsage_Dynamic == D3D11_USAGE_DYNAMIC && RenderUsage_Staging == D3D11_USAGE_STAGING, "RenderUsage");
+static_assert(RenderBind_VertexBuffer == D3D11_BIND_VERTEX_BUFFER && RenderBind_IndexBuffer == D3D11_BIND_INDEX_BUFFER &&
+    RenderBind_ConstantBuffer == D3D11_BIND_CONSTANT_BUFFER && RenderBind_ShaderResource == D3D11_BIND_SHADER_RESOURCE, "RenderBind");
+static_assert(RenderCpuAccess_Write == D3D11_CPU_ACCESS_WRITE && RenderCpuAccess_Read == D3D11_CPU_ACCESS_READ, "RenderCpuAccess");
+static_assert(RenderMap_Write == D3D11_MAP_WRITE && RenderMap_WriteDiscard == D3D11_MAP_WRITE_DISCARD &&
+    RenderMap_WriteNoOverwrite == D3D11_MAP_WRITE_NO_OVERWRITE, "RenderMap");
+static_assert(RenderTopology_PointList == D3D11_PRIMITIVE_TOPOLOGY_POINTLIST && RenderTopology_LineList == D3D11_PRIMITIVE_TOPOLOGY_LINELIST &&
+    RenderTopology_LineStrip == D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP && RenderTopology_TriangleList == D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST &&
+    RenderTopology_TriangleStrip == D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP, "RenderTopology");
+static_assert(RenderInput_PerVertex == D3D11_INPUT_PER_VERTEX_DATA && RenderInput_PerInstance == D3D11_INPUT_PER_INSTANCE_DATA, "RenderInputClass");
+static_assert(RenderFilter_Point == D3D11_FILTER_MIN_MAG_MIP_POINT && RenderFilter_Linear == D3D11_FILTER_MIN_MAG_MIP_LINEAR, "RenderFilter");
+static_assert(RenderAddress_Wrap == D3D11_TEXTURE_ADDRESS_WRAP && RenderAddress_Mirror == D3D11_TEXTURE_ADDRESS_MIRROR &&
+    RenderAddress_Clamp == D3D11_TEXTURE_ADDRESS_CLAMP, "RenderAddress");
+static_assert(RenderCompare_Never == D3D11_COMPARISON_NEVER && RenderCompare_Less == D3D11_COMPARISON_LESS &&
+    RenderCompare_LessEqual == D3D11_COMPARISON_LESS_EQUAL && RenderCompare_Always == D3D11_COMPARISON_ALWAYS, "RenderCompare");
+static_assert(RenderBlend_Zero == D3D11_BLEND_ZERO && RenderBlend_One == D3D11_BLEND_ONE &&
+    RenderBlend_SrcAlpha == D3D11_BLEND_SRC_ALPHA && RenderBlend_InvSrcAlpha == D3D11_BLEND_INV_SRC_ALPHA, "RenderBlend");
+static_assert(RenderBlendOp_Add == D3D11_BLEND_OP_ADD && RenderBlendOp_Subtract == D3D11_BLEND_OP_SUBTRACT, "RenderBlendOp");
+static_assert(RenderDepthWrite_Zero == D3D11_DEPTH_WRITE_MASK_ZERO && RenderDepthWrite_All == D3D11_DEPTH_WRITE_MASK_ALL, "RenderDepthWrite");
+static_assert(RENDER_COLOR_WRITE_ALL == D3D11_COLOR_WRITE_ENABLE_ALL, "RENDER_COLOR_WRITE_ALL");
+
+//-----------------------------------------
+// リソース
+// |  Native() で包んでいる D3D11 オブジェクトを返す
+//-----------------------------------------
+template<class Base, class Native>
+class D3D11Object : public Base
+{
+public:
+    explicit D3D11Object(Native* p) : m_native(p) {}    //p の参照を引き取る
+    ~D3D11Object() { if (m_native) m_native->Release(); }
+    Native* NativePtr() const { return m_native; }
+
+private:
+    Native* m_native;
+};
+
+typedef D3D11Object<RenderBuffer, ID3D11Buffer> D3D11Buffer;
+typedef D3D11Object<RenderTexture2D, ID3D11Texture2D> D3D11Texture2D;
+typedef D3D11Object<RenderShaderResourceView, ID3D11ShaderResourceView> D3D11ShaderResourceView;
+typedef D3D11Object<RenderInputLayout, ID3D11InputLayout> D3D11InputLayout;
+typedef D3D11Object<RenderVertexShader, ID3D11VertexShader> D3D11VertexShader;
+typedef D3D11Object<RenderPixelShader, ID3D11PixelShader> D3D11PixelShader;
+typedef D3D11Object<RenderSamplerState, ID3D11SamplerState> D3D11SamplerState;
+typedef D3D11Object<RenderBlendState, ID3D11BlendState> D3D11BlendState;
+typedef D3D11Object<RenderDepthStencilState, ID3D11DepthStencilState> D3D11DepthStencilState;
+
+// 包みを外す（バックエンドは1つなので渡されるのは必ずこのファイルで作ったもの）
+static ID3D11Buffer* D3D11_Native(RenderBuffer* p) { return p ? static_cast<D3D11Buffer*>(p)->NativePtr() : nullptr; }
+static ID3D11Texture2D* D3D11_Native(RenderTexture2D* p) { return p ? static_cast<D3D11Texture2D*>(p)->NativePtr() : nullptr; }
+static ID3D11ShaderResourceView* D3D11_Native(RenderShaderResourceView* p) { return p ? static_cast<D3D11ShaderResourceView*>(p)->NativePtr() : nullptr; }
+static ID3D11InputLayout* D3D11_Native(RenderInputLayout* p) { return p ? static_cast<D3D11InputLayout*>(p)->NativePtr() : nullptr; }
+static ID3D11VertexShader* D3D11_Native(RenderVertexShader* p) { return p ? static_cast<D3D11VertexShader*>(p)->NativePtr() : nullptr; }
+static ID3D11PixelShader* D3D11_Native(RenderPixelShader* p) { return p ? static_cast<D3D11PixelShader*>(p)->NativePtr() : nullptr; }
+static ID3D11SamplerState* D3D11_Native(RenderSamplerState* p) { return p ? static_cast<D3D11SamplerState*>(p)->NativePtr() : nullptr; }
+static ID3D11BlendState* D3D11_Native(RenderBlendState* p) { return p ? static_cast<D3D11BlendState*>(p)->NativePtr() : nullptr; }
+static ID3D11DepthStencilState* D3D11_Native(RenderDepthStencilState* p) { return p ? static_cast<D3D11DepthStencilState*>(p)->NativePtr() : nullptr; }
+
+// 作成結果を包んで out へ（out 無しは D3D11 と同じく検証のみ）
+template<class Wrap, class Base, class Native>
+static bool D3D11_Wrap(HRESULT hr, Native* native, Base** out)
+{
+    if (FAILED(hr)) return false;
+    if (out) *out = new Wrap(native);
+    else if (native) native->Release();
+    return true;
+}
+
+// 同じスロット数ぶんの包みを外す（D3D11 の1回の Set の上限以内）
+#define D3D11_MAX_BIND 16
+template<class T, class Native>
+static unsigned D3D11_NativeArray(unsigned num, T* const* src, Native** dst)
+{
+    if (num > D3D11_MAX_BIND) num = D3D11_MAX_BIND;
+    for (unsigned i = 0; i < num; ++i) dst[i] = src ? D3D11_Native(src[i]) : nullptr;
+    return num;
+}
+
+//-----------------------------------------
+// デバイス
+//-----------------------------------------
+class D3D11RenderDevice : public RenderDevice
+{
+public:
+    explicit D3D11RenderDevice(ID3D11Device* dev) : m_dev(dev) {}
+
+protected:
+    bool OnCreateBuffer(const RenderBufferDesc* desc, const RenderSubresourceData* init, RenderBuffer** out) override
+    {
+        if (!desc) return false;
+        D3D11_BUFFER_DESC d = {};
+        d.ByteWidth = desc->ByteWidth;
+        d.Usage = (D3D11_USAGE)desc->Usage;
+        d.BindFlags = desc->BindFlags;
+        d.CPUAccessFlags = desc->CPUAccessFlags;
+        D3D11_SUBRESOURCE_DATA s = {};
+        if (init) s.pSysMem = init->pSysMem;
+        ID3D11Buffer* p = nullptr;
+        HRESULT hr = m_dev->CreateBuffer(&d, init ? &s : nullptr, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11Buffer>(hr, p, out);
+    }
+    bool OnCreateTexture2D(const RenderTexture2DDesc* desc, const RenderSubresourceData* init, RenderTexture2D** out) override
+    {
+        if (!desc) return false;
+        D3D11_TEXTURE2D_DESC d = {};
+        d.Width = desc->Width;
+        d.Height = desc->Height;
+        d.MipLevels = desc->MipLevels;
+        d.ArraySize = 1;
+        d.Format = (DXGI_FORMAT)desc->Format;
+        d.SampleDesc.Count = 1;
+        d.Usage = (D3D11_USAGE)desc->Usage;
+        d.BindFlags = desc->BindFlags;
+        D3D11_SUBRESOURCE_DATA s = {};
+        if (init) {
+            s.pSysMem = init->pSysMem;
+            s.SysMemPitch = init->SysMemPitch;
+        }
+        ID3D11Texture2D* p = nullptr;
+        HRESULT hr = m_dev->CreateTexture2D(&d, init ? &s : nullptr, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11Texture2D>(hr, p, out);
+    }
+    bool OnCreateShaderResourceView(RenderTexture2D* tex, RenderShaderResourceView** out) override
+    {
+        ID3D11ShaderResourceView* p = nullptr;
+        HRESULT hr = m_dev->CreateShaderResourceView(D3D11_Native(tex), nullptr, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11ShaderResourceView>(hr, p, out);
+    }
+    bool OnCreateInputLayout(const RenderInputElementDesc* desc, unsigned num, const void* code, size_t codeSize, RenderInputLayout** out) override
+    {
+        D3D11_INPUT_ELEMENT_DESC d[D3D11_IA_VERTEX_INPUT_STRUCTURE_ELEMENT_COUNT] = {};
+        if (!desc || num > D3D11_IA_VERTEX_INPUT_STRUCTURE_ELEMENT_COUNT) return false;
+        for (unsigned i = 0; i < num; ++i) {
+            d[i].SemanticName = desc[i].SemanticName;
+            d[i].SemanticIndex = desc[i].SemanticIndex;
+            d[i].Format = (DXGI_FORMAT)desc[i].Format;
+            d[i].InputSlot = desc[i].InputSlot;
+            d[i].AlignedByteOffset = desc[i].AlignedByteOffset;
+            d[i].InputSlotClass = (D3D11_INPUT_CLASSIFICATION)desc[i].InputSlotClass;
+            d[i].InstanceDataStepRate = desc[i].InstanceDataStepRate;
+        }
+        ID3D11InputLayout* p = nullptr;
+        HRESULT hr = m_dev->CreateInputLayout(d, num, code, codeSize, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11InputLayout>(hr, p, out);
+    }
+    bool OnCreateVertexShader(const void* code, size_t codeSize, RenderVertexShader** out) override
+    {
+        ID3D11VertexShader* p = nullptr;
+        HRESULT hr = m_dev->CreateVertexShader(code, codeSize, nullptr, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11VertexShader>(hr, p, out);
+    }
+    bool OnCreatePixelShader(const void* code, size_t codeSize, RenderPixelShader** out) override
+    {
+        ID3D11PixelShader* p = nullptr;
+        HRESULT hr = m_dev->CreatePixelShader(code, codeSize, nullptr, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11PixelShader>(hr, p, out);
+    }
+    bool OnCreateSamplerState(const RenderSamplerDesc* desc, RenderSamplerState** out) override
+    {
+        if (!desc) return false;
+        D3D11_SAMPLER_DESC d = {};
+        d.Filter = (D3D11_FILTER)desc->Filter;
+        d.AddressU = (D3D11_TEXTURE_ADDRESS_MODE)desc->AddressU;
+        d.AddressV = (D3D11_TEXTURE_ADDRESS_MODE)desc->AddressV;
+        d.AddressW = (D3D11_TEXTURE_ADDRESS_MODE)desc->AddressW;
+        d.MinLOD = desc->MinLOD;
+        d.MaxLOD = desc->MaxLOD;
+        ID3D11SamplerState* p = nullptr;
+        HRESULT hr = m_dev->CreateSamplerState(&d, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11SamplerState>(hr, p, out);
+    }
+    bool OnCreateBlendState(const RenderBlendDesc* desc, RenderBlendState** out) override
+    {
+        if (!desc) return false;
+        D3D11_BLEND_DESC d = {};
+        const RenderTargetBlendDesc& s = desc->RenderTarget[0];
+        D3D11_RENDER_TARGET_BLEND_DESC& t = d.RenderTarget[0];
+        t.BlendEnable = s.BlendEnable ? TRUE : FALSE;
+        t.SrcBlend = (D3D11_BLEND)s.SrcBlend;
+        t.DestBlend = (D3D11_BLEND)s.DestBlend;
+        t.BlendOp = (D3D11_BLEND_OP)s.BlendOp;
+        t.SrcBlendAlpha = (D3D11_BLEND)s.SrcBlendAlpha;
+        t.DestBlendAlpha = (D3D11_BLEND)s.DestBlendAlpha;
+        t.BlendOpAlpha = (D3D11_BLEND_OP)s.BlendOpAlpha;
+        t.RenderTargetWriteMask = s.RenderTargetWriteMask;
+        ID3D11BlendState* p = nullptr;
+        HRESULT hr = m_dev->CreateBlendState(&d, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11BlendState>(hr, p, out);
+    }
+    bool OnCreateDepthStencilState(const RenderDepthStencilDesc* desc, RenderDepthStencilState** out) override
+    {
+        if (!desc) return false;
+        D3D11_DEPTH_STENCIL_DESC d = {};
+        d.DepthEnable = desc->DepthEnable ? TRUE : FALSE;
+        d.DepthWriteMask = (D3D11_DEPTH_WRITE_MASK)desc->DepthWriteMask;
+        d.DepthFunc = (D3D11_COMPARISON_FUNC)desc->DepthFunc;
+        ID3D11DepthStencilState* p = nullptr;
+        HRESULT hr = m_dev->CreateDepthStencilState(&d, out ? &p : nullptr);
+        return D3D11_Wrap<D3D11DepthStencilState>(hr, p, out);
+    }
+    bool OnCompileShader(const char* source, size_t size, const char* name, const char* entry, const char* target, RenderBlob** out, RenderBlob** errors) override
+    {
+        ComPtr<ID3DBlob> code, err;
+        HRESULT hr = D3DCompile(source, size, name, nullptr, nullptr, entry, target, 0, 0, &code, &err);
+        if (errors && err) *errors = new RenderBlob(err->GetBufferPointer(), err->GetBufferSize());
+        if (FAILED(hr)) return false;
+        if (out) *out = new RenderBlob(code->GetBufferPointer(), code->GetBufferSize());
+        return true;
+    }
+
+private:
+    ID3D11Device* m_dev;
+};
+
+//-----------------------------------------
+// コンテキスト
+//-----------------------------------------
+class D3D11RenderContext : public RenderContext
+{
+public:
+    explicit D3D11RenderContext(ID3D11DeviceContext* ctx) : m_ctx(ctx) {}
+
+protected:
+    void OnUpdateSubresource(RenderBuffer* dst, const void* src) override
+    {
+        m_ctx->UpdateSubresource(D3D11_Native(dst), 0, nullptr, src, 0, 0);
+    }
+    bool OnMap(RenderBuffer* buf, RenderMap type, RenderMappedSubresource* out) override
+    {
+        D3D11_MAPPED_SUBRESOURCE m = {};
+        if (FAILED(m_ctx->Map(D3D11_Native(buf), 0, (D3D11_MAP)type, 0, &m))) return false;
+        if (out) {
+            out->pData = m.pData;
+            out->RowPitch = m.RowPitch;
+        }
+        return true;
+    }
+    void OnUnmap(RenderBuffer* buf) override
+    {
+        m_ctx->Unmap(D3D11_Native(buf), 0);
+    }
+    void OnIASetVertexBuffers(unsigned slot, unsigned num, RenderBuffer* const* vbs, const unsigned* strides, const unsigned* offsets) override
+    {
+        ID3D11Buffer* b[D3D11_MAX_BIND];
+        num = D3D11_NativeArray(num, vbs, b);
+        m_ctx->IASetVertexBuffers(slot, num, b, strides, offsets);
+    }
+    void OnIASetIndexBuffer(RenderBuffer* ib, RenderFormat format, unsigned offset) override
+    {
+        m_ctx->IASetIndexBuffer(D3D11_Native(ib), (DXGI_FORMAT)format, offset);
+    }
+    void OnIASetPrimitiveTopology(RenderTopology topology) override
+    {
+        m_ctx->IASetPrimitiveTopology((D3D11_PRIMITIVE_TOPOLOGY)topology);
+    }
+    void OnIASetInputLayout(RenderInputLayout* layout) override
+    {
+        m_ctx->IASetInputLayout(D3D11_Native(layout));
+    }
+    void OnVSSetShader(RenderVertexShader* vs) override
+    {
+        m_ctx->VSSetShader(D3D11_Native(vs), nullptr, 0);
+    }
+    void OnVSSetConstantBuffers(unsigned slot, unsigned num, RenderBuffer* const* cbs) override
+    {
+        ID3D11Buffer* b[D3D11_MAX_BIND];
+        num = D3D11_NativeArray(num, cbs, b);
+        m_ctx->VSSetConstantBuffers(slot, num, b);
+    }
+    void OnPSSetShader(RenderPixelShader* ps) override
+    {
+        m_ctx->PSSetShader(D3D11_Native(ps), nullptr, 0);
+    }
+    void OnPSSetConstantBuffers(unsigned slot, unsigned num, RenderBuffer* const* cbs) override
+    {
+        ID3D11Buffer* b[D3D11_MAX_BIND];
+        num = D3D11_NativeArray(num, cbs, b);
+        m_ctx->PSSetConstantBuffers(slot, num, b);
+    }
+    void OnPSSetShaderResources(unsigned slot, unsigned num, RenderShaderResourceView* const* srvs) override
+    {
+        ID3D11ShaderResourceView* v[D3D11_MAX_BIND];
+        num = D3D11_NativeArray(num, srvs, v);
+        m_ctx->PSSetShaderResources(slot, num, v);
+    }
+    void OnPSSetSamplers(unsigned slot, unsigned num, RenderSamplerState* const* samplers) override
+    {
+        ID3D11SamplerState* s[D3D11_MAX_BIND];
+        num = D3D11_NativeArray(num, samplers, s);
+        m_ctx->PSSetSamplers(slot, num, s);
+    }
+    void OnOMSetBlendState(RenderBlendState* state, const float factor[4], unsigned mask) override
+    {
+        m_ctx->OMSetBlendState(D3D11_Native(state), factor, mask);
+    }
+    void OnOMSetDepthStencilState(RenderDepthStencilState* state, unsigned ref) override
+    {
+        // 取得（OMGetDepthStencilState）で同じ包みを返せるように控える
+        m_depthState = state;
+        m_depthRef = ref;
+        m_ctx->OMSetDepthStencilState(D3D11_Native(state), ref);
+    }
+    void OnOMGetDepthStencilState(RenderDepthStencilState** state, unsigned* ref) override
+    {
+        if (state) {
+            *state = m_depthState.Get();
+            if (*state) (*state)->AddRef();
+        }
+        if (ref) *ref = m_depthRef;
+    }
+    void OnDraw(unsigned count, unsigned start) override
+    {
+        m_ctx->Draw(count, start);
+    }
+    void OnDrawIndexed(unsigned count, unsigned startIndex, int baseVertex) override
+    {
+        m_ctx->DrawIndexed(count, startIndex, baseVertex);
+    }
+    void OnDrawInstanced(unsigned vertexCount, unsigned instanceCount, unsigned startVertex, unsigned startInstance) override
+    {
+        m_ctx->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+    }
+    void OnDrawIndexedInstanced(unsigned indexCount, unsigned instanceCount, unsigned startIndex, int baseVertex, unsigned startInstance) override
+    {
+        m_ctx->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    }
+
+private:
+    ID3D11DeviceContext* m_ctx;
+    RenderPtr<RenderDepthStencilState> m_depthState;
+    unsigned m_depthRef = 0;
+};
+
+//-----------------------------------------
+// 初期化
+//-----------------------------------------
+bool RenderBackend_InitD3D11(ID3D11Device* dev, ID3D11DeviceContext* ctx)
+{
+    if (!dev || !ctx) return false;
+    RenderBackend_Set(RenderBackend_D3D11, new D3D11RenderDevice(dev), new D3D11RenderContext(ctx));
+    return true;
+}
@@ -0,0 +1,12 @@
+﻿// RenderBackendD3D11.h
+// D3D11 バックエンドの初期化（Windows のみ。ウィンドウを持つ Main.cpp から使う）
+// |  コンポーネントやマネージャーは RenderDevice.h だけを見る（ここは include しない）
+// __________________________________________
+
+#pragma once
+
+#include <d3d11.h>
+#include "RenderDevice.h"
+
+//|| RenderBackend API ||______________
+bool RenderBackend_InitD3D11(ID3D11Device* dev, ID3D11DeviceContext* ctx);  //既存の D3D11 デバイスを包む
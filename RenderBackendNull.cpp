@@ -0,0 +1,350 @@
+﻿// RenderBackendNull.cpp
+// Null バックエンド（GPU無し）
+// |  リソースは RenderResource 派生のダミー（作成時の記述子 / バッファの中身のみ持つ）
+// |  シェーダーはコンパイルせず、入口の関数名があるかだけ見て擬似バイトコードを返す
+// |  Draw 時の必須ステート / Map の対応 / 定数バッファのサイズなどを検証して数える
+// __________________________________________
+
+#include "RenderDevice.h"
+#include "Manager.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define NULL_RENDER_MAX_LOG 16     // AddMessage へ出す検証エラーの上限
+
+//-----------------------------------------
+// 記録
+//-----------------------------------------
+static RenderNullStats g_NullStats = {};
+static bool g_NullRecording = false;
+static std::vector<const char*> g_NullRecorded;
+
+static void RenderNull_Error(const char* where, const char* msg)
+{
+    if (g_NullStats.ValidationErrors < NULL_RENDER_MAX_LOG) {
+        char line[256];
+        snprintf(line, sizeof(line), "RenderNull: %s: %s", where, msg);
+        AddMessage(line);
+    }
+    g_NullStats.ValidationErrors++;
+}
+
+static void RenderNull_Command(const char* name)
+{
+    g_NullStats.Commands++;
+    if (g_NullRecording) g_NullRecorded.push_back(name);
+}
+
+void RenderNull_GetStats(RenderNullStats* out)
+{
+    if (out) *out = g_NullStats;
+}
+
+void RenderNull_SetRecording(bool enable) { g_NullRecording = enable; }
+int RenderNull_GetRecordedCount() { return (int)g_NullRecorded.size(); }
+const char* RenderNull_GetRecorded(int index)
+{
+    if (index < 0 || index >= (int)g_NullRecorded.size()) return nullptr;
+    return g_NullRecorded[index];
+}
+void RenderNull_ClearRecorded() { g_NullRecorded.clear(); }
+
+//-----------------------------------------
+// ダミーリソース
+// |  生存数を数えるだけ（Null バックエンドで作ったものしか渡らないので static_cast で取り出す）
+//-----------------------------------------
+template<class T>
+class NullObject : public T
+{
+public:
+    NullObject()
+    {
+        g_NullStats.LiveResources++;
+        if (g_NullStats.LiveResources > g_NullStats.PeakResources)
+            g_NullStats.PeakResources = g_NullStats.LiveResources;
+    }
+    ~NullObject() override { g_NullStats.LiveResources--; }
+};
+
+// バッファは中身（Map / UpdateSubresource 先）を持つ
+class NullBuffer : public NullObject<RenderBuffer>
+{
+public:
+    explicit NullBuffer(const RenderBufferDesc& desc) : Desc(desc), Data(desc.ByteWidth) {}
+    RenderBufferDesc Desc;
+    std::vector<unsigned char> Data;
+    bool Mapped = false;
+};
+
+class NullTexture2D : public NullObject<RenderTexture2D>
+{
+public:
+    explicit NullTexture2D(const RenderTexture2DDesc& desc) : Desc(desc) {}
+    RenderTexture2DDesc Desc;
+};
+
+// ビューは D3D11 と同じく元のテクスチャの参照を持つ
+class NullShaderResourceView : public NullObject<RenderShaderResourceView>
+{
+public:
+    explicit NullShaderResourceView(RenderTexture2D* tex) : m_texture(tex) {}
+
+private:
+    RenderPtr<RenderTexture2D> m_texture;
+};
+
+template<class Obj, class T, class... Args>
+static bool RenderNull_Create(T** out, Args&&... args)
+{
+    if (!out) return true;      // D3D11 と同じく out 無しは検証のみ
+    *out = new Obj(std::forward<Args>(args)...);
+    return true;
+}
+
+static const char NULL_SHADER_TAG[] = "NULLSHADER";   // 擬似バイトコードの先頭
+
+//-----------------------------------------
+// デバイス
+//-----------------------------------------
+class NullRenderDevice : public RenderDevice
+{
+protected:
+    bool OnCreateBuffer(const RenderBufferDesc* desc, const RenderSubresourceData* init, RenderBuffer** out) override
+    {
+        if (!desc || desc->ByteWidth == 0) { RenderNull_Error("CreateBuffer", "invalid desc"); return false; }
+        if ((desc->BindFlags & RenderBind_ConstantBuffer) && (desc->ByteWidth % 16) != 0) {
+            RenderNull_Error("CreateBuffer", "constant buffer size must be a multiple of 16");
+            return false;
+        }
+        if (desc->Usage == RenderUsage_Immutable && (!init || !init->pSysMem)) {
+            RenderNull_Error("CreateBuffer", "immutable buffer without initial data");
+            return false;
+        }
+        if (!out) return true;
+        NullBuffer* buf = new NullBuffer(*desc);
+        if (init && init->pSysMem) {
+            memcpy(buf->Data.data(), init->pSysMem, desc->ByteWidth);
+            g_NullStats.BytesUploaded += desc->ByteWidth;
+        }
+        *out = buf;
+        return true;
+    }
+    bool OnCreateTexture2D(const RenderTexture2DDesc* desc, const RenderSubresourceData* init, RenderTexture2D** out) override
+    {
+        if (!desc || desc->Width == 0 || desc->Height == 0) { RenderNull_Error("CreateTexture2D", "invalid desc"); return false; }
+        if (init && init->pSysMem) g_NullStats.BytesUploaded += (unsigned long long)init->SysMemPitch * desc->Height;
+        return RenderNull_Create<NullTexture2D>(out, *desc);
+    }
+    bool OnCreateShaderResourceView(RenderTexture2D* tex, RenderShaderResourceView** out) override
+    {
+        if (!tex) { RenderNull_Error("CreateShaderResourceView", "null resource"); return false; }
+        return RenderNull_Create<NullShaderResourceView>(out, tex);
+    }
+    bool OnCreateInputLayout(const RenderInputElementDesc* desc, unsigned num, const void* code, size_t codeSize, RenderInputLayout** out) override
+    {
+        if (!desc || num == 0 || !code || codeSize == 0) { RenderNull_Error("CreateInputLayout", "invalid args"); return false; }
+        return RenderNull_Create<NullObject<RenderInputLayout>>(out);
+    }
+    bool OnCreateVertexShader(const void* code, size_t codeSize, RenderVertexShader** out) override
+    {
+        if (!code || codeSize == 0) { RenderNull_Error("CreateVertexShader", "empty bytecode"); return false; }
+        return RenderNull_Create<NullObject<RenderVertexShader>>(out);
+    }
+    bool OnCreatePixelShader(const void* code, size_t codeSize, RenderPixelShader** out) override
+    {
+        if (!code || codeSize == 0) { RenderNull_Error("CreatePixelShader", "empty bytecode"); return false; }
+        return RenderNull_Create<NullObject<RenderPixelShader>>(out);
+    }
+    bool OnCreateSamplerState(const RenderSamplerDesc* desc, RenderSamplerState** out) override
+    {
+        if (!desc) { RenderNull_Error("CreateSamplerState", "null desc"); return false; }
+        return RenderNull_Create<NullObject<RenderSamplerState>>(out);
+    }
+    bool OnCreateBlendState(const RenderBlendDesc* desc, RenderBlendState** out) override
+    {
+        if (!desc) { RenderNull_Error("CreateBlendState", "null desc"); return false; }
+        return RenderNull_Create<NullObject<RenderBlendState>>(out);
+    }
+    bool OnCreateDepthStencilState(const RenderDepthStencilDesc* desc, RenderDepthStencilState** out) override
+    {
+        if (!desc) { RenderNull_Error("CreateDepthStencilState", "null desc"); return false; }
+        return RenderNull_Create<NullObject<RenderDepthStencilState>>(out);
+    }
+
+    // 入口の関数があるかだけ見る（HLSL の構文は見ない）。出力は "NULLSHADER target entry" の擬似バイトコード
+    bool OnCompileShader(const char* source, size_t size, const char* name, const char* entry, const char* target, RenderBlob** out, RenderBlob** errors) override
+    {
+        const char* err = nullptr;
+        if (!source || size == 0) err = "empty source";
+        else if (!entry || !target) err = "no entry or target";
+        else if (std::string(source, size).find(entry) == std::string::npos) err = "entry point not found";
+
+        if (err) {
+            if (errors) {
+                char msg[256];
+                snprintf(msg, sizeof(msg), "%s: %s (%s)", name ? name : "shader", err, entry ? entry : "");
+                *errors = new RenderBlob(msg, strlen(msg));
+            }
+            return false;
+        }
+
+        if (out) {
+            std::string code = std::string(NULL_SHADER_TAG) + " " + target + " " + entry;
+            *out = new RenderBlob(code.data(), code.size());
+        }
+        return true;
+    }
+};
+
+//-----------------------------------------
+// コンテキスト
+//-----------------------------------------
+class NullRenderContext : public RenderContext
+{
+protected:
+    void OnUpdateSubresource(RenderBuffer* dst, const void* src) override
+    {
+        RenderNull_Command("UpdateSubresource");
+        if (!dst || !src) { RenderNull_Error("UpdateSubresource", "null resource or source"); return; }
+        NullBuffer* b = static_cast<NullBuffer*>(dst);
+        memcpy(b->Data.data(), src, b->Data.size());
+        g_NullStats.BytesUploaded += b->Data.size();
+    }
+    bool OnMap(RenderBuffer* buf, RenderMap, RenderMappedSubresource* out) override
+    {
+        RenderNull_Command("Map");
+        if (!buf || !out) { RenderNull_Error("Map", "null argument"); return false; }
+        NullBuffer* b = static_cast<NullBuffer*>(buf);
+        if (b->Mapped) { RenderNull_Error("Map", "resource already mapped"); return false; }
+        if (b->Desc.Usage != RenderUsage_Dynamic) { RenderNull_Error("Map", "buffer is not dynamic"); return false; }
+        b->Mapped = true;
+        out->pData = b->Data.data();
+        out->RowPitch = (unsigned)b->Data.size();
+        g_NullStats.BytesUploaded += b->Data.size();
+        return true;
+    }
+    void OnUnmap(RenderBuffer* buf) override
+    {
+        RenderNull_Command("Unmap");
+        if (!buf) { RenderNull_Error("Unmap", "null resource"); return; }
+        NullBuffer* b = static_cast<NullBuffer*>(buf);
+        if (!b->Mapped) { RenderNull_Error("Unmap", "resource not mapped"); return; }
+        b->Mapped = false;
+    }
+
+    void OnIASetVertexBuffers(unsigned slot, unsigned num, RenderBuffer* const* vbs, const unsigned* strides, const unsigned*) override
+    {
+        RenderNull_Command("IASetVertexBuffers");
+        if (num && (!vbs || !strides)) RenderNull_Error("IASetVertexBuffers", "null array");
+        if (slot == 0 && num && vbs) m_vertexBuffer = vbs[0] != nullptr;
+    }
+    void OnIASetIndexBuffer(RenderBuffer* ib, RenderFormat format, unsigned) override
+    {
+        RenderNull_Command("IASetIndexBuffer");
+        if (ib && format != RenderFormat_R16_UInt && format != RenderFormat_R32_UInt)
+            RenderNull_Error("IASetIndexBuffer", "invalid format");
+        m_indexBuffer = ib != nullptr;
+    }
+    void OnIASetPrimitiveTopology(RenderTopology topology) override
+    {
+        RenderNull_Command("IASetPrimitiveTopology");
+        m_topology = topology != RenderTopology_Undefined;
+    }
+    void OnIASetInputLayout(RenderInputLayout* layout) override
+    {
+        RenderNull_Command("IASetInputLayout");
+        m_inputLayout = layout != nullptr;
+    }
+
+    void OnVSSetShader(RenderVertexShader* vs) override
+    {
+        RenderNull_Command("VSSetShader");
+        m_vs = vs != nullptr;
+    }
+    void OnVSSetConstantBuffers(unsigned, unsigned, RenderBuffer* const*) override { RenderNull_Command("VSSetConstantBuffers"); }
+    void OnPSSetShader(RenderPixelShader* ps) override
+    {
+        RenderNull_Command("PSSetShader");
+        m_ps = ps != nullptr;
+    }
+    void OnPSSetConstantBuffers(unsigned, unsigned, RenderBuffer* const*) override { RenderNull_Command("PSSetConstantBuffers"); }
+    void OnPSSetShaderResources(unsigned, unsigned, RenderShaderResourceView* const*) override { RenderNull_Command("PSSetShaderResources"); }
+    void OnPSSetSamplers(unsigned, unsigned, RenderSamplerState* const*) override { RenderNull_Command("PSSetSamplers"); }
+
+    void OnOMSetBlendState(RenderBlendState*, const float[4], unsigned) override { RenderNull_Command("OMSetBlendState"); }
+    void OnOMSetDepthStencilState(RenderDepthStencilState* state, unsigned ref) override
+    {
+        RenderNull_Command("OMSetDepthStencilState");
+        m_depthState = state;
+        m_depthRef = ref;
+    }
+    void OnOMGetDepthStencilState(RenderDepthStencilState** state, unsigned* ref) override
+    {
+        RenderNull_Command("OMGetDepthStencilState");
+        if (state) {
+            *state = m_depthState.Get();
+            if (*state) (*state)->AddRef();
+        }
+        if (ref) *ref = m_depthRef;
+    }
+
+    void OnDraw(unsigned count, unsigned) override
+    {
+        RenderNull_Command("Draw");
+        ValidateDraw("Draw", count, false);
+    }
+    void OnDrawIndexed(unsigned count, unsigned, int) override
+    {
+        RenderNull_Command("DrawIndexed");
+        ValidateDraw("DrawIndexed", count, true);
+    }
+    void OnDrawInstanced(unsigned vertexCount, unsigned instanceCount, unsigned, unsigned) override
+    {
+        RenderNull_Command("DrawInstanced");
+        ValidateDraw("DrawInstanced", vertexCount * instanceCount, false);
+    }
+    void OnDrawIndexedInstanced(unsigned indexCount, unsigned instanceCount, unsigned, int, unsigned) override
+    {
+        RenderNull_Command("DrawIndexedInstanced");
+        ValidateDraw("DrawIndexedInstanced", indexCount * instanceCount, true);
+    }
+
+private:
+    // Draw 前に必要なステートが揃っているか
+    void ValidateDraw(const char* name, unsigned count, bool indexed)
+    {
+        if (count == 0) RenderNull_Error(name, "empty draw");
+        if (!m_vs || !m_ps) RenderNull_Error(name, "shader not bound");
+        if (!m_topology) RenderNull_Error(name, "topology not set");
+        if (m_inputLayout && !m_vertexBuffer) RenderNull_Error(name, "vertex buffer not bound");
+        if (indexed && !m_indexBuffer) RenderNull_Error(name, "index buffer not bound");
+    }
+
+    bool m_vs = false;
+    bool m_ps = false;
+    bool m_inputLayout = false;
+    bool m_topology = false;
+    bool m_vertexBuffer = false;
+    bool m_indexBuffer = false;
+    RenderPtr<RenderDepthStencilState> m_depthState;
+    unsigned m_depthRef = 0;
+};
+
+//-----------------------------------------
+// 生成
+//-----------------------------------------
+RenderDevice* RenderBackend_CreateNullDevice()
+{
+    g_NullStats = {};
+    g_NullRecorded.clear();
+    return new NullRenderDevice();
+}
+
+RenderContext* RenderBackend_CreateNullContext()
+{
+    return new NullRenderContext();
+}
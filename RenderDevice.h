@@ -0,0 +1,596 @@
+﻿// RenderDevice.h
+// 描画バックエンドのインターフェース（GetDevice() / GetContext() が返す）
+// |  公開メソッドは統計を数えてから On〜 を呼ぶ（実処理は各バックエンド）
+// |  RenderBackendD3D11.cpp : D3D11 へ変換して転送（Windows のみ。初期化は RenderBackendD3D11.h）
+// |  RenderBackendNull.cpp  : GPU無しで検証・記録のみ行う（ヘッドレス / ベンチ用。どの OS でも動く）
+// |  バッファ / ステートの記述子と列挙は API に依存しない形でここに置く（値は D3D11 と同じにしてある）
+// |  リソースは参照カウント付きの RenderResource 派生。RenderPtr で保持する
+// |  シェーダーのコンパイルもバックエンドが行う（CompileShader）
+// |  統計は描画元のコンポーネント種別（RenderScope）ごとに分けて集計する
+// |  集計結果は GetRenderStats() で取得（RenderManager.cpp）
+// __________________________________________
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// 集計先の区分（Object.h の ComponentTypes の並び順と一致させる）
+enum RenderScope
+{
+    RenderScope_Camera = 0,
+    RenderScope_Grid,
+    RenderScope_Model,
+    RenderScope_SpriteWorld,
+    RenderScope_SpriteScreen,
+    RenderScope_SpriteBox,
+    RenderScope_SpriteCylinder,
+    RenderScope_Sound,
+    RenderScope_Effect,
+    RenderScope_Engine,         //上記以外（Clear / シェーダー生成 / アセット読込など）
+    RenderScope_Count
+};
+
+// 1区分ぶんのカウンタ
+struct RenderStatsCounters
+{
+    unsigned DrawCalls;         //Draw / DrawIndexed / Draw*Instanced
+    unsigned StateChanges;      //IA / VS / PS / OM の Set 系
+    unsigned TextureBinds;      //PSSetShaderResources
+    unsigned Uploads;           //UpdateSubresource / Map
+    unsigned BufferCreates;     //CreateBuffer
+    unsigned ResourceCreates;   //CreateBuffer 以外の Create 系（テクスチャ / ステート / シェーダー）
+};
+
+// 1フレームぶんの統計
+struct RenderStats
+{
+    unsigned Frame;
+    RenderStatsCounters Total;
+    RenderStatsCounters Scope[RenderScope_Count];
+};
+
+//|| RenderManager API ||______________
+const RenderStats* GetRenderStats();                                //直前に確定したフレームの統計
+void RenderStats_SetScope(int scope);                               //このスレッドの以降の呼び出しの集計先を設定
+int  RenderStats_GetScope();                                        //このスレッドの集計先
+void RenderStats_EndFrame();                                        //フレーム確定（Present後に呼ぶ）
+void RenderStats_SetLogInterval(int frames);                        //Nフレームごとに出力（0で無効）
+void RenderStats_SetSteadyStateAssert(bool enable, int warmupFrames); //定常フレームでのGPUリソース生成を検出
+
+// 集計中の1区分ぶん（RenderStats_EndFrame で RenderStatsCounters へ写す）
+struct RenderStatsAtomicCounters
+{
+    std::atomic<unsigned> DrawCalls;
+    std::atomic<unsigned> StateChanges;
+    std::atomic<unsigned> TextureBinds;
+    std::atomic<unsigned> Uploads;
+    std::atomic<unsigned> BufferCreates;
+    std::atomic<unsigned> ResourceCreates;
+};
+
+// 現在の集計先（スレッドごと。RenderStats_SetScope はそのスレッドだけを切り替え、他スレッドは Engine から始まる）
+extern thread_local RenderStatsAtomicCounters* g_RenderStatsCurrent;
+#define RENDER_STATS_ADD(field) g_RenderStatsCurrent->field.fetch_add(1, std::memory_order_relaxed)
+
+class RenderDevice;
+class RenderContext;
+
+// バックエンド種別
+enum RenderBackendType
+{
+    RenderBackend_None = 0,
+    RenderBackend_D3D11,
+    RenderBackend_Null,
+};
+
+// Null バックエンドの記録結果
+struct RenderNullStats
+{
+    unsigned Commands;          //受け付けたコンテキスト呼び出し数（累計）
+    unsigned ValidationErrors;  //検証エラー数（累計）
+    unsigned LiveResources;     //未解放のリソース数
+    unsigned PeakResources;
+    unsigned long long BytesUploaded;
+};
+
+//|| RenderBackend API ||______________
+bool RenderBackend_InitNull();                                              //GPU無しで動かす（D3D11 は RenderBackendD3D11.h）
+void RenderBackend_Shutdown();
+RenderBackendType RenderBackend_GetType();
+RenderDevice* RenderBackend_GetDevice();
+RenderContext* RenderBackend_GetContext();
+void RenderBackend_Set(RenderBackendType type, RenderDevice* dev, RenderContext* ctx);  //作ったバックエンドを登録（所有権を移す）
+
+// バックエンド生成（RenderBackendNull.cpp）
+RenderDevice* RenderBackend_CreateNullDevice();
+RenderContext* RenderBackend_CreateNullContext();
+
+void RenderNull_GetStats(RenderNullStats* out);
+void RenderNull_SetRecording(bool enable);          //コンテキスト呼び出しの名前を記録（検証用）
+int  RenderNull_GetRecordedCount();
+const char* RenderNull_GetRecorded(int index);
+void RenderNull_ClearRecorded();
+
+//-----------------------------------------
+// 列挙（値は D3D11 / DXGI と同じ。RenderBackendD3D11.cpp で static_assert している）
+//-----------------------------------------
+enum RenderFormat
+{
+    RenderFormat_Unknown = 0,
+    RenderFormat_R32G32B32A32_Float = 2,
+    RenderFormat_R32G32B32_Float = 6,
+    RenderFormat_R16G16B16A16_UInt = 12,
+    RenderFormat_R32G32_Float = 16,
+    RenderFormat_R8G8B8A8_UNorm = 28,
+    RenderFormat_R32_UInt = 42,
+    RenderFormat_R16_UInt = 57,
+};
+
+enum RenderUsage
+{
+    RenderUsage_Default = 0,
+    RenderUsage_Immutable = 1,
+    RenderUsage_Dynamic = 2,
+    RenderUsage_Staging = 3,
+};
+
+enum RenderBind
+{
+    RenderBind_VertexBuffer = 0x1,
+    RenderBind_IndexBuffer = 0x2,
+    RenderBind_ConstantBuffer = 0x4,
+    RenderBind_ShaderResource = 0x8,
+};
+
+enum RenderCpuAccess
+{
+    RenderCpuAccess_Write = 0x10000,
+    RenderCpuAccess_Read = 0x20000,
+};
+
+enum RenderMap
+{
+    RenderMap_Write = 2,
+    RenderMap_WriteDiscard = 4,
+    RenderMap_WriteNoOverwrite = 5,
+};
+
+enum RenderTopology
+{
+    RenderTopology_Undefined = 0,
+    RenderTopology_PointList = 1,
+    RenderTopology_LineList = 2,
+    RenderTopology_LineStrip = 3,
+    RenderTopology_TriangleList = 4,
+    RenderTopology_TriangleStrip = 5,
+};
+
+enum RenderInputClass
+{
+    RenderInput_PerVertex = 0,
+    RenderInput_PerInstance = 1,
+};
+
+enum RenderFilter
+{
+    RenderFilter_Point = 0,
+    RenderFilter_Linear = 0x15,
+};
+
+enum RenderAddress
+{
+    RenderAddress_Wrap = 1,
+    RenderAddress_Mirror = 2,
+    RenderAddress_Clamp = 3,
+};
+
+enum RenderCompare
+{
+    RenderCompare_Never = 1,
+    RenderCompare_Less = 2,
+    RenderCompare_Equal = 3,
+    RenderCompare_LessEqual = 4,
+    RenderCompare_Greater = 5,
+    RenderCompare_NotEqual = 6,
+    RenderCompare_GreaterEqual = 7,
+    RenderCompare_Always = 8,
+};
+
+enum RenderBlend
+{
+    RenderBlend_Zero = 1,
+    RenderBlend_One = 2,
+    RenderBlend_SrcAlpha = 5,
+    RenderBlend_InvSrcAlpha = 6,
+};
+
+enum RenderBlendOp
+{
+    RenderBlendOp_Add = 1,
+    RenderBlendOp_Subtract = 2,
+};
+
+enum RenderDepthWrite
+{
+    RenderDepthWrite_Zero = 0,
+    RenderDepthWrite_All = 1,
+};
+
+#define RENDER_COLOR_WRITE_ALL 0xF
+#define RENDER_LOD_MAX 3.402823466e+38f     //サンプラーの MaxLOD（ミップを全部使う）
+
+//-----------------------------------------
+// 記述子
+//-----------------------------------------
+struct RenderBufferDesc
+{
+    unsigned ByteWidth;
+    RenderUsage Usage;
+    unsigned BindFlags;         //RenderBind の組み合わせ
+    unsigned CPUAccessFlags;    //RenderCpuAccess の組み合わせ
+};
+
+struct RenderTexture2DDesc
+{
+    unsigned Width;
+    unsigned Height;
+    unsigned MipLevels;
+    RenderFormat Format;
+    RenderUsage Usage;
+    unsigned BindFlags;
+};
+
+struct RenderSubresourceData
+{
+    const void* pSysMem;
+    unsigned SysMemPitch;       //テクスチャの1行のバイト数
+};
+
+struct RenderMappedSubresource
+{
+    void* pData;
+    unsigned RowPitch;
+};
+
+struct RenderInputElementDesc
+{
+    const char* SemanticName;
+    unsigned SemanticIndex;
+    RenderFormat Format;
+    unsigned InputSlot;
+    unsigned AlignedByteOffset;
+    RenderInputClass InputSlotClass;
+    unsigned InstanceDataStepRate;
+};
+
+struct RenderSamplerDesc
+{
+    RenderFilter Filter;
+    RenderAddress AddressU;
+    RenderAddress AddressV;
+    RenderAddress AddressW;
+    float MinLOD;
+    float MaxLOD;
+};
+
+struct RenderTargetBlendDesc
+{
+    bool BlendEnable;
+    RenderBlend SrcBlend;
+    RenderBlend DestBlend;
+    RenderBlendOp BlendOp;
+    RenderBlend SrcBlendAlpha;
+    RenderBlend DestBlendAlpha;
+    RenderBlendOp BlendOpAlpha;
+    unsigned char RenderTargetWriteMask;
+};
+
+struct RenderBlendDesc
+{
+    RenderTargetBlendDesc RenderTarget[1];  //描画先は1枚のみ
+};
+
+struct RenderDepthStencilDesc
+{
+    bool DepthEnable;
+    RenderDepthWrite DepthWriteMask;
+    RenderCompare DepthFunc;
+};
+
+//-----------------------------------------
+// リソース
+// |  参照カウント付き（作成時 1。Release で 0 になったら破棄）
+// |  実体は各バックエンドの派生クラス
+//-----------------------------------------
+class RenderResource
+{
+public:
+    unsigned AddRef() { return m_ref.fetch_add(1, std::memory_order_relaxed) + 1; }
+    unsigned Release()
+    {
+        unsigned r = m_ref.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (r == 0) delete this;
+        return r;
+    }
+
+protected:
+    RenderResource() : m_ref(1) {}
+    virtual ~RenderResource() {}
+    RenderResource(const RenderResource&) = delete;
+    RenderResource& operator=(const RenderResource&) = delete;
+
+private:
+    std::atomic<unsigned> m_ref;
+};
+
+class RenderBuffer : public RenderResource {};
+class RenderTexture2D : public RenderResource {};
+class RenderShaderResourceView : public RenderResource {};
+class RenderInputLayout : public RenderResource {};
+class RenderVertexShader : public RenderResource {};
+class RenderPixelShader : public RenderResource {};
+class RenderSamplerState : public RenderResource {};
+class RenderBlendState : public RenderResource {};
+class RenderDepthStencilState : public RenderResource {};
+
+// コンパイル済みシェーダー / コンパイルエラーの文字列（どのバックエンドでも同じ実体）
+class RenderBlob : public RenderResource
+{
+public:
+    RenderBlob(const void* data, size_t size)
+        : m_data(static_cast<const unsigned char*>(data), static_cast<const unsigned char*>(data) + size) {}
+    const void* GetBufferPointer() const { return m_data.data(); }
+    size_t GetBufferSize() const { return m_data.size(); }
+
+private:
+    std::vector<unsigned char> m_data;
+};
+
+// RenderResource の保持（ComPtr と同じ使い方）
+template<class T>
+class RenderPtr
+{
+public:
+    RenderPtr() = default;
+    RenderPtr(std::nullptr_t) {}
+    RenderPtr(T* p) : m_p(p) { if (m_p) m_p->AddRef(); }
+    RenderPtr(const RenderPtr& o) : m_p(o.m_p) { if (m_p) m_p->AddRef(); }
+    RenderPtr(RenderPtr&& o) noexcept : m_p(o.m_p) { o.m_p = nullptr; }
+    ~RenderPtr() { Reset(); }
+
+    RenderPtr& operator=(const RenderPtr& o) { RenderPtr(o).Swap(*this); return *this; }
+    RenderPtr& operator=(RenderPtr&& o) noexcept { RenderPtr(static_cast<RenderPtr&&>(o)).Swap(*this); return *this; }
+    RenderPtr& operator=(T* p) { RenderPtr(p).Swap(*this); return *this; }
+    RenderPtr& operator=(std::nullptr_t) { Reset(); return *this; }
+
+    T* Get() const { return m_p; }
+    T* operator->() const { return m_p; }
+    explicit operator bool() const { return m_p != nullptr; }
+    T* const* GetAddressOf() const { return &m_p; }
+    T** GetAddressOf() { return &m_p; }
+    T** ReleaseAndGetAddressOf() { Reset(); return &m_p; }
+    T** operator&() { return ReleaseAndGetAddressOf(); }   //Create 系の out 引数へ渡す
+    void Reset() { if (m_p) { m_p->Release(); m_p = nullptr; } }
+    void Swap(RenderPtr& o) { T* t = m_p; m_p = o.m_p; o.m_p = t; }
+
+private:
+    T* m_p = nullptr;
+};
+
+//-----------------------------------------
+// デバイス
+//-----------------------------------------
+class RenderDevice
+{
+public:
+    virtual ~RenderDevice() {}
+
+    bool CreateBuffer(const RenderBufferDesc* desc, const RenderSubresourceData* init, RenderBuffer** out)
+    {
+        RENDER_STATS_ADD(BufferCreates);
+        return OnCreateBuffer(desc, init, out);
+    }
+    bool CreateTexture2D(const RenderTexture2DDesc* desc, const RenderSubresourceData* init, RenderTexture2D** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreateTexture2D(desc, init, out);
+    }
+    bool CreateShaderResourceView(RenderTexture2D* tex, RenderShaderResourceView** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreateShaderResourceView(tex, out);
+    }
+    bool CreateInputLayout(const RenderInputElementDesc* desc, unsigned num, const void* code, size_t codeSize, RenderInputLayout** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreateInputLayout(desc, num, code, codeSize, out);
+    }
+    bool CreateVertexShader(const void* code, size_t codeSize, RenderVertexShader** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreateVertexShader(code, codeSize, out);
+    }
+    bool CreatePixelShader(const void* code, size_t codeSize, RenderPixelShader** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreatePixelShader(code, codeSize, out);
+    }
+    bool CreateSamplerState(const RenderSamplerDesc* desc, RenderSamplerState** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreateSamplerState(desc, out);
+    }
+    bool CreateBlendState(const RenderBlendDesc* desc, RenderBlendState** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreateBlendState(desc, out);
+    }
+    bool CreateDepthStencilState(const RenderDepthStencilDesc* desc, RenderDepthStencilState** out)
+    {
+        RENDER_STATS_ADD(ResourceCreates);
+        return OnCreateDepthStencilState(desc, out);
+    }
+
+    // HLSL のコンパイル（entry: "VSMain" など / target: "vs_5_0" など）
+    // |  失敗時は errors にメッセージ（無ければ nullptr）
+    bool CompileShader(const char* source, size_t size, const char* name, const char* entry, const char* target, RenderBlob** out, RenderBlob** errors)
+    {
+        if (errors) *errors = nullptr;
+        return OnCompileShader(source, size, name, entry, target, out, errors);
+    }
+    bool CompileShaderFromFile(const char* path, const char* entry, const char* target, RenderBlob** out, RenderBlob** errors);  //RenderManager.cpp
+
+protected:
+    virtual bool OnCreateBuffer(const RenderBufferDesc* desc, const RenderSubresourceData* init, RenderBuffer** out) = 0;
+    virtual bool OnCreateTexture2D(const RenderTexture2DDesc* desc, const RenderSubresourceData* init, RenderTexture2D** out) = 0;
+    virtual bool OnCreateShaderResourceView(RenderTexture2D* tex, RenderShaderResourceView** out) = 0;
+    virtual bool OnCreateInputLayout(const RenderInputElementDesc* desc, unsigned num, const void* code, size_t codeSize, RenderInputLayout** out) = 0;
+    virtual bool OnCreateVertexShader(const void* code, size_t codeSize, RenderVertexShader** out) = 0;
+    virtual bool OnCreatePixelShader(const void* code, size_t codeSize, RenderPixelShader** out) = 0;
+    virtual bool OnCreateSamplerState(const RenderSamplerDesc* desc, RenderSamplerState** out) = 0;
+    virtual bool OnCreateBlendState(const RenderBlendDesc* desc, RenderBlendState** out) = 0;
+    virtual bool OnCreateDepthStencilState(const RenderDepthStencilDesc* desc, RenderDepthStencilState** out) = 0;
+    virtual bool OnCompileShader(const char* source, size_t size, const char* name, const char* entry, const char* target, RenderBlob** out, RenderBlob** errors) = 0;
+};
+
+//-----------------------------------------
+// コンテキスト
+// |  描画先（バックバッファ / 深度）のクリアと設定はウィンドウを持つ側（Main.cpp）が行う
+//-----------------------------------------
+class RenderContext
+{
+public:
+    virtual ~RenderContext() {}
+
+    // Upload（定数 / 頂点バッファのみ）
+    void UpdateSubresource(RenderBuffer* dst, const void* src)
+    {
+        RENDER_STATS_ADD(Uploads);
+        OnUpdateSubresource(dst, src);
+    }
+    bool Map(RenderBuffer* buf, RenderMap type, RenderMappedSubresource* out)
+    {
+        RENDER_STATS_ADD(Uploads);
+        return OnMap(buf, type, out);
+    }
+    void Unmap(RenderBuffer* buf)
+    {
+        OnUnmap(buf);
+    }
+
+    // IA
+    void IASetVertexBuffers(unsigned slot, unsigned num, RenderBuffer* const* vbs, const unsigned* strides, const unsigned* offsets)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnIASetVertexBuffers(slot, num, vbs, strides, offsets);
+    }
+    void IASetIndexBuffer(RenderBuffer* ib, RenderFormat format, unsigned offset)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnIASetIndexBuffer(ib, format, offset);
+    }
+    void IASetPrimitiveTopology(RenderTopology topology)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnIASetPrimitiveTopology(topology);
+    }
+    void IASetInputLayout(RenderInputLayout* layout)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnIASetInputLayout(layout);
+    }
+
+    // VS / PS
+    void VSSetShader(RenderVertexShader* vs)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnVSSetShader(vs);
+    }
+    void VSSetConstantBuffers(unsigned slot, unsigned num, RenderBuffer* const* cbs)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnVSSetConstantBuffers(slot, num, cbs);
+    }
+    void PSSetShader(RenderPixelShader* ps)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnPSSetShader(ps);
+    }
+    void PSSetConstantBuffers(unsigned slot, unsigned num, RenderBuffer* const* cbs)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnPSSetConstantBuffers(slot, num, cbs);
+    }
+    void PSSetShaderResources(unsigned slot, unsigned num, RenderShaderResourceView* const* srvs)
+    {
+        RENDER_STATS_ADD(TextureBinds);
+        OnPSSetShaderResources(slot, num, srvs);
+    }
+    void PSSetSamplers(unsigned slot, unsigned num, RenderSamplerState* const* samplers)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnPSSetSamplers(slot, num, samplers);
+    }
+
+    // OM
+    void OMSetBlendState(RenderBlendState* state, const float factor[4], unsigned mask)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnOMSetBlendState(state, factor, mask);
+    }
+    void OMSetDepthStencilState(RenderDepthStencilState* state, unsigned ref)
+    {
+        RENDER_STATS_ADD(StateChanges);
+        OnOMSetDepthStencilState(state, ref);
+    }
+    void OMGetDepthStencilState(RenderDepthStencilState** state, unsigned* ref)   //state は AddRef 済みで返る
+    {
+        OnOMGetDepthStencilState(state, ref);
+    }
+
+    // Draw
+    void Draw(unsigned count, unsigned start)
+    {
+        RENDER_STATS_ADD(DrawCalls);
+        OnDraw(count, start);
+    }
+    void DrawIndexed(unsigned count, unsigned startIndex, int baseVertex)
+    {
+        RENDER_STATS_ADD(DrawCalls);
+        OnDrawIndexed(count, startIndex, baseVertex);
+    }
+    void DrawInstanced(unsigned vertexCount, unsigned instanceCount, unsigned startVertex, unsigned startInstance)
+    {
+        RENDER_STATS_ADD(DrawCalls);
+        OnDrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+    }
+    void DrawIndexedInstanced(unsigned indexCount, unsigned instanceCount, unsigned startIndex, int baseVertex, unsigned startInstance)
+    {
+        RENDER_STATS_ADD(DrawCalls);
+        OnDrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+    }
+
+protected:
+    virtual void OnUpdateSubresource(RenderBuffer* dst, const void* src) = 0;
+    virtual bool OnMap(RenderBuffer* buf, RenderMap type, RenderMappedSubresource* out) = 0;
+    virtual void OnUnmap(RenderBuffer* buf) = 0;
+    virtual void OnIASetVertexBuffers(unsigned slot, unsigned num, RenderBuffer* const* vbs, const unsigned* strides, const unsigned* offsets) = 0;
+    virtual void OnIASetIndexBuffer(RenderBuffer* ib, RenderFormat format, unsigned offset) = 0;
+    virtual void OnIASetPrimitiveTopology(RenderTopology topology) = 0;
+    virtual void OnIASetInputLayout(RenderInputLayout* layout) = 0;
+    virtual void OnVSSetShader(RenderVertexShader* vs) = 0;
+    virtual void OnVSSetConstantBuffers(unsigned slot, unsigned num, RenderBuffer* const* cbs) = 0;
+    virtual void OnPSSetShader(RenderPixelShader* ps) = 0;
+    virtual void OnPSSetConstantBuffers(unsigned slot, unsigned num, RenderBuffer* const* cbs) = 0;
+    virtual void OnPSSetShaderResources(unsigned slot, unsigned num, RenderShaderResourceView* const* srvs) = 0;
+    virtual void OnPSSetSamplers(unsigned slot, unsigned num, RenderSamplerState* const* samplers) = 0;
+    virtual void OnOMSetBlendState(RenderBlendState* state, const float factor[4], unsigned mask) = 0;
+    virtual void OnOMSetDepthStencilState(RenderDepthStencilState* state, unsigned ref) = 0;
+    virtual void OnOMGetDepthStencilState(RenderDepthStencilState** state, unsigned* ref) = 0;
+    virtual void OnDraw(unsigned count, unsigned start) = 0;
+    virtual void OnDrawIndexed(unsigned count, unsigned startIndex, int baseVertex) = 0;
+    virtual void OnDrawInstanced(unsigned vertexCount, unsigned instanceCount, unsigned startVertex, unsigned startInstance) = 0;
+    virtual void OnDrawIndexedInstanced(unsigned indexCount, unsigned instanceCount, unsigned startIndex, int baseVertex, unsigned startInstance) = 0;
+};
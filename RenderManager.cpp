@@ -0,0 +1,201 @@
+﻿// RenderManager.cpp
+// 描画バックエンドの切り替えと描画統計の集計
+// |  GetDevice() / GetContext() は現在のバックエンドを返す
+// |  フレーム中は g_RenderStatsCurrent（スレッドごと）の指す区分へ加算。同じ区分へ複数スレッドから足せるよう atomic
+// |  RenderStats_EndFrame で確定し、次フレーム用にクリア
+// __________________________________________
+
+#include "Manager.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static RenderBackendType g_RenderBackendType = RenderBackend_None;
+static RenderDevice* g_RenderBackendDevice = nullptr;
+static RenderContext* g_RenderBackendContext = nullptr;
+static int g_ScreenWidth = 800;     // 描画先の大きさ（ウィンドウ / ベンチ共通）
+static int g_ScreenHeight = 600;
+
+static RenderStatsAtomicCounters g_RenderStatsWork[RenderScope_Count];  // 集計中（区分ごと）
+static unsigned g_RenderStatsFrame = 0;
+static RenderStats g_RenderStatsLast = {};     // 直前フレーム（確定済み）
+static thread_local int g_RenderStatsScope = RenderScope_Engine;
+thread_local RenderStatsAtomicCounters* g_RenderStatsCurrent = &g_RenderStatsWork[RenderScope_Engine];
+
+static int  g_RenderStatsLogInterval = 0;
+static bool g_RenderStatsAssert = false;
+static int  g_RenderStatsWarmup = 0;
+
+static const char* RenderScopeNames[RenderScope_Count] = {
+    "Camera", "Grid", "Model", "SpriteWorld", "SpriteScreen",
+    "SpriteBox", "SpriteCylinder", "Sound", "Effect", "Engine",
+};
+
+//-----------------------------------------
+// バックエンド
+//-----------------------------------------
+void RenderBackend_Set(RenderBackendType type, RenderDevice* dev, RenderContext* ctx)
+{
+    RenderBackend_Shutdown();
+    g_RenderBackendDevice = dev;
+    g_RenderBackendContext = ctx;
+    g_RenderBackendType = (dev && ctx) ? type : RenderBackend_None;
+}
+
+bool RenderBackend_InitNull()
+{
+    RenderBackend_Set(RenderBackend_Null, RenderBackend_CreateNullDevice(), RenderBackend_CreateNullContext());
+    return true;
+}
+
+void RenderBackend_Shutdown()
+{
+    delete g_RenderBackendContext;
+    delete g_RenderBackendDevice;
+    g_RenderBackendContext = nullptr;
+    g_RenderBackendDevice = nullptr;
+    g_RenderBackendType = RenderBackend_None;
+}
+
+RenderBackendType RenderBackend_GetType() { return g_RenderBackendType; }
+RenderDevice* RenderBackend_GetDevice() { return g_RenderBackendDevice; }
+RenderContext* RenderBackend_GetContext() { return g_RenderBackendContext; }
+
+RenderDevice* GetDevice() { return g_RenderBackendDevice; }
+RenderContext* GetContext() { return g_RenderBackendContext; }
+
+int GetScreenWidth() { return g_ScreenWidth; }
+int GetScreenHeight() { return g_ScreenHeight; }
+void SetScreenSize(int width, int height)
+{
+    g_ScreenWidth = width;
+    g_ScreenHeight = height;
+}
+
+//-----------------------------------------
+// シェーダー
+//-----------------------------------------
+// ファイルを読んで CompileShader へ渡す（name はパス）
+bool RenderDevice::CompileShaderFromFile(const char* path, const char* entry, const char* target, RenderBlob** out, RenderBlob** errors)
+{
+    if (errors) *errors = nullptr;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        if (errors) {
+            char msg[512];
+            snprintf(msg, sizeof(msg), "%s: file not found", path);
+            *errors = new RenderBlob(msg, strlen(msg));
+        }
+        return false;
+    }
+    std::vector<char> source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    return CompileShader(source.data(), source.size(), path, entry, target, out, errors);
+}
+
+//-----------------------------------------
+// 区分
+//-----------------------------------------
+void RenderStats_SetScope(int scope)
+{
+    if (scope < 0 || scope >= RenderScope_Count) scope = RenderScope_Engine;
+    g_RenderStatsScope = scope;
+    g_RenderStatsCurrent = &g_RenderStatsWork[scope];
+}
+
+int RenderStats_GetScope()
+{
+    return g_RenderStatsScope;
+}
+
+const RenderStats* GetRenderStats()
+{
+    return &g_RenderStatsLast;
+}
+
+void RenderStats_SetLogInterval(int frames)
+{
+    g_RenderStatsLogInterval = frames > 0 ? frames : 0;
+}
+
+void RenderStats_SetSteadyStateAssert(bool enable, int warmupFrames)
+{
+    g_RenderStatsAssert = enable;
+    g_RenderStatsWarmup = warmupFrames > 0 ? warmupFrames : 0;
+}
+
+//-----------------------------------------
+// フレーム確定
+//-----------------------------------------
+static void RenderStats_Add(RenderStatsCounters& dst, const RenderStatsCounters& src)
+{
+    dst.DrawCalls += src.DrawCalls;
+    dst.StateChanges += src.StateChanges;
+    dst.TextureBinds += src.TextureBinds;
+    dst.Uploads += src.Uploads;
+    dst.BufferCreates += src.BufferCreates;
+    dst.ResourceCreates += src.ResourceCreates;
+}
+
+// 集計中の値を取り出して 0 に戻す（取り出した後の加算は次のフレームへ入る）
+static void RenderStats_Take(RenderStatsCounters& dst, RenderStatsAtomicCounters& src)
+{
+    dst.DrawCalls = src.DrawCalls.exchange(0, std::memory_order_relaxed);
+    dst.StateChanges = src.StateChanges.exchange(0, std::memory_order_relaxed);
+    dst.TextureBinds = src.TextureBinds.exchange(0, std::memory_order_relaxed);
+    dst.Uploads = src.Uploads.exchange(0, std::memory_order_relaxed);
+    dst.BufferCreates = src.BufferCreates.exchange(0, std::memory_order_relaxed);
+    dst.ResourceCreates = src.ResourceCreates.exchange(0, std::memory_order_relaxed);
+}
+
+static void RenderStats_Log(const RenderStats& s)
+{
+    char line[256];
+    snprintf(line, sizeof(line), "[RenderStats] frame %u: draw %u / state %u / tex %u / upload %u / buffer %u / resource %u\n",
+        s.Frame, s.Total.DrawCalls, s.Total.StateChanges, s.Total.TextureBinds,
+        s.Total.Uploads, s.Total.BufferCreates, s.Total.ResourceCreates);
+    System_DebugOutput(line);
+
+    for (int i = 0; i < RenderScope_Count; ++i) {
+        const RenderStatsCounters& c = s.Scope[i];
+        if (c.DrawCalls + c.StateChanges + c.TextureBinds + c.Uploads + c.BufferCreates + c.ResourceCreates == 0) continue;
+        snprintf(line, sizeof(line), "  %-15s draw %u / state %u / tex %u / upload %u / buffer %u / resource %u\n",
+            RenderScopeNames[i], c.DrawCalls, c.StateChanges, c.TextureBinds,
+            c.Uploads, c.BufferCreates, c.ResourceCreates);
+        System_DebugOutput(line);
+    }
+}
+
+void RenderStats_EndFrame()
+{
+    RenderStats w = {};
+    w.Frame = g_RenderStatsFrame++;
+    for (int i = 0; i < RenderScope_Count; ++i) {
+        RenderStats_Take(w.Scope[i], g_RenderStatsWork[i]);
+        RenderStats_Add(w.Total, w.Scope[i]);
+    }
+
+    g_RenderStatsLast = w;
+
+    if (g_RenderStatsLogInterval > 0 && (w.Frame % (unsigned)g_RenderStatsLogInterval) == 0)
+        RenderStats_Log(w);
+
+    // 定常フレームでGPUリソースを作っていたら停止
+    if (g_RenderStatsAssert && w.Frame >= (unsigned)g_RenderStatsWarmup &&
+        (w.Total.BufferCreates != 0 || w.Total.ResourceCreates != 0))
+    {
+        RenderStats_Log(w);
+        AddMessage("RenderStats: GPU resource created in steady-state frame");
+        assert(!"RenderStats: GPU resource created in steady-state frame");
+    }
+
+    RenderStats_SetScope(RenderScope_Engine);
+}
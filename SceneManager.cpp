@@ -3,29 +3,287 @@
 // Objectにインデックスを割り振り、Sceneごとに管理する仕組みを提供。
 
 #include "Manager.h"
+#include "AssetLoad.h"
+#include "JobSystem.h"
+#include <climits>
+#include <string>
 #include <vector>
 
+// シーンのアセット読み込み状態
+enum SceneLoadState {
+    SceneLoad_Unloaded = 0,     // テクスチャ未読み込み（コンポーネントは GPU リソースなし）
+    SceneLoad_Loading,          // 非同期読み込み中
+    SceneLoad_Loaded,
+};
+
 // Scene範囲構造体（元通り）
 typedef struct {
     int StartIndex_Grid, EndIndex_Grid;
     int StartIndex_GridBox, EndIndex_GridBox;
     int StartIndex_GridPolygon, EndIndex_GridPolygon;
+    int StartIndex_BoxCollider, EndIndex_BoxCollider;
     int StartIndex_Camera, EndIndex_Camera;
     int StartIndex_SpriteWorld, EndIndex_SpriteWorld;
     int StartIndex_SpriteScreen, EndIndex_SpriteScreen;
     int StartIndex_SpriteBox, EndIndex_SpriteBox;
     int StartIndex_SpriteCylinder, EndIndex_SpriteCylinder;
+    int StartIndex_Model, EndIndex_Model;
+    int StartIndex_Effect, EndIndex_Effect;
     int UseCameraIndex;
     bool Finalized;
+    int LoadState;
+    unsigned Reused;    // 削除済みシーンの範囲を引き継いだ type のビット（末尾へ移るまで End を固定）
 } SceneRange;
 
+// 削除したシーンが空けた行の範囲（次の AddScene が type ごとに引き継ぐ）
+typedef struct {
+    IndexType Type;
+    int Begin, End;
+} SceneHole;
+
+// シーン単位の範囲を持つ type（Camera / GridLine はシーン間で共有）
+static const IndexType SceneRangeTypes[] = {
+    IndexType::SpriteWorld, IndexType::SpriteScreen, IndexType::SpriteBox, IndexType::SpriteCylinder,
+    IndexType::GridBox, IndexType::GridPolygon, IndexType::BoxCollider, IndexType::Model, IndexType::Effect,
+};
+
 static std::vector<SceneRange> SceneRanges;
+static std::vector<SceneHole> SceneHoles;
+static std::vector<std::vector<std::string>> SceneAssets;   // シーンごとのマニフェスト（テクスチャのパス）
 static KeyMap SceneMap;
 static int CurrentSceneIndex = -1;
 static int ActiveSceneIndex = -1;
+static int PendingSceneIndex = -1;  // ChangeSceneWhenLoaded の切り替え先
 void SettingScene();
 void SceneEndPoint();
 
+// Object 側のシーン別リストへ範囲を反映（Sprite 系 / Model / Effect はシーン単位、Camera / Sound は共通）
+static void SyncObjectSceneList(int sceneIndex)
+{
+    Object* obj = GetObjectClass();
+    if (!obj || sceneIndex < 0 || sceneIndex >= (int)SceneRanges.size()) return;
+    const SceneRange& r = SceneRanges[sceneIndex];
+    obj->SetSceneRange<SpriteWorld>(sceneIndex, r.StartIndex_SpriteWorld, r.EndIndex_SpriteWorld);
+    obj->SetSceneRange<SpriteScreen>(sceneIndex, r.StartIndex_SpriteScreen, r.EndIndex_SpriteScreen);
+    obj->SetSceneRange<SpriteBox>(sceneIndex, r.StartIndex_SpriteBox, r.EndIndex_SpriteBox);
+    obj->SetSceneRange<SpriteCylinder>(sceneIndex, r.StartIndex_SpriteCylinder, r.EndIndex_SpriteCylinder);
+    obj->SetSceneRange<Model>(sceneIndex, r.StartIndex_Model, r.EndIndex_Model);
+    obj->SetSceneRange<Effect>(sceneIndex, r.StartIndex_Effect, r.EndIndex_Effect);
+}
+
+static void SetObjectActiveScene(int sceneIndex)
+{
+    if (GetObjectClass()) GetObjectClass()->SetActiveScene(sceneIndex);
+}
+
+//-----------------------------------------
+// ストリーミング（内部）
+// |  読み込み: マニフェストの参照を増やして非同期ロード → 揃ったらコンポーネントを組み直す
+// |  解放    : コンポーネントの GPU リソースを捨てて参照を外す（0 になったテクスチャは解放）
+//-----------------------------------------
+static bool SceneSlotFields(SceneRange& r, IndexType type, int** begin, int** end)
+{
+    switch (type)
+    {
+    case IndexType::SpriteWorld:    *begin = &r.StartIndex_SpriteWorld;    *end = &r.EndIndex_SpriteWorld;    return true;
+    case IndexType::SpriteScreen:   *begin = &r.StartIndex_SpriteScreen;   *end = &r.EndIndex_SpriteScreen;   return true;
+    case IndexType::SpriteBox:      *begin = &r.StartIndex_SpriteBox;      *end = &r.EndIndex_SpriteBox;      return true;
+    case IndexType::SpriteCylinder: *begin = &r.StartIndex_SpriteCylinder; *end = &r.EndIndex_SpriteCylinder; return true;
+    case IndexType::GridBox:        *begin = &r.StartIndex_GridBox;        *end = &r.EndIndex_GridBox;        return true;
+    case IndexType::GridPolygon:    *begin = &r.StartIndex_GridPolygon;    *end = &r.EndIndex_GridPolygon;    return true;
+    case IndexType::BoxCollider:    *begin = &r.StartIndex_BoxCollider;    *end = &r.EndIndex_BoxCollider;    return true;
+    case IndexType::Model:          *begin = &r.StartIndex_Model;          *end = &r.EndIndex_Model;          return true;
+    case IndexType::Effect:         *begin = &r.StartIndex_Effect;         *end = &r.EndIndex_Effect;         return true;
+    default: return false;
+    }
+}
+
+static void SceneSlotRange(const SceneRange& r, IndexType type, int* begin, int* end)
+{
+    int *b, *e;
+    if (!SceneSlotFields(const_cast<SceneRange&>(r), type, &b, &e)) { *begin = *end = 0; return; }
+    *begin = *b;
+    *end = *e;
+}
+
+// テクスチャを持つコンポーネントの全スロットに fn
+static void Scene_ForEachSlot(int index, void (*fn)(IndexType, int))
+{
+    const IndexType types[] = { IndexType::SpriteWorld, IndexType::SpriteScreen, IndexType::SpriteBox, IndexType::SpriteCylinder };
+    for (IndexType type : types)
+    {
+        int begin, end;
+        SceneSlotRange(SceneRanges[index], type, &begin, &end);
+        for (int i = begin; i < end; ++i) fn(type, i);
+    }
+}
+
+static bool Scene_AssetsReady(int index)
+{
+    for (const std::string& a : SceneAssets[index])
+        if (AL_IsLoadPending(a.c_str())) return false;
+    return true;
+}
+
+static void Scene_BeginLoad(int index)
+{
+    SceneRange& r = SceneRanges[index];
+    if (r.LoadState != SceneLoad_Unloaded) return;
+    for (const std::string& a : SceneAssets[index])
+    {
+        Texture_AddRef(a.c_str());
+        if (!Texture_IsResident(a.c_str())) AL_LoadFromPackageByNameAsync(a.c_str());
+    }
+    r.LoadState = SceneLoad_Loading;
+}
+
+// 全アセットの GPU 登録後にメインスレッドで
+static void Scene_FinishLoad(int index)
+{
+    SceneRanges[index].LoadState = SceneLoad_Loaded;
+    Scene_ForEachSlot(index, RestoreObjectResources);
+}
+
+static void Scene_EnsureLoaded(int index)
+{
+    if (SceneRanges[index].LoadState == SceneLoad_Loaded) return;
+    Scene_BeginLoad(index);
+    if (!Scene_AssetsReady(index)) AL_WaitAsyncLoads();
+    Scene_FinishLoad(index);
+}
+
+static void Scene_Unload(int index)
+{
+    SceneRange& r = SceneRanges[index];
+    if (r.LoadState == SceneLoad_Unloaded) return;
+    if (!Scene_AssetsReady(index)) AL_WaitAsyncLoads();
+    if (PendingSceneIndex == index) PendingSceneIndex = -1;
+
+    r.LoadState = SceneLoad_Unloaded;
+    // CopyScene で共有しているスロットは他のシーンが読み込み済みなら残す
+    Scene_ForEachSlot(index, [](IndexType type, int i) {
+        if (!IsSceneSlotLoaded(type, i)) ReleaseObjectResources(type, i);
+    });
+    for (const std::string& a : SceneAssets[index]) Texture_Release(a.c_str());
+}
+
+static void Scene_Switch(int index)
+{
+    CurrentSceneIndex = index;
+    ActiveSceneIndex = index;
+    SetObjectActiveScene(index);    // O(1)：描画・更新対象のリストを差し替えるだけ
+}
+
+// 毎フレーム：読み込みの完了を反映し、待っている切り替えを行う
+static void Scene_UpdateStreaming()
+{
+    for (int i = 0; i < (int)SceneRanges.size(); ++i)
+        if (SceneRanges[i].LoadState == SceneLoad_Loading && Scene_AssetsReady(i)) Scene_FinishLoad(i);
+
+    if (PendingSceneIndex >= 0 && SceneRanges[PendingSceneIndex].LoadState == SceneLoad_Loaded)
+    {
+        Scene_Switch(PendingSceneIndex);
+        PendingSceneIndex = -1;
+    }
+    // ChangeScene を通らずに使われているシーン（AddScene 直後など）
+    if (CurrentSceneIndex >= 0 && CurrentSceneIndex < (int)SceneRanges.size())
+        Scene_EnsureLoaded(CurrentSceneIndex);
+}
+
+//-----------------------------------------
+// 削除済みシーンの行の再利用
+// |  DeleteScene が空けた [Start, End) を穴として残し、次の AddScene がその範囲から始める
+// |  Pool の末尾に接する穴はそのまま末尾へ伸ばせる。途中の穴は End を固定し、
+// |  埋まったら範囲ごと末尾へ移して（元の範囲は穴に戻す）以後は末尾に積む
+//-----------------------------------------
+static unsigned SceneTypeBit(IndexType type) { return 1u << (int)type; }
+
+static int ScenePoolCount(IndexType type)
+{
+    ObjectIndex* idx = GetObjectIndex();
+    switch (type)
+    {
+    case IndexType::SpriteWorld:    return idx->SpriteWorldIndex;
+    case IndexType::SpriteScreen:   return idx->SpriteScreenIndex;
+    case IndexType::SpriteBox:      return idx->SpriteBoxIndex;
+    case IndexType::SpriteCylinder: return idx->SpriteCylinderIndex;
+    case IndexType::GridBox:        return idx->GridBoxIndex;
+    case IndexType::GridPolygon:    return idx->GridPolygonIndex;
+    case IndexType::BoxCollider:    return idx->BoxColliderIndex;
+    case IndexType::Model:          return idx->ModelIndex;
+    case IndexType::Effect:         return idx->EffectIndex;
+    default: return 0;
+    }
+}
+
+// 確定前の範囲を Pool の末尾まで伸ばす（引き継いだ範囲は固定のまま）
+static void Scene_ExtendEnds(SceneRange& r)
+{
+    ObjectIndex* idx = GetObjectIndex();
+    for (IndexType type : SceneRangeTypes) {
+        int *b, *e;
+        if (!(r.Reused & SceneTypeBit(type)) && SceneSlotFields(r, type, &b, &e)) *e = ScenePoolCount(type);
+    }
+    r.EndIndex_Camera = idx->CameraIndex;
+    r.EndIndex_Grid = idx->GridLineIndex;
+}
+
+// 隣り合う穴はまとめる
+static void Scene_AddHole(IndexType type, int begin, int end)
+{
+    if (begin >= end) return;
+    for (size_t i = 0; i < SceneHoles.size();) {
+        const SceneHole& h = SceneHoles[i];
+        if (h.Type == type && (h.End == begin || h.Begin == end)) {
+            if (h.Begin < begin) begin = h.Begin;
+            if (h.End > end) end = h.End;
+            SceneHoles[i] = SceneHoles.back();
+            SceneHoles.pop_back();
+            continue;
+        }
+        ++i;
+    }
+    SceneHoles.push_back({ type, begin, end });
+}
+
+// 新しいシーンの範囲を穴から始める（末尾に接する穴を優先、無ければ一番大きい穴）
+static void Scene_TakeHole(SceneRange& r, IndexType type)
+{
+    int count = ScenePoolCount(type);
+    int pick = -1;
+    for (int i = 0; i < (int)SceneHoles.size(); ++i) {
+        const SceneHole& h = SceneHoles[i];
+        if (h.Type != type) continue;
+        if (h.End == count) { pick = i; break; }
+        if (pick < 0 || h.End - h.Begin > SceneHoles[pick].End - SceneHoles[pick].Begin) pick = i;
+    }
+    int *b, *e;
+    if (pick < 0 || !SceneSlotFields(r, type, &b, &e)) return;
+    SceneHole h = SceneHoles[pick];
+    SceneHoles[pick] = SceneHoles.back();
+    SceneHoles.pop_back();
+    *b = h.Begin;
+    *e = h.End;
+    if (h.End != count) r.Reused |= SceneTypeBit(type);
+}
+
+bool MoveActiveSceneRangeToTail(IndexType type)
+{
+    if (ActiveSceneIndex < 0 || ActiveSceneIndex >= (int)SceneRanges.size()) return false;
+    SceneRange& r = SceneRanges[ActiveSceneIndex];
+    int *b, *e;
+    if (r.Finalized || !(r.Reused & SceneTypeBit(type)) || !SceneSlotFields(r, type, &b, &e)) return false;
+    int begin = *b, end = *e;
+    int dst = MoveObjectRange(type, begin, end);
+    if (dst < 0) return false;
+    *b = dst;
+    *e = ScenePoolCount(type);
+    r.Reused &= ~SceneTypeBit(type);
+    Scene_AddHole(type, begin, end);
+    SyncObjectSceneList(ActiveSceneIndex);
+    return true;
+}
+
 //-----------------------------------------
 // Scene操作
 //-----------------------------------------
@@ -52,29 +310,35 @@ void AddScene(const char* name)
     range.EndIndex_GridBox = idx->GridBoxIndex;
     range.StartIndex_GridPolygon = idx->GridPolygonIndex;
     range.EndIndex_GridPolygon = idx->GridPolygonIndex;
+    range.StartIndex_BoxCollider = idx->BoxColliderIndex;
+    range.EndIndex_BoxCollider = idx->BoxColliderIndex;
+    range.StartIndex_Model = idx->ModelIndex;
+    range.EndIndex_Model = idx->ModelIndex;
+    range.StartIndex_Effect = idx->EffectIndex;
+    range.EndIndex_Effect = idx->EffectIndex;
     range.StartIndex_Grid = idx->GridLineIndex;
     range.EndIndex_Grid = idx->GridLineIndex;
     range.UseCameraIndex = -1;
     range.Finalized = false;
+    range.LoadState = SceneLoad_Unloaded;   // 最初に使われる時に読み込む
+    for (IndexType type : SceneRangeTypes) Scene_TakeHole(range, type);
 
     SceneRanges.push_back(range);
+    SceneAssets.emplace_back();
+    SyncObjectSceneList(newIndex);
+    SetObjectActiveScene(newIndex);
 }
 
 void SceneEndPoint()
 {
-    if (SceneRanges.empty()) return;
+    if (SceneRanges.empty() || CurrentSceneIndex < 0) return;
     ObjectIndex* idx = GetObjectIndex();
     SceneRange& r = SceneRanges[CurrentSceneIndex];
+    if (r.Finalized) { ActiveSceneIndex = -1; return; }     // 確定済みの範囲は広げない
 
-    r.EndIndex_Camera = idx->CameraIndex;
-    r.EndIndex_SpriteWorld = idx->SpriteWorldIndex;
-    r.EndIndex_SpriteScreen = idx->SpriteScreenIndex;
-    r.EndIndex_SpriteBox = idx->SpriteBoxIndex;
-    r.EndIndex_SpriteCylinder = idx->SpriteCylinderIndex;
-    r.EndIndex_GridBox = idx->GridBoxIndex;
-    r.EndIndex_GridPolygon = idx->GridPolygonIndex;
-    r.EndIndex_Grid = idx->GridLineIndex;
+    Scene_ExtendEnds(r);
     r.Finalized = true;
+    SyncObjectSceneList(CurrentSceneIndex);
 
     ActiveSceneIndex = -1;
 }
@@ -85,13 +349,8 @@ void RefreshSceneRange()
     SceneRange& range = SceneRanges[CurrentSceneIndex];
     if (range.Finalized) return; // ✅ 確定済みは更新しない
 
-    ObjectIndex* idx = GetObjectIndex();
-    range.EndIndex_Camera = idx->CameraIndex;
-    range.EndIndex_SpriteWorld = idx->SpriteWorldIndex;
-    range.EndIndex_SpriteScreen = idx->SpriteScreenIndex;
-    range.EndIndex_GridBox = idx->GridBoxIndex;
-    range.EndIndex_GridPolygon = idx->GridPolygonIndex;
-    range.EndIndex_Grid = idx->GridLineIndex;
+    Scene_ExtendEnds(range);
+    SyncObjectSceneList(CurrentSceneIndex);
 }
 //-----------------------------------------
 // Scene初期化
@@ -103,6 +362,7 @@ void InitScene(const char* name)
 
     SceneRange& range = SceneRanges[index];
     CurrentSceneIndex = index;
+    SetObjectActiveScene(index);
     ObjectDataPool* pool = GetObjectDataPool();
     //Camera
     int useCam = range.UseCameraIndex >= 0 ? range.UseCameraIndex : GetUseCamera();
@@ -139,19 +399,48 @@ void InitScene(const char* name)
 }
 
 //-----------------------------------------
-// Sceneコピー（簡易）
-/* 元の処理を維持。コピー時にPool 内 Vec を push する処理は
-   ObjectManager 側の API と合わせて呼ぶ実装が望ましいが、
-   簡略版として SceneRange の複製で対応。 */
+// Sceneコピー
+// |  元シーンのオブジェクトを Pool の末尾へまとめて複製し、新しい範囲を持つシーンを作る
+// |  名前は "<newScene>/<元の名前>"（例: SetSpriteWorldPos("Copy1/TestSprite01", ...)）
+// |  Camera はシーン間で共有のため複製しない
+//-----------------------------------------
+static void CopySceneRange(IndexType type, int& begin, int& end, const char* prefix)
+{
+    int dst = CopyObjectRange(type, begin, end, prefix);
+    if (dst < 0) { begin = end = 0; return; }
+    end = dst + (end - begin);
+    begin = dst;
+}
+
 void CopyScene(const char* srcScene, const char* newScene)
 {
     int srcIndex = KeyMap_GetIndex(&SceneMap, srcScene);
     if (srcIndex == -1) { AddMessage(ConcatCStr("CopyScene failed: ", srcScene)); return; }
+    if (KeyMap_GetIndex(&SceneMap, newScene) != -1) { AddMessage(ConcatCStr("CopyScene failed (already exists): ", newScene)); return; }
+
+    // 作成中のシーンは先に閉じる（末尾に足した複製を取り込まないように）
+    if (ActiveSceneIndex >= 0 && ActiveSceneIndex == CurrentSceneIndex && !SceneRanges[ActiveSceneIndex].Finalized)
+        SceneEndPoint();
+
+    std::string prefix = std::string(newScene) + "/";
+    SceneRange dst = SceneRanges[srcIndex];
+    CopySceneRange(IndexType::SpriteWorld, dst.StartIndex_SpriteWorld, dst.EndIndex_SpriteWorld, prefix.c_str());
+    CopySceneRange(IndexType::SpriteScreen, dst.StartIndex_SpriteScreen, dst.EndIndex_SpriteScreen, prefix.c_str());
+    CopySceneRange(IndexType::SpriteBox, dst.StartIndex_SpriteBox, dst.EndIndex_SpriteBox, prefix.c_str());
+    CopySceneRange(IndexType::SpriteCylinder, dst.StartIndex_SpriteCylinder, dst.EndIndex_SpriteCylinder, prefix.c_str());
+    CopySceneRange(IndexType::GridBox, dst.StartIndex_GridBox, dst.EndIndex_GridBox, prefix.c_str());
+    CopySceneRange(IndexType::GridPolygon, dst.StartIndex_GridPolygon, dst.EndIndex_GridPolygon, prefix.c_str());
+    CopySceneRange(IndexType::BoxCollider, dst.StartIndex_BoxCollider, dst.EndIndex_BoxCollider, prefix.c_str());
+    CopySceneRange(IndexType::Model, dst.StartIndex_Model, dst.EndIndex_Model, prefix.c_str());
+    CopySceneRange(IndexType::Effect, dst.StartIndex_Effect, dst.EndIndex_Effect, prefix.c_str());
+    dst.Finalized = true;
+    dst.Reused = 0;
+    dst.LoadState = SceneLoad_Unloaded;
 
     KeyMap_Add(&SceneMap, newScene);
-    SceneRange src = SceneRanges[srcIndex];
-    SceneRange dst = src;
     SceneRanges.push_back(dst);
+    SceneAssets.push_back(SceneAssets[srcIndex]);
+    SyncObjectSceneList((int)SceneRanges.size() - 1);
     AddMessage(ConcatCStr("CopyScene(): ", newScene));
 }
 
@@ -160,12 +449,17 @@ void CopyScene(const char* srcScene, const char* newScene)
 //-----------------------------------------
 void UpdateScene()
 {
+    LIA_PROFILE_SCOPE("UpdateScene");
     RefreshSceneRange();
+    Scene_UpdateStreaming();
 
     if (CurrentSceneIndex < 0 || CurrentSceneIndex >= (int)SceneRanges.size()) return;
     SceneRange& range = SceneRanges[CurrentSceneIndex];
     ObjectDataPool* pool = GetObjectDataPool();
 
+    // 当たり判定（結果は GetCollisionContacts で取得）
+    UpdateCollision(range.StartIndex_BoxCollider, range.EndIndex_BoxCollider);
+
     int cam = (range.UseCameraIndex >= 0) ? range.UseCameraIndex : GetUseCamera();
     if (cam < 0 || cam >= (int)pool->CameraPos.size) return;
 
@@ -179,8 +473,26 @@ void UpdateScene()
     }
 }
 
+// Pool のワールド行列 * viewProj を転置してコンポーネントへ渡す
+// |  カメラが同じなら、ワールド行列が計算し直されたもの・未計算のもの・視錐台に入ってきたものだけ
+template<class T>
+static void BatchMVP(Object* obj, IndexType type, int begin, int end, const XMMATRIX& viewProj, bool all)
+{
+    Job_ParallelFor(begin, end, 0, [&](int b, int e)
+    {
+        for (int i = b; i < e; i++)
+        {
+            T* c = obj->GetComponent<T>(i);
+            if (!c || !c->Enabled || c->Culled) continue;
+            if (!all && !c->IsMatrixDirty() && !IsTransformUpdated(type, i) && !IsObjectNewlyVisible(type, i)) continue;
+            c->SetMVP(XMMatrixTranspose(XMMatrixMultiply(GetWorldMatrix(type, i), viewProj)));
+        }
+    });
+}
+
 void DrawScene()
 {
+    LIA_PROFILE_SCOPE("DrawScene");
     if (CurrentSceneIndex < 0 || CurrentSceneIndex >= (int)SceneRanges.size()) return;
     SceneRange& range = SceneRanges[CurrentSceneIndex];
     ObjectDataPool* pool = GetObjectDataPool();
@@ -190,9 +502,33 @@ void DrawScene()
 
     if (!GetGridClass() || !GetObjectClass()) return;
 
+    // 親子付けを反映したワールド行列と境界（変更のあった部分だけ）
+    UpdateTransforms();
+    UpdateBounds();
+    UpdateSpatialIndex();
+
+    // カメラ行列はシーンで1回だけ取得（view * proj はカメラ側で変わったときだけ計算済み）
+    Camera* cam = GetObjectClass()->GetComponent<Camera>(useCam);
+    if (!cam)
+    {
+        System_MessageBox("CameraNotFound", "DrawScene");
+        return;
+    }
+    const XMMATRIX viewProj = cam->GetViewProjection();
+
+    // カメラかシーンが前フレームと違えば全オブジェクトの MVP を作り直す
+    static Camera* s_lastCam = nullptr;
+    static unsigned s_lastCamVersion = 0;
+    static int s_lastScene = -1;
+    bool camChanged = (cam != s_lastCam || cam->GetVersion() != s_lastCamVersion || CurrentSceneIndex != s_lastScene);
+    s_lastCam = cam;
+    s_lastCamVersion = cam->GetVersion();
+    s_lastScene = CurrentSceneIndex;
 
-    GetGridClass()->SetProj(GetObjectClass()->GetComponent<Camera>(useCam)->GetProjection());
-    GetGridClass()->SetView(GetObjectClass()->GetComponent<Camera>(useCam)->GetView());
+    RenderStats_SetScope(RenderScope_Grid);
+
+    GetGridClass()->SetViewProjection(viewProj);
+    SetCullingFrustum(viewProj);
 
     // GridBase
     GetGridClass()->SetColor({ 0,0,0,1 });
@@ -217,139 +553,171 @@ void DrawScene()
 
     // GridBox
     if (SceneRanges[CurrentSceneIndex].StartIndex_GridBox >= 0 && SceneRanges[CurrentSceneIndex].EndIndex_GridBox <= (int)pool->GridBoxPos.size) {
+        CullRange(IndexType::GridBox, SceneRanges[CurrentSceneIndex].StartIndex_GridBox, SceneRanges[CurrentSceneIndex].EndIndex_GridBox);
         for (int i = SceneRanges[CurrentSceneIndex].StartIndex_GridBox; i < SceneRanges[CurrentSceneIndex].EndIndex_GridBox; i++) {
             if (i < 0 || i >= (int)pool->GridBoxPos.size) continue;
-            Vec4 pos = Vec4_Get(&pool->GridBoxPos, i);
+            if (!IsObjectVisible(IndexType::GridBox, i)) continue;     // 削除済みも外
             Vec4 size = Vec4_Get(&pool->GridBoxSize, i);
-            Vec4 ang = Vec4_Get(&pool->GridBoxAngle, i);
             Vec4 col = Vec4_Get(&pool->GridBoxColor, i);
             GetGridClass()->SetColor({ col.X,col.Y,col.Z,col.W });
-            GetGridClass()->DrawBox({ pos.X,pos.Y,pos.Z }, { size.X,size.Y,size.Z }, { ang.X,ang.Y,ang.Z });
+            GetGridClass()->DrawBox(GetWorldMatrix(IndexType::GridBox, i), { size.X,size.Y,size.Z });
         }
     }
 
     // GridPolygon
     if (SceneRanges[CurrentSceneIndex].StartIndex_GridPolygon >= 0 && SceneRanges[CurrentSceneIndex].EndIndex_GridPolygon <= (int)pool->GridPolygonPos.size) {
+        CullRange(IndexType::GridPolygon, SceneRanges[CurrentSceneIndex].StartIndex_GridPolygon, SceneRanges[CurrentSceneIndex].EndIndex_GridPolygon);
         for (int i = SceneRanges[CurrentSceneIndex].StartIndex_GridPolygon; i < SceneRanges[CurrentSceneIndex].EndIndex_GridPolygon; i++) {
             if (i < 0 || i >= (int)pool->GridPolygonPos.size) continue;
-            Vec4 pos = Vec4_Get(&pool->GridPolygonPos, i);
+            if (!IsObjectVisible(IndexType::GridPolygon, i)) continue;
             Vec4 size = Vec4_Get(&pool->GridPolygonSize, i);
-            Vec4 ang = Vec4_Get(&pool->GridPolygonAngle, i);
             Vec4 col = Vec4_Get(&pool->GridPolygonColor, i);
             GetGridClass()->SetColor({ col.X,col.Y,col.Z,col.W });
             GetGridClass()->DrawGridPolygon(VecInt_Get(&pool->GridPolygonSides, i),
-                { pos.X,pos.Y,pos.Z }, { size.X,size.Y,size.Z }, { ang.X,ang.Y,ang.Z });
+                GetWorldMatrix(IndexType::GridPolygon, i), { size.X,size.Y,size.Z });
         }
     }
 
+    RenderStats_SetScope(RenderScope_Engine);
+
     if (!GetObjectClass())
     {
-        MessageBoxA(nullptr, "ObjectClassNULL", "Error", MB_OK);
+        System_MessageBox("ObjectClassNULL", "Error");
     }
 
-    //SpriteWorld
-    if (SceneRanges[CurrentSceneIndex].StartIndex_SpriteWorld >= 0 && SceneRanges[CurrentSceneIndex].EndIndex_SpriteWorld <= (int)pool->SpriteWorldPos.size)
+    Object* obj = GetObjectClass();
+
+    //SpriteWorld（値のコピーのみなので並列）
+    int swBegin = range.StartIndex_SpriteWorld, swEnd = range.EndIndex_SpriteWorld;
+    if (swBegin < 0 || swEnd > (int)pool->SpriteWorldPos.size) swBegin = swEnd = 0;
+    if (swEnd > obj->GetSize<SpriteWorld>()) swEnd = obj->GetSize<SpriteWorld>();
+    CullRange(IndexType::SpriteWorld, swBegin, swEnd);
+    Job_ParallelFor(swBegin, swEnd, 0, [&](int begin, int end)
     {
-        for (int i = SceneRanges[CurrentSceneIndex].StartIndex_SpriteWorld; i < SceneRanges[CurrentSceneIndex].EndIndex_SpriteWorld; i++)
+        for (int i = begin; i < end; i++)
         {
-            if (i < 0 || i >= (int)pool->SpriteWorldPos.size) continue;
-            Vec4 v4Pos = Vec4_Get(&pool->SpriteWorldPos, i);
+            SpriteWorld* sw = obj->GetComponent<SpriteWorld>(i);
+            if (!sw || !sw->Enabled) continue;  // 削除済みは同期しない
+            sw->Culled = !IsObjectVisible(IndexType::SpriteWorld, i);
+            if (sw->Culled) continue;           // 視錐台の外も同期しない（入ってきたフレームで同期する）
             Vec4 v4Size = Vec4_Get(&pool->SpriteWorldSize, i);
-            Vec4 v4Angle = Vec4_Get(&pool->SpriteWorldAngle, i);
             Vec4 v4Color = Vec4_Get(&pool->SpriteWorldColor, i);
 
-            
-            GetObjectClass()->GetComponent<SpriteWorld>(i)->SetColor({ v4Color.X, v4Color.Y, v4Color.Z, v4Color.W });
-            GetObjectClass()->GetComponent<SpriteWorld>(i)->SetPos(v4Pos.X, v4Pos.Y, v4Pos.Z);
-            GetObjectClass()->GetComponent<SpriteWorld>(i)->SetSize(v4Size.X, v4Size.Y);
-            GetObjectClass()->GetComponent<SpriteWorld>(i)->SetAngle(v4Angle.X, v4Angle.Y, v4Angle.Z);
+            sw->SetColor({ v4Color.X, v4Color.Y, v4Color.Z, v4Color.W });
+            sw->SetSize(v4Size.X, v4Size.Y);
+        }
+    });
+
+    //SpriteBox（SetSize で頂点バッファを作るためメインスレッド。サイズが同じなら何もしない）
+    int sbBegin = range.StartIndex_SpriteBox, sbEnd = range.EndIndex_SpriteBox;
+    if (sbBegin < 0 || sbEnd > (int)pool->SpriteBoxPos.size) sbBegin = sbEnd = 0;
+    if (sbEnd > obj->GetSize<SpriteBox>()) sbEnd = obj->GetSize<SpriteBox>();
+    CullRange(IndexType::SpriteBox, sbBegin, sbEnd);
+    for (int i = sbBegin; i < sbEnd; ++i)
+    {
+        SpriteBox* sb = obj->GetComponent<SpriteBox>(i);
+        if (!sb || !sb->Enabled) continue;
+        sb->Culled = !IsObjectVisible(IndexType::SpriteBox, i);
+        if (sb->Culled) continue;
+        Vec4 v4Size = Vec4_Get(&pool->SpriteBoxSize, i);
+        Vec4 v4Color = Vec4_Get(&pool->SpriteBoxColor, i);
+
+        sb->SetSize(v4Size.X, v4Size.Y, v4Size.Z);
+        sb->SetColor(v4Color.X, v4Color.Y, v4Color.Z, v4Color.W);
+    }
+    //SpriteCylinder（同上）
+    int scBegin = range.StartIndex_SpriteCylinder, scEnd = range.EndIndex_SpriteCylinder;
+    if (scBegin < 0 || scEnd > (int)pool->SpriteCylinderPos.size) scBegin = scEnd = 0;
+    if (scEnd > obj->GetSize<SpriteCylinder>()) scEnd = obj->GetSize<SpriteCylinder>();
+    CullRange(IndexType::SpriteCylinder, scBegin, scEnd);
+    for (int i = scBegin; i < scEnd; ++i)
+    {
+        SpriteCylinder* sc = obj->GetComponent<SpriteCylinder>(i);
+        if (!sc || !sc->Enabled) continue;
+        sc->Culled = !IsObjectVisible(IndexType::SpriteCylinder, i);
+        if (sc->Culled) continue;
+        Vec4 v4Size = Vec4_Get(&pool->SpriteCylinderSize, i);
+        Vec4 v4Color = Vec4_Get(&pool->SpriteCylinderColor, i);
+
+        sc->SetReel(GetReelSymbols(i), GetReelScroll(i));
+        sc->SetSize(v4Size.X, v4Size.Y, v4Size.Z);
+        sc->SetColor(v4Color.X, v4Color.Y, v4Color.Z, v4Color.W);
+    }
 
-            //カメラ行列を渡す
-            if (GetObjectClass()->GetComponent<Camera>(useCam)) {
-                GetObjectClass()->GetComponent<SpriteWorld>(i)->SetView(GetObjectClass()->GetComponent<Camera>(useCam)->GetView());
-                GetObjectClass()->GetComponent<SpriteWorld>(i)->SetProj(GetObjectClass()->GetComponent<Camera>(useCam)->GetProjection());
-            }
-            else
-            {
-                MessageBoxA(nullptr, "CameraNotFound", "SpriteWorld", MB_OK);
-            }
+    // MVP 行列をまとめて並列計算（Draw では計算済みの値を使う）
+    {
+        LIA_PROFILE_SCOPE("DrawScene::Matrix");
+        BatchMVP<SpriteWorld>(obj, IndexType::SpriteWorld, swBegin, swEnd, viewProj, camChanged);
+        BatchMVP<SpriteBox>(obj, IndexType::SpriteBox, sbBegin, sbEnd, viewProj, camChanged);
+        BatchMVP<SpriteCylinder>(obj, IndexType::SpriteCylinder, scBegin, scEnd, viewProj, camChanged);
+    }
 
-        }
+    //Model（モーションの切り替えはメインスレッド、姿勢とスキニングは並列）
+    int mdBegin = range.StartIndex_Model, mdEnd = range.EndIndex_Model;
+    if (mdBegin < 0 || mdEnd > (int)pool->ModelPos.size) mdBegin = mdEnd = 0;
+    if (mdEnd > obj->GetSize<Model>()) mdEnd = obj->GetSize<Model>();
+    CullRange(IndexType::Model, mdBegin, mdEnd);
+    for (int i = mdBegin; i < mdEnd; ++i)
+    {
+        Model* md = obj->GetComponent<Model>(i);
+        if (!md || !md->Enabled) continue;
+        md->Culled = !IsObjectVisible(IndexType::Model, i);
+        if (md->Culled) continue;           // 視錐台の外はモーションの切り替えもスキニングも入ってきたフレームで
+        Vec4 v4Size = Vec4_Get(&pool->ModelSize, i);
+        md->SetSize(v4Size.X, v4Size.Y, v4Size.Z);
+        md->SetWorld(GetWorldMatrix(IndexType::Model, i));
+        md->SetView(cam->GetView());
+        md->SetProj(cam->GetProjection());
+
+        const char* motion = KeyMap_GetKey(&pool->ModelMotionMap, i);
+        if (motion && *motion && !md->IsMotion(motion))
+            md->SetMotionBlend(motion, VecInt_Get(&pool->ModelMotionBlend, i));
     }
-    //SpriteBox
-    if (SceneRanges[CurrentSceneIndex].StartIndex_SpriteBox >= 0 &&
-        SceneRanges[CurrentSceneIndex].EndIndex_SpriteBox <= (int)pool->SpriteBoxPos.size)
     {
-        for (int i = SceneRanges[CurrentSceneIndex].StartIndex_SpriteBox;
-            i < SceneRanges[CurrentSceneIndex].EndIndex_SpriteBox; ++i)
+        LIA_PROFILE_SCOPE("DrawScene::Skinning");
+        Job_ParallelFor(mdBegin, mdEnd, 0, [&](int begin, int end)
         {
-            if (i < 0 || i >= (int)pool->SpriteBoxPos.size) continue;
-            Vec4 v4Pos = Vec4_Get(&pool->SpriteBoxPos, i);
-            Vec4 v4Size = Vec4_Get(&pool->SpriteBoxSize, i);
-            Vec4 v4Color = Vec4_Get(&pool->SpriteBoxColor, i);
-            Vec4 v4Angle = Vec4_Get(&pool->SpriteBoxAngle, i);
-
-            GetObjectClass()->GetComponent<SpriteBox>(i)->SetPos(v4Pos.X, v4Pos.Y, v4Pos.Z);
-            GetObjectClass()->GetComponent<SpriteBox>(i)->SetSize(v4Size.X, v4Size.Y, v4Size.Z);
-            GetObjectClass()->GetComponent<SpriteBox>(i)->SetAngle(v4Angle.X, v4Angle.Y, v4Angle.Z);
-            GetObjectClass()->GetComponent<SpriteBox>(i)->SetColor(v4Color.X, v4Color.Y, v4Color.Z, v4Color.W);
-
-            //カメラ行列を渡す
-            if (GetObjectClass()->GetComponent<Camera>(useCam)) {
-                GetObjectClass()->GetComponent<SpriteBox>(i)->SetView(GetObjectClass()->GetComponent<Camera>(useCam)->GetView());
-                GetObjectClass()->GetComponent<SpriteBox>(i)->SetProj(GetObjectClass()->GetComponent<Camera>(useCam)->GetProjection());
-            }
-            else
+            for (int i = begin; i < end; i++)
             {
-                MessageBoxA(nullptr, "CameraNotFound", "SpriteWorld", MB_OK);
+                Model* md = obj->GetComponent<Model>(i);
+                if (md && md->Enabled && !md->Culled) md->Skin();
             }
-        }
+        });
     }
-    //SpriteCylinder
-    if (SceneRanges[CurrentSceneIndex].StartIndex_SpriteCylinder >= 0 &&
-        SceneRanges[CurrentSceneIndex].EndIndex_SpriteCylinder <= (int)pool->SpriteCylinderPos.size)
+
+    //Effect（粒子は UpdateEffects で更新済み、ここではカメラだけ渡す）
+    int efBegin = range.StartIndex_Effect, efEnd = range.EndIndex_Effect;
+    if (efBegin < 0) efBegin = efEnd = 0;
+    if (efEnd > obj->GetSize<Effect>()) efEnd = obj->GetSize<Effect>();
+    for (int i = efBegin; i < efEnd; ++i)
     {
-        for (int i = SceneRanges[CurrentSceneIndex].StartIndex_SpriteCylinder;
-            i < SceneRanges[CurrentSceneIndex].EndIndex_SpriteCylinder; ++i)
-        {
-            if (i < 0 || i >= (int)pool->SpriteCylinderPos.size) continue;
-            Vec4 v4Pos = Vec4_Get(&pool->SpriteCylinderPos, i);
-            Vec4 v4Size = Vec4_Get(&pool->SpriteCylinderSize, i);
-            Vec4 v4Color = Vec4_Get(&pool->SpriteCylinderColor, i);
-            Vec4 v4Angle = Vec4_Get(&pool->SpriteCylinderAngle, i);
-
-            GetObjectClass()->GetComponent<SpriteCylinder>(i)->SetPos(v4Pos.X, v4Pos.Y, v4Pos.Z);
-            GetObjectClass()->GetComponent<SpriteCylinder>(i)->SetSize(v4Size.X, v4Size.Y, v4Size.Z);
-            GetObjectClass()->GetComponent<SpriteCylinder>(i)->SetAngle(v4Angle.X, v4Angle.Y, v4Angle.Z);
-            GetObjectClass()->GetComponent<SpriteCylinder>(i)->SetColor(v4Color.X, v4Color.Y, v4Color.Z, v4Color.W);
-
-            //カメラ行列を渡す
-            if (GetObjectClass()->GetComponent<Camera>(useCam)) {
-                GetObjectClass()->GetComponent<SpriteCylinder>(i)->SetView(GetObjectClass()->GetComponent<Camera>(useCam)->GetView());
-                GetObjectClass()->GetComponent<SpriteCylinder>(i)->SetProj(GetObjectClass()->GetComponent<Camera>(useCam)->GetProjection());
-            }
-            else
-            {
-                MessageBoxA(nullptr, "CameraNotFound", "SpriteWorld", MB_OK);
-            }
-        }
+        Effect* ef = obj->GetComponent<Effect>(i);
+        if (!ef || !ef->Enabled) continue;
+        ef->SetView(cam->GetView());
+        ef->SetProj(cam->GetProjection());
     }
-    //SpriteScreen
+
+    //SpriteScreen（画面外 / 手前の不透明 UI に隠れたものは描画しない）
     if (SceneRanges[CurrentSceneIndex].StartIndex_SpriteScreen >= 0 &&
         SceneRanges[CurrentSceneIndex].EndIndex_SpriteScreen <= (int)pool->SpriteScreenPos.size)
     {
+        CullScreenRange(SceneRanges[CurrentSceneIndex].StartIndex_SpriteScreen, SceneRanges[CurrentSceneIndex].EndIndex_SpriteScreen);
         for (int i = SceneRanges[CurrentSceneIndex].StartIndex_SpriteScreen;
             i < SceneRanges[CurrentSceneIndex].EndIndex_SpriteScreen; ++i)
         {
             if (i < 0 || i >= (int)pool->SpriteScreenPos.size) continue;
+            SpriteScreen* ss = obj->GetComponent<SpriteScreen>(i);
+            if (!ss || !ss->Enabled) continue;
+            ss->Culled = !IsScreenVisible(i);
+            if (ss->Culled) continue;
             Vec4 v4Pos = Vec4_Get(&pool->SpriteScreenPos, i);
             Vec4 v4Size = Vec4_Get(&pool->SpriteScreenSize, i);
             Vec4 v4Color = Vec4_Get(&pool->SpriteScreenColor, i);
             int vIAngle = VecInt_Get(&pool->SpriteScreenAngle, i);
 
-            GetObjectClass()->GetComponent<SpriteScreen>(i)->SetPos(v4Pos.X, v4Pos.Y);
-            GetObjectClass()->GetComponent<SpriteScreen>(i)->SetSize(v4Size.X, v4Size.Y);
-            GetObjectClass()->GetComponent<SpriteScreen>(i)->SetColor(v4Color.X, v4Color.Y, v4Color.Z, v4Color.W);
+            ss->SetPos(v4Pos.X, v4Pos.Y);
+            ss->SetSize(v4Size.X, v4Size.Y);
+            ss->SetColor(v4Color.X, v4Color.Y, v4Color.Z, v4Color.W);
         }
     }
 }
@@ -363,8 +731,86 @@ void ChangeScene(const char* name)
     if (index == -1) return;
 
     AddMessage(ConcatCStr("ChangeScene: ", name));
-    CurrentSceneIndex = index;
-    ActiveSceneIndex = index;
+    if (PendingSceneIndex == index) PendingSceneIndex = -1;
+    Scene_EnsureLoaded(index);      // 未読み込みならここで待つ（PreloadScene 済みなら待ちは短い）
+    Scene_Switch(index);
+}
+
+//-----------------------------------------
+// ストリーミング
+//-----------------------------------------
+void PreloadScene(const char* name)
+{
+    int index = KeyMap_GetIndex(&SceneMap, name);
+    if (index == -1) { AddMessage(ConcatCStr("PreloadScene failed: ", name)); return; }
+    Scene_BeginLoad(index);
+}
+
+void UnloadScene(const char* name)
+{
+    int index = KeyMap_GetIndex(&SceneMap, name);
+    if (index == -1) { AddMessage(ConcatCStr("UnloadScene failed: ", name)); return; }
+    if (index == CurrentSceneIndex) { AddMessage(ConcatCStr("UnloadScene: current scene cannot be unloaded: ", name)); return; }
+    Scene_Unload(index);
+}
+
+bool IsSceneLoaded(const char* name)
+{
+    int index = KeyMap_GetIndex(&SceneMap, name);
+    if (index == -1) return false;
+    return SceneRanges[index].LoadState == SceneLoad_Loaded;
+}
+
+void ChangeSceneWhenLoaded(const char* name)
+{
+    int index = KeyMap_GetIndex(&SceneMap, name);
+    if (index == -1) { AddMessage(ConcatCStr("ChangeSceneWhenLoaded failed: ", name)); return; }
+    Scene_BeginLoad(index);
+    PendingSceneIndex = index;      // 切り替えは UpdateScene で
+}
+
+static void Scene_AddAsset(int index, const char* path)
+{
+    std::vector<std::string>& list = SceneAssets[index];
+    for (const std::string& a : list)
+        if (a == path) return;
+    list.push_back(path);
+
+    // 読み込み済み / 読み込み中のシーンならその場で参照を持つ
+    if (SceneRanges[index].LoadState != SceneLoad_Unloaded)
+    {
+        Texture_AddRef(path);
+        if (SceneRanges[index].LoadState == SceneLoad_Loading && !Texture_IsResident(path))
+            AL_LoadFromPackageByNameAsync(path);
+    }
+}
+
+void AddSceneAsset(const char* scene, const char* path)
+{
+    int index = KeyMap_GetIndex(&SceneMap, scene);
+    if (index == -1 || !path) { AddMessage(ConcatCStr("AddSceneAsset failed: ", scene)); return; }
+    Scene_AddAsset(index, path);
+}
+
+void NotifySceneAsset(const char* path)
+{
+    if (!path || ActiveSceneIndex < 0 || ActiveSceneIndex >= (int)SceneRanges.size()) return;
+    Scene_AddAsset(ActiveSceneIndex, path);
+}
+
+// スロットを含むシーンのどれかが読み込み済みなら true（どのシーンにも属さないスロットも true）
+bool IsSceneSlotLoaded(IndexType type, int index)
+{
+    bool owned = false;
+    for (const SceneRange& r : SceneRanges)
+    {
+        int begin, end;
+        SceneSlotRange(r, type, &begin, &end);
+        if (index < begin || index >= end) continue;
+        if (r.LoadState == SceneLoad_Loaded) return true;
+        owned = true;
+    }
+    return !owned;
 }
 
 void NotifyAddObject(IndexType type)
@@ -372,6 +818,7 @@ void NotifyAddObject(IndexType type)
     if (ActiveSceneIndex < 0 || ActiveSceneIndex >= (int)SceneRanges.size()) return;
     SceneRange& range = SceneRanges[ActiveSceneIndex];
     ObjectIndex* idx = GetObjectIndex();
+    if (range.Reused & SceneTypeBit(type)) return;     // 引き継いだ範囲は末尾へ移るまで固定
 
     switch (type)
     {
@@ -381,6 +828,9 @@ void NotifyAddObject(IndexType type)
     case IndexType::GridPolygon:
         range.EndIndex_GridPolygon = idx->GridPolygonIndex;
         break;
+    case IndexType::BoxCollider:
+        range.EndIndex_BoxCollider = idx->BoxColliderIndex;
+        break;
     case IndexType::Camera:
         range.EndIndex_Camera = idx->CameraIndex;
         break;
@@ -390,11 +840,34 @@ void NotifyAddObject(IndexType type)
     }
 }
 
+// 追加先シーン（ActiveSceneIndex）での type の範囲。削除済みスロットの再利用先の判定に使う
+// |  確定前のシーンは末尾まで（これから追加される分も含む）。引き継いだ範囲は固定の End まで
+bool GetActiveSceneRange(IndexType type, int* begin, int* end)
+{
+    if (ActiveSceneIndex < 0 || ActiveSceneIndex >= (int)SceneRanges.size()) return false;
+    if (type == IndexType::Camera || type == IndexType::GridLine) return false;
+    const SceneRange& r = SceneRanges[ActiveSceneIndex];
+    SceneSlotRange(r, type, begin, end);
+    if (!r.Finalized && !(r.Reused & SceneTypeBit(type))) *end = INT_MAX;
+    return true;
+}
+
+// シーン name での type の範囲（作成中のシーンは現在の末尾まで）
+bool GetSceneRange(const char* name, IndexType type, int* begin, int* end)
+{
+    int index = name ? KeyMap_GetIndex(&SceneMap, name) : -1;
+    if (index < 0 || index >= (int)SceneRanges.size()) return false;
+    if (index == CurrentSceneIndex) RefreshSceneRange();
+    SceneSlotRange(SceneRanges[index], type, begin, end);
+    return true;
+}
+
 const char* GetCurrentSceneName()
 {
     if (CurrentSceneIndex < 0 || CurrentSceneIndex >= (int)SceneMap.size)
         return "None";
-    return KeyMap_GetKey(&SceneMap, CurrentSceneIndex);
+    const char* name = KeyMap_GetKey(&SceneMap, CurrentSceneIndex);
+    return name ? name : "None";
 }
 
 void SetSceneCamera(const char* s, const char* c)
@@ -409,4 +882,39 @@ void SetSceneCamera(const char* s, const char* c)
     SceneRanges[si].UseCameraIndex = ci;
     AddMessage(ConcatCStr("SetSceneCamera: scene=", s));
 }
-void DeleteScene(const char* name) { /*元処理保持用ダミー*/ }
+//-----------------------------------------
+// Scene削除
+// |  シーンのオブジェクトを全て削除（GPU リソース・名前も解放）し、範囲を空にする
+// |  Pool の行は詰めない（他シーンのインデックスを保つため）。空いた範囲は次の AddScene が引き継ぐ
+// |  Camera はシーン間で共有のため残す
+//-----------------------------------------
+void DeleteScene(const char* name)
+{
+    int index = KeyMap_GetIndex(&SceneMap, name);
+    if (index == -1) { AddMessage(ConcatCStr("DeleteScene failed: ", name)); return; }
+
+    SceneRange& r = SceneRanges[index];
+    if (!r.Finalized && index == CurrentSceneIndex) RefreshSceneRange();
+    Scene_Unload(index);            // テクスチャの参照を外す
+    SceneAssets[index].clear();
+
+    for (IndexType type : SceneRangeTypes) {
+        int *b, *e;
+        SceneSlotFields(r, type, &b, &e);
+        for (int i = *b; i < *e; ++i) RemoveObjectAt(type, i, true);
+        Scene_AddHole(type, *b, *e);
+        *e = *b;
+    }
+    r.Reused = 0;
+    r.EndIndex_Grid = r.StartIndex_Grid;
+    r.EndIndex_Camera = r.StartIndex_Camera;
+    r.UseCameraIndex = -1;
+    r.Finalized = true;
+    SyncObjectSceneList(index);     // Object 側は空のリストになる
+
+    KeyMap_Remove(&SceneMap, index);
+    if (ActiveSceneIndex == index) ActiveSceneIndex = -1;
+    if (CurrentSceneIndex == index) CurrentSceneIndex = -1;     // 描画対象なし（Object も空のリストのまま）
+
+    AddMessage(ConcatCStr("DeleteScene(): ", name));
+}
@@ -0,0 +1,289 @@
+﻿// ScreenGridManager.cpp
+// SpriteScreen の 2D 空間ハッシュ（一様グリッド）
+// |  800x600（SpriteScreen の正射影と同じ）を SCREEN_GRID_CELL px の升目に分け、升目ごとに重なる行の番号を持つ
+// |  Pos / Size が変わった行だけ入れ直す（ScreenGrid_MarkDirty → 次の UpdateScreenGrid）。升目の範囲が同じなら何もしない
+// |  点の問い合わせは升目1つ、矩形は重なる升目だけを見る（1升目あたりの行数が少なければ O(1)）
+// |  描画前の判定: 画面外 / 透明の行と、後ろに描かれる不透明な行（SetSpriteScreenOpaque）に覆われた行を省く
+// __________________________________________
+
+#include "Manager.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#define SCREEN_GRID_WIDTH 800
+#define SCREEN_GRID_HEIGHT 600
+#define SCREEN_GRID_CELL 64
+#define SCREEN_GRID_COLS ((SCREEN_GRID_WIDTH + SCREEN_GRID_CELL - 1) / SCREEN_GRID_CELL)
+#define SCREEN_GRID_ROWS ((SCREEN_GRID_HEIGHT + SCREEN_GRID_CELL - 1) / SCREEN_GRID_CELL)
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct ScreenGridItem {
+    short X0, Y0, X1, Y1;   // 入っている升目の範囲（X0 > X1: どこにも入っていない）
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static const ScreenGridItem ScreenGridNone = { 0, 0, -1, -1 };
+static std::vector<int> g_ScreenCells[SCREEN_GRID_COLS * SCREEN_GRID_ROWS];
+static std::vector<ScreenGridItem> g_ScreenItems;       // Pool のインデックスごと
+static std::vector<unsigned char> g_ScreenDirty;
+static std::vector<int> g_ScreenDirtyList;
+static std::vector<unsigned> g_ScreenStamp;             // 矩形の問い合わせで同じ行を2回返さないため
+static unsigned g_ScreenStampNow = 0;
+static std::vector<unsigned char> g_ScreenVisible;
+static int g_ScreenVisibleCount = 0;
+static int g_ScreenCulledCount = 0;
+
+//-----------------------------------------
+// 矩形と升目
+//-----------------------------------------
+// 行の矩形 [x0, x1) x [y0, y1)（Size が負でも左上 / 右下に直す）
+static void ScreenGrid_Rect(ObjectDataPool* p, int i, float& x0, float& y0, float& x1, float& y1)
+{
+    Vec4 pos = p->SpriteScreenPos.data[i];
+    Vec4 size = p->SpriteScreenSize.data[i];
+    x0 = std::min(pos.X, pos.X + size.X);
+    x1 = std::max(pos.X, pos.X + size.X);
+    y0 = std::min(pos.Y, pos.Y + size.Y);
+    y1 = std::max(pos.Y, pos.Y + size.Y);
+}
+
+// 矩形が重なる升目の範囲（画面外・面積 0・NaN はどこにも入れない）
+static ScreenGridItem ScreenGrid_Cells(float x0, float y0, float x1, float y1)
+{
+    if (!(x1 > x0 && y1 > y0 && x1 > 0.0f && y1 > 0.0f &&
+        x0 < (float)SCREEN_GRID_WIDTH && y0 < (float)SCREEN_GRID_HEIGHT)) return ScreenGridNone;
+    ScreenGridItem c;
+    c.X0 = (short)std::max(0, (int)(x0 / SCREEN_GRID_CELL));
+    c.Y0 = (short)std::max(0, (int)(y0 / SCREEN_GRID_CELL));
+    c.X1 = (short)std::min(SCREEN_GRID_COLS - 1, (int)std::ceil(x1 / SCREEN_GRID_CELL) - 1);
+    c.Y1 = (short)std::min(SCREEN_GRID_ROWS - 1, (int)std::ceil(y1 / SCREEN_GRID_CELL) - 1);
+    return c;
+}
+
+static void ScreenGrid_Unlink(int index, const ScreenGridItem& c)
+{
+    for (int y = c.Y0; y <= c.Y1; ++y)
+        for (int x = c.X0; x <= c.X1; ++x) {
+            std::vector<int>& cell = g_ScreenCells[y * SCREEN_GRID_COLS + x];
+            for (size_t k = 0; k < cell.size(); ++k)
+                if (cell[k] == index) { cell[k] = cell.back(); cell.pop_back(); break; }
+        }
+}
+
+static void ScreenGrid_Link(int index, const ScreenGridItem& c)
+{
+    for (int y = c.Y0; y <= c.Y1; ++y)
+        for (int x = c.X0; x <= c.X1; ++x)
+            g_ScreenCells[y * SCREEN_GRID_COLS + x].push_back(index);
+}
+
+// Pool に増えた行（Add / CopyObjectRange / AcquireObjectRows の末尾追加）を変更ありにする
+static void ScreenGrid_Sync()
+{
+    int n = (int)GetObjectDataPool()->SpriteScreenPos.size;
+    if (n < (int)g_ScreenItems.size()) ReleaseScreenGrid();    // Pool が作り直された
+    int old = (int)g_ScreenItems.size();
+    if (n == old) return;
+    g_ScreenItems.resize(n, ScreenGridNone);
+    g_ScreenDirty.resize(n, 1);
+    g_ScreenStamp.resize(n, 0);
+    for (int i = old; i < n; ++i) g_ScreenDirtyList.push_back(i);
+}
+
+// 問い合わせの対象（現在のシーンの範囲、シーンが無ければ全体）
+static void ScreenGrid_Range(int* begin, int* end)
+{
+    if (!GetSceneRange(GetCurrentSceneName(), IndexType::SpriteScreen, begin, end)) { *begin = 0; *end = INT_MAX; }
+}
+
+//-----------------------------------------
+// 更新
+//-----------------------------------------
+void ScreenGrid_MarkDirty(IndexType type, int index)
+{
+    if (type != IndexType::SpriteScreen) return;
+    if (index < 0 || index >= (int)g_ScreenItems.size()) return;    // 未登録なら ScreenGrid_Sync で入る
+    if (g_ScreenDirty[index]) return;
+    g_ScreenDirty[index] = 1;
+    g_ScreenDirtyList.push_back(index);
+}
+
+void UpdateScreenGrid()
+{
+    ScreenGrid_Sync();
+    if (g_ScreenDirtyList.empty()) return;
+    LIA_PROFILE_SCOPE("UpdateScreenGrid");
+
+    ObjectDataPool* p = GetObjectDataPool();
+    for (int i : g_ScreenDirtyList) {
+        g_ScreenDirty[i] = 0;
+        ScreenGridItem c = ScreenGridNone;
+        if (VecBool_Get(&p->SpriteScreenAlive, i)) {
+            float x0, y0, x1, y1;
+            ScreenGrid_Rect(p, i, x0, y0, x1, y1);
+            c = ScreenGrid_Cells(x0, y0, x1, y1);
+        }
+        ScreenGridItem& old = g_ScreenItems[i];
+        if (c.X0 == old.X0 && c.Y0 == old.Y0 && c.X1 == old.X1 && c.Y1 == old.Y1) continue;
+        ScreenGrid_Unlink(i, old);
+        ScreenGrid_Link(i, c);
+        old = c;
+    }
+    g_ScreenDirtyList.clear();
+}
+
+//-----------------------------------------
+// 問い合わせ
+//-----------------------------------------
+int QueryScreenPoint(float x, float y, std::vector<int>* out)
+{
+    if (!out) return 0;
+    UpdateScreenGrid();
+    if (!(x >= 0.0f && y >= 0.0f && x < (float)SCREEN_GRID_WIDTH && y < (float)SCREEN_GRID_HEIGHT)) return 0;
+
+    int begin, end;
+    ScreenGrid_Range(&begin, &end);
+    ObjectDataPool* p = GetObjectDataPool();
+    size_t first = out->size();
+    for (int i : g_ScreenCells[(int)(y / SCREEN_GRID_CELL) * SCREEN_GRID_COLS + (int)(x / SCREEN_GRID_CELL)]) {
+        if (i < begin || i >= end) continue;
+        float x0, y0, x1, y1;
+        ScreenGrid_Rect(p, i, x0, y0, x1, y1);
+        if (x >= x0 && x < x1 && y >= y0 && y < y1) out->push_back(i);
+    }
+    std::sort(out->begin() + first, out->end());
+    return (int)(out->size() - first);
+}
+
+int QueryScreenRect(float x0, float y0, float x1, float y1, std::vector<int>* out)
+{
+    if (!out) return 0;
+    UpdateScreenGrid();
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    ScreenGridItem c = ScreenGrid_Cells(x0, y0, x1, y1);
+    if (c.X0 > c.X1) return 0;
+
+    if (++g_ScreenStampNow == 0) {
+        std::fill(g_ScreenStamp.begin(), g_ScreenStamp.end(), 0u);
+        g_ScreenStampNow = 1;
+    }
+    int begin, end;
+    ScreenGrid_Range(&begin, &end);
+    ObjectDataPool* p = GetObjectDataPool();
+    size_t first = out->size();
+    for (int y = c.Y0; y <= c.Y1; ++y)
+        for (int x = c.X0; x <= c.X1; ++x)
+            for (int i : g_ScreenCells[y * SCREEN_GRID_COLS + x]) {
+                if (i < begin || i >= end || g_ScreenStamp[i] == g_ScreenStampNow) continue;
+                g_ScreenStamp[i] = g_ScreenStampNow;
+                float ax0, ay0, ax1, ay1;
+                ScreenGrid_Rect(p, i, ax0, ay0, ax1, ay1);
+                if (ax0 < x1 && ax1 > x0 && ay0 < y1 && ay1 > y0) out->push_back(i);
+            }
+    std::sort(out->begin() + first, out->end());
+    return (int)(out->size() - first);
+}
+
+int PickSpriteScreen(float x, float y)
+{
+    UpdateScreenGrid();
+    if (!(x >= 0.0f && y >= 0.0f && x < (float)SCREEN_GRID_WIDTH && y < (float)SCREEN_GRID_HEIGHT)) return -1;
+
+    int begin, end;
+    ScreenGrid_Range(&begin, &end);
+    ObjectDataPool* p = GetObjectDataPool();
+    int best = -1;
+    for (int i : g_ScreenCells[(int)(y / SCREEN_GRID_CELL) * SCREEN_GRID_COLS + (int)(x / SCREEN_GRID_CELL)]) {
+        if (i <= best || i < begin || i >= end) continue;
+        float x0, y0, x1, y1;
+        ScreenGrid_Rect(p, i, x0, y0, x1, y1);
+        if (x >= x0 && x < x1 && y >= y0 && y < y1) best = i;
+    }
+    return best;
+}
+
+//-----------------------------------------
+// 描画前の判定
+//-----------------------------------------
+// 行 i の画面内の部分が、後ろに描かれる不透明な行（[i + 1, end)）1つに覆われているか
+// |  覆う行は i の全ての升目に入っているので、i の左上の升目だけ見ればよい
+static bool ScreenGrid_Covered(ObjectDataPool* p, int i, int end)
+{
+    float x0, y0, x1, y1;
+    ScreenGrid_Rect(p, i, x0, y0, x1, y1);
+    x0 = std::max(x0, 0.0f);
+    y0 = std::max(y0, 0.0f);
+    x1 = std::min(x1, (float)SCREEN_GRID_WIDTH);
+    y1 = std::min(y1, (float)SCREEN_GRID_HEIGHT);
+
+    const ScreenGridItem& c = g_ScreenItems[i];
+    for (int j : g_ScreenCells[c.Y0 * SCREEN_GRID_COLS + c.X0]) {
+        if (j <= i || j >= end) continue;
+        if (!p->SpriteScreenOpaque.data[j] || p->SpriteScreenColor.data[j].W < 1.0f) continue;
+        float ox0, oy0, ox1, oy1;
+        ScreenGrid_Rect(p, j, ox0, oy0, ox1, oy1);
+        if (ox0 <= x0 && oy0 <= y0 && ox1 >= x1 && oy1 >= y1) return true;
+    }
+    return false;
+}
+
+int CullScreenRange(int begin, int end)
+{
+    LIA_PROFILE_SCOPE("CullScreenRange");
+    UpdateScreenGrid();
+    ObjectDataPool* p = GetObjectDataPool();
+    int n = (int)g_ScreenItems.size();
+    if ((int)g_ScreenVisible.size() < n) g_ScreenVisible.resize(n, 1);
+    if (begin < 0) begin = 0;
+    if (end > n) end = n;
+
+    bool cull = IsCullingEnabled();
+    int visible = 0, culled = 0;
+    for (int i = begin; i < end; ++i) {
+        if (!VecBool_Get(&p->SpriteScreenAlive, i)) { g_ScreenVisible[i] = 0; continue; }
+        const ScreenGridItem& c = g_ScreenItems[i];
+        bool show = !cull ||
+            (c.X0 <= c.X1 && p->SpriteScreenColor.data[i].W > 0.0f && !ScreenGrid_Covered(p, i, end));
+        g_ScreenVisible[i] = show ? 1 : 0;
+        if (show) visible++;
+        else culled++;
+    }
+    g_ScreenVisibleCount = visible;
+    g_ScreenCulledCount = culled;
+    return visible;
+}
+
+bool IsScreenVisible(int index)
+{
+    if (index < 0 || index >= (int)g_ScreenVisible.size()) return true;     // 未判定
+    return g_ScreenVisible[index] != 0;
+}
+
+void GetScreenCullStats(int* visible, int* culled)
+{
+    if (visible) *visible = g_ScreenVisibleCount;
+    if (culled) *culled = g_ScreenCulledCount;
+}
+
+//-----------------------------------------
+// 解放
+//-----------------------------------------
+void ReleaseScreenGrid()
+{
+    for (std::vector<int>& cell : g_ScreenCells) cell.clear();
+    g_ScreenItems.clear();
+    g_ScreenDirty.clear();
+    g_ScreenDirtyList.clear();
+    g_ScreenStamp.clear();
+    g_ScreenStampNow = 0;
+    g_ScreenVisible.clear();
+    g_ScreenVisibleCount = 0;
+    g_ScreenCulledCount = 0;
+}
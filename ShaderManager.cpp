@@ -10,17 +10,16 @@
 
 #include "Manager.h"
 
-#include <d3dcompiler.h>
 
-ID3DBlob* g_Default2DVSBlob = nullptr;
-ID3DBlob* g_Default2DPSBlob = nullptr;
-ID3DBlob* g_Default3DVSBlob = nullptr;
-ID3DBlob* g_Default3DPSBlob = nullptr;
+RenderBlob* g_Default2DVSBlob = nullptr;
+RenderBlob* g_Default2DPSBlob = nullptr;
+RenderBlob* g_Default3DVSBlob = nullptr;
+RenderBlob* g_Default3DPSBlob = nullptr;
 
-ID3D11VertexShader* g_Default2DVS = nullptr;
-ID3D11PixelShader*  g_Default2DPS = nullptr;
-ID3D11VertexShader* g_Default3DVS = nullptr;
-ID3D11PixelShader*  g_Default3DPS = nullptr;
+RenderVertexShader* g_Default2DVS = nullptr;
+RenderPixelShader*  g_Default2DPS = nullptr;
+RenderVertexShader* g_Default3DVS = nullptr;
+RenderPixelShader*  g_Default3DPS = nullptr;
 
 //L[}bv
 Char2Vector g_VSList;
@@ -36,17 +35,24 @@ static int g_Use3DPSIndex = 0;
 static int g_Use3DVSIndex = 0;
 static int g_Use3DGridVSIndex = 0;
 static int g_Use3DGridPSIndex = 0;
+static int g_UseModelVSIndex = 0;
+static int g_UseSkinVSIndex = 0;
+static int g_UseModelPSIndex = 0;
+static int g_UseReelVSIndex = 0;
+static int g_UseReelPSIndex = 0;
+static int g_UseEffectVSIndex = 0;
+static int g_UseEffectPSIndex = 0;
 
 //VF[_[ۑ
-static ID3D11VertexShader* g_VSObject[1024];
-static ID3D11PixelShader*  g_PSObject[1024];
+static RenderVertexShader* g_VSObject[1024];
+static RenderPixelShader*  g_PSObject[1024];
 
-static ID3D11VertexShader* g_VS2DShader;
-static ID3D11PixelShader*  g_PS2DShader;
-static ID3D11VertexShader* g_VS3DShader;
-static ID3D11PixelShader*  g_PS3DShader;
+static RenderVertexShader* g_VS2DShader;
+static RenderPixelShader*  g_PS2DShader;
+static RenderVertexShader* g_VS3DShader;
+static RenderPixelShader*  g_PS3DShader;
 
-static ID3DBlob* g_VSBlobObject[1024];
+static RenderBlob* g_VSBlobObject[1024];
 
 //ǉ
 void AddVertexShader(const char* shaderName, const char* shaderCode)
@@ -76,7 +82,8 @@ void ShaderManager_Init()
 //ǉ
 void ShaderManager_Update()
 {
-    ID3D11Device* dev = GetDevice();
+    LIA_PROFILE_SCOPE("ShaderManager_Update");
+    RenderDevice* dev = GetDevice();
     if (!dev) return;
 
     // ---- PS ----
@@ -84,17 +91,15 @@ void ShaderManager_Update()
     {
         Char2 d = Char2_Get(&g_PSList, g_ShaderPSOldIndex);
 
-        ID3DBlob* psBlob = nullptr;
-        ID3DBlob* err = nullptr;
+        RenderBlob* psBlob = nullptr;
+        RenderBlob* err = nullptr;
 
-        HRESULT hr = D3DCompile(
-            d.End, strlen(d.End),
-            NULL, NULL, NULL,
+        bool ok = dev->CompileShader(
+            d.End, strlen(d.End), d.First,
             "PSMain", "ps_5_0",
-            0, 0,
             &psBlob, &err);
 
-        if (FAILED(hr))
+        if (!ok)
         {
             AddMessage(ConcatCStr("PixelShader Compile Error: ", d.First));
             if (err) AddMessage((char*)err->GetBufferPointer());
@@ -104,7 +109,6 @@ void ShaderManager_Update()
             dev->CreatePixelShader(
                 psBlob->GetBufferPointer(),
                 psBlob->GetBufferSize(),
-                nullptr,
                 &g_PSObject[g_ShaderPSOldIndex]);
         }
 
@@ -119,17 +123,15 @@ void ShaderManager_Update()
     {
         Char2 d = Char2_Get(&g_VSList, g_ShaderVSOldIndex);
 
-        ID3DBlob* vsBlob = nullptr;
-        ID3DBlob* err = nullptr;
+        RenderBlob* vsBlob = nullptr;
+        RenderBlob* err = nullptr;
 
-        HRESULT hr = D3DCompile(
-            d.End, strlen(d.End),
-            NULL, NULL, NULL,
+        bool ok = dev->CompileShader(
+            d.End, strlen(d.End), d.First,
             "VSMain", "vs_5_0",
-            0, 0,
             &vsBlob, &err);
 
-        if (FAILED(hr))
+        if (!ok)
         {
             AddMessage(ConcatCStr("VertexShader Compile Error: ", d.First));
             if (err) AddMessage((char*)err->GetBufferPointer());
@@ -140,7 +142,6 @@ void ShaderManager_Update()
             dev->CreateVertexShader(
                 vsBlob->GetBufferPointer(),
                 vsBlob->GetBufferSize(),
-                nullptr,
                 &g_VSObject[g_ShaderVSOldIndex]);
 
             // Blob ۑiRelease Ȃj
@@ -203,42 +204,84 @@ int GetPixelShaderIndex(const char* shaderName)
 }
 
 
-ID3D11VertexShader* GetVertexShader2D()
+RenderVertexShader* GetVertexShader2D()
 {
     int index = g_Use2DVSIndex;
     if (index < 0 || index >= g_ShaderVSOldIndex) return nullptr;
     return g_VSObject[index];
 }
-ID3D11PixelShader* GetPixelShader2D()
+RenderPixelShader* GetPixelShader2D()
 {
     int index = g_Use2DPSIndex;
     if (index < 0 || index >= g_ShaderPSOldIndex) return nullptr;
     return g_PSObject[index];
 }
-ID3D11VertexShader* GetVertexShader3D()
+RenderVertexShader* GetVertexShader3D()
 {
     int index = g_Use3DVSIndex;
     if (index < 0 || index >= g_ShaderVSOldIndex) return nullptr;
     return g_VSObject[index];
 }
-ID3D11PixelShader* GetPixelShader3D()
+RenderPixelShader* GetPixelShader3D()
 {
     int index = g_Use3DPSIndex;
     if (index < 0 || index >= g_ShaderPSOldIndex) return nullptr;
     return g_PSObject[index];
 }
-ID3D11VertexShader* GetVertexShader3DGrid()
+RenderVertexShader* GetVertexShader3DGrid()
 {
     int index = g_Use3DGridVSIndex;
     if (index < 0 || index >= g_ShaderVSOldIndex) return nullptr;
     return g_VSObject[index];
 }
-ID3D11PixelShader* GetPixelShader3DGrid()
+RenderPixelShader* GetPixelShader3DGrid()
 {
     int index = g_Use3DGridPSIndex;
     if (index < 0 || index >= g_ShaderPSOldIndex) return nullptr;
     return g_PSObject[index];
 }
+RenderVertexShader* GetVertexShaderModel()
+{
+    int index = g_UseModelVSIndex;
+    if (index < 0 || index >= g_ShaderVSOldIndex) return nullptr;
+    return g_VSObject[index];
+}
+RenderVertexShader* GetVertexShaderSkin()
+{
+    int index = g_UseSkinVSIndex;
+    if (index < 0 || index >= g_ShaderVSOldIndex) return nullptr;
+    return g_VSObject[index];
+}
+RenderPixelShader* GetPixelShaderModel()
+{
+    int index = g_UseModelPSIndex;
+    if (index < 0 || index >= g_ShaderPSOldIndex) return nullptr;
+    return g_PSObject[index];
+}
+RenderVertexShader* GetVertexShaderReel()
+{
+    int index = g_UseReelVSIndex;
+    if (index < 0 || index >= g_ShaderVSOldIndex) return nullptr;
+    return g_VSObject[index];
+}
+RenderPixelShader* GetPixelShaderReel()
+{
+    int index = g_UseReelPSIndex;
+    if (index < 0 || index >= g_ShaderPSOldIndex) return nullptr;
+    return g_PSObject[index];
+}
+RenderVertexShader* GetVertexShaderEffect()
+{
+    int index = g_UseEffectVSIndex;
+    if (index < 0 || index >= g_ShaderVSOldIndex) return nullptr;
+    return g_VSObject[index];
+}
+RenderPixelShader* GetPixelShaderEffect()
+{
+    int index = g_UseEffectPSIndex;
+    if (index < 0 || index >= g_ShaderPSOldIndex) return nullptr;
+    return g_PSObject[index];
+}
 
 void InitShaderDefault()
 {
@@ -414,9 +457,239 @@ void InitShaderDefault()
 
     AddPixelShader("DefaultPixelShader3DGrid", PSDefaultGrid);
     g_Use3DGridPSIndex = 2;
+
+    // fiCPU XLjOς / ÓIbVj
+    const char* VSDefaultModel =
+        R"EOT(
+        cbuffer ConstantBuffer : register(b0)
+        {
+            matrix mvp;
+            matrix world;
+        };
+        
+        struct VS_INPUT
+        {
+            float3 pos : POSITION;
+            float2 uv : TEXCOORD0;
+            float3 nor : NORMAL;
+        };
+        
+        struct PS_INPUT
+        {
+            float4 pos : SV_POSITION;
+            float3 nor : NORMAL;
+        };
+        
+        PS_INPUT VSMain(VS_INPUT input)
+        {
+            PS_INPUT output;
+            output.pos = mul(float4(input.pos, 1.0f), mvp);
+            output.nor = mul(float4(input.nor, 0.0f), world).xyz;
+            return output;
+        }
+        )EOT";
+    AddVertexShader("DefaultVertexShaderModel", VSDefaultModel);
+    g_UseModelVSIndex = 3;
+
+    // fiGPU XLjOB{[ԍƏd݂͒_obt@ slot 1j
+    const char* VSDefaultSkin =
+        R"EOT(
+        cbuffer ConstantBuffer : register(b0)
+        {
+            matrix mvp;
+            matrix world;
+        };
+        cbuffer BoneBuffer : register(b2)
+        {
+            matrix bones[128];
+        };
+        
+        struct VS_INPUT
+        {
+            float3 pos : POSITION;
+            float2 uv : TEXCOORD0;
+            float3 nor : NORMAL;
+            uint4 bone : BLENDINDICES;
+            float4 weight : BLENDWEIGHT;
+        };
+        
+        struct PS_INPUT
+        {
+            float4 pos : SV_POSITION;
+            float3 nor : NORMAL;
+        };
+        
+        PS_INPUT VSMain(VS_INPUT input)
+        {
+            PS_INPUT output;
+            float sum = dot(input.weight, float4(1, 1, 1, 1));
+            float4 pos = float4(input.pos, 1.0f);
+            float3 nor = input.nor;
+            if (sum > 0.0f)
+            {
+                matrix m = bones[input.bone.x] * input.weight.x
+                         + bones[input.bone.y] * input.weight.y
+                         + bones[input.bone.z] * input.weight.z
+                         + bones[input.bone.w] * input.weight.w;
+                pos = mul(pos, m);
+                nor = mul(float4(nor, 0.0f), m).xyz;
+            }
+            output.pos = mul(pos, mvp);
+            output.nor = mul(float4(nor, 0.0f), world).xyz;
+            return output;
+        }
+        )EOT";
+    AddVertexShader("DefaultVertexShaderSkin", VSDefaultSkin);
+    g_UseSkinVSIndex = 4;
+
+    const char* PSDefaultModel =
+        R"EOT(
+        cbuffer ColorBuffer : register(b1)
+        {
+            float4 color;
+        }
+        
+        struct PS_INPUT
+        {
+            float4 pos : SV_POSITION;
+            float3 nor : NORMAL;
+        };
+        
+        float4 PSMain(PS_INPUT input) : SV_TARGET
+        {
+            // siŒj lambert + 
+            float3 light = normalize(float3(0.3f, 1.0f, -0.5f));
+            float d = saturate(dot(normalize(input.nor), light));
+            return float4(color.rgb * (0.35f + 0.65f * d), color.a);
+        }
+        )EOT";
+    AddPixelShader("DefaultPixelShaderModel", PSDefaultModel);
+    g_UseModelPSIndex = 3;
+
+    // [oNiSpriteCylinder ̃[[hBs / F / UV ̂炵ʂ̓CX^XƁj
+    const char* VSDefaultReel =
+        R"EOT(
+        cbuffer ReelBuffer : register(b0)
+        {
+            float4 scroll;      // x: 1  UV 炷iʁj/ 0i㉺ʁj
+        };
+        
+        struct VS_INPUT
+        {
+            float3 pos : POSITION;
+            float2 uv : TEXCOORD0;
+            float4 row0 : TEXCOORD1;    // ]uς mvp
+            float4 row1 : TEXCOORD2;
+            float4 row2 : TEXCOORD3;
+            float4 row3 : TEXCOORD4;
+            float4 color : COLOR0;
+            float4 uvOffset : TEXCOORD5;
+        };
+        
+        struct PS_INPUT
+        {
+            float4 pos : SV_POSITION;
+            float2 uv : TEXCOORD0;
+            float4 color : COLOR0;
+        };
+        
+        PS_INPUT VSMain(VS_INPUT input)
+        {
+            PS_INPUT output;
+            float4 p = float4(input.pos, 1.0f);
+            output.pos = float4(dot(p, input.row0), dot(p, input.row1), dot(p, input.row2), dot(p, input.row3));
+            output.uv = input.uv + input.uvOffset.xy * scroll.x;
+            output.color = input.color;
+            return output;
+        }
+        )EOT";
+    AddVertexShader("DefaultVertexShaderReel", VSDefaultReel);
+    g_UseReelVSIndex = 5;
+
+    const char* PSDefaultReel =
+        R"EOT(
+        Texture2D tex0 : register(t0);
+        SamplerState samp0 : register(s0);
+        
+        struct PS_INPUT
+        {
+            float4 pos : SV_POSITION;
+            float2 uv : TEXCOORD0;
+            float4 color : COLOR0;
+        };
+        
+        float4 PSMain(PS_INPUT input) : SV_TARGET
+        {
+            // DefaultPixelShader3D ƓiF̓CX^Xj
+            float4 texColor = tex0.Sample(samp0, input.uv);
+            if (texColor.a * input.color.a < 0.5f)
+                discard;
+            return texColor * input.color;
+        }
+        )EOT";
+    AddPixelShader("DefaultPixelShaderReel", PSDefaultReel);
+    g_UseReelPSIndex = 4;
+
+    // p[eBNiEffectBPʂ̎lp`CX^Ẍʒu / 傫ŃJɌčLj
+    const char* VSDefaultEffect =
+        R"EOT(
+        cbuffer EffectBuffer : register(b0)
+        {
+            matrix viewProj;    // ]uς
+            float4 right;       // J̉Ei[hj
+            float4 up;          // J̏i[hj
+        };
+        
+        struct VS_INPUT
+        {
+            float2 corner : POSITION;       // -0.5 .. 0.5
+            float4 posSize : TEXCOORD1;     // xyz: ʒu / w: 傫
+            float4 color : COLOR0;
+        };
+        
+        struct PS_INPUT
+        {
+            float4 pos : SV_POSITION;
+            float2 uv : TEXCOORD0;
+            float4 color : COLOR0;
+        };
+        
+        PS_INPUT VSMain(VS_INPUT input)
+        {
+            PS_INPUT output;
+            float3 world = input.posSize.xyz + (right.xyz * input.corner.x + up.xyz * input.corner.y) * input.posSize.w;
+            output.pos = mul(float4(world, 1.0f), viewProj);
+            output.uv = float2(input.corner.x + 0.5f, 0.5f - input.corner.y);
+            output.color = input.color;
+            return output;
+        }
+        )EOT";
+    AddVertexShader("DefaultVertexShaderEffect", VSDefaultEffect);
+    g_UseEffectVSIndex = 6;
+
+    const char* PSDefaultEffect =
+        R"EOT(
+        Texture2D tex0 : register(t0);
+        SamplerState samp0 : register(s0);
+        
+        struct PS_INPUT
+        {
+            float4 pos : SV_POSITION;
+            float2 uv : TEXCOORD0;
+            float4 color : COLOR0;
+        };
+        
+        float4 PSMain(PS_INPUT input) : SV_TARGET
+        {
+            // ̂܂܏d˂i[x͏Ȃj
+            return tex0.Sample(samp0, input.uv) * input.color;
+        }
+        )EOT";
+    AddPixelShader("DefaultPixelShaderEffect", PSDefaultEffect);
+    g_UseEffectPSIndex = 5;
 }
 
-ID3DBlob* GetCurrent2DVSBlob()
+RenderBlob* GetCurrent2DVSBlob()
 {
     int idx = g_Use2DVSIndex;
 
@@ -425,7 +698,7 @@ ID3DBlob* GetCurrent2DVSBlob()
 
     return g_VSBlobObject[idx];
 }
-ID3DBlob* GetCurrent3DVSBlob()
+RenderBlob* GetCurrent3DVSBlob()
 {
     int idx = g_Use3DVSIndex;
 
@@ -434,7 +707,7 @@ ID3DBlob* GetCurrent3DVSBlob()
 
     return g_VSBlobObject[idx];
 }
-ID3DBlob* GetCurrent3DGridVSBlob()
+RenderBlob* GetCurrent3DGridVSBlob()
 {
     int idx = g_Use3DGridVSIndex;
 
@@ -442,4 +715,39 @@ ID3DBlob* GetCurrent3DGridVSBlob()
         return nullptr;
 
     return g_VSBlobObject[idx];
-}
\ No newline at end of file
+}RenderBlob* GetCurrentModelVSBlob()
+{
+    int idx = g_UseModelVSIndex;
+
+    if (idx < 0 || idx >= g_ShaderVSOldIndex)
+        return nullptr;
+
+    return g_VSBlobObject[idx];
+}
+RenderBlob* GetCurrentSkinVSBlob()
+{
+    int idx = g_UseSkinVSIndex;
+
+    if (idx < 0 || idx >= g_ShaderVSOldIndex)
+        return nullptr;
+
+    return g_VSBlobObject[idx];
+}
+RenderBlob* GetCurrentReelVSBlob()
+{
+    int idx = g_UseReelVSIndex;
+
+    if (idx < 0 || idx >= g_ShaderVSOldIndex)
+        return nullptr;
+
+    return g_VSBlobObject[idx];
+}
+RenderBlob* GetCurrentEffectVSBlob()
+{
+    int idx = g_UseEffectVSIndex;
+
+    if (idx < 0 || idx >= g_ShaderVSOldIndex)
+        return nullptr;
+
+    return g_VSBlobObject[idx];
+}
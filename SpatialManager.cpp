@@ -0,0 +1,460 @@
+﻿// SpatialManager.cpp
+// 空間インデックス（動的 AABB ツリー）
+// |  CullingManager の境界（ワールド AABB）を葉に持つ2分木。葉の箱は少し大きめ（SPATIAL_MARGIN）に取る
+// |  UpdateSpatialIndex で、境界が作り直された行のうち大きめの箱からはみ出したものだけ入れ直す
+// |  挿入先は表面積の増え方が小さい方を選び、高さの差が2以上になったら回転して釣り合いを取る
+// |  問い合わせ: 視錐台 / レイ / 球 / AABB（ノードの箱で枝ごと飛ばす）
+// __________________________________________
+
+#include "Manager.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+using namespace DirectX;
+
+#define SPATIAL_TYPE_COUNT 6
+#define SPATIAL_MARGIN 0.25f
+#define SPATIAL_NULL -1
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct SpatialNode {
+    XMFLOAT3 Min, Max;      // 葉は大きめの箱
+    int Parent;             // 空きノードでは次の空き
+    int Child1, Child2;     // 葉は SPATIAL_NULL
+    int Height;             // 葉 0 / 空き -1
+    int Slot;               // 葉のみ: SpatialTypes の番号
+    int Index;              // 葉のみ: Pool のインデックス
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static const IndexType SpatialTypes[SPATIAL_TYPE_COUNT] = {
+    IndexType::SpriteWorld, IndexType::SpriteBox, IndexType::SpriteCylinder,
+    IndexType::GridBox, IndexType::GridPolygon, IndexType::Model,
+};
+static std::vector<SpatialNode> g_SpatialNodes;
+static int g_SpatialRoot = SPATIAL_NULL;
+static int g_SpatialFree = SPATIAL_NULL;
+static int g_SpatialLeafCount = 0;
+static std::vector<int> g_LeafOf[SPATIAL_TYPE_COUNT];       // Pool のインデックス → 葉（無ければ SPATIAL_NULL）
+static std::vector<int> g_SpatialStack;                     // 問い合わせ用
+
+//-----------------------------------------
+// 箱
+//-----------------------------------------
+static void Box_Union(const SpatialNode& a, const SpatialNode& b, XMFLOAT3& mn, XMFLOAT3& mx)
+{
+    mn = { std::min(a.Min.x, b.Min.x), std::min(a.Min.y, b.Min.y), std::min(a.Min.z, b.Min.z) };
+    mx = { std::max(a.Max.x, b.Max.x), std::max(a.Max.y, b.Max.y), std::max(a.Max.z, b.Max.z) };
+}
+
+static float Box_Area(const XMFLOAT3& mn, const XMFLOAT3& mx)
+{
+    float x = mx.x - mn.x, y = mx.y - mn.y, z = mx.z - mn.z;
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+static bool Box_Contains(const SpatialNode& n, const XMFLOAT3& mn, const XMFLOAT3& mx)
+{
+    return n.Min.x <= mn.x && n.Min.y <= mn.y && n.Min.z <= mn.z &&
+        mx.x <= n.Max.x && mx.y <= n.Max.y && mx.z <= n.Max.z;
+}
+
+static bool Box_Overlap(const SpatialNode& n, const Vec4& mn, const Vec4& mx)
+{
+    return n.Min.x <= mx.X && mn.X <= n.Max.x &&
+        n.Min.y <= mx.Y && mn.Y <= n.Max.y &&
+        n.Min.z <= mx.Z && mn.Z <= n.Max.z;
+}
+
+// 球と箱の最短距離の2乗
+static float Box_DistSq(const SpatialNode& n, const Vec4& c)
+{
+    float dx = std::max(std::max(n.Min.x - c.X, 0.0f), c.X - n.Max.x);
+    float dy = std::max(std::max(n.Min.y - c.Y, 0.0f), c.Y - n.Max.y);
+    float dz = std::max(std::max(n.Min.z - c.Z, 0.0f), c.Z - n.Max.z);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// スラブ法（当たらなければ false、t は入る位置）
+static bool Box_Ray(const SpatialNode& n, const float o[3], const float inv[3], float maxDist, float* t)
+{
+    const float mn[3] = { n.Min.x, n.Min.y, n.Min.z };
+    const float mx[3] = { n.Max.x, n.Max.y, n.Max.z };
+    float t0 = 0.0f, t1 = maxDist;
+    for (int a = 0; a < 3; ++a) {
+        float n0 = (mn[a] - o[a]) * inv[a];
+        float n1 = (mx[a] - o[a]) * inv[a];
+        if (n0 > n1) std::swap(n0, n1);
+        if (n0 > t0) t0 = n0;
+        if (n1 < t1) t1 = n1;
+        if (t0 > t1) return false;
+    }
+    *t = t0;
+    return true;
+}
+
+// 視錐台と箱（0: 外 / 1: 交差 / 2: 完全に内側）
+static int Box_Frustum(const SpatialNode& n, const XMFLOAT4 planes[6])
+{
+    float cx = (n.Min.x + n.Max.x) * 0.5f, cy = (n.Min.y + n.Max.y) * 0.5f, cz = (n.Min.z + n.Max.z) * 0.5f;
+    float ex = (n.Max.x - n.Min.x) * 0.5f, ey = (n.Max.y - n.Min.y) * 0.5f, ez = (n.Max.z - n.Min.z) * 0.5f;
+    int result = 2;
+    for (int k = 0; k < 6; ++k) {
+        const XMFLOAT4& p = planes[k];
+        float d = p.x * cx + p.y * cy + p.z * cz + p.w;
+        float r = fabsf(p.x) * ex + fabsf(p.y) * ey + fabsf(p.z) * ez;
+        if (d + r < 0.0f) return 0;
+        if (d - r < 0.0f) result = 1;
+    }
+    return result;
+}
+
+//-----------------------------------------
+// ノード
+//-----------------------------------------
+static int Spatial_Alloc()
+{
+    if (g_SpatialFree == SPATIAL_NULL) {
+        g_SpatialNodes.push_back(SpatialNode{});
+        g_SpatialNodes.back().Height = -1;
+        g_SpatialNodes.back().Parent = SPATIAL_NULL;
+        g_SpatialFree = (int)g_SpatialNodes.size() - 1;
+    }
+    int n = g_SpatialFree;
+    g_SpatialFree = g_SpatialNodes[n].Parent;
+    SpatialNode& node = g_SpatialNodes[n];
+    node.Parent = node.Child1 = node.Child2 = SPATIAL_NULL;
+    node.Height = 0;
+    node.Slot = -1;
+    node.Index = -1;
+    return n;
+}
+
+static void Spatial_Free(int n)
+{
+    g_SpatialNodes[n].Parent = g_SpatialFree;
+    g_SpatialNodes[n].Height = -1;
+    g_SpatialFree = n;
+}
+
+static void Spatial_Refit(int n)
+{
+    SpatialNode& node = g_SpatialNodes[n];
+    const SpatialNode& a = g_SpatialNodes[node.Child1];
+    const SpatialNode& b = g_SpatialNodes[node.Child2];
+    Box_Union(a, b, node.Min, node.Max);
+    node.Height = 1 + std::max(a.Height, b.Height);
+}
+
+static void Spatial_ReplaceChild(int parent, int oldChild, int newChild)
+{
+    if (parent == SPATIAL_NULL) { g_SpatialRoot = newChild; return; }
+    SpatialNode& p = g_SpatialNodes[parent];
+    if (p.Child1 == oldChild) p.Child1 = newChild;
+    else p.Child2 = newChild;
+}
+
+// a の子の高さの差が2以上なら高い方の子を持ち上げる（戻り値は a の位置に来たノード）
+static int Spatial_Balance(int a)
+{
+    std::vector<SpatialNode>& t = g_SpatialNodes;
+    if (t[a].Child1 == SPATIAL_NULL || t[a].Height < 2) return a;
+
+    int b = t[a].Child1, c = t[a].Child2;
+    int balance = t[c].Height - t[b].Height;
+    if (balance > 1 || balance < -1) {
+        // 高い方の子 up を a の位置へ持ち上げ、a は up の子になる
+        bool liftC = balance > 1;
+        int up = liftC ? c : b;
+        int f = t[up].Child1, g = t[up].Child2;
+
+        t[up].Child1 = a;
+        t[up].Parent = t[a].Parent;
+        t[a].Parent = up;
+        Spatial_ReplaceChild(t[up].Parent, a, up);
+
+        // 孫のうち高い方を up に残し、低い方を a へ
+        int high = (t[f].Height > t[g].Height) ? f : g;
+        int low = (high == f) ? g : f;
+        t[up].Child2 = high;
+        if (liftC) t[a].Child2 = low; else t[a].Child1 = low;
+        t[low].Parent = a;
+        Spatial_Refit(a);
+        Spatial_Refit(up);
+        return up;
+    }
+    return a;
+}
+
+static void Spatial_FixUpwards(int n)
+{
+    while (n != SPATIAL_NULL) {
+        n = Spatial_Balance(n);
+        Spatial_Refit(n);
+        n = g_SpatialNodes[n].Parent;
+    }
+}
+
+static void Spatial_InsertLeaf(int leaf)
+{
+    if (g_SpatialRoot == SPATIAL_NULL) {
+        g_SpatialRoot = leaf;
+        g_SpatialNodes[leaf].Parent = SPATIAL_NULL;
+        return;
+    }
+
+    // 表面積の増え方が最小になる兄弟を探す
+    const SpatialNode l = g_SpatialNodes[leaf];
+    int index = g_SpatialRoot;
+    while (g_SpatialNodes[index].Child1 != SPATIAL_NULL) {
+        const SpatialNode& node = g_SpatialNodes[index];
+        XMFLOAT3 mn, mx;
+        Box_Union(node, l, mn, mx);
+        float area = Box_Area(node.Min, node.Max);
+        float combined = Box_Area(mn, mx);
+        float cost = 2.0f * combined;                   // ここで新しい親を作る場合
+        float inherit = 2.0f * (combined - area);       // 下へ進む場合に祖先が増える分
+
+        float childCost[2];
+        int children[2] = { node.Child1, node.Child2 };
+        for (int k = 0; k < 2; ++k) {
+            const SpatialNode& ch = g_SpatialNodes[children[k]];
+            Box_Union(ch, l, mn, mx);
+            float grown = Box_Area(mn, mx);
+            childCost[k] = (ch.Child1 == SPATIAL_NULL ? grown : grown - Box_Area(ch.Min, ch.Max)) + inherit;
+        }
+        if (cost < childCost[0] && cost < childCost[1]) break;
+        index = (childCost[0] < childCost[1]) ? children[0] : children[1];
+    }
+
+    int sibling = index;
+    int oldParent = g_SpatialNodes[sibling].Parent;
+    int newParent = Spatial_Alloc();
+    g_SpatialNodes[newParent].Parent = oldParent;
+    g_SpatialNodes[newParent].Child1 = sibling;
+    g_SpatialNodes[newParent].Child2 = leaf;
+    g_SpatialNodes[sibling].Parent = newParent;
+    g_SpatialNodes[leaf].Parent = newParent;
+    Spatial_ReplaceChild(oldParent, sibling, newParent);
+    Spatial_FixUpwards(newParent);
+}
+
+static void Spatial_RemoveLeaf(int leaf)
+{
+    if (leaf == g_SpatialRoot) { g_SpatialRoot = SPATIAL_NULL; return; }
+    int parent = g_SpatialNodes[leaf].Parent;
+    int grand = g_SpatialNodes[parent].Parent;
+    int sibling = (g_SpatialNodes[parent].Child1 == leaf) ? g_SpatialNodes[parent].Child2 : g_SpatialNodes[parent].Child1;
+
+    Spatial_ReplaceChild(grand, parent, sibling);
+    g_SpatialNodes[sibling].Parent = grand;
+    Spatial_Free(parent);
+    if (grand != SPATIAL_NULL) Spatial_FixUpwards(grand);
+}
+
+// 境界（中心 + 半径）から大きめの箱を作る
+static void Spatial_FatBox(const Vec4& c, const Vec4& e, XMFLOAT3& mn, XMFLOAT3& mx, float margin)
+{
+    mn = { c.X - e.X - margin, c.Y - e.Y - margin, c.Z - e.Z - margin };
+    mx = { c.X + e.X + margin, c.Y + e.Y + margin, c.Z + e.Z + margin };
+}
+
+//-----------------------------------------
+// 更新（UpdateBounds の後に1回）
+//-----------------------------------------
+static BoolVector* Spatial_Alive(int slot)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    switch (SpatialTypes[slot])
+    {
+    case IndexType::SpriteWorld:    return &p->SpriteWorldAlive;
+    case IndexType::SpriteBox:      return &p->SpriteBoxAlive;
+    case IndexType::SpriteCylinder: return &p->SpriteCylinderAlive;
+    case IndexType::GridBox:        return &p->GridBoxAlive;
+    case IndexType::GridPolygon:    return &p->GridPolygonAlive;
+    case IndexType::Model:          return &p->ModelAlive;
+    default:                        return nullptr;
+    }
+}
+
+void UpdateSpatialIndex()
+{
+    LIA_PROFILE_SCOPE("UpdateSpatialIndex");
+    for (int s = 0; s < SPATIAL_TYPE_COUNT; ++s) {
+        IndexType type = SpatialTypes[s];
+        BoolVector* alive = Spatial_Alive(s);
+        std::vector<int>& leafOf = g_LeafOf[s];
+        if (leafOf.size() < alive->size) leafOf.resize(alive->size, SPATIAL_NULL);
+
+        for (int i = 0; i < (int)alive->size; ++i) {
+            int leaf = leafOf[i];
+            if (!alive->data[i]) {
+                // 削除済み
+                if (leaf != SPATIAL_NULL) {
+                    Spatial_RemoveLeaf(leaf);
+                    Spatial_Free(leaf);
+                    leafOf[i] = SPATIAL_NULL;
+                    g_SpatialLeafCount--;
+                }
+                continue;
+            }
+            if (leaf != SPATIAL_NULL && !IsBoundsUpdated(type, i)) continue;
+
+            Vec4 sphere, extent;
+            if (!GetObjectBounds(type, i, &sphere, &extent)) continue;     // UpdateBounds 前に増えた行
+            XMFLOAT3 mn, mx;
+            Spatial_FatBox(sphere, extent, mn, mx, 0.0f);
+            if (leaf != SPATIAL_NULL) {
+                if (Box_Contains(g_SpatialNodes[leaf], mn, mx)) continue;  // 大きめの箱の中なら木はそのまま
+                Spatial_RemoveLeaf(leaf);
+            }
+            else {
+                leaf = Spatial_Alloc();
+                g_SpatialNodes[leaf].Slot = s;
+                g_SpatialNodes[leaf].Index = i;
+                leafOf[i] = leaf;
+                g_SpatialLeafCount++;
+            }
+            Spatial_FatBox(sphere, extent, g_SpatialNodes[leaf].Min, g_SpatialNodes[leaf].Max, SPATIAL_MARGIN);
+            Spatial_InsertLeaf(leaf);
+        }
+    }
+}
+
+//-----------------------------------------
+// 問い合わせ
+// |  結果は out の末尾に追加（out は呼び出し側で clear）。戻り値は追加した数
+// |  葉の箱は大きめなので、正確な判定が要る場合は GetObjectBounds で絞り込む
+//-----------------------------------------
+static void Spatial_PushHit(std::vector<SpatialHit>* out, const SpatialNode& leaf, float distance)
+{
+    SpatialHit h;
+    h.Type = SpatialTypes[leaf.Slot];
+    h.Index = leaf.Index;
+    h.Distance = distance;
+    out->push_back(h);
+}
+
+// 部分木の葉を全て追加（完全に内側のとき）
+static void Spatial_PushSubtree(int n, std::vector<SpatialHit>* out)
+{
+    size_t base = g_SpatialStack.size();
+    g_SpatialStack.push_back(n);
+    while (g_SpatialStack.size() > base) {
+        int k = g_SpatialStack.back();
+        g_SpatialStack.pop_back();
+        const SpatialNode& node = g_SpatialNodes[k];
+        if (node.Child1 == SPATIAL_NULL) { Spatial_PushHit(out, node, 0.0f); continue; }
+        g_SpatialStack.push_back(node.Child1);
+        g_SpatialStack.push_back(node.Child2);
+    }
+}
+
+int QuerySpatialAABB(const Vec4& min, const Vec4& max, std::vector<SpatialHit>* out)
+{
+    if (!out || g_SpatialRoot == SPATIAL_NULL) return 0;
+    size_t first = out->size();
+    g_SpatialStack.clear();
+    g_SpatialStack.push_back(g_SpatialRoot);
+    while (!g_SpatialStack.empty()) {
+        int k = g_SpatialStack.back();
+        g_SpatialStack.pop_back();
+        const SpatialNode& node = g_SpatialNodes[k];
+        if (!Box_Overlap(node, min, max)) continue;
+        if (node.Child1 == SPATIAL_NULL) { Spatial_PushHit(out, node, 0.0f); continue; }
+        g_SpatialStack.push_back(node.Child1);
+        g_SpatialStack.push_back(node.Child2);
+    }
+    return (int)(out->size() - first);
+}
+
+int QuerySpatialSphere(const Vec4& sphere, std::vector<SpatialHit>* out)
+{
+    if (!out || g_SpatialRoot == SPATIAL_NULL) return 0;
+    size_t first = out->size();
+    float r2 = sphere.W * sphere.W;
+    g_SpatialStack.clear();
+    g_SpatialStack.push_back(g_SpatialRoot);
+    while (!g_SpatialStack.empty()) {
+        int k = g_SpatialStack.back();
+        g_SpatialStack.pop_back();
+        const SpatialNode& node = g_SpatialNodes[k];
+        float d2 = Box_DistSq(node, sphere);
+        if (d2 > r2) continue;
+        if (node.Child1 == SPATIAL_NULL) { Spatial_PushHit(out, node, sqrtf(d2)); continue; }
+        g_SpatialStack.push_back(node.Child1);
+        g_SpatialStack.push_back(node.Child2);
+    }
+    return (int)(out->size() - first);
+}
+
+int QuerySpatialFrustum(const XMMATRIX& viewProj, std::vector<SpatialHit>* out)
+{
+    if (!out || g_SpatialRoot == SPATIAL_NULL) return 0;
+    size_t first = out->size();
+    XMFLOAT4 planes[6];
+    GetFrustumPlanes(viewProj, planes);
+    g_SpatialStack.clear();
+    g_SpatialStack.push_back(g_SpatialRoot);
+    while (!g_SpatialStack.empty()) {
+        int k = g_SpatialStack.back();
+        g_SpatialStack.pop_back();
+        const SpatialNode& node = g_SpatialNodes[k];
+        int r = Box_Frustum(node, planes);
+        if (r == 0) continue;
+        if (r == 2) { Spatial_PushSubtree(k, out); continue; }   // 以下は全て内側
+        if (node.Child1 == SPATIAL_NULL) { Spatial_PushHit(out, node, 0.0f); continue; }
+        g_SpatialStack.push_back(node.Child1);
+        g_SpatialStack.push_back(node.Child2);
+    }
+    return (int)(out->size() - first);
+}
+
+// dir は正規化済み。Distance は葉の箱に入る距離（近い順に並べる）
+int QuerySpatialRay(const Vec4& origin, const Vec4& dir, float maxDist, std::vector<SpatialHit>* out)
+{
+    if (!out || g_SpatialRoot == SPATIAL_NULL) return 0;
+    size_t first = out->size();
+    const float o[3] = { origin.X, origin.Y, origin.Z };
+    const float d[3] = { dir.X, dir.Y, dir.Z };
+    float inv[3];
+    for (int a = 0; a < 3; ++a) inv[a] = (d[a] != 0.0f) ? 1.0f / d[a] : FLT_MAX;
+    g_SpatialStack.clear();
+    g_SpatialStack.push_back(g_SpatialRoot);
+    while (!g_SpatialStack.empty()) {
+        int k = g_SpatialStack.back();
+        g_SpatialStack.pop_back();
+        const SpatialNode& node = g_SpatialNodes[k];
+        float t;
+        if (!Box_Ray(node, o, inv, maxDist, &t)) continue;
+        if (node.Child1 == SPATIAL_NULL) { Spatial_PushHit(out, node, t); continue; }
+        g_SpatialStack.push_back(node.Child1);
+        g_SpatialStack.push_back(node.Child2);
+    }
+    std::sort(out->begin() + first, out->end(),
+        [](const SpatialHit& a, const SpatialHit& b) { return a.Distance < b.Distance; });
+    return (int)(out->size() - first);
+}
+
+//-----------------------------------------
+// 取得
+//-----------------------------------------
+int GetSpatialObjectCount() { return g_SpatialLeafCount; }
+int GetSpatialTreeHeight() { return g_SpatialRoot == SPATIAL_NULL ? 0 : g_SpatialNodes[g_SpatialRoot].Height; }
+
+void ReleaseSpatialIndex()
+{
+    g_SpatialNodes.clear();
+    g_SpatialNodes.shrink_to_fit();
+    g_SpatialRoot = SPATIAL_NULL;
+    g_SpatialFree = SPATIAL_NULL;
+    g_SpatialLeafCount = 0;
+    for (std::vector<int>& v : g_LeafOf) v.clear();
+    g_SpatialStack.clear();
+}
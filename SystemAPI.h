@@ -1,2 +1,196 @@
+﻿// SystemAPI.h
+// OS に依存する処理の窓口（Windows / それ以外）
+// |  時計 / スレッド ID / デバッグ出力 / エラー表示 / ファイル / アラインメント付き確保 / 文字列 / キー入力
+// |  エンジンのコードは Windows.h を直接使わずここを通す（Windows 以外でもヘッドレスのベンチが動く）
+// |  ウィンドウと D3D11 の初期化（Main.cpp）と各 API のバックエンド（WIC / XAudio2 / D3D11）は対象外
+// __________________________________________
+
 #pragma once
 
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <chrono>
+#include <cwchar>
+#include <strings.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------
+// 時計（高分解能のティック）
+//-----------------------------------------
+inline long long System_GetTicks()
+{
+#if defined(_WIN32)
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return t.QuadPart;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline long long System_GetTickFrequency()
+{
+#if defined(_WIN32)
+    LARGE_INTEGER f;
+    QueryPerformanceFrequency(&f);
+    return f.QuadPart;
+#else
+    return 1000000000LL;
+#endif
+}
+
+// 呼び出したスレッドの ID（表示用。Windows 以外は OS のスレッド ID）
+inline unsigned System_GetThreadId()
+{
+#if defined(_WIN32)
+    return (unsigned)GetCurrentThreadId();
+#else
+    return (unsigned)syscall(SYS_gettid);
+#endif
+}
+
+//-----------------------------------------
+// 出力
+//-----------------------------------------
+// デバッガの出力ウィンドウへ（Windows 以外は stderr）
+inline void System_DebugOutput(const char* text)
+{
+#if defined(_WIN32)
+    OutputDebugStringA(text);
+#else
+    fputs(text, stderr);
+#endif
+}
+
+// エラーの表示（Windows はダイアログで止まる。それ以外は stderr へ出して続行）
+inline void System_MessageBox(const char* text, const char* caption)
+{
+#if defined(_WIN32)
+    MessageBoxA(nullptr, text, caption, MB_OK);
+#else
+    fprintf(stderr, "[%s] %s\n", caption ? caption : "", text ? text : "");
+#endif
+}
+
+// 呼び出し元のコンソールへ stdout を繋ぐ（GUI アプリの exe から printf するため。それ以外は何もしない）
+inline void System_AttachConsole()
+{
+#if defined(_WIN32)
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        FILE* dummy = nullptr;
+        freopen_s(&dummy, "CONOUT$", "w", stdout);
+    }
+#endif
+}
+
+//-----------------------------------------
+// ファイル
+//-----------------------------------------
+inline FILE* System_FileOpen(const char* path, const char* mode)
+{
+    FILE* fp = nullptr;
+#if defined(_WIN32)
+    if (fopen_s(&fp, path, mode) != 0) return nullptr;
+#else
+    fp = fopen(path, mode);
+#endif
+    return fp;
+}
+
+//-----------------------------------------
+// メモリ
+//-----------------------------------------
+inline void* System_AlignedAlloc(size_t size, size_t align)
+{
+#if defined(_WIN32)
+    return _aligned_malloc(size, align);
+#else
+    // malloc の境界で足りるなら malloc（posix_memalign は確保が多いと遅い）
+    if (align <= alignof(std::max_align_t)) return malloc(size ? size : 1);
+    void* p = nullptr;
+    if (align < sizeof(void*)) align = sizeof(void*);
+    return posix_memalign(&p, align, size ? size : 1) == 0 ? p : nullptr;
+#endif
+}
+
+inline void System_AlignedFree(void* p)
+{
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+// 中身を移して確保し直す（oldSize: 元の確保サイズ。Windows は _aligned_realloc なので使わない）
+inline void* System_AlignedRealloc(void* p, size_t oldSize, size_t size, size_t align)
+{
+#if defined(_WIN32)
+    (void)oldSize;
+    return _aligned_realloc(p, size, align);
+#else
+    void* n = System_AlignedAlloc(size, align);
+    if (n && p) memcpy(n, p, oldSize < size ? oldSize : size);
+    if (n) free(p);
+    return n;
+#endif
+}
+
+//-----------------------------------------
+// 文字列
+//-----------------------------------------
+inline char* System_StrDup(const char* str)
+{
+#if defined(_WIN32)
+    return _strdup(str);
+#else
+    return strdup(str);
+#endif
+}
+
+// 大文字小文字を無視した比較（ASCII）
+inline int System_StrICmp(const char* a, const char* b)
+{
+#if defined(_WIN32)
+    return _stricmp(a, b);
+#else
+    return strcasecmp(a, b);
+#endif
+}
+
+// マルチバイト（Windows は ANSI コードページ、それ以外はロケール）→ ワイド文字。len は終端を含む長さ（0 は失敗）
+inline int System_MultiByteToWide(const char* str, wchar_t* out, int outLen)
+{
+#if defined(_WIN32)
+    return MultiByteToWideChar(CP_ACP, 0, str, -1, out, outLen);
+#else
+    size_t n = mbstowcs(out, str, out ? (size_t)outLen : 0);
+    return n == (size_t)-1 ? 0 : (int)n + 1;
+#endif
+}
+
+//-----------------------------------------
+// 入力
+//-----------------------------------------
+// key: 'A'..'Z' / '0'..'9' は文字コード、それ以外は SYSTEM_KEY_*（Windows の仮想キーコードと同じ値）
+#define SYSTEM_KEY_SPACE 0x20
+
+// 押されているか（ウィンドウの無い環境では常に false）
+inline bool System_IsKeyDown(int key)
+{
+#if defined(_WIN32)
+    return GetKeyState(key) < 0;
+#else
+    (void)key;
+    return false;
+#endif
+}
@@ -0,0 +1,354 @@
+﻿// TransformManager.cpp
+// 親子付けとワールド行列の一括計算
+// |  Pool の 3D オブジェクト（SpriteWorld / SpriteBox / SpriteCylinder / GridBox / GridPolygon / Model）に1つずつノードを持つ
+// |  親を持つオブジェクトの Pos / Angle は親からの相対値。Size は子へ伝えない（Sprite 系は頂点に焼き込み、Model は描画時に掛ける）
+// |  変更のあったノード（Set*Pos / Set*Angle / 追加 / 親の変更で印が付く）を一覧で持ち、その部分木だけを辿る
+// |  辿ったノードを深さ順に詰め、深さごとに Job_ParallelFor で world = local * 親の world を計算する
+// |  結果は Pool の *Matrix 列に書く（描画側は Pool から読むだけ）
+// |  1フレームのコストは変更のあった部分木の大きさに比例する（ノード全体は走査しない）
+// __________________________________________
+
+#include "Manager.h"
+#include "JobSystem.h"
+#include <vector>
+
+using namespace DirectX;
+
+#define TRANSFORM_TYPE_COUNT 6
+
+//-----------------------------------------
+// 構造体
+//-----------------------------------------
+struct TransformNodes {
+    std::vector<int> Parent;                // 親ノード（-1: なし）
+    std::vector<int> FirstChild;
+    std::vector<int> NextSibling;
+    std::vector<int> Depth;
+    std::vector<unsigned char> Dirty;       // 次の UpdateTransforms で計算し直す（g_DirtyList に載っている）
+    std::vector<unsigned char> Updated;     // 直前の UpdateTransforms で計算し直した
+    std::vector<unsigned char> Slot;        // TransformTypes の番号
+    std::vector<int> Index;                 // Pool のインデックス
+};
+
+//-----------------------------------------
+// グローバル
+//-----------------------------------------
+static const IndexType TransformTypes[TRANSFORM_TYPE_COUNT] = {
+    IndexType::SpriteWorld, IndexType::SpriteBox, IndexType::SpriteCylinder,
+    IndexType::GridBox, IndexType::GridPolygon, IndexType::Model,
+};
+static TransformNodes g_Nodes;
+static std::vector<int> g_NodeOf[TRANSFORM_TYPE_COUNT];     // Pool のインデックス → ノード
+static std::vector<int> g_DirtyList;                        // Dirty の付いたノード
+static std::vector<int> g_UpdatedList;                      // 直前の UpdateTransforms で計算し直したノード（深さ順）
+static std::vector<int> g_Visit;                            // 作業用：辿る途中のノード / 辿ったノード
+static std::vector<int> g_LevelBegin;                       // 深さ d は g_UpdatedList[g_LevelBegin[d], g_LevelBegin[d + 1])
+static int g_MaxDepth = 0;
+static bool g_OrderDirty = false;
+
+//-----------------------------------------
+// ノード
+//-----------------------------------------
+static void Transform_SetDirty(int n)
+{
+    if (g_Nodes.Dirty[n]) return;
+    g_Nodes.Dirty[n] = 1;
+    g_DirtyList.push_back(n);
+}
+
+static int Transform_Slot(IndexType type)
+{
+    for (int s = 0; s < TRANSFORM_TYPE_COUNT; ++s)
+        if (TransformTypes[s] == type) return s;
+    return -1;
+}
+
+static void Transform_Columns(int slot, Vec4Vector** pos, Vec4Vector** angle, MatrixVector** world = nullptr)
+{
+    ObjectDataPool* p = GetObjectDataPool();
+    MatrixVector* w = nullptr;
+    switch (TransformTypes[slot])
+    {
+    case IndexType::SpriteWorld:    *pos = &p->SpriteWorldPos;    *angle = &p->SpriteWorldAngle;    w = &p->SpriteWorldMatrix;    break;
+    case IndexType::SpriteBox:      *pos = &p->SpriteBoxPos;      *angle = &p->SpriteBoxAngle;      w = &p->SpriteBoxMatrix;      break;
+    case IndexType::SpriteCylinder: *pos = &p->SpriteCylinderPos; *angle = &p->SpriteCylinderAngle; w = &p->SpriteCylinderMatrix; break;
+    case IndexType::GridBox:        *pos = &p->GridBoxPos;        *angle = &p->GridBoxAngle;        w = &p->GridBoxMatrix;        break;
+    case IndexType::GridPolygon:    *pos = &p->GridPolygonPos;    *angle = &p->GridPolygonAngle;    w = &p->GridPolygonMatrix;    break;
+    case IndexType::Model:          *pos = &p->ModelPos;          *angle = &p->ModelAngle;          w = &p->ModelMatrix;          break;
+    default:                        *pos = nullptr;               *angle = nullptr;                 break;
+    }
+    if (world) *world = w;
+}
+
+// Pool の行数までノードを作る（新しいノードは親なし・要計算）
+static void Transform_Grow(int slot, int count)
+{
+    std::vector<int>& nodeOf = g_NodeOf[slot];
+    Vec4Vector *pos, *angle;
+    MatrixVector* world;
+    Transform_Columns(slot, &pos, &angle, &world);
+    if (world && (int)world->size < count) VecMat_Resize(world, count);
+    while ((int)nodeOf.size() < count) {
+        int n = (int)g_Nodes.Parent.size();
+        g_Nodes.Parent.push_back(-1);
+        g_Nodes.FirstChild.push_back(-1);
+        g_Nodes.NextSibling.push_back(-1);
+        g_Nodes.Depth.push_back(0);
+        g_Nodes.Dirty.push_back(0);
+        g_Nodes.Updated.push_back(0);
+        g_Nodes.Slot.push_back((unsigned char)slot);
+        g_Nodes.Index.push_back((int)nodeOf.size());
+        nodeOf.push_back(n);
+        Transform_SetDirty(n);
+        g_OrderDirty = true;
+    }
+}
+
+static void Transform_Sync()
+{
+    for (int s = 0; s < TRANSFORM_TYPE_COUNT; ++s) {
+        Vec4Vector *pos, *angle;
+        Transform_Columns(s, &pos, &angle);
+        if (pos && (int)pos->size > (int)g_NodeOf[s].size()) Transform_Grow(s, (int)pos->size);
+    }
+}
+
+// type / index のノード（無ければ作る。対象外の型や範囲外は -1）
+static int Transform_Node(IndexType type, int index)
+{
+    int slot = Transform_Slot(type);
+    if (slot < 0 || index < 0) return -1;
+    if (index >= (int)g_NodeOf[slot].size()) {
+        Vec4Vector *pos, *angle;
+        Transform_Columns(slot, &pos, &angle);
+        if (!pos || index >= (int)pos->size) return -1;
+        Transform_Grow(slot, (int)pos->size);
+    }
+    return g_NodeOf[slot][index];
+}
+
+// 親から外す（子はそのまま）
+static void Transform_Detach(int n)
+{
+    int p = g_Nodes.Parent[n];
+    if (p >= 0) {
+        int* link = &g_Nodes.FirstChild[p];
+        while (*link >= 0 && *link != n) link = &g_Nodes.NextSibling[*link];
+        if (*link == n) *link = g_Nodes.NextSibling[n];
+    }
+    g_Nodes.Parent[n] = -1;
+    g_Nodes.NextSibling[n] = -1;
+    Transform_SetDirty(n);
+    g_OrderDirty = true;
+}
+
+// 深さを求め直す（親子関係かノード数が変わったときだけ）
+static void Transform_RebuildDepth()
+{
+    int count = (int)g_Nodes.Parent.size();
+    std::vector<int>& depth = g_Nodes.Depth;
+    std::fill(depth.begin(), depth.end(), -1);
+
+    std::vector<int> chain;
+    int maxDepth = 0;
+    for (int n = 0; n < count; ++n) {
+        if (depth[n] >= 0) continue;
+        chain.clear();
+        int q = n;
+        while (q >= 0 && depth[q] < 0) { chain.push_back(q); q = g_Nodes.Parent[q]; }
+        int d = (q >= 0) ? depth[q] + 1 : 0;
+        for (size_t i = chain.size(); i-- > 0;) depth[chain[i]] = d++;
+        if (d - 1 > maxDepth) maxDepth = d - 1;
+    }
+    g_MaxDepth = maxDepth;
+    g_OrderDirty = false;
+}
+
+// 変更のあった部分木を辿り、深さ順に g_UpdatedList へ詰める
+// |  祖先にも Dirty があるノードは祖先の部分木に含まれるので根にしない
+static void Transform_CollectDirty()
+{
+    g_Visit.clear();
+    for (int r : g_DirtyList) {
+        bool covered = false;
+        for (int q = g_Nodes.Parent[r]; q >= 0 && !covered; q = g_Nodes.Parent[q])
+            covered = g_Nodes.Dirty[q] != 0;
+        if (covered) continue;
+
+        size_t top = g_Visit.size();
+        g_Visit.push_back(r);
+        for (size_t k = top; k < g_Visit.size(); ++k)
+            for (int ch = g_Nodes.FirstChild[g_Visit[k]]; ch >= 0; ch = g_Nodes.NextSibling[ch])
+                g_Visit.push_back(ch);
+    }
+
+    // 深さで数え分け
+    g_LevelBegin.assign(g_MaxDepth + 2, 0);
+    for (int n : g_Visit) g_LevelBegin[g_Nodes.Depth[n] + 1]++;
+    for (int d = 0; d <= g_MaxDepth; ++d) g_LevelBegin[d + 1] += g_LevelBegin[d];
+    g_UpdatedList.resize(g_Visit.size());
+    for (int n : g_Visit) g_UpdatedList[g_LevelBegin[g_Nodes.Depth[n]]++] = n;
+    for (int d = g_MaxDepth; d > 0; --d) g_LevelBegin[d] = g_LevelBegin[d - 1];
+    g_LevelBegin[0] = 0;
+}
+
+//-----------------------------------------
+// 親子付け
+//-----------------------------------------
+void SetParentAt(IndexType type, int index, IndexType parentType, int parentIndex)
+{
+    int c = Transform_Node(type, index);
+    if (c < 0) { AddMessage("SetParent: object has no transform"); return; }
+    int p = (parentIndex >= 0) ? Transform_Node(parentType, parentIndex) : -1;
+    if (parentIndex >= 0 && p < 0) { AddMessage("SetParent: parent has no transform"); return; }
+
+    // 自分の子孫を親にはできない
+    for (int q = p; q >= 0; q = g_Nodes.Parent[q]) {
+        if (q == c) { AddMessage("SetParent: cyclic parent"); return; }
+    }
+    Transform_Detach(c);
+    if (p >= 0) {
+        g_Nodes.Parent[c] = p;
+        g_Nodes.NextSibling[c] = g_Nodes.FirstChild[p];
+        g_Nodes.FirstChild[p] = c;
+    }
+}
+
+void SetParent(IndexType type, const char* name, IndexType parentType, const char* parentName)
+{
+    int index = GetObjectIndexByName(type, name);
+    if (index < 0) { AddMessage(ConcatCStr("SetParent: object not found ", name)); return; }
+    int parentIndex = -1;
+    if (parentName) {
+        parentIndex = GetObjectIndexByName(parentType, parentName);
+        if (parentIndex < 0) { AddMessage(ConcatCStr("SetParent: parent not found ", parentName)); return; }
+    }
+    SetParentAt(type, index, parentType, parentIndex);
+}
+
+void Transform_MarkDirty(IndexType type, int index)
+{
+    int slot = Transform_Slot(type);
+    if (slot < 0 || index < 0 || index >= (int)g_NodeOf[slot].size()) return;   // 未作成なら作成時に計算される
+    Transform_SetDirty(g_NodeOf[slot][index]);
+}
+
+// 行の移動時：ノードを入れ替えて親子関係ごと to の行へ移す（from には空のノードが残る）
+void Transform_OnMove(IndexType type, int from, int to)
+{
+    int a = Transform_Node(type, from);
+    int b = Transform_Node(type, to);
+    if (a < 0 || b < 0) return;
+    int slot = g_Nodes.Slot[a];
+    g_NodeOf[slot][from] = b;
+    g_NodeOf[slot][to] = a;
+    g_Nodes.Index[a] = to;
+    g_Nodes.Index[b] = from;
+    Transform_SetDirty(a);
+    Transform_SetDirty(b);
+}
+
+// 削除時：親から外し、子は親なしにする（子の Pos / Angle はそのままワールド値として扱われる）
+void Transform_OnRemove(IndexType type, int index)
+{
+    int slot = Transform_Slot(type);
+    if (slot < 0 || index < 0 || index >= (int)g_NodeOf[slot].size()) return;
+    int n = g_NodeOf[slot][index];
+    for (int ch = g_Nodes.FirstChild[n]; ch >= 0;) {
+        int next = g_Nodes.NextSibling[ch];
+        g_Nodes.Parent[ch] = -1;
+        g_Nodes.NextSibling[ch] = -1;
+        Transform_SetDirty(ch);
+        ch = next;
+    }
+    g_Nodes.FirstChild[n] = -1;
+    Transform_Detach(n);
+}
+
+//-----------------------------------------
+// 更新（DrawScene の最初に1回）
+//-----------------------------------------
+void UpdateTransforms()
+{
+    LIA_PROFILE_SCOPE("UpdateTransforms");
+    Transform_Sync();
+    if (g_OrderDirty) Transform_RebuildDepth();
+    for (int n : g_UpdatedList) g_Nodes.Updated[n] = 0;
+    g_UpdatedList.clear();
+    if (g_DirtyList.empty()) return;
+    Transform_CollectDirty();
+
+    Vec4Vector* pos[TRANSFORM_TYPE_COUNT];
+    Vec4Vector* angle[TRANSFORM_TYPE_COUNT];
+    XMMATRIX* world[TRANSFORM_TYPE_COUNT];
+    for (int s = 0; s < TRANSFORM_TYPE_COUNT; ++s) {
+        MatrixVector* w;
+        Transform_Columns(s, &pos[s], &angle[s], &w);
+        world[s] = w->data;
+    }
+
+    // 親は1つ前の深さで計算済みか、変更が無く前の値のまま
+    for (size_t d = 0; d + 1 < g_LevelBegin.size(); ++d) {
+        if (g_LevelBegin[d] == g_LevelBegin[d + 1]) continue;
+        Job_ParallelFor(g_LevelBegin[d], g_LevelBegin[d + 1], 0, [&](int begin, int end)
+        {
+            for (int k = begin; k < end; ++k) {
+                int n = g_UpdatedList[k];
+                int p = g_Nodes.Parent[n];
+                int s = g_Nodes.Slot[n], i = g_Nodes.Index[n];
+                const Vec4& t = pos[s]->data[i];
+                const Vec4& a = angle[s]->data[i];
+                XMMATRIX local = XMMatrixRotationRollPitchYaw(a.X, a.Y, a.Z);
+                local.r[3] = XMVectorSet(t.X, t.Y, t.Z, 1.0f);
+                world[s][i] = (p >= 0) ? XMMatrixMultiply(local, world[g_Nodes.Slot[p]][g_Nodes.Index[p]]) : local;
+                g_Nodes.Updated[n] = 1;
+            }
+        });
+    }
+    for (int n : g_DirtyList) g_Nodes.Dirty[n] = 0;
+    g_DirtyList.clear();
+}
+
+//-----------------------------------------
+// 取得
+//-----------------------------------------
+const XMMATRIX& GetWorldMatrix(IndexType type, int index)
+{
+    static const XMMATRIX identity = XMMatrixIdentity();
+    int slot = Transform_Slot(type);
+    if (slot < 0 || index < 0 || index >= (int)g_NodeOf[slot].size()) return identity;
+    Vec4Vector *pos, *angle;
+    MatrixVector* world;
+    Transform_Columns(slot, &pos, &angle, &world);
+    if ((size_t)index >= world->size) return identity;
+    return world->data[index];
+}
+
+bool IsTransformUpdated(IndexType type, int index)
+{
+    int slot = Transform_Slot(type);
+    if (slot < 0 || index < 0 || index >= (int)g_NodeOf[slot].size()) return false;
+    return g_Nodes.Updated[g_NodeOf[slot][index]] != 0;
+}
+
+int GetParentAt(IndexType type, int index, IndexType* parentType)
+{
+    int slot = Transform_Slot(type);
+    if (slot < 0 || index < 0 || index >= (int)g_NodeOf[slot].size()) return -1;
+    int p = g_Nodes.Parent[g_NodeOf[slot][index]];
+    if (p < 0) return -1;
+    if (parentType) *parentType = TransformTypes[g_Nodes.Slot[p]];
+    return g_Nodes.Index[p];
+}
+
+void ReleaseTransforms()
+{
+    g_Nodes = TransformNodes{};
+    for (std::vector<int>& v : g_NodeOf) v.clear();
+    g_DirtyList.clear();
+    g_UpdatedList.clear();
+    g_Visit.clear();
+    g_LevelBegin.clear();
+    g_MaxDepth = 0;
+    g_OrderDirty = false;
+}
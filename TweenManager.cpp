@@ -0,0 +1,469 @@
+﻿// TweenManager.cpp
+// Tween / タイムライン
+// |  対象は Pool の列（Pos / Angle / Size / Color）を型とインデックスで直接指す。コンポーネントは経由しない
+// |  状態は列ごとの配列（SoA）。空きスロットを再利用し、配列は増えるときだけ確保（Tween ごとの確保は無い）
+// |  UpdateTweens: 1. 進行中の Tween をまとめて評価（イージング → 補間。Job_ParallelFor で分割）
+// |               2. 並び順に Pool へ書き込み、Transform / ScreenGrid に変更を知らせる（同じ列への書き込みは後勝ち）
+// |               3. 終わった Tween を外し、溜めたイベントを呼ぶ（コールバック内で追加 / 停止してよい）
+// |  ハンドルは スロット番号 + 世代。停止済み / 再利用されたハンドルは無効
+// __________________________________________
+
+#include "Manager.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define TWEEN_SLOT_BITS 20
+#define TWEEN_SLOT_MASK ((1 << TWEEN_SLOT_BITS) - 1)
+#define TWEEN_GEN_MASK  0x3FF
+#define TWEEN_TYPE_MAX  16
+#define TWEEN_PROP_MAX  4
+#define TWEEN_GRAIN     2048
+
+// 評価結果
+enum TweenState
+{
+    TweenState_Wait,        //遅延中 / 前の Tween 待ち（書き込まない）
+    TweenState_Run,
+    TweenState_End,         //最後の値を書いて外す
+};
+
+// Tween 本体（スロットごと）
+static std::vector<unsigned char> g_TweenType, g_TweenProp, g_TweenEase, g_TweenPingPong, g_TweenCapture, g_TweenState, g_TweenLooped;
+static std::vector<int> g_TweenIndex, g_TweenLoop, g_TweenCycle, g_TweenAfter, g_TweenGen, g_TweenActivePos;
+static std::vector<unsigned> g_TweenStamp;
+static std::vector<float> g_TweenTime, g_TweenDelay, g_TweenDuration;
+static std::vector<Vec4> g_TweenFrom, g_TweenTo, g_TweenValue;
+static std::vector<TweenEventFn> g_TweenEvent;
+static std::vector<void*> g_TweenUser;
+
+static std::vector<int> g_TweenFree;        // 空きスロット
+static std::vector<int> g_TweenActive;      // 進行中のスロット（詰めて並べる）
+static std::vector<int> g_TweenFinished;    // 今回終わったスロット（作業用）
+
+typedef struct { int Tween; int Event; TweenEventFn Fn; void* User; } TweenFire;
+static std::vector<TweenFire> g_TweenFires;  // 今回のイベント（作業用）
+
+// 削除された行（次の UpdateTweens で、それより前に作られた Tween を止める）
+typedef struct { int Type; int Index; unsigned Stamp; } TweenRemoved;
+static std::vector<TweenRemoved> g_TweenRemoved;
+static unsigned g_TweenStampNow = 0;
+
+//-----------------------------------------
+// イージング（t: 0..1）
+//-----------------------------------------
+static float Tween_Ease(int ease, float t)
+{
+    switch (ease)
+    {
+    case TweenEase_InQuad:    return t * t;
+    case TweenEase_OutQuad:   return t * (2.0f - t);
+    case TweenEase_InOutQuad: return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+    case TweenEase_InCubic:   return t * t * t;
+    case TweenEase_OutCubic:  { float u = t - 1.0f; return u * u * u + 1.0f; }
+    case TweenEase_InOutCubic:
+        if (t < 0.5f) return 4.0f * t * t * t;
+        else { float u = 2.0f * t - 2.0f; return 0.5f * u * u * u + 1.0f; }
+    case TweenEase_InOutSine: return 0.5f - 0.5f * cosf(t * 3.14159265f);
+    case TweenEase_OutBack:
+    {
+        const float c1 = 1.70158f, c3 = c1 + 1.0f;
+        float u = t - 1.0f;
+        return 1.0f + c3 * u * u * u + c1 * u * u;
+    }
+    case TweenEase_OutBounce:
+    {
+        const float n = 7.5625f, d = 2.75f;
+        if (t < 1.0f / d) return n * t * t;
+        if (t < 2.0f / d) { t -= 1.5f / d;  return n * t * t + 0.75f; }
+        if (t < 2.5f / d) { t -= 2.25f / d; return n * t * t + 0.9375f; }
+        t -= 2.625f / d;
+        return n * t * t + 0.984375f;
+    }
+    default: return t;
+    }
+}
+
+//-----------------------------------------
+// 対象の列
+//-----------------------------------------
+static Vec4Vector* Tween_Column(ObjectDataPool* p, IndexType type, int prop)
+{
+    switch (type)
+    {
+    case IndexType::Camera:
+        return prop == TweenProp_Pos ? &p->CameraPos : nullptr;
+    case IndexType::SpriteWorld:
+        return prop == TweenProp_Pos ? &p->SpriteWorldPos : prop == TweenProp_Angle ? &p->SpriteWorldAngle
+            : prop == TweenProp_Size ? &p->SpriteWorldSize : &p->SpriteWorldColor;
+    case IndexType::SpriteScreen:
+        return prop == TweenProp_Pos ? &p->SpriteScreenPos : prop == TweenProp_Size ? &p->SpriteScreenSize
+            : prop == TweenProp_Color ? &p->SpriteScreenColor : nullptr;   // Angle は IntVector
+    case IndexType::SpriteBox:
+        return prop == TweenProp_Pos ? &p->SpriteBoxPos : prop == TweenProp_Angle ? &p->SpriteBoxAngle
+            : prop == TweenProp_Size ? &p->SpriteBoxSize : &p->SpriteBoxColor;
+    case IndexType::SpriteCylinder:
+        return prop == TweenProp_Pos ? &p->SpriteCylinderPos : prop == TweenProp_Angle ? &p->SpriteCylinderAngle
+            : prop == TweenProp_Size ? &p->SpriteCylinderSize : &p->SpriteCylinderColor;
+    case IndexType::Model:
+        return prop == TweenProp_Pos ? &p->ModelPos : prop == TweenProp_Angle ? &p->ModelAngle
+            : prop == TweenProp_Size ? &p->ModelSize : nullptr;
+    case IndexType::BoxCollider:
+        return prop == TweenProp_Pos ? &p->BoxColliderPos : prop == TweenProp_Angle ? &p->BoxColliderAngle
+            : prop == TweenProp_Size ? &p->BoxColliderSize : nullptr;
+    case IndexType::GridBox:
+        return prop == TweenProp_Pos ? &p->GridBoxPos : prop == TweenProp_Angle ? &p->GridBoxAngle
+            : prop == TweenProp_Size ? &p->GridBoxSize : &p->GridBoxColor;
+    case IndexType::GridPolygon:
+        return prop == TweenProp_Pos ? &p->GridPolygonPos : prop == TweenProp_Angle ? &p->GridPolygonAngle
+            : prop == TweenProp_Size ? &p->GridPolygonSize : &p->GridPolygonColor;
+    default:
+        return nullptr;
+    }
+}
+
+static int Tween_Handle(int slot) { return ((g_TweenGen[slot] & TWEEN_GEN_MASK) << TWEEN_SLOT_BITS) | slot; }
+
+// ハンドル → スロット（無効なら -1）
+static int Tween_Slot(int tween)
+{
+    if (tween < 0) return -1;
+    int slot = tween & TWEEN_SLOT_MASK;
+    if (slot >= (int)g_TweenGen.size() || g_TweenActivePos[slot] < 0) return -1;
+    if ((g_TweenGen[slot] & TWEEN_GEN_MASK) != ((tween >> TWEEN_SLOT_BITS) & TWEEN_GEN_MASK)) return -1;
+    return slot;
+}
+
+static void Tween_Grow(int count)
+{
+    g_TweenType.resize(count);     g_TweenProp.resize(count);     g_TweenEase.resize(count);
+    g_TweenPingPong.resize(count); g_TweenCapture.resize(count);  g_TweenState.resize(count);
+    g_TweenLooped.resize(count);
+    g_TweenIndex.resize(count);    g_TweenLoop.resize(count);     g_TweenCycle.resize(count);
+    g_TweenAfter.resize(count);    g_TweenGen.resize(count, 0);   g_TweenActivePos.resize(count, -1);
+    g_TweenStamp.resize(count);
+    g_TweenTime.resize(count);     g_TweenDelay.resize(count);    g_TweenDuration.resize(count);
+    g_TweenFrom.resize(count);     g_TweenTo.resize(count);       g_TweenValue.resize(count);
+    g_TweenEvent.resize(count);    g_TweenUser.resize(count);
+}
+
+static void Tween_Free(int slot)
+{
+    int pos = g_TweenActivePos[slot];
+    if (pos < 0) return;
+    int last = g_TweenActive.back();
+    g_TweenActive[pos] = last;
+    g_TweenActivePos[last] = pos;
+    g_TweenActive.pop_back();
+    g_TweenActivePos[slot] = -1;
+    g_TweenGen[slot]++;
+    g_TweenEvent[slot] = nullptr;
+    g_TweenFree.push_back(slot);
+}
+
+static int Tween_Add(IndexType type, int index, int prop, const Vec4& from, const Vec4& to, bool capture, float duration, int ease)
+{
+    if ((int)type < 0 || (int)type >= TWEEN_TYPE_MAX || prop < 0 || prop >= TWEEN_PROP_MAX) return -1;
+    Vec4Vector* col = Tween_Column(GetObjectDataPool(), type, prop);
+    if (!col || index < 0 || index >= (int)col->size || !IsObjectAlive(type, index)) {
+        AddMessage("AddTween: 対象の列がありません");
+        return -1;
+    }
+
+    int slot;
+    if (!g_TweenFree.empty()) { slot = g_TweenFree.back(); g_TweenFree.pop_back(); }
+    else {
+        slot = (int)g_TweenGen.size();
+        if (slot > TWEEN_SLOT_MASK) { AddMessage("AddTween: Tween が多すぎます"); return -1; }
+        Tween_Grow(slot + 1);
+    }
+
+    g_TweenType[slot] = (unsigned char)type;
+    g_TweenProp[slot] = (unsigned char)prop;
+    g_TweenEase[slot] = (unsigned char)ease;
+    g_TweenPingPong[slot] = 0;
+    g_TweenCapture[slot] = capture ? 1 : 0;
+    g_TweenState[slot] = TweenState_Wait;
+    g_TweenLooped[slot] = 0;
+    g_TweenIndex[slot] = index;
+    g_TweenLoop[slot] = 0;
+    g_TweenCycle[slot] = 0;
+    g_TweenAfter[slot] = -1;
+    g_TweenStamp[slot] = ++g_TweenStampNow;
+    g_TweenTime[slot] = 0.0f;
+    g_TweenDelay[slot] = 0.0f;
+    g_TweenDuration[slot] = duration > 0.0f ? duration : 0.0f;
+    g_TweenFrom[slot] = from;
+    g_TweenTo[slot] = to;
+    g_TweenValue[slot] = from;
+    g_TweenEvent[slot] = nullptr;
+    g_TweenUser[slot] = nullptr;
+
+    g_TweenActivePos[slot] = (int)g_TweenActive.size();
+    g_TweenActive.push_back(slot);
+    return Tween_Handle(slot);
+}
+
+static int Tween_IndexByName(IndexType type, const char* name)
+{
+    if (!name) return -1;
+    if (type == IndexType::Model) return KeyMap_GetIndex(&GetObjectDataPool()->ModelMap, name);
+    return GetObjectIndexByName(type, name);
+}
+
+//-----------------------------------------
+// 追加 / 設定
+//-----------------------------------------
+int AddTween(IndexType type, const char* name, int prop, Vec4 to, float duration, int ease)
+{
+    int index = Tween_IndexByName(type, name);
+    if (index < 0) { AddMessage(ConcatCStr("AddTween: 見つかりません ", name ? name : "")); return -1; }
+    return Tween_Add(type, index, prop, to, to, true, duration, ease);
+}
+
+int AddTweenBy(IndexType type, const char* name, int prop, Vec4 delta, float duration, int ease)
+{
+    int tween = AddTween(type, name, prop, delta, duration, ease);
+    int slot = Tween_Slot(tween);
+    if (slot >= 0) g_TweenCapture[slot] = 2;     // 開始時に to = from + delta
+    return tween;
+}
+
+int AddTweenAt(IndexType type, int index, int prop, Vec4 from, Vec4 to, float duration, int ease)
+{
+    return Tween_Add(type, index, prop, from, to, false, duration, ease);
+}
+
+void SetTweenDelay(int tween, float seconds)
+{
+    int slot = Tween_Slot(tween);
+    if (slot >= 0) g_TweenDelay[slot] = seconds > 0.0f ? seconds : 0.0f;
+}
+
+void SetTweenLoop(int tween, int count, bool pingPong)
+{
+    int slot = Tween_Slot(tween);
+    if (slot < 0) return;
+    g_TweenLoop[slot] = count;
+    g_TweenPingPong[slot] = pingPong ? 1 : 0;
+}
+
+void SetTweenAfter(int tween, int prev)
+{
+    int slot = Tween_Slot(tween);
+    if (slot < 0) return;
+    g_TweenAfter[slot] = Tween_Slot(prev) >= 0 ? prev : -1;
+}
+
+void SetTweenEvent(int tween, TweenEventFn fn, void* user)
+{
+    int slot = Tween_Slot(tween);
+    if (slot < 0) return;
+    g_TweenEvent[slot] = fn;
+    g_TweenUser[slot] = user;
+}
+
+void StopTween(int tween)
+{
+    int slot = Tween_Slot(tween);
+    if (slot >= 0) Tween_Free(slot);
+}
+
+void StopTweens(IndexType type, const char* name)
+{
+    int index = Tween_IndexByName(type, name);
+    if (index < 0) return;
+    for (size_t i = g_TweenActive.size(); i-- > 0;) {
+        int slot = g_TweenActive[i];
+        if (g_TweenType[slot] == (unsigned char)type && g_TweenIndex[slot] == index) StopTween(Tween_Handle(slot));
+    }
+}
+
+bool IsTweenActive(int tween)
+{
+    return Tween_Slot(tween) >= 0;
+}
+
+int GetTweenCount()
+{
+    return (int)g_TweenActive.size();
+}
+
+void ReserveTweens(int count)
+{
+    if (count <= (int)g_TweenGen.size()) return;
+    int old = (int)g_TweenGen.size();
+    Tween_Grow(count);
+    g_TweenFree.reserve(count);
+    for (int s = count; s-- > old;) g_TweenFree.push_back(s);
+    g_TweenActive.reserve(count);
+    g_TweenFinished.reserve(count);
+}
+
+void Tween_OnMove(IndexType type, int from, int to)
+{
+    for (int slot : g_TweenActive)
+        if (g_TweenType[slot] == (int)type && g_TweenIndex[slot] == from) g_TweenIndex[slot] = to;
+}
+
+void Tween_OnRemove(IndexType type, int index)
+{
+    if (g_TweenActive.empty()) return;
+    g_TweenRemoved.push_back({ (int)type, index, g_TweenStampNow });
+}
+
+//-----------------------------------------
+// 更新
+//-----------------------------------------
+// 削除された行を指していた Tween を外す（行が再利用されていても、削除より後に作られた Tween は残す）
+static void Tween_ApplyRemoved()
+{
+    if (g_TweenRemoved.empty()) return;
+    std::sort(g_TweenRemoved.begin(), g_TweenRemoved.end(), [](const TweenRemoved& a, const TweenRemoved& b) {
+        return a.Type != b.Type ? a.Type < b.Type : a.Index < b.Index;
+    });
+    for (size_t i = g_TweenActive.size(); i-- > 0;) {
+        int slot = g_TweenActive[i];
+        TweenRemoved key = { g_TweenType[slot], g_TweenIndex[slot], 0 };
+        auto it = std::lower_bound(g_TweenRemoved.begin(), g_TweenRemoved.end(), key, [](const TweenRemoved& a, const TweenRemoved& b) {
+            return a.Type != b.Type ? a.Type < b.Type : a.Index < b.Index;
+        });
+        for (; it != g_TweenRemoved.end() && it->Type == key.Type && it->Index == key.Index; ++it) {
+            if (g_TweenStamp[slot] <= it->Stamp) { Tween_Free(slot); break; }
+        }
+    }
+    g_TweenRemoved.clear();
+}
+
+// [b, e) の進行中 Tween を評価（読むのは Pool と自分のスロットだけ。並列に呼んでよい）
+static void Tween_Evaluate(int b, int e, float dt, Vec4Vector* (*cols)[TWEEN_PROP_MAX])
+{
+    for (int i = b; i < e; ++i) {
+        int s = g_TweenActive[i];
+        g_TweenLooped[s] = 0;
+        float duration = g_TweenDuration[s];
+
+        if (g_TweenAfter[s] >= 0) {
+            if (IsTweenActive(g_TweenAfter[s])) { g_TweenState[s] = TweenState_Wait; continue; }
+            g_TweenAfter[s] = -1;   // 前の Tween が終わったフレームから進める
+        }
+
+        float time = g_TweenTime[s] + dt;
+        g_TweenTime[s] = time;
+        if (time < g_TweenDelay[s]) { g_TweenState[s] = TweenState_Wait; continue; }
+
+        if (g_TweenCapture[s]) {
+            // 始まった時点の値から
+            const Vec4& cur = cols[g_TweenType[s]][g_TweenProp[s]]->data[g_TweenIndex[s]];
+            if (g_TweenCapture[s] == 2) {
+                const Vec4& d = g_TweenTo[s];
+                g_TweenTo[s] = { cur.X + d.X, cur.Y + d.Y, cur.Z + d.Z, cur.W + d.W };
+            }
+            g_TweenFrom[s] = cur;
+            g_TweenCapture[s] = 0;
+        }
+
+        float local = time - g_TweenDelay[s];
+        int loop = g_TweenLoop[s];
+        int cycle;
+        float t;
+        unsigned char state = TweenState_Run;
+        if (duration <= 0.0f) { cycle = loop < 0 ? 0 : loop; t = 1.0f; state = loop < 0 ? TweenState_Run : TweenState_End; }
+        else {
+            float c = floorf(local / duration);
+            cycle = c > 2.0e9f ? 2000000000 : (int)c;
+            t = (local - c * duration) / duration;
+            if (loop >= 0 && cycle > loop) { cycle = loop; t = 1.0f; state = TweenState_End; }
+        }
+        if (cycle > g_TweenCycle[s]) { g_TweenCycle[s] = cycle; g_TweenLooped[s] = 1; }
+        if (g_TweenPingPong[s] && (cycle & 1)) t = 1.0f - t;
+
+        float k = Tween_Ease(g_TweenEase[s], t);
+        const Vec4& f = g_TweenFrom[s];
+        const Vec4& to = g_TweenTo[s];
+        g_TweenValue[s] = { f.X + (to.X - f.X) * k, f.Y + (to.Y - f.Y) * k, f.Z + (to.Z - f.Z) * k, f.W + (to.W - f.W) * k };
+        g_TweenState[s] = state;
+    }
+}
+
+void UpdateTweens(float dt)
+{
+    LIA_PROFILE_SCOPE("UpdateTweens");
+    Tween_ApplyRemoved();
+    int n = (int)g_TweenActive.size();
+    if (n == 0) return;
+
+    // (型, 項目) → 列。評価中に Pool の配列は増えないので先に引いておく
+    ObjectDataPool* pool = GetObjectDataPool();
+    Vec4Vector* cols[TWEEN_TYPE_MAX][TWEEN_PROP_MAX];
+    for (int t = 0; t < TWEEN_TYPE_MAX; ++t)
+        for (int p = 0; p < TWEEN_PROP_MAX; ++p) cols[t][p] = Tween_Column(pool, (IndexType)t, p);
+
+    Job_ParallelFor(0, n, TWEEN_GRAIN, [&](int b, int e) { Tween_Evaluate(b, e, dt, cols); });
+
+    // 書き込み（並び順）
+    g_TweenFinished.clear();
+    g_TweenFires.clear();
+    for (int i = 0; i < n; ++i) {
+        int s = g_TweenActive[i];
+        IndexType type = (IndexType)g_TweenType[s];
+        int index = g_TweenIndex[s];
+        if (g_TweenState[s] == TweenState_Wait) continue;
+        Vec4Vector* col = cols[(int)type][g_TweenProp[s]];
+        if (index >= (int)col->size || !IsObjectAlive(type, index)) { g_TweenFinished.push_back(s); continue; }
+
+        col->data[index] = g_TweenValue[s];
+        int prop = g_TweenProp[s];
+        if (prop == TweenProp_Pos || prop == TweenProp_Angle) Transform_MarkDirty(type, index);
+        if (prop == TweenProp_Pos || prop == TweenProp_Size) ScreenGrid_MarkDirty(type, index);
+
+        if (g_TweenEvent[s]) {
+            if (g_TweenLooped[s] && g_TweenState[s] != TweenState_End)
+                g_TweenFires.push_back({ Tween_Handle(s), TweenEvent_Loop, g_TweenEvent[s], g_TweenUser[s] });
+            if (g_TweenState[s] == TweenState_End)
+                g_TweenFires.push_back({ Tween_Handle(s), TweenEvent_Complete, g_TweenEvent[s], g_TweenUser[s] });
+        }
+        if (g_TweenState[s] == TweenState_End) g_TweenFinished.push_back(s);
+    }
+
+    for (int s : g_TweenFinished) Tween_Free(s);
+
+    // イベント（ハンドルは Complete の時点で無効。中で AddTween / StopTween してよい）
+    for (size_t i = 0; i < g_TweenFires.size(); ++i) {
+        TweenFire f = g_TweenFires[i];
+        f.Fn(f.Tween, f.Event, f.User);
+    }
+}
+
+void ReleaseTweens()
+{
+    g_TweenType.clear();     g_TweenType.shrink_to_fit();
+    g_TweenProp.clear();     g_TweenProp.shrink_to_fit();
+    g_TweenEase.clear();     g_TweenEase.shrink_to_fit();
+    g_TweenPingPong.clear(); g_TweenPingPong.shrink_to_fit();
+    g_TweenCapture.clear();  g_TweenCapture.shrink_to_fit();
+    g_TweenState.clear();    g_TweenState.shrink_to_fit();
+    g_TweenLooped.clear();   g_TweenLooped.shrink_to_fit();
+    g_TweenIndex.clear();    g_TweenIndex.shrink_to_fit();
+    g_TweenLoop.clear();     g_TweenLoop.shrink_to_fit();
+    g_TweenCycle.clear();    g_TweenCycle.shrink_to_fit();
+    g_TweenAfter.clear();    g_TweenAfter.shrink_to_fit();
+    g_TweenGen.clear();      g_TweenGen.shrink_to_fit();
+    g_TweenActivePos.clear(); g_TweenActivePos.shrink_to_fit();
+    g_TweenStamp.clear();    g_TweenStamp.shrink_to_fit();
+    g_TweenTime.clear();     g_TweenTime.shrink_to_fit();
+    g_TweenDelay.clear();    g_TweenDelay.shrink_to_fit();
+    g_TweenDuration.clear(); g_TweenDuration.shrink_to_fit();
+    g_TweenFrom.clear();     g_TweenFrom.shrink_to_fit();
+    g_TweenTo.clear();       g_TweenTo.shrink_to_fit();
+    g_TweenValue.clear();    g_TweenValue.shrink_to_fit();
+    g_TweenEvent.clear();    g_TweenEvent.shrink_to_fit();
+    g_TweenUser.clear();     g_TweenUser.shrink_to_fit();
+    g_TweenFree.clear();     g_TweenFree.shrink_to_fit();
+    g_TweenActive.clear();   g_TweenActive.shrink_to_fit();
+    g_TweenFinished.clear(); g_TweenFinished.shrink_to_fit();
+    g_TweenFires.clear();    g_TweenFires.shrink_to_fit();
+    g_TweenRemoved.clear();  g_TweenRemoved.shrink_to_fit();
+    g_TweenStampNow = 0;
+}
@@ -1,19 +1,113 @@
 #include "Manager.h"
-#include <Windows.h>
 #include <string>
 #include <vector>
 #include <cstdio>
+#include <cstdarg>
+#include <cassert>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <new>
 
 #define MAX_MESSAGE 256
 static const char* MessageList[MAX_MESSAGE] = { nullptr };
 
+//===============================
+// q[vmۂ̌v
+// |  operator new ƁÃt@C C ziVec* / KeyMap / AddMessagej̊mۂ𐔂
+// |  BenchRunner t[Ƃ̍iԂ̃t[ 0 ڕWj
+// |  vpȂ̂ LIA_PROFILE `̂݁B` operator new uAHeapCount_Add ͋iManager.hj
+//===============================
+#if defined(LIA_PROFILE)
+static std::atomic<unsigned long long> g_HeapAllocCount{ 0 };
+
+void HeapCount_Add()
+{
+    g_HeapAllocCount.fetch_add(1, std::memory_order_relaxed);
+}
+unsigned long long GetHeapAllocCount()
+{
+    return g_HeapAllocCount.load(std::memory_order_relaxed);
+}
+#else
+unsigned long long GetHeapAllocCount() { return 0; }
+#endif
+
+static void* Util_Malloc(size_t size)
+{
+    HeapCount_Add();
+    return malloc(size);
+}
+static void* Util_Realloc(void* p, size_t size)
+{
+    HeapCount_Add();
+    return realloc(p, size);
+}
+static char* Util_StrDup(const char* str)
+{
+    HeapCount_Add();
+    return System_StrDup(str);
+}
+
+#if defined(LIA_PROFILE)
+// uiʏ / z / sized / nothrow / aligned ̑SĂ̌`BW̎ĂԐɗȂj
+static void* Heap_New(size_t size)
+{
+    HeapCount_Add();
+    return malloc(size ? size : 1);
+}
+static void* Heap_NewAligned(size_t size, std::align_val_t align)
+{
+    HeapCount_Add();
+    return System_AlignedAlloc(size ? size : 1, (size_t)align);
+}
+
+void* operator new(size_t size)
+{
+    if (void* p = Heap_New(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size)
+{
+    if (void* p = Heap_New(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return Heap_New(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Heap_New(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+
+void* operator new(size_t size, std::align_val_t align)
+{
+    if (void* p = Heap_NewAligned(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t align)
+{
+    if (void* p = Heap_NewAligned(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return Heap_NewAligned(size, align); }
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return Heap_NewAligned(size, align); }
+void operator delete(void* p, std::align_val_t) noexcept { System_AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { System_AlignedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { System_AlignedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { System_AlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { System_AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { System_AlignedFree(p); }
+#endif
+
 //===============================
 // bZ[W
 //===============================
 void AddMessage(const char* sent) {
     for (int i = 0; i < MAX_MESSAGE; i++) {
         if (MessageList[i] == nullptr) {
-            MessageList[i] = _strdup(sent);
+            MessageList[i] = Util_StrDup(sent);
             break;
         }
     }
@@ -22,27 +116,171 @@ std::wstring ConvertToWString(const char* str)
 {
     if (!str) return L"";
 
-    int len = MultiByteToWideChar(CP_ACP, 0, str, -1, nullptr, 0); // CP_ACP = ANSI (ˑ)
+    int len = System_MultiByteToWide(str, nullptr, 0); // Windows  CP_ACP = ANSI (ˑ)
     if (len == 0) return L"";
 
     std::wstring wstr(len - 1, L'\0'); // I[kĊm
-    MultiByteToWideChar(CP_ACP, 0, str, -1, &wstr[0], len);
+    System_MultiByteToWide(str, &wstr[0], len);
     return wstr;
 }
+// ʂ̓t[A[ii FrameArena_Reset ܂ŗLBȂĂ悢j
 const char* ConcatCStr(const char* str1, const char* str2) {
     if (!str1 && !str2) return nullptr;
     if (!str1) return str2;
     if (!str2) return str1;
     size_t len1 = strlen(str1);
     size_t len2 = strlen(str2);
-    char* result = (char*)malloc(len1 + len2 + 1);
-    strcpy_s(result, len1 + 1, str1);
-    strcat_s(result, len1 + len2 + 1, str2);
+    char* result = (char*)FrameAlloc(len1 + len2 + 1, 1);
+    memcpy(result, str1, len1);
+    memcpy(result + len1, str2, len2 + 1);
     return result;
 }
 
-void ConcatCStrFree(const char* str) {
-    free((void*)str);
+// ݊piConcatCStr ̓t[A[îŉȂj
+void ConcatCStrFree(const char*) {
+}
+
+//===============================
+// t[A[i
+// |  1t[gꎞ̈B擪l߂ĎAFrameArena_Reset őS܂Ƃ߂Ď̂Ă
+// |  ̂̓bNȂiatomic ̉Ẑ݁jBȂ΃q[vioverflowjA Reset Ŗ{̂L
+// |  Ԃł͖{̂ő̂Ńq[vmۂ͋NȂ
+//===============================
+#define FRAME_ARENA_INITIAL (1 << 20)   // ŏ̗eʁi1 MBj
+#define FRAME_ARENA_ALIGN 16
+
+static char* g_FrameArena = nullptr;
+static size_t g_FrameArenaCapacity = 0;
+static std::atomic<size_t> g_FrameArenaOffset{ 0 };
+static size_t g_FrameArenaPeak = 0;
+static std::mutex g_FrameOverflowMutex;
+static std::vector<void*> g_FrameOverflow;         // {̂ɓȂiReset ŉj
+static size_t g_FrameOverflowBytes = 0;
+static int g_FrameOverflowCount = 0;                // ݌viL񐔂̖ڈj
+
+void* FrameAlloc(size_t size, size_t align)
+{
+    // 傫 16 oCgPʂɐ؂グA擪͏ 16 oCgE
+    // 16 𒴂 aligni2 ̗ݏj͍̕]ɎA̒ŋEւ炷
+    assert((align & (align - 1)) == 0 && "FrameAlloc: align must be a power of two");
+    if (align < FRAME_ARENA_ALIGN) align = FRAME_ARENA_ALIGN;
+    size_t need = (size + FRAME_ARENA_ALIGN - 1) & ~(size_t)(FRAME_ARENA_ALIGN - 1);
+    if (need == 0) need = FRAME_ARENA_ALIGN;
+    size_t take = need + (align - FRAME_ARENA_ALIGN);
+
+    size_t offset = g_FrameArenaOffset.fetch_add(take, std::memory_order_relaxed);
+    if (g_FrameArena && offset + take <= g_FrameArenaCapacity) {
+        uintptr_t p = (uintptr_t)(g_FrameArena + offset);
+        return (void*)((p + align - 1) & ~(uintptr_t)(align - 1));
+    }
+
+    std::lock_guard<std::mutex> lock(g_FrameOverflowMutex);
+    void* p = System_AlignedAlloc(need, align);
+    HeapCount_Add();
+    if (!p) return nullptr;
+    g_FrameOverflow.push_back(p);
+    g_FrameOverflowBytes += take;
+    g_FrameOverflowCount++;
+    return p;
+}
+
+char* FrameFormat(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(nullptr, 0, format, args);
+    va_end(args);
+    if (len < 0) return nullptr;
+    char* str = (char*)FrameAlloc((size_t)len + 1, 1);
+    if (!str) return nullptr;
+    va_start(args, format);
+    vsnprintf(str, (size_t)len + 1, format, args);
+    va_end(args);
+    return str;
+}
+
+void FrameArena_Reset()
+{
+    size_t used = g_FrameArenaOffset.load(std::memory_order_relaxed);
+    if (used > g_FrameArenaCapacity) used = g_FrameArenaCapacity;
+    used += g_FrameOverflowBytes;
+    if (used > g_FrameArenaPeak) g_FrameArenaPeak = used;
+
+    // ꂽi܂͖mہjȂÃt[̎gpʂ 2 {܂Ŗ{̂L
+    if (!g_FrameArena || g_FrameOverflowBytes > 0) {
+        size_t capacity = g_FrameArenaCapacity ? g_FrameArenaCapacity : FRAME_ARENA_INITIAL;
+        while (capacity < used * 2) capacity *= 2;
+        if (capacity != g_FrameArenaCapacity || !g_FrameArena) {
+            System_AlignedFree(g_FrameArena);
+            g_FrameArena = (char*)System_AlignedAlloc(capacity, FRAME_ARENA_ALIGN);
+            HeapCount_Add();
+            g_FrameArenaCapacity = g_FrameArena ? capacity : 0;
+        }
+    }
+    for (void* p : g_FrameOverflow) System_AlignedFree(p);
+    g_FrameOverflow.clear();
+    g_FrameOverflowBytes = 0;
+    g_FrameArenaOffset.store(0, std::memory_order_relaxed);
+}
+
+void GetFrameArenaStats(size_t* peak, size_t* capacity, int* overflows)
+{
+    if (peak) *peak = g_FrameArenaPeak;
+    if (capacity) *capacity = g_FrameArenaCapacity;
+    if (overflows) *overflows = g_FrameOverflowCount;
+}
+
+void ReleaseFrameArena()
+{
+    FrameArena_Reset();
+    System_AlignedFree(g_FrameArena);
+    g_FrameArena = nullptr;
+    g_FrameArenaCapacity = 0;
+    g_FrameArenaPeak = 0;
+    g_FrameOverflowCount = 0;
+    std::vector<void*>().swap(g_FrameOverflow);
+}
+
+//===============================
+// ͈͂̕ / ꊇǉiʁj
+// |  g [begin, end) 𖖔֕Bmۂ1ARs[ memcpy
+//===============================
+template<class V>
+static bool Vec_Reserve(V* vec, size_t count, const char* api)
+{
+    if (vec->size + count <= vec->capacity) return true;
+    size_t new_capacity = (vec->capacity == 0) ? 4 : vec->capacity;
+    while (new_capacity < vec->size + count) new_capacity *= 2;
+    auto* new_data = (decltype(vec->data))Util_Realloc(vec->data, new_capacity * sizeof(*vec->data));
+    if (!new_data) {
+        AddMessage(ConcatCStr(api, "/̊mۂɎs\n"));
+        return false;
+    }
+    vec->data = new_data;
+    vec->capacity = new_capacity;
+    return true;
+}
+template<class V>
+static bool Vec_AppendRange(V* vec, size_t begin, size_t end, const char* api)
+{
+    if (begin > end || end > vec->size) {
+        AddMessage(ConcatCStr(api, "/CfbNX͈͊O\n"));
+        return false;
+    }
+    size_t count = end - begin;
+    if (!Vec_Reserve(vec, count, api)) return false;
+    if (count) memcpy(vec->data + vec->size, vec->data + begin, count * sizeof(*vec->data));
+    vec->size += count;
+    return true;
+}
+// l count ֒ǉiPrefab ̈ꊇǉpj
+template<class V, class T>
+static bool Vec_AppendFill(V* vec, size_t count, T value, const char* api)
+{
+    if (!Vec_Reserve(vec, count, api)) return false;
+    for (size_t i = 0; i < count; i++) vec->data[vec->size + i] = value;
+    vec->size += count;
+    return true;
 }
 
 //===============================
@@ -57,7 +295,7 @@ void Vec4_Init(Vec4Vector* vec) {
 void Vec4_PushBack(Vec4Vector* vec, Vec4 value) {
     if (vec->size >= vec->capacity) {
         size_t new_capacity = (vec->capacity == 0) ? 4 : vec->capacity * 2;
-        Vec4* new_data = (Vec4*)realloc(vec->data, new_capacity * sizeof(Vec4));
+        Vec4* new_data = (Vec4*)Util_Realloc(vec->data, new_capacity * sizeof(Vec4));
         if (!new_data) {
             AddMessage("\nerror : vector_push_back/̊mۂɎs\n");
             return;
@@ -84,6 +322,14 @@ Vec4 Vec4_Get(Vec4Vector* vec, size_t index) {
     }
     return vec->data[index];
 }
+//͈͂𖖔֕
+void Vec4_AppendRange(Vec4Vector* vec, size_t begin, size_t end) {
+    Vec_AppendRange(vec, begin, end, "\nerror : vector_append_range");
+}
+//l count ǉ
+void Vec4_AppendFill(Vec4Vector* vec, size_t count, Vec4 value) {
+    Vec_AppendFill(vec, count, value, "\nerror : vector_append_fill");
+}
 //
 void Vec4_Free(Vec4Vector* vec) {
     free(vec->data);
@@ -105,7 +351,7 @@ void Char2_PushBack(Char2Vector* vec, Char2 str)
 {
     if (vec->size >= vec->capacity) {
         size_t new_capacity = (vec->capacity == 0) ? 4 : vec->capacity * 2;
-        Char2* new_data = (Char2*)realloc(vec->data, new_capacity * sizeof(Char2));
+        Char2* new_data = (Char2*)Util_Realloc(vec->data, new_capacity * sizeof(Char2));
         if (!new_data) {
             AddMessage("\nerror : char2vector_push_back/̊mۂɎs\n");
             return;
@@ -163,7 +409,7 @@ void VecC_PushBack(CharVector* vec, const char* str) {
 
     if (vec->size >= vec->capacity) {
         size_t new_capacity = (vec->capacity == 0) ? 4 : vec->capacity * 2;
-        char** new_data = (char**)realloc(vec->data, new_capacity * sizeof(const char*));
+        char** new_data = (char**)Util_Realloc(vec->data, new_capacity * sizeof(const char*));
         if (!new_data) {
             AddMessage("\nerror : charvector_push_back/̊mۂɎs\n");
             return;
@@ -174,7 +420,7 @@ void VecC_PushBack(CharVector* vec, const char* str) {
 
     // Rs[mۂĕۑ
     size_t len = strlen(str) + 1;
-    char* copy = (char*)malloc(len);
+    char* copy = (char*)Util_Malloc(len);
     if (!copy) {
         AddMessage("\nerror : charvector_push_back/Rs[s\n");
         return;
@@ -200,10 +446,11 @@ void VecC_Set(CharVector* vec, size_t index, const char* str) {
         AddMessage("\nerror : charvector_set/CfbNX͈͊O\n");
         return;
     }
+    free(vec->data[index]);
     vec->data[index] = NULL;
 
     size_t len = strlen(str) + 1;
-    char* copy = (char*)malloc(len);
+    char* copy = (char*)Util_Malloc(len);
     memcpy(copy, str, len);
 
     vec->data[index] = copy;
@@ -231,7 +478,7 @@ void VecInt_PushBack(IntVector* vec, int str) {
 
     if (vec->size >= vec->capacity) {
         size_t new_capacity = (vec->capacity == 0) ? 4 : vec->capacity * 2;
-        int* new_data = (int*)realloc(vec->data, new_capacity * sizeof(int));
+        int* new_data = (int*)Util_Realloc(vec->data, new_capacity * sizeof(int));
         if (!new_data) {
             AddMessage("\nerror : intvector_push_back/̊mۂɎs\n");
             return;
@@ -256,6 +503,12 @@ void VecInt_Set(IntVector* vec, size_t index, int str) {
     }
     vec->data[index] = str;
 }
+void VecInt_AppendRange(IntVector* vec, size_t begin, size_t end) {
+    Vec_AppendRange(vec, begin, end, "\nerror : int_vector_append_range");
+}
+void VecInt_AppendFill(IntVector* vec, size_t count, int value) {
+    Vec_AppendFill(vec, count, value, "\nerror : int_vector_append_fill");
+}
 void VecInt_Free(IntVector* vec) {
     free(vec->data);
     vec->data = NULL;
@@ -274,7 +527,7 @@ void VecBool_Init(BoolVector* vec) {
 void VecBool_PushBack(BoolVector* vec, bool str) {
     if (vec->size >= vec->capacity) {
         size_t new_capacity = (vec->capacity == 0) ? 4 : vec->capacity * 2;
-        bool* new_data = (bool*)realloc(vec->data, new_capacity * sizeof(bool));
+        bool* new_data = (bool*)Util_Realloc(vec->data, new_capacity * sizeof(bool));
         if (!new_data) {
             AddMessage("\nerror : bool_vector_push_back/̊mۂɎs\n");
             return;
@@ -299,6 +552,12 @@ void VecBool_Set(BoolVector* vec, size_t index, bool str) {
     }
     vec->data[index] = str;
 }
+void VecBool_AppendRange(BoolVector* vec, size_t begin, size_t end) {
+    Vec_AppendRange(vec, begin, end, "\nerror : bool_vector_append_range");
+}
+void VecBool_AppendFill(BoolVector* vec, size_t count, bool value) {
+    Vec_AppendFill(vec, count, value, "\nerror : bool_vector_append_fill");
+}
 void VecBool_Free(BoolVector* vec) {
     free(vec->data);
     vec->data = NULL;
@@ -315,6 +574,35 @@ void KeyMap_Init(KeyMap* map) {
     map->size = 0;
     map->capacity = 0;
 }
+//-----------------------------------------
+// Matrix niXMMATRIX  16 oCgEKvȂ̂ System_AlignedRealloc Ŋmہj
+//-----------------------------------------
+void VecMat_Init(MatrixVector* vec) {
+    vec->data = NULL;
+    vec->size = 0;
+    vec->capacity = 0;
+}
+void VecMat_Resize(MatrixVector* vec, size_t size) {
+    if (size > vec->capacity) {
+        size_t new_capacity = (vec->capacity == 0) ? 4 : vec->capacity;
+        while (new_capacity < size) new_capacity *= 2;
+        HeapCount_Add();
+        DirectX::XMMATRIX* new_data = (DirectX::XMMATRIX*)System_AlignedRealloc(vec->data, vec->capacity * sizeof(DirectX::XMMATRIX), new_capacity * sizeof(DirectX::XMMATRIX), 16);
+        if (!new_data) {
+            AddMessage("\nerror : VecMat_Resize/̊mۂɎs\n");
+            return;
+        }
+        vec->data = new_data;
+        vec->capacity = new_capacity;
+    }
+    for (size_t i = vec->size; i < size; i++) vec->data[i] = DirectX::XMMatrixIdentity();
+    vec->size = size;
+}
+void VecMat_Free(MatrixVector* vec) {
+    System_AlignedFree(vec->data);
+    VecMat_Init(vec);
+}
+
 void KeyMap_Free(KeyMap* map) {
     for (size_t i = 0; i < map->size; i++) {
         free(map->keys[i]);
@@ -327,7 +615,7 @@ void KeyMap_Free(KeyMap* map) {
 int KeyMap_EnsureCapacity(KeyMap* map) {
     if (map->size >= map->capacity) {
         size_t new_capacity = (map->capacity == 0) ? 4 : map->capacity * 2;
-        char** new_keys = (char**)realloc(map->keys, new_capacity * sizeof(char*));
+        char** new_keys = (char**)Util_Realloc(map->keys, new_capacity * sizeof(char*));
         if (!new_keys) {
             AddMessage("\nerror : keymap_ensure_capacity/̊mۂɎs\n");
             return 0; // mێs
@@ -339,19 +627,25 @@ int KeyMap_EnsureCapacity(KeyMap* map) {
 }
 int KeyMap_Add(KeyMap* map, const char* key) {
     for (size_t i = 0; i < map->size; i++) {
-        if (strcmp(map->keys[i], key) == 0) {
+        if (map->keys[i] && strcmp(map->keys[i], key) == 0) {
             printf("error: key '%s' already exists!\n", key);
             //return -1; // 
         }
     }
     if (!KeyMap_EnsureCapacity(map)) return -1;
 
-    map->keys[map->size] = _strdup(key);
+    map->keys[map->size] = Util_StrDup(key);
     return (int)map->size++; // o^CfbNXԂ
 }
+int KeyMap_Push(KeyMap* map, const char* key) {
+    if (!KeyMap_EnsureCapacity(map)) return -1;
+
+    map->keys[map->size] = Util_StrDup(key);
+    return (int)map->size++;
+}
 int KeyMap_GetIndex(KeyMap* map, const char* key) {
     for (size_t i = 0; i < map->size; i++) {
-        if (strcmp(map->keys[i], key) == 0) {
+        if (map->keys[i] && strcmp(map->keys[i], key) == 0) {
             return (int)i; // 
         }
     }
@@ -367,14 +661,63 @@ void KeyMap_SetKey(KeyMap* map, size_t index, const char* key)
         AddMessage("\nerror : KeyMap_set/CfbNX͈͊O\n");
         return;
     }
+    free(map->keys[index]);
     map->keys[index] = NULL;
 
     size_t len = strlen(key) + 1;
-    char* copy = (char*)malloc(len);
+    char* copy = (char*)Util_Malloc(len);
     memcpy(copy, key, len);
 
     map->keys[index] = copy;
 }
+// [begin, end) ̃L[𖖔֕iprefix ΐ擪ɕtBL[ NULL ̂܂܁j
+void KeyMap_AppendRange(KeyMap* map, size_t begin, size_t end, const char* prefix)
+{
+    if (begin > end || end > map->size) {
+        AddMessage("\nerror : KeyMap_AppendRange/CfbNX͈͊O\n");
+        return;
+    }
+    size_t prefixLen = prefix ? strlen(prefix) : 0;
+    for (size_t i = begin; i < end; i++) {
+        if (!KeyMap_EnsureCapacity(map)) return;
+        const char* key = map->keys[i];
+        char* copy = NULL;
+        if (key) {
+            size_t len = strlen(key) + 1;
+            copy = (char*)Util_Malloc(prefixLen + len);
+            if (prefixLen) memcpy(copy, prefix, prefixLen);
+            memcpy(copy + prefixLen, key, len);
+        }
+        map->keys[map->size++] = copy;
+    }
+}
+// ̃L[iNULLj count ֒ǉiォ KeyMap_SetKey Ŗ߂j
+void KeyMap_AppendEmpty(KeyMap* map, size_t count)
+{
+    if (map->size + count > map->capacity) {
+        size_t new_capacity = (map->capacity == 0) ? 4 : map->capacity;
+        while (new_capacity < map->size + count) new_capacity *= 2;
+        char** new_keys = (char**)Util_Realloc(map->keys, new_capacity * sizeof(char*));
+        if (!new_keys) {
+            AddMessage("\nerror : KeyMap_AppendEmpty/̊mۂɎs\n");
+            return;
+        }
+        map->keys = new_keys;
+        map->capacity = new_capacity;
+    }
+    for (size_t i = 0; i < count; i++) map->keys[map->size + i] = NULL;
+    map->size += count;
+}
+// L[iCfbNX͋l߂ȂBL[ NULL ɂȂ茟Ɋ|Ȃj
+void KeyMap_Remove(KeyMap* map, size_t index)
+{
+    if (index >= map->size) {
+        AddMessage("\nerror : KeyMap_Remove/CfbNX͈͊O\n");
+        return;
+    }
+    free(map->keys[index]);
+    map->keys[index] = NULL;
+}
 const char* KeyMap_GetKey(KeyMap* map, int index) {
     if (index < 0 || (size_t)index >= map->size) {
         AddMessage("\nerror : keymap_getkey/CfbNX͈͊O\n");